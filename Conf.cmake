@@ -26,6 +26,9 @@ option(OPS_Use_Dev_Directories
 option(FMK
   "Special FMK Code"                                       OFF)
 
+option(OPS_Use_OpenMP
+  "Build the threaded paths with OpenMP, if it is found"   ON)
+
 set(OPS_Use_Graphics_Option
   None
   # Base
@@ -44,7 +44,7 @@
 #include <Node.h>
 #include <Domain.h>
 
-Element  *ops_TheActiveElement = 0;
+thread_local Element *ops_TheActiveElement = 0;
 
 Matrix **Element::theMatrices; 
 Vector **Element::theVectors1; 
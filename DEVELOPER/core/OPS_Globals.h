@@ -64,7 +64,7 @@ class Element;
 extern double   ops_Dt;                // current delta T for current domain doing an update
 // extern double  *ops_Gravity;        // gravity factors for current domain undergoing an update
 extern Domain  *ops_TheActiveDomain;   // current domain undergoing an update
-extern Element *ops_TheActiveElement;  // current element undergoing an update
+extern thread_local Element *ops_TheActiveElement;  // current element undergoing an update, per thread
 
 // global variable for initial state analysis
 // added: Chris McGann, University of Washington
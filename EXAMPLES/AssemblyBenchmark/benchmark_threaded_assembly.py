@@ -0,0 +1,271 @@
+"""
+Benchmark of the multithreaded element assembly of IncrementalIntegrator.
+
+Times the same transient analysis of a large fiber frame and of a brick
+model with 'integrator -numThreads n ...' and 'domainThreads n' for a list
+of thread counts. The response must be the same to the bit for every
+count above one; the threads sum the element contributions color by
+color, so against the serial run the largest relative difference of the
+displacements is reported, which is at the level of roundoff. The
+forceBeamColumn elements of the frame are thread
+safe and are assembled by the threads; the bricks are not, so the brick
+model shows the cost of the threaded path when no element takes part.
+OpenSees must be built with OpenMP for the threads to be used; otherwise
+every run is serial.
+
+Usage: python benchmark_threaded_assembly.py <output.csv> [threads ...]
+"""
+
+from __future__ import annotations
+
+import csv
+import os
+import sys
+import time
+from dataclasses import dataclass
+from pathlib import Path
+from typing import Callable, List, Tuple
+
+# Import OpenSeesPy: prefer local build, else installed openseespy
+SCRIPT_PATH = Path(__file__).resolve()
+FILENAME = SCRIPT_PATH.name
+SCRIPT_DIR = SCRIPT_PATH.parent
+REPO_ROOT = SCRIPT_PATH.parents[2]
+BUILD_CANDIDATES = (
+    REPO_ROOT / "build" / "Release",
+    REPO_ROOT / "build",
+)
+OPENSEESPY_BUILD = None
+for candidate in BUILD_CANDIDATES:
+    if (candidate / "opensees.so").exists():
+        OPENSEESPY_BUILD = candidate
+        break
+if OPENSEESPY_BUILD is not None:
+    print(f"[{FILENAME}] Importing OpenSeesPy from: {OPENSEESPY_BUILD}")
+    sys.path.insert(0, str(OPENSEESPY_BUILD))
+    import opensees as ops
+else:
+    print(f"[{FILENAME}] No local build found; using openseespy.opensees")
+    import openseespy.opensees as ops
+
+
+# -----------------------------------------------------------------------------
+# Models
+# -----------------------------------------------------------------------------
+
+# Planar steel moment frame: W-shape like fiber sections with Steel02
+NUM_STORIES = 40
+NUM_BAYS = 40
+STORY_HEIGHT = 144.0  # in
+BAY_WIDTH = 288.0  # in
+FLOOR_MASS = 0.05  # kip s^2 / in per node
+
+# Solid block of elastoplastic bricks
+BRICKS = (20, 10, 10)
+BLOCK_SIZE = (40.0, 20.0, 20.0)  # in
+
+
+def build_frame() -> str:
+    """Fixed base moment frame of forceBeamColumn elements."""
+    ops.wipe()
+    ops.model("basic", "-ndm", 2, "-ndf", 3)
+
+    ops.uniaxialMaterial("Steel02", 1, 50.0, 29000.0, 0.01, 18, 0.925, 0.15)
+    ops.section("Fiber", 1)
+    ops.patch("rect", 1, 2, 8, 6.0, -4.0, 7.0, 4.0)  # top flange
+    ops.patch("rect", 1, 12, 1, -6.0, -0.25, 6.0, 0.25)  # web
+    ops.patch("rect", 1, 2, 8, -7.0, -4.0, -6.0, 4.0)  # bottom flange
+    ops.beamIntegration("Lobatto", 1, 1, 5)
+    ops.geomTransf("PDelta", 1)
+    ops.geomTransf("Linear", 2)
+
+    def tag(i, j):
+        return j * (NUM_BAYS + 1) + i + 1
+
+    for j in range(NUM_STORIES + 1):
+        for i in range(NUM_BAYS + 1):
+            if j == 0:
+                ops.node(tag(i, j), i * BAY_WIDTH, 0.0)
+                ops.fix(tag(i, j), 1, 1, 1)
+            else:
+                ops.node(tag(i, j), i * BAY_WIDTH, j * STORY_HEIGHT,
+                         "-mass", FLOOR_MASS, FLOOR_MASS, 0.0)
+
+    eleTag = 1
+    for j in range(NUM_STORIES):
+        for i in range(NUM_BAYS + 1):
+            ops.element("forceBeamColumn", eleTag, tag(i, j), tag(i, j + 1), 1, 1)
+            eleTag += 1
+    for j in range(1, NUM_STORIES + 1):
+        for i in range(NUM_BAYS):
+            ops.element("forceBeamColumn", eleTag, tag(i, j), tag(i + 1, j), 2, 1)
+            eleTag += 1
+
+    ops.rayleigh(0.0, 0.0, 0.0, 0.002)
+    ops.timeSeries("Trig", 1, 0.0, 10.0, 1.0, "-factor", 200.0)
+    ops.pattern("UniformExcitation", 1, 1, "-accel", 1)
+    return "UmfPack"
+
+
+def build_bricks() -> str:
+    """Block of bricks with J2 plasticity, cantilevered and bent past yield."""
+    ops.wipe()
+    ops.model("basic", "-ndm", 3, "-ndf", 3)
+
+    ops.nDMaterial("J2Plasticity", 1, 16667.0, 11154.0, 50.0, 60.0, 5.0, 100.0)
+    nx, ny, nz = BRICKS
+    lx, ly, lz = BLOCK_SIZE
+    ops.block3D(
+        nx, ny, nz, 1, 1, "stdBrick", 1,
+        1, 0.0, 0.0, 0.0,
+        2, lx, 0.0, 0.0,
+        3, lx, ly, 0.0,
+        4, 0.0, ly, 0.0,
+        5, 0.0, 0.0, lz,
+        6, lx, 0.0, lz,
+        7, lx, ly, lz,
+        8, 0.0, ly, lz,
+    )
+    ops.fixX(0.0, 1, 1, 1)
+
+    # the material has no mass, so the transient analysis is quasi-static
+    ops.timeSeries("Linear", 1, "-factor", 10.0)
+    ops.pattern("Plain", 1, 1)
+    tip = [node for node in ops.getNodeTags() if ops.nodeCoord(node, 1) == lx]
+    for node in tip:
+        ops.load(node, 0.0, 0.0, 1000.0 / len(tip))
+    return "SupernodalSPD"
+
+
+MODELS: List[Tuple[str, Callable[[], str]]] = [
+    ("frame", build_frame),
+    ("brick", build_bricks),
+]
+
+
+# -----------------------------------------------------------------------------
+# Benchmark
+# -----------------------------------------------------------------------------
+
+
+@dataclass
+class BenchmarkRow:
+    model: str
+    num_threads: int
+    num_elements: int
+    num_equations: int
+    num_steps: int
+    status: int
+    time_seconds: float
+    max_displacement: float
+
+
+CSV_HEADER = (
+    "model",
+    "num_threads",
+    "num_elements",
+    "num_equations",
+    "num_steps",
+    "status",
+    "time_seconds",
+    "max_displacement",
+)
+
+
+def run_benchmark(model: str, build: Callable[[], str], num_threads: int,
+                  num_steps: int = 20, dt: float = 0.01) -> Tuple[BenchmarkRow, List[float]]:
+    """Run the transient analysis of one model with the given threads."""
+    system = build()
+    ops.domainThreads(num_threads)
+
+    ops.constraints("Plain")
+    ops.numberer("RCM")
+    ops.system(system)
+    ops.test("NormDispIncr", 1.0e-8, 20)
+    ops.algorithm("Newton")
+    ops.integrator("-numThreads", num_threads, "Newmark", 0.5, 0.25)
+    ops.analysis("Transient")
+
+    start_time = time.perf_counter()
+    status = ops.analyze(num_steps, dt)
+    time_seconds = time.perf_counter() - start_time
+
+    disp = [u for node in ops.getNodeTags() for u in ops.nodeDisp(node)]
+    row = BenchmarkRow(
+        model=model,
+        num_threads=num_threads,
+        num_elements=len(ops.getEleTags()),
+        num_equations=ops.systemSize(),
+        num_steps=num_steps,
+        status=status,
+        time_seconds=time_seconds,
+        max_displacement=max(abs(u) for u in disp),
+    )
+    return row, disp
+
+
+def main():
+    """Run the benchmarks and output CSV."""
+    if len(sys.argv) < 2:
+        print(f"Usage: python {FILENAME} <output.csv> [threads ...]")
+        sys.exit(1)
+
+    # Handle output CSV path: if simple filename, store in script directory
+    output_arg = sys.argv[1]
+    if '/' not in output_arg and '\\' not in output_arg:
+        output_csv = SCRIPT_DIR / output_arg
+    else:
+        output_csv = Path(output_arg)
+    output_csv.parent.mkdir(parents=True, exist_ok=True)
+
+    if len(sys.argv) > 2:
+        thread_counts = [int(n) for n in sys.argv[2:]]
+    else:
+        cores = os.cpu_count() or 1
+        thread_counts = sorted({1, 2, 4, 8, 16, 32, 64, cores} & set(range(1, cores + 1)))
+
+    print("\n=== Threaded Assembly Benchmark ===")
+    print(f"Threads: {thread_counts}")
+    print(f"Results will be written to: {output_csv}\n")
+
+    with output_csv.open("w", newline="") as csvfile:
+        writer = csv.writer(csvfile)
+        writer.writerow(CSV_HEADER)
+
+        for model, build in MODELS:
+            serial_time = None
+            serial_disp = None
+            threaded_disp = None
+            for num_threads in thread_counts:
+                row, disp = run_benchmark(model, build, num_threads)
+                writer.writerow((
+                    row.model,
+                    row.num_threads,
+                    row.num_elements,
+                    row.num_equations,
+                    row.num_steps,
+                    row.status,
+                    f"{row.time_seconds:.6f}",
+                    f"{row.max_displacement:.12e}",
+                ))
+                csvfile.flush()
+
+                if serial_time is None:
+                    serial_time = row.time_seconds
+                    serial_disp = disp
+                scale = max(max(abs(u) for u in serial_disp), 1.0e-300)
+                difference = max(abs(u1 - u2) for u1, u2 in zip(serial_disp, disp)) / scale
+                if num_threads > 1 and threaded_disp is None:
+                    threaded_disp = disp
+                same = "same" if num_threads == 1 or disp == threaded_disp else "DIFFERENT"
+                print(f"{model:6s} {row.num_elements:7d} elements {row.num_equations:7d} eqn "
+                      f"{num_threads:3d} threads: {row.time_seconds:8.2f} s "
+                      f"speedup {serial_time / row.time_seconds:5.2f}, "
+                      f"response {same}, relative difference {difference:.1e} "
+                      f"(status {row.status})")
+
+    ops.wipe()
+
+
+if __name__ == "__main__":
+    main()
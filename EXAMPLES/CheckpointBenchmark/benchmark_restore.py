@@ -0,0 +1,230 @@
+"""
+Benchmark of checkpoint save and restore with 'database File' and
+'database Binary'.
+
+A fiber frame is analysed for a number of steps with a 'save' after each.
+Then every checkpoint is restored, latest first, and the restored nodal
+displacements are checked against those saved. Reports the total save and
+restore times of each datastore, the number of files each writes, and the
+ratio of the Binary to the File times. Binary is not expected to be faster,
+most of the time of both goes to sendSelf() and recvSelf().
+
+Usage: python benchmark_restore.py <output.csv> [stories bays steps]
+"""
+
+from __future__ import annotations
+
+import csv
+import shutil
+import sys
+import tempfile
+import time
+from dataclasses import dataclass
+from pathlib import Path
+from typing import Dict, List
+
+# Import OpenSeesPy: prefer local build, else installed openseespy
+SCRIPT_PATH = Path(__file__).resolve()
+FILENAME = SCRIPT_PATH.name
+SCRIPT_DIR = SCRIPT_PATH.parent
+REPO_ROOT = SCRIPT_PATH.parents[2]
+BUILD_CANDIDATES = (
+    REPO_ROOT / "build" / "Release",
+    REPO_ROOT / "build",
+)
+OPENSEESPY_BUILD = None
+for candidate in BUILD_CANDIDATES:
+    if (candidate / "opensees.so").exists():
+        OPENSEESPY_BUILD = candidate
+        break
+if OPENSEESPY_BUILD is not None:
+    print(f"[{FILENAME}] Importing OpenSeesPy from: {OPENSEESPY_BUILD}")
+    sys.path.insert(0, str(OPENSEESPY_BUILD))
+    import opensees as ops
+else:
+    print(f"[{FILENAME}] No local build found; using openseespy.opensees")
+    import openseespy.opensees as ops
+
+
+# -----------------------------------------------------------------------------
+# Model
+# -----------------------------------------------------------------------------
+
+STORY_HEIGHT = 144.0  # in
+BAY_WIDTH = 288.0  # in
+FLOOR_MASS = 0.05  # kip s^2 / in per node
+
+
+def build_frame(num_stories: int, num_bays: int) -> None:
+    """Fixed base moment frame of forceBeamColumn elements under a ground motion."""
+    ops.wipe()
+    ops.model("basic", "-ndm", 2, "-ndf", 3)
+
+    ops.uniaxialMaterial("Steel02", 1, 50.0, 29000.0, 0.01, 18, 0.925, 0.15)
+    ops.section("Fiber", 1)
+    ops.patch("rect", 1, 2, 8, 6.0, -4.0, 7.0, 4.0)  # top flange
+    ops.patch("rect", 1, 12, 1, -6.0, -0.25, 6.0, 0.25)  # web
+    ops.patch("rect", 1, 2, 8, -7.0, -4.0, -6.0, 4.0)  # bottom flange
+    ops.beamIntegration("Lobatto", 1, 1, 5)
+    ops.geomTransf("PDelta", 1)
+    ops.geomTransf("Linear", 2)
+
+    def tag(i, j):
+        return j * (num_bays + 1) + i + 1
+
+    for j in range(num_stories + 1):
+        for i in range(num_bays + 1):
+            if j == 0:
+                ops.node(tag(i, j), i * BAY_WIDTH, 0.0)
+                ops.fix(tag(i, j), 1, 1, 1)
+            else:
+                ops.node(tag(i, j), i * BAY_WIDTH, j * STORY_HEIGHT,
+                         "-mass", FLOOR_MASS, FLOOR_MASS, 0.0)
+
+    eleTag = 1
+    for j in range(num_stories):
+        for i in range(num_bays + 1):
+            ops.element("forceBeamColumn", eleTag, tag(i, j), tag(i, j + 1), 1, 1)
+            eleTag += 1
+    for j in range(1, num_stories + 1):
+        for i in range(num_bays):
+            ops.element("forceBeamColumn", eleTag, tag(i, j), tag(i + 1, j), 2, 1)
+            eleTag += 1
+
+    ops.timeSeries("Trig", 1, 0.0, 10.0, 1.0, "-factor", 200.0)
+    ops.pattern("UniformExcitation", 1, 1, "-accel", 1)
+
+    ops.constraints("Plain")
+    ops.numberer("RCM")
+    ops.system("UmfPack")
+    ops.test("NormDispIncr", 1.0e-8, 20)
+    ops.algorithm("Newton")
+    ops.integrator("Newmark", 0.5, 0.25)
+    ops.analysis("Transient")
+
+
+def displacements() -> Dict[int, List[float]]:
+    return {node: ops.nodeDisp(node) for node in ops.getNodeTags()}
+
+
+# -----------------------------------------------------------------------------
+# Benchmark
+# -----------------------------------------------------------------------------
+
+
+@dataclass
+class BenchmarkRow:
+    datastore: str
+    num_elements: int
+    num_checkpoints: int
+    save_seconds: float
+    restore_seconds: float
+    num_files: int
+    restored_ok: bool
+
+
+CSV_HEADER = (
+    "datastore",
+    "num_elements",
+    "num_checkpoints",
+    "save_seconds",
+    "restore_seconds",
+    "num_files",
+    "restored_ok",
+)
+
+
+def run_benchmark(datastore: str, directory: Path, num_stories: int,
+                  num_bays: int, num_steps: int, dt: float = 0.01) -> BenchmarkRow:
+    """Save after each step, then restore every checkpoint."""
+    build_frame(num_stories, num_bays)
+    ops.database(datastore, str(directory / datastore / "checkpoint"))
+
+    saved = {}
+    save_seconds = 0.0
+    for step in range(1, num_steps + 1):
+        if ops.analyze(1, dt) != 0:
+            raise RuntimeError(f"analysis failed at step {step}")
+        start_time = time.perf_counter()
+        ops.save(step)
+        save_seconds += time.perf_counter() - start_time
+        saved[step] = displacements()
+
+    restored_ok = True
+    restore_seconds = 0.0
+    for step in range(num_steps, 0, -1):
+        start_time = time.perf_counter()
+        ops.restore(step)
+        restore_seconds += time.perf_counter() - start_time
+        if displacements() != saved[step]:
+            restored_ok = False
+
+    return BenchmarkRow(
+        datastore=datastore,
+        num_elements=len(ops.getEleTags()),
+        num_checkpoints=num_steps,
+        save_seconds=save_seconds,
+        restore_seconds=restore_seconds,
+        num_files=len(list((directory / datastore).iterdir())),
+        restored_ok=restored_ok,
+    )
+
+
+def main():
+    """Run the benchmarks and output CSV."""
+    if len(sys.argv) < 2:
+        print(f"Usage: python {FILENAME} <output.csv> [stories bays steps]")
+        sys.exit(1)
+
+    # Handle output CSV path: if simple filename, store in script directory
+    output_arg = sys.argv[1]
+    if '/' not in output_arg and '\\' not in output_arg:
+        output_csv = SCRIPT_DIR / output_arg
+    else:
+        output_csv = Path(output_arg)
+    output_csv.parent.mkdir(parents=True, exist_ok=True)
+
+    num_stories, num_bays, num_steps = 20, 20, 10
+    if len(sys.argv) > 4:
+        num_stories, num_bays, num_steps = (int(a) for a in sys.argv[2:5])
+
+    print("\n=== Checkpoint Restore Benchmark ===")
+    print(f"Frame: {num_stories} stories, {num_bays} bays, {num_steps} checkpoints")
+    print(f"Results will be written to: {output_csv}\n")
+
+    rows: List[BenchmarkRow] = []
+    directory = Path(tempfile.mkdtemp(prefix="checkpoint_"))
+    try:
+        with output_csv.open("w", newline="") as csvfile:
+            writer = csv.writer(csvfile)
+            writer.writerow(CSV_HEADER)
+            for datastore in ("File", "Binary"):
+                (directory / datastore).mkdir()
+                row = run_benchmark(datastore, directory, num_stories, num_bays, num_steps)
+                rows.append(row)
+                writer.writerow((
+                    row.datastore,
+                    row.num_elements,
+                    row.num_checkpoints,
+                    f"{row.save_seconds:.6f}",
+                    f"{row.restore_seconds:.6f}",
+                    row.num_files,
+                    int(row.restored_ok),
+                ))
+                csvfile.flush()
+                print(f"{row.datastore:6s} {row.num_elements:6d} elements: "
+                      f"save {row.save_seconds:8.3f} s, restore {row.restore_seconds:8.3f} s, "
+                      f"{row.num_files} files, "
+                      f"restored state {'matches' if row.restored_ok else 'DIFFERS'}")
+    finally:
+        ops.wipe()
+        shutil.rmtree(directory, ignore_errors=True)
+
+    file_row, binary_row = rows
+    print(f"\nBinary / File time: save "
+          f"{binary_row.save_seconds / file_row.save_seconds:.2f}, restore "
+          f"{binary_row.restore_seconds / file_row.restore_seconds:.2f}")
+
+
+if __name__ == "__main__":
+    main()
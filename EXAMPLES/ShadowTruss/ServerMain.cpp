@@ -43,7 +43,7 @@ OPS_Stream &opserr = sserr;
 
 double        ops_Dt = 0;
 Domain       *ops_TheActiveDomain = 0;
-Element      *ops_TheActiveElement = 0;
+thread_local Element *ops_TheActiveElement = 0;
 
 // main routine
 int main(int argc, char **argv)
@@ -0,0 +1,270 @@
+"""
+Benchmark of the sparse SPD solvers on linear static and modal problems.
+
+Solves the same elastic brick bar with 'system SupernodalSPD', 'UmfPack'
+and 'ProfileSPD', the latter with both RCM and Plain numbering, for a
+series of mesh refinements. The static case is one linear load step, the
+modal case the lowest modes found with the default eigen solver, which
+factors K with the current system. Displacements and eigenvalues are
+compared against the first solver of the list.
+
+Usage: python benchmark_spd_solvers.py <output.csv> [mesh_factor ...]
+"""
+
+from __future__ import annotations
+
+import csv
+import math
+import sys
+import time
+from dataclasses import dataclass
+from pathlib import Path
+from typing import Callable, List, Tuple
+
+# Import OpenSeesPy: prefer local build, else installed openseespy
+SCRIPT_PATH = Path(__file__).resolve()
+FILENAME = SCRIPT_PATH.name
+SCRIPT_DIR = SCRIPT_PATH.parent
+REPO_ROOT = SCRIPT_PATH.parents[2]
+BUILD_CANDIDATES = (
+    REPO_ROOT / "build" / "Release",
+    REPO_ROOT / "build",
+)
+OPENSEESPY_BUILD = None
+for candidate in BUILD_CANDIDATES:
+    if (candidate / "opensees.so").exists():
+        OPENSEESPY_BUILD = candidate
+        break
+if OPENSEESPY_BUILD is not None:
+    print(f"[{FILENAME}] Importing OpenSeesPy from: {OPENSEESPY_BUILD}")
+    sys.path.insert(0, str(OPENSEESPY_BUILD))
+    import opensees as ops
+else:
+    print(f"[{FILENAME}] No local build found; using openseespy.opensees")
+    import openseespy.opensees as ops
+
+
+# -----------------------------------------------------------------------------
+# Model Geometry and Material Properties
+# -----------------------------------------------------------------------------
+
+BAR_LENGTH = 10.0  # inches
+BAR_HEIGHT = 2.0  # inches
+BAR_THICKNESS = 1.0  # inches
+
+ELASTIC_MODULUS = 29_000.0  # kip / in^2
+POISSON_RATIO = 0.3
+STEEL_DENSITY = 0.284e-3 / 386.4  # kip s^2 / in^4
+TIP_LOAD = 10.0  # kip
+
+NUM_MODES = 10
+
+
+def build_solid_bar_model(nx: int, ny: int, nz: int) -> None:
+    """Cantilevered bar of elastic bricks with a vertical tip load."""
+    ops.wipe()
+    ops.model("basic", "-ndm", 3, "-ndf", 3)
+    ops.nDMaterial("ElasticIsotropic", 1, ELASTIC_MODULUS, POISSON_RATIO, STEEL_DENSITY)
+
+    ops.block3D(
+        nx, ny, nz, 1, 1, "stdBrick", 1,
+        1, 0.0, -BAR_THICKNESS / 2.0, -BAR_HEIGHT / 2.0,
+        2, BAR_LENGTH, -BAR_THICKNESS / 2.0, -BAR_HEIGHT / 2.0,
+        3, BAR_LENGTH, BAR_THICKNESS / 2.0, -BAR_HEIGHT / 2.0,
+        4, 0.0, BAR_THICKNESS / 2.0, -BAR_HEIGHT / 2.0,
+        5, 0.0, -BAR_THICKNESS / 2.0, BAR_HEIGHT / 2.0,
+        6, BAR_LENGTH, -BAR_THICKNESS / 2.0, BAR_HEIGHT / 2.0,
+        7, BAR_LENGTH, BAR_THICKNESS / 2.0, BAR_HEIGHT / 2.0,
+        8, 0.0, BAR_THICKNESS / 2.0, BAR_HEIGHT / 2.0,
+    )
+    ops.fixX(0.0, 1, 1, 1)
+
+    ops.timeSeries("Linear", 1)
+    ops.pattern("Plain", 1, 1)
+    tip = [node for node in ops.getNodeTags()
+           if math.isclose(ops.nodeCoord(node, 1), BAR_LENGTH, abs_tol=1e-9)]
+    for node in tip:
+        ops.load(node, 0.0, 0.0, -TIP_LOAD / len(tip))
+
+
+def counts_from_mesh_factor(factor: float) -> Tuple[int, int, int]:
+    """Return the brick counts for a given refinement factor."""
+    mesh_size = BAR_THICKNESS / factor
+
+    def count(dim: float) -> int:
+        return max(1, int(math.ceil(dim / mesh_size)))
+
+    return count(BAR_LENGTH), count(BAR_THICKNESS), count(BAR_HEIGHT)
+
+
+# -----------------------------------------------------------------------------
+# Solvers: (name, system, numberer)
+# -----------------------------------------------------------------------------
+
+SOLVERS: List[Tuple[str, str, str]] = [
+    ("SupernodalSPD", "SupernodalSPD", "Plain"),
+    ("UmfPack", "UmfPack", "Plain"),
+    ("ProfileSPD-RCM", "ProfileSPD", "RCM"),
+    ("ProfileSPD-Plain", "ProfileSPD", "Plain"),
+]
+
+# ProfileSPD with Plain numbering has a profile of the whole bar section
+# times its length; skip it beyond this mesh factor
+SKIP_LIMITS = {
+    "ProfileSPD-Plain": 8.0,
+}
+
+
+# -----------------------------------------------------------------------------
+# Benchmark
+# -----------------------------------------------------------------------------
+
+
+@dataclass
+class BenchmarkRow:
+    problem: str
+    solver_name: str
+    mesh_factor: float
+    num_elements: int
+    num_equations: int
+    status: int
+    time_seconds: float
+    max_rel_difference: float
+
+
+CSV_HEADER = (
+    "problem",
+    "solver",
+    "mesh_factor",
+    "num_elements",
+    "num_equations",
+    "status",
+    "time_seconds",
+    "max_rel_difference",
+)
+
+
+def configure(system: str, numberer: str) -> None:
+    ops.constraints("Plain")
+    ops.numberer(numberer)
+    ops.system(system)
+    ops.integrator("LoadControl", 1.0)
+    ops.test("NormUnbalance", 1.0e-6, 2)
+    ops.algorithm("Linear")
+    ops.analysis("Static")
+
+
+def run_static() -> Tuple[int, List[float]]:
+    status = ops.analyze(1)
+    return status, [u for node in ops.getNodeTags() for u in ops.nodeDisp(node)]
+
+
+def run_modal() -> Tuple[int, List[float]]:
+    values = ops.eigen(NUM_MODES)
+    if not values or len(values) != NUM_MODES:
+        return -1, []
+    return 0, list(values)
+
+
+PROBLEMS: List[Tuple[str, Callable[[], Tuple[int, List[float]]]]] = [
+    ("static", run_static),
+    ("modal", run_modal),
+]
+
+
+def max_rel_difference(values: List[float], reference: List[float]) -> float:
+    if not values or len(values) != len(reference):
+        return float("nan")
+    scale = max(abs(v) for v in reference) or 1.0
+    return max(abs(a - b) for a, b in zip(values, reference)) / scale
+
+
+def run_benchmark(problem: str, run: Callable[[], Tuple[int, List[float]]],
+                  solver: Tuple[str, str, str], mesh_factor: float,
+                  counts: Tuple[int, int, int]) -> Tuple[BenchmarkRow, List[float]]:
+    """Build the model and time one problem with one solver."""
+    solver_name, system, numberer = solver
+    build_solid_bar_model(*counts)
+    configure(system, numberer)
+
+    start_time = time.perf_counter()
+    status, values = run()
+    time_seconds = time.perf_counter() - start_time
+
+    row = BenchmarkRow(
+        problem=problem,
+        solver_name=solver_name,
+        mesh_factor=mesh_factor,
+        num_elements=len(ops.getEleTags()),
+        num_equations=ops.systemSize(),
+        status=status,
+        time_seconds=time_seconds,
+        max_rel_difference=float("nan"),
+    )
+    return row, values
+
+
+def main():
+    """Run the benchmarks and output CSV."""
+    if len(sys.argv) < 2:
+        print(f"Usage: python {FILENAME} <output.csv> [mesh_factor ...]")
+        sys.exit(1)
+
+    # Handle output CSV path: if simple filename, store in script directory
+    output_arg = sys.argv[1]
+    if '/' not in output_arg and '\\' not in output_arg:
+        output_csv = SCRIPT_DIR / output_arg
+    else:
+        output_csv = Path(output_arg)
+    output_csv.parent.mkdir(parents=True, exist_ok=True)
+
+    if len(sys.argv) > 2:
+        mesh_factors = [float(f) for f in sys.argv[2:]]
+    else:
+        mesh_factors = [2.0, 4.0, 6.0, 8.0, 10.0, 12.0]
+
+    print("\n=== Sparse SPD Solver Benchmark ===")
+    print(f"Comparing: {[s[0] for s in SOLVERS]}")
+    print(f"Mesh factors: {mesh_factors}")
+    print(f"Results will be written to: {output_csv}\n")
+
+    with output_csv.open("w", newline="") as csvfile:
+        writer = csv.writer(csvfile)
+        writer.writerow(CSV_HEADER)
+
+        for problem, run in PROBLEMS:
+            for mesh_factor in mesh_factors:
+                counts = counts_from_mesh_factor(mesh_factor)
+                reference = None
+                for solver in SOLVERS:
+                    if mesh_factor >= SKIP_LIMITS.get(solver[0], float("inf")):
+                        print(f"{problem:6s} {mesh_factor:5.1f} {solver[0]:17s} skipped")
+                        continue
+
+                    row, values = run_benchmark(problem, run, solver, mesh_factor, counts)
+                    if reference is None and row.status == 0:
+                        reference = values
+                    if reference is not None:
+                        row.max_rel_difference = max_rel_difference(values, reference)
+
+                    writer.writerow((
+                        row.problem,
+                        row.solver_name,
+                        row.mesh_factor,
+                        row.num_elements,
+                        row.num_equations,
+                        row.status,
+                        f"{row.time_seconds:.6f}",
+                        f"{row.max_rel_difference:.3e}",
+                    ))
+                    csvfile.flush()
+
+                    print(f"{problem:6s} {mesh_factor:5.1f} {row.solver_name:17s} "
+                          f"{row.num_equations:7d} eqn: {row.time_seconds:8.3f} s "
+                          f"(status {row.status}, rel. difference {row.max_rel_difference:.1e})")
+
+    ops.wipe()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,112 @@
+# Monte Carlo Response Analysis with Worker Processes
+
+# The samples of runMonteCarloResponseAnalysis -numProcs n draw their
+# random numbers from streams given by the seed and the sample number,
+# so the samples x and limit-state values g written must not depend on
+# the number of worker processes. Without -numProcs the samples are run
+# as before, only x is written and the limit-state functions are not
+# evaluated.
+
+puts "MonteCarloProcs.tcl: Verification of x and g with 1 and 3 worker processes"
+
+# enough samples for each worker to write more than a pipe holds
+set numSamples 6000
+
+proc readFile {fileName} {
+    set f [open $fileName r]
+    set data [read $f]
+    close $f
+    return $data
+}
+
+proc runSamples {numProcs outFile numSamples} {
+    wipe
+    wipeReliability
+
+    # cantilever of length L with a tip load P, E and A random
+    model basic -ndm 2 -ndf 3
+
+    set L 144.0
+    set E 30000.0
+    set A 25.0
+    set I 1500.0
+    set P 25.0
+
+    node 1 0.0 0.0
+    node 2  $L 0.0
+    fix 1 1 1 0
+    fix 2 0 1 0
+
+    section Elastic 1 $E $A $I
+    geomTransf Linear 1
+    element forceBeamColumn 1 1 2 1 Lobatto 1 3
+
+    pattern Plain 1 Constant {
+	load 2 $P 0 0
+    }
+
+    analysis Static
+
+    reliability
+
+    randomVariable 62 normal -mean $E -stdv [expr 0.1*$E]
+    randomVariable 25 normal -mean $A -stdv [expr 0.1*$A]
+
+    parameter 12 randomVariable 62 element 1 E
+    parameter 13 randomVariable 25 element 1 A
+    parameter 23 node 2 disp 1
+
+    performanceFunction 76 "0.005-\$par(23)"
+    performanceFunction 77 "0.0052-\$par(23)"
+
+    randomNumberGenerator        Philox 11
+    probabilityTransformation    Nataf -print 0
+    functionEvaluator            Tcl -file "analyze 1"
+
+    if {$numProcs == 0} {
+	runMonteCarloResponseAnalysis -outPutFile $outFile -maxNum $numSamples -print 0 -seed 5
+    } else {
+	runMonteCarloResponseAnalysis -outPutFile $outFile -maxNum $numSamples -print 0 -seed 5 -numProcs $numProcs
+    }
+}
+
+runSamples 0 mcProcs0.out 100
+runSamples 1 mcProcs1.out $numSamples
+runSamples 3 mcProcs3.out $numSamples
+
+set testOK 0
+
+puts "\nSamples without worker processes:"
+set data0 [readFile mcProcs0.out]
+if {[llength $data0] != 200 || [file exists mcProcs0.out.gFun]} {
+    set testOK -1;
+    puts "failed mcProcs0.out has [llength $data0] values, expected 200 and no mcProcs0.out.gFun"
+} else {
+    puts "mcProcs0.out has x only ([llength $data0] values)"
+}
+file delete mcProcs0.out mcProcs0.out.gFun
+
+puts "\nComparison of 1 and 3 worker processes:"
+foreach fileName {mcProcs.out mcProcs.out.gFun} {
+    set name1 [string map {mcProcs mcProcs1} $fileName]
+    set name3 [string map {mcProcs mcProcs3} $fileName]
+    set data1 [readFile $name1]
+    set data3 [readFile $name3]
+    if {[string length $data1] == 0 || $data1 != $data3} {
+	set testOK -1;
+	puts "failed $name1 and $name3 differ"
+    } else {
+	puts "$name1 and $name3 are the same ([llength $data1] values)"
+    }
+    file delete $name1 $name3
+}
+
+set results [open results.out a+]
+if {$testOK == 0} {
+    puts "\nPASSED Verification Test MonteCarloProcs.tcl \n\n"
+    puts $results "PASSED : MonteCarloProcs.tcl"
+} else {
+    puts "\nFAILED Verification Test MonteCarloProcs.tcl \n\n"
+    puts $results "FAILED : MonteCarloProcs.tcl"
+}
+close $results
@@ -0,0 +1,148 @@
+# Nodal State Store
+
+# With domainNodalStore 1 the response of the nodes is kept in one
+# contiguous store instead of arrays of each node. The same arithmetic
+# is done either way, so a nonlinear frame pushed over and then shaken
+# must give exactly the same displacements, velocities and accelerations
+# with and without the store, for each of the constraint handlers. The
+# frame has fixed supports, an imposed support displacement, floors
+# tied by equalDOF and a rigid link.
+
+puts "NodalStore.tcl: Verification of a frame with and without domainNodalStore"
+
+proc runFrame {useStore handler} {
+    wipe
+    model basic -ndm 2 -ndf 3
+    domainNodalStore $useStore
+
+    # two bays, two storeys
+    set H 144.0
+    set B 240.0
+    set m 0.5
+    for {set j 0} {$j <= 2} {incr j} {
+	for {set i 0} {$i <= 2} {incr i} {
+	    set tag [expr 10*$j+$i+1]
+	    node $tag [expr $i*$B] [expr $j*$H]
+	    if {$j > 0} {
+		mass $tag $m $m 0.0
+	    }
+	}
+    }
+    fix 1 1 1 1
+    fix 2 1 1 1
+    fix 3 1 0 1
+
+    # a node hanging off the roof on a rigid link
+    node 40 [expr 2.5*$B] [expr 2*$H]
+    mass 40 $m $m 0.0
+    rigidLink beam 23 40
+
+    # the floors move together horizontally
+    foreach floor {10 20} {
+	equalDOF [expr $floor+1] [expr $floor+2] 1
+	equalDOF [expr $floor+1] [expr $floor+3] 1
+    }
+
+    uniaxialMaterial Steel02 1 50.0 29000.0 0.02 18 0.925 0.15
+    section Fiber 1 {
+	patch rect 1 12 1 -6.0 -4.0 6.0 4.0
+    }
+    geomTransf PDelta 1
+    geomTransf Linear 2
+
+    set eleTag 1
+    for {set j 0} {$j < 2} {incr j} {
+	for {set i 0} {$i <= 2} {incr i} {
+	    set iNode [expr 10*$j+$i+1]
+	    element forceBeamColumn $eleTag $iNode [expr $iNode+10] 1 Lobatto 1 4
+	    incr eleTag
+	}
+	for {set i 0} {$i < 2} {incr i} {
+	    set iNode [expr 10*($j+1)+$i+1]
+	    element elasticBeamColumn $eleTag $iNode [expr $iNode+1] 50.0 29000.0 1000.0 2
+	    incr eleTag
+	}
+    }
+
+    # push the roof over while the right support settles
+    timeSeries Linear 1
+    pattern Plain 1 1 {
+	load 21 40.0 0.0 0.0
+	load 11 20.0 0.0 0.0
+	sp 3 2 -0.05
+    }
+
+    constraints $handler 1.0e10 1.0e10
+    numberer RCM
+    system BandGen
+    test NormDispIncr 1.0e-8 50
+    algorithm Newton
+    integrator LoadControl 0.1
+    analysis Static
+
+    set response {}
+    for {set k 0} {$k < 10} {incr k} {
+	if {[analyze 1] != 0} {
+	    return -1
+	}
+	lappend response [frameResponse]
+    }
+
+    # then shake it
+    loadConst -time 0.0
+    timeSeries Sine 2 0.0 2.0 0.4 -factor 400.0
+    pattern UniformExcitation 2 1 -accel 2
+    rayleigh 0.1 0.0 0.0 0.002
+
+    wipeAnalysis
+    constraints $handler 1.0e10 1.0e10
+    numberer RCM
+    system BandGen
+    test NormDispIncr 1.0e-8 50
+    algorithm Newton
+    integrator Newmark 0.5 0.25
+    analysis Transient
+
+    for {set k 0} {$k < 100} {incr k} {
+	if {[analyze 1 0.02] != 0} {
+	    return -1
+	}
+	lappend response [frameResponse]
+    }
+
+    return $response
+}
+
+proc frameResponse {} {
+    set response {}
+    foreach node [getNodeTags] {
+	lappend response [nodeDisp $node] [nodeVel $node] [nodeAccel $node]
+    }
+    return $response
+}
+
+set testOK 0
+
+foreach handler {Transformation Penalty Lagrange} {
+    set response0 [runFrame 0 $handler]
+    set response1 [runFrame 1 $handler]
+    if {$response0 == -1 || $response1 == -1} {
+	set testOK -1
+	puts "failed $handler: analysis failed"
+    } elseif {$response0 != $response1} {
+	set testOK -1
+	puts "failed $handler: response differs with domainNodalStore"
+    } else {
+	puts "$handler: same response with and without domainNodalStore ([llength $response1] steps)"
+    }
+}
+
+set results [open results.out a+]
+if {$testOK == 0} {
+    puts "\nPASSED Verification Test NodalStore.tcl \n\n"
+    puts $results "PASSED : NodalStore.tcl"
+} else {
+    puts "\nFAILED Verification Test NodalStore.tcl \n\n"
+    puts $results "FAILED : NodalStore.tcl"
+}
+close $results
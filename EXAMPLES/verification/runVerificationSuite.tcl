@@ -14,5 +14,7 @@ source EigenFrame.Extra.tcl
 source AISC25.tcl
 source PlanarShearWall.tcl
 source PinchedCylinder.tcl
+source MonteCarloProcs.tcl
+source NodalStore.tcl
 
 exit
@@ -62,6 +62,12 @@ Channel::getDbTag(void)
   return 0;
 }
 
+int
+Channel::flush(void)
+{
+  return 0;
+}
+
 int
 Channel::getTag(void)
 {
@@ -62,6 +62,9 @@ class Channel
     virtual int isDatastore(void);
     virtual int getDbTag(void);
     int getTag(void);
+
+    // sends any data a channel holds back, e.g. to send it in one message
+    virtual int flush(void);
     
     // methods to send/receive messages and objects on channels.
     virtual int sendObj(int commitTag,
@@ -37,14 +37,31 @@
 #include <MPI_ChannelAddress.h>
 #include <MovableObject.h>
 
+#include <string.h>
+#include <algorithm>
+
+// the types of the data in a packet
+enum {MPI_CHANNEL_CHAR = 1, MPI_CHANNEL_INT = 2, MPI_CHANNEL_DOUBLE = 3};
+
+static const size_t maxPacketSize = 65536;
+
+// the MPI tags of the packets, and of the data too large for a packet,
+// which is sent directly after a header
+enum {MPI_CHANNEL_PACKET = 0, MPI_CHANNEL_DIRECT = 1};
+
+std::vector<MPI_Channel *> MPI_Channel::aggregatingChannels;
+
 // MPI_Channel(unsigned int other_Port, char *other_InetAddr): 
 // 	constructor to open a socket with my inet_addr and with a port number 
 //	given by the OS. 
 
-MPI_Channel::MPI_Channel(int other)
- :otherTag(other), otherComm(MPI_COMM_WORLD)
+MPI_Channel::MPI_Channel(int other, bool aggregateData)
+ :otherTag(other), otherComm(MPI_COMM_WORLD),
+  aggregate(aggregateData), sendTag(other), sendComm(MPI_COMM_WORLD),
+  recvPos(0), recvTag(other)
 {
-  
+  if (aggregate == true)
+    aggregatingChannels.push_back(this);
 }    
 
 // ~MPI_Channel():
@@ -52,7 +69,199 @@ MPI_Channel::MPI_Channel(int other)
 
 MPI_Channel::~MPI_Channel()
 {
+  if (aggregate == false)
+    return;
+
+  aggregatingChannels.erase(std::remove(aggregatingChannels.begin(),
+					aggregatingChannels.end(), this),
+			    aggregatingChannels.end());
+
+  // the data held back and the sends in progress are completed
+  int finalized = 0;
+  MPI_Finalized(&finalized);
+  if (finalized != 0)
+    return;
+
+  this->flush();
+  for (size_t i=0; i<sentPackets.size(); i++)
+    MPI_Wait(&sentPackets[i].request, MPI_STATUS_IGNORE);
+}
+
+
+// int flush(void):
+//	Method to send the data held back in one message.
+
+int
+MPI_Channel::flush(void)
+{
+  if (aggregate == false || sendPacket.empty() == true)
+    return 0;
+
+  // reuse the buffer of a send that is complete
+  Packet *thePacket = 0;
+  for (size_t i=0; i<sentPackets.size() && thePacket == 0; i++) {
+    int done = 0;
+    MPI_Test(&sentPackets[i].request, &done, MPI_STATUS_IGNORE);
+    if (done != 0)
+      thePacket = &sentPackets[i];
+  }
+  if (thePacket == 0) {
+    sentPackets.push_back(Packet());
+    thePacket = &sentPackets.back();
+  }
+
+  thePacket->data.swap(sendPacket);
+  sendPacket.clear();
+
+  int res = MPI_Isend((void *)thePacket->data.data(), thePacket->data.size(), MPI_BYTE,
+		      sendTag, MPI_CHANNEL_PACKET, sendComm, &thePacket->request);
+  if (res != MPI_SUCCESS) {
+    opserr << "MPI_Channel::flush() - failed to send to process " << sendTag << endln;
+    return -1;
+  }
+
+  return 0;
+}
+
+
+// int flushAll(void):
+//	Method to send the data held back by all the channels of the process.
+
+int
+MPI_Channel::flushAll(void)
+{
+  int res = 0;
+  for (size_t i=0; i<aggregatingChannels.size(); i++)
+    if (aggregatingChannels[i]->flush() < 0)
+      res = -1;
+
+  return res;
+}
+
+
+// int sendData(int type, const void *data, int numEntries, int entrySize):
+//	Method to add data to the packet held back.
+
+int
+MPI_Channel::sendData(int type, const void *data, int numEntries, int entrySize)
+{
+  // a packet goes to one process
+  if (sendPacket.empty() == false && (otherTag != sendTag || otherComm != sendComm))
+    this->flush();
+  sendTag = otherTag;
+  sendComm = otherComm;
+
+  int header[2];
+  header[0] = type;
+  header[1] = numEntries;
+  size_t numBytes = (size_t)numEntries*entrySize;
+
+  // large data is not copied, it is sent after the data held back
+  if (numBytes >= maxPacketSize) {
+    if (this->flush() < 0)
+      return -1;
+    int res = MPI_Send((void *)header, 2, MPI_INT, sendTag, MPI_CHANNEL_DIRECT, sendComm);
+    if (res == MPI_SUCCESS)
+      res = MPI_Send((void *)data, numBytes, MPI_BYTE, sendTag, MPI_CHANNEL_DIRECT, sendComm);
+    if (res != MPI_SUCCESS) {
+      opserr << "MPI_Channel::sendData() - failed to send to process " << sendTag << endln;
+      return -1;
+    }
+    return 0;
+  }
+
+  size_t pos = sendPacket.size();
+  sendPacket.resize(pos + sizeof(header) + ((numBytes + 7) & ~(size_t)7));
+  memcpy(&sendPacket[pos], header, sizeof(header));
+  if (numBytes != 0)
+    memcpy(&sendPacket[pos + sizeof(header)], data, numBytes);
+
+  if (sendPacket.size() >= maxPacketSize)
+    return this->flush();
+
+  return 0;
+}
+
+
+// int recvData(int type, void *data, int numEntries, int entrySize, const char *method):
+//	Method to take the next data from the packet received, receiving the
+//	next packet if all its data has been taken.
+
+int
+MPI_Channel::recvData(int type, void *data, int numEntries, int entrySize, const char *method)
+{
+  if (recvPos < recvPacket.size() && otherTag != recvTag && otherTag != MPI_ANY_SOURCE) {
+    opserr << "MPI_Channel::" << method << "() - data from process " << recvTag;
+    opserr << " has not all been received\n";
+    return -1;
+  }
+
+  if (recvPos >= recvPacket.size()) {
+    // the other process may be waiting on data this process holds back
+    MPI_Channel::flushAll();
+
+    MPI_Status status;
+    MPI_Probe(otherTag, MPI_ANY_TAG, otherComm, &status);
+    recvTag = status.MPI_SOURCE;
+
+    if (status.MPI_TAG == MPI_CHANNEL_DIRECT) {
+      // large data, received in place if it is what is expected
+      int header[2];
+      MPI_Recv((void *)header, 2, MPI_INT, recvTag, MPI_CHANNEL_DIRECT, otherComm, &status);
+      MPI_Probe(recvTag, MPI_CHANNEL_DIRECT, otherComm, &status);
+      int count = 0;
+      MPI_Get_count(&status, MPI_BYTE, &count);
+      if (header[0] == type && header[1] == numEntries && count == numEntries*entrySize) {
+	MPI_Recv(data, count, MPI_BYTE, recvTag, MPI_CHANNEL_DIRECT, otherComm, &status);
+	return 0;
+      }
+
+      std::vector<char> discard(count);
+      MPI_Recv((void *)discard.data(), count, MPI_BYTE, recvTag, MPI_CHANNEL_DIRECT, otherComm, &status);
+      opserr << "MPI_Channel::" << method << "() -";
+      opserr << " incorrect data received: " << header[1] << " entries of type " << header[0];
+      opserr << " expected: " << numEntries << " of type " << type << endln;
+      return -1;
+    }
+
+    int count = 0;
+    MPI_Get_count(&status, MPI_BYTE, &count);
+    recvPacket.resize(count);
+    MPI_Recv((void *)recvPacket.data(), count, MPI_BYTE, recvTag, MPI_CHANNEL_PACKET, otherComm, &status);
+    recvPos = 0;
+  }
+
+  int header[2];
+  if (recvPos + sizeof(header) > recvPacket.size()) {
+    opserr << "MPI_Channel::" << method << "() - packet received is corrupt\n";
+    recvPos = recvPacket.size();
+    return -1;
+  }
+  memcpy(header, &recvPacket[recvPos], sizeof(header));
+
+  int size = (header[0] == MPI_CHANNEL_DOUBLE) ? sizeof(double) :
+    (header[0] == MPI_CHANNEL_INT) ? sizeof(int) : 1;
+  size_t numBytes = (size_t)header[1]*size;
+  size_t next = recvPos + sizeof(header) + ((numBytes + 7) & ~(size_t)7);
+  if (next > recvPacket.size()) {
+    opserr << "MPI_Channel::" << method << "() - packet received is corrupt\n";
+    recvPos = recvPacket.size();
+    return -1;
+  }
 
+  if (header[0] != type || header[1] != numEntries) {
+    opserr << "MPI_Channel::" << method << "() -";
+    opserr << " incorrect data received: " << header[1] << " entries of type " << header[0];
+    opserr << " expected: " << numEntries << " of type " << type << endln;
+    recvPos = next;
+    return -1;
+  }
+
+  if (numBytes != 0)
+    memcpy(data, &recvPacket[recvPos + sizeof(header)], numBytes);
+  recvPos = next;
+
+  return 0;
 }
 
 
@@ -160,6 +369,9 @@ MPI_Channel::recvMsg(int dbTag, int commitTag, Message &msg, ChannelAddress *the
       }		    
     }
 
+    if (aggregate == true)
+      return this->recvData(MPI_CHANNEL_CHAR, msg.data, msg.length, 1, "recvMsg");
+
     // if o.k. get a pointer to the data in the message and 
     // place the incoming data there
     int nleft,nread;
@@ -212,6 +424,9 @@ MPI_Channel::sendMsg(int dbTag, int commitTag, const Message &msg, ChannelAddres
       }		    
     }
 
+    if (aggregate == true)
+      return this->sendData(MPI_CHANNEL_CHAR, msg.data, msg.length, 1);
+
     // if o.k. get a pointer to the data in the message and 
     // place the incoming data there
     int nwrite, nleft;    
@@ -242,6 +457,9 @@ MPI_Channel::recvMatrix(int dbTag, int commitTag, Matrix &theMatrix, ChannelAddr
       }		    
     }
 
+    if (aggregate == true)
+      return this->recvData(MPI_CHANNEL_DOUBLE, theMatrix.data, theMatrix.dataSize, sizeof(double), "recvMatrix");
+
     // if o.k. get a pointer to the data in the Matrix and 
     // place the incoming data there
     int nleft,nread;
@@ -285,6 +503,9 @@ MPI_Channel::sendMatrix(int dbTag, int commitTag, const Matrix &theMatrix, Chann
       }		    
     }
 
+    if (aggregate == true)
+      return this->sendData(MPI_CHANNEL_DOUBLE, theMatrix.data, theMatrix.dataSize, sizeof(double));
+
     // if o.k. get a pointer to the data in the Matrix and 
     // place the incoming data there
     int nwrite, nleft;    
@@ -325,6 +546,9 @@ MPI_Channel::recvVector(int dbTag, int commitTag, Vector &theVector, ChannelAddr
 
     //    opserr << "MPI:recvVector " << otherTag << " " << theVector.Size() << endln;
 
+    if (aggregate == true)
+      return this->recvData(MPI_CHANNEL_DOUBLE, theVector.theData, theVector.sz, sizeof(double), "recvVector");
+
     // if o.k. get a pointer to the data in the Vector and 
     // place the incoming data there
     int nleft,nread;
@@ -369,6 +593,9 @@ MPI_Channel::sendVector(int dbTag, int commitTag, const Vector &theVector, Chann
       }		    
     }
 
+    if (aggregate == true)
+      return this->sendData(MPI_CHANNEL_DOUBLE, theVector.theData, theVector.sz, sizeof(double));
+
     // if o.k. get a pointer to the data in the Vector and 
     // place the incoming data there
     int nwrite, nleft;    
@@ -404,6 +631,9 @@ MPI_Channel::recvID(int dbTag, int commitTag, ID &theID, ChannelAddress *theAddr
       }		    
     }
 
+    if (aggregate == true)
+      return this->recvData(MPI_CHANNEL_INT, theID.data, theID.sz, sizeof(int), "recvID");
+
     // if o.k. get a pointer to the data in the ID and 
     // place the incoming data there
     int nleft,nread;
@@ -453,6 +683,9 @@ MPI_Channel::sendID(int dbTag, int commitTag, const ID &theID, ChannelAddress *t
       }		    
     }
 
+    if (aggregate == true)
+      return this->sendData(MPI_CHANNEL_INT, theID.data, theID.sz, sizeof(int));
+
     // if o.k. get a pointer to the data in the ID and 
     // place the incoming data there
     int nwrite, nleft;    
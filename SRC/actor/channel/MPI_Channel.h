@@ -30,6 +30,21 @@
 // MPI_Channel is a sub-class of channel. It is implemented with Berkeley
 // stream sockets using the TCP protocol. Messages delivery is garaunteed. 
 // Communication is full-duplex between a pair of connected sockets.
+//
+// With aggregate true the ID, Vector, Matrix and Message data sent are
+// copied into a packet, each behind an int type and size and padded to 8
+// bytes, and the packet is sent with MPI_Isend once it holds 64 KB, when
+// flush() is invoked, or before any aggregating channel of the process
+// receives, so that the process never waits on data it holds back. The
+// packet buffers of the sends not yet complete are kept in a pool and
+// reused. A packet is received whole and the receive methods take the
+// data from it in order. Data of 64 KB or more is not copied into a
+// packet: the packet held back is sent, then the data is sent directly
+// with a blocking MPI_Send, as without aggregation, and is received in
+// place. Both ends of a channel must aggregate or not.
+// Code that blocks other than in a channel receive, e.g. in a collective
+// or in a parallel solver, must first invoke flushAll(), or flush() on
+// the channels it sent on, as the barrier, send and recv commands do.
 
 #ifndef MPI_Channel_h
 #define MPI_Channel_h
@@ -37,10 +52,13 @@
 #include <mpi.h>
 #include <Channel.h>
 
+#include <vector>
+#include <deque>
+
 class MPI_Channel : public Channel
 {
   public:
-    MPI_Channel(int otherProcess);        
+    MPI_Channel(int otherProcess, bool aggregate = false);
     ~MPI_Channel();
 
     char *addToProgram(void);
@@ -74,12 +92,33 @@ class MPI_Channel : public Channel
     int sendID(int dbTag, int commitTag, const ID &theID, ChannelAddress *theAddress =0);
     int recvID(int dbTag, int commitTag, ID &theID, ChannelAddress *theAddress =0);    
     
+    int flush(void);
+    static int flushAll(void);
     
   protected:
 	
   private:
+    struct Packet {
+      MPI_Request request;
+      std::vector<char> data;
+    };
+
+    int sendData(int type, const void *data, int numEntries, int entrySize);
+    int recvData(int type, void *data, int numEntries, int entrySize, const char *method);
+
     int otherTag;
     MPI_Comm otherComm;    
+
+    bool aggregate;
+    std::vector<char> sendPacket;  // data held back
+    int sendTag;                   // where sendPacket goes
+    MPI_Comm sendComm;
+    std::deque<Packet> sentPackets;
+    std::vector<char> recvPacket;
+    size_t recvPos;                // next data in recvPacket
+    int recvTag;                   // where recvPacket came from
+
+    static std::vector<MPI_Channel *> aggregatingChannels;
 };
 
 
@@ -0,0 +1,219 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: two process echo test of MPI_Channel. Process 0 sends
+// an ID, Vector, Matrix, large Vector and Message, process 1 checks them
+// and sends the ID and Vector back changed. With aggregation on it also
+// checks that a size mismatch is reported and that data sent just before
+// a barrier, which flushes the channels as the barrier commands do,
+// arrives. Last it times the round trip of a small ID, a stream of small
+// Vectors answered by one ID, and a stream of 1 MB Vectors, e.g.
+//
+//      make mpiTest; mpirun -np 2 ./mpiTest 1 100
+
+#include <MPI_Channel.h>
+#include <ID.h>
+#include <Vector.h>
+#include <Matrix.h>
+#include <Message.h>
+#include <OPS_Globals.h>
+#include <StandardStream.h>
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+StandardStream sserr;
+OPS_Stream *opserrPtr = &sserr;
+
+static int
+echo(MPI_Channel &theChannel, int rank, int numRounds)
+{
+  for (int round=0; round<numRounds; round++) {
+    ID id(3);
+    Vector v(5);
+    Matrix m(2,3);
+    Vector big(100000);
+    char buffer[7];
+    Message msg(buffer, 7);
+
+    if (rank == 0) {
+      id(0) = round; id(1) = 2; id(2) = 3;
+      for (int i=0; i<5; i++)
+	v(i) = i + 0.5*round;
+      m(1,2) = 7.0;
+      big(99999) = round;
+      strcpy(buffer, "hello!");
+
+      theChannel.sendID(0, 0, id);
+      theChannel.sendVector(0, 0, v);
+      theChannel.sendMatrix(0, 0, m);
+      theChannel.sendVector(0, 0, big);
+      theChannel.sendMsg(0, 0, msg);
+
+      ID idBack(3);
+      Vector vBack(5);
+      int res = theChannel.recvID(0, 0, idBack);
+      res += theChannel.recvVector(0, 0, vBack);
+      if (res != 0 || idBack(0) != round+1 || vBack(4) != 2*(4 + 0.5*round)) {
+	fprintf(stderr, "round %d: wrong data echoed\n", round);
+	return -1;
+      }
+
+    } else {
+      int res = theChannel.recvID(0, 0, id);
+      res += theChannel.recvVector(0, 0, v);
+      res += theChannel.recvMatrix(0, 0, m);
+      res += theChannel.recvVector(0, 0, big);
+      res += theChannel.recvMsg(0, 0, msg);
+      if (res != 0 || id(0) != round || m(1,2) != 7.0 || big(99999) != round ||
+	  strcmp(buffer, "hello!") != 0) {
+	fprintf(stderr, "round %d: wrong data received\n", round);
+	return -1;
+      }
+
+      id(0) += 1;
+      v *= 2.0;
+      theChannel.sendID(0, 0, id);
+      theChannel.sendVector(0, 0, v);
+    }
+  }
+
+  return 0;
+}
+
+// the seconds per round trip of an ID(1), and the MB/s of numSends
+// Vectors of size n sent by process 0 and answered by one ID
+static void
+timeChannel(MPI_Channel &theChannel, int rank, int numRounds)
+{
+  ID id(1);
+  MPI_Barrier(MPI_COMM_WORLD);
+  double start = MPI_Wtime();
+  for (int i=0; i<numRounds; i++) {
+    if (rank == 0) {
+      theChannel.sendID(0, 0, id);
+      theChannel.recvID(0, 0, id);
+    } else {
+      theChannel.recvID(0, 0, id);
+      theChannel.sendID(0, 0, id);
+    }
+  }
+  double latency = (MPI_Wtime() - start)/numRounds;
+  if (rank == 0)
+    printf("  round trip of an ID(1): %.2f us\n", latency*1.0e6);
+
+  int sizes[2] = {8, 131072};
+  int numSends[2] = {100*numRounds, numRounds};
+  for (int j=0; j<2; j++) {
+    Vector v(sizes[j]);
+    MPI_Channel::flushAll();
+    MPI_Barrier(MPI_COMM_WORLD);
+    start = MPI_Wtime();
+    if (rank == 0) {
+      for (int i=0; i<numSends[j]; i++)
+	theChannel.sendVector(0, 0, v);
+      theChannel.recvID(0, 0, id);
+    } else {
+      for (int i=0; i<numSends[j]; i++)
+	theChannel.recvVector(0, 0, v);
+      theChannel.sendID(0, 0, id);
+      theChannel.flush();
+    }
+    double time = MPI_Wtime() - start;
+    if (rank == 0)
+      printf("  %d Vectors of %d doubles: %.3f s, %.1f MB/s\n", numSends[j], sizes[j],
+	     time, numSends[j]*sizes[j]*sizeof(double)/time/1.0e6);
+  }
+}
+
+int main(int argc, char **argv)
+{
+  MPI_Init(&argc, &argv);
+
+  int rank = 0;
+  int numProcesses = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &numProcesses);
+  if (numProcesses != 2) {
+    if (rank == 0)
+      fprintf(stderr, "usage: mpirun -np 2 %s aggregate? numRounds?\n", argv[0]);
+    MPI_Finalize();
+    return 1;
+  }
+
+  bool aggregate = (argc > 1) ? atoi(argv[1]) != 0 : true;
+  int numRounds = (argc > 2) ? atoi(argv[2]) : 100;
+
+  int numErrors = 0;
+  {
+    MPI_Channel theChannel(1-rank, aggregate);
+
+    if (echo(theChannel, rank, numRounds) != 0)
+      numErrors++;
+
+    if (aggregate == true) {
+      // the receiver checks the size of what it gets
+      if (rank == 0) {
+	ID id(2);
+	theChannel.sendID(0, 0, id);
+	theChannel.flush();
+      } else {
+	ID id(4);
+	if (theChannel.recvID(0, 0, id) == 0) {
+	  fprintf(stderr, "size mismatch not reported\n");
+	  numErrors++;
+	}
+      }
+
+      // data held back when the sender enters a barrier, which
+      // deadlocks unless the barrier flushes the channels
+      ID id(1);
+      if (rank == 0) {
+	id(0) = 17;
+	theChannel.sendID(0, 0, id);
+	MPI_Channel::flushAll();
+	MPI_Barrier(MPI_COMM_WORLD);
+      } else {
+	theChannel.recvID(0, 0, id);
+	MPI_Channel::flushAll();
+	MPI_Barrier(MPI_COMM_WORLD);
+	if (id(0) != 17) {
+	  fprintf(stderr, "data sent before the barrier not received\n");
+	  numErrors++;
+	}
+      }
+    }
+  }
+
+  int allErrors = 0;
+  MPI_Allreduce(&numErrors, &allErrors, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+  if (rank == 0)
+    printf("%s: aggregate %d, %d rounds\n", allErrors == 0 ? "PASSED" : "FAILED",
+	   aggregate ? 1 : 0, numRounds);
+
+  if (allErrors == 0) {
+    MPI_Channel theChannel(1-rank, aggregate);
+    timeChannel(theChannel, rank, numRounds);
+  }
+
+  MPI_Finalize();
+  return allErrors == 0 ? 0 : 1;
+}
@@ -33,6 +33,8 @@
 #include <ID.h>
 
 #include <mpi.h>
+#include <stdlib.h>
+#include <string.h>
 
 MPI_MachineBroker::MPI_MachineBroker(FEM_ObjectBroker *theBroker, int argc, char **argv)
   :MachineBroker(theBroker)
@@ -45,9 +47,18 @@ MPI_MachineBroker::MPI_MachineBroker(FEM_ObjectBroker *theBroker, int argc, char
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
   MPI_Comm_size(MPI_COMM_WORLD, &size);
 
+  // the processes must agree on the mode of the channels
+  int aggregate = 0;
+  if (rank == 0) {
+    const char *mode = getenv("OPENSEES_MPI_AGGREGATE");
+    if (mode != 0 && strcmp(mode, "1") == 0)
+      aggregate = 1;
+  }
+  MPI_Bcast(&aggregate, 1, MPI_INT, 0, MPI_COMM_WORLD);
+
   theChannels = new MPI_Channel *[size];
   for (int i=0; i<size; i++) {
-    theChannels[i] = new MPI_Channel(i);
+    theChannels[i] = new MPI_Channel(i, aggregate != 0);
   }
   usedChannels = new ID(size);
   usedChannels->Zero();
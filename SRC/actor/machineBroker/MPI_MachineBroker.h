@@ -28,7 +28,9 @@
 //
 // Purpose: This file contains the class definition for MPI_MachineBroker.
 // MPI_MachineBroker is the broker responsible for monitoring the usage of
-// the processes in an mpi run.
+// the processes in an mpi run. If the environment variable
+// OPENSEES_MPI_AGGREGATE is set to 1 in process 0, the channels of all
+// the processes aggregate their data, see MPI_Channel.
 //
 // What: "@(#) MPI_MachineBroker.h, revA"
 
@@ -64,6 +64,7 @@ static void
 parseAcceleratorArgs(int &incrementTangent, int &iterateTangent,
 		     int &maxDim, int &factorOnce,
 		     int &numTerms, bool &cutOut, double R[2],
+		     int &refactorSteps, int &refactorIter,
 		     bool wantMaxDim, bool wantNumTerms, bool wantCutOut)
 {
     bool iterateSeen = false;
@@ -124,6 +125,18 @@ parseAcceleratorArgs(int &incrementTangent, int &iterateTangent,
 	    factorOnce = 1;
 	    factorOnceExplicit = true;
 	}
+	else if ((strcmp(flag, "-refactorSteps") == 0 || strcmp(flag, "-refactorIter") == 0)
+		 && OPS_GetNumRemainingInputArgs() > 0) {
+	    int numdata = 1;
+	    int value = 0;
+	    if (OPS_GetIntInput(&numdata, &value) < 0) {
+		opserr << "WARNING accelerated-Newton failed to read " << flag << "\n";
+	    } else if (strcmp(flag, "-refactorSteps") == 0) {
+		refactorSteps = value;
+	    } else {
+		refactorIter = value;
+	    }
+	}
     }
 
     if (!iterateSeen && factorOnceExplicit && factorOnce != 0) {
@@ -147,6 +160,17 @@ parseAcceleratorArgs(int &incrementTangent, int &iterateTangent,
 	factorOnce = 1;
 }
 
+static AcceleratedNewton *
+newAcceleratedNewton(Accelerator *theAccel, int incrementTangent, int factorOnce,
+		     int refactorSteps, int refactorIter)
+{
+    AcceleratedNewton *theAlgo =
+	new AcceleratedNewton(theAccel, incrementTangent, factorOnce);
+    if (refactorSteps > 0 || refactorIter > 0)
+	theAlgo->setRefactorPolicy(refactorSteps, refactorIter);
+    return theAlgo;
+}
+
 void *
 OPS_KrylovNewton()
 {
@@ -154,18 +178,21 @@ OPS_KrylovNewton()
     int iterateTangent = CURRENT_TANGENT;
     int maxDim = 3;
     int factorOnce = 0;
+    int refactorSteps = 0;
+    int refactorIter = 0;
     int numTerms = 0;
     bool cutOut = false;
     double R[2];
 
     parseAcceleratorArgs(incrementTangent, iterateTangent, maxDim, factorOnce,
-			 numTerms, cutOut, R,
+			 numTerms, cutOut, R, refactorSteps, refactorIter,
 			 /*wantMaxDim=*/true,
 			 /*wantNumTerms=*/false,
 			 /*wantCutOut=*/false);
 
     Accelerator *theAccel = new KrylovAccelerator(maxDim, iterateTangent);
-    return new AcceleratedNewton(theAccel, incrementTangent, factorOnce);
+    return newAcceleratedNewton(theAccel, incrementTangent, factorOnce,
+				refactorSteps, refactorIter);
 }
 
 void *
@@ -175,18 +202,21 @@ OPS_RaphsonNewton()
     int iterateTangent = CURRENT_TANGENT;
     int maxDim = 0;
     int factorOnce = 0;
+    int refactorSteps = 0;
+    int refactorIter = 0;
     int numTerms = 0;
     bool cutOut = false;
     double R[2];
 
     parseAcceleratorArgs(incrementTangent, iterateTangent, maxDim, factorOnce,
-			 numTerms, cutOut, R,
+			 numTerms, cutOut, R, refactorSteps, refactorIter,
 			 /*wantMaxDim=*/false,
 			 /*wantNumTerms=*/false,
 			 /*wantCutOut=*/false);
 
     Accelerator *theAccel = new RaphsonAccelerator(iterateTangent);
-    return new AcceleratedNewton(theAccel, incrementTangent, factorOnce);
+    return newAcceleratedNewton(theAccel, incrementTangent, factorOnce,
+				refactorSteps, refactorIter);
 }
 
 void *
@@ -196,12 +226,14 @@ OPS_SecantNewton()
     int iterateTangent = CURRENT_TANGENT;
     int maxDim = 3;
     int factorOnce = 0;
+    int refactorSteps = 0;
+    int refactorIter = 0;
     int numTerms = 2;
     bool cutOut = false;
     double R[2];
 
     parseAcceleratorArgs(incrementTangent, iterateTangent, maxDim, factorOnce,
-			 numTerms, cutOut, R,
+			 numTerms, cutOut, R, refactorSteps, refactorIter,
 			 /*wantMaxDim=*/true,
 			 /*wantNumTerms=*/true,
 			 /*wantCutOut=*/true);
@@ -224,7 +256,8 @@ OPS_SecantNewton()
 	    theAccel = new SecantAccelerator3(maxDim, iterateTangent);
     }
 
-    return new AcceleratedNewton(theAccel, incrementTangent, factorOnce);
+    return newAcceleratedNewton(theAccel, incrementTangent, factorOnce,
+				refactorSteps, refactorIter);
 }
 
 void *
@@ -234,18 +267,21 @@ OPS_PeriodicNewton()
     int iterateTangent = CURRENT_TANGENT;
     int maxDim = 3;
     int factorOnce = 0;
+    int refactorSteps = 0;
+    int refactorIter = 0;
     int numTerms = 0;
     bool cutOut = false;
     double R[2];
 
     parseAcceleratorArgs(incrementTangent, iterateTangent, maxDim, factorOnce,
-			 numTerms, cutOut, R,
+			 numTerms, cutOut, R, refactorSteps, refactorIter,
 			 /*wantMaxDim=*/true,
 			 /*wantNumTerms=*/false,
 			 /*wantCutOut=*/false);
 
     Accelerator *theAccel = new PeriodicAccelerator(maxDim, iterateTangent);
-    return new AcceleratedNewton(theAccel, incrementTangent, factorOnce);
+    return newAcceleratedNewton(theAccel, incrementTangent, factorOnce,
+				refactorSteps, refactorIter);
 }
 
 void *
@@ -255,12 +291,14 @@ OPS_MillerNewton()
     int iterateTangent = CURRENT_TANGENT;
     int maxDim = 3;
     int factorOnce = 0;
+    int refactorSteps = 0;
+    int refactorIter = 0;
     int numTerms = 0;
     bool cutOut = false;
     double R[2];
 
     parseAcceleratorArgs(incrementTangent, iterateTangent, maxDim, factorOnce,
-			 numTerms, cutOut, R,
+			 numTerms, cutOut, R, refactorSteps, refactorIter,
 			 /*wantMaxDim=*/true,
 			 /*wantNumTerms=*/false,
 			 /*wantCutOut=*/false);
@@ -269,7 +307,8 @@ OPS_MillerNewton()
 	   << "using AcceleratedNewton without MillerAccelerator.\n";
 
     Accelerator *theAccel = 0;
-    return new AcceleratedNewton(theAccel, incrementTangent, factorOnce);
+    return newAcceleratedNewton(theAccel, incrementTangent, factorOnce,
+				refactorSteps, refactorIter);
 }
 
 // Constructor
@@ -337,6 +376,7 @@ AcceleratedNewton::domainChanged(void)
   // Cached factorization invalid after domain change / setSize - reform increment tangent next solve.
   if (factorOnce == 2)
     factorOnce = 1;
+  this->resetTangent();
   return 0;
 }
 
@@ -385,7 +425,9 @@ AcceleratedNewton::solveCurrentStep(void)
   }
 
   // Increment-side formTangent only; iterate-side uses accelerator/updateTangent.
-  if (factorOnce != 2) {
+  // Under a refactor policy the tangent factored in a previous step is reused.
+  bool reuse = this->reuseTangent();
+  if (factorOnce != 2 && !reuse) {
     if (theIntegrator->formTangent(tangent) < 0){
       opserr << "WARNING AcceleratedNewton::solveCurrentStep() -";
       opserr << "the Integrator failed in formTangent()\n";
@@ -396,6 +438,7 @@ AcceleratedNewton::solveCurrentStep(void)
 
     // Count factorization of the first tangent
     numFactorizations++;
+    this->tangentFormed();
   }
   
   // set itself as the ConvergenceTest objects EquiSolnAlgo
@@ -469,8 +512,10 @@ AcceleratedNewton::solveCurrentStep(void)
 	  opserr << "the Accelerator failed in updateTangent()\n";
 	  return -1;
 	}
-	if (ret > 0)
+	if (ret > 0) {
 	  numFactorizations++;
+	  this->tangentFormed();
+	}
       }
     }
     //opserr << "ACCEL: " << numFactorizations << endln;
@@ -485,8 +530,11 @@ AcceleratedNewton::solveCurrentStep(void)
   if (result == -2) {
     opserr << "AcceleratedNewton::solveCurrentStep() -";
     opserr << "The ConvergenceTest object failed in test()\n";
+    this->tangentUsed(k-1, -3);
     return -3;
   }
+
+  this->tangentUsed(k-1, result);
   
   // note - if positive result we are returning what the convergence
   // test returned which should be the number of iterations
@@ -47,7 +47,8 @@
 
 EquiSolnAlgo::EquiSolnAlgo(int clasTag)
 :SolutionAlgorithm(clasTag),
- theModel(0), theIntegrator(0), theSysOfEqn(0), theTest(0)
+ theModel(0), theIntegrator(0), theSysOfEqn(0), theTest(0),
+ refactorSteps(0), refactorIter(0), stepsWithTangent(0), tangentValid(false)
 {
 
 }
@@ -111,3 +112,59 @@ EquiSolnAlgo::getLinearSOEptr(void) const
 }
     
 
+
+int
+EquiSolnAlgo::setRefactorPolicy(int everyNumSteps, int maxNumIter)
+{
+  refactorSteps = everyNumSteps;
+  refactorIter = maxNumIter;
+  this->resetTangent();
+  return 0;
+}
+
+
+// called at the start of a step; returns true if the tangent factored
+// in a previous step is to be used again, in which case the subclass
+// must skip formTangent() so that the LinearSOESolver only performs
+// back substitutions. The tangent is invalidated until the step has
+// converged, so a failed step always leads to a refactorization.
+bool
+EquiSolnAlgo::reuseTangent(void)
+{
+  bool reuse = tangentValid;
+  if (refactorSteps <= 0 && refactorIter <= 0)
+    reuse = false;
+  else if (refactorSteps > 0 && stepsWithTangent >= refactorSteps)
+    reuse = false;
+
+  tangentValid = false;
+  return reuse;
+}
+
+
+void
+EquiSolnAlgo::tangentFormed(void)
+{
+  stepsWithTangent = 0;
+}
+
+
+void
+EquiSolnAlgo::tangentUsed(int numIter, int result)
+{
+  if (result < 0) {
+    tangentValid = false;
+    return;
+  }
+
+  stepsWithTangent++;
+  tangentValid = (refactorIter <= 0 || numIter <= refactorIter);
+}
+
+
+void
+EquiSolnAlgo::resetTangent(void)
+{
+  stepsWithTangent = 0;
+  tangentValid = false;
+}
@@ -67,6 +67,11 @@ class EquiSolnAlgo: public SolutionAlgorithm
 
     virtual void Print(OPS_Stream &s, int flag =0) =0;    
 
+    // tangent refactor policy: reuse the factored tangent across steps,
+    // refactoring every everyNumSteps steps or after a step needing
+    // more than maxNumIter iterations (<= 0 disables either criterion)
+    virtual int setRefactorPolicy(int everyNumSteps, int maxNumIter);
+
     virtual int getNumFactorizations(void) {return 0;}
     virtual int getNumIterations(void) {return 0;}
     virtual double getTotalTimeCPU(void)   {return 0.0;}
@@ -83,12 +88,23 @@ class EquiSolnAlgo: public SolutionAlgorithm
     LinearSOE	            *getLinearSOEptr(void) const;
 
   protected:
+    // used by subclasses to carry out the refactor policy
+    bool reuseTangent(void);
+    void tangentFormed(void);
+    void tangentUsed(int numIter, int result);
+    void resetTangent(void);
+
     ConvergenceTest *theTest;
     
   private:
     AnalysisModel 	  *theModel;
     IncrementalIntegrator *theIntegrator;
     LinearSOE 		  *theSysOfEqn;
+
+    int refactorSteps;     // max number of steps a tangent is used for
+    int refactorIter;      // refactor after a step with more iterations
+    int stepsWithTangent;  // steps completed with the current tangent
+    bool tangentValid;     // factored tangent in the SOE may be reused
 };
 
 #endif
@@ -55,6 +55,8 @@ void* OPS_ModifiedNewton()
   int factoronce = 0;
   double iFactor = 0;
   double cFactor = 1;
+  int refactorSteps = 0;
+  int refactorIter = 0;
 
   while (OPS_GetNumRemainingInputArgs() > 0) {
     const char* type = OPS_GetString();
@@ -80,16 +82,31 @@ void* OPS_ModifiedNewton()
         iFactor = data[0];
         cFactor = data[1];
       }
+    } else if (strcmp(type,"-refactorSteps") == 0 || strcmp(type,"-refactorIter") == 0) {
+      int numData = 1;
+      int value = 0;
+      if (OPS_GetNumRemainingInputArgs() < 1 || OPS_GetIntInput(&numData,&value) < 0) {
+        opserr << "WARNING invalid value for " << type << "\n";
+        return 0;
+      }
+      if (strcmp(type,"-refactorSteps") == 0)
+        refactorSteps = value;
+      else
+        refactorIter = value;
     }
   }
 
-  return new ModifiedNewton(formTangent, iFactor, cFactor, factoronce);
+  ModifiedNewton *theAlgo = new ModifiedNewton(formTangent, iFactor, cFactor, factoronce);
+  if (refactorSteps > 0 || refactorIter > 0)
+    theAlgo->setRefactorPolicy(refactorSteps, refactorIter);
+
+  return theAlgo;
 }
 
 // Constructor
 ModifiedNewton::ModifiedNewton(int theTangentToUse, double iFact, double cFact, int factOnce)
 :EquiSolnAlgo(EquiALGORITHM_TAGS_ModifiedNewton),
- tangent(theTangentToUse), numIterations(0), factorOnce(factOnce),
+ tangent(theTangentToUse), numIterations(0), numFactorizations(0), factorOnce(factOnce),
  iFactor(iFact), cFactor(cFact)
 {
   
@@ -98,7 +115,7 @@ ModifiedNewton::ModifiedNewton(int theTangentToUse, double iFact, double cFact,
 
 ModifiedNewton::ModifiedNewton(ConvergenceTest &theT, int theTangentToUse, double iFact, double cFact, int factOnce)
 :EquiSolnAlgo(EquiALGORITHM_TAGS_ModifiedNewton),
- tangent(theTangentToUse), numIterations(0), factorOnce(factOnce),
+ tangent(theTangentToUse), numIterations(0), numFactorizations(0), factorOnce(factOnce),
  iFactor(iFact), cFactor(cFact)
 {
 
@@ -116,6 +133,7 @@ ModifiedNewton::domainChanged(void)
   // Domain change: cached factorization invalid after setSize - reform tangent next solve.
   if (factorOnce == 2)
     factorOnce = 1;
+  this->resetTangent();
   return 0;
 }
 
@@ -146,12 +164,17 @@ ModifiedNewton::solveCurrentStep(void)
     }	
 
     SOLUTION_ALGORITHM_tangentFlag = tangent;
-    if (factorOnce!=2) {
+    // with a refactor policy the factored tangent of the last step is
+    // kept and each iteration only costs a back substitution
+    bool reuse = this->reuseTangent();
+    if (factorOnce!=2 && !reuse) {
       if (theIncIntegratorr->formTangent(tangent, iFactor, cFactor) < 0){
         opserr << "WARNING ModifiedNewton::solveCurrentStep() -";
         opserr << "the Integrator failed in formTangent()\n";
         return -1;
       }	
+      numFactorizations++;
+      this->tangentFormed();
       if (factorOnce==1) {
         factorOnce =2;
       }
@@ -206,8 +229,11 @@ ModifiedNewton::solveCurrentStep(void)
       if (factorOnce ==2) {
         factorOnce = 1;
       }
+      this->tangentUsed(numIterations, -3);
       return -3;
     }
+
+    this->tangentUsed(numIterations, result);
     return result;
 }
 
@@ -249,3 +275,9 @@ ModifiedNewton::getNumIterations(void)
 {
   return numIterations;
 }
+
+int
+ModifiedNewton::getNumFactorizations(void)
+{
+  return numFactorizations;
+}
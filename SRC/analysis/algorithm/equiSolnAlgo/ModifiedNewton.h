@@ -55,6 +55,7 @@ class ModifiedNewton: public EquiSolnAlgo
     int solveCurrentStep(void);
     int domainChanged(void);
     int getNumIterations(void);
+    int getNumFactorizations(void);
 
     virtual int sendSelf(int commitTag, Channel &theChannel);
     virtual int recvSelf(int commitTag, Channel &theChannel, 
@@ -67,6 +68,7 @@ class ModifiedNewton: public EquiSolnAlgo
   private:
     int tangent;
     int numIterations;
+    int numFactorizations;
     // factorOnce: 0=every iter; 1->2 after one formTangent; 2=skip formTangent (reuse factor).
     // domainChanged() resets 2->1.
     int factorOnce;
@@ -55,6 +55,7 @@
 #include <Matrix.h>
 #include <ID.h>
 #include <Graph.h>
+#include <Profiler.h>
 
 // Constructor
 //    sets theModel and theSysOFEqn to 0 and the Algorithm to the one supplied
@@ -167,6 +168,9 @@ DirectIntegrationAnalysis::initialize(void)
 int 
 DirectIntegrationAnalysis::analyze(int numSteps, double dT, bool flush)
 {
+  static int analyzeRegion = Profiler::getRegion("analyze");
+  ProfilerScope theScope(analyzeRegion);
+
   int result = 0;
 
   for (int i=0; i<numSteps; i++) {
@@ -190,6 +194,13 @@ DirectIntegrationAnalysis::analyze(int numSteps, double dT, bool flush)
 int 
 DirectIntegrationAnalysis::analyzeStep(double dT)
 {
+  static int stepRegion = Profiler::getRegion("step");
+  static int newStepRegion = Profiler::getRegion("newStep");
+  static int solveRegion = Profiler::getRegion("solveCurrentStep");
+  static int commitRegion = Profiler::getRegion("commitStep");
+  static int iterationCounter = Profiler::getCounter("iterations");
+  ProfilerScope theScope(stepRegion);
+
   int result = 0;
   Domain *the_Domain = this->getDomainPtr();
 
@@ -210,7 +221,11 @@ DirectIntegrationAnalysis::analyzeStep(double dT)
     }	
   }
   
-  if (theIntegrator->newStep(dT) < 0) {
+  {
+    ProfilerScope newStepScope(newStepRegion);
+    result = theIntegrator->newStep(dT);
+  }
+  if (result < 0) {
     opserr << "DirectIntegrationAnalysis::analyze() - the Integrator failed";
     opserr << " at time " << the_Domain->getCurrentTime() << endln;
     the_Domain->revertToLastCommit();
@@ -218,7 +233,15 @@ DirectIntegrationAnalysis::analyzeStep(double dT)
     return -2;
   }
   
-  result = theAlgorithm->solveCurrentStep();
+  {
+    ProfilerScope solveScope(solveRegion);
+    result = theAlgorithm->solveCurrentStep();
+  }
+  if (Profiler::isEnabled()) {
+    ConvergenceTest *theTest = theAlgorithm->getConvergenceTest();
+    if (theTest != 0)
+      Profiler::count(iterationCounter, theTest->getNumTests());
+  }
   if (result < 0) {
     opserr << "DirectIntegrationAnalysis::analyze() - the Algorithm failed";
     opserr << " at time " << the_Domain->getCurrentTime() << endln;
@@ -245,7 +268,10 @@ DirectIntegrationAnalysis::analyzeStep(double dT)
 #endif
   // AddingSensitivity:END //////////////////////////////////////
   
-  result = theIntegrator->commit();
+  {
+    ProfilerScope commitScope(commitRegion);
+    result = theIntegrator->commit();
+  }
   if (result < 0) {
     opserr << "DirectIntegrationAnalysis::analyze() - ";
     opserr << "the Integrator failed to commit";
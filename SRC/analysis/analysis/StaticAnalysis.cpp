@@ -46,6 +46,7 @@
 #include <Matrix.h>
 #include <ID.h>
 #include <Graph.h>
+#include <Profiler.h>
 //#include <Timer.h>
 #include <Integrator.h>//Abbas
 
@@ -126,11 +127,21 @@ StaticAnalysis::clearAll(void)
 int 
 StaticAnalysis::analyze(int numSteps, bool flush)
 {
+    static int analyzeRegion = Profiler::getRegion("analyze");
+    static int stepRegion = Profiler::getRegion("step");
+    static int newStepRegion = Profiler::getRegion("newStep");
+    static int solveRegion = Profiler::getRegion("solveCurrentStep");
+    static int commitRegion = Profiler::getRegion("commitStep");
+    static int iterationCounter = Profiler::getCounter("iterations");
+    ProfilerScope theScope(analyzeRegion);
+
     int result = 0;
     Domain *the_Domain = this->getDomainPtr();
 
     for (int i=0; i<numSteps; i++) {
 
+	ProfilerScope stepScope(stepRegion);
+
 	result = theAnalysisModel->analysisStep();
 
 	if (result < 0) {
@@ -160,7 +171,10 @@ StaticAnalysis::analyze(int numSteps, bool flush)
 	    }	
 	}
 
-	result = theIntegrator->newStep();
+	{
+	    ProfilerScope newStepScope(newStepRegion);
+	    result = theIntegrator->newStep();
+	}
 	if (result < 0) {
 	    opserr << "StaticAnalysis::analyze() - the Integrator failed";
 	    opserr << " at step: " << i << " with domain at load factor ";
@@ -172,7 +186,15 @@ StaticAnalysis::analyze(int numSteps, bool flush)
 	    return -2;
 	}
 
-           result = theAlgorithm->solveCurrentStep();
+	{
+	    ProfilerScope solveScope(solveRegion);
+	    result = theAlgorithm->solveCurrentStep();
+	}
+	if (Profiler::isEnabled()) {
+	    ConvergenceTest *theTest = theAlgorithm->getConvergenceTest();
+	    if (theTest != 0)
+		Profiler::count(iterationCounter, theTest->getNumTests());
+	}
 	if (result < 0) {
 	    opserr << "StaticAnalysis::analyze() - the Algorithm failed";
 	    opserr << " at step: " << i << " with domain at load factor ";
@@ -204,7 +226,10 @@ StaticAnalysis::analyze(int numSteps, bool flush)
 
 // AddingSensitivity:END //////////////////////////////////////
 
-	result = theIntegrator->commit();
+	{
+	    ProfilerScope commitScope(commitRegion);
+	    result = theIntegrator->commit();
+	}
 	if (result < 0) {
 	    opserr << "StaticAnalysis::analyze() - ";
 	    opserr << "the Integrator failed to commit";
@@ -49,9 +49,34 @@
 // static variables initialisation
 Matrix DOF_Group::errMatrix(1,1);
 Vector DOF_Group::errVect(1);
-Matrix **DOF_Group::theMatrices; // array of pointers to class wide matrices
-Vector **DOF_Group::theVectors;  // array of pointers to class widde vectors
-int DOF_Group::numDOFs(0);           // number of objects
+
+// the class wide matrix and vector objects used to return the tangent 
+// and unbalance; one set per thread so that DOF_Groups of the same size
+// can be formed concurrently. Within a thread the results of two groups
+// of the same size still share one object.
+namespace {
+  class DOF_GroupWorkArea {
+  public:
+    DOF_GroupWorkArea() {
+      for (int i=0; i<=MAX_NUM_DOF; i++) {
+	theMatrices[i] = 0;
+	theVectors[i] = 0;
+      }
+    }
+    ~DOF_GroupWorkArea() {
+      for (int i=0; i<=MAX_NUM_DOF; i++) {
+	if (theMatrices[i] != 0)
+	  delete theMatrices[i];
+	if (theVectors[i] != 0)
+	  delete theVectors[i];
+      }
+    }
+    Matrix *theMatrices[MAX_NUM_DOF+1]; // pointers to class wide matrices
+    Vector *theVectors[MAX_NUM_DOF+1];  // pointers to class wide vectors
+  };
+
+  thread_local DOF_GroupWorkArea theWorkArea;
+}
 
 
 //  DOF_Group(Node *);
@@ -61,7 +86,7 @@ DOF_Group::DOF_Group(int tag, Node *node)
 :TaggedObject(tag),
  unbalance(0), tangent(0), myNode(node), 
  myID(node->getNumberDOF()), 
- numDOF(node->getNumberDOF())
+ numDOF(node->getNumberDOF()), classWide(false)
 {
     // get number of DOF & verify valid
     int numDOF = node->getNumberDOF();
@@ -82,43 +107,11 @@ DOF_Group::DOF_Group(int tag, Node *node)
     for (int i=0; i<numDOF; i++)
 	myID(i) = -2;
     
-    // if this is the first DOF_Group we now
-    // create the arrays used to store pointers to class wide
-    // matrix and vector objects used to return tangent and residual
-    if (numDOFs == 0) {
-	theMatrices = new Matrix *[MAX_NUM_DOF+1];
-	theVectors  = new Vector *[MAX_NUM_DOF+1];
-	
-	if (theMatrices == 0 || theVectors == 0) {
-	    opserr << "DOF_Group::DOF_Group(Node *) ";
-	    opserr << " ran out of memory";	    
-	}
-	for (int i=0; i<MAX_NUM_DOF; i++) {
-	    theMatrices[i] = 0;
-	    theVectors[i] = 0;
-	}
-    }    
-    
     // set the pointers for the tangent and residual
     if (numDOF <= MAX_NUM_DOF) {
 	// use class wide objects
-	if (theVectors[numDOF] == 0) {
-	    // have to create matrix and vector of size as none yet created
-	    theVectors[numDOF] = new Vector(numDOF);
-	    theMatrices[numDOF] = new Matrix(numDOF,numDOF);
-	    unbalance = theVectors[numDOF];
-	    tangent = theMatrices[numDOF];
-	    if (unbalance == 0 || unbalance->Size() != numDOF ||	
-		tangent == 0 || tangent->noCols() != numDOF)	{  
-		opserr << "DOF_Group::DOF_Group(Node *) ";
-		opserr << " ran out of memory for vector/Matrix of size :";
-		opserr << numDOF << endln;
-		exit(-1);
-	    }
-	} else {
-	    unbalance = theVectors[numDOF];
-	    tangent = theMatrices[numDOF];
-	}
+	classWide = true;
+	this->setWorkArea();
     } else {
 	// create matrices and vectors for each object instance
 	unbalance = new Vector(numDOF);
@@ -132,8 +125,6 @@ DOF_Group::DOF_Group(int tag, Node *node)
 	    exit(-1);
 	}
     }
-    
-    numDOFs++;
 }
 
 
@@ -141,7 +132,7 @@ DOF_Group::DOF_Group(int tag, int ndof)
 :TaggedObject(tag),
  unbalance(0), tangent(0), myNode(0), 
  myID(ndof), 
- numDOF(ndof)
+ numDOF(ndof), classWide(false)
 {
     // get number of DOF & verify valid
     int numDOF = ndof;
@@ -162,48 +153,16 @@ DOF_Group::DOF_Group(int tag, int ndof)
     for (int i=0; i<numDOF; i++)
 	myID(i) = -2;
     
-    // if this is the first DOF_Group we now
-    // create the arrays used to store pointers to class wide
-    // matrix and vector objects used to return tangent and residual
-    if (numDOFs == 0) {
-	theMatrices = new Matrix *[MAX_NUM_DOF+1];
-	theVectors  = new Vector *[MAX_NUM_DOF+1];
-	
-	if (theMatrices == 0 || theVectors == 0) {
-	    opserr << "DOF_Group::DOF_Group(int, int ndof) ";
-	    opserr << " ran out of memory";	    
-	}
-	for (int i=0; i<MAX_NUM_DOF; i++) {
-	    theMatrices[i] = 0;
-	    theVectors[i] = 0;
-	}
-    }    
-
     // set the pointers for the tangent and residual
     if (numDOF <= MAX_NUM_DOF) {
 	// use class wide objects
-	if (theVectors[numDOF] == 0) {
-	    // have to create matrix and vector of size as none yet created
-	    theVectors[numDOF] = new Vector(numDOF);
-	    theMatrices[numDOF] = new Matrix(numDOF,numDOF);
-	    unbalance = theVectors[numDOF];
-	    tangent = theMatrices[numDOF];
-	    if (unbalance == 0 || unbalance->Size() != numDOF ||	
-		tangent == 0 || tangent->noCols() != numDOF)	{  
-		opserr << "DOF_Group::DOF_Group(int, int ndof) ";
-		opserr << " ran out of memory for vector/Matrix of size :";
-		opserr << numDOF << endln;
-		exit(-1);
-	    }
-	} else {
-	    unbalance = theVectors[numDOF];
-	    tangent = theMatrices[numDOF];
-	}
+	classWide = true;
+	this->setWorkArea();
     } else {
 	// create matrices and vectors for each object instance
 	unbalance = new Vector(numDOF);
 	tangent = new Matrix(numDOF, numDOF);
-	if (unbalance == 0 || tangent ==0 ||
+	if (unbalance == 0 || unbalance->Size() ==0 ||
 	    tangent ==0 || tangent->noRows() ==0) {
 	    
 	    opserr << "DOF_Group::DOF_Group(int, int ndof) ";
@@ -212,8 +171,6 @@ DOF_Group::DOF_Group(int tag, int ndof)
 	    exit(-1);
 	}
     }
-    
-    numDOFs++;
 }
 
 // ~DOF_Group();    
@@ -221,35 +178,47 @@ DOF_Group::DOF_Group(int tag, int ndof)
 
 DOF_Group::~DOF_Group()
 {
-    numDOFs--;
-
-    int numDOF = unbalance->Size();
-
     // set the pointer in the associated Node to 0, to stop
     // segmentation fault if node tries to use this object after destroyed
     if (myNode != 0) 
       myNode->setDOF_GroupPtr(0);
 
     // delete tangent and residual if created specially
-    if (numDOF > MAX_NUM_DOF) {
+    if (classWide == false) {
 	if (tangent != 0) delete tangent;
 	if (unbalance != 0) delete unbalance;
     }
-
-    // if this is the last FE_Element, clean up the
-    // storage for the matrix and vector objects
-    if (numDOFs == 0) {
-	for (int i=0; i<MAX_NUM_DOF; i++) {
-	    if (theVectors[i] != 0)
-		delete theVectors[i];
-	    if (theMatrices[i] != 0)
-		delete theMatrices[i];
-	}	
-	delete [] theMatrices;
-	delete [] theVectors;
-    }    
 }    
 
+
+// void setWorkArea(void);
+//	Method to point tangent and unbalance at the class wide objects
+//	of the calling thread; invoked at the start of each method that
+//	uses them.
+
+void
+DOF_Group::setWorkArea(void)
+{
+    if (classWide == false)
+	return;
+
+    Matrix *&theMatrix = theWorkArea.theMatrices[numDOF];
+    Vector *&theVector = theWorkArea.theVectors[numDOF];
+    if (theMatrix == 0) {
+	theMatrix = new Matrix(numDOF,numDOF);
+	theVector = new Vector(numDOF);
+	if (theMatrix->noCols() != numDOF || theVector->Size() != numDOF) {
+	    opserr << "DOF_Group::setWorkArea() ";
+	    opserr << " ran out of memory for vector/Matrix of size :";
+	    opserr << numDOF << endln;
+	    exit(-1);
+	}
+    }
+
+    tangent = theMatrix;
+    unbalance = theVector;
+}
+
 // void setID(int index, int value);
 //	Method to set the corresponding index of the ID to value.
 
@@ -335,6 +304,8 @@ DOF_Group::getNumConstrainedDOF(void) const
 const Matrix &
 DOF_Group::getTangent(Integrator *theIntegrator) 
 {	
+    this->setWorkArea();
+
     if (theIntegrator != 0)
 	theIntegrator->formNodTangent(this);    
     return *tangent;
@@ -343,6 +314,8 @@ DOF_Group::getTangent(Integrator *theIntegrator)
 void  
 DOF_Group::zeroTangent(void)
 {
+    this->setWorkArea();
+
     tangent->Zero();
 }
 
@@ -350,6 +323,8 @@ DOF_Group::zeroTangent(void)
 void  
 DOF_Group::addMtoTang(double fact)
 {
+    this->setWorkArea();
+
     if (myNode != 0) {
 	if (tangent->addMatrix(1.0, myNode->getMass(), fact) < 0) {
 	    opserr << "DOF_Group::addMtoTang(void) ";
@@ -366,6 +341,8 @@ DOF_Group::addMtoTang(double fact)
 void  
 DOF_Group::addCtoTang(double fact)
 {
+    this->setWorkArea();
+
     if (myNode != 0) {
 	if (tangent->addMatrix(1.0, myNode->getDamp(), fact) < 0) {
 	    opserr << "DOF_Group::addMtoTang(void) ";
@@ -383,6 +360,8 @@ DOF_Group::addCtoTang(double fact)
 void
 DOF_Group::zeroUnbalance(void) 
 {
+    this->setWorkArea();
+
     unbalance->Zero();
 }
 
@@ -390,6 +369,8 @@ DOF_Group::zeroUnbalance(void)
 const Vector &
 DOF_Group::getUnbalance(Integrator *theIntegrator)
 {
+    this->setWorkArea();
+
     if (theIntegrator != 0)
 	theIntegrator->formNodUnbalance(this);
 
@@ -400,6 +381,8 @@ DOF_Group::getUnbalance(Integrator *theIntegrator)
 void
 DOF_Group::addPtoUnbalance(double fact)
 {
+    this->setWorkArea();
+
     if (myNode != 0) {
 	if (unbalance->addVector(1.0, myNode->getUnbalancedLoad(), fact) < 0) {
 	    opserr << "DOF_Group::addPIncInertiaToUnbalance() -";
@@ -416,6 +399,8 @@ DOF_Group::addPtoUnbalance(double fact)
 void
 DOF_Group::addPIncInertiaToUnbalance(double fact)
 {
+    this->setWorkArea();
+
     if (myNode != 0) {
 	if (unbalance->addVector(1.0, myNode->getUnbalancedLoadIncInertia(), 
 				 fact) < 0) {
@@ -434,6 +419,8 @@ DOF_Group::addPIncInertiaToUnbalance(double fact)
 void  
 DOF_Group::addM_Force(const Vector &Udotdot, double fact)
 {
+    this->setWorkArea();
+
     if (myNode == 0) {
 	opserr << "DOF_Group::addM_Force() - no Node associated";	
 	opserr << " subclass should not call this method \n";	    
@@ -463,6 +450,8 @@ DOF_Group::addM_Force(const Vector &Udotdot, double fact)
 const Vector &
 DOF_Group::getTangForce(const Vector &Udotdot, double fact)
 {
+  this->setWorkArea();
+
   opserr << "DOF_Group::getTangForce() - not yet implemented";
   return *unbalance;
 }
@@ -471,6 +460,8 @@ DOF_Group::getTangForce(const Vector &Udotdot, double fact)
 const Vector &
 DOF_Group::getM_Force(const Vector &Udotdot, double fact)
 {
+    this->setWorkArea();
+
     if (myNode == 0) {
 	opserr << "DOF_Group::getM_Force() - no Node associated";	
 	opserr << " subclass should not call this method \n";	    
@@ -499,6 +490,8 @@ DOF_Group::getM_Force(const Vector &Udotdot, double fact)
 const Vector &
 DOF_Group::getC_Force(const Vector &Udotdot, double fact)
 {
+    this->setWorkArea();
+
     if (myNode == 0) {
 	opserr << "DOF_Group::getC_Force() - no Node associated";	
 	opserr << " subclass should not call this method \n";	    
@@ -564,6 +557,8 @@ DOF_Group::getCommittedAccel(void)
 void
 DOF_Group::setNodeDisp(const Vector &u)
 {
+    this->setWorkArea();
+
     if (myNode == 0) {
 	opserr << "DOF_Group::setNodeDisp: no associated Node\n";
 	return;
@@ -591,6 +586,8 @@ DOF_Group::setNodeDisp(const Vector &u)
 void
 DOF_Group::setNodeVel(const Vector &udot)
 {
+    this->setWorkArea();
+
 
     if (myNode == 0) {
 	opserr << "DOF_Group::setNodeVel: 0 Node Pointer\n";
@@ -621,6 +618,8 @@ DOF_Group::setNodeVel(const Vector &udot)
 void
 DOF_Group::setNodeAccel(const Vector &udotdot)
 {
+    this->setWorkArea();
+
 
     if (myNode == 0) {
 	opserr << "DOF_Group::setNodeAccel: 0 Node Pointer\n";
@@ -649,6 +648,8 @@ DOF_Group::setNodeAccel(const Vector &udotdot)
 void
 DOF_Group::incrNodeDisp(const Vector &u)
 {
+    this->setWorkArea();
+
     if (myNode == 0) {
 	opserr << "DOF_Group::incrNodeDisp: 0 Node Pointer\n";
 	exit(-1);
@@ -681,6 +682,8 @@ DOF_Group::incrNodeDisp(const Vector &u)
 void
 DOF_Group::incrNodeVel(const Vector &udot)
 {
+    this->setWorkArea();
+
 
     if (myNode == 0) {
 	opserr << "DOF_Group::incrNodeVel: 0 Node Pointer\n";
@@ -709,6 +712,8 @@ DOF_Group::incrNodeVel(const Vector &udot)
 void
 DOF_Group::incrNodeAccel(const Vector &udotdot)
 {
+    this->setWorkArea();
+
 
     if (myNode == 0) {
 	opserr << "DOF_Group::incrNodeAccel: 0 Node Pointer\n";
@@ -767,6 +772,8 @@ DOF_Group::getTrialAccel()
 void
 DOF_Group::setEigenvector(int mode, const Vector &theVector)
 {
+    this->setWorkArea();
+
 
     if (myNode == 0) {
 	opserr << "DOF_Group::setEigenvector: 0 Node Pointer\n";
@@ -812,6 +819,8 @@ DOF_Group::getT(void)
 void  
 DOF_Group::addLocalM_Force(const Vector &accel, double fact)
 {
+    this->setWorkArea();
+
     if (myNode != 0) {
 	if (unbalance->addMatrixVector(1.0, myNode->getMass(), accel, fact) < 0) {  
 				       
@@ -830,6 +839,8 @@ DOF_Group::addLocalM_Force(const Vector &accel, double fact)
 const Vector &
 DOF_Group::getDispSensitivity(int gradNumber)
 {
+    this->setWorkArea();
+
     Vector &result = *unbalance;
 	for (int i=0; i<numDOF; i++) {
 		result(i) = myNode->getDispSensitivity(i+1,gradNumber);
@@ -840,6 +851,8 @@ DOF_Group::getDispSensitivity(int gradNumber)
 const Vector &
 DOF_Group::getVelSensitivity(int gradNumber)
 {
+    this->setWorkArea();
+
     Vector &result = *unbalance;
 	for (int i=0; i<numDOF; i++) {
 		result(i) = myNode->getVelSensitivity(i+1,gradNumber);
@@ -850,6 +863,8 @@ DOF_Group::getVelSensitivity(int gradNumber)
 const Vector &
 DOF_Group::getAccSensitivity(int gradNumber)
 {
+    this->setWorkArea();
+
     Vector &result = *unbalance;
 	for (int i=0; i<numDOF; i++) {
 		result(i) = myNode->getAccSensitivity(i+1,gradNumber);
@@ -862,6 +877,8 @@ DOF_Group::getAccSensitivity(int gradNumber)
 int 
 DOF_Group::saveDispSensitivity(const Vector &v, int gradNum, int numGrads)
 {
+  this->setWorkArea();
+
   Vector &dudh = *unbalance;
 
   for (int i = 0; i < numDOF; i++) {
@@ -878,6 +895,8 @@ DOF_Group::saveDispSensitivity(const Vector &v, int gradNum, int numGrads)
 int 
 DOF_Group::saveVelSensitivity(const Vector &v, int gradNum, int numGrads)
 {
+  this->setWorkArea();
+
   Vector &dudh = *unbalance;
 
   for (int i = 0; i < numDOF; i++) {
@@ -894,6 +913,8 @@ DOF_Group::saveVelSensitivity(const Vector &v, int gradNum, int numGrads)
 int 
 DOF_Group::saveAccSensitivity(const Vector &v, int gradNum, int numGrads)
 {
+  this->setWorkArea();
+
   Vector &dudh = *unbalance;
 
   for (int i = 0; i < numDOF; i++) {
@@ -924,6 +945,8 @@ DOF_Group::saveSensitivity(const Vector &v, const Vector &vdot,
 void  
 DOF_Group::addM_ForceSensitivity(const Vector &Udotdot, double fact)
 {
+    this->setWorkArea();
+
     if (myNode == 0) {
 	opserr << "DOF_Group::addM_Force() - no Node associated";	
 	opserr << " subclass should not call this method \n";	    
@@ -951,6 +974,8 @@ DOF_Group::addM_ForceSensitivity(const Vector &Udotdot, double fact)
 void
 DOF_Group::addD_Force(const Vector &Udot, double fact)
 {
+    this->setWorkArea();
+
     if (myNode == 0) {
         opserr << "DOF_Group::addD_Force() - no Node associated";
         opserr << " subclass should not call this method \n";
@@ -978,6 +1003,8 @@ DOF_Group::addD_Force(const Vector &Udot, double fact)
 void
 DOF_Group::addD_ForceSensitivity(const Vector &Udot, double fact)
 {
+    this->setWorkArea();
+
     if (myNode == 0) {
         opserr << "DOF_Group::addD_ForceSensitivity() - no Node associated";
         opserr << " subclass should not call this method \n";
@@ -1031,6 +1058,8 @@ DOF_Group::getDampingBetaFactor(int mode, double ratio, double wn)
 const Vector &
 DOF_Group::getDampingBetaForce(int mode, double beta)
 {
+  this->setWorkArea();
+
   // to return beta * M * phi(mode)
   const Matrix & mass = myNode->getMass();
   const Matrix & eigenVectors = myNode->getEigenvectors();
@@ -66,13 +66,18 @@ class DOF_Group: public TaggedObject
     virtual int getNumFreeDOF(void) const;
     virtual int getNumConstrainedDOF(void) const;
 
-    // methods to form the tangent
+    // methods to form the tangent and unbalance; unless the group has
+    // more than 256 dof, the results of these and of the get*Force()
+    // methods are not owned by the group but shared by all groups of the
+    // same size. Each thread has its own set, so threads do not overwrite
+    // each other's results, but within a thread the old constraint still
+    // holds: a result must be used, or copied, before the same thread
+    // asks another group of the same size for a result.
     virtual const Matrix &getTangent(Integrator *theIntegrator);
     virtual void  zeroTangent(void);
     virtual void  addMtoTang(double fact = 1.0);    
     virtual void  addCtoTang(double fact = 1.0);    
 
-    // methods to form the unbalance
     virtual const Vector &getUnbalance(Integrator *theIntegrator);
     virtual void  zeroUnbalance(void);
     virtual void  addPtoUnbalance(double fact = 1.0);
@@ -133,6 +138,7 @@ class DOF_Group: public TaggedObject
   
    protected:
     void  addLocalM_Force(const Vector &Udotdot, double fact = 1.0);     
+    void  setWorkArea(void);
 
     // protected variables - a copy for each object of the class            
     Vector *unbalance;
@@ -143,13 +149,11 @@ class DOF_Group: public TaggedObject
     // private variables - a copy for each object of the class        
     ID 	myID;
     int numDOF;
+    bool classWide;            // tangent & unbalance are the class wide objects
 
     // static variables - single copy for all objects of the class	    
     static Matrix errMatrix;
     static Vector errVect;
-    static Matrix **theMatrices; // array of pointers to class wide matrices
-    static Vector **theVectors;  // array of pointers to class widde vectors
-    static int numDOFs;           // number of objects    
 };
 
 #endif
@@ -81,6 +81,8 @@ LagrangeDOF_Group::~LagrangeDOF_Group()
 const Matrix &
 LagrangeDOF_Group::getTangent(Integrator *theIntegrator)
 {
+    this->setWorkArea();
+
     // does nothing - the Lagrange FE_Elements provide coeffs to tangent
     if (tangent == 0) {
 	int numDOF = this->getNumDOF();
@@ -101,6 +103,8 @@ LagrangeDOF_Group::getTangent(Integrator *theIntegrator)
 const Vector &
 LagrangeDOF_Group::getUnbalance(Integrator *theIntegrator)
 {
+    this->setWorkArea();
+
     // does nothing - the Lagrange FE_Elements provide residual 
     unbalance->Zero();
     return *unbalance;
@@ -210,6 +214,8 @@ LagrangeDOF_Group::getCommittedDisp(void)
 const Vector &
 LagrangeDOF_Group::getCommittedVel(void)
 {
+    this->setWorkArea();
+
     unbalance->Zero();
     return *unbalance;
 }
@@ -217,6 +223,8 @@ LagrangeDOF_Group::getCommittedVel(void)
 const Vector &
 LagrangeDOF_Group::getCommittedAccel(void)
 {
+    this->setWorkArea();
+
     unbalance->Zero();
     return *unbalance;
 }
@@ -274,6 +282,8 @@ LagrangeDOF_Group::addM_Force(const Vector &Udotdot, double fact)
 const Vector &
 LagrangeDOF_Group::getTangForce(const Vector &disp, double fact)
 {
+  this->setWorkArea();
+
   opserr << "WARNING LagrangeDOF_Group::getTangForce() - not yet implemented\n";
   unbalance->Zero();
   return *unbalance;
@@ -282,6 +292,8 @@ LagrangeDOF_Group::getTangForce(const Vector &disp, double fact)
 const Vector &
 LagrangeDOF_Group::getC_Force(const Vector &disp, double fact)
 {
+  this->setWorkArea();
+
   unbalance->Zero();
   return *unbalance;
 }
@@ -289,6 +301,8 @@ LagrangeDOF_Group::getC_Force(const Vector &disp, double fact)
 const Vector &
 LagrangeDOF_Group::getM_Force(const Vector &disp, double fact)
 {
+  this->setWorkArea();
+
   unbalance->Zero();
   return *unbalance;
 }
@@ -479,6 +479,8 @@ TransformationDOF_Group::getCommittedAccel(void)
 void
 TransformationDOF_Group::setNodeDisp(const Vector &u)
 {
+    this->setWorkArea();
+
 #ifdef TRANSF_INCREMENTAL_MP
     // save the previous mod trial here
     static Vector modTrialDispOld;
@@ -566,6 +568,8 @@ TransformationDOF_Group::setNodeDisp(const Vector &u)
 void
 TransformationDOF_Group::setNodeVel(const Vector &u)
 {
+    this->setWorkArea();
+
     // call base class method and return if no MP_Constraint
     if (theMP == 0) {
 	this->DOF_Group::setNodeVel(u);
@@ -612,6 +616,8 @@ TransformationDOF_Group::setNodeVel(const Vector &u)
 void
 TransformationDOF_Group::setNodeAccel(const Vector &u)
 {
+    this->setWorkArea();
+
     // call base class method and return if no MP_Constraint
     if (theMP == 0) {
 	this->DOF_Group::setNodeAccel(u);
@@ -662,6 +668,8 @@ TransformationDOF_Group::setNodeAccel(const Vector &u)
 void
 TransformationDOF_Group::incrNodeDisp(const Vector &u)
 {
+    this->setWorkArea();
+
     // call base class method and return if no MP_Constraint
     if (theMP == 0) {
 	this->DOF_Group::incrNodeDisp(u);
@@ -698,6 +706,8 @@ TransformationDOF_Group::incrNodeDisp(const Vector &u)
 void
 TransformationDOF_Group::incrNodeVel(const Vector &u)
 {
+  this->setWorkArea();
+
   // call base class method and return if no MP_Constraint
   if (theMP == 0) {
     this->DOF_Group::incrNodeVel(u);
@@ -729,6 +739,8 @@ TransformationDOF_Group::incrNodeVel(const Vector &u)
 void
 TransformationDOF_Group::incrNodeAccel(const Vector &u)
 {
+  this->setWorkArea();
+
   // call base class method and return if no MP_Constraint
   if (theMP == 0) {
     this->DOF_Group::incrNodeAccel(u);
@@ -862,6 +874,8 @@ TransformationDOF_Group::getTrialAccel(void)
 void
 TransformationDOF_Group::setEigenvector(int mode, const Vector &u)
 {
+  this->setWorkArea();
+
   // call base class method and return if no MP_Constraint
   if (theMP == 0) {
     this->DOF_Group::setEigenvector(mode, u);
@@ -1033,6 +1047,8 @@ TransformationDOF_Group::addSP_Constraint(SP_Constraint &theSP)
 int 
 TransformationDOF_Group::enforceSPs(int doMP)
 {
+  this->setWorkArea();
+
 #ifdef TRANSF_INCREMENTAL_MP
     // Massimo 2026 - Reset modTotalDisp here (called when starting a new step)
     // in case the previous step did not converge.
@@ -1224,6 +1240,8 @@ int
 TransformationDOF_Group::saveDispSensitivity(const Vector &u,
 					     int gradNum, int numGrads)
 {
+  this->setWorkArea();
+
   // call base class method and return if no MP_Constraint
   if (theMP == 0) {
     return this->DOF_Group::saveDispSensitivity(u, gradNum, numGrads);
@@ -1255,6 +1273,8 @@ int
 TransformationDOF_Group::saveVelSensitivity(const Vector &u,
 					    int gradNum, int numGrads)
 {
+  this->setWorkArea();
+
   // call base class method and return if no MP_Constraint
   if (theMP == 0) {
     return this->DOF_Group::saveVelSensitivity(u, gradNum, numGrads);
@@ -1286,6 +1306,8 @@ int
 TransformationDOF_Group::saveAccSensitivity(const Vector &u,
 					    int gradNum, int numGrads)
 {
+  this->setWorkArea();
+
   // call base class method and return if no MP_Constraint
   if (theMP == 0) {
     return this->DOF_Group::saveAccSensitivity(u, gradNum, numGrads);
@@ -42,23 +42,49 @@
 #include <AnalysisModel.h>
 #include <Matrix.h>
 #include <Vector.h>
+#include <chrono>
 
 #define MAX_NUM_DOF 64
 
 // static variables initialisation
 Matrix FE_Element::errMatrix(1,1);
 Vector FE_Element::errVector(1);
-Matrix **FE_Element::theMatrices; // pointers to class wide matrices
-Vector **FE_Element::theVectors;  // pointers to class widde vectors
 int FE_Element::numFEs(0);           // number of objects
 
+// the class wide matrix and vector objects used to return the tangent 
+// and residual; one set per thread so that FE_Elements of the same size
+// can be formed concurrently during a parallel assembly
+namespace {
+  class FE_ElementWorkArea {
+  public:
+    FE_ElementWorkArea() {
+      for (int i=0; i<=MAX_NUM_DOF; i++) {
+	theMatrices[i] = 0;
+	theVectors[i] = 0;
+      }
+    }
+    ~FE_ElementWorkArea() {
+      for (int i=0; i<=MAX_NUM_DOF; i++) {
+	if (theMatrices[i] != 0)
+	  delete theMatrices[i];
+	if (theVectors[i] != 0)
+	  delete theVectors[i];
+      }
+    }
+    Matrix *theMatrices[MAX_NUM_DOF+1]; // pointers to class wide matrices
+    Vector *theVectors[MAX_NUM_DOF+1];  // pointers to class wide vectors
+  };
+
+  thread_local FE_ElementWorkArea theWorkArea;
+}
+
 //  FE_Element(Element *, Integrator *theIntegrator);
 //	construictor that take the corresponding model element.
 FE_Element::FE_Element(int tag, Element *ele)
   :TaggedObject(tag),
    myDOF_Groups((ele->getExternalNodes()).Size()), myID(ele->getNumDOF()), 
    numDOF(ele->getNumDOF()), theModel(0), myEle(ele), 
-   theResidual(0), theTangent(0), theIntegrator(0)
+   theResidual(0), theTangent(0), theIntegrator(0), classWide(false)
 {
   if (numDOF <= 0) {
     opserr << "FE_Element::FE_Element(Element *) ";
@@ -96,23 +122,6 @@ FE_Element::FE_Element(int tag, Element *ele)
 	}
     }
 
-    // if this is the first FE_Element we now
-    // create the arrays used to store pointers to class wide
-    // matrix and vector objects used to return tangent and residual
-    if (numFEs == 0) {
-	theMatrices = new Matrix *[MAX_NUM_DOF+1];
-	theVectors  = new Vector *[MAX_NUM_DOF+1];
-	
-	if (theMatrices == 0 || theVectors == 0) {
-	    opserr << "FE_Element::FE_Element(Element *) ";
-	    opserr << " ran out of memory";	    
-	}
-	for (int i=0; i<MAX_NUM_DOF; i++) {
-	    theMatrices[i] = 0;
-	    theVectors[i] = 0;
-	}
-    }
-
     if (ele->isSubdomain() == false) {
 	
 	// if Elements are not subdomains, set up pointers to
@@ -120,22 +129,8 @@ FE_Element::FE_Element(int tag, Element *ele)
 
 	if (numDOF <= MAX_NUM_DOF) {
 	    // use class wide objects
-	    if (theVectors[numDOF] == 0) {
-		theVectors[numDOF] = new Vector(numDOF);
-		theMatrices[numDOF] = new Matrix(numDOF,numDOF);
-		theResidual = theVectors[numDOF];
-		theTangent = theMatrices[numDOF];
-		if (theResidual == 0 || theResidual->Size() != numDOF ||	
-		    theTangent == 0 || theTangent->noCols() != numDOF)	{  
-		    opserr << "FE_Element::FE_Element(Element *) ";
-		    opserr << " ran out of memory for vector/Matrix of size :";
-		    opserr << numDOF << endln;
-		    exit(-1);
-		}
-	    } else {
-		theResidual = theVectors[numDOF];
-		theTangent = theMatrices[numDOF];
-	    }
+	    classWide = true;
+	    this->setWorkArea();
 	} else {
 	    // create matrices and vectors for each object instance
 	    theResidual = new Vector(numDOF);
@@ -167,28 +162,11 @@ FE_Element::FE_Element(int tag, Element *ele)
 FE_Element::FE_Element(int tag, int numDOF_Group, int ndof)
   :TaggedObject(tag),
    myDOF_Groups(numDOF_Group), myID(ndof), numDOF(ndof), theModel(0),
-   myEle(0), theResidual(0), theTangent(0), theIntegrator(0)
+   myEle(0), theResidual(0), theTangent(0), theIntegrator(0), classWide(false)
 {
     // this is for a subtype, the subtype must set the myDOF_Groups ID array
     numFEs++;
 
-    // if this is the first FE_Element we now
-    // create the arrays used to store pointers to class wide
-    // matrix and vector objects used to return tangent and residual
-    if (numFEs == 0) {
-	theMatrices = new Matrix *[MAX_NUM_DOF+1];
-	theVectors  = new Vector *[MAX_NUM_DOF+1];
-	
-	if (theMatrices == 0 || theVectors == 0) {
-	    opserr << "FE_Element::FE_Element(Element *) ";
-	    opserr << " ran out of memory";	    
-	}
-	for (int i=0; i<MAX_NUM_DOF; i++) {
-	    theMatrices[i] = 0;
-	    theVectors[i] = 0;
-	}
-    }
-    
     // as subtypes have no access to the tangent or residual we don't set them
     // this way we can detect if subclass does not provide all methods it should
 }
@@ -208,20 +186,36 @@ FE_Element::~FE_Element()
 	if (theTangent != 0) delete theTangent;
 	if (theResidual != 0) delete theResidual;
     }
+}    
+
 
-    // if this is the last FE_Element, clean up the
-    // storage for the matrix and vector objects
-    if (numFEs == 0) {
-	for (int i=0; i<MAX_NUM_DOF; i++) {
-	    if (theVectors[i] != 0)
-		delete theVectors[i];
-	    if (theMatrices[i] != 0)
-		delete theMatrices[i];
-	}	
-	delete [] theMatrices;
-	delete [] theVectors;
+// void setWorkArea(void);
+//	Method to point theTangent and theResidual at the class wide
+//	objects of the calling thread; invoked at the start of each
+//	method that forms the tangent or residual.
+
+void
+FE_Element::setWorkArea(void)
+{
+    if (classWide == false)
+	return;
+
+    Matrix *&theMatrix = theWorkArea.theMatrices[numDOF];
+    Vector *&theVector = theWorkArea.theVectors[numDOF];
+    if (theMatrix == 0) {
+	theMatrix = new Matrix(numDOF,numDOF);
+	theVector = new Vector(numDOF);
+	if (theMatrix->noCols() != numDOF || theVector->Size() != numDOF) {
+	    opserr << "FE_Element::setWorkArea() ";
+	    opserr << " ran out of memory for vector/Matrix of size :";
+	    opserr << numDOF << endln;
+	    exit(-1);
+	}
     }
-}    
+
+    theTangent = theMatrix;
+    theResidual = theVector;
+}
 
 
 const ID &
@@ -288,6 +282,7 @@ const Matrix &
 FE_Element::getTangent(Integrator *theNewIntegrator)
 {
     theIntegrator = theNewIntegrator;
+    this->setWorkArea();
     
     if (myEle == 0) {
 	opserr << "FATAL FE_Element::getTangent() - no Element *given ";
@@ -297,8 +292,14 @@ FE_Element::getTangent(Integrator *theNewIntegrator)
     }
 
     if (myEle->isSubdomain() == false) {
-      if (theNewIntegrator != 0)
-	theNewIntegrator->formEleTangent(this);	    	    
+      if (theNewIntegrator != 0) {
+	if (Element::measuresCosts()) {
+	  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	  theNewIntegrator->formEleTangent(this);
+	  myEle->addTangentCost(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+	} else
+	  theNewIntegrator->formEleTangent(this);
+      }
 
       return *theTangent;
     } else {
@@ -312,6 +313,7 @@ const Vector &
 FE_Element::getResidual(Integrator *theNewIntegrator)
 {
     theIntegrator = theNewIntegrator;
+    this->setWorkArea();
 
     if (theIntegrator == 0)
       return *theResidual;
@@ -338,6 +340,7 @@ FE_Element::getResidual(Integrator *theNewIntegrator)
 void  
 FE_Element::zeroTangent(void)
 {
+    this->setWorkArea();
     if (myEle != 0) {
 	if (myEle->isSubdomain() == false)
 	    theTangent->Zero();
@@ -468,6 +471,7 @@ FE_Element::storePreviousK(int numP)
 void  
 FE_Element::zeroResidual(void)
 {
+    this->setWorkArea();
     if (myEle != 0) {
 	if (myEle->isSubdomain() == false)
 	    theResidual->Zero();
@@ -533,6 +537,8 @@ FE_Element::getTangForce(const Vector &disp, double fact)
 {
     if (myEle != 0) {    
 
+	this->setWorkArea();
+
 	// zero out the force vector
 	theResidual->Zero();
 
@@ -582,6 +588,8 @@ FE_Element::getK_Force(const Vector &disp, double fact)
 {
     if (myEle != 0) {    
 
+	this->setWorkArea();
+
 	// zero out the force vector
 	theResidual->Zero();
 
@@ -620,6 +628,8 @@ FE_Element::getKi_Force(const Vector &disp, double fact)
 {
     if (myEle != 0) {    
 
+	this->setWorkArea();
+
 	// zero out the force vector
 	theResidual->Zero();
 
@@ -658,6 +668,8 @@ FE_Element::getM_Force(const Vector &disp, double fact)
 
     if (myEle != 0) {    
 
+	this->setWorkArea();
+
 	// zero out the force vector
 	theResidual->Zero();
 
@@ -696,6 +708,8 @@ FE_Element::getC_Force(const Vector &disp, double fact)
 {
     if (myEle != 0) {    
 
+	this->setWorkArea();
+
 	// zero out the force vector
 	theResidual->Zero();
 
@@ -740,6 +754,7 @@ const Vector &
 FE_Element::getLastResponse(void)
 {
     if (myEle != 0) {
+      this->setWorkArea();
       if (theIntegrator != 0) {
 	if (theIntegrator->getLastResponse(*theResidual,myID) < 0) {
 	  opserr << "WARNING FE_Element::getLastResponse(void)";
@@ -1126,6 +1141,20 @@ void FE_Element::deactivate()
 }
 
 
+// bool isThreadSafe(void);
+//	Method to return true if getTangent() and getResidual() may be
+//	invoked on this and other FE_Elements concurrently.
+
+bool
+FE_Element::isThreadSafe(void)
+{
+    if (myEle != 0 && myEle->isSubdomain() == false)
+	return myEle->isThreadSafe();
+
+    return false;
+}
+
+
 bool FE_Element::isActive()
 { 
 	if (myEle->isActive())
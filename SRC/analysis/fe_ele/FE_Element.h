@@ -105,6 +105,7 @@ class FE_Element: public TaggedObject
     void activate();
     void deactivate();
     bool isActive();
+    virtual bool isThreadSafe(void);
 
   protected:
     void  addLocalM_Force(const Vector &accel, double fact = 1.0);    
@@ -125,12 +126,13 @@ class FE_Element: public TaggedObject
     Vector *theResidual;
     Matrix *theTangent;
     Integrator *theIntegrator; // need for Subdomain
+    bool classWide;            // tangent & residual are the class wide objects
+
+    void setWorkArea(void);
     
     // static variables - single copy for all objects of the class	
     static Matrix errMatrix;
     static Vector errVector;
-    static Matrix **theMatrices; // array of pointers to class wide matrices
-    static Vector **theVectors;  // array of pointers to class widde vectors
     static int numFEs;           // number of objects
     
 
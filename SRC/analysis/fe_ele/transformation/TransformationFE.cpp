@@ -974,6 +974,14 @@ TransformationFE::getLastResponse(void)
 }
 
 
+// the transformed tangent and residual are formed in class wide objects
+bool
+TransformationFE::isThreadSafe(void)
+{
+    return false;
+}
+
+
 int 
 TransformationFE::transformResponse(const Vector &modResp, 
 				    Vector &unmodResp)
@@ -69,9 +69,11 @@
 #ifdef _PARALLEL_PROCESSING
 extern bool OPS_PARTITIONED;
 #include <mpi.h>
+#include <MPI_Channel.h>
 #endif // _PARALLEL_PROCESSING
 #ifdef _PARALLEL_INTERPRETERS
 #include <mpi.h>
+#include <MPI_Channel.h>
 #endif // _PARALLEL_INTERPRETERS
 
 void* OPS_AutoConstraintHandler()
@@ -235,6 +237,7 @@ namespace {
 				double local_max = m_gp_max;
 				double local_avg = m_gp_avg;
 				double local_cnt = m_gp_cnt;
+				MPI_Channel::flushAll();
 				if (MPI_Allreduce(&local_min, &m_gp_min, 1, MPI_DOUBLE, MPI_MIN, MPI_COMM_WORLD) != MPI_SUCCESS) {
 					opserr << "AutoConstraintHandler Warning: MPI_Allreduce failed to get MIN\n";
 				}
@@ -62,15 +62,17 @@ void *    OPS_CollocationHSFixedNumIter(void)
     int numData = 0;
     
     // count number of numeric parameters
+    int numRead = 0;
     while (OPS_GetNumRemainingInputArgs() > 0)  {
         const char *argvLoc = OPS_GetString();
+        numRead++;
         if (strcmp(argvLoc, "-polyOrder") == 0) {
             break;
         }
         numData++;
     }
     // reset to read from beginning
-    OPS_ResetCurrentInputArg(2);
+    OPS_ResetCurrentInputArg(-numRead);
     
     if (OPS_GetDouble(&numData, dData) != 0) {
         opserr << "WARNING - invalid args want CollocationHSFixedNumIter $theta <-polyOrder $O>\n";
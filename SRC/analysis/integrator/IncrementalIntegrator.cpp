@@ -39,6 +39,8 @@
 #include <FE_EleIter.h>
 #include <DOF_GrpIter.h>
 #include <EigenSOE.h>
+#include <Element.h>
+#include <Profiler.h>
 #include <cmath>
 
 IncrementalIntegrator::IncrementalIntegrator(int clasTag)
@@ -46,7 +48,7 @@ IncrementalIntegrator::IncrementalIntegrator(int clasTag)
  statusFlag(CURRENT_TANGENT), theEigenSOE(0), 
  eigenVectors(0), eigenValues(0), dampingForces(0),isDiagonal(false),diagMass(0),
  mV(0),tmpV1(0),tmpV2(0),
- theSOE(0), theAnalysisModel(0), theTest(0)
+ theSOE(0), theAnalysisModel(0), theTest(0), numThreads(1)
 {
   
 }
@@ -84,6 +86,11 @@ IncrementalIntegrator::setEigenSOE(EigenSOE *theEigSOE) {
 int 
 IncrementalIntegrator::formTangent(int statFlag)
 {
+    static int tangentRegion = Profiler::getRegion("formTangent");
+    static int tangentCounter = Profiler::getCounter("tangents");
+    ProfilerScope theScope(tangentRegion);
+    Profiler::count(tangentCounter);
+
     int result = 0;
     statusFlag = statFlag;
 
@@ -96,18 +103,27 @@ IncrementalIntegrator::formTangent(int statFlag)
     // zero the A matrix of the linearSOE
     theSOE->zeroA();
 
+#ifdef _OPENMP
+    if (numThreads > 1 && theSOE->isThreadSafe())
+	return this->formElementTangentParallel();
+#endif
+
     // the loops to form and add the tangents are broken into two for 
     // efficiency when performing parallel computations - CHANGE
 
     // loop through the FE_Elements adding their contributions to the tangent
     FE_Element *elePtr;
     FE_EleIter &theEles2 = theAnalysisModel->getFEs();    
-    while((elePtr = theEles2()) != 0)     
+    bool profile = Profiler::isEnabled();
+    while((elePtr = theEles2()) != 0) {
+	Element *theEle = profile ? elePtr->getElement() : 0;
+	ProfilerScope eleScope(theEle != 0 ? Profiler::getClassRegion(theEle->getClassTag(), theEle->getClassType()) : -1);
 	if (theSOE->addA(elePtr->getTangent(this),elePtr->getID()) < 0) {
 	    opserr << "WARNING IncrementalIntegrator::formTangent -";
 	    opserr << " failed in addA for ID " << elePtr->getID();	    
 	    result = -3;
 	}
+    }
 
     return result;
 }
@@ -129,6 +145,9 @@ IncrementalIntegrator::formIndependentSensitivityLHS(int statFlag)
 int 
 IncrementalIntegrator::formUnbalance(void)
 {
+    static int unbalanceRegion = Profiler::getRegion("formUnbalance");
+    ProfilerScope theScope(unbalanceRegion);
+
     if (theAnalysisModel == 0 || theSOE == 0) {
 	opserr << "WARNING IncrementalIntegrator::formUnbalance -";
 	opserr << " no AnalysisModel or LinearSOE has been set\n";
@@ -266,6 +285,11 @@ IncrementalIntegrator::formNodalUnbalance(void)
 int 
 IncrementalIntegrator::formElementResidual(void)
 {
+#ifdef _OPENMP
+    if (numThreads > 1 && theSOE->isThreadSafe())
+	return this->formElementResidualParallel();
+#endif
+
     // loop through the FE_Elements and add the residual
     FE_Element *elePtr;
 
@@ -284,6 +308,130 @@ IncrementalIntegrator::formElementResidual(void)
     return res;	    
 }
 
+int
+IncrementalIntegrator::setNumThreads(int num)
+{
+    if (num < 1) {
+	opserr << "WARNING IncrementalIntegrator::setNumThreads() -";
+	opserr << " number of threads must be at least 1\n";
+	return -1;
+    }
+
+#ifndef _OPENMP
+    if (num > 1) {
+	opserr << "WARNING IncrementalIntegrator::setNumThreads() -";
+	opserr << " not built with OpenMP, assembly will be serial\n";
+	num = 1;
+    }
+#endif
+
+    numThreads = num;
+    return 0;
+}
+
+int
+IncrementalIntegrator::getNumThreads(void) const
+{
+    return numThreads;
+}
+
+// formElementTangentParallel() and formElementResidualParallel() 
+// assemble the FE_Element contributions one color at a time, the
+// FE_Elements of a color being shared amongst the threads. As FE_Elements
+// of the same color share no equations each entry of the SOE receives at
+// most one contribution per color, so the result does not depend on the
+// number of threads or the order in which they run. The contributions
+// are summed color by color rather than in the order of the FE_EleIter,
+// so the result can differ from that of the serial loops by roundoff.
+// FE_Elements that are not thread safe are not colored and are assembled
+// after the colors by the calling thread.
+
+int
+IncrementalIntegrator::formElementTangentParallel(void)
+{
+    int result = 0;
+
+    const std::vector<std::vector<FE_Element *> > &theColors = 
+	theAnalysisModel->getFE_ElementColors();
+
+    int numColors = theColors.size();
+    for (int c=0; c<numColors; c++) {
+	const std::vector<FE_Element *> &theEles = theColors[c];
+	int numEles = theEles.size();
+
+#pragma omp parallel for num_threads(numThreads) schedule(dynamic,16) reduction(min:result)
+	for (int i=0; i<numEles; i++) {
+	    FE_Element *elePtr = theEles[i];
+	    if (theSOE->addA(elePtr->getTangent(this),elePtr->getID()) < 0) {
+#pragma omp critical (IncrementalIntegrator_output)
+		{
+		    opserr << "WARNING IncrementalIntegrator::formTangent -";
+		    opserr << " failed in addA for ID " << elePtr->getID() << endln;
+		}
+		result = -3;
+	    }
+	}
+    }
+
+    const std::vector<FE_Element *> &theSerialEles = 
+	theAnalysisModel->getFE_ElementsNotThreadSafe();
+
+    int numSerialEles = theSerialEles.size();
+    for (int i=0; i<numSerialEles; i++) {
+	FE_Element *elePtr = theSerialEles[i];
+	if (theSOE->addA(elePtr->getTangent(this),elePtr->getID()) < 0) {
+	    opserr << "WARNING IncrementalIntegrator::formTangent -";
+	    opserr << " failed in addA for ID " << elePtr->getID() << endln;
+	    result = -3;
+	}
+    }
+
+    return result;
+}
+
+int
+IncrementalIntegrator::formElementResidualParallel(void)
+{
+    int result = 0;
+
+    const std::vector<std::vector<FE_Element *> > &theColors = 
+	theAnalysisModel->getFE_ElementColors();
+
+    int numColors = theColors.size();
+    for (int c=0; c<numColors; c++) {
+	const std::vector<FE_Element *> &theEles = theColors[c];
+	int numEles = theEles.size();
+
+#pragma omp parallel for num_threads(numThreads) schedule(dynamic,16) reduction(min:result)
+	for (int i=0; i<numEles; i++) {
+	    FE_Element *elePtr = theEles[i];
+	    if (theSOE->addB(elePtr->getResidual(this),elePtr->getID()) < 0) {
+#pragma omp critical (IncrementalIntegrator_output)
+		{
+		    opserr << "WARNING IncrementalIntegrator::formElementResidual -";
+		    opserr << " failed in addB for ID " << elePtr->getID() << endln;
+		}
+		result = -2;
+	    }
+	}
+    }
+
+    const std::vector<FE_Element *> &theSerialEles = 
+	theAnalysisModel->getFE_ElementsNotThreadSafe();
+
+    int numSerialEles = theSerialEles.size();
+    for (int i=0; i<numSerialEles; i++) {
+	FE_Element *elePtr = theSerialEles[i];
+	if (theSOE->addB(elePtr->getResidual(this),elePtr->getID()) < 0) {
+	    opserr << "WARNING IncrementalIntegrator::formElementResidual -";
+	    opserr << " failed in addB for ID " << elePtr->getID() << endln;
+	    result = -2;
+	}
+    }
+
+    return result;
+}
+
 /*
 int
 IncrementalIntegrator::setModalDampingFactors(const Vector &factors)
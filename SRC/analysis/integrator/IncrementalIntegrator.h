@@ -96,6 +96,11 @@ class IncrementalIntegrator : public Integrator
     virtual const Vector &getVel(void);
     int doMv(const Vector &v, Vector &res);
 
+    // methods to set the number of threads used to assemble the
+    // FE_Element contributions; 1 (the default) assembles serially
+    int setNumThreads(int numThreads);
+    int getNumThreads(void) const;
+
 // AddingSensitivity:BEGIN //////////////////////////////////
     virtual int revertToStart();
     virtual int formIndependentSensitivityLHS(int statusFlag = CURRENT_TANGENT);
@@ -111,6 +116,8 @@ class IncrementalIntegrator : public Integrator
 
     virtual int  formNodalUnbalance(void);        
     virtual int  formElementResidual(void);            
+    int  formElementTangentParallel(void);
+    int  formElementResidualParallel(void);
     int statusFlag;
     double iFactor;
     double cFactor;
@@ -130,6 +137,7 @@ class IncrementalIntegrator : public Integrator
     LinearSOE *theSOE;
     AnalysisModel *theAnalysisModel;
     ConvergenceTest *theTest;
+    int numThreads;
 
 };
 
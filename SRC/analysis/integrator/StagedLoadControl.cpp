@@ -58,6 +58,7 @@
 
 #ifdef _PARALLEL_PROCESSING
 #include <mpi.h>
+#include <MPI_Channel.h>
 #endif
 
 // static double doubleone = 1.0;
@@ -65,7 +66,7 @@
 // static ID dofid(1);
 
 #define SEQUENTIAL_SECTION_BEGIN  for (int proc = 0; proc < nproc; ++proc){ if (rank == proc) {
-#define SEQUENTIAL_SECTION_END } MPI_Barrier(MPI_COMM_WORLD);}
+#define SEQUENTIAL_SECTION_END } MPI_Channel::flushAll(); MPI_Barrier(MPI_COMM_WORLD);}
 
 
 void* OPS_StagedLoadControlIntegrator()
@@ -180,6 +181,7 @@ int StagedLoadControl::formTangent(int statFlag)
 
 
     #ifdef _PARALLEL_PROCESSING
+    MPI_Channel::flushAll();
     MPI_Allreduce(nodedofs, allnodedofs, numEqn, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
     #endif
 
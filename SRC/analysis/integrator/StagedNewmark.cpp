@@ -47,6 +47,7 @@ static int count = 0;
 
 #ifdef _PARALLEL_PROCESSING
 #include <mpi.h>
+#include <MPI_Channel.h>
 #endif
 
 
@@ -181,6 +182,7 @@ int StagedNewmark::formTangent(int statFlag)
 
 
     #ifdef _PARALLEL_PROCESSING
+    MPI_Channel::flushAll();
     MPI_Allreduce(nodedofs, allnodedofs, numEqn, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
     #endif
 
@@ -44,6 +44,8 @@
 #include <DOF_Group.h>
 #include <FE_EleIter.h>
 #include <DOF_GrpIter.h>
+#include <Element.h>
+#include <Profiler.h>
 
 TransientIntegrator::TransientIntegrator(int clasTag)
 :IncrementalIntegrator(clasTag)
@@ -67,6 +69,11 @@ TransientIntegrator::formTangent(int statFlag, double iFact, double cFact)
 int 
 TransientIntegrator::formTangent(int statFlag)
 {
+    static int tangentRegion = Profiler::getRegion("formTangent");
+    static int tangentCounter = Profiler::getCounter("tangents");
+    ProfilerScope theScope(tangentRegion);
+    Profiler::count(tangentCounter);
+
     int result = 0;
     statusFlag = statFlag;
 
@@ -105,9 +112,20 @@ TransientIntegrator::formTangent(int statFlag)
     }    
 
     // loop through the FE_Elements getting them to add the tangent    
+#ifdef _OPENMP
+    if (this->getNumThreads() > 1 && theLinSOE->isThreadSafe()) {
+	if (this->formElementTangentParallel() < 0)
+	    result = -2;
+	return result;
+    }
+#endif
+
     FE_EleIter &theEles2 = theModel->getFEs();    
     FE_Element *elePtr;    
+    bool profile = Profiler::isEnabled();
     while((elePtr = theEles2()) != 0)     {
+	Element *theEle = profile ? elePtr->getElement() : 0;
+	ProfilerScope eleScope(theEle != 0 ? Profiler::getClassRegion(theEle->getClassTag(), theEle->getClassType()) : -1);
 	if (theLinSOE->addA(elePtr->getTangent(this),elePtr->getID()) < 0) {
 	    opserr << "TransientIntegrator::formTangent() - failed to addA:ele\n";
 	    result = -2;
@@ -120,6 +138,9 @@ TransientIntegrator::formTangent(int statFlag)
     
 int
 TransientIntegrator::formUnbalance(void) {
+    static int unbalanceRegion = Profiler::getRegion("formUnbalance");
+    ProfilerScope theScope(unbalanceRegion);
+
     LinearSOE *theLinSOE = this->getLinearSOE();
     AnalysisModel *theModel = this->getAnalysisModel();
 
@@ -45,10 +45,14 @@
 #include <DOF_GrpIter.h>
 #include <FE_EleIter.h>
 #include <Graph.h>
+#include <CSRGraph.h>
 #include <Vertex.h>
 #include <Node.h>
 #include <NodeIter.h>
 #include <ConstraintHandler.h>
+#include <NodalStateStore.h>
+#include <ID.h>
+#include <typeinfo>
 
 
 #include <MapOfTaggedObjects.h>
@@ -62,8 +66,8 @@
 AnalysisModel::AnalysisModel(int theClassTag)
 :MovableObject(theClassTag),
  myDomain(0), myHandler(0),
- myDOFGraph(0), myGroupGraph(0),
- numFE_Ele(0), numDOF_Grp(0), numEqn(0)
+ myDOFGraph(0), myGroupGraph(0), colorsBuiltFlag(false),
+ numFE_Ele(0), numDOF_Grp(0), numEqn(0), stateEqnsStamp(0)
 {
     theFEs     = new ArrayOfTaggedObjects(1024);
     theDOFs    =  new ArrayOfTaggedObjects(1024);
@@ -76,8 +80,8 @@ AnalysisModel::AnalysisModel(int theClassTag)
 AnalysisModel::AnalysisModel()
 :MovableObject(AnaMODEL_TAGS_AnalysisModel),
  myDomain(0), myHandler(0),
- myDOFGraph(0), myGroupGraph(0),
- numFE_Ele(0), numDOF_Grp(0), numEqn(0)
+ myDOFGraph(0), myGroupGraph(0), colorsBuiltFlag(false),
+ numFE_Ele(0), numDOF_Grp(0), numEqn(0), stateEqnsStamp(0)
 {
   theFEs     = new ArrayOfTaggedObjects(256);
   theDOFs    = new ArrayOfTaggedObjects(256);
@@ -89,8 +93,8 @@ AnalysisModel::AnalysisModel()
 AnalysisModel::AnalysisModel(TaggedObjectStorage &theFes, TaggedObjectStorage &theDofs)
 :MovableObject(AnaMODEL_TAGS_AnalysisModel),
  myDomain(0), myHandler(0),
- myDOFGraph(0), myGroupGraph(0),
- numFE_Ele(0), numDOF_Grp(0), numEqn(0)
+ myDOFGraph(0), myGroupGraph(0), colorsBuiltFlag(false),
+ numFE_Ele(0), numDOF_Grp(0), numEqn(0), stateEqnsStamp(0)
 {
   theFEs     = &theFes;
   theDOFs    = &theDofs;
@@ -195,6 +199,7 @@ AnalysisModel::addDOF_Group(DOF_Group *theGroup)
   bool result = theDOFs->addComponent(theGroup);
   if (result == true) {
     numDOF_Grp++;
+    stateEqnsStamp = 0;
     return true;  // o.k.
   } else
     return false;
@@ -215,10 +220,17 @@ AnalysisModel::clearAll(void)
 
     myDOFGraph = 0;
     myGroupGraph = 0;
+    theFEColors.clear();
+    theFEsNotThreadSafe.clear();
+    colorsBuiltFlag = false;
     
     numFE_Ele =0;
     numDOF_Grp = 0;
     numEqn = 0;    
+
+    theStateEqns.clear();
+    theOtherDOFs.clear();
+    stateEqnsStamp = 0;
 }
 
 void
@@ -279,6 +291,13 @@ void
 AnalysisModel::setNumEqn(int theNumEqn)
 {
     numEqn = theNumEqn;
+
+    // equation numbers have changed, coloring and the map to the
+    // nodal state store must be redone
+    theFEColors.clear();
+    theFEsNotThreadSafe.clear();
+    colorsBuiltFlag = false;
+    stateEqnsStamp = 0;
 }
 
 int 
@@ -288,11 +307,149 @@ AnalysisModel::getNumEqn(void) const
 }
 
 
+// const std::vector<std::vector<FE_Element *> > &getFE_ElementColors(void);
+//	Method to return the thread safe FE_Elements grouped by color. The 
+//	coloring is a greedy one performed in FE_Element iteration order, 
+//	each FE_Element gets the lowest color not already given to an 
+//	FE_Element with which it shares an equation number. As the 
+//	contributions of FE_Elements of one color touch distinct entries of 
+//	the system of equations, they can be assembled concurrently. The 
+//	coloring, and the list of FE_Elements that are not thread safe, is
+//	kept until the FE_Elements or equation numbers change.
+
+const std::vector<std::vector<FE_Element *> > &
+AnalysisModel::getFE_ElementColors(void)
+{
+  if (colorsBuiltFlag == true)
+    return theFEColors;
+
+  // gather the thread safe FE_Elements & the largest equation number
+  std::vector<FE_Element *> theEles;
+  int maxEqn = -1;
+  FE_Element *elePtr;
+  FE_EleIter &theFEIter = this->getFEs();
+  while ((elePtr = theFEIter()) != 0) {
+    if (elePtr->isThreadSafe() == false) {
+      theFEsNotThreadSafe.push_back(elePtr);
+      continue;
+    }
+    theEles.push_back(elePtr);
+    const ID &id = elePtr->getID();
+    for (int j=0; j<id.Size(); j++)
+      if (id(j) > maxEqn)
+	maxEqn = id(j);
+  }
+  int numEles = theEles.size();
+  int numEqns = maxEqn+1;
+
+  // map each equation to the FE_Elements contributing to it
+  std::vector<int> eqnStart(numEqns+1, 0);
+  for (int i=0; i<numEles; i++) {
+    const ID &id = theEles[i]->getID();
+    for (int j=0; j<id.Size(); j++)
+      if (id(j) >= 0)
+	eqnStart[id(j)+1]++;
+  }
+  for (int i=0; i<numEqns; i++)
+    eqnStart[i+1] += eqnStart[i];
+
+  std::vector<int> eqnEles(eqnStart[numEqns]);
+  std::vector<int> eqnNext(eqnStart.begin(), eqnStart.end()-1);
+  for (int i=0; i<numEles; i++) {
+    const ID &id = theEles[i]->getID();
+    for (int j=0; j<id.Size(); j++)
+      if (id(j) >= 0)
+	eqnEles[eqnNext[id(j)]++] = i;
+  }
+
+  // greedy coloring, colorUsedBy[c] == i if color c is not available to i
+  std::vector<int> eleColor(numEles, -1);
+  std::vector<int> colorUsedBy;
+  for (int i=0; i<numEles; i++) {
+    const ID &id = theEles[i]->getID();
+    for (int j=0; j<id.Size(); j++) {
+      int eqn = id(j);
+      if (eqn < 0)
+	continue;
+      for (int k=eqnStart[eqn]; k<eqnStart[eqn+1]; k++) {
+	int color = eleColor[eqnEles[k]];
+	if (color >= 0)
+	  colorUsedBy[color] = i;
+      }
+    }
+
+    int color = 0;
+    int numColors = colorUsedBy.size();
+    while (color < numColors && colorUsedBy[color] == i)
+      color++;
+    if (color == numColors) {
+      colorUsedBy.push_back(-1);
+      theFEColors.resize(numColors+1);
+    }
+
+    eleColor[i] = color;
+    theFEColors[color].push_back(theEles[i]);
+  }
+
+  colorsBuiltFlag = true;
+  return theFEColors;
+}
+
+
+// const std::vector<FE_Element *> &getFE_ElementsNotThreadSafe(void);
+//	Method to return, in iteration order, the FE_Elements left out of
+//	the coloring as they are not thread safe.
+
+const std::vector<FE_Element *> &
+AnalysisModel::getFE_ElementsNotThreadSafe(void)
+{
+  this->getFE_ElementColors();
+  return theFEsNotThreadSafe;
+}
+
+
 Graph &
 AnalysisModel::getDOFGraph(void)
 {
   if (myDOFGraph == 0) {
-    int numVertex = this->getNumDOF_Groups();
+
+    //
+    // when the equation numbers are 0 through n-1, as assigned by the
+    // numberers, the graph is built in compressed row form from the
+    // FE_Element IDs without creating a Vertex for each dof
+    //
+
+    std::vector<bool> isEqn;
+    int numDOFs = 0;
+    DOF_Group *dofPtr =0;
+    DOF_GrpIter &theDOFs1 = this->getDOFs();
+    while ((dofPtr = theDOFs1()) != 0) {
+      const ID &id = dofPtr->getID();
+      for (int i=0; i<id.Size(); i++) {
+	int eqn = id(i) - START_EQN_NUM;
+	if (eqn >= 0) {
+	  if (eqn >= (int)isEqn.size())
+	    isEqn.resize(eqn+1, false);
+	  if (isEqn[eqn] == false) {
+	    isEqn[eqn] = true;
+	    numDOFs++;
+	  }
+	}
+      }
+    }
+
+    if (numDOFs == (int)isEqn.size() && START_EQN_NUM == START_VERTEX_NUM) {
+      CSRGraph *theGraph = new CSRGraph(numDOFs);
+
+      FE_Element *elePtr =0;
+      FE_EleIter &eleIter = this->getFEs();
+      while((elePtr = eleIter()) != 0)
+	theGraph->addClique(elePtr->getID());
+
+      theGraph->build();
+      myDOFGraph = theGraph;
+      return *myDOFGraph;
+    }
 
     //    myDOFGraph = new Graph(numVertex);
     MapOfTaggedObjects *graphStorage = new MapOfTaggedObjects();
@@ -302,7 +459,6 @@ AnalysisModel::getDOFGraph(void)
     // create a vertex for each dof
     //
     
-    DOF_Group *dofPtr =0;
     DOF_GrpIter &theDOFs = this->getDOFs();
     while ((dofPtr = theDOFs()) != 0) {
       const ID &id = dofPtr->getID();
@@ -372,6 +528,43 @@ AnalysisModel::getDOFGroupGraph(void)
 	exit(-1);
     }	
 
+    DOF_Group *dofPtr;
+
+    //
+    // if the DOF_Group tags are 0 through numVertex-1, as assigned by
+    // the ConstraintHandlers, the graph is built in compressed row form
+    //
+
+    std::vector<bool> isGroup(numVertex, false);
+    int numGroups = 0;
+    DOF_GrpIter &dofIter1 = this->getDOFs();
+    while ((dofPtr = dofIter1()) != 0) {
+      int DOF_GroupTag = dofPtr->getTag() - START_VERTEX_NUM;
+      if (DOF_GroupTag >= 0 && DOF_GroupTag < numVertex
+	  && isGroup[DOF_GroupTag] == false) {
+	isGroup[DOF_GroupTag] = true;
+	numGroups++;
+      }
+    }
+
+    if (numGroups == numVertex && START_VERTEX_NUM == 0) {
+      CSRGraph *theGraph = new CSRGraph(numVertex);
+
+      DOF_GrpIter &dofIter = this->getDOFs();
+      while ((dofPtr = dofIter()) != 0)
+	theGraph->setVertex(dofPtr->getTag(), dofPtr->getNodeTag(),
+			    dofPtr->getNumFreeDOF());
+
+      FE_Element *elePtr;
+      FE_EleIter &eleIter = this->getFEs();
+      while((elePtr = eleIter()) != 0)
+	theGraph->addClique(elePtr->getDOFtags());
+
+      theGraph->build();
+      myGroupGraph = theGraph;
+      return *myGroupGraph;
+    }
+
     //    myGroupGraph = new Graph(numVertex);
     MapOfTaggedObjects *graphStorage = new MapOfTaggedObjects();
     myGroupGraph = new Graph(*graphStorage);
@@ -381,8 +574,6 @@ AnalysisModel::getDOFGroupGraph(void)
 	opserr << "  - out of memory\n";
 	exit(-1);
     }	
-	
-    DOF_Group *dofPtr;
 
     // now create the vertices with a reference equal to the DOF_Group number.
     // and a tag which ranges from 0 through numVertex-1
@@ -431,11 +622,66 @@ AnalysisModel::getDOFGroupGraph(void)
 
 
 
+// NodalStateStore *getStateStore(void);
+//	Private method to return the NodalStateStore of the Domain, 0 if none
+//	is used. Each slot of the store is mapped to the equation number of
+//	its dof, -1 if the dof has no equation, or -2 if the node has no
+//	DOF_Group or one of a subclass, e.g. a TransformationDOF_Group, that
+//	sets the response of its node itself. The map is redone when the 
+//	store or the equation numbers change.
+
+NodalStateStore *
+AnalysisModel::getStateStore(void)
+{
+    if (myDomain == 0)
+	return 0;
+
+    NodalStateStore *theStore = myDomain->getNodalStateStore();
+    if (theStore == 0 || stateEqnsStamp == theStore->getStamp())
+	return theStore;
+
+    theStateEqns.assign(theStore->getNumDOF(), -2);
+    theOtherDOFs.clear();
+
+    DOF_GrpIter &theDOFGrps = this->getDOFs();
+    DOF_Group 	*dofPtr;
+    while ((dofPtr = theDOFGrps()) != 0) {
+	int slot = -1;
+	if (typeid(*dofPtr) == typeid(DOF_Group))
+	    slot = theStore->getSlot(myDomain->getNode(dofPtr->getNodeTag()));
+
+	if (slot < 0) {
+	    theOtherDOFs.push_back(dofPtr);
+	    continue;
+	}
+
+	const ID &id = dofPtr->getID();
+	for (int i=0; i<id.Size(); i++)
+	    theStateEqns[slot+i] = (id(i) >= 0) ? id(i) : -1;
+    }
+
+    stateEqnsStamp = theStore->getStamp();
+    return theStore;
+}
+
+
 void 
 AnalysisModel::setResponse(const Vector &disp,
 			   const Vector &vel, 
 			   const Vector &accel)
 {
+    NodalStateStore *theStore = this->getStateStore();
+    if (theStore != 0) {
+	theStore->setResponse(theStateEqns.data(), &disp, &vel, &accel,
+			      myDomain->getNumThreads());
+	for (DOF_Group *dofPtr : theOtherDOFs) {
+	    dofPtr->setNodeDisp(disp);
+	    dofPtr->setNodeVel(vel);
+	    dofPtr->setNodeAccel(accel);	
+	}
+	return;
+    }
+
     DOF_GrpIter &theDOFGrps = this->getDOFs();
     DOF_Group 	*dofPtr;
 
@@ -449,6 +695,15 @@ AnalysisModel::setResponse(const Vector &disp,
 void 
 AnalysisModel::setDisp(const Vector &disp)
 {
+    NodalStateStore *theStore = this->getStateStore();
+    if (theStore != 0) {
+	theStore->setResponse(theStateEqns.data(), &disp, 0, 0,
+			      myDomain->getNumThreads());
+	for (DOF_Group *dofPtr : theOtherDOFs)
+	    dofPtr->setNodeDisp(disp);
+	return;
+    }
+
     DOF_GrpIter &theDOFGrps = this->getDOFs();
     DOF_Group 	*dofPtr;
 
@@ -459,6 +714,15 @@ AnalysisModel::setDisp(const Vector &disp)
 void 
 AnalysisModel::setVel(const Vector &vel)
 {
+    NodalStateStore *theStore = this->getStateStore();
+    if (theStore != 0) {
+	theStore->setResponse(theStateEqns.data(), 0, &vel, 0,
+			      myDomain->getNumThreads());
+	for (DOF_Group *dofPtr : theOtherDOFs)
+	    dofPtr->setNodeVel(vel);
+	return;
+    }
+
         DOF_GrpIter &theDOFGrps = this->getDOFs();
     DOF_Group 	*dofPtr;
     
@@ -470,6 +734,15 @@ AnalysisModel::setVel(const Vector &vel)
 void 
 AnalysisModel::setAccel(const Vector &accel)
 {
+    NodalStateStore *theStore = this->getStateStore();
+    if (theStore != 0) {
+	theStore->setResponse(theStateEqns.data(), 0, 0, &accel,
+			      myDomain->getNumThreads());
+	for (DOF_Group *dofPtr : theOtherDOFs)
+	    dofPtr->setNodeAccel(accel);
+	return;
+    }
+
     DOF_GrpIter &theDOFGrps = this->getDOFs();
     DOF_Group 	*dofPtr;
     
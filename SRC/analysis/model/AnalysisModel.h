@@ -40,6 +40,7 @@
 // What: "@(#) AnalysisModel.h, revA"
 
 #include <MovableObject.h>
+#include <vector>
 
 class TaggedObjectStorage;
 class Domain;
@@ -51,6 +52,7 @@ class DOF_Group;
 class Vector;
 class FEM_ObjectBroker;
 class ConstraintHandler;
+class NodalStateStore;
 
 class AnalysisModel: public MovableObject
 {
@@ -79,6 +81,12 @@ class AnalysisModel: public MovableObject
     virtual int getNumEqn(void) const ; 
     virtual Graph &getDOFGraph(void);
     virtual Graph &getDOFGroupGraph(void);
+
+    // method to obtain the thread safe FE_Elements grouped by color, no 
+    // two FE_Elements of the same color sharing an equation number, and
+    // the FE_Elements that are not thread safe
+    virtual const std::vector<std::vector<FE_Element *> > &getFE_ElementColors(void);
+    virtual const std::vector<FE_Element *> &getFE_ElementsNotThreadSafe(void);
     
     // methods to update the response quantities at the DOF_Groups,
     // which in turn set the new nodal trial response quantities.
@@ -125,11 +133,16 @@ class AnalysisModel: public MovableObject
 
     
   private:
+    NodalStateStore *getStateStore(void);
+
     Domain *myDomain;
     ConstraintHandler *myHandler;
 
     Graph *myDOFGraph;
     Graph *myGroupGraph;    
+    std::vector<std::vector<FE_Element *> > theFEColors;
+    std::vector<FE_Element *> theFEsNotThreadSafe;
+    bool colorsBuiltFlag;
     
     int numFE_Ele;             // number of FE_Elements objects added
     int numDOF_Grp;            // number of DOF_Group objects added
@@ -137,6 +150,12 @@ class AnalysisModel: public MovableObject
 
     TaggedObjectStorage  *theFEs;
     TaggedObjectStorage  *theDOFs;
+
+    // equation number of each slot of the Domain's NodalStateStore and
+    // the DOF_Groups whose nodes the store does not set
+    std::vector<int> theStateEqns;
+    std::vector<DOF_Group *> theOtherDOFs;
+    int stateEqnsStamp;
     
     FE_EleIter    *theFEiter;     
     DOF_GrpIter   *theDOFiter;    
@@ -1144,6 +1144,8 @@
 #define LinSOE_TAGS_PFEMCompressibleLinSOE 28
 #define LinSOE_TAGS_PFEMQuasiLinSOE 29
 #define LinSOE_TAGS_PFEMDiaLinSOE 30
+#define LinSOE_TAGS_SupernodalSPDLinSOE 31
+#define LinSOE_TAGS_KrylovLinSOE 32
 #define LinSOE_TAGS_SparsePythonCompressedLinSOE 100101
 #define LinSOE_TAGS_SparsePythonCOOLinSOE        100102
 #define LinSOE_TAGS_PARDISOGenLinSOE 99990
@@ -1182,6 +1184,8 @@
 #define SOLVER_TAGS_CuSP                                31
 #define SOLVER_TAGS_PFEMQuasiSolver                     32
 #define SOLVER_TAGS_PFEMDiaSolver                       33
+#define SOLVER_TAGS_SupernodalSPDLinSolver              34
+#define SOLVER_TAGS_KrylovLinSolver                     35
 #define SOLVER_TAGS_SparsePythonCompressedLinSolver     100201
 #define SOLVER_TAGS_SparsePythonCOOLinSolver            100202
 
@@ -1223,6 +1227,7 @@
 #define OPS_STREAM_TAGS_DataTurbineStream   10
 #define OPS_STREAM_TAGS_DataFileStreamAdd   11
 #define OPS_STREAM_TAGS_SocketStream        12
+#define OPS_STREAM_TAGS_ColumnFileStream    13
 
 #define DomDecompALGORITHM_TAGS_DomainDecompAlgo 1
 
@@ -32,6 +32,7 @@
 #include <elementAPI.h>
 #ifdef _PARALLEL_INTERPRETERS
 #include <mpi.h>
+#include <MPI_Channel.h>
 #endif
 
 void* OPS_CTestPFEM()
@@ -193,6 +194,7 @@ int CTestPFEM::test(void)
 	allnorms[5] = normrespi;
     }
 
+    MPI_Channel::flushAll();
     if(MPI_Bcast(&allnorms,6,MPI_DOUBLE,0,MPI_COMM_WORLD) != MPI_SUCCESS) {
 	opserr<<"WARNING: failed to copy norms to all processors\n";
 	return -1;
@@ -64,6 +64,11 @@ public:
     virtual int    update(void) = 0;
     virtual double getInitialLength(void) = 0;
     virtual double getDeformedLength(void) = 0;
+
+    // true if the state and work storage used by update() and the
+    // get methods are private to each object (or thread), so that
+    // different transformations may be used concurrently
+    virtual bool isThreadSafe(void) {return false;};
     
     virtual int commitState(void) = 0;
     virtual int revertToLastCommit(void) = 0;
@@ -56,6 +56,7 @@ public:
     
     int initialize(Node *node1Pointer, Node *node2Pointer);
     int update(void);
+    bool isThreadSafe(void) {return true;};
     double getInitialLength(void);
     double getDeformedLength(void);
     
@@ -122,8 +123,8 @@ private:
     double cosTheta, sinTheta;  // direction cosines of undeformed element wrt to global system 
     double L;  // undeformed element length
 
-    static Matrix Tlg;  // matrix that transforms from global to local coordinates
-    static Matrix kg;   // global stiffness matrix
+    static thread_local Matrix Tlg;  // matrix that transforms from global to local coordinates
+    static thread_local Matrix kg;   // global stiffness matrix
 
     double *nodeIInitialDisp, *nodeJInitialDisp;
     bool initialDispChecked;
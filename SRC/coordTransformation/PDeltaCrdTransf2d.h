@@ -58,6 +58,7 @@ public:
     
     int initialize(Node *node1Pointer, Node *node2Pointer);
     int update(void);
+    bool isThreadSafe(void) {return true;};
     double getInitialLength(void);
     double getDeformedLength(void);
     
@@ -106,8 +107,8 @@ private:
     double L;     // undeformed element length
     double ul14;  // Transverse local displacement offset of P-Delta
     
-    static Matrix Tlg;  // matrix that transforms from global to local coordinates
-    static Matrix kg;   // global stiffness matrix
+    static thread_local Matrix Tlg;  // matrix that transforms from global to local coordinates
+    static thread_local Matrix kg;   // global stiffness matrix
     
     double *nodeIInitialDisp, *nodeJInitialDisp;
     bool initialDispChecked;
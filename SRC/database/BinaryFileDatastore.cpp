@@ -0,0 +1,439 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the class implementation for
+// BinaryFileDatastore.
+
+#include "BinaryFileDatastore.h"
+
+#include <string.h>
+
+#include <OPS_Globals.h>
+#include <ID.h>
+#include <Vector.h>
+#include <Matrix.h>
+
+using std::ios;
+
+#define DATASTORE_MAGIC         "OPSDATA"
+#define DATASTORE_VERSION       1
+#define DATASTORE_HEADER_SIZE   24
+#define DATASTORE_RECORD_SIZE   16
+#define DATASTORE_BUFFER_SIZE   67108864
+#define DATASTORE_READ_SIZE     1048576
+
+#define RECORD_ID       1
+#define RECORD_VECTOR   2
+#define RECORD_MATRIX   3
+#define RECORD_COMMIT   4
+
+BinaryFileDatastore::BinaryFileDatastore(const char *name,
+					 Domain &theDomain,
+					 FEM_ObjectBroker &theObjBroker)
+  :FE_Datastore(theDomain, theObjBroker),
+   fileName(0), fileEnd(0), lastCommit(0), readStart(0)
+{
+  fileName = new char [strlen(name)+1];
+  strcpy(fileName, name);
+
+  this->openFile();
+}
+
+BinaryFileDatastore::~BinaryFileDatastore()
+{
+  // records sent since the last commit are not kept
+  if (theFile.is_open())
+    theFile.close();
+
+  if (fileName != 0)
+    delete [] fileName;
+}
+
+
+int
+BinaryFileDatastore::commitState(int commitTag)
+{
+  int result = FE_Datastore::commitState(commitTag);
+  if (result < 0 || theFile.is_open() == false)
+    return -1;
+
+  // append the commit record listing the records sent for this commit
+  long long offset = fileEnd + theBuffer.size();
+  int numEntries = theUncommitted.size();
+  int header[4] = {RECORD_COMMIT, 0, commitTag, numEntries};
+
+  const char *data = (const char *)header;
+  theBuffer.insert(theBuffer.end(), data, data+DATASTORE_RECORD_SIZE);
+  data = (const char *)&lastCommit;
+  theBuffer.insert(theBuffer.end(), data, data+sizeof(long long));
+  data = (const char *)theUncommitted.data();
+  theBuffer.insert(theBuffer.end(), data, data+numEntries*sizeof(Entry));
+
+  if (this->writeBuffer() < 0)
+    return -1;
+
+  // only now does the header point to the new commit
+  theFile.seekp(16, ios::beg);
+  theFile.write((const char *)&offset, sizeof(long long));
+  theFile.flush();
+  if (theFile.fail()) {
+    opserr << "BinaryFileDatastore::commitState() - error writing to file " << fileName << endln;
+    theFile.clear();
+    return -1;
+  }
+
+  lastCommit = offset;
+  theUncommitted.clear();
+
+  return result;
+}
+
+
+int
+BinaryFileDatastore::sendMsg(int dataTag, int commitTag,
+			     const Message &,
+			     ChannelAddress *theAddress)
+{
+  opserr << "BinaryFileDatastore::sendMsg() - not yet implemented\n";
+  return -1;
+}
+
+int
+BinaryFileDatastore::recvMsg(int dataTag, int commitTag,
+			     Message &,
+			     ChannelAddress *theAddress)
+{
+  opserr << "BinaryFileDatastore::recvMsg() - not yet implemented\n";
+  return -1;
+}
+
+int
+BinaryFileDatastore::recvMsgUnknownSize(int dataTag, int commitTag,
+					Message &,
+					ChannelAddress *theAddress)
+{
+  opserr << "BinaryFileDatastore::recvMsgUnknownSize() - not yet implemented\n";
+  return -1;
+}
+
+
+int
+BinaryFileDatastore::sendMatrix(int dataTag, int commitTag,
+				const Matrix &theMatrix,
+				ChannelAddress *theAddress)
+{
+  int size = theMatrix.noRows()*theMatrix.noCols();
+  const void *theData = (size > 0) ? &const_cast<Matrix &>(theMatrix)(0,0) : 0;
+
+  if (this->sendData(RECORD_MATRIX, dataTag, commitTag, theData, size) < 0) {
+    opserr << "BinaryFileDatastore::sendMatrix() - failed\n";
+    return -1;
+  }
+
+  return 0;
+}
+
+int
+BinaryFileDatastore::recvMatrix(int dataTag, int commitTag,
+				Matrix &theMatrix,
+				ChannelAddress *theAddress)
+{
+  int size = theMatrix.noRows()*theMatrix.noCols();
+  void *theData = (size > 0) ? &theMatrix(0,0) : 0;
+
+  if (this->recvData(RECORD_MATRIX, dataTag, commitTag, theData, size) < 0) {
+    opserr << "BinaryFileDatastore::recvMatrix() - failed\n";
+    return -1;
+  }
+
+  return 0;
+}
+
+
+int
+BinaryFileDatastore::sendVector(int dataTag, int commitTag,
+				const Vector &theVector,
+				ChannelAddress *theAddress)
+{
+  int size = theVector.Size();
+  const void *theData = (size > 0) ? &const_cast<Vector &>(theVector)(0) : 0;
+
+  if (this->sendData(RECORD_VECTOR, dataTag, commitTag, theData, size) < 0) {
+    opserr << "BinaryFileDatastore::sendVector() - failed\n";
+    return -1;
+  }
+
+  return 0;
+}
+
+int
+BinaryFileDatastore::recvVector(int dataTag, int commitTag,
+				Vector &theVector,
+				ChannelAddress *theAddress)
+{
+  int size = theVector.Size();
+  void *theData = (size > 0) ? &theVector(0) : 0;
+
+  if (this->recvData(RECORD_VECTOR, dataTag, commitTag, theData, size) < 0) {
+    opserr << "BinaryFileDatastore::recvVector() - failed\n";
+    return -1;
+  }
+
+  return 0;
+}
+
+
+int
+BinaryFileDatastore::sendID(int dataTag, int commitTag,
+			    const ID &theID,
+			    ChannelAddress *theAddress)
+{
+  int size = theID.Size();
+  const void *theData = (size > 0) ? &const_cast<ID &>(theID)(0) : 0;
+
+  if (this->sendData(RECORD_ID, dataTag, commitTag, theData, size) < 0) {
+    opserr << "BinaryFileDatastore::sendID() - failed\n";
+    return -1;
+  }
+
+  return 0;
+}
+
+int
+BinaryFileDatastore::recvID(int dataTag, int commitTag,
+			    ID &theID,
+			    ChannelAddress *theAddress)
+{
+  int size = theID.Size();
+  void *theData = (size > 0) ? &theID(0) : 0;
+
+  if (this->recvData(RECORD_ID, dataTag, commitTag, theData, size) < 0) {
+    opserr << "BinaryFileDatastore::recvID() - failed\n";
+    return -1;
+  }
+
+  return 0;
+}
+
+
+// int openFile(void);
+// Opens the file, creating it if it does not exist, and rebuilds the
+// table of records by following the commit records back from the last.
+
+int
+BinaryFileDatastore::openFile(void)
+{
+  theFile.open(fileName, ios::in | ios::out | ios::binary);
+
+  // if file did not exist, need to pass trunc flag to open it
+  if (theFile.is_open() == false) {
+    theFile.clear();
+    theFile.open(fileName, ios::in | ios::out | ios::trunc | ios::binary);
+  }
+
+  if (theFile.is_open() == false) {
+    opserr << "FATAL - BinaryFileDatastore::openFile() - could not open file " << fileName << endln;
+    return -1;
+  }
+
+  theFile.seekg(0, ios::end);
+  long long size = theFile.tellg();
+
+  char magic[8] = DATASTORE_MAGIC;
+  int version[2] = {DATASTORE_VERSION, 0};
+
+  // a new file
+  if (size < DATASTORE_HEADER_SIZE) {
+    theFile.seekp(0, ios::beg);
+    theFile.write(magic, 8);
+    theFile.write((const char *)version, 2*sizeof(int));
+    theFile.write((const char *)&lastCommit, sizeof(long long));
+    fileEnd = DATASTORE_HEADER_SIZE;
+    return 0;
+  }
+
+  char fileMagic[8];
+  int fileVersion[2];
+  theFile.seekg(0, ios::beg);
+  theFile.read(fileMagic, 8);
+  theFile.read((char *)fileVersion, 2*sizeof(int));
+  theFile.read((char *)&lastCommit, sizeof(long long));
+
+  if (theFile.fail() || memcmp(magic, fileMagic, 8) != 0 || fileVersion[0] != DATASTORE_VERSION) {
+    opserr << "FATAL - BinaryFileDatastore::openFile() - " << fileName
+	   << " is not a file written by a BinaryFileDatastore\n";
+    theFile.close();
+    lastCommit = 0;
+    return -1;
+  }
+
+  // data after the last commit record is overwritten
+  fileEnd = DATASTORE_HEADER_SIZE;
+
+  std::vector<Entry> theEntries;
+  long long offset = lastCommit;
+  while (offset != 0) {
+    int header[4];
+    long long previous;
+    theFile.seekg(offset, ios::beg);
+    theFile.read((char *)header, DATASTORE_RECORD_SIZE);
+    theFile.read((char *)&previous, sizeof(long long));
+    if (theFile.fail() || header[0] != RECORD_COMMIT || header[3] < 0) {
+      opserr << "FATAL - BinaryFileDatastore::openFile() - " << fileName
+	     << " is corrupt at " << OPS_Stream::toString(offset).c_str() << endln;
+      theRecords.clear();
+      theFile.close();
+      return -1;
+    }
+
+    int numEntries = header[3];
+    theEntries.resize(numEntries);
+    if (numEntries > 0)
+      theFile.read((char *)theEntries.data(), numEntries*sizeof(Entry));
+
+    if (offset == lastCommit)
+      fileEnd = offset + DATASTORE_RECORD_SIZE + sizeof(long long) + numEntries*sizeof(Entry);
+
+    // later records replace earlier ones with the same key
+    for (int i=numEntries-1; i>=0; i--)
+      theRecords.emplace(theEntries[i].key, theEntries[i].offset);
+
+    offset = previous;
+  }
+
+  theFile.clear();
+
+  return 0;
+}
+
+
+// int sendData(int type, int dbTag, int commitTag, const void *theData, int size);
+// Appends a record to the buffer; the buffer is written at the next
+// commit, or once it holds more than DATASTORE_BUFFER_SIZE bytes.
+
+int
+BinaryFileDatastore::sendData(int type, int dbTag, int commitTag,
+			      const void *theData, int size)
+{
+  if (theFile.is_open() == false)
+    return -1;
+
+  int numBytes = size*((type == RECORD_ID) ? sizeof(int) : sizeof(double));
+  int numPadded = (numBytes + 7) & ~7;
+
+  Entry theEntry;
+  theEntry.key.type = type;
+  theEntry.key.size = size;
+  theEntry.key.dbTag = dbTag;
+  theEntry.key.commitTag = commitTag;
+  theEntry.offset = fileEnd + theBuffer.size();
+
+  int header[4] = {type, dbTag, commitTag, size};
+  const char *data = (const char *)header;
+  theBuffer.insert(theBuffer.end(), data, data+DATASTORE_RECORD_SIZE);
+  data = (const char *)theData;
+  theBuffer.insert(theBuffer.end(), data, data+numBytes);
+  theBuffer.resize(theBuffer.size() + numPadded - numBytes, 0);
+
+  theRecords[theEntry.key] = theEntry.offset;
+  theUncommitted.push_back(theEntry);
+
+  if (theBuffer.size() > DATASTORE_BUFFER_SIZE)
+    return this->writeBuffer();
+
+  return 0;
+}
+
+
+int
+BinaryFileDatastore::recvData(int type, int dbTag, int commitTag,
+			      void *theData, int size)
+{
+  if (theFile.is_open() == false)
+    return -1;
+
+  Key key;
+  key.type = type;
+  key.size = size;
+  key.dbTag = dbTag;
+  key.commitTag = commitTag;
+
+  std::unordered_map<Key, long long, KeyHash>::iterator theRecord = theRecords.find(key);
+  if (theRecord == theRecords.end()) {
+    opserr << "BinaryFileDatastore::recvData() - no data of size " << size << " with dbTag "
+	   << dbTag << " for commitTag " << commitTag << endln;
+    return -1;
+  }
+
+  long long offset = theRecord->second + DATASTORE_RECORD_SIZE;
+  int numBytes = size*((type == RECORD_ID) ? sizeof(int) : sizeof(double));
+  if (numBytes == 0)
+    return 0;
+
+  // the record may not have been written yet
+  if (offset >= fileEnd) {
+    memcpy(theData, &theBuffer[offset-fileEnd], numBytes);
+    return 0;
+  }
+
+  // a seek discards the buffer of the stream, so the file is read in
+  // large blocks; a restore then reads most records from the last block
+  if (offset < readStart || offset + numBytes > readStart + (long long)theReadBuffer.size()) {
+    long long numRead = (numBytes > DATASTORE_READ_SIZE) ? numBytes : DATASTORE_READ_SIZE;
+    if (numRead > fileEnd - offset)
+      numRead = fileEnd - offset;
+
+    readStart = offset;
+    theReadBuffer.resize(numRead);
+    theFile.seekg(offset, ios::beg);
+    theFile.read(theReadBuffer.data(), numRead);
+    if (theFile.fail()) {
+      opserr << "BinaryFileDatastore::recvData() - error reading file " << fileName << endln;
+      theFile.clear();
+      theReadBuffer.clear();
+      return -1;
+    }
+  }
+
+  memcpy(theData, &theReadBuffer[offset-readStart], numBytes);
+
+  return 0;
+}
+
+
+int
+BinaryFileDatastore::writeBuffer(void)
+{
+  if (theBuffer.empty() == true)
+    return 0;
+
+  theFile.seekp(fileEnd, ios::beg);
+  theFile.write(theBuffer.data(), theBuffer.size());
+  if (theFile.fail()) {
+    opserr << "BinaryFileDatastore - error writing to file " << fileName << endln;
+    theFile.clear();
+    return -1;
+  }
+
+  fileEnd += theBuffer.size();
+  theBuffer.clear();
+
+  return 0;
+}
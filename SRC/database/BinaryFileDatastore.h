@@ -0,0 +1,151 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef BinaryFileDatastore_h
+#define BinaryFileDatastore_h
+
+// Description: This file contains the class definition for
+// BinaryFileDatastore. BinaryFileDatastore is a concrete subclass of
+// FE_Datastore which keeps all the data of all the commits in a single
+// binary file that is only ever appended to. Each ID, Vector and Matrix
+// sent is appended as a record:
+//
+//   int32 type, int32 dbTag, int32 commitTag, int32 size, then the
+//   size ints or doubles, padded to a multiple of 8 bytes
+//
+// behind a file header of char magic[8] "OPSDATA", int32 version,
+// int32 0 and int64 lastCommit. At the end of commitState() a commit
+// record is appended, holding the offset of the previous commit record
+// and (type, size, dbTag, commitTag, offset) of every record sent since,
+// and lastCommit in the header is set to it. The records are in the
+// byte order of the machine and their data is 8 byte aligned, so the
+// file can be memory mapped.
+//
+// The records are found through a hash table keyed on type, size, dbTag
+// and commitTag, as FileDatastore keys its files and entries on them;
+// the latest record sent for a key is the one received. When an
+// existing file is opened the table is rebuilt from the chain of commit
+// records, and data written after the last complete commit is dropped.
+// As the domain only sends its geometry when it has changed, every
+// commit after the first mostly adds the state of the components.
+//
+// It is not a faster FileDatastore: saves and restores take about as
+// long with either, as their time goes to sendSelf() and recvSelf() of
+// the components. What it adds is that a checkpoint is only published
+// by the header update at the end of commitState(), so a run killed
+// during a save leaves the earlier checkpoints intact and readable, and
+// that all the checkpoints are in one file rather than in a file for
+// each size of ID, Vector and Matrix and each commit.
+
+#include <FE_Datastore.h>
+
+#include <fstream>
+#include <vector>
+#include <unordered_map>
+
+class FEM_ObjectBroker;
+
+class BinaryFileDatastore: public FE_Datastore
+{
+  public:
+    BinaryFileDatastore(const char *fileName,
+			Domain &theDomain,
+			FEM_ObjectBroker &theBroker);
+    ~BinaryFileDatastore();
+
+    // methods for sending and receiving the data
+    int sendMsg(int dbTag, int commitTag,
+		const Message &,
+		ChannelAddress *theAddress =0);
+    int recvMsg(int dbTag, int commitTag,
+		Message &,
+		ChannelAddress *theAddress =0);
+    int recvMsgUnknownSize(int dbTag, int commitTag,
+		Message &,
+		ChannelAddress *theAddress =0);
+
+    int sendMatrix(int dbTag, int commitTag,
+		   const Matrix &theMatrix,
+		   ChannelAddress *theAddress =0);
+    int recvMatrix(int dbTag, int commitTag,
+		   Matrix &theMatrix,
+		   ChannelAddress *theAddress =0);
+
+    int sendVector(int dbTag, int commitTag,
+		   const Vector &theVector,
+		   ChannelAddress *theAddress =0);
+    int recvVector(int dbTag, int commitTag,
+		   Vector &theVector,
+		   ChannelAddress *theAddress =0);
+
+    int sendID(int dbTag, int commitTag,
+	       const ID &theID,
+	       ChannelAddress *theAddress =0);
+    int recvID(int dbTag, int commitTag,
+	       ID &theID,
+	       ChannelAddress *theAddress =0);
+
+    // the commitState method
+    int commitState(int commitTag);
+
+  private:
+    struct Key {
+      int type;
+      int size;
+      int dbTag;
+      int commitTag;
+      bool operator==(const Key &other) const {
+	return type == other.type && size == other.size &&
+	  dbTag == other.dbTag && commitTag == other.commitTag;
+      }
+    };
+
+    struct KeyHash {
+      size_t operator()(const Key &key) const {
+	size_t h = (unsigned int)key.dbTag;
+	h = h*1000003 ^ (unsigned int)key.commitTag;
+	h = h*1000003 ^ (unsigned int)key.size;
+	return h*1000003 ^ (unsigned int)key.type;
+      }
+    };
+
+    struct Entry {
+      Key key;
+      long long offset;
+    };
+
+    int openFile(void);
+    int sendData(int type, int dbTag, int commitTag, const void *theData, int size);
+    int recvData(int type, int dbTag, int commitTag, void *theData, int size);
+    int writeBuffer(void);
+
+    char *fileName;
+    std::fstream theFile;
+    long long fileEnd;        // where the buffer goes
+    long long lastCommit;     // offset of the last commit record, 0 if none
+
+    std::unordered_map<Key, long long, KeyHash> theRecords;
+    std::vector<Entry> theUncommitted;  // records sent since the last commit
+    std::vector<char> theBuffer;        // records not yet written
+    std::vector<char> theReadBuffer;    // part of the file last read
+    long long readStart;                // where theReadBuffer starts
+};
+
+#endif
@@ -46,6 +46,7 @@
 
 // known databases
 #include <FileDatastore.h>
+#include <BinaryFileDatastore.h>
 
 // linked list of struct for other types of
 // databases that can be added dynamically
@@ -96,7 +97,7 @@ TclAddDatabase(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **a
 
   // make sure at least one other argument to contain integrator
   if (argc < 2) {
-    opserr << "WARNING need to specify a Database type; valid type File, MySQL, BerkeleyDB \n";
+    opserr << "WARNING need to specify a Database type; valid type File, Binary, MySQL, BerkeleyDB \n";
     return TCL_ERROR;
   }    
 
@@ -123,6 +124,21 @@ TclAddDatabase(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **a
       return TCL_ERROR;
     } 
     
+    return TCL_OK;
+
+  // a single binary file
+  } else if (strcmp(argv[1],"Binary") == 0) {
+    if (argc < 3) {
+      opserr << "WARNING database Binary fileName? ";
+      return TCL_ERROR;
+    }
+
+    // delete the old database
+    if (theDatabase != 0)
+      delete theDatabase;
+
+    theDatabase = new BinaryFileDatastore(argv[2], theDomain, theBroker);
+
     return TCL_OK;
   } else {
 
@@ -173,7 +189,7 @@ TclAddDatabase(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **a
     }
   }
   opserr << "WARNING No database type exists ";
-  opserr << "for database of type:" << argv[1] << "valid database type File\n";
+  opserr << "for database of type:" << argv[1] << "valid database type File, Binary\n";
 
   return TCL_ERROR;
 }    
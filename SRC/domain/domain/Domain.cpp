@@ -54,9 +54,11 @@
 #include <LoadPattern.h>
 #include <Parameter.h>
 #include <Response.h>
+#include <Profiler.h>
 
 #include <MapOfTaggedObjects.h>
 #include <MapOfTaggedObjectsIter.h>
+#include <TaggedObjectIter.h>
 
 #include <SingleDomEleIter.h>
 #include <SingleDomNodIter.h>
@@ -83,6 +85,12 @@
 #include <FEM_ObjectBroker.h>
 
 #include <DomainModalProperties.h>
+#include <Information.h>
+#include <NodalStateStore.h>
+#include <chrono>
+#include <map>
+#include <vector>
+#include <algorithm>
 
 //
 // global variables
@@ -93,6 +101,8 @@ double        ops_Dt = 0.0;
 bool          ops_InitialStateAnalysis = false;
 int           ops_Creep = 0;
 
+thread_local bool Domain::updatesGlobals = true;
+
 Domain::Domain()
 :theRecorders(0), numRecorders(0),
  currentTime(0.0), committedTime(0.0), dT(0.0), currentGeoTag(0),
@@ -105,8 +115,12 @@ Domain::Domain()
  theModalProperties(0),
  theModalDampingFactors(0), inclModalMatrix(false),
  lastChannel(0),
- paramIndex(0), paramSize(0), numParameters(0)
+ paramIndex(0), paramSize(0), numParameters(0),
+ numThreads(1), sweepArraysBuiltFlag(false),
+ theNodalStateStore(0), nodalStateBuiltFlag(false)
 {
+    this->resetPhaseStats();
+
   
     // init the arrays for storing the domain components
     theElements = new MapOfTaggedObjects();
@@ -162,8 +176,12 @@ Domain::Domain(int numNodes, int numElements, int numSPs, int numMPs, int numEQs
  theBounds(6), theEigenvalues(0), theEigenvalueSetTime(0), 
  theModalProperties(0),
  theModalDampingFactors(0), inclModalMatrix(false),
- lastChannel(0), paramIndex(0), paramSize(0), numParameters(0)
+ lastChannel(0), paramIndex(0), paramSize(0), numParameters(0),
+ numThreads(1), sweepArraysBuiltFlag(false),
+ theNodalStateStore(0), nodalStateBuiltFlag(false)
 {
+    this->resetPhaseStats();
+
     // init the arrays for storing the domain components
     theElements = new MapOfTaggedObjects();
     theNodes    = new MapOfTaggedObjects();
@@ -227,8 +245,12 @@ Domain::Domain(TaggedObjectStorage &theNodesStorage,
  theBounds(6), theEigenvalues(0), theEigenvalueSetTime(0), 
  theModalProperties(0),
  theModalDampingFactors(0), inclModalMatrix(false),
- lastChannel(0),paramIndex(0), paramSize(0), numParameters(0)
+ lastChannel(0),paramIndex(0), paramSize(0), numParameters(0),
+ numThreads(1), sweepArraysBuiltFlag(false),
+ theNodalStateStore(0), nodalStateBuiltFlag(false)
 {
+    this->resetPhaseStats();
+
     // init the arrays for storing the domain components
     thePCs      = new MapOfTaggedObjects();
 
@@ -288,8 +310,12 @@ Domain::Domain(TaggedObjectStorage &theStorage)
  theBounds(6), theEigenvalues(0), theEigenvalueSetTime(0), 
  theModalProperties(0),
  theModalDampingFactors(0), inclModalMatrix(false),
- lastChannel(0),paramIndex(0), paramSize(0), numParameters(0)
+ lastChannel(0),paramIndex(0), paramSize(0), numParameters(0),
+ numThreads(1), sweepArraysBuiltFlag(false),
+ theNodalStateStore(0), nodalStateBuiltFlag(false)
 {
+    this->resetPhaseStats();
+
     // init the arrays for storing the domain components
     theStorage.clearAll(); // clear the storage just in case populated
     theElements = &theStorage;
@@ -346,6 +372,9 @@ Domain::~Domain()
   // delete the objects in the domain
   this->Domain::clearAll();
 
+  if (theNodalStateStore != 0)
+    delete theNodalStateStore;
+
   // delete all the storage objects
   // SEGMENT FAULT WILL OCCUR IF THESE OBJECTS WERE NOT CONSTRUCTED
   // USING NEW
@@ -1045,6 +1074,11 @@ Domain::clearAll(void) {
   while ((thePattern = thePatterns()) != 0)
     thePattern->clearAll();
 
+  // the nodes must own their response before they are deleted
+  if (theNodalStateStore != 0)
+    theNodalStateStore->clear();
+  nodalStateBuiltFlag = false;
+
   // clean out the containers
   theElements->clearAll();
   theNodes->clearAll();
@@ -1099,6 +1133,7 @@ Domain::clearAll(void) {
   hasDomainChangedFlag = false;
   nodeGraphBuiltFlag = false;
   eleGraphBuiltFlag = false;
+  sweepArraysBuiltFlag = false;
   
   dbEle =0; dbNod =0; dbSPs =0; dbPCs = 0; dbMPs = 0; dbEQs = 0; dbLPs = 0; dbParam = 0;
 
@@ -1156,6 +1191,10 @@ Domain::removeNode(int tag)
   // mark the domain has having changed 
   this->domainChange();
 
+  // the node is handed back with its own copy of the response
+  if (theNodalStateStore != 0)
+    theNodalStateStore->clear();
+
   // adjust node bounds 
   resetBounds = true;
   
@@ -2067,7 +2106,8 @@ Domain::applyLoad(double timeStep)
       theSP->applyConstraint(timeStep);
     }
 
-    ops_Dt = dT;
+    if (updatesGlobals == true)
+      ops_Dt = dT;
 }
 
 
@@ -2137,6 +2177,9 @@ Domain::setRayleighDampingFactors(double alphaM, double betaK, double betaK0, do
 int
 Domain::record(bool fromAnalysis)
 {
+  static int recordRegion = Profiler::getRegion("record");
+  ProfilerScope theScope(recordRegion);
+
   int res = 0;
 
   // invoke record on all recorders
@@ -2153,29 +2196,50 @@ Domain::record(bool fromAnalysis)
 int
 Domain::commit(void)
 {
+    static int commitRegion = Profiler::getRegion("commit");
+    static int recordRegion = Profiler::getRegion("record");
+    ProfilerScope theScope(commitRegion);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
     // 
     // first invoke commit on all nodes and elements in the domain
     //
-    Node *nodePtr;
-    NodeIter &theNodeIter = this->getNodes();
-    while ((nodePtr = theNodeIter()) != 0) {
-      nodePtr->commitState();
-    }
+    if (numThreads > 1)
+      this->sweepParallel(COMMIT_PHASE);
+    else {
+      NodalStateStore *theStore = this->getNodalStateStore();
+      if (theStore != 0)
+	theStore->commitState();
+      else {
+	Node *nodePtr;
+	NodeIter &theNodeIter = this->getNodes();
+	while ((nodePtr = theNodeIter()) != 0) {
+	  nodePtr->commitState();
+	}
+      }
 
-    Element *elePtr;
-    ElementIter &theElemIter = this->getElements();    
-    while ((elePtr = theElemIter()) != 0) {
-      elePtr->commitState();
+      Element *elePtr;
+      ElementIter &theElemIter = this->getElements();    
+      while ((elePtr = theElemIter()) != 0) {
+	elePtr->commitState();
+      }
     }
 
+    phaseTime[COMMIT_PHASE] += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    phaseCount[COMMIT_PHASE]++;
+
     // set the new committed time in the domain
     committedTime = currentTime;
     dT = 0.0;
 
     // invoke record on all recorders
-    for (int i=0; i<numRecorders; i++)
-      if (theRecorders[i] != 0)
-	theRecorders[i]->record(commitTag, currentTime);
+    {
+      ProfilerScope recordScope(recordRegion);
+      for (int i=0; i<numRecorders; i++)
+	if (theRecorders[i] != 0)
+	  theRecorders[i]->record(commitTag, currentTime);
+    }
 
     // update the commitTag
     commitTag++;
@@ -2185,21 +2249,35 @@ Domain::commit(void)
 int
 Domain::revertToLastCommit(void)
 {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
     // 
     // first invoke revertToLastCommit  on all nodes and elements in the domain
     //
     
-    Node *nodePtr;
-    NodeIter &theNodeIter = this->getNodes();
-    while ((nodePtr = theNodeIter()) != 0)
-	nodePtr->revertToLastCommit();
+    if (numThreads > 1)
+      this->sweepParallel(REVERT_PHASE);
+    else {
+      NodalStateStore *theStore = this->getNodalStateStore();
+      if (theStore != 0)
+	theStore->revertToLastCommit();
+      else {
+	Node *nodePtr;
+	NodeIter &theNodeIter = this->getNodes();
+	while ((nodePtr = theNodeIter()) != 0)
+	  nodePtr->revertToLastCommit();
+      }
     
-    Element *elePtr;
-    ElementIter &theElemIter = this->getElements();    
-    while ((elePtr = theElemIter()) != 0) {
+      Element *elePtr;
+      ElementIter &theElemIter = this->getElements();    
+      while ((elePtr = theElemIter()) != 0) {
 	elePtr->revertToLastCommit();
+      }
     }
 
+    phaseTime[REVERT_PHASE] += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    phaseCount[REVERT_PHASE]++;
+
     // set the current time and load factor in the domain to last committed
     currentTime = committedTime;
     dT = 0.0;
@@ -2249,21 +2327,42 @@ Domain::revertToStart(void)
 int
 Domain::update(void)
 {
+  static int updateRegion = Profiler::getRegion("update");
+  ProfilerScope theScope(updateRegion);
+
   // set the global constants
-  ops_Dt = dT;
-  ops_TheActiveDomain = this;
+  if (updatesGlobals == true) {
+    ops_Dt = dT;
+    ops_TheActiveDomain = this;
+  }
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
 
   int ok = 0;
 
   // invoke update on all the ele's
-  ElementIter &theEles = this->getElements();
-  Element *theEle;
+  if (numThreads > 1)
+    ok = this->sweepParallel(UPDATE_PHASE);
+  else {
+    ElementIter &theEles = this->getElements();
+    Element *theEle;
 
-  while ((theEle = theEles()) != 0) {
-    ops_TheActiveElement = theEle;
-    ok += theEle->update();
+    // when profiling, the time of each element is kept under its class
+    bool profile = Profiler::isEnabled();
+    bool measure = Element::measuresCosts();
+    while ((theEle = theEles()) != 0) {
+      ops_TheActiveElement = theEle;
+      ProfilerScope eleScope(profile ? Profiler::getClassRegion(theEle->getClassTag(), theEle->getClassType()) : -1);
+      if (measure)
+	ok += theEle->measureUpdate();
+      else
+	ok += theEle->update();
+    }
   }
 
+  phaseTime[UPDATE_PHASE] += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  phaseCount[UPDATE_PHASE]++;
+
   if (ok != 0)
     opserr << "Domain::update - domain failed in update\n";
 
@@ -2280,6 +2379,344 @@ Domain::update(double newTime, double dT)
   return 0;
 }
 
+// sweepParallel() - invokes commitState(), revertToLastCommit() or
+// update() on all the nodes and elements, chunks of the element array
+// being handed out to the threads. Elements that are not thread safe
+// are done one at a time in a critical section. The return values of
+// the elements are summed as in the serial loops.
+int
+Domain::sweepParallel(int phase)
+{
+  if (sweepArraysBuiltFlag == false) {
+    theNodeArray.clear();
+    theNodeArray.reserve(this->getNumNodes());
+    Node *nodePtr;
+    NodeIter &theNodeIter = this->getNodes();
+    while ((nodePtr = theNodeIter()) != 0)
+      theNodeArray.push_back(nodePtr);
+
+    // isThreadSafe() may ask every material of the element, which can
+    // cost as much as an update, so it is asked once here
+    theEleArray.clear();
+    theEleArray.reserve(this->getNumElements());
+    theEleThreadSafe.clear();
+    theEleThreadSafe.reserve(this->getNumElements());
+    Element *elePtr;
+    ElementIter &theElemIter = this->getElements();
+    while ((elePtr = theElemIter()) != 0) {
+      theEleArray.push_back(elePtr);
+      theEleThreadSafe.push_back(elePtr->isThreadSafe());
+    }
+
+    sweepArraysBuiltFlag = true;
+  }
+
+  int numNod = theNodeArray.size();
+  int numEle = theEleArray.size();
+  int ok = 0;
+
+  // nodes only copy their own trial and committed response
+  NodalStateStore *theStore = this->getNodalStateStore();
+  if (phase != UPDATE_PHASE && theStore != 0) {
+    if (phase == COMMIT_PHASE)
+      theStore->commitState(numThreads);
+    else
+      theStore->revertToLastCommit(numThreads);
+  } else if (phase != UPDATE_PHASE) {
+#pragma omp parallel for num_threads(numThreads) schedule(static) if(numNod > 2000)
+    for (int i=0; i<numNod; i++) {
+      if (phase == COMMIT_PHASE)
+	theNodeArray[i]->commitState();
+      else
+	theNodeArray[i]->revertToLastCommit();
+    }
+  }
+
+  bool measure = Element::measuresCosts();
+#pragma omp parallel for num_threads(numThreads) schedule(dynamic,16) reduction(+:ok)
+  for (int i=0; i<numEle; i++) {
+    Element *elePtr = theEleArray[i];
+    int res;
+    ops_TheActiveElement = elePtr;
+    if (theEleThreadSafe[i]) {
+      if (phase == UPDATE_PHASE)
+	res = measure ? elePtr->measureUpdate() : elePtr->update();
+      else if (phase == COMMIT_PHASE)
+	res = elePtr->commitState();
+      else
+	res = elePtr->revertToLastCommit();
+    } else {
+#pragma omp critical (Domain_notThreadSafe)
+      {
+	if (phase == UPDATE_PHASE)
+	  res = measure ? elePtr->measureUpdate() : elePtr->update();
+	else if (phase == COMMIT_PHASE)
+	  res = elePtr->commitState();
+	else
+	  res = elePtr->revertToLastCommit();
+      }
+    }
+    ok += res;
+  }
+
+  return ok;
+}
+
+int
+Domain::setNumThreads(int num)
+{
+  if (num < 1) {
+    opserr << "WARNING Domain::setNumThreads() - number of threads must be at least 1\n";
+    return -1;
+  }
+
+#ifndef _OPENMP
+  if (num > 1) {
+    opserr << "WARNING Domain::setNumThreads() - not built with OpenMP, sweeps will be serial\n";
+    num = 1;
+  }
+#endif
+
+  numThreads = num;
+  return 0;
+}
+
+int
+Domain::getNumThreads(void) const
+{
+  return numThreads;
+}
+
+// setNodalStateStore() - with useStore true the trial and committed
+// response of the nodes is moved into a NodalStateStore, so that the
+// commit and revert sweeps and the AnalysisModel run over contiguous
+// arrays; with false the nodes get their own arrays back.
+int
+Domain::setNodalStateStore(bool useStore)
+{
+  if (useStore == true) {
+    if (theNodalStateStore == 0)
+      theNodalStateStore = new NodalStateStore();
+    nodalStateBuiltFlag = false;
+  } else if (theNodalStateStore != 0) {
+    delete theNodalStateStore;
+    theNodalStateStore = 0;
+    nodalStateBuiltFlag = false;
+  }
+
+  return 0;
+}
+
+// getNodalStateStore() - returns 0 if no store is used, otherwise the
+// store, assigning the nodes their slots if the domain has changed.
+NodalStateStore *
+Domain::getNodalStateStore(void)
+{
+  if (theNodalStateStore == 0)
+    return 0;
+
+  if (nodalStateBuiltFlag == false) {
+    if (theNodalStateStore->setNodes(this->getNodes()) != 0)
+      return 0;
+    nodalStateBuiltFlag = true;
+  }
+
+  return theNodalStateStore;
+}
+
+// setStorage() - moves the components of the given type, "node",
+// "element", "sp" or "mp", into theStorage, which must be empty and
+// which the domain takes over, and deletes the old container. Lets large
+// models with sparse tag numbering use e.g. a HashOfTaggedObjects. On
+// failure theStorage is left empty and remains with the caller.
+int
+Domain::setStorage(const char *componentType, TaggedObjectStorage *theStorage)
+{
+  TaggedObjectStorage **theOldStorage = 0;
+  if (strcmp(componentType, "node") == 0)
+    theOldStorage = &theNodes;
+  else if (strcmp(componentType, "element") == 0)
+    theOldStorage = &theElements;
+  else if (strcmp(componentType, "sp") == 0)
+    theOldStorage = &theSPs;
+  else if (strcmp(componentType, "mp") == 0)
+    theOldStorage = &theMPs;
+  else {
+    opserr << "WARNING Domain::setStorage() - unknown component type " << componentType << endln;
+    return -1;
+  }
+
+  if (theStorage == 0 || theStorage->getNumComponents() != 0) {
+    opserr << "WARNING Domain::setStorage() - the new storage must exist and be empty\n";
+    return -1;
+  }
+
+  TaggedObjectStorage *theOld = *theOldStorage;
+  theStorage->setSize(theOld->getNumComponents());
+
+  TaggedObject *theComponent;
+  TaggedObjectIter &theComponents = theOld->getComponents();
+  while ((theComponent = theComponents()) != 0) {
+    if (theStorage->addComponent(theComponent) == false) {
+      opserr << "WARNING Domain::setStorage() - failed to move component " << theComponent->getTag() << endln;
+      theStorage->clearAll(false);
+      return -1;
+    }
+  }
+
+  theOld->clearAll(false);
+  delete theOld;
+  *theOldStorage = theStorage;
+
+  // the iters are bound to the containers
+  if (theOldStorage == &theNodes) {
+    delete theNodIter;
+    theNodIter = new SingleDomNodIter(theNodes);
+  } else if (theOldStorage == &theElements) {
+    delete theEleIter;
+    theEleIter = new SingleDomEleIter(theElements);
+  } else if (theOldStorage == &theSPs) {
+    delete theSP_Iter;
+    theSP_Iter = new SingleDomSP_Iter(theSPs);
+  } else {
+    delete theMP_Iter;
+    theMP_Iter = new SingleDomMP_Iter(theMPs);
+  }
+
+  this->domainChange();
+  return 0;
+}
+
+// getPhaseStat() - returns the accumulated wall time (commitTime,
+// revertTime, updateTime) or number of calls (numCommit, numRevert,
+// numUpdate) of the domain wide sweeps since the last reset.
+int
+Domain::getPhaseStat(const char *name, Information &theInfo)
+{
+  static const char *timeNames[3] = {"commitTime", "revertTime", "updateTime"};
+  static const char *countNames[3] = {"numCommit", "numRevert", "numUpdate"};
+
+  for (int i=0; i<3; i++) {
+    if (strcmp(name, timeNames[i]) == 0) {
+      theInfo.theType = DoubleType;
+      theInfo.setDouble(phaseTime[i]);
+      return 0;
+    }
+    if (strcmp(name, countNames[i]) == 0) {
+      theInfo.theType = IntType;
+      theInfo.setInt(phaseCount[i]);
+      return 0;
+    }
+  }
+
+  if (strcmp(name, "numThreads") == 0) {
+    theInfo.theType = IntType;
+    theInfo.setInt(numThreads);
+    return 0;
+  }
+
+  return -1;
+}
+
+void
+Domain::resetPhaseStats(void)
+{
+  for (int i=0; i<3; i++) {
+    phaseTime[i] = 0.0;
+    phaseCount[i] = 0;
+  }
+}
+
+// printElementCosts() - prints the measured cost of the elements summed
+// over each class, most expensive class first, followed by the numTop
+// most expensive elements.
+int
+Domain::printElementCosts(OPS_Stream &s, int numTop)
+{
+  struct ClassCost {
+    const char *className;
+    int numEle;
+    ElementCost cost;
+  };
+  std::map<int, ClassCost> classCosts;
+  std::vector<std::pair<double, Element *> > eleTimes;
+  double totalTime = 0.0;
+
+  Element *theEle;
+  ElementIter &theElements = this->getElements();
+  while ((theEle = theElements()) != 0) {
+    const ElementCost *theCost = theEle->getMeasuredCost();
+    if (theCost == 0)
+      continue;
+
+    ClassCost &theClass = classCosts[theEle->getClassTag()];
+    if (theClass.numEle == 0)
+      theClass.className = theEle->getClassType();
+    theClass.numEle++;
+    theClass.cost.numUpdates += theCost->numUpdates;
+    theClass.cost.updateTime += theCost->updateTime;
+    theClass.cost.numTangents += theCost->numTangents;
+    theClass.cost.tangentTime += theCost->tangentTime;
+    theClass.cost.numIterations += theCost->numIterations;
+
+    double time = theCost->updateTime + theCost->tangentTime;
+    eleTimes.push_back(std::make_pair(time, theEle));
+    totalTime += time;
+  }
+
+  if (eleTimes.empty()) {
+    s << "Domain::printElementCosts() - no element costs have been measured\n";
+    return 0;
+  }
+
+  std::vector<std::pair<double, int> > classTimes;
+  for (std::map<int, ClassCost>::iterator it = classCosts.begin(); it != classCosts.end(); it++)
+    classTimes.push_back(std::make_pair(it->second.cost.updateTime + it->second.cost.tangentTime, it->first));
+  std::sort(classTimes.rbegin(), classTimes.rend());
+
+  s << "Element costs by class (times in seconds)\n";
+  s << "class classTag elements updates updateTime tangents tangentTime iterations percent\n";
+  for (size_t i=0; i<classTimes.size(); i++) {
+    const ClassCost &theClass = classCosts[classTimes[i].second];
+    s << theClass.className << " " << classTimes[i].second << " " << theClass.numEle
+      << " " << OPS_Stream::toString(theClass.cost.numUpdates).c_str() << " " << theClass.cost.updateTime
+      << " " << OPS_Stream::toString(theClass.cost.numTangents).c_str() << " " << theClass.cost.tangentTime
+      << " " << OPS_Stream::toString(theClass.cost.numIterations).c_str()
+      << " " << (totalTime > 0.0 ? 100.0*classTimes[i].first/totalTime : 0.0) << "\n";
+  }
+
+  if (numTop > (int)eleTimes.size())
+    numTop = eleTimes.size();
+  if (numTop > 0) {
+    std::partial_sort(eleTimes.begin(), eleTimes.begin() + numTop, eleTimes.end(),
+		      [](const std::pair<double, Element *> &a, const std::pair<double, Element *> &b) {
+			return a.first > b.first;
+		      });
+
+    s << "The " << numTop << " most expensive elements\n";
+    s << "tag class updates updateTime tangents tangentTime iterations\n";
+    for (int i=0; i<numTop; i++) {
+      theEle = eleTimes[i].second;
+      const ElementCost *theCost = theEle->getMeasuredCost();
+      s << theEle->getTag() << " " << theEle->getClassType()
+	<< " " << OPS_Stream::toString(theCost->numUpdates).c_str() << " " << theCost->updateTime
+	<< " " << OPS_Stream::toString(theCost->numTangents).c_str() << " " << theCost->tangentTime
+	<< " " << OPS_Stream::toString(theCost->numIterations).c_str() << "\n";
+    }
+  }
+
+  return 0;
+}
+
+void
+Domain::resetElementCosts(void)
+{
+  Element *theEle;
+  ElementIter &theElements = this->getElements();
+  while ((theEle = theElements()) != 0)
+    theEle->resetCost();
+}
+
 
 int
 Domain::updateParameter(int tag, int value)
@@ -2452,6 +2889,8 @@ void
 Domain::domainChange(void)
 {
     hasDomainChangedFlag = true;
+    sweepArraysBuiltFlag = false;
+    nodalStateBuiltFlag = false;
 }
 
 
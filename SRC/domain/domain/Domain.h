@@ -38,6 +38,7 @@
 
 #include <OPS_Stream.h>
 #include <Vector.h>
+#include <vector>
 
 class Element;
 class Node;
@@ -52,6 +53,7 @@ class Parameter;
 
 class ElementIter;
 class NodeIter;
+class NodalStateStore;
 class SP_ConstraintIter;
 class MP_ConstraintIter;
 class Pressure_ConstraintIter;
@@ -79,6 +81,7 @@ class FEM_ObjectBroker;
 class TaggedObjectStorage;
 
 class DomainModalProperties;
+class Information;
 
 class Domain
 {
@@ -202,6 +205,24 @@ class Domain
     virtual  int  update(double newTime, double dT);
     virtual  int  updateParameter(int tag, int value);
     virtual  int  updateParameter(int tag, double value);    
+
+    // methods for the threaded commit, revert and update sweeps
+    virtual int setNumThreads(int numThreads);
+    virtual int getNumThreads(void) const;
+    virtual int getPhaseStat(const char *name, Information &theInfo);
+    virtual void resetPhaseStats(void);
+
+    // methods to report the measured cost of the elements, see
+    // Element::setMeasureCosts()
+    virtual int printElementCosts(OPS_Stream &s, int numTop = 10);
+    virtual void resetElementCosts(void);
+
+    // methods to hold the nodal response in contiguous arrays
+    virtual int setNodalStateStore(bool useStore);
+    virtual NodalStateStore *getNodalStateStore(void);
+
+    // method to change the container holding a type of component
+    virtual int setStorage(const char *componentType, TaggedObjectStorage *theStorage);
     
     virtual  int  analysisStep(double dT);
     virtual  int  eigenAnalysis(int numMode, bool generalized, bool findSmallest);
@@ -259,6 +280,14 @@ class Domain
     virtual int buildEleGraph(Graph *theEleGraph);
     virtual int buildNodeGraph(Graph *theNodeGraph);
 
+    enum {COMMIT_PHASE = 0, REVERT_PHASE = 1, UPDATE_PHASE = 2};
+    int sweepParallel(int phase);
+
+    // false in the threads that update subdomains concurrently, see
+    // ThreadedSubdomain, which leave ops_Dt and ops_TheActiveDomain as
+    // the main thread set them
+    static thread_local bool updatesGlobals;
+
     Recorder **theRecorders;
     int numRecorders;    
 
@@ -321,6 +350,22 @@ class Domain
     enum {paramSize_grow = 20};
     int paramSize;
     int numParameters;
+
+    // threaded sweeps: arrays of the components and of whether each
+    // element is thread safe, rebuilt after a domainChange(), and the
+    // accumulated wall time and count per phase
+    int numThreads;
+    bool sweepArraysBuiltFlag;
+    std::vector<Node *> theNodeArray;
+    std::vector<Element *> theEleArray;
+    std::vector<char> theEleThreadSafe;
+    double phaseTime[3];
+    int phaseCount[3];
+
+    // optional store of the nodal response, filled lazily after a
+    // domainChange()
+    NodalStateStore *theNodalStateStore;
+    bool nodalStateBuiltFlag;
 };
 
 #endif
@@ -56,6 +56,7 @@
 #include <SingleDomEleIter.h>
 #include <Vertex.h>
 #include <Graph.h>
+#include <VertexIter.h>
 #include <LoadPattern.h>
 #include <NodalLoad.h>
 #include <ElementalLoad.h>
@@ -86,7 +87,8 @@ typedef MAP_VERTEX::iterator     MAP_VERTEX_ITERATOR;
 PartitionedDomain::PartitionedDomain()
   : Domain(),
     theSubdomains(0), theDomainPartitioner(0),
-    theSubdomainIter(0), mySubdomainGraph(0), has_sent_yet(false)
+    theSubdomainIter(0), mySubdomainGraph(0), has_sent_yet(false),
+    balanceInterval(1), balanceImbalance(1.0), numCommitsSinceBalance(0)
 {
   elements = new MapOfTaggedObjects();//(1024);
   theSubdomains = new ArrayOfTaggedObjects(32);
@@ -109,7 +111,8 @@ PartitionedDomain::PartitionedDomain()
 PartitionedDomain::PartitionedDomain(DomainPartitioner &thePartitioner)
   : Domain(),
     theSubdomains(0), theDomainPartitioner(&thePartitioner),
-    theSubdomainIter(0), mySubdomainGraph(0), has_sent_yet(false)
+    theSubdomainIter(0), mySubdomainGraph(0), has_sent_yet(false),
+    balanceInterval(1), balanceImbalance(1.0), numCommitsSinceBalance(0)
 {
   elements = new MapOfTaggedObjects();//(1024);
   theSubdomains = new ArrayOfTaggedObjects(32);
@@ -137,7 +140,8 @@ PartitionedDomain::PartitionedDomain(int numNodes, int numElements,
 
   : Domain(numNodes, 0, numSPs, numMPs, numEQs, numLoadPatterns),
     theSubdomains(0), theDomainPartitioner(&thePartitioner),
-    theSubdomainIter(0), mySubdomainGraph(0), has_sent_yet(false)
+    theSubdomainIter(0), mySubdomainGraph(0), has_sent_yet(false),
+    balanceInterval(1), balanceImbalance(1.0), numCommitsSinceBalance(0)
 {
   elements = new MapOfTaggedObjects();//(numElements);
   theSubdomains = new ArrayOfTaggedObjects(numSubdomains);
@@ -1035,15 +1039,11 @@ PartitionedDomain::update(void)
     }
   }
 
-#ifdef _PARALLEL_PROCESSING
-// opserr << "PartitionedDomain:: barrierCheck\n";
+  // wait for the subdomains that update asynchronously
   return this->barrierCheck(res);
-#endif
-  return res;
 }
 
 
-#ifdef _PARALLEL_PROCESSING
 int
 PartitionedDomain::barrierCheck(int res)
 {
@@ -1069,7 +1069,6 @@ PartitionedDomain::barrierCheck(int res)
 
   return result;
 }
-#endif
 
 int
 PartitionedDomain::update(double newTime, double dT)
@@ -1088,10 +1087,7 @@ PartitionedDomain::update(double newTime, double dT)
     }
   }
 
-#ifdef _PARALLEL_PROCESSING
   return this->barrierCheck(res);
-#endif
-  return res;
 
   /*
 
@@ -1286,12 +1282,32 @@ PartitionedDomain::commit(void)
   // opserr << "Subdomain # MASTER " << " update_time = " << this->Domain::update_time_committed << endln;
 
 
-  // now we load balance if we have subdomains and a partitioner
+  // now we load balance if we have subdomains and a partitioner, every
+  // balanceInterval commits and only if the costs of the subdomains since
+  // the last check, the weights of the graph, are out of balance
   int numSubdomains = this->getNumSubdomains();
-  if (numSubdomains != 0 && theDomainPartitioner != 0)  {
-    // opserr << "Subdomain # MASTER " << " BALANCING! " << endln;
-    Graph &theSubGraphs = this->getSubdomainGraph();
-    theDomainPartitioner->balance(theSubGraphs);
+  if (numSubdomains != 0 && theDomainPartitioner != 0 && balanceInterval > 0)  {
+    numCommitsSinceBalance++;
+    if (numCommitsSinceBalance >= balanceInterval) {
+      numCommitsSinceBalance = 0;
+      Graph &theSubGraphs = this->getSubdomainGraph();
+
+      double maxCost = 0.0;
+      double sumCost = 0.0;
+      VertexIter &theVertices = theSubGraphs.getVertices();
+      Vertex *vertexPtr;
+      while ((vertexPtr = theVertices()) != 0) {
+	if (this->getSubdomainPtr(vertexPtr->getTag()) != 0) {
+	  double cost = vertexPtr->getWeight();
+	  sumCost += cost;
+	  if (cost > maxCost)
+	    maxCost = cost;
+	}
+      }
+
+      if (maxCost*numSubdomains > balanceImbalance*sumCost)
+	theDomainPartitioner->balance(theSubGraphs);
+    }
   }
 
   return 0;
@@ -1495,6 +1511,22 @@ PartitionedDomain::setPartitioner(DomainPartitioner *thePartitioner)
 }
 
 
+int
+PartitionedDomain::setLoadBalancing(int interval, double imbalance)
+{
+  if (interval < 0 || imbalance < 1.0) {
+    opserr << "PartitionedDomain::setLoadBalancing() - interval must be >= 0 and imbalance >= 1.0\n";
+    return -1;
+  }
+
+  balanceInterval = interval;
+  balanceImbalance = imbalance;
+  numCommitsSinceBalance = 0;
+
+  return 0;
+}
+
+
 int
 PartitionedDomain::partition(int numPartitions, bool usingMain, int mainPartitionID, int specialElementTag)
 {
@@ -1833,10 +1865,14 @@ PartitionedDomain::getSubdomainGraph(void)
   int subDTag = 1;
   double myCostP0 = 0.0;//this->getUpdateTime();
 
-  Vertex *selfvertexPtr = new Vertex(subDTag, subDTag, myCostP0);
-  mySubdomainGraph->addVertex(selfvertexPtr);
+  // P0 is not added if a subdomain has its tag, the subdomain's cost
+  // would otherwise be lost
+  if (this->getSubdomainPtr(subDTag) == 0) {
+    Vertex *selfvertexPtr = new Vertex(subDTag, subDTag, myCostP0);
+    mySubdomainGraph->addVertex(selfvertexPtr);
   
-  subDTagToVtxTag.insert(MAP_INT_TYPE(subDTag, subDTag));
+    subDTagToVtxTag.insert(MAP_INT_TYPE(subDTag, subDTag));
+  }
 
   while ((subDPtr = theSubdomains()) != 0) {    
     int subDTag = subDPtr->getTag();
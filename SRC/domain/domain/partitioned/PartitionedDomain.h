@@ -131,6 +131,11 @@ class PartitionedDomain: public Domain
 
     // public member functions in addition to the standard domain
     virtual int setPartitioner(DomainPartitioner *thePartitioner);
+
+    // the partitioner balances the subdomains every interval commits if
+    // the most costly is more than imbalance times the average cost, an
+    // interval of 0 turns the balancing off
+    virtual int setLoadBalancing(int interval, double imbalance = 1.0);
     virtual int partition(int numPartitions, bool usingMain = false, int mainPartitionID = 0, int specialElementTag = 0);
     virtual int repartition(int numPartitions, bool usingMain = false, int mainPartitionID = 0, int specialElementTag = 0);
 			
@@ -175,6 +180,10 @@ class PartitionedDomain: public Domain
     Graph *mySubdomainGraph;    // a graph of subdomain connectivity
 
     bool has_sent_yet;
+
+    int balanceInterval;
+    double balanceImbalance;
+    int numCommitsSinceBalance;
 };
 
 #endif
@@ -30,7 +30,7 @@
 #include <Information.h>
 #include <Parameter.h>
 
-Vector Beam2dPartialUniformLoad::data(6);
+thread_local Vector Beam2dPartialUniformLoad::data(6);
 
 Beam2dPartialUniformLoad::Beam2dPartialUniformLoad(int tag, double wt, double wa,
 						   int theElementTag)
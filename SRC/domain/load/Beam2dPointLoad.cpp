@@ -33,7 +33,7 @@
 #include <Information.h>
 #include <Parameter.h>
 
-Vector Beam2dPointLoad::data(3);
+thread_local Vector Beam2dPointLoad::data(3);
 
 Beam2dPointLoad::Beam2dPointLoad(int tag, double Pt, double dist,
 				 int theElementTag, double Pa)
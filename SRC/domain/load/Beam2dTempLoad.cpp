@@ -30,7 +30,7 @@
 #include <Beam2dTempLoad.h>
 #include <Vector.h>
 
-Vector Beam2dTempLoad::data(4);
+thread_local Vector Beam2dTempLoad::data(4);
 
 Beam2dTempLoad::Beam2dTempLoad(int tag, 
 			       double temp1, double temp2, 
@@ -39,7 +39,7 @@
 #include <Beam2dThermalAction.h>
 #include <Vector.h>
 #include <Element.h>
-Vector Beam2dThermalAction::data(18);
+thread_local Vector Beam2dThermalAction::data(18);
 
 Beam2dThermalAction::Beam2dThermalAction(int tag, 
 					 double t1, double locY1, double t2, double locY2,
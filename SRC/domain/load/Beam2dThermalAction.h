@@ -85,7 +85,7 @@ class Beam2dThermalAction : public ElementalLoad
   double Temp[9]; //Initial Temperature 
   double TempApp[9]; // Temperature applied
   double Loc[9]; // Location through the depth of section
-  static Vector data; // data for temperature and locations
+  static thread_local Vector data; // data for temperature and locations
 
   int ThermalActionType;
 
@@ -34,7 +34,7 @@
 #include <Information.h>
 #include <Parameter.h>
 
-Vector Beam2dUniformLoad::data(2);
+thread_local Vector Beam2dUniformLoad::data(2);
 
 Beam2dUniformLoad::Beam2dUniformLoad(int tag, double wt, double wa,
 				     int theElementTag)
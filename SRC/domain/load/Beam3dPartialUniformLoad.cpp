@@ -30,7 +30,7 @@
 #include <Information.h>
 #include <Parameter.h>
 
-Vector Beam3dPartialUniformLoad::data(8);
+thread_local Vector Beam3dPartialUniformLoad::data(8);
 
 Beam3dPartialUniformLoad::Beam3dPartialUniformLoad(int tag, double wya, double wza, double waa,
 						   double aL, double bL, double wyb, double wzb, double wab, int theElementTag)
@@ -61,7 +61,7 @@ class Beam3dPartialUniformLoad : public ElementalLoad
   double wTransyb;
   double wTranszb;
   double wAxialb;
-  static Vector data;
+  static thread_local Vector data;
   
   int parameterID;
 };
@@ -31,7 +31,7 @@
 #include <Channel.h>
 #include <FEM_ObjectBroker.h>
 
-Vector Beam3dPointLoad::data(4);
+thread_local Vector Beam3dPointLoad::data(4);
 
 Beam3dPointLoad::Beam3dPointLoad(int tag, double py, double pz, double dist,
 				 int theElementTag, double px)
@@ -39,7 +39,7 @@
 #include <Beam3dThermalAction.h>
 #include <Vector.h>
 #include <Element.h>
-Vector Beam3dThermalAction::data(35);
+thread_local Vector Beam3dThermalAction::data(35);
 
 // It allows for linear interpolation in a 5x5 grid (5 locs in Z and Y)
 Beam3dThermalAction::Beam3dThermalAction(int tag,
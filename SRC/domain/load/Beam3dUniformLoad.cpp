@@ -32,7 +32,7 @@
 #include <Channel.h>
 #include <FEM_ObjectBroker.h>
 
-Vector Beam3dUniformLoad::data(3);
+thread_local Vector Beam3dUniformLoad::data(3);
 
 Beam3dUniformLoad::Beam3dUniformLoad(int tag, double wY, double wZ, double wX,
 				     int theElementTag)
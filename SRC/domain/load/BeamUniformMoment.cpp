@@ -32,7 +32,7 @@
 #include <Channel.h>
 #include <FEM_ObjectBroker.h>
 
-Vector BeamUniformMoment::data(3);
+thread_local Vector BeamUniformMoment::data(3);
 
 BeamUniformMoment::BeamUniformMoment(int tag, double x, double y, double z,
 				     int theElementTag)
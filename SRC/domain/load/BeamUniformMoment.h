@@ -51,7 +51,7 @@ class BeamUniformMoment : public ElementalLoad
     double mx;  // Twist
     double my;  // About y
     double mz;  // About z
-    static Vector data;
+    static thread_local Vector data;
 };
 
 #endif
@@ -0,0 +1,267 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the class implementation for
+// NodalStateStore.
+
+#include <NodalStateStore.h>
+#include <Node.h>
+#include <NodeIter.h>
+#include <Vector.h>
+#include <Versor.h>
+#include <classTags.h>
+
+int NodalStateStore::lastStamp = 0;
+
+NodalStateStore::NodalStateStore()
+  :numDOF(0), stamp(0), disp(0), vel(0), accel(0),
+   theStoredNodes(), theOtherNodes()
+{
+
+}
+
+
+NodalStateStore::~NodalStateStore()
+{
+  this->clear();
+}
+
+
+// int setNodes(NodeIter &theNodes);
+// Gives every Node of the iter a slot in newly allocated arrays and moves
+// its response there. Only Nodes of the base class with at least one dof
+// are stored, the commit and revert sweeps invoke the methods of the
+// others.
+
+int
+NodalStateStore::setNodes(NodeIter &theNodes)
+{
+  this->clear();
+
+  Node *theNode;
+  while ((theNode = theNodes()) != 0) {
+    if (theNode->getClassTag() == NOD_TAG_Node && theNode->getNumberDOF() > 0) {
+      theStoredNodes.push_back(theNode);
+      numDOF += theNode->getNumberDOF();
+    } else
+      theOtherNodes.push_back(theNode);
+  }
+
+  if (numDOF != 0) {
+    disp = new double[4*numDOF];
+    vel = new double[2*numDOF];
+    accel = new double[2*numDOF];
+  }
+
+  int slot = 0;
+  for (Node *theStoredNode : theStoredNodes) {
+    theStoredNode->setStateStorage(&disp[slot], &vel[slot], &accel[slot], numDOF);
+    slot += theStoredNode->getNumberDOF();
+  }
+
+  stamp = ++lastStamp;
+
+  return 0;
+}
+
+
+// void clear(void);
+// Moves the response of the stored Nodes back into arrays they own and
+// releases the arrays of the store.
+
+void
+NodalStateStore::clear(void)
+{
+  for (Node *theNode : theStoredNodes)
+    theNode->setStateStorage(0, 0, 0, 0);
+
+  theStoredNodes.clear();
+  theOtherNodes.clear();
+
+  if (disp != 0)
+    delete [] disp;
+  if (vel != 0)
+    delete [] vel;
+  if (accel != 0)
+    delete [] accel;
+
+  disp = vel = accel = 0;
+  numDOF = 0;
+  stamp = 0;
+}
+
+
+int
+NodalStateStore::getNumDOF(void) const
+{
+  return numDOF;
+}
+
+
+// int getStamp(void) const;
+// Returns a number that changes whenever the slots are reassigned, 0 if
+// the store is empty.
+
+int
+NodalStateStore::getStamp(void) const
+{
+  return stamp;
+}
+
+
+// int getSlot(const Node *theNode) const;
+// Returns the offset of the response of theNode in the blocks, -1 if the
+// Node is not stored.
+
+int
+NodalStateStore::getSlot(const Node *theNode) const
+{
+  if (theNode == 0 || theNode->sharedState == false)
+    return -1;
+
+  if (theNode->disp < disp || theNode->disp >= disp + numDOF)
+    return -1;
+
+  return theNode->disp - disp;
+}
+
+
+int
+NodalStateStore::commitState(int numThreads)
+{
+  double *trialDisp = disp;
+  double *commitDisp = disp + numDOF;
+  double *incrDisp = disp + 2*numDOF;
+  double *incrDeltaDisp = disp + 3*numDOF;
+  double *trialVel = vel;
+  double *commitVel = vel + numDOF;
+  double *trialAccel = accel;
+  double *commitAccel = accel + numDOF;
+  int n = numDOF;
+
+#pragma omp parallel for num_threads(numThreads) schedule(static) if(n > 2000)
+  for (int i=0; i<n; i++) {
+    commitDisp[i] = trialDisp[i];
+    incrDisp[i] = 0.0;
+    incrDeltaDisp[i] = 0.0;
+    commitVel[i] = trialVel[i];
+    commitAccel[i] = trialAccel[i];
+  }
+
+  for (Node *theNode : theStoredNodes)
+    if (theNode->rotation != nullptr)
+      theNode->rotation[0] = theNode->rotation[1];
+
+  int res = 0;
+  for (Node *theNode : theOtherNodes)
+    if (theNode->commitState() != 0)
+      res = -1;
+
+  return res;
+}
+
+
+int
+NodalStateStore::revertToLastCommit(int numThreads)
+{
+  double *trialDisp = disp;
+  double *commitDisp = disp + numDOF;
+  double *incrDisp = disp + 2*numDOF;
+  double *incrDeltaDisp = disp + 3*numDOF;
+  double *trialVel = vel;
+  double *commitVel = vel + numDOF;
+  double *trialAccel = accel;
+  double *commitAccel = accel + numDOF;
+  int n = numDOF;
+
+#pragma omp parallel for num_threads(numThreads) schedule(static) if(n > 2000)
+  for (int i=0; i<n; i++) {
+    trialDisp[i] = commitDisp[i];
+    incrDisp[i] = 0.0;
+    incrDeltaDisp[i] = 0.0;
+    trialVel[i] = commitVel[i];
+    trialAccel[i] = commitAccel[i];
+  }
+
+  for (Node *theNode : theStoredNodes)
+    if (theNode->rotation != nullptr)
+      theNode->rotation[1] = theNode->rotation[0];
+
+  int res = 0;
+  for (Node *theNode : theOtherNodes)
+    if (theNode->revertToLastCommit() != 0)
+      res = -1;
+
+  return res;
+}
+
+
+// int setResponse(const int *eqns, const Vector *disp, const Vector *vel,
+//                 const Vector *accel, int numThreads);
+// Gathers the trial response of every slot from the given Vectors, any of
+// which may be 0. As in Node::setTrialDisp() the incremental displacement
+// is taken from the committed and the incremental-delta from the previous
+// trial displacement, so a dof with no equation keeps its trial value but
+// has its increments updated.
+
+int
+NodalStateStore::setResponse(const int *eqns, const Vector *U,
+			     const Vector *Udot, const Vector *Udotdot,
+			     int numThreads)
+{
+  int n = numDOF;
+
+  if (U != 0) {
+    double *trialDisp = disp;
+    double *commitDisp = disp + numDOF;
+    double *incrDisp = disp + 2*numDOF;
+    double *incrDeltaDisp = disp + 3*numDOF;
+    const Vector &u = *U;
+
+#pragma omp parallel for num_threads(numThreads) schedule(static) if(n > 2000)
+    for (int i=0; i<n; i++) {
+      int eqn = eqns[i];
+      if (eqn == -2)
+	continue;
+      double tDisp = (eqn >= 0) ? u(eqn) : trialDisp[i];
+      incrDisp[i] = tDisp - commitDisp[i];
+      incrDeltaDisp[i] = tDisp - trialDisp[i];
+      trialDisp[i] = tDisp;
+    }
+  }
+
+  if (Udot != 0) {
+    const Vector &udot = *Udot;
+#pragma omp parallel for num_threads(numThreads) schedule(static) if(n > 2000)
+    for (int i=0; i<n; i++)
+      if (eqns[i] >= 0)
+	vel[i] = udot(eqns[i]);
+  }
+
+  if (Udotdot != 0) {
+    const Vector &udotdot = *Udotdot;
+#pragma omp parallel for num_threads(numThreads) schedule(static) if(n > 2000)
+    for (int i=0; i<n; i++)
+      if (eqns[i] >= 0)
+	accel[i] = udotdot(eqns[i]);
+  }
+
+  return 0;
+}
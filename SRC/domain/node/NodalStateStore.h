@@ -0,0 +1,81 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef NodalStateStore_h
+#define NodalStateStore_h
+
+// Description: This file contains the class definition for NodalStateStore.
+// A NodalStateStore holds the response of the Nodes of a Domain in a few
+// contiguous arrays, one per quantity, instead of in arrays allocated by
+// every Node. With N the total number of dof of the stored Nodes, the
+// displacement array holds the trial, committed, incremental and
+// incremental-delta displacements of all Nodes in four blocks of length
+// N, the velocity and acceleration arrays hold the trial and committed
+// values in two. Each Node is given a slot, an offset into the blocks,
+// and views its part of the arrays through the usual Vector interface.
+// Committing, reverting and setting the response from the solution of
+// the system of equations then become linear sweeps over the blocks.
+
+#include <vector>
+
+class Node;
+class NodeIter;
+class Vector;
+
+class NodalStateStore
+{
+  public:
+    NodalStateStore();
+    ~NodalStateStore();
+
+    int setNodes(NodeIter &theNodes);
+    void clear(void);
+
+    int getNumDOF(void) const;
+    int getStamp(void) const;
+    int getSlot(const Node *theNode) const;
+
+    // sweeps over all the Nodes of the Domain
+    int commitState(int numThreads = 1);
+    int revertToLastCommit(int numThreads = 1);
+
+    // sets the trial response from the solution of the system of
+    // equations, eqns holds for each slot an equation number, -1 for a
+    // dof with no equation, or -2 for a dof left untouched
+    int setResponse(const int *eqns, const Vector *disp, const Vector *vel,
+		    const Vector *accel, int numThreads = 1);
+
+  protected:
+
+  private:
+    int numDOF;
+    int stamp;
+
+    double *disp;   // [trial | commit | incr | incrDelta]
+    double *vel;    // [trial | commit]
+    double *accel;  // [trial | commit]
+
+    std::vector<Node *> theStoredNodes;
+    std::vector<Node *> theOtherNodes;  // e.g. DummyNodes, Nodes with no dof
+
+    static int lastStamp;
+};
+
+#endif
@@ -59,9 +59,35 @@
 
 #include <OPS_Globals.h>
 #include <elementAPI.h>
-
-Matrix **Node::theMatrices = 0;
-int Node::numMatrices = 0;
+#include <vector>
+
+// the matrix returned by getMass() and getDamp() when a node has no
+// mass or damping; one per size and thread so that nodes can be used
+// concurrently during a parallel assembly
+namespace {
+  class NodeWorkArea {
+  public:
+    ~NodeWorkArea() {
+      for (size_t i=0; i<theMatrices.size(); i++)
+	if (theMatrices[i] != 0)
+	  delete theMatrices[i];
+    }
+    std::vector<Matrix *> theMatrices; // indexed by the number of dof
+  };
+
+  thread_local NodeWorkArea theWorkArea;
+
+  Matrix &
+  getWorkMatrix(int numDOF)
+  {
+    std::vector<Matrix *> &theMatrices = theWorkArea.theMatrices;
+    if ((int)theMatrices.size() <= numDOF)
+      theMatrices.resize(numDOF+1, (Matrix *)0);
+    if (theMatrices[numDOF] == 0)
+      theMatrices[numDOF] = new Matrix(numDOF, numDOF);
+    return *theMatrices[numDOF];
+  }
+}
 
 int OPS_Node()
 {
@@ -227,10 +253,10 @@ Node::Node(int theClassTag)
  Crd(0), commitDisp(0), commitVel(0), commitAccel(0), 
  trialDisp(0), trialVel(0), trialAccel(0), unbalLoad(0), incrDisp(0), 
  incrDeltaDisp(0),
- disp(0), vel(0), accel(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
+ disp(0), vel(0), accel(0), stateStride(0), sharedState(false), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
  rotation(nullptr),
  R(0), mass(0), unbalLoadWithInertia(0), alphaM(0.0), theEigenvectors(0), 
- index(-1), reaction(0), displayLocation(0), temperature(0)
+ reaction(0), displayLocation(0), temperature(0)
 {
   // for FEM_ObjectBroker, recvSelf() must be invoked on object
 
@@ -251,10 +277,10 @@ Node::Node(int tag, int theClassTag)
  Crd(0), commitDisp(0), commitVel(0), commitAccel(0), 
  trialDisp(0), trialVel(0), trialAccel(0), unbalLoad(0), incrDisp(0),
  incrDeltaDisp(0), 
- disp(0), vel(0), accel(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
+ disp(0), vel(0), accel(0), stateStride(0), sharedState(false), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
  rotation(nullptr),
   R(0), mass(0), unbalLoadWithInertia(0), alphaM(0.0), theEigenvectors(0), 
- index(-1), reaction(0), displayLocation(0), temperature(0)
+ reaction(0), displayLocation(0), temperature(0)
 {
   // for subclasses - they must implement all the methods with
   // their own data structures.
@@ -275,10 +301,10 @@ Node::Node(int tag, int ndof, double Crd1, Vector *dLoc)
  Crd(0), commitDisp(0), commitVel(0), commitAccel(0), 
  trialDisp(0), trialVel(0), trialAccel(0), unbalLoad(0), incrDisp(0),
  incrDeltaDisp(0), 
- disp(0), vel(0), accel(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
+ disp(0), vel(0), accel(0), stateStride(0), sharedState(false), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
  rotation(nullptr),
  R(0), mass(0), unbalLoadWithInertia(0), alphaM(0.0), theEigenvectors(0), 
- index(-1), reaction(0), displayLocation(0), temperature(0)
+ reaction(0), displayLocation(0), temperature(0)
 {
   // AddingSensitivity:BEGIN /////////////////////////////////////////
   dispSensitivity = 0;
@@ -295,8 +321,6 @@ Node::Node(int tag, int ndof, double Crd1, Vector *dLoc)
   if (dLoc != 0) {
     displayLocation = new Vector(*dLoc);
   }
-  
-  index = -1;
 }
 
 
@@ -308,7 +332,7 @@ Node::Node(int tag, int ndof, double Crd1, double Crd2, Vector *dLoc)
  Crd(0), commitDisp(0), commitVel(0), commitAccel(0), 
  trialDisp(0), trialVel(0), trialAccel(0), unbalLoad(0), incrDisp(0),
  incrDeltaDisp(0), 
- disp(0), vel(0), accel(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
+ disp(0), vel(0), accel(0), stateStride(0), sharedState(false), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
  rotation(nullptr),
  R(0), mass(0), unbalLoadWithInertia(0), alphaM(0.0), theEigenvectors(0),
  reaction(0), displayLocation(0), temperature(0)
@@ -329,8 +353,6 @@ Node::Node(int tag, int ndof, double Crd1, double Crd2, Vector *dLoc)
   if (dLoc != 0) {
     displayLocation = new Vector(*dLoc);
   }
-  
-  index = -1;
 }
 
 
@@ -343,7 +365,7 @@ Node::Node(int tag, int ndof, double Crd1, double Crd2, Vector *dLoc)
  Crd(0), commitDisp(0), commitVel(0), commitAccel(0), 
  trialDisp(0), trialVel(0), trialAccel(0), unbalLoad(0), incrDisp(0),
  incrDeltaDisp(0), 
- disp(0), vel(0), accel(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
+ disp(0), vel(0), accel(0), stateStride(0), sharedState(false), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
  rotation(nullptr),
  R(0), mass(0), unbalLoadWithInertia(0), alphaM(0.0), theEigenvectors(0),
  reaction(0), displayLocation(0), temperature(0)
@@ -365,8 +387,6 @@ Node::Node(int tag, int ndof, double Crd1, double Crd2, Vector *dLoc)
   if (dLoc != 0) {
     displayLocation = new Vector(*dLoc);
   }
-  
-  index = -1;
 }
 
 
@@ -379,7 +399,7 @@ Node::Node(const Node &otherNode, bool copyMass)
  Crd(0), commitDisp(0), commitVel(0), commitAccel(0), 
  trialDisp(0), trialVel(0), trialAccel(0), unbalLoad(0), incrDisp(0),
  incrDeltaDisp(0), 
- disp(0), vel(0), accel(0), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
+ disp(0), vel(0), accel(0), stateStride(0), sharedState(false), dbTag1(0), dbTag2(0), dbTag3(0), dbTag4(0),
  rotation(nullptr),
  R(0), mass(0), unbalLoadWithInertia(0), alphaM(0.0), theEigenvectors(0),
    reaction(0), displayLocation(0), temperature(0)
@@ -408,8 +428,9 @@ Node::Node(const Node &otherNode, bool copyMass)
       opserr << " FATAL Node::Node(node *) - ran out of memory for displacement\n";
       exit(-1);
     }
-    for (int i=0; i<4*numberDOF; i++)
-      disp[i] = otherNode.disp[i];
+    for (int k=0; k<4; k++)
+      for (int i=0; i<numberDOF; i++)
+	disp[k*stateStride+i] = otherNode.disp[k*otherNode.stateStride+i];
   }    
   
   if (otherNode.commitVel != 0) {
@@ -417,8 +438,9 @@ Node::Node(const Node &otherNode, bool copyMass)
       opserr << " FATAL Node::Node(node *) - ran out of memory for velocity\n";
       exit(-1);
     }
-    for (int i=0; i<2*numberDOF; i++)
-      vel[i] = otherNode.vel[i];
+    for (int k=0; k<2; k++)
+      for (int i=0; i<numberDOF; i++)
+	vel[k*stateStride+i] = otherNode.vel[k*otherNode.stateStride+i];
   }    
   
   if (otherNode.commitAccel != 0) {
@@ -426,8 +448,9 @@ Node::Node(const Node &otherNode, bool copyMass)
       opserr << " FATAL Node::Node(node *) - ran out of memory for acceleration\n";
       exit(-1);
     }
-    for (int i=0; i<2*numberDOF; i++)
-      accel[i] = otherNode.accel[i];
+    for (int k=0; k<2; k++)
+      for (int i=0; i<numberDOF; i++)
+	accel[k*stateStride+i] = otherNode.accel[k*otherNode.stateStride+i];
   }    
   
   
@@ -457,8 +480,6 @@ Node::Node(const Node &otherNode, bool copyMass)
   }
 
   temperature = otherNode.temperature;
-
-  index = -1;
 }
 
 
@@ -502,14 +523,17 @@ Node::~Node()
     if (unbalLoad != 0)
 	delete unbalLoad;
     
-    if (disp != 0)
+    // arrays held by a NodalStateStore belong to the store
+    if (sharedState == false) {
+      if (disp != 0)
 	delete [] disp;
 
-    if (vel != 0)
+      if (vel != 0)
 	delete [] vel;
 
-    if (accel != 0)
+      if (accel != 0)
 	delete [] accel;
+    }
 
     if (mass != 0)
 	delete mass;
@@ -739,8 +763,8 @@ Node::setTrialDisp(double value, int dof)
     // perform the assignment .. we don't go through Vector interface
     // as we are sure of size and this way is quicker
     double tDisp = value;
-    disp[dof+2*numberDOF] = tDisp - disp[dof+numberDOF];
-    disp[dof+3*numberDOF] = tDisp - disp[dof];	
+    disp[dof+2*stateStride] = tDisp - disp[dof+stateStride];
+    disp[dof+3*stateStride] = tDisp - disp[dof];	
     disp[dof] = tDisp;
 
     return 0;
@@ -770,8 +794,8 @@ Node::setTrialDisp(const Vector &newTrialDisp)
     // as we are sure of size and this way is quicker
     for (int i=0; i<numberDOF; i++) {
         double tDisp = newTrialDisp(i);
-	disp[i+2*numberDOF] = tDisp - disp[i+numberDOF];
-	disp[i+3*numberDOF] = tDisp - disp[i];	
+	disp[i+2*stateStride] = tDisp - disp[i+stateStride];
+	disp[i+3*stateStride] = tDisp - disp[i];	
 	disp[i] = tDisp;
     }
 
@@ -838,7 +862,7 @@ Node::incrTrialDisp(const Vector &incrDispl)
     }    
 
     if (rotation != nullptr && this->getNumberDOF() >= 6)
-      rotation[1] = rotation[1]*Versor::from_vector(&disp[3*numberDOF+3]);
+      rotation[1] = rotation[1]*Versor::from_vector(&disp[3*stateStride+3]);
 
 
     // create a copy if no trial exists and add committed
@@ -850,8 +874,8 @@ Node::incrTrialDisp(const Vector &incrDispl)
 	for (int i = 0; i<numberDOF; i++) {
 	  double incrDispI = incrDispl(i);
 	  disp[i] = incrDispI;
-	  disp[i+2*numberDOF] = incrDispI;
-	  disp[i+3*numberDOF] = incrDispI;
+	  disp[i+2*stateStride] = incrDispI;
+	  disp[i+3*stateStride] = incrDispI;
 	}
 	return 0;
     }
@@ -860,8 +884,8 @@ Node::incrTrialDisp(const Vector &incrDispl)
     for (int i = 0; i<numberDOF; i++) {
 	  double incrDispI = incrDispl(i);
 	  disp[i] += incrDispI;
-	  disp[i+2*numberDOF] += incrDispI;
-	  disp[i+3*numberDOF] = incrDispI;
+	  disp[i+2*stateStride] += incrDispI;
+	  disp[i+3*stateStride] = incrDispI;
     }
 
     return 0;
@@ -1095,22 +1119,22 @@ Node::commitState()
     // check disp exists, if does set commit = trial, incr = 0.0
     if (trialDisp != 0) {
       for (int i=0; i<numberDOF; i++) {
-	disp[i+numberDOF] = disp[i];  
-        disp[i+2*numberDOF] = 0.0;
-        disp[i+3*numberDOF] = 0.0;
+	disp[i+stateStride] = disp[i];  
+        disp[i+2*stateStride] = 0.0;
+        disp[i+3*stateStride] = 0.0;
       }
     }		    
     
     // check vel exists, if does set commit = trial    
     if (trialVel != 0) {
       for (int i=0; i<numberDOF; i++)
-	vel[i+numberDOF] = vel[i];
+	vel[i+stateStride] = vel[i];
     }
     
     // check accel exists, if does set commit = trial        
     if (trialAccel != 0) {
       for (int i=0; i<numberDOF; i++)
-	accel[i+numberDOF] = accel[i];
+	accel[i+stateStride] = accel[i];
     }
 
     if (rotation != nullptr)
@@ -1127,22 +1151,22 @@ Node::revertToLastCommit()
     // check disp exists, if does set trial = last commit, incr = 0
     if (disp != 0) {
       for (int i=0 ; i<numberDOF; i++) {
-	disp[i] = disp[i+numberDOF];
-	disp[i+2*numberDOF] = 0.0;
-	disp[i+3*numberDOF] = 0.0;
+	disp[i] = disp[i+stateStride];
+	disp[i+2*stateStride] = 0.0;
+	disp[i+3*stateStride] = 0.0;
       }
     }
     
     // check vel exists, if does set trial = last commit
     if (vel != 0) {
       for (int i=0 ; i<numberDOF; i++)
-	vel[i] = vel[numberDOF+i];
+	vel[i] = vel[stateStride+i];
     }
 
     // check accel exists, if does set trial = last commit
     if (accel != 0) {    
       for (int i=0 ; i<numberDOF; i++)
-	accel[i] = accel[numberDOF+i];
+	accel[i] = accel[stateStride+i];
     }
 
     if (rotation != nullptr)
@@ -1157,20 +1181,23 @@ Node::revertToStart()
 {
     // check disp exists, if does set all to zero
     if (disp != 0) {
-      for (int i=0 ; i<4*numberDOF; i++)
-	disp[i] = 0.0;
+      for (int k=0 ; k<4; k++)
+	for (int i=0 ; i<numberDOF; i++)
+	  disp[k*stateStride+i] = 0.0;
     }
 
     // check vel exists, if does set all to zero
     if (vel != 0) {
-      for (int i=0 ; i<2*numberDOF; i++)
-	vel[i] = 0.0;
+      for (int k=0 ; k<2; k++)
+	for (int i=0 ; i<numberDOF; i++)
+	  vel[k*stateStride+i] = 0.0;
     }
 
     // check accel exists, if does set all to zero
     if (accel != 0) {    
-      for (int i=0 ; i<2*numberDOF; i++)
-	accel[i] = 0.0;
+      for (int k=0 ; k<2; k++)
+	for (int i=0 ; i<numberDOF; i++)
+	  accel[k*stateStride+i] = 0.0;
     }
     
     if (unbalLoad != 0) 
@@ -1204,14 +1231,11 @@ Node::revertToStart()
 const Matrix &
 Node::getMass(void) 
 {
-    if (index == -1) {
-	setGlobalMatrices();
-    }
-    
     // make sure it was created before we return it
     if (mass == 0) {
-      theMatrices[index]->Zero();
-      return *theMatrices[index];
+      Matrix &result = getWorkMatrix(numberDOF);
+      result.Zero();
+      return result;
     } else 
       return *mass;
 }
@@ -1227,16 +1251,13 @@ Node::setRayleighDampingFactor(double alpham) {
 const Matrix &
 Node::getDamp(void) 
 {
-    if (index == -1) {
-	setGlobalMatrices();
-    }
-    
     // make sure it was created before we return it
     if (mass == 0 || alphaM == 0.0) {
-      theMatrices[index]->Zero();
-      return *theMatrices[index];
+      Matrix &result = getWorkMatrix(numberDOF);
+      result.Zero();
+      return result;
     } else {
-      Matrix &result = *theMatrices[index];
+      Matrix &result = getWorkMatrix(numberDOF);
       result = *mass;
       result *= alphaM;
       return result;
@@ -1247,16 +1268,13 @@ Node::getDamp(void)
 const Matrix &
 Node::getDampSensitivity(void) 
 {
-    if (index == -1) {
-	setGlobalMatrices();
-    }
-    
     // make sure it was created before we return it
     if (mass == 0 || alphaM == 0.0) {
-      theMatrices[index]->Zero();
-      return *theMatrices[index];
+      Matrix &result = getWorkMatrix(numberDOF);
+      result.Zero();
+      return result;
     } else {
-      Matrix &result = *theMatrices[index];
+      Matrix &result = getWorkMatrix(numberDOF);
 	  result.Zero();
       //result = *mass;
       //result *= alphaM;
@@ -1603,7 +1621,7 @@ Node::recvSelf(int cTag, Channel &theChannel,
 
       // set the trial quantities equal to committed
       for (int i=0; i<numberDOF; i++)
-	disp[i] = disp[i+numberDOF];  // set trial equal committed
+	disp[i] = disp[i+stateStride];  // set trial equal committed
 
     } else if (commitDisp != 0) {
       // if going back to initial we will just zero the vectors
@@ -1625,7 +1643,7 @@ Node::recvSelf(int cTag, Channel &theChannel,
 
       // set the trial quantity
       for (int i=0; i<numberDOF; i++)
-	vel[i] = vel[i+numberDOF];  // set trial equal committed
+	vel[i] = vel[i+stateStride];  // set trial equal committed
     }
 
     if (data(4) == 0) {
@@ -1641,7 +1659,7 @@ Node::recvSelf(int cTag, Channel &theChannel,
       
       // set the trial values
       for (int i=0; i<numberDOF; i++)
-	accel[i] = accel[i+numberDOF];  // set trial equal committed
+	accel[i] = accel[i+stateStride];  // set trial equal committed
     }
 
     if (data(5) == 0) {
@@ -1692,36 +1710,6 @@ Node::recvSelf(int cTag, Channel &theChannel,
       }
     }        
 
-
-  index = -1;
-  if (numMatrices != 0) {
-    for (int i=0; i<numMatrices; i++)
-      if (theMatrices[i]->noRows() == numberDOF) {
-	index = i;
-	i = numMatrices;
-      }
-  }
-  if (index == -1) {
-    Matrix **nextMatrices = new Matrix *[numMatrices+1];
-    if (nextMatrices == 0) {
-      opserr << "Element::getTheMatrix - out of memory\n";
-      exit(-1);
-    }
-    for (int j=0; j<numMatrices; j++)
-      nextMatrices[j] = theMatrices[j];
-    Matrix *theMatrix = new Matrix(numberDOF, numberDOF);
-    if (theMatrix == 0) {
-      opserr << "Element::getTheMatrix - out of memory\n";
-      exit(-1);
-    }
-    nextMatrices[numMatrices] = theMatrix;
-    if (numMatrices != 0) 
-      delete [] theMatrices;
-    index = numMatrices;
-    numMatrices++;
-    theMatrices = nextMatrices;
-  }
-
   return 0;
 }
 
@@ -1807,6 +1795,90 @@ Node::displaySelf(Renderer &theRenderer, int theEleMode, int theNodeMode, float
 }
 
 
+// int setStateStorage(double *dispData, double *velData,
+//                     double *accelData, int stride);
+// Moves the response of the node into arrays owned by a NodalStateStore.
+// The trial, committed, incremental and incremental-delta displacements
+// start at dispData, dispData+stride, dispData+2*stride and
+// dispData+3*stride; the trial and committed velocities and accelerations
+// are laid out the same way. The current response is copied across. If
+// null pointers are passed the response is moved back into arrays owned
+// by the node.
+
+int
+Node::setStateStorage(double *dispData, double *velData, double *accelData,
+		      int stride)
+{
+  bool toStore = (dispData != 0 && velData != 0 && accelData != 0);
+
+  if (toStore == false) {
+    if (sharedState == false)
+      return 0;
+
+    stride = numberDOF;
+    dispData = new double[4*numberDOF];
+    velData = new double[2*numberDOF];
+    accelData = new double[2*numberDOF];
+  }
+
+  // copy the response across, zero for quantities not yet formed
+  for (int i=0; i<numberDOF; i++) {
+    for (int k=0; k<4; k++)
+      dispData[k*stride+i] = (disp != 0) ? disp[k*stateStride+i] : 0.0;
+    for (int k=0; k<2; k++) {
+      velData[k*stride+i] = (vel != 0) ? vel[k*stateStride+i] : 0.0;
+      accelData[k*stride+i] = (accel != 0) ? accel[k*stateStride+i] : 0.0;
+    }
+  }
+
+  if (sharedState == false) {
+    if (disp != 0)
+      delete [] disp;
+    if (vel != 0)
+      delete [] vel;
+    if (accel != 0)
+      delete [] accel;
+  }
+
+  disp = dispData;
+  vel = velData;
+  accel = accelData;
+  stateStride = stride;
+  sharedState = toStore;
+
+  // point the Vectors at the new arrays
+  if (trialDisp == 0) {
+    trialDisp = new Vector(disp, numberDOF);
+    commitDisp = new Vector(&disp[stride], numberDOF);
+    incrDisp = new Vector(&disp[2*stride], numberDOF);
+    incrDeltaDisp = new Vector(&disp[3*stride], numberDOF);
+  } else {
+    trialDisp->setData(disp, numberDOF);
+    commitDisp->setData(&disp[stride], numberDOF);
+    incrDisp->setData(&disp[2*stride], numberDOF);
+    incrDeltaDisp->setData(&disp[3*stride], numberDOF);
+  }
+
+  if (trialVel == 0) {
+    trialVel = new Vector(vel, numberDOF);
+    commitVel = new Vector(&vel[stride], numberDOF);
+  } else {
+    trialVel->setData(vel, numberDOF);
+    commitVel->setData(&vel[stride], numberDOF);
+  }
+
+  if (trialAccel == 0) {
+    trialAccel = new Vector(accel, numberDOF);
+    commitAccel = new Vector(&accel[stride], numberDOF);
+  } else {
+    trialAccel->setData(accel, numberDOF);
+    commitAccel->setData(&accel[stride], numberDOF);
+  }
+
+  return 0;
+}
+
+
 // createDisp(), createVel() and createAccel():
 // private methods to create the arrays to hold the disp, vel and acceleration
 // values and the Vector objects for the committed and trial quantities.
@@ -1815,6 +1887,7 @@ int
 Node::createDisp(void)
 {
   // trial , committed, incr = (committed-trial)
+  stateStride = numberDOF;
   disp = new double[4*numberDOF];
     
   if (disp == 0) {
@@ -1843,6 +1916,7 @@ Node::createDisp(void)
 int
 Node::createVel(void)
 {
+    stateStride = numberDOF;
     vel = new double[2*numberDOF];
     
     if (vel == 0) {
@@ -1867,6 +1941,7 @@ Node::createVel(void)
 int
 Node::createAccel(void)
 {
+    stateStride = numberDOF;
     accel = new double[2*numberDOF];
     
     if (accel == 0) {
@@ -1893,13 +1968,10 @@ Node::createAccel(void)
 Matrix
 Node::getMassSensitivity(void)
 {
-    if (index == -1) {
-	setGlobalMatrices();
-    }
-    
 	if (mass == 0) {
-		theMatrices[index]->Zero();
-		return *theMatrices[index];
+		Matrix &result = getWorkMatrix(numberDOF);
+		result.Zero();
+		return result;
 	} 
 	else {
 		Matrix massSens(mass->noRows(),mass->noCols());
@@ -2398,37 +2470,3 @@ Node::setNodalThermalActionPtr(NodalThermalAction* theAction)
 }
 //Add Pointer to NodalThermalAction id applicable-----end------L.Jiang, {SIF]
 
-int
-Node::setGlobalMatrices()
-{
-    if (index == -1) {
-	for (int i=0; i<numMatrices; i++) {
-	    if (theMatrices[i]->noRows() == numberDOF) {
-		index = i;
-		i = numMatrices;
-	    }
-	}
-    }
-    if (index == -1) {
-	Matrix **nextMatrices = new Matrix *[numMatrices+1];
-	if (nextMatrices == 0) {
-	    opserr << "Element::getTheMatrix - out of memory\n";
-	    exit(-1);
-	}
-	for (int j=0; j<numMatrices; j++)
-	    nextMatrices[j] = theMatrices[j];
-	Matrix *theMatrix = new Matrix(numberDOF, numberDOF);
-	if (theMatrix == 0) {
-	    opserr << "Element::getTheMatrix - out of memory\n";
-	    exit(-1);
-	}
-	nextMatrices[numMatrices] = theMatrix;
-	if (numMatrices != 0) 
-	    delete [] theMatrices;
-	index = numMatrices;
-	numMatrices++;
-	theMatrices = nextMatrices;
-    }
-
-    return 0;
-}
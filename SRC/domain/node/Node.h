@@ -54,6 +54,8 @@ class NodalThermalAction; //L.Jiang [ SIF ]
 
 class Node : public DomainComponent
 {
+  friend class NodalStateStore;
+
   public:
     // constructors
     Node(int classTag);
@@ -112,7 +114,17 @@ class Node : public DomainComponent
     virtual int revertToLastCommit();    
     virtual int revertToStart();        
 
-    // public methods for dynamic analysis
+    // public method to place the response in arrays shared by the nodes
+    // of a domain, see NodalStateStore
+    int setStateStorage(double *dispData, double *velData, double *accelData,
+			int stride);
+
+    // public methods for dynamic analysis; getDamp(), getDampSensitivity()
+    // and, for a node without mass, getMass() return a matrix shared by
+    // all nodes with the same number of dof. Each thread has its own,
+    // but within a thread the old constraint still holds: the result
+    // must be used, or copied, before the same thread asks another such
+    // node for its mass or damping.
     virtual const Matrix &getMass(void);
     virtual int setMass(const Matrix &theMass);
     virtual int setNumColR(int numCol);
@@ -180,9 +192,6 @@ class Node : public DomainComponent
     int createVel(void);
     int createAccel(void); 
 
-    // private method to set up global matrices
-    int setGlobalMatrices();
-
     // private data associated with each node object
     int numberDOF;                    // number of dof at Node
     DOF_Group *theDOF_GroupPtr;       // pointer to associated DOF_Group
@@ -196,6 +205,8 @@ class Node : public DomainComponent
     
     double *disp, *vel, *accel; // double arrays holding the displ, 
                                 // vel and accel values
+    int stateStride;            // distance between trial, committed, .. in them
+    bool sharedState;           // arrays owned by a NodalStateStore
 
     int dbTag1, dbTag2, dbTag3, dbTag4; // needed for database
     Matrix *R;                          // nodal participation matrix
@@ -214,12 +225,6 @@ class Node : public DomainComponent
 
     NodalThermalAction *theNodalThermalActionPtr; //Added by Liming Jiang for pointer to nodalThermalAction, [SIF]
 
-    static Matrix **theMatrices;
-    static int numMatrices;
-    static Matrix **theVectors;
-    static int numVectors;
-    int index;
-
     Vector *reaction;
     Vector *displayLocation;
     double temperature; // Minjie
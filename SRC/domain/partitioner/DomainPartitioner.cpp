@@ -65,6 +65,7 @@
 #include <FileStream.h>
 
 #include <iostream>
+#include <vector>
 
 //==================================================================================================
 // NodeLocations
@@ -75,19 +76,24 @@
 class NodeLocations: public TaggedObject
 {
 public:
-  NodeLocations(int tag);
+  NodeLocations(int tag, int numParts);
   void Print(OPS_Stream &s, int flag =0);  
   int addPartition(int partition);
+  int removePartition(int partition);
   ID nodePartitions;
   int numPartitions;
+  ID numElements;   // number of elements of each partition using the node
+  bool isFixed;     // constrained or loaded, swapVertex() does not move it
 };
 
 
 
-NodeLocations::NodeLocations(int tag)
+NodeLocations::NodeLocations(int tag, int numParts)
 :TaggedObject(tag), 
  nodePartitions(0,1), 
- numPartitions(0)
+ numPartitions(0),
+ numElements(numParts+1),
+ isFixed(false)
 {
 
 }
@@ -106,6 +112,31 @@ NodeLocations::addPartition(int partition)
   return 0;
 }
 
+int
+NodeLocations::removePartition(int partition)
+{
+  if (nodePartitions.removeValue(partition) >= 0)
+    numPartitions--;
+  return 0;
+}
+
+
+// removes the vertices from a graph of boundary vertices without deleting
+// them, they belong to the element graph
+static void
+releaseVertices(Graph *theGraph)
+{
+  ID tags(theGraph->getNumVertex());
+  int numVertex = 0;
+  VertexIter &theVertices = theGraph->getVertices();
+  Vertex *vertexPtr;
+  while ((vertexPtr = theVertices()) != 0 && numVertex < tags.Size())
+    tags(numVertex++) = vertexPtr->getTag();
+
+  for (int i=0; i<numVertex; i++)
+    theGraph->removeVertex(tags(i), false);
+}
+
 
 //==================================================================================================
 // Some maps that help handling graphs
@@ -128,7 +159,8 @@ typedef MAP_ID::iterator     MAP_ID_ITERATOR;
 DomainPartitioner::DomainPartitioner(GraphPartitioner &theGraphPartitioner)
   :  myDomain(0), thePartitioner(theGraphPartitioner), theBalancer(0),
  theElementGraph(0), theBoundaryElements(0), 
- theNodeLocations(0),elementPlace(0), numPartitions(0), partitionFlag(false), usingMainDomain(false)
+ theNodeLocations(0),elementPlace(0), pinnedElements(0,16), partitionWeights(0), numSwapped(0),
+ numPartitions(0), partitionFlag(false), usingMainDomain(false)
 {
 
 }    
@@ -137,7 +169,8 @@ DomainPartitioner::DomainPartitioner(GraphPartitioner &theGraphPartitioner,
 				     LoadBalancer &theLoadBalancer)
   :  myDomain(0), thePartitioner(theGraphPartitioner), theBalancer(&theLoadBalancer),
  theElementGraph(0), theBoundaryElements(0),
- theNodeLocations(0),elementPlace(0), numPartitions(0), partitionFlag(false), usingMainDomain(false)
+ theNodeLocations(0),elementPlace(0), pinnedElements(0,16), partitionWeights(0), numSwapped(0),
+ numPartitions(0), partitionFlag(false), usingMainDomain(false)
 {
     // set the links the loadBalancer needs
     theLoadBalancer.setLinks(*this);
@@ -148,10 +181,21 @@ DomainPartitioner::~DomainPartitioner()
 {
   if (theBoundaryElements != 0) {
     for (int i=0; i<numPartitions; i++)
-      if (theBoundaryElements[i] != 0)
+      if (theBoundaryElements[i] != 0) {
+	releaseVertices(theBoundaryElements[i]);
 	delete theBoundaryElements[i];
+      }
     delete []theBoundaryElements;
   }
+
+  if (theElementGraph != 0)
+    delete theElementGraph;
+
+  if (theNodeLocations != 0)
+    delete theNodeLocations;
+
+  if (partitionWeights != 0)
+    delete partitionWeights;
 }
 
 
@@ -184,11 +228,41 @@ DomainPartitioner::partition(int numParts, bool usingMain, int mainPartitionTag,
     }
   }
 
-  // we get the ele graph from the domain and partition it
-  //    Graph &theEleGraph = myDomain->getElementGraph();
-  //    theElementGraph = new Graph(myDomain->getElementGraph());
-
-  theElementGraph = &(myDomain->getElementGraph());
+  // free what is left of a previous partition, the boundary graphs hold
+  // the vertices of the element graph
+  if (theBoundaryElements != 0) {
+    for (int i=0; i<numPartitions; i++)
+      if (theBoundaryElements[i] != 0) {
+	releaseVertices(theBoundaryElements[i]);
+	delete theBoundaryElements[i];
+      }
+    delete [] theBoundaryElements;
+    theBoundaryElements = 0;
+  }
+  if (theElementGraph != 0)
+    delete theElementGraph;
+  if (theNodeLocations != 0)
+    delete theNodeLocations;
+  theNodeLocations = 0;
+  elementNodes.clear();
+  pinnedElements.resize(0);
+  numPartitions = 0;
+
+  // we get a copy of the ele graph from the domain and partition it; the
+  // domain's graph is removed once the elements have moved, the copy is
+  // kept for the load balancer
+  theElementGraph = new Graph(myDomain->getElementGraph());
+
+  // if the cost of the elements has been measured, weight the vertices
+  // by it so the partitions take about the same time to compute
+  VertexIter &theWeightedVertices = theElementGraph->getVertices();
+  Vertex *weightedVertexPtr;
+  while ((weightedVertexPtr = theWeightedVertices()) != 0) {
+    Element *theEle = myDomain->getElement(weightedVertexPtr->getRef());
+    const ElementCost *theCost = (theEle != 0) ? theEle->getMeasuredCost() : 0;
+    if (theCost != 0)
+      weightedVertexPtr->setWeight(theCost->updateTime + theCost->tangentTime);
+  }
 
   int theError = thePartitioner.partition(*theElementGraph, numParts);
 
@@ -249,9 +323,6 @@ DomainPartitioner::partition(int numParts, bool usingMain, int mainPartitionTag,
   // we do not invoke the destructor on the individual graphs as 
   // this would invoke the destructor on the individual vertices
 
-  if (theBoundaryElements != 0)
-    delete [] theBoundaryElements;
-  
   theBoundaryElements = new Graph * [numParts];
   if (theBoundaryElements == 0) {
     opserr << "DomainPartitioner::partition(int numParts)";
@@ -290,7 +361,7 @@ DomainPartitioner::partition(int numParts, bool usingMain, int mainPartitionTag,
   NodeIter &theNodes = myDomain->getNodes();
   Node *nodePtr;
   while ((nodePtr = theNodes()) != 0) {
-    NodeLocations *theNodeLocation = new NodeLocations(nodePtr->getTag());
+    NodeLocations *theNodeLocation = new NodeLocations(nodePtr->getTag(), numParts);
     if (theNodeLocation == 0) {
       opserr << "DomainPartitioner::partition(int numParts)";
       opserr << " - ran out of memory creating NodeLocation for node: " << nodePtr->getTag() << endln;
@@ -339,6 +410,7 @@ DomainPartitioner::partition(int numParts, bool usingMain, int mainPartitionTag,
     //Also for each element, transverse its connected nodes
     Element *elePtr = myDomain->getElement(eleTag);
     const ID &nodes = elePtr->getExternalNodes();
+    elementNodes[eleTag] = nodes;
     size = nodes.Size();
     for (int j=0; j<size; j++) {
       int nodeTag = nodes(j);
@@ -353,6 +425,8 @@ DomainPartitioner::partition(int numParts, bool usingMain, int mainPartitionTag,
       // Add current partition as a location into current node's location map...
       NodeLocations *theNodeLocation = (NodeLocations *)theTaggedObject;
       theNodeLocation->addPartition(vertexColor);
+      if (nodes.getLocation(nodeTag) == j)
+	theNodeLocation->numElements(vertexColor)++;
     }
   }
 
@@ -380,6 +454,8 @@ DomainPartitioner::partition(int numParts, bool usingMain, int mainPartitionTag,
     
     NodeLocations *theRetainedLocation = (NodeLocations *)theRetainedObject;
     NodeLocations *theConstrainedLocation = (NodeLocations *)theConstrainedObject;
+    theRetainedLocation->isFixed = true;
+    theConstrainedLocation->isFixed = true;
 
     ID &theConstrainedNodesPartitions = theConstrainedLocation->nodePartitions;
     int numPartitions = theConstrainedNodesPartitions.Size();
@@ -547,6 +623,7 @@ DomainPartitioner::partition(int numParts, bool usingMain, int mainPartitionTag,
       }
     
       NodeLocations *theNodeLocation = (NodeLocations *)theTaggedObject;
+      theNodeLocation->isFixed = true;
       ID &nodePartitions = theNodeLocation->nodePartitions;
       int numPartitions = theNodeLocation->numPartitions;
       for (int i=0; i<numPartitions; i++) {
@@ -577,6 +654,7 @@ DomainPartitioner::partition(int numParts, bool usingMain, int mainPartitionTag,
       }
       
       NodeLocations *theNodeLocation = (NodeLocations *)theTaggedObject;
+      theNodeLocation->isFixed = true;
       ID &nodePartitions = theNodeLocation->nodePartitions;
       int numPartitions = theNodeLocation->numPartitions;
       for (int i=0; i<numPartitions; i++) {
@@ -596,6 +674,7 @@ DomainPartitioner::partition(int numParts, bool usingMain, int mainPartitionTag,
     ElementalLoad *theLoad;
     while ((theLoad = theLoads()) != 0) {
       int loadEleTag = theLoad->getElementTag();
+      pinnedElements.insert(loadEleTag);
 
       SubdomainIter &theSubdomains = myDomain->getSubdomains();
       Subdomain *theSub;
@@ -630,6 +709,7 @@ DomainPartitioner::partition(int numParts, bool usingMain, int mainPartitionTag,
     }
     
     NodeLocations *theNodeLocation = (NodeLocations *)theTaggedObject;
+    theNodeLocation->isFixed = true;
     ID &nodePartitions = theNodeLocation->nodePartitions;
     int numPartitions = theNodeLocation->numPartitions;
     for (int i=0; i<numPartitions; i++) {
@@ -731,31 +811,37 @@ DomainPartitioner::balance(Graph &theWeightedPGraph)
 
     if (theBalancer != 0) {
 
-	// call on the LoadBalancer to partition		
+	// the weights of the vertices of the elements are summed for each
+	// partition, releaseVertex() moves the share of the partition's
+	// weight in theWeightedPGraph that an element has with it
+	if (partitionWeights == 0)
+	  partitionWeights = new Vector(numPartitions+1);
+	partitionWeights->Zero();
+	VertexIter &theVertices = theElementGraph->getVertices();
+	Vertex *vertexPtr;
+	while ((vertexPtr = theVertices()) != 0) {
+	  int color = vertexPtr->getColor();
+	  if (color >= 0 && color <= numPartitions)
+	    (*partitionWeights)(color) += vertexPtr->getWeight();
+	}
 
-    // timer.start();
-    // If we have a balancer, then call the balance function
+	// call on the LoadBalancer to partition		
+	numSwapped = 0;
 	res = theBalancer->balance(theWeightedPGraph);
 	    
 	// now invoke domainChanged on Subdomains and PartitionedDomain
-    // { 
-
-
-      // All domains are informed that there has been a domain change
-	SubdomainIter &theSubDomains = myDomain->getSubdomains();
-	Subdomain *theSubDomain;
-
-	while ((theSubDomain = theSubDomains()) != 0) 
-	  theSubDomain->domainChange();
-        myDomain->domainChange();
-	
-	// we invoke change on the PartitionedDomain
-
-      // if(res > 0)
-      // {
-        // fid << myDomain->getCurrentTime() << " " << timer.getReal() << endln;
-      // }
-    // }
+	// if any element has moved, the Subdomains number their equations
+	// again before the PartitionedDomain asks for their sizes
+	if (numSwapped != 0) {
+	  SubdomainIter &theSubDomains = myDomain->getSubdomains();
+	  Subdomain *theSubDomain;
+
+	  while ((theSubDomain = theSubDomains()) != 0) {
+	    theSubDomain->domainChange();
+	    theSubDomain->invokeChangeOnAnalysis();
+	  }
+	  myDomain->domainChange();
+	}
     }
   else
   {
@@ -795,6 +881,10 @@ DomainPartitioner::getColoredGraph(void)
       opserr << " - No domain has been set";
       exit(0);
     }
+
+    // once partitioned the colors are kept in the copy of the graph
+    if (theElementGraph != 0)
+      return *theElementGraph;
     
     return myDomain->getElementGraph();
 }
@@ -804,17 +894,22 @@ int
 DomainPartitioner::swapVertex(int from, int to, int vertexTag,
 			      bool adjacentVertexNotInOther)
 {
-  opserr << "DomainPartitioner::swapVertex() " << from << " " << to << " " << vertexTag << endln;
-
-  /*
   // check that the object did the partitioning
   if (partitionFlag == false) {
-    opserr << "DomainPartitioner::balance(const Vector &load)";
+    opserr << "DomainPartitioner::swapVertex";
     opserr << " - not partitioned or DomainPartitioner did not partition\n";
     return -1;
   }
-  
-  // check that the subdomain exist in partitioned domain
+
+  if (from == to)
+    return 0;
+
+  // the elements of the main partition are in the PartitionedDomain
+  // itself, they are not moved
+  if (usingMainDomain == true && (from == mainPartition || to == mainPartition))
+    return -2;
+
+  // check that the subdomains exist in partitioned domain
   Subdomain *fromSubdomain = myDomain->getSubdomainPtr(from);
   if (fromSubdomain == 0) {
     opserr << "DomainPartitioner::swapVertex - No from Subdomain: ";
@@ -827,309 +922,229 @@ DomainPartitioner::swapVertex(int from, int to, int vertexTag,
     opserr << to << " exists\n";
     return -3;
   }    
-  
-  // remove the vertex from the boundary if there
-  // if not there we have to get a pointer to it from the ele graph.
-  
-  //    Graph &theEleGraph = myDomain->getElementGraph();    
-  Graph *fromBoundary = theBoundaryElements[from-1];
-  Graph *toBoundary = theBoundaryElements[to-1];    
-  Vertex *vertexPtr;
-  
-  // get a pointer to the vertex in the element graph
-  if (adjacentVertexNotInOther  == false) {
-    vertexPtr = fromBoundary->removeVertex(vertexTag,false);    
-    if (vertexPtr == 0) 
-      vertexPtr = theElementGraph->getVertexPtr(vertexTag);
 
-    if (vertexPtr == 0)  // if still 0 no vertex given by tag exists
-      return -4;
-  } else { // get a pointer and check vertex not adjacent to another partition
-    vertexPtr = fromBoundary->getVertexPtr(vertexTag);    
-    if (vertexPtr == 0) 
-      vertexPtr = theElementGraph->getVertexPtr(vertexTag);
-    if (vertexPtr == 0)  // if still 0 no vertex given by tag exists
-      return -4;	
-    const ID &adjacent = vertexPtr->getAdjacency();
+  Vertex *vertexPtr = theElementGraph->getVertexPtr(vertexTag);
+  if (vertexPtr == 0 || vertexPtr->getColor() != from)
+    return -4;
+
+  // if asked, check the vertex is adjacent to to and to no other partition
+  const ID &eleAdjacent = vertexPtr->getAdjacency();
+  int eleAdjacentSize = eleAdjacent.Size();
+  if (adjacentVertexNotInOther == true) {
     bool inTo = false;
     bool inOther = false;
-    int adjacentSize = adjacent.Size();
-    for (int i=0; i<adjacentSize; i++) {
-      Vertex *other = theElementGraph->getVertexPtr(adjacent(i));
-      if (other->getColor() == to) 
+    for (int i=0; i<eleAdjacentSize; i++) {
+      int otherColor = theElementGraph->getVertexPtr(eleAdjacent(i))->getColor();
+      if (otherColor == to) 
 	inTo = true;
-      else if (other->getColor() != from) {
+      else if (otherColor != from)
 	inOther = true;
-	i = adjacentSize;
-      }
     }
     if (inTo != true || inOther == true) // we cannot remove the vertex
       return -5;
-    // if can remove the vertex from the fromBoundary
-    Vertex *theVertex = fromBoundary->removeVertex(vertexTag,false);
   }
-  
+
   int eleTag = vertexPtr->getRef();
-  
-  //
-  // in the FROM subdomain we:
-  //  1. remove the element
-  //  2. remove all nodes connected to the element divide color by prime
-  //  3. see if have to add nodes back as external
-  //  4. remove from the PartitionedDomain if node was external
-  //  5. add new elements to the boundary vertices for from
-  
-  //  1. remove the element from the fromSubdomain
-    //          this gives us a pointer to the element as well.
-
-    Element *elePtr = fromSubdomain->removeElement(eleTag);
-    if (elePtr == 0) // if ele not there we can just return but ERROR it should be
-  return -6;
-
-    //  2. remove all nodes connected to the element divide color by prime    
-    //  3. add back if still in subdomain
-    //  4. if node external remove from PartitionedDomains external nodes
-    int primeFrom = primes(from);
-    const ID  &nodes1 = elePtr->getExternalNodes(); // create a copy, need after send ele
-    ID  nodes(nodes1);
-
-    int nodesSize = nodes.Size();
-    Node **nodesArray = new Node *[nodesSize];
-    for (int i=0; i<nodesSize; i++) {
-  int nodeTag = nodes(i);
-
-  // remove the node
-  Node *nodePtr = fromSubdomain->removeNode(nodeTag);
-
-  (*nodePlace)(nodeTag) /= primeFrom;
-  nodesArray[i] = nodePtr;
-        // opserr << "DomainPartitioner::swapVertex -NODE " << *nodePtr;
-  // add back as external if still needed
-  if ((*nodePlace)(nodeTag)%primeFrom == 0)
-      fromSubdomain->addExternalNode(nodePtr);
-
-  // if it was external remove from PartitionedDomains external nodes
-  int partition = (*nodePlace)(nodeTag);
-  for (int j=1; j<=numPartitions; j++) 
-      if (j != from) {
-    int prime = primes(j);
-    if (partition%prime == 0) {
-        myDomain->removeExternalNode(nodeTag);
-        j = numPartitions+1;
-    }
-      }
-    }
+  if (pinnedElements.getLocationOrdered(eleTag) >= 0)
+    return -5;
 
-    // 5. add new elements to boundary vertices of from if connected to
-    //    vertex we just removed and of color of from and not already in boundary
+  std::map<int, ID>::iterator theEleNodes = elementNodes.find(eleTag);
+  if (theEleNodes == elementNodes.end())
+    return -4;
+  const ID &nodes = theEleNodes->second;
+  int numNodes = nodes.Size();
 
-    const ID &eleAdjacent = vertexPtr->getAdjacency();
-    int eleAdjacentSize = eleAdjacent.Size();
+  //
+  // determine the partitions each node of the element is in after the
+  // swap; a node that is constrained or loaded must stay as it is. a
+  // subdomain that keeps a node but as internal instead of external node,
+  // or the reverse, gets a new node object, its elements using the node
+  // are removed and added back so they use the new one
+  //
 
-    for (int a=0; a<eleAdjacentSize; a++) {
-	int otherEleVertexTag = eleAdjacent(a);
-	Vertex *other = fromBoundary->getVertexPtr(otherEleVertexTag);
-	if (other == 0) {
-	    other = theElementGraph->getVertexPtr(otherEleVertexTag);
-	    if (other->getColor() == from)
-		fromBoundary->addVertex(other,false);
-	}
-    }
+  std::vector<NodeLocations *> theLocations(numNodes, (NodeLocations *)0);
+  std::vector<ID> oldPartitions(numNodes);
+  std::vector<ID> newPartitions(numNodes);
+  std::vector<int> reloadTags;
+  std::vector<int> reloadPartitions;
 
+  for (int i=0; i<numNodes; i++) {
+    int nodeTag = nodes(i);
+    if (nodes.getLocation(nodeTag) != i) // node listed twice
+      continue;
 
-    
-    // in the TO subdomain we:
-    //  1. remove all nodes connected to the element, may or may not be there
-    //     if there don't divide by primeTo. 
-    //  2. mark all connecting nodes of elements as belonging to To
-    //  3. add the nodes, checking if external or internal
-    //  3. add the element
-    //  4. change the vertex color to be to and add vertex to boundary
-    //     also see if we can reduce the size of boundary
-    //     of boundary of to vertices
-
-    //  1. remove all nodes connected to the element, may or may not be there
-    //      if there divide by primeTo, do this as may have been added as extnl
-    int primeTo = primes(to);
-    for (int l=0; l<nodesSize; l++) {    
-  int nodeTag = nodesArray[l]->getTag();
-  int nodeColor = (*nodePlace)(nodeTag);
-  if (nodeColor % primeTo == 0) {
-      Node *nodePtr;
-      nodePtr = toSubdomain->removeNode(nodes(l));
-  }
+    TaggedObject *theTaggedObject = theNodeLocations->getComponentPtr(nodeTag);
+    if (theTaggedObject == 0) {
+      opserr << "DomainPartitioner::swapVertex";
+      opserr << " - failed to find NodeLocation in Map for Node: " << nodeTag << " -- A BUG!!\n";
+      return -4;
     }
+    NodeLocations *theNodeLocation = (NodeLocations *)theTaggedObject;
 
-
-    for (int m=0; m<nodesSize; m++) {
-  Node *nodePtr = nodesArray[m];
-  int nodeTag = nodePtr->getTag();
-  
-  //  2. mark all connecting nodes of elements as belonging to To      
-  (*nodePlace)(nodeTag) *= primeTo;
-
-  //  3. add the nodes, checking if external or internal  
-  int internal = 0;
-  for (int n=1; n<=numPartitions; n++) 
-      if (n != to) {
-    int prime = primes(n);
-    if ((*nodePlace)(nodeTag)%prime == 0) { // its external
-        internal = 1;
-        n = numPartitions+1;
-    }
+    bool leavesFrom = theNodeLocation->numElements(from) == 1;
+    bool entersTo = theNodeLocation->numElements(to) == 0;
+    if (leavesFrom == false && entersTo == false)
+      continue;
+
+    if (theNodeLocation->isFixed == true)
+      return -6;
+
+    theLocations[i] = theNodeLocation;
+    oldPartitions[i] = theNodeLocation->nodePartitions;
+    newPartitions[i] = theNodeLocation->nodePartitions;
+    if (leavesFrom == true)
+      newPartitions[i].removeValue(from);
+    newPartitions[i].insert(to);
+
+    bool wasInternal = oldPartitions[i].Size() == 1;
+    bool isInternal = newPartitions[i].Size() == 1;
+    if (wasInternal == isInternal)
+      continue;
+
+    for (int j=0; j<newPartitions[i].Size(); j++) {
+      int partition = newPartitions[i](j);
+      if (oldPartitions[i].getLocationOrdered(partition) < 0 ||
+	  (usingMainDomain == true && partition == mainPartition))
+	continue;
+
+      // any element sharing the node is adjacent to the vertex
+      for (int k=0; k<eleAdjacentSize; k++) {
+	Vertex *other = theElementGraph->getVertexPtr(eleAdjacent(k));
+	int otherTag = other->getRef();
+	if (other->getColor() != partition ||
+	    elementNodes[otherTag].getLocation(nodeTag) < 0)
+	  continue;
+
+	bool listed = false;
+	for (size_t l=0; l<reloadTags.size(); l++)
+	  if (reloadTags[l] == otherTag)
+	    listed = true;
+	if (listed == false) {
+	  reloadTags.push_back(otherTag);
+	  reloadPartitions.push_back(partition);
+	}
       }
-  
-  if (internal == 0)
-      toSubdomain->addNode(nodePtr);
-  else {
-      toSubdomain->addExternalNode(nodePtr);
-      myDomain->addNode(nodePtr);
-  }
     }
+  }
 
-    delete [] nodesArray; // DELETE nodesArray here should not use nodePtrs
-                          // after here as node objects deleted if parallel    
-    
-    //  3. add the element
-    
-    toSubdomain->addElement(elePtr);
-    
-    //  4. change the vertex color to be to and add vertex to boundary
-    //     also see if we can reduce the size of to's boundary vertices
-
-
-    vertexPtr->setColor(to);
-    toBoundary->addVertex(vertexPtr,false);
-
-    for (int n=0; n<eleAdjacentSize; n++) {
-	int otherEleVertexTag = eleAdjacent(n);
-	Vertex *other = toBoundary->removeVertex(otherEleVertexTag,false);
-	if (other != 0) {
-	    const ID &othersAdjacency = other->getAdjacency();
-	    int otherSize = othersAdjacency.Size();
-	    for (int b=0; b<otherSize; b++) {
-		int anotherEleVertexTag = othersAdjacency(b);
-		Vertex *otherOther = theElementGraph->getVertexPtr(anotherEleVertexTag);
-		if (otherOther->getColor() != to) {
-		    toBoundary->addVertex(other,false);
-		    b=otherSize;
-		}
-	    }
-	}
-    }
+  // remove the element from from; a subdomain in another process sends
+  // it, with its state, as it does the nodes below
+  Element *elePtr = fromSubdomain->removeElement(eleTag);
+  if (elePtr == 0) {
+    opserr << "DomainPartitioner::swapVertex - element " << eleTag;
+    opserr << " not in Subdomain " << from << endln;
+    return -7;
+  }
 
+  std::vector<Element *> reloadElements(reloadTags.size(), (Element *)0);
+  for (size_t l=0; l<reloadTags.size(); l++) {
+    Subdomain *theSubdomain = myDomain->getSubdomainPtr(reloadPartitions[l]);
+    reloadElements[l] = theSubdomain->removeElement(reloadTags[l]);
+  }
 
-    // now remove any SP_Constraints that may have been external to 
-    // PartitionedDomain and are now internal to toSubdomain
-    SP_ConstraintIter &theSPs = myDomain->getSPs();
-    SP_Constraint *spPtr;
-    while ((spPtr = theSPs()) != 0) {
-  int nodeTag = spPtr->getNodeTag();
-  for (int i=0; i<nodesSize; i++) {
-      if (nodeTag == nodes(i)) {
-    int internal = 0;
-    for (int j=1; j<=numPartitions; j++) 
-        if (j != to) {
-      int prime = primes(j);
-      if ((*nodePlace)(nodeTag)%prime == 0) {
-          internal = 1;
-          j = numPartitions+1;
-      }
-        }
-    if (internal == 0) { // add to toSubdomain if inteernal
-        myDomain->removeSP_Constraint(spPtr->getTag());
-        toSubdomain->addSP_Constraint(spPtr);
-    }
+  // move the nodes, a boundary node is in the PartitionedDomain and the
+  // subdomains have a copy as external node
+  for (int i=0; i<numNodes; i++) {
+    NodeLocations *theNodeLocation = theLocations[i];
+    if (theNodeLocation == 0)
+      continue;
+
+    int nodeTag = nodes(i);
+    const ID &oldParts = oldPartitions[i];
+    const ID &newParts = newPartitions[i];
+    bool wasInternal = oldParts.Size() == 1;
+    bool isInternal = newParts.Size() == 1;
+
+    // the node with the state
+    Node *nodePtr = 0;
+    if (wasInternal == true)
+      nodePtr = fromSubdomain->removeNode(nodeTag);
+    else {
+      for (int j=0; j<oldParts.Size(); j++) {
+	int partition = oldParts(j);
+	if (usingMainDomain == true && partition == mainPartition)
+	  continue;
+	if (newParts.getLocationOrdered(partition) < 0 || isInternal == true) {
+	  Node *dummy = myDomain->getSubdomainPtr(partition)->removeNode(nodeTag);
+	  if (dummy != 0)
+	    delete dummy;
+	}
       }
-  }
     }
 
-    
-    
-    // now remove any SP_Constraints that may have been internal to fromSubdomain
-    // and are now external to PartitionedDomain or internal to toSubdomain 
-    SP_ConstraintIter &theSPs2 = fromSubdomain->getSPs();
-    while ((spPtr = theSPs2()) != 0) {
-  int nodeTag = spPtr->getNodeTag();
-  for (int i=0; i<nodesSize; i++) {
-      if (nodeTag == nodes(i)) {
-    fromSubdomain->removeSP_Constraint(spPtr->getTag());
-    int internal = 0;
-    for (int j=1; j<=numPartitions; j++) 
-        if (j != to) {
-      int prime = primes(j);
-      if ((*nodePlace)(nodeTag)%prime == 0) {
-          internal = 1;
-          j = numPartitions+1;
+    if (isInternal == true) {
+      int partition = newParts(0);
+      if (usingMainDomain == false || partition != mainPartition) {
+	if (wasInternal == false)
+	  nodePtr = myDomain->removeExternalNode(nodeTag);
+	if (nodePtr != 0)
+	  myDomain->getSubdomainPtr(partition)->addNode(nodePtr);
       }
-        }
-    if (internal == 0) 
-        toSubdomain->addSP_Constraint(spPtr);
-    else
-        myDomain->addSP_Constraint(spPtr);
+    } else {
+      if (wasInternal == true && nodePtr != 0)
+	myDomain->addNode(nodePtr);
+
+      Node *boundaryNode = myDomain->getNode(nodeTag);
+      for (int j=0; j<newParts.Size(); j++) {
+	int partition = newParts(j);
+	if (usingMainDomain == true && partition == mainPartition)
+	  continue;
+	if ((oldParts.getLocationOrdered(partition) < 0 || wasInternal == true) &&
+	    boundaryNode != 0)
+	  myDomain->getSubdomainPtr(partition)->addExternalNode(boundaryNode);
       }
-  }
     }
 
-
-
-  */
-    /*
-    // now remove any NodalLoads that may have been external to 
-    // PartitionedDomain and are now internal to toSubdomain
-    NodalLoadIter &theNodalLoads = myDomain->getNodalLoads();
-    NodalLoad *loadPtr;
-    while ((loadPtr = theNodalLoads()) != 0) {
-  int nodeTag = loadPtr->getNodeTag();
-  for (int i=0; i<nodesSize; i++) {
-      if (nodeTag == nodes(i)) {
-    int internal = 0;
-    for (int j=1; j<=numPartitions; j++) 
-        if (j != to) {
-      int prime = primes(j);
-      if ((*nodePlace)(nodeTag)%prime == 0) {
-          internal = 1;
-          j = numPartitions+1;
-      }
-        }
-    if (internal == 0) { // add to toSubdomain if inteernal
-        myDomain->removeNodalLoad(loadPtr->getTag());
-        toSubdomain->addNodalLoad(loadPtr);
-    }
-      }
+    if (newParts.getLocationOrdered(from) < 0)
+      theNodeLocation->removePartition(from);
+    theNodeLocation->addPartition(to);
   }
-    }
 
+  for (int i=0; i<numNodes; i++) {
+    int nodeTag = nodes(i);
+    if (nodes.getLocation(nodeTag) != i)
+      continue;
+    NodeLocations *theNodeLocation = (NodeLocations *)theNodeLocations->getComponentPtr(nodeTag);
+    theNodeLocation->numElements(from)--;
+    theNodeLocation->numElements(to)++;
+  }
 
-    // now remove any NodalLoads that may have been internal to fromSubdomain
-    // and are now external to PartitionedDomain or internal to toSubdomain 
-
-    NodalLoadIter &theNodalLoads2 = myDomain->getNodalLoads();
-    while ((loadPtr = theNodalLoads2()) != 0) {
-  int nodeTag = loadPtr->getNodeTag();
-  for (int i=0; i<nodesSize; i++) {
-      if (nodeTag == nodes(i)) {
-    fromSubdomain->removeNodalLoad(loadPtr->getTag());
-    int internal = 0;
-    for (int j=1; j<=numPartitions; j++) 
-        if (j != to) {
-      int prime = primes(j);
-      if ((*nodePlace)(nodeTag)%prime == 0) {
-          internal = 1;
-          j = numPartitions+1;
+  for (size_t l=0; l<reloadTags.size(); l++)
+    if (reloadElements[l] != 0)
+      myDomain->getSubdomainPtr(reloadPartitions[l])->addElement(reloadElements[l]);
+
+  toSubdomain->addElement(elePtr);
+
+  // recolor the vertex; it and its adjacent vertices are the only ones
+  // that may have moved on or off the boundaries
+  vertexPtr->setColor(to);
+  theBoundaryElements[from-1]->removeVertex(vertexTag, false);
+
+  for (int a=-1; a<eleAdjacentSize; a++) {
+    Vertex *theVertex = (a < 0) ? vertexPtr : theElementGraph->getVertexPtr(eleAdjacent(a));
+    int color = theVertex->getColor();
+    if (color < 1 || color > numPartitions)
+      continue;
+
+    bool onBoundary = false;
+    const ID &adjacency = theVertex->getAdjacency();
+    for (int b=0; b<adjacency.Size(); b++)
+      if (theElementGraph->getVertexPtr(adjacency(b))->getColor() != color) {
+	onBoundary = true;
+	break;
       }
-        }
-    if (internal == 0) 
-        toSubdomain->addNodalLoad(loadPtr);
-    else
-        myDomain->addNodalLoad(loadPtr);
-      }  
+
+    Graph *theBoundary = theBoundaryElements[color-1];
+    bool inBoundary = theBoundary->getVertexPtr(theVertex->getTag()) != 0;
+    if (onBoundary == true && inBoundary == false)
+      theBoundary->addVertex(theVertex, false);
+    else if (onBoundary == false && inBoundary == true)
+      theBoundary->removeVertex(theVertex->getTag(), false);
   }
-    }
-    */
 
-    return 0;
+  numSwapped++;
 
+  return 0;
 }
 
 
@@ -1141,380 +1156,40 @@ int
 DomainPartitioner::swapBoundary(int from, int to, bool adjacentVertexNotInOther)
           
 {
-  opserr << "DomainPartitioner::swapBoundary: from "  << from << " to " << to << endln;
-  /***********************************************************************************
-    opserr << "DomainPartitioner::swapBoundary from " << from << "  to " << to << endln;
-    Timer timer;
-    timer.start();
-
-    // check that the object did the partitioning
-    if (partitionFlag == false) {
-  opserr << "DomainPartitioner::balance(const Vector &load)";
-  opserr << " - not partitioned or DomainPartitioner did not partition\n";
-  return -1;
-    }
-
-    // check that the subdomains exist in partitioned domain
-    Subdomain *fromSubdomain = myDomain->getSubdomainPtr(from);
-    if (fromSubdomain == 0) {
-  opserr << "DomainPartitioner::swapBoundary - No from Subdomain: ";
-  opserr << from << " exists\n";
-  return -2;
-    }
-
-    Subdomain *toSubdomain = myDomain->getSubdomainPtr(to);
-    if (toSubdomain == 0) {
-  opserr << "DomainPartitioner::swapBoundary - No to Subdomain: ";
-  opserr << to << " exists\n";
-  return -3;
-    }    
-
-    // get the element graph
-    //    Graph &theEleGraph = myDomain->getElementGraph();    
-    Graph *fromBoundary = theBoundaryElements[from-1];
-    Graph *toBoundary = theBoundaryElements[to-1];
-
-    // into a new graph place the vertices that are to be swapped
-    Graph *swapVertices = new Graph(fromBoundary->getNumVertex());
-
-    VertexIter &swappableVertices = fromBoundary->getVertices();
-    Vertex *vertexPtr;
-
-    while ((vertexPtr = swappableVertices()) != 0) {
-	if (adjacentVertexNotInOther == false) {   
-	    const ID &adjacency=vertexPtr->getAdjacency();
-	    int size = adjacency.Size();
-	    for (int i=0; i<size; i++) {
-		int otherTag = adjacency(i);
-		Vertex *otherVertex = toBoundary->getVertexPtr(otherTag);
-		if (otherVertex != 0) {
-		    swapVertices->addVertex(vertexPtr,false);
-		    i = size;
-		}
-	    }
-	}
-	else {
-	    const ID &adjacent = vertexPtr->getAdjacency();
-	    bool inTo = false;
-	    bool inOther = false;
-	    int adjacentSize = adjacent.Size();
-	    for (int i=0; i<adjacentSize; i++) {
-		Vertex *other = theElementGraph->getVertexPtr(adjacent(i));
-		if (other->getColor() == to) 
-		    inTo = true;
-		else if (other->getColor() != from) {
-		    inOther = true;
-		    i = adjacentSize;
-		}
-	    }
-	    if (inTo == true && inOther == false) { // we remove the vertex
-		swapVertices->addVertex(vertexPtr,false);
-		vertexPtr->setColor(to);
-	    }
-	}
-    }
-
-    //
-    // in the FROM subdomain we:
-    //  1. remove the elements corresponding to the vertices
-    //  2. remove all nodes connected to the elements divide color by prime
-    //  3. see if have to add nodes back as external
-    //  4. remove from the PartitionedDomain if node was external
-    //  5. add new elements to the boundary vertices for from
-
-    // 1. first remove all the elements from from subdomain
-    VertexIter &verticesToSwap = swapVertices->getVertices();
-
-    int numEleToSwap = swapVertices->getNumVertex();
-    Element **elementsArray = new Element *[numEleToSwap];
-
-    int count =0; 
-    int numCannotRemove =0;
-    for (int i=0; i<numEleToSwap; i++) {
-      vertexPtr = verticesToSwap();
-  if (vertexPtr == 0) 
-      return -1;
-
-  int vertexTag = vertexPtr->getTag();
-  int eleTag = vertexPtr->getRef();
-
-  // remove the vertex from fromBoundary, set color to to
-  // and add to toBoundary
-  bool inFrom = true;
-  vertexPtr = fromBoundary->removeVertex(vertexTag,false);
-
-
-  if (inFrom == true) {
-      vertexPtr->setColor(to);
-      toBoundary->addVertex(vertexPtr,false);
-      Element *elePtr = fromSubdomain->removeElement(eleTag);
-      if (elePtr == 0) // if ele not there we can just return IT SHOULD BE
-    return -4;
-      elementsArray[count] = elePtr;
-      count++;
-  }
-  else  // we cannot remove the element
-      numCannotRemove++;
-    }
-    numEleToSwap -= numCannotRemove;
-
-    //  2. remove all nodes connected to the elements divide color by prime    
-    //     for each element and add back if still in subdomain
-    //  3. add back if still in subdomain
-    //  4. if node external remove from PartitionedDomains external nodes
-
-    // first determine which nodes to remove
-    int primeFrom = primes(from);
-    int primeTo = primes(to);
-    int numNodToSwap = 0;
-    ID nodesToRemove(0,128);
-    for (int j=0; j<numEleToSwap; j++) {
-  Element *elePtr = elementsArray[j];
-  const ID  &nodes = elePtr->getExternalNodes(); 
-  
-  int nodesSize = nodes.Size();
-
-  for (int k=0; k<nodesSize; k++) {
-      int nodeTag = nodes(k);
-      int loc = nodesToRemove.getLocation(nodeTag);
-      if (loc < 0) {
-    nodesToRemove[numNodToSwap] = nodeTag;
-    numNodToSwap++;
-      }
-      (*nodePlace)(nodeTag) /= primeFrom;    
-      (*nodePlace)(nodeTag) *= primeTo;        
-  }
-    }
-
-    // remove the nodes
-    Node **nodesArray = new Node *[numNodToSwap];  
-    for (int k=0; k<numNodToSwap; k++) {
-  int nodeTag = nodesToRemove(k); 
-  Node *nodePtr = fromSubdomain->removeNode(nodeTag);
-  nodesArray[k] = nodePtr;
-
-  // add the node back to from if still external
-  if ((*nodePlace)(nodeTag)%primeFrom == 0)
-      fromSubdomain->addExternalNode(nodePtr);
-
-  // if it was external remove from PartitionedDomains external nodes
-  int partition = (*nodePlace)(nodeTag);
-  for (int j=1; j<=numPartitions; j++) 
-      if (j != from) {
-    int prime = primes(j);
-    if (partition%prime == 0) {
-        myDomain->removeExternalNode(nodeTag);
-        j = numPartitions+1;
-    }
-      }
-    }
-
-    // 5. add new vertices to boundary vertices of from if connected to
-    //    vertex we just removed and of color of from and not already in boundary
-
-    VertexIter &verticesToSwap2 = swapVertices->getVertices();
-    while ((vertexPtr = verticesToSwap2()) != 0) {
-  const ID &vertexAdjacent = vertexPtr->getAdjacency();
-  int vertexAdjacentSize = vertexAdjacent.Size();
-
-	for (int a=0; a<vertexAdjacentSize; a++) {
-	    int otherEleVertexTag = vertexAdjacent(a);
-	    Vertex *other = fromBoundary->getVertexPtr(otherEleVertexTag);
-	    if (other == 0) {
-		other = theElementGraph->getVertexPtr(otherEleVertexTag);
-		if (other->getColor() == from)
-		    fromBoundary->addVertex(other,false);
-	    }
-	}	
-    }
-
-
-    // in the TO subdomain we:
-    //  1. remove all nodes connected to the element, may or may not be there
-    //     if there don't divide by primeTo. 
-    //  2. mark all connecting nodes of elements as belonging to To
-    //  3. add the nodes, checking if external or internal
-    //  3. add the element
-    //  4. change the vertex color to be to and add vertex to boundary
-    //     also see if we can reduce the size of boundary
-    //     of boundary of to vertices
-
-    //  1. remove all nodes connected to the element, may or may not be there
-    //      if there divide by primeTo, do this as may have been added as extnl
-
-    for (int l=0; l<numNodToSwap; l++) {    
-  int nodeTag = nodesArray[l]->getTag();
-  Node *nodePtr;
-  nodePtr = toSubdomain->removeNode(nodesToRemove(l));
-    }
-
-
-    for (int m=0; m<numNodToSwap; m++) {
-  Node *nodePtr = nodesArray[m];
-  int nodeTag = nodePtr->getTag();
-  
-  //  3. add the nodes, checking if external or internal  
-  int internal = 0;
-  for (int n=1; n<=numPartitions; n++) 
-      if (n != to) {
-    int prime = primes(n);
-    if ((*nodePlace)(nodeTag)%prime == 0) { // its external
-        internal = 1;
-        n = numPartitions+1;
-    }
-      }
-  
-  if (internal == 0)
-      toSubdomain->addNode(nodePtr);
-  else {
-      toSubdomain->addExternalNode(nodePtr);
-      myDomain->addNode(nodePtr);
+  // check that the object did the partitioning
+  if (partitionFlag == false) {
+    opserr << "DomainPartitioner::swapBoundary";
+    opserr << " - not partitioned or DomainPartitioner did not partition\n";
+    return -1;
   }
-    }
-
-
-    delete [] nodesArray; // DELETE nodesArray here should not use nodePtrs
-                          // after here as node objects deleted if parallel    
-    
-    //  3. add the elements
-    for (int a=0; a<numEleToSwap; a++)
-  toSubdomain->addElement(elementsArray[a]);
-
-
-    //  4. change the vertex color to be to and add vertex to boundary
-    //     also see if we can reduce the size of to's boundary vertices
-
-    VertexIter &verticesToSwap3 = swapVertices->getVertices();
-    while ((vertexPtr = verticesToSwap3()) != 0) {
-	const ID &vertexAdjacent = vertexPtr->getAdjacency();
-	int vertexAdjacentSize = vertexAdjacent.Size();
-	for (int n=0; n<vertexAdjacentSize; n++) {
-	    int otherEleVertexTag = vertexAdjacent(n);
-	    Vertex *other = toBoundary->removeVertex(otherEleVertexTag,false);
-	    if (other != 0) {
-		const ID &othersAdjacency = other->getAdjacency();
-		int otherSize = othersAdjacency.Size();
-		for (int b=0; b<otherSize; b++) {
-		    int anotherEleVertexTag = othersAdjacency(b);
-		    Vertex *otherOther 
-			= theElementGraph->getVertexPtr(anotherEleVertexTag);
-		    if (otherOther->getColor() != to) {
-			toBoundary->addVertex(other,false);
-			b=otherSize;
-		    }
-		}
-	    }
-	}
-    }
 
-    // now remove any SP_Constraints that may have been external to 
-    // PartitionedDomain and are now internal to toSubdomain
-    SP_ConstraintIter &theSPs = myDomain->getSPs();
-    SP_Constraint *spPtr;
-    while ((spPtr = theSPs()) != 0) {
-  int nodeTag = spPtr->getNodeTag();
-  int loc = nodesToRemove.getLocation(nodeTag);
-  if (loc >= 0) {
-      int internal = 0;
-      for (int j=1; j<=numPartitions; j++) 
-    if (j != to) {
-        int prime = primes(j);
-        if ((*nodePlace)(nodeTag)%prime == 0) {
-      internal = 1;
-      j = numPartitions+1;
-        }
-    }
-      if (internal == 0) { // add to toSubdomain if inteernal
-    myDomain->removeSP_Constraint(spPtr->getTag());
-    toSubdomain->addSP_Constraint(spPtr);
-      }
+  if (from < 1 || from > numPartitions || to < 1 || to > numPartitions) {
+    opserr << "DomainPartitioner::swapBoundary - no partition " << from;
+    opserr << " or " << to << endln;
+    return -2;
   }
-    }
 
-    
-    // now remove any SP_Constraints that may have been internal to fromSubdomain
-    // and are now external to PartitionedDomain or internal to toSubdomain 
-    SP_ConstraintIter &theSPs2 = fromSubdomain->getSPs();
-    while ((spPtr = theSPs2()) != 0) {
-  int nodeTag = spPtr->getNodeTag();
-  int loc = nodesToRemove.getLocation(nodeTag);
-  if (loc >= 0) {
-      fromSubdomain->removeSP_Constraint(spPtr->getTag());
-      int internal = 0;
-      for (int j=1; j<=numPartitions; j++) 
-    if (j != to) {
-        int prime = primes(j);
-        if ((*nodePlace)(nodeTag)%prime == 0) {
-      internal = 1;
-      j = numPartitions+1;
-        }
-    }
-      if (internal == 0) 
-    toSubdomain->addSP_Constraint(spPtr);
-      else
-    myDomain->addSP_Constraint(spPtr);
-  }  
-    }
+  // swapVertex() changes the boundary, the vertices of from adjacent
+  // to to are found first
+  Graph *fromBoundary = theBoundaryElements[from-1];
+  ID swapTags(0, fromBoundary->getNumVertex()+1);
+  int numSwap = 0;
 
-    // now remove any NodalLoads that may have been external to 
-    // PartitionedDomain and are now internal to toSubdomain
-    NodalLoadIter &theNodalLoads = myDomain->getNodalLoads();
-    NodalLoad *loadPtr;
-    while ((loadPtr = theNodalLoads()) != 0) {
-  int nodeTag = loadPtr->getNodeTag();
-  int loc = nodesToRemove.getLocation(nodeTag);
-  if (loc >= 0) {
-
-      int internal = 0;
-      for (int j=1; j<=numPartitions; j++) 
-    if (j != to) {
-        int prime = primes(j);
-        if ((*nodePlace)(nodeTag)%prime == 0) {
-      internal = 1;
-      j = numPartitions+1;
-        }
-    }
-      if (internal == 0) { // add to toSubdomain if inteernal
-    myDomain->removeNodalLoad(loadPtr->getTag());
-    toSubdomain->addNodalLoad(loadPtr);
+  VertexIter &swappableVertices = fromBoundary->getVertices();
+  Vertex *vertexPtr;
+  while ((vertexPtr = swappableVertices()) != 0) {
+    const ID &adjacency = vertexPtr->getAdjacency();
+    for (int i=0; i<adjacency.Size(); i++)
+      if (theElementGraph->getVertexPtr(adjacency(i))->getColor() == to) {
+	swapTags[numSwap++] = vertexPtr->getTag();
+	break;
       }
   }
-    }
-
-
-    // now remove any NodalLoads that may have been internal to fromSubdomain
-    // and are now external to PartitionedDomain or internal to toSubdomain 
-
-    NodalLoadIter &theNodalLoads2 = myDomain->getNodalLoads();
-    while ((loadPtr = theNodalLoads2()) != 0) {
-  int nodeTag = loadPtr->getNodeTag();
-  int loc = nodesToRemove.getLocation(nodeTag);
-  if (loc >= 0) {
-      fromSubdomain->removeNodalLoad(loadPtr->getTag());
-      int internal = 0;
-      for (int j=1; j<=numPartitions; j++) 
-    if (j != to) {
-        int prime = primes(j);
-        if ((*nodePlace)(nodeTag)%prime == 0) {
-      internal = 1;
-      j = numPartitions+1;
-        }
-    }
-      if (internal == 0) 
-    toSubdomain->addNodalLoad(loadPtr);
-      else
-    myDomain->addNodalLoad(loadPtr);
-  }  
-    }
 
+  for (int j=0; j<numSwap; j++)
+    this->swapVertex(from, to, swapTags(j), adjacentVertexNotInOther);
 
-    delete swapVertices;
-
-    timer.pause();
-    opserr << "DomainPartitioner::swapBoundary DONE" << timer.getReal() << endln;
-
-  ***************************************************************************/
-    return 0;
+  return 0;
 }
 
 
@@ -1575,29 +1250,39 @@ DomainPartitioner::releaseVertex(int from,
       maxAttraction = attraction(j);
     }
 
+  if (partition == from)
+    return 0;
+
+  Vertex *fromVertex = theWeightedPartitionGraph.getVertexPtr(from);
+  Vertex *toVertex = theWeightedPartitionGraph.getVertexPtr(partition);	    
+  if (fromVertex == 0 || toVertex == 0)
+    return -4;
+
+  double fromWeight = fromVertex->getWeight();
+  double toWeight  = toVertex->getWeight();
+
+  if (mustReleaseToLighter == true) { // check the other partition has a lighter load
+    if (fromWeight <= toWeight)
+      return 0;
+    if (toWeight != 0.0 && fromWeight/toWeight <= factorGreater)
+      return 0;
+  }
+
   // swap the vertex
-  if (mustReleaseToLighter == false)
-    return swapVertex(from, partition, vertexTag, adjacentVertexNotInOther);
-  
-  else { // check the other partition has a lighter load
-    Vertex *fromVertex = theWeightedPartitionGraph.getVertexPtr(from);
-    Vertex *toVertex = theWeightedPartitionGraph.getVertexPtr(partition);	    
-    
-    double fromWeight = fromVertex->getWeight();
-    double toWeight  = toVertex->getWeight();
-    
-    if (fromWeight == toWeight)
-      opserr << "DomainPartitioner::releaseVertex - TO CHANGE >= to >\n";
-
-    if (fromWeight >= toWeight) {
-      if (toWeight == 0.0) 
-	return swapVertex(from,partition,vertexTag,adjacentVertexNotInOther);	    
-      if (fromWeight/toWeight > factorGreater)        
-	return swapVertex(from,partition,vertexTag,adjacentVertexNotInOther);	    
-    }
+  int res = swapVertex(from, partition, vertexTag, adjacentVertexNotInOther);
+
+  // move the share of the element in the weight of from to partition, so
+  // the next vertices released see the loads the swaps have left
+  if (res == 0 && partitionWeights != 0 && (*partitionWeights)(from) > 0.0) {
+    double eleWeight = vertexPtr->getWeight();
+    double share = fromWeight*eleWeight/(*partitionWeights)(from);
+    fromVertex->setWeight(fromWeight - share);
+    toVertex->setWeight(toWeight + share);
+    (*partitionWeights)(from) -= eleWeight;
+    (*partitionWeights)(partition) += eleWeight;
   }
-  
-  return 0;
+
+  return res;
 }
 
 
@@ -1649,7 +1334,9 @@ DomainPartitioner::releaseBoundary(int from,
 		    factorGreater,
 		    adjacentVertexNotInOther);
     
-    delete swapVertices;    
+    // the vertices belong to the element graph
+    releaseVertices(swapVertices);
+    delete swapVertices;
 
     return 0;
 }
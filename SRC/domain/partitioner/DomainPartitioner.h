@@ -29,6 +29,12 @@
 // Description: This file contains the class definition for DomainPartitioner.
 // A DomainPartitioner is an object used to partition a PartitionedDomain.
 //
+// After the partition, a LoadBalancer can move the elements on the
+// boundaries between the Subdomains with swapVertex(); the element and
+// any node that changes Subdomain are sent with their state. Elements
+// with elemental loads, and elements that would move a node that is
+// constrained or loaded, are not moved.
+//
 // What: "@(#) DomainPartitioner.h, revA"
 
 #ifndef DomainPartitioner_h
@@ -39,6 +45,7 @@
 #endif
 
 #include <ID.h>
+#include <map>
 
 class GraphPartitioner;
 class LoadBalancer;
@@ -103,6 +110,10 @@ class DomainPartitioner
     
     TaggedObjectStorage *theNodeLocations;
     ID *elementPlace;
+    std::map<int, ID> elementNodes;  // the elements may be in other processes
+    ID pinnedElements;               // ordered tags of elements not moved
+    Vector *partitionWeights;        // sum of the vertex weights of each partition
+    int numSwapped;
     int numPartitions;
     ID primes;
     bool partitionFlag;
@@ -947,7 +947,9 @@ LoadPattern::getCopy(void)
   theCopy->loadFactor = loadFactor;
   theCopy->scaleFactor = scaleFactor;
   theCopy->isConstant = isConstant;
-  theCopy->theSeries = theSeries;
+  // each pattern deletes its series
+  if (theSeries != 0)
+    theCopy->theSeries = theSeries->getCopy();
   return theCopy;
 }
 
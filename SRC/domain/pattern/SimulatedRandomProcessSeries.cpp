@@ -45,7 +45,7 @@
 #include <Spectrum.h>
 #include <OpenSeesReliabilityCommands.h>
 
-CStdLibRandGenerator SimulatedRandomProcessSeries::randGenerator;
+PhiloxRandGenerator SimulatedRandomProcessSeries::randGenerator;
 
 void *
 OPS_SimulatedRandomProcessSeries(void)
@@ -124,8 +124,9 @@ SimulatedRandomProcessSeries::SimulatedRandomProcessSeries(int tag,
    theSpectrum(theSpectr), numFreqIntervals(numFreqInt), mean(pmean),
    deltaW(0.0), theta(numFreqInt), A(numFreqInt)
 {
-  //theRandomNumberGenerator = theRandNumGenerator;
-	theRandomNumberGenerator = &randGenerator;
+	theRandomNumberGenerator = theRandNumGenerator;
+	if (theRandomNumberGenerator == 0)
+		theRandomNumberGenerator = &randGenerator;
 	
 	// Generate random numbers, uniformly distributed between 0 and 2pi
 	double pi = 3.14159265358979;
@@ -38,7 +38,7 @@
 #include <TimeSeries.h>
 #include <Spectrum.h>
 #include <RandomNumberGenerator.h>
-#include <CStdLibRandGenerator.h>
+#include <PhiloxRandGenerator.h>
 
 class SimulatedRandomProcessSeries : public TimeSeries
 {
@@ -80,7 +80,7 @@ private:
 	Vector theta;
 	Vector A;
 
-  static CStdLibRandGenerator randGenerator;
+  static PhiloxRandGenerator randGenerator;  // if none is given
 };
 
 #endif
@@ -45,6 +45,7 @@
 
 #if defined(_PARALLEL_PROCESSING) || defined(_PARALLEL_INTERPRETERS)
 #include <mpi.h>
+#include <MPI_Channel.h>
 #endif
 
 #include <limits>   //For std::numeric_limits<double>::epsilon()
@@ -1745,6 +1746,7 @@ void H5DRMLoadPattern::node_matching_BruteForce(double d_tol, const ID & interna
 
 #if defined(_PARALLEL_PROCESSING) || defined(_PARALLEL_INTERPRETERS)
     bool * accounted_for0 = new bool[Nstations];
+    MPI_Channel::flushAll();
     MPI_Reduce(
     accounted_for,
     accounted_for0,
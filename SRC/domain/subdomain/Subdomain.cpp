@@ -59,6 +59,19 @@
 #include <Channel.h>
 #include <FEM_ObjectBroker.h>
 
+#include <chrono>
+
+// the wall clock time of the work done in the subdomain is summed in
+// realCost, getCost() returns the time since it was last invoked
+namespace {
+  typedef std::chrono::steady_clock Clock;
+
+  double elapsed(Clock::time_point start)
+  {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+  }
+}
+
 
 Matrix Subdomain::badResult(1,1); // for returns from getStiff, getMass and getDamp
 
@@ -361,13 +374,19 @@ Subdomain::revertToStart(void)
 int
 Subdomain::update(void)
 {
-  return this->Domain::update();
+  Clock::time_point start = Clock::now();
+  int res = this->Domain::update();
+  realCost += elapsed(start);
+  return res;
 }
 
 int
 Subdomain::update(double newTime, double dT)
 {
-    return this->Domain::update(newTime, dT);
+  Clock::time_point start = Clock::now();
+  int res = this->Domain::update(newTime, dT);
+  realCost += elapsed(start);
+  return res;
 }
 
 void
@@ -684,11 +703,12 @@ int
 Subdomain::computeTang(void)
 {   
   if (theAnalysis != 0) {
-    //    theTimer.start();
+    Clock::time_point start = Clock::now();
     
     int res =0;
     res = theAnalysis->formTangent();
     
+    realCost += elapsed(start);
     return res;
     
   } else {
@@ -704,15 +724,12 @@ int
 Subdomain::computeResidual(void)
 {
   if (theAnalysis != 0) {
-    //    theTimer.start();
+    Clock::time_point start = Clock::now();
     
     int res =0;
     res = theAnalysis->formResidual();
     
-    //theTimer.pause();
-    //    realCost += theTimer.getReal();
-    //    cpuCost += theTimer.getCPU();
-    //    pageCost += theTimer.getNumPageFaults();
+    realCost += elapsed(start);
     
     return res;
     
@@ -793,7 +810,9 @@ Subdomain::computeNodalResponse(void)
 {
     int res =0;
     if (theAnalysis != 0) {
+	Clock::time_point start = Clock::now();
 	res = theAnalysis->computeInternalResponse();
+	realCost += elapsed(start);
 	return res;
     }
     else {
@@ -0,0 +1,385 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation of ThreadedSubdomain.
+
+#include <ThreadedSubdomain.h>
+#include <Element.h>
+#include <ElementIter.h>
+
+#include <algorithm>
+
+std::vector<ThreadedSubdomain *> ThreadedSubdomain::theThreadedSubdomains;
+std::mutex ThreadedSubdomain::notThreadSafeMutex;
+
+ThreadedSubdomain::ThreadedSubdomain(int tag)
+  :Subdomain(tag), done(false), taskError(0),
+   tangPosted(false), residPosted(false), inlineCalls(false),
+   safeStamp(-1), threadSafe(false)
+{
+  theThreadedSubdomains.push_back(this);
+  theWorker = std::thread(&ThreadedSubdomain::runTasks, this);
+}
+
+
+ThreadedSubdomain::~ThreadedSubdomain()
+{
+  // the worker runs the tasks still queued before it returns
+  {
+    std::lock_guard<std::mutex> lock(theMutex);
+    done = true;
+  }
+  taskAdded.notify_one();
+  theWorker.join();
+
+  theThreadedSubdomains.erase(std::remove(theThreadedSubdomains.begin(),
+					  theThreadedSubdomains.end(), this),
+			      theThreadedSubdomains.end());
+}
+
+
+ThreadedSubdomain::InlineScope::InlineScope(ThreadedSubdomain &theSubdomain)
+  :error(0), theSub(theSubdomain), active(false)
+{
+  // a task may invoke the methods, they are then already in the worker
+  if (theSub.onWorker() == true)
+    return;
+
+  error = theSub.wait();
+  theLock = theSub.lockIfNotThreadSafe();
+  theSub.inlineCalls = true;
+  theSub.tangPosted = false;
+  theSub.residPosted = false;
+  active = true;
+}
+
+
+ThreadedSubdomain::InlineScope::~InlineScope()
+{
+  if (active == true)
+    theSub.inlineCalls = false;
+}
+
+
+bool
+ThreadedSubdomain::onWorker(void) const
+{
+  return std::this_thread::get_id() == theWorker.get_id();
+}
+
+
+// std::unique_lock<std::mutex> lockIfNotThreadSafe(void);
+// Returns a lock on the mutex shared by the subdomains with an element
+// that is not thread safe, or an empty lock if all the elements are.
+// The elements are checked again whenever the domain has changed.
+
+std::unique_lock<std::mutex>
+ThreadedSubdomain::lockIfNotThreadSafe(void)
+{
+  int stamp = this->hasDomainChanged();
+  if (stamp != safeStamp) {
+    threadSafe = true;
+    Element *theEle;
+    ElementIter &theEles = this->getElements();
+    while ((theEle = theEles()) != 0)
+      if (theEle->isThreadSafe() == false)
+	threadSafe = false;
+    safeStamp = stamp;
+  }
+
+  std::unique_lock<std::mutex> lock(notThreadSafeMutex, std::defer_lock);
+  if (threadSafe == false)
+    lock.lock();
+  return lock;
+}
+
+
+// int post(int type, double time, double deltaT);
+// Queues a task for the worker. A task posted by a task, or while the
+// calling thread runs the methods of the base classes, is run at once.
+
+int
+ThreadedSubdomain::post(int type, double time, double deltaT)
+{
+  Task theTask = {type, time, deltaT};
+  if (this->onWorker() == true || inlineCalls == true)
+    return this->runTask(theTask);
+
+  // a change of state leaves any tangent or residual queued stale
+  if (type != TANG && type != RESIDUAL) {
+    tangPosted = false;
+    residPosted = false;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(theMutex);
+    theTasks.push_back(theTask);
+  }
+  taskAdded.notify_one();
+  return 0;
+}
+
+
+// int wait(void);
+// Waits until the worker has run all the queued tasks and returns the
+// first error of those tasks.
+
+int
+ThreadedSubdomain::wait(void)
+{
+  std::unique_lock<std::mutex> lock(theMutex);
+  taskDone.wait(lock, [this] {return theTasks.empty() == true;});
+  int res = taskError;
+  taskError = 0;
+  return res;
+}
+
+
+int
+ThreadedSubdomain::runTask(const Task &theTask)
+{
+  switch (theTask.type) {
+  case TANG:
+    return this->Subdomain::computeTang();
+  case RESIDUAL:
+    return this->Subdomain::computeResidual();
+  case NODAL_RESPONSE:
+    return this->Subdomain::computeNodalResponse();
+  case UPDATE:
+    return this->Subdomain::update();
+  case UPDATE_TIME:
+    return this->Subdomain::update(theTask.time, theTask.deltaT);
+  default:
+    return -1;
+  }
+}
+
+
+// void runTasks(void);
+// The worker thread, runs the tasks in the order they were queued. A
+// task stays in the queue while it is run, so wait() returns only once
+// it is done.
+
+void
+ThreadedSubdomain::runTasks(void)
+{
+  updatesGlobals = false;
+
+  std::unique_lock<std::mutex> lock(theMutex);
+  while (true) {
+    taskAdded.wait(lock, [this] {return theTasks.empty() == false || done == true;});
+    if (theTasks.empty() == true)
+      break;
+
+    Task theTask = theTasks.front();
+    lock.unlock();
+
+    int res;
+    {
+      std::unique_lock<std::mutex> serialLock = this->lockIfNotThreadSafe();
+      res = this->runTask(theTask);
+    }
+
+    lock.lock();
+    theTasks.pop_front();
+    if (res != 0 && taskError == 0)
+      taskError = res;
+    taskDone.notify_all();
+  }
+}
+
+
+void
+ThreadedSubdomain::clearAll(void)
+{
+  InlineScope theScope(*this);
+  this->Subdomain::clearAll();
+}
+
+
+int
+ThreadedSubdomain::commit(void)
+{
+  InlineScope theScope(*this);
+  int res = this->Subdomain::commit();
+  return (theScope.error != 0) ? theScope.error : res;
+}
+
+
+int
+ThreadedSubdomain::revertToLastCommit(void)
+{
+  InlineScope theScope(*this);
+  int res = this->Subdomain::revertToLastCommit();
+  return (theScope.error != 0) ? theScope.error : res;
+}
+
+
+int
+ThreadedSubdomain::revertToStart(void)
+{
+  InlineScope theScope(*this);
+  int res = this->Subdomain::revertToStart();
+  return (theScope.error != 0) ? theScope.error : res;
+}
+
+
+int
+ThreadedSubdomain::update(void)
+{
+  return this->post(UPDATE);
+}
+
+
+int
+ThreadedSubdomain::update(double newTime, double dT)
+{
+  return this->post(UPDATE_TIME, newTime, dT);
+}
+
+
+void
+ThreadedSubdomain::applyLoad(double pseudoTime)
+{
+  InlineScope theScope(*this);
+  this->Subdomain::applyLoad(pseudoTime);
+}
+
+
+int
+ThreadedSubdomain::barrierCheckIN(void)
+{
+  int res = this->wait();
+  if (res != 0)
+    opserr << "ThreadedSubdomain::barrierCheckIN() - subdomain " << this->getTag() << " failed in update\n";
+  return res;
+}
+
+
+void
+ThreadedSubdomain::wipeAnalysis(void)
+{
+  InlineScope theScope(*this);
+  this->Subdomain::wipeAnalysis();
+}
+
+
+int
+ThreadedSubdomain::invokeChangeOnAnalysis(void)
+{
+  InlineScope theScope(*this);
+  return this->Subdomain::invokeChangeOnAnalysis();
+}
+
+
+int
+ThreadedSubdomain::getNumDOF(void)
+{
+  InlineScope theScope(*this);
+  return this->Subdomain::getNumDOF();
+}
+
+
+const Vector &
+ThreadedSubdomain::getResistingForce(void)
+{
+  InlineScope theScope(*this);
+  if (theScope.error != 0)
+    opserr << "WARNING ThreadedSubdomain::getResistingForce() - subdomain " << this->getTag() << " failed to form its residual\n";
+  return this->Subdomain::getResistingForce();
+}
+
+
+// int computeTang(void);
+// Queues the forming and condensing of the tangent of all the
+// ThreadedSubdomains of the domain that have not yet been asked to, as
+// their getTang() follows.
+
+int
+ThreadedSubdomain::computeTang(void)
+{
+  if (this->onWorker() == true || inlineCalls == true)
+    return this->Subdomain::computeTang();
+
+  Domain *theDomain = this->getDomain();
+  for (size_t i = 0; i < theThreadedSubdomains.size(); i++) {
+    ThreadedSubdomain *theSub = theThreadedSubdomains[i];
+    if (theSub->tangPosted == false &&
+	(theSub == this || (theDomain != 0 && theSub->getDomain() == theDomain))) {
+      theSub->post(TANG);
+      theSub->tangPosted = true;
+    }
+  }
+
+  return 0;
+}
+
+
+int
+ThreadedSubdomain::computeResidual(void)
+{
+  if (this->onWorker() == true || inlineCalls == true)
+    return this->Subdomain::computeResidual();
+
+  Domain *theDomain = this->getDomain();
+  for (size_t i = 0; i < theThreadedSubdomains.size(); i++) {
+    ThreadedSubdomain *theSub = theThreadedSubdomains[i];
+    if (theSub->residPosted == false &&
+	(theSub == this || (theDomain != 0 && theSub->getDomain() == theDomain))) {
+      theSub->post(RESIDUAL);
+      theSub->residPosted = true;
+    }
+  }
+
+  return 0;
+}
+
+
+const Matrix &
+ThreadedSubdomain::getTang(void)
+{
+  InlineScope theScope(*this);
+  if (theScope.error != 0)
+    opserr << "WARNING ThreadedSubdomain::getTang() - subdomain " << this->getTag() << " failed to form its tangent\n";
+  return this->Subdomain::getTang();
+}
+
+
+int
+ThreadedSubdomain::computeNodalResponse(void)
+{
+  return this->post(NODAL_RESPONSE);
+}
+
+
+int
+ThreadedSubdomain::analysisStep(double dT)
+{
+  InlineScope theScope(*this);
+  return this->Subdomain::analysisStep(dT);
+}
+
+
+int
+ThreadedSubdomain::eigenAnalysis(int numMode, bool generalized, bool findSmallest)
+{
+  InlineScope theScope(*this);
+  return this->Subdomain::eigenAnalysis(numMode, generalized, findSmallest);
+}
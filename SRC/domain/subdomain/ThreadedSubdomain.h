@@ -0,0 +1,137 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef ThreadedSubdomain_h
+#define ThreadedSubdomain_h
+
+// Description: This file contains the class definition for
+// ThreadedSubdomain. A ThreadedSubdomain is a Subdomain whose state
+// determination and static condensation are done by a worker thread of
+// its own, so that the subdomains of a PartitionedDomain are worked on
+// concurrently in one process, as the ShadowSubdomains are by the
+// processes of a parallel run but without sending the data through
+// Channels. The condensed tangent and residual are read directly from
+// the DomainDecompositionAnalysis of the subdomain, which, as for a
+// Subdomain, is to be created with analysis objects of its own.
+//
+// computeTang(), computeResidual(), computeNodalResponse() and update()
+// only queue the work. The first computeTang() or computeResidual() of a
+// round queues the work for all the ThreadedSubdomains of the same
+// PartitionedDomain, as the FE_Elements ask for the tangent of one
+// subdomain right after the other. getTang(), getResistingForce() and
+// barrierCheckIN(), which PartitionedDomain::update() invokes, wait for
+// the queued work and return any error; the other methods that use the
+// state of the subdomain wait and then run in the calling thread.
+//
+// The subdomains share no nodes, the external nodes being copies, but
+// the elements of different subdomains may share class-wide storage. A
+// subdomain with an element that is not isThreadSafe() does its work
+// holding a lock shared by all such subdomains. The workers leave the
+// globals ops_Dt and ops_TheActiveDomain as set by the main thread and
+// keep an ops_TheActiveElement of their own.
+
+#include <Subdomain.h>
+
+#include <deque>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+class ThreadedSubdomain: public Subdomain
+{
+  public:
+    ThreadedSubdomain(int tag);
+    ~ThreadedSubdomain();
+
+    void clearAll(void);
+
+    int commit(void);
+    int revertToLastCommit(void);
+    int revertToStart(void);
+    int update(void);
+    int update(double newTime, double dT);
+    void applyLoad(double pseudoTime);
+
+    int barrierCheckIN(void);
+
+    void wipeAnalysis(void);
+    int invokeChangeOnAnalysis(void);
+
+    int getNumDOF(void);
+    const Vector &getResistingForce(void);
+
+    int computeTang(void);
+    int computeResidual(void);
+    const Matrix &getTang(void);
+
+    int computeNodalResponse(void);
+    int analysisStep(double deltaT);
+    int eigenAnalysis(int numMode, bool generalized, bool findSmallest);
+
+  private:
+    enum {TANG, RESIDUAL, NODAL_RESPONSE, UPDATE, UPDATE_TIME};
+
+    // waits for the queued tasks and has the methods of the base classes
+    // invoked in its lifetime run in the calling thread
+    class InlineScope {
+      public:
+        InlineScope(ThreadedSubdomain &theSubdomain);
+        ~InlineScope();
+        int error;              // of the tasks waited for
+      private:
+        ThreadedSubdomain &theSub;
+        bool active;
+        std::unique_lock<std::mutex> theLock;
+    };
+
+    struct Task {
+      int type;
+      double time;
+      double deltaT;
+    };
+
+    int post(int type, double time = 0.0, double deltaT = 0.0);
+    int wait(void);
+    int runTask(const Task &theTask);
+    void runTasks(void);
+    bool onWorker(void) const;
+    std::unique_lock<std::mutex> lockIfNotThreadSafe(void);
+
+    std::deque<Task> theTasks;  // the task being run stays at the front
+    bool done;
+    int taskError;              // first error since the last wait()
+    bool tangPosted;            // computeTang() queued but not yet read
+    bool residPosted;
+    bool inlineCalls;           // the main thread is running the methods
+
+    int safeStamp;              // domain stamp when threadSafe was set
+    bool threadSafe;
+
+    std::mutex theMutex;
+    std::condition_variable taskAdded;
+    std::condition_variable taskDone;
+    std::thread theWorker;
+
+    static std::vector<ThreadedSubdomain *> theThreadedSubdomains;
+    static std::mutex notThreadSafeMutex;
+};
+
+#endif
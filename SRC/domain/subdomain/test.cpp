@@ -0,0 +1,341 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: domain decomposition test. A pushover of a small frame of
+// force based fiber elements is run in a Domain and, split into three
+// Subdomains by column lines, in a PartitionedDomain whose Subdomains are
+// statically condensed by a DomainDecompositionAnalysis of their own. The
+// nodal displacements of the partitioned runs, with Subdomains and with
+// ThreadedSubdomains, are compared with those of the Domain. A last run
+// with Subdomains moves elements between them after the frame has
+// yielded, as load balancing does, and must give the same displacements,
+// e.g.
+//
+//      make test; ./test
+
+#include <Domain.h>
+#include <PartitionedDomain.h>
+#include <DomainPartitioner.h>
+#include <GraphPartitioner.h>
+#include <Subdomain.h>
+#include <SubdomainIter.h>
+#include <ThreadedSubdomain.h>
+#include <Graph.h>
+#include <Vertex.h>
+#include <VertexIter.h>
+#include <Node.h>
+#include <NodeIter.h>
+#include <SP_Constraint.h>
+#include <NodalLoad.h>
+#include <LoadPattern.h>
+#include <LinearSeries.h>
+#include <Steel01.h>
+#include <UniaxialFiber2d.h>
+#include <FiberSection2d.h>
+#include <LobattoBeamIntegration.h>
+#include <PDeltaCrdTransf2d.h>
+#include <ForceBeamColumn2d.h>
+
+#include <StaticAnalysis.h>
+#include <DomainDecompositionAnalysis.h>
+#include <AnalysisModel.h>
+#include <PlainHandler.h>
+#include <DOF_Numberer.h>
+#include <RCM.h>
+#include <NewtonRaphson.h>
+#include <DomainDecompAlgo.h>
+#include <LoadControl.h>
+#include <CTestNormDispIncr.h>
+#include <ProfileSPDLinSOE.h>
+#include <ProfileSPDLinDirectSolver.h>
+#include <ProfileSPDLinSubstrSolver.h>
+
+#include <OPS_Globals.h>
+#include <StandardStream.h>
+
+#include <math.h>
+#include <map>
+
+StandardStream sserr;
+OPS_Stream *opserrPtr = &sserr;
+
+static const int numBays = 4;
+static const int numStories = 6;
+static const int numSubdomains = 3;
+static const int numSteps = 10;
+
+static int
+nodeTag(int line, int floor)
+{
+  return 100*floor + line + 1;
+}
+
+// elements are numbered by the column line they are on or start from
+static int
+columnLine(int eleTag)
+{
+  return eleTag < 1000 ? (eleTag-1)/numStories : (eleTag-1000)%numBays;
+}
+
+// colors the elements by column line, which the graph partitioners
+// shipped with OpenSees do not do predictably
+class ColumnLinePartitioner: public GraphPartitioner
+{
+  public:
+    int partition(Graph &theGraph, int numPart) {
+      VertexIter &theVertices = theGraph.getVertices();
+      Vertex *vertexPtr;
+      while ((vertexPtr = theVertices()) != 0)
+	vertexPtr->setColor(1 + columnLine(vertexPtr->getRef())*numPart/(numBays+1));
+      return 0;
+    }
+};
+
+// a frame of steel columns and beams pushed sideways past yield under
+// gravity loads, the loads are on the exterior columns only
+static void
+buildFrame(Domain &theDomain)
+{
+  for (int floor = 0; floor <= numStories; floor++)
+    for (int line = 0; line <= numBays; line++)
+      theDomain.addNode(new Node(nodeTag(line, floor), 3, 240.0*line, 144.0*floor));
+
+  for (int line = 0; line <= numBays; line++)
+    for (int dof = 0; dof < 3; dof++)
+      theDomain.addSP_Constraint(new SP_Constraint(nodeTag(line, 0), dof, 0.0, true));
+
+  Steel01 theSteel(1, 50.0, 29000.0, 0.02);
+  const int numFibers = 8;
+  Fiber *theFibers[numFibers];
+  for (int i = 0; i < numFibers; i++)
+    theFibers[i] = new UniaxialFiber2d(i+1, theSteel, 6.0, -10.5 + 3.0*i);
+  FiberSection2d theSection(1, numFibers, theFibers);
+  for (int i = 0; i < numFibers; i++)
+    delete theFibers[i];
+
+  SectionForceDeformation *theSections[4];
+  for (int i = 0; i < 4; i++)
+    theSections[i] = &theSection;
+  LobattoBeamIntegration theIntegration;
+  PDeltaCrdTransf2d theColumnTransf(1);
+  PDeltaCrdTransf2d theBeamTransf(2);
+
+  for (int line = 0; line <= numBays; line++)
+    for (int floor = 0; floor < numStories; floor++)
+      theDomain.addElement(new ForceBeamColumn2d(1 + line*numStories + floor,
+						 nodeTag(line, floor), nodeTag(line, floor+1),
+						 4, theSections, theIntegration, theColumnTransf));
+  for (int floor = 1; floor <= numStories; floor++)
+    for (int line = 0; line < numBays; line++)
+      theDomain.addElement(new ForceBeamColumn2d(1000 + (floor-1)*numBays + line,
+						 nodeTag(line, floor), nodeTag(line+1, floor),
+						 4, theSections, theIntegration, theBeamTransf));
+
+  LoadPattern *thePattern = new LoadPattern(1);
+  thePattern->setTimeSeries(new LinearSeries());
+  theDomain.addLoadPattern(thePattern);
+  Vector P(3);
+  int loadTag = 1;
+  for (int floor = 1; floor <= numStories; floor++)
+    for (int line = 0; line <= numBays; line += numBays) {
+      P(0) = 120.0*floor/numStories;
+      P(1) = -50.0;
+      theDomain.addNodalLoad(new NodalLoad(loadTag++, nodeTag(line, floor), P), 1);
+    }
+}
+
+// moves the elements on the boundary of the second Subdomain with the
+// first to the first, returns the number of elements moved
+static int
+migrate(PartitionedDomain &theDomain, DomainPartitioner &theDomainPartitioner)
+{
+  int numElements = theDomain.getSubdomainPtr(1)->getNumElements();
+  theDomainPartitioner.swapBoundary(2, 1, false);
+
+  // as DomainPartitioner::balance() does
+  SubdomainIter &theSubdomains = theDomain.getSubdomains();
+  Subdomain *theSub;
+  while ((theSub = theSubdomains()) != 0) {
+    theSub->domainChange();
+    theSub->invokeChangeOnAnalysis();
+  }
+  theDomain.domainChange();
+
+  return theDomain.getSubdomainPtr(1)->getNumElements() - numElements;
+}
+
+// with a DomainPartitioner, the Subdomains are migrated after 8 of the 10
+// steps, when the frame has yielded
+static int
+pushover(Domain &theDomain, std::map<int, Vector> &theDisplacements,
+	 DomainPartitioner *theMigrator = 0)
+{
+  // the numberer and the system of equations delete the objects they
+  // are given
+  PlainHandler theHandler;
+  DOF_Numberer theNumberer(*(new RCM()));
+  AnalysisModel theModel;
+  CTestNormDispIncr theTest(1.0e-12, 25, 0);
+  NewtonRaphson theAlgorithm;
+  ProfileSPDLinSOE theSOE(*(new ProfileSPDLinDirectSolver()));
+  LoadControl theIntegrator(1.0/numSteps, 1, 1.0/numSteps, 1.0/numSteps);
+
+  StaticAnalysis theAnalysis(theDomain, theHandler, theNumberer, theModel,
+			     theAlgorithm, theSOE, theIntegrator, &theTest);
+
+  int res = theAnalysis.analyze(numSteps - 2);
+
+  if (res >= 0 && theMigrator != 0) {
+    int numMoved = migrate((PartitionedDomain &)theDomain, *theMigrator);
+    opserr << "migrated " << numMoved << " elements\n";
+    if (numMoved <= 0)
+      res = -1;
+  }
+
+  if (res >= 0)
+    res = theAnalysis.analyze(2);
+
+  NodeIter &theNodes = theDomain.getNodes();
+  Node *nodePtr;
+  while ((nodePtr = theNodes()) != 0)
+    theDisplacements[nodePtr->getTag()] = nodePtr->getDisp();
+
+  return res;
+}
+
+// gives each Subdomain the objects of its own analysis, which condenses
+// it to its external nodes, and numbers its equations
+static void
+setSubdomainAnalyses(PartitionedDomain &theDomain)
+{
+  for (int i = 1; i <= numSubdomains; i++) {
+    Subdomain *theSub = theDomain.getSubdomainPtr(i);
+    ProfileSPDLinSubstrSolver *theSolver = new ProfileSPDLinSubstrSolver();
+    new DomainDecompositionAnalysis(*theSub,
+				    *(new PlainHandler()),
+				    *(new DOF_Numberer(*(new RCM()))),
+				    *(new AnalysisModel()),
+				    *(new DomainDecompAlgo()),
+				    *(new LoadControl(1.0/numSteps, 1, 1.0/numSteps, 1.0/numSteps)),
+				    *(new ProfileSPDLinSOE(*theSolver)),
+				    *theSolver,
+				    0);
+    theSub->invokeChangeOnAnalysis();
+  }
+}
+
+// the largest difference of the displacements relative to the largest
+// displacement of the reference
+static double
+compare(std::map<int, Vector> &theDisplacements, std::map<int, Vector> &theReference)
+{
+  double maxDisp = 0.0;
+  double maxDiff = 0.0;
+  for (std::map<int, Vector>::iterator it = theReference.begin(); it != theReference.end(); it++) {
+    const Vector &ref = it->second;
+    std::map<int, Vector>::iterator other = theDisplacements.find(it->first);
+    for (int i = 0; i < ref.Size(); i++) {
+      maxDisp = fmax(maxDisp, fabs(ref(i)));
+      if (other == theDisplacements.end() || other->second.Size() != ref.Size())
+	maxDiff = 1.0e30;
+      else
+	maxDiff = fmax(maxDiff, fabs(other->second(i) - ref(i)));
+    }
+  }
+  return maxDiff/maxDisp;
+}
+
+static int
+partitionedPushover(bool threaded, bool migrated, std::map<int, Vector> &theDisplacements)
+{
+  ColumnLinePartitioner thePartitioner;
+  DomainPartitioner theDomainPartitioner(thePartitioner);
+  PartitionedDomain theDomain(theDomainPartitioner);
+  buildFrame(theDomain);
+
+  for (int i = 1; i <= numSubdomains; i++) {
+    Subdomain *theSub;
+    if (threaded)
+      theSub = new ThreadedSubdomain(i);
+    else
+      theSub = new Subdomain(i);
+    theDomain.addSubdomain(theSub);
+  }
+
+  if (theDomain.partition(numSubdomains) < 0) {
+    opserr << "partition failed\n";
+    return -1;
+  }
+  setSubdomainAnalyses(theDomain);
+
+  int res = pushover(theDomain, theDisplacements, migrated ? &theDomainPartitioner : 0);
+
+  // the internal nodes are held by the Subdomains
+  for (int i = 1; i <= numSubdomains; i++) {
+    NodeIter &theNodes = theDomain.getSubdomainPtr(i)->getNodes();
+    Node *nodePtr;
+    while ((nodePtr = theNodes()) != 0)
+      theDisplacements[nodePtr->getTag()] = nodePtr->getDisp();
+  }
+
+  return res;
+}
+
+int main(int argc, char **argv)
+{
+  int numErrors = 0;
+  const double tol = 1.0e-9;
+
+  std::map<int, Vector> theReference;
+  {
+    Domain theDomain;
+    buildFrame(theDomain);
+    if (pushover(theDomain, theReference) < 0) {
+      opserr << "FAILED: analysis of the Domain\n";
+      return 1;
+    }
+  }
+  opserr << "Domain: roof displacement " << theReference[nodeTag(0, numStories)](0) << endln;
+
+  // the migrated run is also checked against the unmigrated one
+  const char *names[] = {"Subdomain", "ThreadedSubdomain", "migrated Subdomain"};
+  std::map<int, Vector> theUnmigrated;
+  for (int run = 0; run < 3; run++) {
+    std::map<int, Vector> theDisplacements;
+    int res = partitionedPushover(run == 1, run == 2, theDisplacements);
+    double diff = compare(theDisplacements, theReference);
+    if (run == 0)
+      theUnmigrated = theDisplacements;
+    else if (run == 2)
+      diff = fmax(diff, compare(theDisplacements, theUnmigrated));
+    opserr << names[run] << ": roof displacement "
+	   << theDisplacements[nodeTag(0, numStories)](0)
+	   << ", largest relative difference " << diff << endln;
+    if (res < 0 || diff > tol) {
+      opserr << "FAILED: " << names[run] << endln;
+      numErrors++;
+    }
+  }
+
+  if (numErrors == 0)
+    opserr << "PASSED: partitioned analyses agree with the Domain\n";
+
+  return numErrors == 0 ? 0 : 1;
+}
@@ -43,13 +43,56 @@
 #include <Matrix.h>
 #include <Node.h>
 #include <Domain.h>
-
-Element  *ops_TheActiveElement = 0;
-
-Matrix **Element::theMatrices; 
-Vector **Element::theVectors1; 
-Vector **Element::theVectors2; 
-int  Element::numMatrices(0);
+#include <chrono>
+#include <vector>
+
+thread_local Element *ops_TheActiveElement = 0;
+
+bool Element::measureCosts(false);
+
+// the matrix and vectors used by the default damping, mass, inertia and
+// sensitivity methods; one set per size and thread so that elements can
+// be used concurrently during a parallel assembly
+namespace {
+  struct WorkObjects {
+    Matrix *theMatrix;
+    Vector *theVector1;
+    Vector *theVector2;
+  };
+
+  class ElementWorkArea {
+  public:
+    ~ElementWorkArea() {
+      for (size_t i=0; i<theObjects.size(); i++) {
+	if (theObjects[i].theMatrix != 0) {
+	  delete theObjects[i].theMatrix;
+	  delete theObjects[i].theVector1;
+	  delete theObjects[i].theVector2;
+	}
+      }
+    }
+    std::vector<WorkObjects> theObjects; // indexed by the number of dof
+  };
+
+  thread_local ElementWorkArea theWorkArea;
+
+  WorkObjects &
+  getWorkObjects(int numDOF)
+  {
+    std::vector<WorkObjects> &theObjects = theWorkArea.theObjects;
+    if ((int)theObjects.size() <= numDOF) {
+      WorkObjects none = {0, 0, 0};
+      theObjects.resize(numDOF+1, none);
+    }
+    WorkObjects &theWork = theObjects[numDOF];
+    if (theWork.theMatrix == 0) {
+      theWork.theMatrix = new Matrix(numDOF, numDOF);
+      theWork.theVector1 = new Vector(numDOF);
+      theWork.theVector2 = new Vector(numDOF);
+    }
+    return theWork;
+  }
+}
 
 // Element(int tag, int noExtNodes);
 // 	constructor that takes the element's unique tag and the number
@@ -58,8 +101,8 @@ int  Element::numMatrices(0);
 Element::Element(int tag, int cTag) 
   :DomainComponent(tag, cTag), alphaM(0.0), 
   betaK(0.0), betaK0(0.0), betaKc(0.0), 
-      Kc(0), previousK(0), numPreviousK(0), index(-1), nodeIndex(-1),
-      is_this_element_active(true)
+      Kc(0), previousK(0), numPreviousK(0), nodeIndex(-1),
+      is_this_element_active(true), theCost(0)
 {
   // does nothing
   ops_TheActiveElement = this;
@@ -75,6 +118,9 @@ Element::~Element()
       delete previousK[i];
     delete [] previousK;
   }
+
+  if (theCost != 0)
+    delete theCost;
 }
 
 int
@@ -120,68 +166,6 @@ Element::setRayleighDampingFactors(double alpham, double betak, double betak0, d
   betaK0 = betak0;
   betaKc = betakc;
 
-  // check that memory has been allocated to store compute/return
-  // damping matrix & residual force calculations
-  if (index == -1) {
-    int numDOF = this->getNumDOF();
-
-    for (int i=0; i<numMatrices; i++) {
-      Matrix *aMatrix = theMatrices[i];
-      if (aMatrix->noRows() == numDOF) {
-	index = i;
-	i = numMatrices;
-      }
-    }
-    if (index == -1) {
-      Matrix **nextMatrices = new Matrix *[numMatrices+1];
-      if (nextMatrices == 0) {
-	opserr << "Element::getTheMatrix - out of memory\n";
-      }
-	  int j;
-      for (j=0; j<numMatrices; j++)
-	nextMatrices[j] = theMatrices[j];
-      Matrix *theMatrix = new Matrix(numDOF, numDOF);
-      if (theMatrix == 0) {
-	opserr << "Element::getTheMatrix - out of memory\n";
-	exit(-1);
-      }
-      nextMatrices[numMatrices] = theMatrix;
-
-      Vector **nextVectors1 = new Vector *[numMatrices+1];
-      Vector **nextVectors2 = new Vector *[numMatrices+1];
-      if (nextVectors1 == 0 || nextVectors2 == 0) {
-	opserr << "Element::getTheVector - out of memory\n";
-	exit(-1);
-      }
-
-      for (j=0; j<numMatrices; j++) {
-	nextVectors1[j] = theVectors1[j];
-	nextVectors2[j] = theVectors2[j];
-      }
-	
-      Vector *theVector1 = new Vector(numDOF);
-      Vector *theVector2 = new Vector(numDOF);
-      if (theVector1 == 0 || theVector2 == 0) {
-	opserr << "Element::getTheVector - out of memory\n";
-	exit(-1);
-      }
-
-      nextVectors1[numMatrices] = theVector1;
-      nextVectors2[numMatrices] = theVector2;
-
-      if (numMatrices != 0) {
-	delete [] theMatrices;
-	delete [] theVectors1;
-	delete [] theVectors2;
-      }
-      index = numMatrices;
-      numMatrices++;
-      theMatrices = nextMatrices;
-      theVectors1 = nextVectors1;
-      theVectors2 = nextVectors2;
-    }
-  }
-
   // if need storage for Kc go get it
   if (betaKc != 0.0) {  
     if (Kc == 0) 
@@ -210,12 +194,9 @@ Element::setDamping(Domain *theDomain, Damping *theDamping)
 const Matrix &
 Element::getDamp(void) 
 {
-  if (index  == -1) {
-    this->setRayleighDampingFactors(alphaM, betaK, betaK0, betaKc);
-  }
 
   // now compute the damping matrix
-  Matrix *theMatrix = theMatrices[index]; 
+  Matrix *theMatrix = getWorkObjects(this->getNumDOF()).theMatrix; 
   theMatrix->Zero();
   if (alphaM != 0.0)
     theMatrix->addMatrix(0.0, this->getMass(), alphaM);
@@ -235,12 +216,9 @@ Element::getDamp(void)
 const Matrix &
 Element::getMass(void)
 {
-  if (index  == -1) {
-    this->setRayleighDampingFactors(alphaM, betaK, betaK0, betaKc);
-  }
 
   // zero the matrix & return it
-  Matrix *theMatrix = theMatrices[index]; 
+  Matrix *theMatrix = getWorkObjects(this->getNumDOF()).theMatrix; 
   theMatrix->Zero();
   return *theMatrix;
 }
@@ -248,13 +226,11 @@ Element::getMass(void)
 const Vector &
 Element::getResistingForceIncInertia(void) 
 {
-  if (index == -1) {
-    this->setRayleighDampingFactors(alphaM, betaK, betaK0, betaKc);
-  }
 
-  Matrix *theMatrix = theMatrices[index]; 
-  Vector *theVector = theVectors2[index];
-  Vector *theVector2 = theVectors1[index];
+  WorkObjects &theWork = getWorkObjects(this->getNumDOF());
+  Matrix *theMatrix = theWork.theMatrix;
+  Vector *theVector = theWork.theVector2;
+  Vector *theVector2 = theWork.theVector1;
 
   //
   // perform: R = P(U) - Pext(t);
@@ -315,13 +291,11 @@ const Vector &
 Element::getRayleighDampingForces(void) 
 {
 
-  if (index == -1) {
-    this->setRayleighDampingFactors(alphaM, betaK, betaK0, betaKc);
-  }
 
-  Matrix *theMatrix = theMatrices[index]; 
-  Vector *theVector = theVectors2[index];
-  Vector *theVector2 = theVectors1[index];
+  WorkObjects &theWork = getWorkObjects(this->getNumDOF());
+  Matrix *theMatrix = theWork.theMatrix;
+  Vector *theVector = theWork.theVector2;
+  Vector *theVector2 = theWork.theVector1;
 
   //
   // perform: R = (alphaM * M + betaK0 * K0 + betaK * K) * v
@@ -415,6 +389,65 @@ Element::isSubdomain(void)
     return false;
 }
 
+// isThreadSafe() - returns true only if update(), getTangentStiff() and
+// getResistingForce() of different objects of the class may be invoked
+// concurrently, i.e. the element and anything it calls use no class-wide
+// work storage. The default is false.
+bool
+Element::isThreadSafe(void)
+{
+    return false;
+}
+
+void
+Element::setMeasureCosts(bool measure)
+{
+  measureCosts = measure;
+}
+
+int
+Element::measureUpdate(void)
+{
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  int res = this->update();
+  double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  if (theCost == 0)
+    theCost = new ElementCost();  // zero initialized
+  theCost->numUpdates++;
+  theCost->updateTime += time;
+  theCost->numIterations += this->getNumIterations();
+
+  return res;
+}
+
+void
+Element::addTangentCost(double time)
+{
+  if (theCost == 0)
+    theCost = new ElementCost();  // zero initialized
+  theCost->numTangents++;
+  theCost->tangentTime += time;
+}
+
+int
+Element::getNumIterations(void)
+{
+  return 0;
+}
+
+void
+Element::resetCost(void)
+{
+  if (theCost == 0)
+    return;
+  theCost->numUpdates = 0;
+  theCost->updateTime = 0.0;
+  theCost->numTangents = 0;
+  theCost->tangentTime = 0.0;
+  theCost->numIterations = 0;
+}
+
 Response*
 Element::setResponse(const char **argv, int argc, OPS_Stream &output)
 {
@@ -508,11 +541,8 @@ Element::getResponseSensitivity(int responseID, int gradIndex,
 const Vector &
 Element::getResistingForceSensitivity(int gradIndex)
 {
-  if (index == -1) {
-    this->setRayleighDampingFactors(alphaM, betaK, betaK0, betaKc);
-  }
 
-  Vector *theVector = theVectors1[index];
+  Vector *theVector = getWorkObjects(this->getNumDOF()).theVector1;
   theVector->Zero();
 
   return *theVector;
@@ -521,9 +551,6 @@ Element::getResistingForceSensitivity(int gradIndex)
 const Matrix &
 Element::getTangentStiffSensitivity(int gradIndex)
 {
-  if (index == -1) {
-    this->setRayleighDampingFactors(alphaM, betaK, betaK0, betaKc);
-  }
 
   static bool warningShown = false;
   if (!warningShown) {
@@ -531,7 +558,7 @@ Element::getTangentStiffSensitivity(int gradIndex)
     warningShown = true;
   }
 
-  Matrix *theMatrix = theMatrices[index];
+  Matrix *theMatrix = getWorkObjects(this->getNumDOF()).theMatrix;
   theMatrix->Zero();
 
   return *theMatrix;
@@ -541,9 +568,6 @@ const Matrix &
 
 Element::getInitialStiffSensitivity(int gradIndex)
 {
-  if (index == -1) {
-    this->setRayleighDampingFactors(alphaM, betaK, betaK0, betaKc);
-  }
 
   static bool warningShown = false;
   if (!warningShown) {
@@ -551,7 +575,7 @@ Element::getInitialStiffSensitivity(int gradIndex)
     warningShown = true;
   }
 
-  Matrix *theMatrix = theMatrices[index];
+  Matrix *theMatrix = getWorkObjects(this->getNumDOF()).theMatrix;
   theMatrix->Zero();
 
   return *theMatrix;
@@ -560,9 +584,6 @@ Element::getInitialStiffSensitivity(int gradIndex)
 const Matrix &
 Element::getCommittedStiffSensitivity(int gradIndex)
 {
-  if (index == -1) {
-    this->setRayleighDampingFactors(alphaM, betaK, betaK0, betaKc);
-  }
 
   static bool warningShown = false;
   if (!warningShown) {
@@ -570,7 +591,7 @@ Element::getCommittedStiffSensitivity(int gradIndex)
     warningShown = true;
   }
 
-  Matrix *theMatrix = theMatrices[index];
+  Matrix *theMatrix = getWorkObjects(this->getNumDOF()).theMatrix;
   theMatrix->Zero();
 
   return *theMatrix;
@@ -579,11 +600,8 @@ Element::getCommittedStiffSensitivity(int gradIndex)
 const Matrix &
 Element::getMassSensitivity(int gradIndex)
 {
-  if (index == -1) {
-    this->setRayleighDampingFactors(alphaM, betaK, betaK0, betaKc);
-  }
 
-  Matrix *theMatrix = theMatrices[index];
+  Matrix *theMatrix = getWorkObjects(this->getNumDOF()).theMatrix;
   theMatrix->Zero();
 
   return *theMatrix;
@@ -609,12 +627,9 @@ Element::addInertiaLoadSensitivityToUnbalance(const Vector &accel, bool tag)
 const Matrix &
 Element::getDampSensitivity(int gradIndex) 
 {
-  if (index  == -1) {
-    this->setRayleighDampingFactors(alphaM, betaK, betaK0, betaKc);
-  }
 
   // now compute the damping matrix
-  Matrix *theMatrix = theMatrices[index]; 
+  Matrix *theMatrix = getWorkObjects(this->getNumDOF()).theMatrix; 
   theMatrix->Zero();
   if (alphaM != 0.0) {
     theMatrix->addMatrix(0.0, this->getMassSensitivity(gradIndex), alphaM);
@@ -769,11 +784,8 @@ Element::displaySelf(Renderer &, int mode, float fact, const char **displayModes
 const Matrix &
 Element::getGeometricTangentStiff()
 {
-    if (index == -1) {
-	this->setRayleighDampingFactors(alphaM, betaK, betaK0, betaKc);
-    }
     
-    Matrix *theMatrix = theMatrices[index];
+    Matrix *theMatrix = getWorkObjects(this->getNumDOF()).theMatrix;
     theMatrix->Zero();
     
     return *theMatrix;
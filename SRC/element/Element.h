@@ -48,6 +48,15 @@ class ElementalLoad;
 class Node;
 class Damping;
 
+// the measured cost of an element, see Element::setMeasureCosts()
+struct ElementCost {
+  long numUpdates;
+  double updateTime;         // seconds in update()
+  long numTangents;
+  double tangentTime;        // seconds forming the tangent
+  long numIterations;        // internal iterations, e.g. of force based beams
+};
+
 class Element : public DomainComponent
 {
   public:
@@ -67,6 +76,7 @@ class Element : public DomainComponent
     virtual int revertToStart(void);                
     virtual int update(void);
     virtual bool isSubdomain(void);
+    virtual bool isThreadSafe(void);
     
     // methods to return the current linearized stiffness,
     // damping and mass matrices
@@ -125,6 +135,17 @@ class Element : public DomainComponent
 
     bool isActive();
 
+    // methods for measuring the cost of the elements; while measuring,
+    // the domain updates the elements with measureUpdate() and the
+    // FE_Elements add the time of forming the tangent
+    static void setMeasureCosts(bool measure);
+    static bool measuresCosts(void) {return measureCosts;};
+    int measureUpdate(void);
+    void addTangentCost(double time);
+    virtual int getNumIterations(void);  // internal iterations of the last update()
+    const ElementCost *getMeasuredCost(void) const {return theCost;};
+    void resetCost(void);
+
 
 
 protected:
@@ -136,16 +157,13 @@ protected:
     Matrix **previousK;
     int numPreviousK;
 
-    int index, nodeIndex;
-
-    static Matrix ** theMatrices; 
-    static Vector ** theVectors1; 
-    static Vector ** theVectors2; 
-    static int numMatrices;
+    int nodeIndex;
 
     bool is_this_element_active;
 
   private:
+    ElementCost *theCost;   // 0 until the cost is measured
+    static bool measureCosts;
 };
 
 
@@ -79,14 +79,39 @@ Journal of Structural Engineering, Approved for publication, February 2007.
 #include <ElementalLoad.h>
 #include <ElementIter.h>
 #include <map>
+#include <MatrixND.h>
+#include <VectorND.h>
+
+using OpenSees::MatrixND;
+using OpenSees::VectorND;
+
+thread_local Matrix ForceBeamColumn2d::theMatrix(6,6);
+thread_local Vector ForceBeamColumn2d::theVector(6);
+thread_local double ForceBeamColumn2d::workArea[200];
+
+thread_local Vector ForceBeamColumn2d::vsSubdivide[maxNumSections];
+thread_local Matrix ForceBeamColumn2d::fsSubdivide[maxNumSections];
+thread_local Vector ForceBeamColumn2d::SsrSubdivide[maxNumSections];
+
+// kv = inverse(f) using the same LAPACK solve against the identity as
+// Matrix::Solve(), but on stack storage so the element state
+// determination does not touch the heap or any shared work area
+template <int n>
+static int
+invertFlexibility(const MatrixND<n,n> &f, MatrixND<n,n> &kv)
+{
+  MatrixND<n,n> work = f;
+  kv.zero();
+  kv.addDiagonal(1.0);
 
-Matrix ForceBeamColumn2d::theMatrix(6,6);
-Vector ForceBeamColumn2d::theVector(6);
-double ForceBeamColumn2d::workArea[200];
+  int N = n;
+  int nrhs = n;
+  int iPIV[n];
+  int info = 0;
+  DGESV(&N, &nrhs, work.data(), &N, iPIV, kv.data(), &N, &info);
 
-Vector ForceBeamColumn2d::vsSubdivide[maxNumSections];
-Matrix ForceBeamColumn2d::fsSubdivide[maxNumSections];
-Vector ForceBeamColumn2d::SsrSubdivide[maxNumSections];
+  return -abs(info);
+}
 
 void* OPS_ForceBeamColumn2d()
 {
@@ -677,7 +702,7 @@ OPS_BeamWithHinges(void)
 ForceBeamColumn2d::ForceBeamColumn2d(): 
   Element(0,ELE_TAG_ForceBeamColumn2d), connectedExternalNodes(2), 
   beamIntegr(0), numSections(0), sections(0), crdTransf(0),
-  rho(0.0), maxIters(0), tol(0.0),
+  rho(0.0), maxIters(0), numIterations(0), tol(0.0),
   initialFlag(0),
   kv(NEBD,NEBD), Se(NEBD),
   kvcommit(NEBD,NEBD), Secommit(NEBD),
@@ -704,7 +729,7 @@ ForceBeamColumn2d::ForceBeamColumn2d (int tag, int nodeI, int nodeJ,
 				      Damping *damping):
   Element(tag,ELE_TAG_ForceBeamColumn2d), connectedExternalNodes(2),
   beamIntegr(0), numSections(0), sections(0), crdTransf(0),
-  rho(massDensPerUnitLength),maxIters(maxNumIters), tol(tolerance), 
+  rho(massDensPerUnitLength),maxIters(maxNumIters), numIterations(0), tol(tolerance), 
   initialFlag(0),
   kv(NEBD,NEBD), Se(NEBD), 
   kvcommit(NEBD,NEBD), Secommit(NEBD),
@@ -1033,7 +1058,7 @@ ForceBeamColumn2d::getInitialStiff(void)
     Ki = new Matrix(this->getTangentStiff());
   */
 
-  static Matrix f(NEBD, NEBD);   // element flexibility matrix  
+  static thread_local Matrix f(NEBD, NEBD);   // element flexibility matrix  
   this->getInitialFlexibility(f);
 
   /*
@@ -1050,7 +1075,7 @@ ForceBeamColumn2d::getInitialStiff(void)
     opserr << "ForceBeamColumn2d::getInitialStiff() -- could not invert flexibility\n";
   */
 
-  static Matrix kvInit(NEBD, NEBD);
+  static thread_local Matrix kvInit(NEBD, NEBD);
   f.Invert(kvInit);
   if(theDamping) kvInit *= theDamping->getStiffnessMultiplier();
   Ki = new Matrix(crdTransf->getInitialGlobalStiffMatrix(kvInit));
@@ -1229,6 +1254,28 @@ ForceBeamColumn2d::initializeSectionHistoryVariables (void)
   }
 }
 
+bool
+ForceBeamColumn2d::isThreadSafe(void)
+{
+  // the element scratch storage, and that of Element used for Rayleigh
+  // damping, is per thread, so the element may be updated concurrently
+  // with others if the objects it calls can be
+  if (theDamping != 0 || crdTransf == 0 || !crdTransf->isThreadSafe())
+    return false;
+
+  for (int i = 0; i < numSections; i++)
+    if (!sections[i]->isThreadSafe())
+      return false;
+
+  return true;
+}
+
+int
+ForceBeamColumn2d::getNumIterations(void)
+{
+  return numIterations;
+}
+
 /********* NEWTON , SUBDIVIDE AND INITIAL ITERATIONS ********************
  */
 int
@@ -1239,20 +1286,22 @@ ForceBeamColumn2d::update()
   if (initialFlag == 2)
     this->revertToLastCommit();
 
+  numIterations = 0;
+
   // update the transformation
   crdTransf->update();
 
   // get basic displacements and increments
   const Vector &v = crdTransf->getBasicTrialDisp();    
 
-  static Vector dv(NEBD);
+  VectorND<NEBD> dv;
 
   dv = crdTransf->getBasicIncrDeltaDisp();    
 
-  if (initialFlag != 0 && dv.Norm() <= DBL_EPSILON && numEleLoads == 0)
+  if (initialFlag != 0 && dv.norm() <= DBL_EPSILON && numEleLoads == 0)
     return 0;
 
-  static Vector vin(NEBD);
+  VectorND<NEBD> vin;
   vin = v;
   vin -= dv;
 
@@ -1265,24 +1314,19 @@ ForceBeamColumn2d::update()
   double wt[maxNumSections];
   beamIntegr->getSectionWeights(numSections, L, wt);
 
-  static Vector vr(NEBD);       // element residual displacements
-  static Matrix f(NEBD,NEBD);   // element flexibility matrix
+  VectorND<NEBD> vr;                // element residual displacements
+  MatrixND<NEBD,NEBD> f;            // element flexibility matrix
   
-  static Matrix I(NEBD,NEBD);   // an identity matrix for matrix inverse
   double dW;                    // section strain energy (work) norm 
   int i, j;
   
-  I.Zero();
-  for (i=0; i<NEBD; i++)
-    I(i,i) = 1.0;
-
   int numSubdivide = 1;
   bool converged = false;
-  static Vector dSe(NEBD);
-  static Vector dvToDo(NEBD);
-  static Vector dvTrial(NEBD);
-  static Vector SeTrial(NEBD);
-  static Matrix kvTrial(NEBD, NEBD);
+  VectorND<NEBD> dSe;
+  VectorND<NEBD> dvToDo;
+  VectorND<NEBD> dvTrial;
+  VectorND<NEBD> SeTrial;
+  MatrixND<NEBD,NEBD> kvTrial;
 
   dvToDo = dv;
   dvTrial = dvToDo;
@@ -1320,7 +1364,7 @@ ForceBeamColumn2d::update()
 
       // calculate nodal force increments and update nodal forces      
       // dSe = kv * dv;
-      dSe.addMatrixVector(0.0, kvTrial, dvTrial, 1.0);
+      dSe = kvTrial*dvTrial;
       SeTrial += dSe;
 
       if (initialFlag != 2) {
@@ -1330,19 +1374,22 @@ ForceBeamColumn2d::update()
 	  numIters = 10*maxIters; // allow 10 times more iterations for initial tangent
 	
 	for (j=0; j <numIters; j++) {
+
+	  numIterations++;
+
 	  // initialize f and vr for integration
-	  f.Zero();
-	  vr.Zero();
+	  f.zero();
+	  vr.zero();
 
 	  for (i=0; i<numSections; i++) {
 
 	    int order      = sections[i]->getOrder();
 	    const ID &code = sections[i]->getType();
 
-	    static Vector Ss;
-	    static Vector dSs;
-	    static Vector dvs;
-	    static Matrix fb;
+	    static thread_local Vector Ss;
+	    static thread_local Vector dSs;
+	    static thread_local Vector dvs;
+	    static thread_local Matrix fb;
 	    
 	    Ss.setData(workArea, order);
 	    dSs.setData(&workArea[order], order);
@@ -1525,7 +1572,7 @@ ForceBeamColumn2d::update()
 
 	  // calculate element stiffness matrix
 	  // invert3by3Matrix(f, kv);	  
-	  if (f.Solve(I, kvTrial) < 0)
+	  if (invertFlexibility(f, kvTrial) < 0)
 	    opserr << "ForceBeamColumn2d::update() -- could not invert flexibility for element with tag: " << this->getTag() << endln;
 				    
 	  // dv = vin + dvTrial  - vr
@@ -1536,9 +1583,9 @@ ForceBeamColumn2d::update()
 	  // dv.addVector(1.0, vr, -1.0);
 	  
 	  // dSe = kv * dv;
-	  dSe.addMatrixVector(0.0, kvTrial, dv, 1.0);
+	  dSe = kvTrial*dv;
 
-	  dW = dv ^ dSe; 
+	  dW = dv.dot(dSe); 
 	  
 	  SeTrial += dSe;
 	  
@@ -1550,7 +1597,7 @@ ForceBeamColumn2d::update()
 	    vin += dvTrial;
 	    
 	    // check if we have got to where we wanted
-	    if (dvToDo.Norm() <= DBL_EPSILON) {
+	    if (dvToDo.norm() <= DBL_EPSILON) {
 	      converged = true;
 	      
 	    } else {  // we convreged but we have more to do
@@ -1561,8 +1608,8 @@ ForceBeamColumn2d::update()
 	    }
 	    
 	    // set kv, vs and Se values
-	    kv = kvTrial;
-	    Se = SeTrial;
+	    kv = Matrix(kvTrial.data(), NEBD, NEBD);
+	    Se = Vector(SeTrial.values, NEBD);
 	    
 	    for (int k=0; k<numSections; k++) {
 	      vs[k] = vsSubdivide[k];
@@ -2637,7 +2684,7 @@ ForceBeamColumn2d::getInitialDeformations(Vector &v0)
     double xL1 = xL-1.0;
     double wtL = wt[i]*L;
 
-    static Vector sp;
+    static thread_local Vector sp;
     sp.setData(workArea, order);
     sp.Zero();
 
@@ -2645,7 +2692,7 @@ ForceBeamColumn2d::getInitialDeformations(Vector &v0)
 
     const Matrix &fse = sections[i]->getInitialFlexibility();
 
-    static Vector e;
+    static thread_local Vector e;
     e.setData(&workArea[order], order);
 
     e.addMatrixVector(0.0, fse, sp, 1.0);
@@ -102,6 +102,8 @@ class ForceBeamColumn3d: public Element
   int revertToLastCommit(void);        
   int revertToStart(void);
   int update(void);    
+  bool isThreadSafe(void);
+  int getNumIterations(void);
   
   const Matrix &getTangentStiff(void);
   const Matrix &getInitialStiff(void);
@@ -168,6 +170,7 @@ class ForceBeamColumn3d: public Element
   // (performs the transformation between the global and basic system)
   double rho;                    // mass density per unit length
   int    maxIters;               // maximum number of local iterations
+  int    numIterations;          // local iterations of the last update
   double tol;	                   // tolerance for relative energy norm for local iterations
   
   int    initialFlag;            // indicates if the element has been initialized
@@ -208,9 +211,11 @@ class ForceBeamColumn3d: public Element
   // undergoing the update (FB element localizes at the integration point level)
   double current_section_lch = 0.0;
 
-  static Matrix theMatrix;
-  static Vector theVector;
-  static double workArea[];
+  // work areas shared by all elements of the class; there is one set
+  // per thread so that different elements can be updated concurrently
+  static thread_local Matrix theMatrix;
+  static thread_local Vector theVector;
+  static thread_local double workArea[];
   
   enum {maxNumSections = 10};
   
@@ -218,9 +223,9 @@ class ForceBeamColumn3d: public Element
   int    maxSubdivisions;       // maximum number of subdivisons of dv for local iterations
   double subdivideFactor;
   
-  static Vector vsSubdivide[];
-  static Vector SsrSubdivide[];
-  static Matrix fsSubdivide[];
+  static thread_local Vector vsSubdivide[];
+  static thread_local Vector SsrSubdivide[];
+  static thread_local Matrix fsSubdivide[];
   //static int maxNumSections;
 
   // AddingSensitivity:BEGIN //////////////////////////////////////////
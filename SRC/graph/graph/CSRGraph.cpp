@@ -0,0 +1,321 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the class implementation for CSRGraph.
+
+#include <CSRGraph.h>
+#include <Vertex.h>
+#include <VertexIter.h>
+#include <ID.h>
+#include <algorithm>
+
+CSRGraph::CSRGraph(int n)
+  :Graph(), numVertex(n), vertexRef(n), vertexColor(n, 0),
+   cliqueStart(1, 0), cliqueData(), rowStart(n+1, 0), adjacency(),
+   numEdge(0), expanded(false), modified(false)
+{
+  for (int i=0; i<numVertex; i++)
+    vertexRef[i] = i;
+}
+
+
+CSRGraph::~CSRGraph()
+{
+
+}
+
+
+// int setVertex(int tag, int ref, int color);
+// Sets the reference and color that the Vertex with the given tag
+// will carry should the Vertex based interface be used.
+
+int
+CSRGraph::setVertex(int tag, int ref, int color)
+{
+  if (tag < 0 || tag >= numVertex || expanded == true) {
+    opserr << "WARNING CSRGraph::setVertex - vertex " << tag;
+    opserr << " not in the graph or the graph has been expanded\n";
+    return -1;
+  }
+
+  vertexRef[tag] = ref;
+  vertexColor[tag] = color;
+  return 0;
+}
+
+
+// int addClique(const ID &theClique);
+// Adds an edge between every pair of vertices in theClique. Entries
+// outside 0 through numVertex-1, e.g. the -1 of a constrained dof,
+// are skipped. The edges are only stored until build() is invoked.
+
+int
+CSRGraph::addClique(const ID &theClique)
+{
+  if (expanded == true) {
+    opserr << "WARNING CSRGraph::addClique - graph has been expanded\n";
+    return -1;
+  }
+
+  int size = theClique.Size();
+  for (int i=0; i<size; i++) {
+    int vertexTag = theClique(i);
+    if (vertexTag >= 0 && vertexTag < numVertex)
+      cliqueData.push_back(vertexTag);
+  }
+  cliqueStart.push_back(cliqueData.size());
+
+  return 0;
+}
+
+
+// int build(void);
+// Assembles the adjacency of the vertices from the cliques added since
+// the last call. The rows are independent, each is gathered from the
+// cliques incident to the vertex with a marker array and then sorted,
+// so the work is split over the available threads.
+
+int
+CSRGraph::build(void)
+{
+  int numClique = cliqueStart.size() - 1;
+
+  // the cliques incident to each vertex
+  std::vector<int> incidenceStart(numVertex+1, 0);
+  for (int k=0; k<numClique; k++)
+    for (int j=cliqueStart[k]; j<cliqueStart[k+1]; j++)
+      incidenceStart[cliqueData[j]+1]++;
+  for (int i=0; i<numVertex; i++)
+    incidenceStart[i+1] += incidenceStart[i];
+
+  std::vector<int> incidence(incidenceStart[numVertex]);
+  std::vector<int> next(incidenceStart.begin(), incidenceStart.end()-1);
+  for (int k=0; k<numClique; k++)
+    for (int j=cliqueStart[k]; j<cliqueStart[k+1]; j++)
+      incidence[next[cliqueData[j]]++] = k;
+
+  // rows from an earlier build() are merged with the new cliques
+  std::vector<int> oldStart;
+  std::vector<int> oldAdjacency;
+  oldStart.swap(rowStart);
+  oldAdjacency.swap(adjacency);
+  rowStart.assign(numVertex+1, 0);
+
+  // first pass counts the degrees, the second fills in the rows
+  for (int pass=0; pass<2; pass++) {
+
+#pragma omp parallel if(numVertex > 2000)
+    {
+      std::vector<int> mark(numVertex, -1);
+      std::vector<int> row;
+
+#pragma omp for schedule(dynamic,256)
+      for (int i=0; i<numVertex; i++) {
+	row.clear();
+	mark[i] = i;
+	for (int k=oldStart[i]; k<oldStart[i+1]; k++) {
+	  int j = oldAdjacency[k];
+	  if (mark[j] != i) {
+	    mark[j] = i;
+	    row.push_back(j);
+	  }
+	}
+	for (int l=incidenceStart[i]; l<incidenceStart[i+1]; l++) {
+	  int c = incidence[l];
+	  for (int k=cliqueStart[c]; k<cliqueStart[c+1]; k++) {
+	    int j = cliqueData[k];
+	    if (mark[j] != i) {
+	      mark[j] = i;
+	      row.push_back(j);
+	    }
+	  }
+	}
+
+	if (pass == 0)
+	  rowStart[i+1] = row.size();
+	else {
+	  std::sort(row.begin(), row.end());
+	  std::copy(row.begin(), row.end(), adjacency.begin() + rowStart[i]);
+	}
+      }
+    }
+
+    if (pass == 0) {
+      for (int i=0; i<numVertex; i++)
+	rowStart[i+1] += rowStart[i];
+      adjacency.resize(rowStart[numVertex]);
+    }
+  }
+
+  numEdge = rowStart[numVertex]/2;
+
+  // release the cliques
+  std::vector<int>(1, 0).swap(cliqueStart);
+  std::vector<int>().swap(cliqueData);
+
+  return 0;
+}
+
+
+int
+CSRGraph::getCSR(const int *&theRowStart, const int *&theAdjacency)
+{
+  if (modified == true)
+    return this->Graph::getCSR(theRowStart, theAdjacency);
+
+  theRowStart = rowStart.data();
+  theAdjacency = adjacency.data();
+  return 0;
+}
+
+
+// int expand(void);
+// Creates the Vertex objects, each with its own copy of the adjacency,
+// the first time a method of the Vertex based interface is invoked.
+
+int
+CSRGraph::expand(void)
+{
+  if (expanded == true)
+    return 0;
+
+  expanded = true;
+
+  for (int i=0; i<numVertex; i++) {
+    Vertex *vertexPtr = new Vertex(i, vertexRef[i], 0, vertexColor[i]);
+    int degree = rowStart[i+1] - rowStart[i];
+    ID vertexAdjacency(degree);
+    for (int j=0; j<degree; j++)
+      vertexAdjacency(j) = adjacency[rowStart[i]+j];
+    vertexPtr->setAdjacency(vertexAdjacency);
+
+    if (this->Graph::addVertex(vertexPtr, false) == false) {
+      opserr << "WARNING CSRGraph::expand - failed to add vertex " << i << endln;
+      delete vertexPtr;
+      return -1;
+    }
+  }
+
+  return 0;
+}
+
+
+bool
+CSRGraph::addVertex(Vertex *vertexPtr, bool checkAdjacency)
+{
+  this->expand();
+  modified = true;
+  return this->Graph::addVertex(vertexPtr, checkAdjacency);
+}
+
+
+int
+CSRGraph::addEdge(int vertexTag, int otherVertexTag)
+{
+  this->expand();
+  modified = true;
+  return this->Graph::addEdge(vertexTag, otherVertexTag);
+}
+
+
+void
+CSRGraph::startAddEdge()
+{
+  this->expand();
+  this->Graph::startAddEdge();
+}
+
+
+int
+CSRGraph::addEdgeFast(int vertexTag, int otherVertexTag)
+{
+  modified = true;
+  return this->Graph::addEdgeFast(vertexTag, otherVertexTag);
+}
+
+
+Vertex *
+CSRGraph::getVertexPtr(int vertexTag)
+{
+  this->expand();
+  return this->Graph::getVertexPtr(vertexTag);
+}
+
+
+VertexIter &
+CSRGraph::getVertices(void)
+{
+  this->expand();
+  return this->Graph::getVertices();
+}
+
+
+int
+CSRGraph::getNumVertex(void) const
+{
+  if (expanded == true)
+    return this->Graph::getNumVertex();
+
+  return numVertex;
+}
+
+
+int
+CSRGraph::getNumEdge(void) const
+{
+  // the Graph only counts the edges added after the expansion
+  return numEdge + this->Graph::getNumEdge();
+}
+
+
+int
+CSRGraph::getFreeTag(void)
+{
+  if (expanded == true)
+    return this->Graph::getFreeTag();
+
+  return numVertex;
+}
+
+
+Vertex *
+CSRGraph::removeVertex(int tag, bool removeEdgeFlag)
+{
+  this->expand();
+  modified = true;
+  return this->Graph::removeVertex(tag, removeEdgeFlag);
+}
+
+
+int
+CSRGraph::merge(Graph &other)
+{
+  this->expand();
+  modified = true;
+  return this->Graph::merge(other);
+}
+
+
+void
+CSRGraph::Print(OPS_Stream &s, int flag)
+{
+  this->expand();
+  this->Graph::Print(s, flag);
+}
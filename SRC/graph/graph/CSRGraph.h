@@ -0,0 +1,87 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef CSRGraph_h
+#define CSRGraph_h
+
+// Description: This file contains the class definition for CSRGraph.
+// CSRGraph is a Graph whose vertices are tagged 0 through numVertex-1
+// and whose adjacency is stored in compressed row form. The edges are
+// given as cliques (the IDs of the FE_Elements), and build() assembles
+// the sorted adjacency of every vertex in one pass. Numberers and
+// LinearSOEs read the arrays through getCSR(); Vertex objects are only
+// created if the old Vertex based interface is used.
+
+#include <Graph.h>
+#include <vector>
+
+class ID;
+
+class CSRGraph: public Graph
+{
+  public:
+    CSRGraph(int numVertex);
+    ~CSRGraph();
+
+    // setting up the graph
+    int setVertex(int tag, int ref, int color = 0);
+    int addClique(const ID &theClique);
+    int build(void);
+
+    int getCSR(const int *&rowStart, const int *&adjacency);
+
+    // the Vertex based interface of Graph
+    bool addVertex(Vertex *vertexPtr, bool checkAdjacency = true);
+    int addEdge(int vertexTag, int otherVertexTag);
+    void startAddEdge();
+    int addEdgeFast(int vertexTag, int otherVertexTag);
+
+    Vertex *getVertexPtr(int vertexTag);
+    VertexIter &getVertices(void);
+    int getNumVertex(void) const;
+    int getNumEdge(void) const;
+    int getFreeTag(void);
+    Vertex *removeVertex(int tag, bool removeEdgeFlag = true);
+
+    int merge(Graph &other);
+
+    void Print(OPS_Stream &s, int flag =0);
+
+  protected:
+
+  private:
+    int expand(void);
+
+    int numVertex;
+    std::vector<int> vertexRef;
+    std::vector<int> vertexColor;
+
+    std::vector<int> cliqueStart;  // cliques added but not yet built
+    std::vector<int> cliqueData;
+
+    std::vector<int> rowStart;
+    std::vector<int> adjacency;
+    int numEdge;
+
+    bool expanded;   // Vertex objects have been created
+    bool modified;   // .. and changed since, the arrays are out of date
+};
+
+#endif
@@ -43,7 +43,7 @@
 
 Graph::Graph()
   :myVertices(0), theVertexIter(0), numEdge(0), nextFreeTag(START_VERTEX_NUM),
-  vertices()
+  vertices(), csrStart(), csrAdjacency()
 {
     myVertices = new MapOfTaggedObjects();
     theVertexIter = new VertexIter(myVertices);
@@ -52,7 +52,7 @@ Graph::Graph()
 
 Graph::Graph(int numVertices)
   :myVertices(0), theVertexIter(0), numEdge(0), nextFreeTag(START_VERTEX_NUM),
-  vertices()
+  vertices(), csrStart(), csrAdjacency()
 {
     myVertices = new MapOfTaggedObjects();
     theVertexIter = new VertexIter(myVertices);
@@ -61,7 +61,7 @@ Graph::Graph(int numVertices)
 
 Graph::Graph(TaggedObjectStorage &theVerticesStorage)
   :myVertices(&theVerticesStorage), theVertexIter(0), numEdge(0), nextFreeTag(START_VERTEX_NUM),
-  vertices()
+  vertices(), csrStart(), csrAdjacency()
 {
   TaggedObject *theObject;
   TaggedObjectIter &theObjects = theVerticesStorage.getComponents();
@@ -76,7 +76,7 @@ Graph::Graph(TaggedObjectStorage &theVerticesStorage)
 
 Graph::Graph(Graph &other) 
   :myVertices(0), theVertexIter(0), numEdge(0), nextFreeTag(START_VERTEX_NUM),
-  vertices()
+  vertices(), csrStart(), csrAdjacency()
 {
   myVertices = new MapOfTaggedObjects();
   theVertexIter = new VertexIter(myVertices);
@@ -88,7 +88,7 @@ Graph::Graph(Graph &other)
   while ((vertexPtr = otherVertices()) != 0) {
     int vertexTag = vertexPtr->getTag();
     int vertexRef = vertexPtr->getRef();
-    vertexPtr = new Vertex(vertexTag, vertexRef);
+    vertexPtr = new Vertex(vertexTag, vertexRef, vertexPtr->getWeight(), vertexPtr->getColor());
     if (vertexPtr == 0) {
       opserr << "Graph::Graph - out of memory\n";
       return;
@@ -368,6 +368,49 @@ Graph::merge(Graph &other) {
 }
 
 
+// int getCSR(const int *&rowStart, const int *&adjacency);
+// Method to return the adjacency of the graph in compressed row form.
+// The arrays are assembled from the Vertex adjacency lists on each call
+// and remain valid until the next call or until the Graph is modified.
+// Returns $0$ if successful, $-1$ if the vertex tags are not the
+// contiguous range 0 through numVertex-1.
+
+int
+Graph::getCSR(const int *&rowStart, const int *&adjacency)
+{
+  int numVertex = this->getNumVertex();
+  csrStart.assign(numVertex+1, -1);
+
+  // first pass: check the tags and count the degrees
+  Vertex *vertexPtr;
+  VertexIter &theVertices = this->getVertices();
+  while ((vertexPtr = theVertices()) != 0) {
+    int tag = vertexPtr->getTag();
+    if (tag < 0 || tag >= numVertex || csrStart[tag+1] != -1)
+      return -1;
+    csrStart[tag+1] = vertexPtr->getAdjacency().Size();
+  }
+
+  csrStart[0] = 0;
+  for (int i=0; i<numVertex; i++)
+    csrStart[i+1] += csrStart[i];
+
+  // second pass: copy the adjacency, which each Vertex keeps sorted
+  csrAdjacency.resize(csrStart[numVertex]);
+  VertexIter &theVertices2 = this->getVertices();
+  while ((vertexPtr = theVertices2()) != 0) {
+    const ID &vertexAdjacency = vertexPtr->getAdjacency();
+    int *row = csrAdjacency.data() + csrStart[vertexPtr->getTag()];
+    for (int i=0; i<vertexAdjacency.Size(); i++)
+      row[i] = vertexAdjacency(i);
+  }
+
+  rowStart = csrStart.data();
+  adjacency = csrAdjacency.data();
+  return 0;
+}
+
+
 void 
 Graph::Print(OPS_Stream &s, int flag)
 {
@@ -392,6 +435,7 @@ Graph::sendSelf(int commitTag, Channel &theChannel)
   }
 
   int numVertex = this->getNumVertex();
+  int numEdge = this->getNumEdge();
 
   // send numEdge & the number of vertices
   static ID idData(2);
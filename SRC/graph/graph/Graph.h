@@ -68,6 +68,11 @@ class Graph
     virtual Vertex *removeVertex(int tag, bool removeEdgeFlag = true);
 
     virtual int merge(Graph &other);
+
+    // compressed row view of the adjacency; the neighbours of vertex i
+    // are adjacency[rowStart[i]] .. adjacency[rowStart[i+1]-1] in
+    // ascending order, without i itself. requires vertex tags 0..n-1
+    virtual int getCSR(const int *&rowStart, const int *&adjacency);
     
     virtual void Print(OPS_Stream &s, int flag =0);
     int sendSelf(int commitTag, Channel &theChannel);
@@ -83,6 +88,8 @@ class Graph
     int numEdge;
     int nextFreeTag;
     std::vector<Vertex*> vertices;
+    std::vector<int> csrStart;
+    std::vector<int> csrAdjacency;
 };
 
 #endif
@@ -31,8 +31,6 @@
 
 #include <AMDNumberer.h>
 #include <Graph.h>
-#include <Vertex.h>
-#include <VertexIter.h>
 #include <ID.h>
 #include <Channel.h>
 #include <FEM_ObjectBroker.h>
@@ -63,33 +61,16 @@ AMD::number(Graph &theGraph, int startVertex)
 
   theResult.resize(numVertex);
 
-  int nnz = 0;
-  Vertex *vertexPtr;
-  VertexIter &vertexIter = theGraph.getVertices();
-  
-  while ((vertexPtr = vertexIter()) != 0) {
-    const ID &adjacency = vertexPtr->getAdjacency();
-    nnz += adjacency.Size();
+  // the compressed row form of the graph is the symmetric pattern amd
+  // expects, the rows sorted and without the diagonal
+  const int *Ap, *Ai;
+  if (theGraph.getCSR(Ap, Ai) < 0) {
+    opserr << "WARNING:  AMD::number - vertex tags are not 0 through numVertex-1\n";
+    theResult.resize(0);
+    return theResult;
   }
 
   int *P = new int[numVertex];
-  int *Ap = new int[numVertex+1];
-  int *Ai = new int[nnz];
-  double Control[AMD_CONTROL];
-  double Info[AMD_INFO];
-
-  VertexIter &vertexIter2 = theGraph.getVertices();
-
-  nnz = 0;
-  int count = 1;
-  Ap[0] = 0;
-
-  while ((vertexPtr = vertexIter2()) != 0) {
-    const ID &adjacency = vertexPtr->getAdjacency();
-    for (int i=0; i<adjacency.Size(); i++)
-      Ai[nnz++] = adjacency(i);
-    Ap[count++] = nnz;
-  }  
 
   amd_order(numVertex, Ap, Ai, P, (double *)NULL, (double *)NULL);
   
@@ -97,8 +78,6 @@ AMD::number(Graph &theGraph, int startVertex)
     theResult[i] = P[i];
 
   delete [] P;
-  delete [] Ap;
-  delete [] Ai;
 
   return theResult;
 }
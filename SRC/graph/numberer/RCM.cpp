@@ -40,6 +40,7 @@
 #include <ID.h>
 #include <Channel.h>
 #include <FEM_ObjectBroker.h>
+#include <vector>
 
 // Constructor
 RCM::RCM(bool gps)
@@ -57,6 +58,64 @@ RCM::~RCM()
 }
 
 
+// static int levelSets(...)
+// Numbers the vertices of a graph in compressed row form by level sets
+// from the vertex start, placing them from the back of result as the
+// Vertex based code below does. Returns the profile measure; the start
+// of the last level set and the last vertex visited are returned for
+// the gibbs-poole-stodlmyer variant.
+
+static int
+levelSets(int numVertex, const int *rowStart, const int *adjacency, int start,
+	  ID &result, std::vector<int> &mark, int &startLastLevelSet,
+	  int &lastVertex)
+{
+    mark.assign(numVertex, -1);
+
+    int currentMark = numVertex-1;  // marks current vertex visiting.
+    int nextMark = currentMark -1;  // indiactes where to put next Tag in ID.
+    int nextUnmarked = 0;           // where to look for disconnected parts
+    int avgProfile = 0;
+    startLastLevelSet = nextMark;
+    result(currentMark) = start;
+    mark[start] = currentMark;
+    lastVertex = start;
+
+    while (nextMark >= 0) {
+	int vertex = result(currentMark);
+	lastVertex = vertex;
+	for (int i=rowStart[vertex]; i<rowStart[vertex+1]; i++) {
+	    int other = adjacency[i];
+	    lastVertex = other;
+	    if (mark[other] == -1) {
+		mark[other] = nextMark;
+		avgProfile += (currentMark - nextMark);
+		result(nextMark--) = other;
+	    }
+	}
+
+	currentMark--;
+
+	if (startLastLevelSet == currentMark)
+	    startLastLevelSet = nextMark;
+
+	// check to see if graph is disconnected
+	if ((currentMark == nextMark) && (currentMark >= 0)) {
+	    while (mark[nextUnmarked] != -1)
+		nextUnmarked++;
+
+	    nextMark--;
+	    startLastLevelSet = nextMark;
+	    lastVertex = nextUnmarked;
+	    mark[nextUnmarked] = currentMark;
+	    result(currentMark) = nextUnmarked;
+	}
+    }
+
+    return avgProfile;
+}
+
+
 // const ID &number(Graph &theGraph,int startVertexTag = -1,
 //                  bool minDegree = false)
 //    Method to perform the Reverse Cuthill-mcKenn numbering scheme. The
@@ -95,6 +154,44 @@ RCM::number(Graph &theGraph, int startVertex)
     if (numVertex == 0) 
 	return *theRefResult;
 	    
+    // if the graph provides its adjacency in compressed row form the
+    // vertices are tagged 0 through numVertex-1 and are numbered on the
+    // arrays, visiting them in the order the Vertex based code does
+
+    const int *rowStart, *adjacency;
+    if (theGraph.getCSR(rowStart, adjacency) == 0) {
+	std::vector<int> mark;
+	int startLastLevelSet, lastVertex;
+	int start = startVertex;
+
+	if (start != -1 && (start < 0 || start >= numVertex)) {
+	    opserr << "WARNING:  RCM::number - No vertex with tag ";
+	    opserr << start << "Exists - using first come from iter\n";
+	    start = -1;
+	}
+
+	if (start == -1) {
+	    start = 0;
+	    if (GPS == true) {
+		levelSets(numVertex, rowStart, adjacency, start, *theRefResult,
+			  mark, startLastLevelSet, lastVertex);
+
+		if (startLastLevelSet > 0) {
+		    ID lastLevelSet(startLastLevelSet);
+		    for (int i=0; i<startLastLevelSet; i++)
+			lastLevelSet(i) = (*theRefResult)(i);
+		    
+		    return this->number(theGraph,lastLevelSet);
+		}
+		start = lastVertex;
+	    }
+	}
+
+	levelSets(numVertex, rowStart, adjacency, start, *theRefResult,
+		  mark, startLastLevelSet, lastVertex);
+
+	return *theRefResult;
+    }
 
     // we first set the Tmp of all vertices to -1, indicating
     // they have not yet been added.
@@ -313,6 +410,40 @@ RCM::number(Graph &theGraph, const ID &startVertices)
     if (numVertex == 0) 
 	return *theRefResult;
 
+    // number on the compressed row form if the graph provides it
+    const int *rowStart, *adjacency;
+    if (theGraph.getCSR(rowStart, adjacency) == 0) {
+	std::vector<int> mark;
+	int startLastLevelSet, lastVertex;
+	int minStartVertex = 0;
+	int minAvgProfile = 0;
+	int start = 0;
+
+	for (int i=0; i<startVertices.Size(); i++) {
+	    start = startVertices(i);
+	    if (start < 0 || start >= numVertex) {
+		opserr << "WARNING:  RCM::number - No vertex with tag ";
+		opserr << start << "Exists - using first come from iter\n";
+		start = 0;
+	    }
+
+	    int avgProfile = levelSets(numVertex, rowStart, adjacency, start,
+				       *theRefResult, mark, startLastLevelSet,
+				       lastVertex);
+
+	    if (i == 0 || minAvgProfile > avgProfile) {
+		minStartVertex = start;
+		minAvgProfile = avgProfile;
+	    }
+	}
+
+	if (minStartVertex != start)
+	    levelSets(numVertex, rowStart, adjacency, minStartVertex,
+		      *theRefResult, mark, startLastLevelSet, lastVertex);
+
+	return *theRefResult;
+    }
+
     // determine one that gives the min avg profile	    
     int minStartVertexTag =0;
     int minAvgProfile = 0;
@@ -35,7 +35,9 @@
 // number() method with the Graph to be numbered.
 //
 // Side effects: numberer() changes the Tmp values of the vertices to
-// the number assigned to that vertex.
+// the number assigned to that vertex. Graphs that provide their adjacency
+// in compressed row form are numbered on the arrays, leaving the
+// vertices untouched.
 //
 // What: "@(#) RCM.h, revA"
 
@@ -0,0 +1,364 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: checks that a CSRGraph gives the same RCM numbering and
+// the same LinearSOE sizes as the Vertex based Graph AnalysisModel built
+// before. The dof graph of a mesh of quads, a chain of trusses, fixed
+// dofs and a disconnected frame is built both ways with the equation
+// numbers scrambled. RCM numbers the Vertex based graph with its Vertex
+// code and the CSRGraph on the arrays; the band, half band and profile
+// of the BandGen, BandSPD and ProfileSPD SOEs set up from the renumbered
+// graphs are compared to the values the Vertex based setSize() gave, e.g.
+//
+//      make rcmTest; ./rcmTest
+
+#include <CSRGraph.h>
+#include <Graph.h>
+#include <Vertex.h>
+#include <VertexIter.h>
+#include <ID.h>
+#include <MapOfTaggedObjects.h>
+#include <RCM.h>
+#include <BandGenLinSOE.h>
+#include <BandGenLinLapackSolver.h>
+#include <BandSPDLinSOE.h>
+#include <BandSPDLinLapackSolver.h>
+#include <ProfileSPDLinSOE.h>
+#include <ProfileSPDLinDirectSolver.h>
+#include <OPS_Globals.h>
+#include <StandardStream.h>
+
+#include <vector>
+
+StandardStream sserr;
+OPS_Stream *opserrPtr = &sserr;
+
+// the Graph AnalysisModel built before the CSRGraph; without the arrays
+// RCM falls back on its Vertex based numbering
+class VertexGraph: public Graph
+{
+  public:
+    VertexGraph(TaggedObjectStorage &theStorage) :Graph(theStorage) {}
+    int getCSR(const int *&rowStart, const int *&adjacency) {return -1;}
+};
+
+// access to the sizes the SOEs compute in setSize()
+class TestBandGenLinSOE: public BandGenLinSOE
+{
+  public:
+    TestBandGenLinSOE(BandGenLinSolver &theSolver) :BandGenLinSOE(theSolver) {}
+    int getNumSuperD(void) {return numSuperD;}
+    int getNumSubD(void) {return numSubD;}
+};
+
+class TestBandSPDLinSOE: public BandSPDLinSOE
+{
+  public:
+    TestBandSPDLinSOE(BandSPDLinSolver &theSolver) :BandSPDLinSOE(theSolver) {}
+    int getHalfBand(void) {return half_band;}
+};
+
+class TestProfileSPDLinSOE: public ProfileSPDLinSOE
+{
+  public:
+    TestProfileSPDLinSOE(ProfileSPDLinSolver &theSolver) :ProfileSPDLinSOE(theSolver) {}
+    int getProfileSize(void) {return profileSize;}
+};
+
+static const int nx = 14;
+static const int ny = 9;
+static const int numFrameNodes = 6;
+
+static std::vector<ID> cliques;
+static int numEqn = 0;
+
+// the FE_Element IDs of the mesh, equation numbers scrambled, fixed
+// dofs -1 and the elements in no particular order
+static void
+buildCliques(void)
+{
+  int numNodes = (nx+1)*(ny+1);
+  int numDOF = 2*numNodes + 3*numFrameNodes;
+
+  std::vector<int> eqn(numDOF);
+  for (int i=0; i<numDOF; i++)
+    eqn[i] = i;
+  unsigned int seed = 12345;
+  for (int i=numDOF-1; i>0; i--) {
+    seed = seed*1103515245 + 12345;
+    int j = (seed >> 8) % (i+1);
+    int tmp = eqn[i]; eqn[i] = eqn[j]; eqn[j] = tmp;
+  }
+
+  // the nodes along x=0 are fixed
+  for (int j=0; j<=ny; j++) {
+    int node = j*(nx+1);
+    eqn[2*node] = -1;
+    eqn[2*node+1] = -1;
+  }
+  // the free dofs are numbered 0 through numEqn-1 in the scrambled order
+  std::vector<int> byEqn(numDOF, -1);
+  for (int i=0; i<numDOF; i++)
+    if (eqn[i] >= 0)
+      byEqn[eqn[i]] = i;
+  numEqn = 0;
+  for (int e=0; e<numDOF; e++)
+    if (byEqn[e] >= 0)
+      eqn[byEqn[e]] = numEqn++;
+
+  cliques.clear();
+
+  // quads, 8 dofs
+  for (int j=0; j<ny; j++) {
+    for (int i=0; i<nx; i++) {
+      int n[4] = {j*(nx+1)+i, j*(nx+1)+i+1, (j+1)*(nx+1)+i+1, (j+1)*(nx+1)+i};
+      ID id(8);
+      for (int a=0; a<4; a++) {
+	id(2*a) = eqn[2*n[a]];
+	id(2*a+1) = eqn[2*n[a]+1];
+      }
+      cliques.push_back(id);
+    }
+  }
+
+  // trusses along the diagonal of the mesh
+  for (int i=0; i<nx && i<ny; i++) {
+    int n1 = i*(nx+1)+i;
+    int n2 = (i+1)*(nx+1)+i+1;
+    ID id(4);
+    id(0) = eqn[2*n1]; id(1) = eqn[2*n1+1];
+    id(2) = eqn[2*n2]; id(3) = eqn[2*n2+1];
+    cliques.push_back(id);
+  }
+
+  // a frame connected to nothing else
+  for (int i=0; i<numFrameNodes-1; i++) {
+    int d = 2*numNodes + 3*i;
+    ID id(6);
+    for (int a=0; a<6; a++)
+      id(a) = eqn[d+a];
+    cliques.push_back(id);
+  }
+
+  // shuffle the elements
+  for (int i=cliques.size()-1; i>0; i--) {
+    seed = seed*1103515245 + 12345;
+    int j = (seed >> 8) % (i+1);
+    ID tmp = cliques[i]; cliques[i] = cliques[j]; cliques[j] = tmp;
+  }
+}
+
+// the Vertex based graph, built as AnalysisModel::getDOFGraph() did
+static Graph *
+vertexGraph(const std::vector<int> &newEqn, bool numberOnVertices)
+{
+  MapOfTaggedObjects *theStorage = new MapOfTaggedObjects();
+  Graph *theGraph;
+  if (numberOnVertices == true)
+    theGraph = new VertexGraph(*theStorage);
+  else
+    theGraph = new Graph(*theStorage);
+
+  for (int i=0; i<numEqn; i++)
+    theGraph->addVertex(new Vertex(i, i), false);
+
+  theGraph->startAddEdge();
+  for (unsigned int k=0; k<cliques.size(); k++) {
+    const ID &id = cliques[k];
+    for (int i=0; i<id.Size(); i++) {
+      if (id(i) < 0)
+	continue;
+      for (int j=i+1; j<id.Size(); j++)
+	if (id(j) >= 0)
+	  theGraph->addEdgeFast(newEqn[id(i)], newEqn[id(j)]);
+    }
+  }
+
+  return theGraph;
+}
+
+static Graph *
+csrGraph(const std::vector<int> &newEqn)
+{
+  CSRGraph *theGraph = new CSRGraph(numEqn);
+  for (unsigned int k=0; k<cliques.size(); k++) {
+    ID id(cliques[k]);
+    for (int i=0; i<id.Size(); i++)
+      if (id(i) >= 0)
+	id(i) = newEqn[id(i)];
+    theGraph->addClique(id);
+  }
+  theGraph->build();
+
+  return theGraph;
+}
+
+int main(int argc, char **argv)
+{
+  int numErrors = 0;
+
+  buildCliques();
+
+  std::vector<int> identity(numEqn);
+  for (int i=0; i<numEqn; i++)
+    identity[i] = i;
+
+  // the adjacency of the two graphs
+  Graph *theVertexGraph = vertexGraph(identity, false);
+  Graph *theCSRGraph = csrGraph(identity);
+  const int *rowStart1, *adjacency1, *rowStart2, *adjacency2;
+  if (theVertexGraph->getCSR(rowStart1, adjacency1) != 0 ||
+      theCSRGraph->getCSR(rowStart2, adjacency2) != 0) {
+    opserr << "getCSR failed\n";
+    return 1;
+  }
+  if (theVertexGraph->getNumEdge() != theCSRGraph->getNumEdge()) {
+    opserr << "number of edges: " << theVertexGraph->getNumEdge() << " "
+	   << theCSRGraph->getNumEdge() << endln;
+    numErrors++;
+  }
+  for (int i=0; i<=numEqn && numErrors == 0; i++) {
+    if (rowStart1[i] != rowStart2[i]) {
+      opserr << "row start " << i << ": " << rowStart1[i] << " "
+	     << rowStart2[i] << endln;
+      numErrors++;
+    }
+  }
+  for (int i=0; numErrors == 0 && i<rowStart1[numEqn]; i++) {
+    if (adjacency1[i] != adjacency2[i]) {
+      opserr << "adjacency " << i << ": " << adjacency1[i] << " "
+	     << adjacency2[i] << endln;
+      numErrors++;
+    }
+  }
+  delete theVertexGraph;
+  delete theCSRGraph;
+
+  // RCM with and without GPS, and from a given start vertex
+  for (int variant=0; variant<3; variant++) {
+    bool GPS = (variant == 1);
+    int startVertex = (variant == 2) ? numEqn/3 : -1;
+
+    Graph *theGraph1 = vertexGraph(identity, true);
+    Graph *theGraph2 = csrGraph(identity);
+    RCM theRCM1(GPS);
+    RCM theRCM2(GPS);
+    const ID &order1 = theRCM1.number(*theGraph1, startVertex);
+    const ID &order2 = theRCM2.number(*theGraph2, startVertex);
+
+    if (order1.Size() != numEqn || order2.Size() != numEqn) {
+      opserr << "RCM variant " << variant << ": sizes " << order1.Size()
+	     << " " << order2.Size() << endln;
+      numErrors++;
+    } else {
+      for (int i=0; i<numEqn; i++) {
+	if (order1(i) != order2(i)) {
+	  opserr << "RCM variant " << variant << ": position " << i << ": "
+		 << order1(i) << " " << order2(i) << endln;
+	  numErrors++;
+	  break;
+	}
+      }
+    }
+
+    if (numErrors != 0) {
+      delete theGraph1;
+      delete theGraph2;
+      continue;
+    }
+
+    // the SOE sizes on the renumbered graphs
+    std::vector<int> newEqn(numEqn);
+    for (int i=0; i<numEqn; i++)
+      newEqn[order1(i)] = i;
+
+    delete theGraph1;
+    delete theGraph2;
+    theGraph1 = vertexGraph(newEqn, false);
+    theGraph2 = csrGraph(newEqn);
+
+    // the sizes as the Vertex based setSize() computed them
+    int numSuperD = 0, numSubD = 0, halfBand = 0, profileSize = 0;
+    std::vector<int> height(numEqn, 0);
+    Vertex *vertexPtr;
+    VertexIter &theVertices = theGraph1->getVertices();
+    while ((vertexPtr = theVertices()) != 0) {
+      int vertexNum = vertexPtr->getTag();
+      const ID &theAdjacency = vertexPtr->getAdjacency();
+      for (int i=0; i<theAdjacency.Size(); i++) {
+	int diff = vertexNum - theAdjacency(i);
+	if (diff > 0) {
+	  if (diff > numSuperD)
+	    numSuperD = diff;
+	  if (diff > height[vertexNum])
+	    height[vertexNum] = diff;
+	} else if (diff < numSubD)
+	  numSubD = diff;
+	if (halfBand < diff)
+	  halfBand = diff;
+      }
+    }
+    numSubD *= -1;
+    halfBand += 1;
+    for (int i=0; i<numEqn; i++)
+      profileSize += height[i] + 1;
+
+    Graph *theGraphs[2] = {theGraph1, theGraph2};
+    for (int g=0; g<2; g++) {
+      // the SOEs delete their solvers
+      TestBandGenLinSOE theBandGenSOE(*(new BandGenLinLapackSolver()));
+      TestBandSPDLinSOE theBandSPDSOE(*(new BandSPDLinLapackSolver()));
+      TestProfileSPDLinSOE theProfileSOE(*(new ProfileSPDLinDirectSolver()));
+
+      if (theBandGenSOE.setSize(*theGraphs[g]) != 0 ||
+	  theBandSPDSOE.setSize(*theGraphs[g]) != 0 ||
+	  theProfileSOE.setSize(*theGraphs[g]) != 0) {
+	opserr << "RCM variant " << variant << ": setSize failed\n";
+	numErrors++;
+	continue;
+      }
+      if (theBandGenSOE.getNumEqn() != numEqn ||
+	  theBandGenSOE.getNumSuperD() != numSuperD ||
+	  theBandGenSOE.getNumSubD() != numSubD ||
+	  theBandSPDSOE.getHalfBand() != halfBand ||
+	  theProfileSOE.getProfileSize() != profileSize) {
+	opserr << "RCM variant " << variant << (g == 0 ? " Graph" : " CSRGraph")
+	       << ": size " << theBandGenSOE.getNumEqn()
+	       << " super " << theBandGenSOE.getNumSuperD()
+	       << " sub " << theBandGenSOE.getNumSubD()
+	       << " half band " << theBandSPDSOE.getHalfBand()
+	       << " profile " << theProfileSOE.getProfileSize()
+	       << ", expected " << numEqn << " " << numSuperD << " " << numSubD
+	       << " " << halfBand << " " << profileSize << endln;
+	numErrors++;
+      }
+    }
+
+    delete theGraph1;
+    delete theGraph2;
+  }
+
+  if (numErrors == 0)
+    opserr << "rcmTest: " << numEqn << " equations PASSED\n";
+  else
+    opserr << "rcmTest: " << numErrors << " errors FAILED\n";
+
+  return numErrors == 0 ? 0 : 1;
+}
@@ -189,6 +189,45 @@ Metis::setDefaultOptions(void)
 }
 
 
+// static int buildAdjacency(Graph &theGraph, int numVertex,
+//                           int *xadj, int *adjncy);
+//    fills in the adjacency structure metis needs, copied from the
+//    compressed row form of the graph if it provides one. Returns -1
+//    if the vertices are not numbered consecutively.
+
+static int
+buildAdjacency(Graph &theGraph, int numVertex, int *xadj, int *adjncy)
+{
+  const int *rowStart, *adjacency;
+  if (START_VERTEX_NUM == 0 && theGraph.getCSR(rowStart, adjacency) == 0) {
+    for (int i = 0; i <= numVertex; i++)
+      xadj[i] = rowStart[i];
+    for (int i = 0; i < rowStart[numVertex]; i++)
+      adjncy[i] = adjacency[i];
+    return 0;
+  }
+
+  int indexEdge = 0;
+  xadj[0] = 0;
+
+  for (int vertex = 0; vertex < numVertex; vertex++) {
+    Vertex *vertexPtr = theGraph.getVertexPtr(vertex + START_VERTEX_NUM);
+    if (vertexPtr == 0)
+      return -1;
+
+    const ID&adjacency = vertexPtr->getAdjacency();
+    int degree = adjacency.Size();
+    for (int i = 0; i < degree; i++) {
+      adjncy[indexEdge++] = adjacency(i) - START_VERTEX_NUM;
+    }
+
+    xadj[vertex + 1] = indexEdge;
+  }
+
+  return 0;
+}
+
+
 // int partition(Graph &theGraph, int numPart)
 //    Method to partition the graph. It first creates the arrays needed
 //    by the metis lib and then invokes a function from the metis lib to
@@ -215,7 +254,7 @@ Metis::partition(Graph &theGraph, int numPart)
   int *vwgts = 0;
   int *ewgts = 0;
   int numbering = 0;
-  int weightflag = 0; // no weights on our graphs yet
+  int weightflag = 0; // no weights unless the vertices have them
 
   if (START_VERTEX_NUM == 0)
     numbering = 0;
@@ -237,38 +276,37 @@ Metis::partition(Graph &theGraph, int numPart)
 
   // we build these data structures
 
-  int indexEdge = 0;
-  xadj[0] = 0;
-
   Vertex *vertexPtr;
-  for (int vertex = 0; vertex < numVertex; vertex++) {
-    vertexPtr = theGraph.getVertexPtr(vertex + START_VERTEX_NUM);
-
-    // check we don't have an invalid vertex numbering scheme
-    // if so WARNING message, clean up and return -2
-
-    if (vertexPtr == 0) {
-      opserr << "WARNING Metis::partition - No partitioning done";
-      opserr << " Metis requires consecutive Vertex Numbering\n";
+  if (buildAdjacency(theGraph, numVertex, xadj, adjncy) < 0) {
+    opserr << "WARNING Metis::partition - No partitioning done";
+    opserr << " Metis requires consecutive Vertex Numbering\n";
 
-      delete [] options;
-      delete [] partition;
-      delete [] xadj;
-      delete [] adjncy;
+    delete [] options;
+    delete [] partition;
+    delete [] xadj;
+    delete [] adjncy;
 
-      return -2;
-    }
+    return -2;
+  }
 
-    const ID&adjacency = vertexPtr->getAdjacency();
-    int degree = adjacency.Size();
-    for (int i = 0; i < degree; i++) {
-      adjncy[indexEdge++] = adjacency(i) - START_VERTEX_NUM;
+  // the vertex weights, e.g. the measured cost of the elements, are
+  // scaled to integers from 1 to 1000
+  double maxWeight = 0.0;
+  for (int vert = 0; vert < numVertex; vert++) {
+    vertexPtr = theGraph.getVertexPtr(vert + START_VERTEX_NUM);
+    if (vertexPtr != 0 && vertexPtr->getWeight() > maxWeight)
+      maxWeight = vertexPtr->getWeight();
+  }
+  if (maxWeight > 0.0) {
+    vwgts = new int [numVertex];
+    for (int vert = 0; vert < numVertex; vert++) {
+      vertexPtr = theGraph.getVertexPtr(vert + START_VERTEX_NUM);
+      double weight = (vertexPtr != 0 && vertexPtr->getWeight() > 0.0) ? vertexPtr->getWeight() : 0.0;
+      vwgts[vert] = 1 + (int)(999.0*weight/maxWeight);
     }
-
-    xadj[vertex + 1] = indexEdge;
+    weightflag = 2; // weights on the vertices only
   }
 
-
   if (defaultOptions == true)
     options[0] = 0;
   else {
@@ -341,6 +379,8 @@ Metis::partition(Graph &theGraph, int numPart)
   delete [] partition;
   delete [] xadj;
   delete [] adjncy;
+  if (vwgts != 0)
+    delete [] vwgts;
 
   return 0;
 }
@@ -469,35 +509,17 @@ Metis::number(Graph &theGraph, int lastVertex)
 
   // we build these data structures
 
-  int indexEdge = 0;
-  xadj[0] = 0;
-
   Vertex *vertexPtr;
-  for (int vertex = 0; vertex < numVertex; vertex++) {
-    vertexPtr = theGraph.getVertexPtr(vertex + START_VERTEX_NUM);
-
-    // check we don't have an invalid vertex numbering scheme
-    // if so WARNING message, clean up and return -2
-
-    if (vertexPtr == 0) {
-      opserr << "WARNING Metis::partition - No partitioning done";
-      opserr << " Metis requires consecutive Vertex Numbering\n";
-
-      delete [] options;
-      delete [] partition;
-      delete [] xadj;
-      delete [] adjncy;
+  if (buildAdjacency(theGraph, numVertex, xadj, adjncy) < 0) {
+    opserr << "WARNING Metis::partition - No partitioning done";
+    opserr << " Metis requires consecutive Vertex Numbering\n";
 
-      return *theRefResult;
-    }
+    delete [] options;
+    delete [] partition;
+    delete [] xadj;
+    delete [] adjncy;
 
-    const ID&adjacency = vertexPtr->getAdjacency();
-    int degree = adjacency.Size();
-    for (int i = 0; i < degree; i++) {
-      adjncy[indexEdge++] = adjacency(i) - START_VERTEX_NUM;
-    }
-
-    xadj[vertex + 1] = indexEdge;
+    return *theRefResult;
   }
 
 
@@ -0,0 +1,458 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation of AsyncStream.
+
+#include <AsyncStream.h>
+#include <ID.h>
+
+AsyncStream::AsyncStream(OPS_Stream *stream, int numRecords)
+  :OPS_Stream(stream->getClassTag()), theStream(stream), synchronous(false),
+   theRecords(numRecords > 0 ? numRecords : 1), first(0), numPending(0),
+   done(false), writeError(0)
+{
+  theWriter = std::thread(&AsyncStream::writeRecords, this);
+}
+
+
+AsyncStream::~AsyncStream()
+{
+  this->stopWriter();
+  delete theStream;
+}
+
+
+// void stopWriter(void);
+// Lets the writer thread empty the ring and return; the data is then
+// written directly by the calling thread.
+
+void
+AsyncStream::stopWriter(void)
+{
+  if (synchronous == true)
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(theMutex);
+    done = true;
+  }
+  recordAdded.notify_one();
+  theWriter.join();
+  synchronous = true;
+}
+
+
+// void writeRecords(void);
+// The writer thread, passes the records in the ring to the wrapped stream
+// in the order they were added. A record stays in the ring while it is
+// being written, so its slot is not reused before the write returns.
+
+void
+AsyncStream::writeRecords(void)
+{
+  Vector data;
+  Vector empty;
+  int numRecords = theRecords.size();
+
+  std::unique_lock<std::mutex> lock(theMutex);
+  while (true) {
+    recordAdded.wait(lock, [this] {return numPending > 0 || done == true;});
+    if (numPending == 0)
+      break;
+
+    std::vector<double> &theRecord = theRecords[first];
+    lock.unlock();
+
+    int res;
+    if (theRecord.empty() == true)
+      res = theStream->write(empty);
+    else {
+      data.setData(theRecord.data(), theRecord.size());
+      res = theStream->write(data);
+    }
+
+    lock.lock();
+    if (res < 0)
+      writeError = res;
+    first = (first + 1) % numRecords;
+    numPending--;
+    recordWritten.notify_all();
+  }
+}
+
+
+// void drain(void);
+// Waits until the writer thread has written all the records, after which
+// the wrapped stream may be used from the calling thread.
+
+void
+AsyncStream::drain(void)
+{
+  if (synchronous == true)
+    return;
+
+  std::unique_lock<std::mutex> lock(theMutex);
+  recordWritten.wait(lock, [this] {return numPending == 0;});
+}
+
+
+int
+AsyncStream::write(Vector &data)
+{
+  if (synchronous == true)
+    return theStream->write(data);
+
+  int numRecords = theRecords.size();
+
+  // wait for a free slot if the writer has fallen behind
+  std::unique_lock<std::mutex> lock(theMutex);
+  recordWritten.wait(lock, [this, numRecords] {return numPending < numRecords;});
+  int last = (first + numPending) % numRecords;
+  int res = writeError;
+  writeError = 0;
+  lock.unlock();
+
+  // the slot is not seen by the writer until numPending is incremented
+  std::vector<double> &theRecord = theRecords[last];
+  int size = data.Size();
+  theRecord.resize(size);
+  for (int i=0; i<size; i++)
+    theRecord[i] = data(i);
+
+  lock.lock();
+  numPending++;
+  lock.unlock();
+  recordAdded.notify_one();
+
+  return res;
+}
+
+
+int
+AsyncStream::flush()
+{
+  this->drain();
+
+  int res = theStream->flush();
+  if (writeError < 0) {
+    res = writeError;
+    writeError = 0;
+  }
+
+  return res;
+}
+
+
+int
+AsyncStream::setFile(const char *fileName, openMode mode, bool echo)
+{
+  this->drain();
+  return theStream->setFile(fileName, mode, echo);
+}
+
+int
+AsyncStream::setPrecision(int prec)
+{
+  this->drain();
+  return theStream->setPrecision(prec);
+}
+
+int
+AsyncStream::setFloatField(floatField field)
+{
+  this->drain();
+  return theStream->setFloatField(field);
+}
+
+int
+AsyncStream::precision(int prec)
+{
+  this->drain();
+  return theStream->precision(prec);
+}
+
+int
+AsyncStream::width(int w)
+{
+  this->drain();
+  return theStream->width(w);
+}
+
+int
+AsyncStream::tag(const char *tagName)
+{
+  this->drain();
+  return theStream->tag(tagName);
+}
+
+int
+AsyncStream::tag(const char *tagName, const char *value)
+{
+  this->drain();
+  return theStream->tag(tagName, value);
+}
+
+int
+AsyncStream::endTag()
+{
+  this->drain();
+  return theStream->endTag();
+}
+
+int
+AsyncStream::attr(const char *name, int value)
+{
+  this->drain();
+  return theStream->attr(name, value);
+}
+
+int
+AsyncStream::attr(const char *name, double value)
+{
+  this->drain();
+  return theStream->attr(name, value);
+}
+
+int
+AsyncStream::attr(const char *name, const char *value)
+{
+  this->drain();
+  return theStream->attr(name, value);
+}
+
+int
+AsyncStream::open(void)
+{
+  this->drain();
+  return theStream->open();
+}
+
+int
+AsyncStream::close(openMode nextOpen)
+{
+  this->drain();
+  return theStream->close(nextOpen);
+}
+
+OPS_Stream &
+AsyncStream::write(const char *s, int n)
+{
+  this->drain();
+  theStream->write(s, n);
+  return *this;
+}
+
+OPS_Stream &
+AsyncStream::write(const unsigned char *s, int n)
+{
+  this->drain();
+  theStream->write(s, n);
+  return *this;
+}
+
+OPS_Stream &
+AsyncStream::write(const signed char *s, int n)
+{
+  this->drain();
+  theStream->write(s, n);
+  return *this;
+}
+
+OPS_Stream &
+AsyncStream::write(const void *s, int n)
+{
+  this->drain();
+  theStream->write(s, n);
+  return *this;
+}
+
+OPS_Stream &
+AsyncStream::write(const double *s, int n)
+{
+  this->drain();
+  theStream->write(s, n);
+  return *this;
+}
+
+OPS_Stream &
+AsyncStream::operator<<(char c)
+{
+  this->drain();
+  *theStream << c;
+  return *this;
+}
+
+OPS_Stream &
+AsyncStream::operator<<(unsigned char c)
+{
+  this->drain();
+  *theStream << c;
+  return *this;
+}
+
+OPS_Stream &
+AsyncStream::operator<<(signed char c)
+{
+  this->drain();
+  *theStream << c;
+  return *this;
+}
+
+OPS_Stream &
+AsyncStream::operator<<(const char *s)
+{
+  this->drain();
+  *theStream << s;
+  return *this;
+}
+
+OPS_Stream &
+AsyncStream::operator<<(const unsigned char *s)
+{
+  this->drain();
+  *theStream << s;
+  return *this;
+}
+
+OPS_Stream &
+AsyncStream::operator<<(const signed char *s)
+{
+  this->drain();
+  *theStream << s;
+  return *this;
+}
+
+OPS_Stream &
+AsyncStream::operator<<(const void *p)
+{
+  this->drain();
+  *theStream << p;
+  return *this;
+}
+
+OPS_Stream &
+AsyncStream::operator<<(int n)
+{
+  this->drain();
+  *theStream << n;
+  return *this;
+}
+
+OPS_Stream &
+AsyncStream::operator<<(unsigned int n)
+{
+  this->drain();
+  *theStream << n;
+  return *this;
+}
+
+OPS_Stream &
+AsyncStream::operator<<(long n)
+{
+  this->drain();
+  *theStream << n;
+  return *this;
+}
+
+OPS_Stream &
+AsyncStream::operator<<(unsigned long n)
+{
+  this->drain();
+  *theStream << n;
+  return *this;
+}
+
+OPS_Stream &
+AsyncStream::operator<<(short n)
+{
+  this->drain();
+  *theStream << n;
+  return *this;
+}
+
+OPS_Stream &
+AsyncStream::operator<<(unsigned short n)
+{
+  this->drain();
+  *theStream << n;
+  return *this;
+}
+
+OPS_Stream &
+AsyncStream::operator<<(bool b)
+{
+  this->drain();
+  *theStream << b;
+  return *this;
+}
+
+OPS_Stream &
+AsyncStream::operator<<(double n)
+{
+  this->drain();
+  *theStream << n;
+  return *this;
+}
+
+OPS_Stream &
+AsyncStream::operator<<(float n)
+{
+  this->drain();
+  *theStream << n;
+  return *this;
+}
+
+void
+AsyncStream::setAddCommon(int flag)
+{
+  this->drain();
+  theStream->setAddCommon(flag);
+}
+
+int
+AsyncStream::setOrder(const ID &order)
+{
+  this->drain();
+  return theStream->setOrder(order);
+}
+
+
+// sendSelf() and recvSelf():
+// in a parallel run the wrapped stream talks over its channels, which is
+// left to the main thread: the writer thread is stopped and from then on
+// the data is written directly. The remote side builds the wrapped
+// stream, whose class tag the AsyncStream carries.
+
+int
+AsyncStream::sendSelf(int commitTag, Channel &theChannel)
+{
+  this->stopWriter();
+
+  return theStream->sendSelf(commitTag, theChannel);
+}
+
+int
+AsyncStream::recvSelf(int commitTag, Channel &theChannel,
+		      FEM_ObjectBroker &theBroker)
+{
+  this->stopWriter();
+
+  return theStream->recvSelf(commitTag, theChannel, theBroker);
+}
@@ -0,0 +1,116 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef _AsyncStream
+#define _AsyncStream
+
+// Description: An AsyncStream wraps the OPS_Stream of a recorder and
+// moves the formatting and output of the recorded data to a writer
+// thread. write(Vector &) only copies the data into a ring of numRecords
+// slots, which the writer thread empties into the wrapped stream; if the
+// ring is full the recorder waits for a slot, so memory stays bounded.
+// Every other method first waits for the ring to empty and then invokes
+// the wrapped stream, keeping the order of headers, data and flushes.
+// The ring is emptied when the stream is flushed, closed or deleted.
+
+#include <OPS_Stream.h>
+#include <Vector.h>
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+class AsyncStream : public OPS_Stream
+{
+ public:
+  AsyncStream(OPS_Stream *theStream, int numRecords = 1024);
+  ~AsyncStream();
+
+  int setFile(const char *fileName, openMode mode = OVERWRITE, bool echo = false);
+  int setPrecision(int precision);
+  int setFloatField(floatField);
+  int precision(int precision);
+  int width(int width);
+
+  // xml stuff
+  int tag(const char *);
+  int tag(const char *, const char *);
+  int endTag();
+  int attr(const char *name, int value);
+  int attr(const char *name, double value);
+  int attr(const char *name, const char *value);
+  int write(Vector &data);
+  int flush();
+  int open(void);
+  int close(openMode nextOpen = APPEND);
+
+  // regular stuff
+  OPS_Stream& write(const char *s, int n);
+  OPS_Stream& write(const unsigned char *s, int n);
+  OPS_Stream& write(const signed char *s, int n);
+  OPS_Stream& write(const void *s, int n);
+  OPS_Stream& write(const double *s, int n);
+
+  OPS_Stream& operator<<(char c);
+  OPS_Stream& operator<<(unsigned char c);
+  OPS_Stream& operator<<(signed char c);
+  OPS_Stream& operator<<(const char *s);
+  OPS_Stream& operator<<(const unsigned char *s);
+  OPS_Stream& operator<<(const signed char *s);
+  OPS_Stream& operator<<(const void *p);
+  OPS_Stream& operator<<(int n);
+  OPS_Stream& operator<<(unsigned int n);
+  OPS_Stream& operator<<(long n);
+  OPS_Stream& operator<<(unsigned long n);
+  OPS_Stream& operator<<(short n);
+  OPS_Stream& operator<<(unsigned short n);
+  OPS_Stream& operator<<(bool b);
+  OPS_Stream& operator<<(double n);
+  OPS_Stream& operator<<(float n);
+
+  // parallel stuff
+  void setAddCommon(int);
+  int setOrder(const ID &order);
+  int sendSelf(int commitTag, Channel &theChannel);
+  int recvSelf(int commitTag, Channel &theChannel,
+	       FEM_ObjectBroker &theBroker);
+
+ private:
+  void drain(void);
+  void stopWriter(void);
+  void writeRecords(void);
+
+  OPS_Stream *theStream;
+  bool synchronous;       // no writer thread, e.g. once the stream is sent
+
+  std::vector<std::vector<double> > theRecords;
+  int first;              // oldest record not yet written
+  int numPending;         // records in the ring, including one being written
+  bool done;
+  int writeError;
+
+  std::mutex theMutex;
+  std::condition_variable recordAdded;
+  std::condition_variable recordWritten;
+  std::thread theWriter;
+};
+
+#endif
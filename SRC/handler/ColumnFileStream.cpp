@@ -0,0 +1,500 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation of ColumnFileStream
+// and of columnFileToText().
+
+#include <ColumnFileStream.h>
+#include <Vector.h>
+#include <ID.h>
+#include <iostream>
+#include <iomanip>
+#include <string.h>
+#include <stdio.h>
+
+using std::ios;
+using std::ifstream;
+using std::ofstream;
+
+#define COLUMN_FILE_MAGIC        "OPSCOLS"
+#define COLUMN_FILE_VERSION      1
+#define COLUMN_FILE_HEADER_SIZE  40
+#define COLUMN_FILE_CHUNK_BYTES  1048576
+#define COLUMN_FILE_MIN_ROWS     16
+
+ColumnFileStream::ColumnFileStream(const char *file, openMode mode,
+				   bool singlePrecision)
+  :OPS_Stream(OPS_STREAM_TAGS_ColumnFileStream),
+   fileOpen(0), theOpenMode(OVERWRITE), fileName(0),
+   valueSize(singlePrecision ? 4 : 8), numColumns(0), chunkRows(0),
+   numRows(0), endOfData(COLUMN_FILE_HEADER_SIZE), numBuffered(0)
+{
+  this->setFile(file, mode);
+}
+
+ColumnFileStream::~ColumnFileStream()
+{
+  this->close();
+
+  if (fileName != 0)
+    delete [] fileName;
+}
+
+int
+ColumnFileStream::setFile(const char *name, openMode mode, bool echo)
+{
+  if (name == 0) {
+    std::cerr << "ColumnFileStream::setFile() - no name passed\n";
+    return -1;
+  }
+
+  // if file already open, finish it
+  if (fileOpen == 1)
+    this->close();
+
+  if (fileName != 0)
+    delete [] fileName;
+
+  fileName = new char[strlen(name)+1];
+  strcpy(fileName, name);
+
+  theOpenMode = mode;
+
+  return 0;
+}
+
+int
+ColumnFileStream::open(void)
+{
+  // check setFile has been called
+  if (fileName == 0) {
+    std::cerr << "ColumnFileStream::open(void) - no file name has been set\n";
+    return -1;
+  }
+
+  // if file already open, return
+  if (fileOpen == 1)
+    return 0;
+
+  // appending continues a file this stream closed, overwriting the index
+  if (theOpenMode == APPEND && chunkOffsets.empty() == false) {
+    theFile.open(fileName, ios::in | ios::out | ios::binary);
+  } else {
+    theFile.open(fileName, ios::out | ios::trunc | ios::binary);
+    numColumns = 0;
+    chunkRows = 0;
+    numRows = 0;
+    endOfData = COLUMN_FILE_HEADER_SIZE;
+    chunkOffsets.clear();
+    numBuffered = 0;
+  }
+
+  theOpenMode = APPEND;
+
+  if (theFile.fail()) {
+    std::cerr << "WARNING - ColumnFileStream::open()";
+    std::cerr << " - could not open file " << fileName << std::endl;
+    theFile.clear();
+    fileOpen = 0;
+    return -1;
+  }
+
+  fileOpen = 1;
+
+  // the index is rewritten when the file is closed
+  return this->writeHeader(0);
+}
+
+int
+ColumnFileStream::close(openMode nextOpen)
+{
+  if (fileOpen == 0) {
+    theOpenMode = nextOpen;
+    return 0;
+  }
+
+  int res = this->writeChunk();
+
+  // write the index after the last chunk
+  theFile.seekp(endOfData);
+  long long numChunks = chunkOffsets.size();
+  theFile.write((const char *)&numChunks, sizeof(long long));
+  if (numChunks > 0)
+    theFile.write((const char *)chunkOffsets.data(), numChunks*sizeof(long long));
+
+  int numNames = columnNames.size();
+  theFile.write((const char *)&numNames, sizeof(int));
+  for (int i=0; i<numNames; i++) {
+    int length = columnNames[i].size();
+    theFile.write((const char *)&length, sizeof(int));
+    theFile.write(columnNames[i].data(), length);
+  }
+
+  if (this->writeHeader(endOfData) < 0)
+    res = -1;
+
+  theFile.close();
+  fileOpen = 0;
+  theOpenMode = nextOpen;
+
+  return res;
+}
+
+int
+ColumnFileStream::flush()
+{
+  if (fileOpen == 0)
+    return 0;
+
+  int res = this->writeChunk();
+  theFile.flush();
+
+  return res;
+}
+
+int
+ColumnFileStream::tag(const char *tagName)
+{
+  theTags.push_back(tagName);
+  return 0;
+}
+
+int
+ColumnFileStream::tag(const char *tagName, const char *value)
+{
+  // each response in the recorder header names a column
+  if (strcmp(tagName, "ResponseType") != 0)
+    return 0;
+
+  std::string name;
+  for (const std::string &theTag : theTags) {
+    name += theTag;
+    name += '/';
+  }
+  name += value;
+  columnNames.push_back(name);
+
+  return 0;
+}
+
+int
+ColumnFileStream::endTag()
+{
+  if (theTags.empty() == false)
+    theTags.pop_back();
+  return 0;
+}
+
+int
+ColumnFileStream::attr(const char *name, int value)
+{
+  if (theTags.empty() == false)
+    theTags.back() += " " + std::string(name) + "=" + std::to_string(value);
+  return 0;
+}
+
+int
+ColumnFileStream::attr(const char *name, double value)
+{
+  if (theTags.empty() == false) {
+    char buffer[32];
+    snprintf(buffer, 32, "%.10g", value);
+    theTags.back() += " " + std::string(name) + "=" + buffer;
+  }
+  return 0;
+}
+
+int
+ColumnFileStream::attr(const char *name, const char *value)
+{
+  if (theTags.empty() == false)
+    theTags.back() += " " + std::string(name) + "=" + value;
+  return 0;
+}
+
+int
+ColumnFileStream::write(Vector &data)
+{
+  if (fileOpen == 0)
+    if (this->open() < 0)
+      return -1;
+
+  int size = data.Size();
+
+  // the first row fixes the number of columns and the chunk size
+  if (numColumns == 0 && chunkOffsets.empty() == true) {
+    if (size == 0)
+      return 0;
+    numColumns = size;
+    chunkRows = COLUMN_FILE_CHUNK_BYTES/(numColumns*valueSize);
+    if (chunkRows < COLUMN_FILE_MIN_ROWS)
+      chunkRows = COLUMN_FILE_MIN_ROWS;
+    theChunk.resize((size_t)numColumns*chunkRows);
+    if (this->writeHeader(0) < 0)
+      return -1;
+  }
+
+  if (size != numColumns) {
+    std::cerr << "ColumnFileStream::write() - " << fileName << ": row has " << size
+	      << " values, the file has " << numColumns << " columns\n";
+    return -1;
+  }
+
+  double *column = &theChunk[numBuffered];
+  for (int i=0; i<numColumns; i++, column += chunkRows)
+    *column = data(i);
+  numBuffered++;
+
+  if (numBuffered == chunkRows)
+    return this->writeChunk();
+
+  return 0;
+}
+
+int
+ColumnFileStream::sendSelf(int commitTag, Channel &theChannel)
+{
+  std::cerr << "ColumnFileStream::sendSelf() - not available in parallel, use -binary or -file\n";
+  return -1;
+}
+
+int
+ColumnFileStream::recvSelf(int commitTag, Channel &theChannel,
+			   FEM_ObjectBroker &theBroker)
+{
+  std::cerr << "ColumnFileStream::recvSelf() - not available in parallel, use -binary or -file\n";
+  return -1;
+}
+
+
+// int writeHeader(long long indexOffset);
+// Writes the header at the start of the file and returns to the end of
+// the data.
+
+int
+ColumnFileStream::writeHeader(long long indexOffset)
+{
+  char magic[8] = COLUMN_FILE_MAGIC;
+  int version = COLUMN_FILE_VERSION;
+
+  theFile.seekp(0);
+  theFile.write(magic, 8);
+  theFile.write((const char *)&version, sizeof(int));
+  theFile.write((const char *)&valueSize, sizeof(int));
+  theFile.write((const char *)&numColumns, sizeof(int));
+  theFile.write((const char *)&chunkRows, sizeof(int));
+  theFile.write((const char *)&numRows, sizeof(long long));
+  theFile.write((const char *)&indexOffset, sizeof(long long));
+  theFile.seekp(endOfData);
+
+  if (theFile.fail()) {
+    std::cerr << "WARNING - ColumnFileStream - could not write file " << fileName << std::endl;
+    return -1;
+  }
+
+  return 0;
+}
+
+
+// int writeChunk(void);
+// Writes the buffered rows as a chunk, column after column.
+
+int
+ColumnFileStream::writeChunk(void)
+{
+  if (numBuffered == 0)
+    return 0;
+
+  long long n = numBuffered;
+  theFile.seekp(endOfData);
+  theFile.write((const char *)&n, sizeof(long long));
+
+  for (int i=0; i<numColumns; i++) {
+    const double *column = &theChunk[(size_t)i*chunkRows];
+    if (valueSize == 8)
+      theFile.write((const char *)column, n*sizeof(double));
+    else {
+      theFloats.resize(n);
+      for (int j=0; j<n; j++)
+	theFloats[j] = column[j];
+      theFile.write((const char *)theFloats.data(), n*sizeof(float));
+    }
+  }
+
+  if (theFile.fail()) {
+    std::cerr << "WARNING - ColumnFileStream - could not write file " << fileName << std::endl;
+    return -1;
+  }
+
+  chunkOffsets.push_back(endOfData);
+  endOfData += sizeof(long long) + n*numColumns*valueSize;
+  numRows += n;
+  numBuffered = 0;
+
+  return 0;
+}
+
+
+int
+columnFileToText(const char *inputFilename, const char *outputFilename,
+		 const ID &columns, bool writeNames)
+{
+  ifstream input(inputFilename, ios::in | ios::binary);
+  if (input.fail()) {
+    std::cerr << "WARNING - columnFileToText()";
+    std::cerr << " - could not open file " << inputFilename << std::endl;
+    return -1;
+  }
+
+  char magic[8];
+  int version, valueSize, numColumns, chunkRows;
+  long long numRows, indexOffset;
+  input.read(magic, 8);
+  input.read((char *)&version, sizeof(int));
+  input.read((char *)&valueSize, sizeof(int));
+  input.read((char *)&numColumns, sizeof(int));
+  input.read((char *)&chunkRows, sizeof(int));
+  input.read((char *)&numRows, sizeof(long long));
+  input.read((char *)&indexOffset, sizeof(long long));
+
+  if (input.fail() || strcmp(magic, COLUMN_FILE_MAGIC) != 0 ||
+      version != COLUMN_FILE_VERSION || (valueSize != 4 && valueSize != 8)) {
+    std::cerr << "WARNING - columnFileToText() - " << inputFilename
+	      << " is not a column file\n";
+    return -1;
+  }
+
+  std::vector<long long> chunkOffsets;
+  std::vector<std::string> columnNames;
+
+  input.seekg(0, ios::end);
+  long long fileSize = input.tellg();
+
+  if (indexOffset != 0) {
+    input.seekg(indexOffset);
+    long long numChunks = 0;
+    input.read((char *)&numChunks, sizeof(long long));
+    chunkOffsets.resize(numChunks);
+    if (numChunks > 0)
+      input.read((char *)chunkOffsets.data(), numChunks*sizeof(long long));
+
+    int numNames = 0;
+    input.read((char *)&numNames, sizeof(int));
+    for (int i=0; i<numNames && input.good(); i++) {
+      int length = 0;
+      input.read((char *)&length, sizeof(int));
+      std::string name(length, ' ');
+      input.read(&name[0], length);
+      columnNames.push_back(name);
+    }
+  } else {
+    // the run did not finish, walk the complete chunks
+    long long offset = COLUMN_FILE_HEADER_SIZE;
+    while (offset + (long long)sizeof(long long) <= fileSize) {
+      long long n = 0;
+      input.seekg(offset);
+      input.read((char *)&n, sizeof(long long));
+      long long next = offset + sizeof(long long) + n*numColumns*valueSize;
+      if (input.fail() || n <= 0 || next > fileSize)
+	break;
+      chunkOffsets.push_back(offset);
+      offset = next;
+    }
+  }
+
+  if (input.fail()) {
+    std::cerr << "WARNING - columnFileToText() - could not read the index of "
+	      << inputFilename << std::endl;
+    return -1;
+  }
+
+  // no columns given means all of them
+  int numSelected = columns.Size();
+  ID selected(numSelected > 0 ? numSelected : numColumns);
+  for (int i=0; i<selected.Size(); i++) {
+    selected(i) = (numSelected > 0) ? columns(i) : i;
+    if (selected(i) < 0 || selected(i) >= numColumns) {
+      std::cerr << "WARNING - columnFileToText() - " << inputFilename << " has no column "
+		<< selected(i) << ", columns 0 to " << numColumns-1 << "\n";
+      return -1;
+    }
+  }
+
+  ofstream output(outputFilename, ios::out);
+  if (output.fail()) {
+    std::cerr << "WARNING - columnFileToText()";
+    std::cerr << " - could not open file " << outputFilename << std::endl;
+    return -1;
+  }
+  output << std::setprecision(valueSize == 8 ? 17 : 9);
+
+  if (writeNames == true) {
+    output << "#";
+    for (int i=0; i<selected.Size(); i++) {
+      int column = selected(i);
+      if (column < (int)columnNames.size())
+	output << " \"" << columnNames[column] << "\"";
+      else
+	output << " \"" << column << "\"";
+    }
+    output << "\n";
+  }
+
+  // read the wanted columns of each chunk and write them as rows
+  int numOut = selected.Size();
+  std::vector<double> values;
+  std::vector<float> floats;
+  for (long long offset : chunkOffsets) {
+    long long n = 0;
+    input.seekg(offset);
+    input.read((char *)&n, sizeof(long long));
+    values.resize(n*numOut);
+
+    for (int i=0; i<numOut; i++) {
+      input.seekg(offset + sizeof(long long) + selected(i)*n*valueSize);
+      if (valueSize == 8)
+	input.read((char *)&values[i*n], n*sizeof(double));
+      else {
+	floats.resize(n);
+	input.read((char *)floats.data(), n*sizeof(float));
+	for (int j=0; j<n; j++)
+	  values[i*n+j] = floats[j];
+      }
+    }
+
+    if (input.fail()) {
+      std::cerr << "WARNING - columnFileToText() - could not read " << inputFilename << std::endl;
+      return -1;
+    }
+
+    for (int j=0; j<n; j++) {
+      for (int i=0; i<numOut; i++) {
+	output << values[i*n+j];
+	if (i < numOut-1)
+	  output << " ";
+      }
+      output << "\n";
+    }
+  }
+
+  output.close();
+
+  return 0;
+}
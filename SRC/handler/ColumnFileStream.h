@@ -0,0 +1,133 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef _ColumnFileStream
+#define _ColumnFileStream
+
+// Description: A ColumnFileStream writes the rows of recorder data to a
+// binary file in chunks of rows, storing each chunk column by column so
+// that the history of one column can be read without reading the whole
+// file. The layout, in the byte order of the machine writing it, is:
+//
+//   header:  char magic[8] "OPSCOLS", int32 version, int32 valueSize
+//            (8 for double, 4 for float), int32 numColumns,
+//            int32 chunkRows (max rows in a chunk), int64 numRows,
+//            int64 indexOffset (0 until the file is closed)
+//   chunks:  int64 n, then numColumns blocks of n values each
+//   index:   int64 numChunks, numChunks int64 chunk offsets,
+//            int32 numNames, then numNames (int32 length, chars)
+//
+// The column names are built from the ResponseType tags the recorders
+// write in their headers. A file whose run did not finish has no index,
+// but the complete chunks can still be found by walking the chunks.
+// columnFileToText() extracts some or all of the columns to a text file.
+
+#include <OPS_Stream.h>
+
+#include <fstream>
+#include <vector>
+#include <string>
+
+class ID;
+
+int columnFileToText(const char *inputFilename, const char *outputFilename,
+		     const ID &columns, bool writeNames = false);
+
+class ColumnFileStream : public OPS_Stream
+{
+ public:
+  ColumnFileStream(const char *fileName, openMode mode = OVERWRITE,
+		   bool singlePrecision = false);
+  ~ColumnFileStream();
+
+  int setFile(const char *fileName, openMode mode = OVERWRITE, bool echo = false);
+  int open(void);
+  int close(openMode nextOpen = APPEND);
+  int flush();
+
+  int setPrecision(int precision) {return 0;};
+  int setFloatField(floatField) {return 0;};
+  int precision(int precision) {return 0;};
+  int width(int width) {return 0;};
+  const char *getFileName(void) {return fileName;}
+
+  // xml stuff
+  int tag(const char *);
+  int tag(const char *, const char *);
+  int endTag();
+  int attr(const char *name, int value);
+  int attr(const char *name, double value);
+  int attr(const char *name, const char *value);
+  int write(Vector &data);
+
+  // regular stuff, not stored in the file
+  OPS_Stream& write(const char *s, int n) {return *this;};
+  OPS_Stream& write(const unsigned char *s, int n) {return *this;};
+  OPS_Stream& write(const signed char *s, int n) {return *this;};
+  OPS_Stream& write(const void *s, int n) {return *this;};
+  OPS_Stream& write(const double *s, int n) {return *this;};
+
+  OPS_Stream& operator<<(char c) {return *this;};
+  OPS_Stream& operator<<(unsigned char c) {return *this;};
+  OPS_Stream& operator<<(signed char c) {return *this;};
+  OPS_Stream& operator<<(const char *s) {return *this;};
+  OPS_Stream& operator<<(const unsigned char *s) {return *this;};
+  OPS_Stream& operator<<(const signed char *s) {return *this;};
+  OPS_Stream& operator<<(const void *p) {return *this;};
+  OPS_Stream& operator<<(int n) {return *this;};
+  OPS_Stream& operator<<(unsigned int n) {return *this;};
+  OPS_Stream& operator<<(long n) {return *this;};
+  OPS_Stream& operator<<(unsigned long n) {return *this;};
+  OPS_Stream& operator<<(short n) {return *this;};
+  OPS_Stream& operator<<(unsigned short n) {return *this;};
+  OPS_Stream& operator<<(bool b) {return *this;};
+  OPS_Stream& operator<<(double n) {return *this;};
+  OPS_Stream& operator<<(float n) {return *this;};
+
+  // parallel stuff
+  int sendSelf(int commitTag, Channel &theChannel);
+  int recvSelf(int commitTag, Channel &theChannel,
+	       FEM_ObjectBroker &theBroker);
+
+ private:
+  int writeHeader(long long indexOffset);
+  int writeChunk(void);
+
+  std::fstream theFile;
+  int fileOpen;
+  openMode theOpenMode;
+  char *fileName;
+
+  int valueSize;
+  int numColumns;
+  int chunkRows;
+  long long numRows;
+  long long endOfData;              // where the next chunk goes
+  std::vector<long long> chunkOffsets;
+
+  std::vector<double> theChunk;     // column c of row r at c*chunkRows+r
+  std::vector<float> theFloats;
+  int numBuffered;
+
+  std::vector<std::string> theTags; // open header tags and their attributes
+  std::vector<std::string> columnNames;
+};
+
+#endif
@@ -34,6 +34,12 @@ OPS_Stream::~OPS_Stream()
 
 }
 
+std::string
+OPS_Stream::toString(long long n)
+{
+  return std::to_string(n);
+}
+
 
  OPS_Stream& 
  OPS_Stream::write(const char *s, int n) {return *this;}
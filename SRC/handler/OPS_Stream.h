@@ -26,6 +26,7 @@
 #define _OPS_Stream
 
 #include <MovableObject.h>
+#include <string>
 enum openMode  {OVERWRITE, APPEND};
 enum floatField {FIXEDD, SCIENTIFIC};
 class Vector;
@@ -80,6 +81,10 @@ class OPS_Stream:  public MovableObject
   virtual OPS_Stream& operator<<(double n);
   virtual OPS_Stream& operator<<(float n);
 
+  // not all streams print longs, counts and file offsets are printed
+  // as text instead: s << OPS_Stream::toString(n).c_str()
+  static std::string toString(long long n);
+
   // parallel stuff
   virtual void setAddCommon(int);
   virtual int setOrder(const ID &order);
@@ -53,6 +53,13 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 #include <BeamIntegration.h>
 #include <NodalLoad.h>
 #include <AnalysisModel.h>
+#include <LinearSOESolver.h>
+#include <Information.h>
+#include <MapOfTaggedObjects.h>
+#include <ArrayOfTaggedObjects.h>
+#include <HashOfTaggedObjects.h>
+#include <Profiler.h>
+#include <Element.h>
 #include <PlainHandler.h>
 #include <RCM.h>
 #include <AMDNumberer.h>
@@ -105,6 +112,7 @@ UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 #include <RegulaFalsiLineSearch.h>
 #include <NewtonLineSearch.h>
 #include <FileDatastore.h>
+#include <BinaryFileDatastore.h>
 #include <Mesh.h>
 #include <BackgroundMesh.h>
 #ifdef _MUMPS
@@ -1065,6 +1073,13 @@ OpenSeesCommands::setFileDatabase(const char* filename)
     }
 }
 
+void
+OpenSeesCommands::setBinaryFileDatabase(const char* filename)
+{
+    if (theDatabase != 0) delete theDatabase;
+    theDatabase = new BinaryFileDatastore(filename, *theDomain, theBroker);
+}
+
 /////////////////////////////
 //// OpenSees APIs  /// /////
 /////////////////////////////
@@ -2102,6 +2117,14 @@ int OPS_System()
 
 	theSOE = (LinearSOE*)OPS_UmfpackGenLinSolver();
 
+    } else if (strcmp(type, "SupernodalSPD") == 0) {
+
+	theSOE = (LinearSOE*)OPS_SupernodalSPDLinSolver();
+
+    } else if (strcmp(type, "Krylov") == 0) {
+
+	theSOE = (LinearSOE*)OPS_KrylovLinSolver();
+
     } else if (strcmp(type,"FullGeneral") == 0) {
 	// now must determine the type of solver to create from rest of args
 	theSOE = (LinearSOE*)OPS_FullGenLinLapackSolver();
@@ -2284,6 +2307,18 @@ int OPS_Integrator()
 
     const char* type = OPS_GetString();
 
+    // check for the number of assembly threads ahead of the type
+    int numThreads = 0;
+    if (strcmp(type,"-numThreads") == 0) {
+	int numdata = 1;
+	if (OPS_GetNumRemainingInputArgs() < 2 ||
+	    OPS_GetIntInput(&numdata, &numThreads) < 0 || numThreads < 1) {
+	    opserr << "WARNING integrator -numThreads numThreads type ... - invalid numThreads\n";
+	    return -1;
+	}
+	type = OPS_GetString();
+    }
+
     // create integrator
     StaticIntegrator* si = 0;
     TransientIntegrator* ti = 0;
@@ -2446,10 +2481,14 @@ int OPS_Integrator()
 
     // set integrator
     if (si != 0) {
+	if (numThreads > 0)
+	    si->setNumThreads(numThreads);
 	if (cmds != 0) {
 	    cmds->setStaticIntegrator(si);
 	}
     } else if (ti != 0) {
+	if (numThreads > 0)
+	    ti->setNumThreads(numThreads);
 	if (cmds != 0) {
 	    cmds->setTransientIntegrator(ti);
 	}
@@ -3301,7 +3340,7 @@ int OPS_Database()
     if (cmds == 0) return 0;
     // make sure at least one other argument to contain integrator
     if (OPS_GetNumRemainingInputArgs() < 1) {
-	opserr << "WARNING need to specify a Database type; valid type File, MySQL, BerkeleyDB \n";
+	opserr << "WARNING need to specify a Database type; valid type File, Binary, MySQL, BerkeleyDB \n";
 	return -1;
     }
 
@@ -3323,8 +3362,19 @@ int OPS_Database()
 
 	return 0;
     }
+    if (strcmp(type,"Binary") == 0) {
+	if (OPS_GetNumRemainingInputArgs() < 1) {
+	    opserr << "WARNING database Binary fileName? ";
+	    return -1;
+	}
+
+	const char* filename = OPS_GetString();
+	cmds->setBinaryFileDatabase(filename);
+
+	return 0;
+    }
     opserr << "WARNING No database type exists ";
-    opserr << "for database of type:" << type << "valid database type File\n";
+    opserr << "for database of type:" << type << "valid database type File, Binary\n";
 
     return -1;
 }
@@ -3892,6 +3942,266 @@ int OPS_systemSize()
     return 0;
 }
 
+int OPS_systemStat()
+{
+    if (cmds == 0) return 0;
+    LinearSOE* theSOE = cmds->getSOE();
+    if (theSOE == 0) {
+	opserr << "WARNING no system is set\n";
+	return -1;
+    }
+
+    if (OPS_GetNumRemainingInputArgs() < 1) {
+	opserr << "WARNING insufficient args: systemStat name\n";
+	return -1;
+    }
+    const char *name = OPS_GetString();
+
+    // counters kept by the solver, e.g. numSymbolicReused for Umfpack
+    LinearSOESolver *theSolver = theSOE->getSolver();
+    Information theInfo;
+    if (theSolver == 0 || theSolver->getVariable(name, theInfo) < 0) {
+	opserr << "WARNING systemStat - solver does not provide " << name << "\n";
+	return -1;
+    }
+
+    int numdata = 1;
+    if (theInfo.theType == DoubleType) {
+	if (OPS_SetDoubleOutput(&numdata, &theInfo.theDouble, true) < 0) {
+	    opserr << "WARNING failed to set output\n";
+	    return -1;
+	}
+    } else {
+	if (OPS_SetIntOutput(&numdata, &theInfo.theInt, true) < 0) {
+	    opserr << "WARNING failed to set output\n";
+	    return -1;
+	}
+    }
+
+    return 0;
+}
+
+int OPS_domainStat()
+{
+    if (cmds == 0) return 0;
+    Domain* theDomain = cmds->getDomain();
+    if (theDomain == 0) return -1;
+
+    if (OPS_GetNumRemainingInputArgs() < 1) {
+	opserr << "WARNING insufficient args: domainStat name\n";
+	return -1;
+    }
+    const char *name = OPS_GetString();
+
+    if (strcmp(name, "reset") == 0) {
+	theDomain->resetPhaseStats();
+	return 0;
+    }
+
+    // timings of the commit, revert and update sweeps, e.g. updateTime
+    Information theInfo;
+    if (theDomain->getPhaseStat(name, theInfo) < 0) {
+	opserr << "WARNING domainStat - domain does not provide " << name << "\n";
+	return -1;
+    }
+
+    int numdata = 1;
+    if (theInfo.theType == DoubleType) {
+	if (OPS_SetDoubleOutput(&numdata, &theInfo.theDouble, true) < 0) {
+	    opserr << "WARNING failed to set output\n";
+	    return -1;
+	}
+    } else {
+	if (OPS_SetIntOutput(&numdata, &theInfo.theInt, true) < 0) {
+	    opserr << "WARNING failed to set output\n";
+	    return -1;
+	}
+    }
+
+    return 0;
+}
+
+int OPS_domainThreads()
+{
+    if (cmds == 0) return 0;
+    Domain* theDomain = cmds->getDomain();
+    if (theDomain == 0) return -1;
+
+    if (OPS_GetNumRemainingInputArgs() < 1) {
+	opserr << "WARNING insufficient args: domainThreads numThreads\n";
+	return -1;
+    }
+
+    int numThreads;
+    int numdata = 1;
+    if (OPS_GetIntInput(&numdata, &numThreads) < 0) {
+	opserr << "WARNING domainThreads numThreads - invalid numThreads\n";
+	return -1;
+    }
+
+    return theDomain->setNumThreads(numThreads);
+}
+
+int OPS_domainStorage()
+{
+    if (cmds == 0) return 0;
+    Domain* theDomain = cmds->getDomain();
+    if (theDomain == 0) return -1;
+
+    if (OPS_GetNumRemainingInputArgs() < 2) {
+	opserr << "WARNING insufficient args: domainStorage componentType storageType\n";
+	return -1;
+    }
+
+    const char* componentType = OPS_GetString();
+    const char* storageType = OPS_GetString();
+
+    TaggedObjectStorage* theStorage = 0;
+    if (strcmp(storageType, "Map") == 0)
+	theStorage = new MapOfTaggedObjects();
+    else if (strcmp(storageType, "Array") == 0)
+	theStorage = new ArrayOfTaggedObjects(1024);
+    else if (strcmp(storageType, "Hash") == 0)
+	theStorage = new HashOfTaggedObjects();
+    else {
+	opserr << "WARNING domainStorage - unknown storageType " << storageType << ", Map, Array or Hash\n";
+	return -1;
+    }
+
+    if (theDomain->setStorage(componentType, theStorage) < 0) {
+	delete theStorage;
+	return -1;
+    }
+
+    return 0;
+}
+
+int OPS_domainNodalStore()
+{
+    if (cmds == 0) return 0;
+    Domain* theDomain = cmds->getDomain();
+    if (theDomain == 0) return -1;
+
+    if (OPS_GetNumRemainingInputArgs() < 1) {
+	opserr << "WARNING insufficient args: domainNodalStore flag\n";
+	return -1;
+    }
+
+    int flag;
+    int numdata = 1;
+    if (OPS_GetIntInput(&numdata, &flag) < 0) {
+	opserr << "WARNING domainNodalStore flag - invalid flag\n";
+	return -1;
+    }
+
+    return theDomain->setNodalStateStore(flag != 0);
+}
+
+int OPS_profiler()
+{
+    if (OPS_GetNumRemainingInputArgs() < 1) {
+	opserr << "WARNING insufficient args: profiler on <-trace>|off|reset|print|dump fileName <-json|-csv|-trace>\n";
+	return -1;
+    }
+
+    const char* action = OPS_GetString();
+
+    if (strcmp(action, "on") == 0) {
+	bool trace = false;
+	if (OPS_GetNumRemainingInputArgs() > 0 && strcmp(OPS_GetString(), "-trace") == 0)
+	    trace = true;
+	return Profiler::enable(trace);
+
+    } else if (strcmp(action, "off") == 0) {
+	Profiler::disable();
+
+    } else if (strcmp(action, "reset") == 0) {
+	Profiler::reset();
+
+    } else if (strcmp(action, "print") == 0) {
+	Profiler::Print(opserr);
+
+    } else if (strcmp(action, "dump") == 0) {
+	if (OPS_GetNumRemainingInputArgs() < 1) {
+	    opserr << "WARNING profiler dump fileName <-json|-csv|-trace> - no fileName given\n";
+	    return -1;
+	}
+	const char* fileName = OPS_GetString();
+	const char* format = "json";
+	if (OPS_GetNumRemainingInputArgs() > 0) {
+	    const char* flag = OPS_GetString();
+	    if (strcmp(flag, "-csv") == 0)
+		format = "csv";
+	    else if (strcmp(flag, "-trace") == 0)
+		format = "trace";
+	    else if (strcmp(flag, "-json") != 0) {
+		opserr << "WARNING profiler dump - unknown format " << flag << ", -json, -csv or -trace\n";
+		return -1;
+	    }
+	}
+	return Profiler::dump(fileName, format);
+
+    } else {
+	opserr << "WARNING profiler - unknown action " << action << ", on, off, reset, print or dump\n";
+	return -1;
+    }
+
+    return 0;
+}
+
+int OPS_elementCosts()
+{
+    if (cmds == 0) return 0;
+    Domain* theDomain = cmds->getDomain();
+    if (theDomain == 0) return -1;
+
+    if (OPS_GetNumRemainingInputArgs() < 1) {
+	opserr << "WARNING insufficient args: elementCosts on|off|reset|print <numTop> <-file fileName>\n";
+	return -1;
+    }
+
+    const char* action = OPS_GetString();
+
+    if (strcmp(action, "on") == 0) {
+	Element::setMeasureCosts(true);
+
+    } else if (strcmp(action, "off") == 0) {
+	Element::setMeasureCosts(false);
+
+    } else if (strcmp(action, "reset") == 0) {
+	theDomain->resetElementCosts();
+
+    } else if (strcmp(action, "print") == 0) {
+	int numTop = 10;
+	const char* fileName = 0;
+	while (OPS_GetNumRemainingInputArgs() > 0) {
+	    const char* flag = OPS_GetString();
+	    if (strcmp(flag, "-file") == 0 && OPS_GetNumRemainingInputArgs() > 0) {
+		fileName = OPS_GetString();
+	    } else {
+		OPS_ResetCurrentInputArg(-1);
+		int numdata = 1;
+		if (OPS_GetIntInput(&numdata, &numTop) < 0) {
+		    opserr << "WARNING elementCosts print - invalid numTop\n";
+		    return -1;
+		}
+	    }
+	}
+
+	if (fileName != 0) {
+	    FileStream theFile(fileName);
+	    return theDomain->printElementCosts(theFile, numTop);
+	}
+	return theDomain->printElementCosts(opserr, numTop);
+
+    } else {
+	opserr << "WARNING elementCosts - unknown action " << action << ", on, off, reset or print\n";
+	return -1;
+    }
+
+    return 0;
+}
+
 int OPS_domainCommitTag() {
     if (cmds == 0) {
         return 0;
@@ -149,6 +149,7 @@ public:
     bool getBuiltModel() {return builtModel;}
 
     void setFileDatabase(const char* filename);
+    void setBinaryFileDatabase(const char* filename);
     FE_Datastore* getDatabase() {return theDatabase;}
 
     Timer* getTimer() {return &theTimer;}
@@ -366,6 +367,7 @@ int OPS_record();
 int OPS_stripOpenSeesXML();
 int OPS_convertBinaryToText();
 int OPS_convertTextToBinary();
+int OPS_columnFileToText();
 int OPS_InitialStateAnalysis();
 int OPS_RigidLink();
 int OPS_RigidDiaphragm();
@@ -457,6 +459,13 @@ int OPS_numIter();
 bool* OPS_builtModel();
 int* OPS_GetNumEigen();
 int OPS_systemSize();
+int OPS_systemStat();
+int OPS_domainStat();
+int OPS_domainThreads();
+int OPS_domainNodalStore();
+int OPS_domainStorage();
+int OPS_profiler();
+int OPS_elementCosts();
 int OPS_domainCommitTag();
 
 void* OPS_KrylovNewton();
@@ -501,6 +510,8 @@ void* OPS_BandSPDLinLapack();
 void* OPS_SuperLUSolver();
 void* OPS_ProfileSPDLinDirectSolver();
 void* OPS_UmfpackGenLinSolver();
+void* OPS_SupernodalSPDLinSolver();
+void* OPS_KrylovLinSolver();
 void* OPS_DiagonalDirectSolver();
 void* OPS_SProfileSPDLinSolver();
 void* OPS_PFEMSolver();
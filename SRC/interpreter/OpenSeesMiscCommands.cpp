@@ -59,6 +59,7 @@
 #ifdef _PARALLEL_INTERPRETERS
 #include <mpi.h>
 #include <metis.h>
+#include <MPI_Channel.h>
 #endif
 
 #ifdef _OPENMP
@@ -1285,6 +1286,40 @@ int OPS_convertTextToBinary()
     return textToBinary(inputFile, outputFile);
 }
 
+extern int columnFileToText(const char *inputFilename, const char *outputFilename,
+			    const ID &columns, bool writeNames);
+
+int OPS_columnFileToText()
+{
+    if (OPS_GetNumRemainingInputArgs() < 2) {
+	opserr << "ERROR incorrect # args - columnFileToText inputFile outputFile <-names> <column1 column2 ...>\n";
+	return -1;
+    }
+
+    const char *inputFile = OPS_GetString();
+    const char *outputFile = OPS_GetString();
+
+    bool writeNames = false;
+    ID columns(0, 8);
+    while (OPS_GetNumRemainingInputArgs() > 0) {
+	const char *opt = OPS_GetString();
+	if (strcmp(opt, "-names") == 0) {
+	    writeNames = true;
+	    continue;
+	}
+	OPS_ResetCurrentInputArg(-1);
+	int column;
+	int numData = 1;
+	if (OPS_GetIntInput(&numData, &column) < 0) {
+	    opserr << "WARNING columnFileToText - invalid column " << opt << "\n";
+	    return -1;
+	}
+	columns[columns.Size()] = column;
+    }
+
+    return columnFileToText(inputFile, outputFile, columns, writeNames);
+}
+
 int OPS_InitialStateAnalysis()
 {
     if (OPS_GetNumRemainingInputArgs() < 1) {
@@ -1626,6 +1661,8 @@ int OPS_getNP()
 int OPS_barrier()
 {
 #ifdef _PARALLEL_INTERPRETERS
+    // data held back by the channels could be what the others wait on
+    MPI_Channel::flushAll();
     return MPI_Barrier(MPI_COMM_WORLD);
 #endif
 
@@ -1761,6 +1798,7 @@ int OPS_recv()
     }
 
     // receive data
+    MPI_Channel::flushAll();
     MPI_Status status;
 
     // receive length and type
@@ -1825,6 +1863,7 @@ int OPS_Bcast() {
     int msgLength[2] = {0,0};
     void* buffer = 0;
     MPI_Datatype datatype;
+    MPI_Channel::flushAll();
     if (myPID == 0) {
 
         // send
@@ -1974,6 +2013,7 @@ int OPS_partition() {
     int np = 1;
     MPI_Comm_rank(MPI_COMM_WORLD, &pid);
     MPI_Comm_size(MPI_COMM_WORLD, &np);
+    MPI_Channel::flushAll();
 
     if (np == 1) return 0;
 
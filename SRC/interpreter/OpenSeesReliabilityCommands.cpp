@@ -90,6 +90,7 @@ MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 #include <AllIndependentTransformation.h>
 #include <ArmijoStepSizeRule.h>
 #include <CStdLibRandGenerator.h>
+#include <PhiloxRandGenerator.h>
 #include <FiniteDifferenceGradient.h>
 #include <FixedStepSizeRule.h>
 #include <GradientProjectionSearchDirection.h>
@@ -1737,13 +1738,26 @@ int OPS_randomNumberGenerator() {
 
     // Get the type of generator
     const char *type = OPS_GetString();
-    if (strcmp(type, "CStdLib") != 0) {
+    RandomNumberGenerator *theGenerator = 0;
+    if (strcmp(type, "CStdLib") == 0) {
+        theGenerator = new CStdLibRandGenerator();
+    } else if (strcmp(type, "Philox") == 0) {
+        // randomNumberGenerator Philox <seed>
+        int seed = 0;
+        int numData = 1;
+        if (OPS_GetNumRemainingInputArgs() > 0 &&
+            OPS_GetIntInput(&numData, &seed) < 0) {
+            opserr << "ERROR: invalid seed of Philox randomNumberGenerator"
+                   << endln;
+            return -1;
+        }
+        theGenerator = new PhiloxRandGenerator(seed);
+    } else {
         opserr << "ERROR: unrecognized type of RandomNumberGenerator "
                << type << endln;
         return -1;
     }
 
-    RandomNumberGenerator *theGenerator = new CStdLibRandGenerator();
     if (theGenerator == 0) {
         opserr << "ERROR: could not create randomNumberGenerator" << endln;
         return -1;
@@ -1745,6 +1745,18 @@ static PyObject *Py_ops_convertBinaryToText(PyObject *self, PyObject *args)
     return wrapper->getResults();
 }
 
+static PyObject *Py_ops_columnFileToText(PyObject *self, PyObject *args)
+{
+    wrapper->resetCommandLine((int)PyTuple_Size(args), 1, args);
+
+    if (OPS_columnFileToText() < 0) {
+	opserr<<(void*)0;
+	return NULL;
+    }
+
+    return wrapper->getResults();
+}
+
 static PyObject *Py_ops_getEleTags(PyObject *self, PyObject *args)
 {
     wrapper->resetCommandLine((int)PyTuple_Size(args), 1, args);
@@ -2046,6 +2058,90 @@ static PyObject *Py_ops_systemSize(PyObject *self, PyObject *args)
     return wrapper->getResults();
 }
 
+static PyObject *Py_ops_systemStat(PyObject *self, PyObject *args)
+{
+    wrapper->resetCommandLine((int)PyTuple_Size(args), 1, args);
+
+    if (OPS_systemStat() < 0) {
+	opserr<<(void*)0;
+	return NULL;
+    }
+
+    return wrapper->getResults();
+}
+
+static PyObject *Py_ops_domainStat(PyObject *self, PyObject *args)
+{
+    wrapper->resetCommandLine((int)PyTuple_Size(args), 1, args);
+
+    if (OPS_domainStat() < 0) {
+	opserr<<(void*)0;
+	return NULL;
+    }
+
+    return wrapper->getResults();
+}
+
+static PyObject *Py_ops_domainThreads(PyObject *self, PyObject *args)
+{
+    wrapper->resetCommandLine((int)PyTuple_Size(args), 1, args);
+
+    if (OPS_domainThreads() < 0) {
+	opserr<<(void*)0;
+	return NULL;
+    }
+
+    return wrapper->getResults();
+}
+
+static PyObject *Py_ops_domainStorage(PyObject *self, PyObject *args)
+{
+    wrapper->resetCommandLine((int)PyTuple_Size(args), 1, args);
+
+    if (OPS_domainStorage() < 0) {
+	opserr<<(void*)0;
+	return NULL;
+    }
+
+    return wrapper->getResults();
+}
+
+static PyObject *Py_ops_profiler(PyObject *self, PyObject *args)
+{
+    wrapper->resetCommandLine((int)PyTuple_Size(args), 1, args);
+
+    if (OPS_profiler() < 0) {
+	opserr<<(void*)0;
+	return NULL;
+    }
+
+    return wrapper->getResults();
+}
+
+static PyObject *Py_ops_elementCosts(PyObject *self, PyObject *args)
+{
+    wrapper->resetCommandLine((int)PyTuple_Size(args), 1, args);
+
+    if (OPS_elementCosts() < 0) {
+	opserr<<(void*)0;
+	return NULL;
+    }
+
+    return wrapper->getResults();
+}
+
+static PyObject *Py_ops_domainNodalStore(PyObject *self, PyObject *args)
+{
+    wrapper->resetCommandLine((int)PyTuple_Size(args), 1, args);
+
+    if (OPS_domainNodalStore() < 0) {
+	opserr<<(void*)0;
+	return NULL;
+    }
+
+    return wrapper->getResults();
+}
+
 static PyObject *Py_ops_version(PyObject *self, PyObject *args)
 {
     wrapper->resetCommandLine((int)PyTuple_Size(args), 1, args);
@@ -3307,6 +3403,7 @@ PythonWrapper::addOpenSeesCommands()
     addCommand("stripXML", &Py_ops_stripXML);
     addCommand("convertBinaryToText", &Py_ops_convertBinaryToText);
     addCommand("convertTextToBinary", &Py_ops_convertTextToBinary);
+    addCommand("columnFileToText", &Py_ops_columnFileToText);
     addCommand("getEleTags", &Py_ops_getEleTags);
     addCommand("getCrdTransfTags", &Py_ops_getCrdTransfTags);
     addCommand("getNodeTags", &Py_ops_getNodeTags);
@@ -3332,6 +3429,13 @@ PythonWrapper::addOpenSeesCommands()
     addCommand("numFact", &Py_ops_numFact);
     addCommand("numIter", &Py_ops_numIter);
     addCommand("systemSize", &Py_ops_systemSize);
+    addCommand("systemStat", &Py_ops_systemStat);
+    addCommand("domainStat", &Py_ops_domainStat);
+    addCommand("domainThreads", &Py_ops_domainThreads);
+    addCommand("domainNodalStore", &Py_ops_domainNodalStore);
+    addCommand("domainStorage", &Py_ops_domainStorage);
+    addCommand("profiler", &Py_ops_profiler);
+    addCommand("elementCosts", &Py_ops_elementCosts);
     addCommand("version", &Py_ops_version);
     addCommand("pyversion", &Py_ops_pyversion);
     addCommand("setMaxOpenFiles", &Py_ops_setMaxOpenFiles);
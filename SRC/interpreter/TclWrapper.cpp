@@ -1167,6 +1167,14 @@ static int Tcl_ops_convertTextToBinary(ClientData clientData, Tcl_Interp *interp
     return TCL_OK;
 }
 
+static int Tcl_ops_columnFileToText(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv) {
+    wrapper->resetCommandLine(argc, 1, argv);
+
+    if (OPS_columnFileToText() < 0) return TCL_ERROR;
+
+    return TCL_OK;
+}
+
 static int Tcl_ops_getEleTags(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv) {
     wrapper->resetCommandLine(argc, 1, argv);
 
@@ -1343,6 +1351,62 @@ static int Tcl_ops_systemSize(ClientData clientData, Tcl_Interp *interp, int arg
     return TCL_OK;
 }
 
+static int Tcl_ops_systemStat(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv) {
+    wrapper->resetCommandLine(argc, 1, argv);
+
+    if (OPS_systemStat() < 0) return TCL_ERROR;
+
+    return TCL_OK;
+}
+
+static int Tcl_ops_domainStat(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv) {
+    wrapper->resetCommandLine(argc, 1, argv);
+
+    if (OPS_domainStat() < 0) return TCL_ERROR;
+
+    return TCL_OK;
+}
+
+static int Tcl_ops_domainThreads(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv) {
+    wrapper->resetCommandLine(argc, 1, argv);
+
+    if (OPS_domainThreads() < 0) return TCL_ERROR;
+
+    return TCL_OK;
+}
+
+static int Tcl_ops_domainStorage(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv) {
+    wrapper->resetCommandLine(argc, 1, argv);
+
+    if (OPS_domainStorage() < 0) return TCL_ERROR;
+
+    return TCL_OK;
+}
+
+static int Tcl_ops_profiler(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv) {
+    wrapper->resetCommandLine(argc, 1, argv);
+
+    if (OPS_profiler() < 0) return TCL_ERROR;
+
+    return TCL_OK;
+}
+
+static int Tcl_ops_elementCosts(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv) {
+    wrapper->resetCommandLine(argc, 1, argv);
+
+    if (OPS_elementCosts() < 0) return TCL_ERROR;
+
+    return TCL_OK;
+}
+
+static int Tcl_ops_domainNodalStore(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv) {
+    wrapper->resetCommandLine(argc, 1, argv);
+
+    if (OPS_domainNodalStore() < 0) return TCL_ERROR;
+
+    return TCL_OK;
+}
+
 static int Tcl_ops_version(ClientData clientData, Tcl_Interp *interp, int argc,   TCL_Char **argv) {
     wrapper->resetCommandLine(argc, 1, argv);
 
@@ -2091,6 +2155,7 @@ TclWrapper::addOpenSeesCommands(Tcl_Interp* interp)
     addCommand(interp,"stripXML", &Tcl_ops_stripXML);
     addCommand(interp,"convertBinaryToText", &Tcl_ops_convertBinaryToText);
     addCommand(interp,"convertTextToBinary", &Tcl_ops_convertTextToBinary);
+    addCommand(interp,"columnFileToText", &Tcl_ops_columnFileToText);
     addCommand(interp,"getEleTags", &Tcl_ops_getEleTags);
     addCommand(interp,"getCrdTransfTags", &Tcl_ops_getCrdTransfTags);
     addCommand(interp,"getNodeTags", &Tcl_ops_getNodeTags);
@@ -2112,6 +2177,13 @@ TclWrapper::addOpenSeesCommands(Tcl_Interp* interp)
     addCommand(interp,"numFact", &Tcl_ops_numFact);
     addCommand(interp,"numIter", &Tcl_ops_numIter);
     addCommand(interp,"systemSize", &Tcl_ops_systemSize);
+    addCommand(interp,"systemStat", &Tcl_ops_systemStat);
+    addCommand(interp,"domainStat", &Tcl_ops_domainStat);
+    addCommand(interp,"domainThreads", &Tcl_ops_domainThreads);
+    addCommand(interp,"domainNodalStore", &Tcl_ops_domainNodalStore);
+    addCommand(interp,"domainStorage", &Tcl_ops_domainStorage);
+    addCommand(interp,"profiler", &Tcl_ops_profiler);
+    addCommand(interp,"elementCosts", &Tcl_ops_elementCosts);
     addCommand(interp,"version", &Tcl_ops_version);
     addCommand(interp,"setMaxOpenFiles", &Tcl_ops_setMaxOpenFiles);
     addCommand(interp,"limitCurve", &Tcl_ops_limitCurve);
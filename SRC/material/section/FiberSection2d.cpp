@@ -30,6 +30,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <vector>
 
 #include <Channel.h>
 #include <Vector.h>
@@ -41,6 +42,7 @@
 #include <ID.h>
 #include <FEM_ObjectBroker.h>
 #include <Information.h>
+#include <Parameter.h>
 #include <MaterialResponse.h>
 #include <UniaxialMaterial.h>
 #include <SectionIntegration.h>
@@ -74,15 +76,11 @@ void* OPS_FiberSection2d()
 // constructors:
 FiberSection2d::FiberSection2d(int tag, int num, Fiber **fibers, bool compCentroid): 
   SectionForceDeformation(tag, SEC_TAG_FiberSection2d),
-  numFibers(num), sizeFibers(num), theMaterials(0), matData(0),
+  numFibers(num), sizeFibers(num), theMaterials(0), matData(0), yFibers(0), AFibers(0),
+  strainFibers(0), stressFibers(0), tangentFibers(0), numFiberGroups(0), fiberGroups(0),
   QzBar(0.0), ABar(0.0), yBar(0.0), computeCentroid(compCentroid),
-  sectionIntegr(0), e(2), s(0), ks(0), dedh(2)
+  fiberGeometrySet(false), sectionIntegr(0), e(2), s(0), ks(0), dedh(2)
 {
-  if (numFibers > 10000) {
-    opserr << "ERROR: FiberSection2d::FiberSection2d -- section has more than 10,000 fibers. You can surely use fewer fibers." << endln;
-    exit(-1);
-  }
-  
   if (numFibers > 0) {
     theMaterials = new UniaxialMaterial *[numFibers];
 
@@ -118,6 +116,8 @@ FiberSection2d::FiberSection2d(int tag, int num, Fiber **fibers, bool compCentro
 
     if (computeCentroid && ABar != 0.0)
       yBar = QzBar/ABar;
+
+    this->setFiberGeometry();
   }
 
   s = new Vector(sData, 2);
@@ -138,15 +138,11 @@ FiberSection2d::FiberSection2d(int tag, int num, Fiber **fibers, bool compCentro
 // allocate memory for fibers
 FiberSection2d::FiberSection2d(int tag, int num, bool compCentroid): 
   SectionForceDeformation(tag, SEC_TAG_FiberSection2d),
-  numFibers(0), sizeFibers(num), theMaterials(0), matData(0),
+  numFibers(0), sizeFibers(num), theMaterials(0), matData(0), yFibers(0), AFibers(0),
+  strainFibers(0), stressFibers(0), tangentFibers(0), numFiberGroups(0), fiberGroups(0),
   QzBar(0.0), ABar(0.0), yBar(0.0), computeCentroid(compCentroid),
-  sectionIntegr(0), e(2), s(0), ks(0), dedh(2)
+  fiberGeometrySet(false), sectionIntegr(0), e(2), s(0), ks(0), dedh(2)
 {
-  if (numFibers > 10000) {
-    opserr << "ERROR: FiberSection2d::FiberSection2d -- section has more than 10,000 fibers. You can surely use fewer fibers." << endln;
-    exit(-1);
-  }
-  
     if(sizeFibers > 0) {
 	theMaterials = new UniaxialMaterial *[sizeFibers];
 
@@ -187,15 +183,11 @@ FiberSection2d::FiberSection2d(int tag, int num, bool compCentroid):
 FiberSection2d::FiberSection2d(int tag, int num, UniaxialMaterial **mats,
 			       SectionIntegration &si, bool compCentroid):
   SectionForceDeformation(tag, SEC_TAG_FiberSection2d),
-  numFibers(num), sizeFibers(num), theMaterials(0), matData(0),
+  numFibers(num), sizeFibers(num), theMaterials(0), matData(0), yFibers(0), AFibers(0),
+  strainFibers(0), stressFibers(0), tangentFibers(0), numFiberGroups(0), fiberGroups(0),
   QzBar(0.0), ABar(0.0), yBar(0.0), computeCentroid(compCentroid),
-  sectionIntegr(0), e(2), s(0), ks(0), dedh(2)
+  fiberGeometrySet(false), sectionIntegr(0), e(2), s(0), ks(0), dedh(2)
 {
-  if (numFibers > 10000) {
-    opserr << "ERROR: FiberSection2d::FiberSection2d -- section has more than 10,000 fibers. You can surely use fewer fibers." << endln;
-    exit(-1);
-  }
-
   if (numFibers > 0) {
     theMaterials = new UniaxialMaterial *[numFibers];
 
@@ -217,17 +209,8 @@ FiberSection2d::FiberSection2d(int tag, int num, UniaxialMaterial **mats,
     exit(-1);
   }
 
-  static double fiberLocs[10000];
-  sectionIntegr->getFiberLocations(numFibers, fiberLocs);
-  
-  static double fiberArea[10000];
-  sectionIntegr->getFiberWeights(numFibers, fiberArea);
-
   for (int i = 0; i < numFibers; i++) {
 
-    ABar  += fiberArea[i];
-    QzBar += fiberLocs[i]*fiberArea[i];
-
     theMaterials[i] = mats[i]->getCopy();
     
     if (theMaterials[i] == 0) {
@@ -236,8 +219,18 @@ FiberSection2d::FiberSection2d(int tag, int num, UniaxialMaterial **mats,
     }
   }    
 
+  this->setFiberGeometry();
+
+  for (int i = 0; i < numFibers; i++) {
+    ABar  += AFibers[i];
+    QzBar += yFibers[i]*AFibers[i];
+  }
+
   if (computeCentroid && ABar != 0.0)
     yBar = QzBar/ABar;
+
+  for (int i = 0; i < numFibers; i++)
+    yFibers[i] -= yBar;
   
   s = new Vector(sData, 2);
   ks = new Matrix(kData, 2, 2);
@@ -257,9 +250,10 @@ FiberSection2d::FiberSection2d(int tag, int num, UniaxialMaterial **mats,
 // constructor for blank object that recvSelf needs to be invoked upon
 FiberSection2d::FiberSection2d():
   SectionForceDeformation(0, SEC_TAG_FiberSection2d),
-  numFibers(0), sizeFibers(0), theMaterials(0), matData(0),
+  numFibers(0), sizeFibers(0), theMaterials(0), matData(0), yFibers(0), AFibers(0),
+  strainFibers(0), stressFibers(0), tangentFibers(0), numFiberGroups(0), fiberGroups(0),
   QzBar(0.0), ABar(0.0), yBar(0.0), computeCentroid(true),
-  sectionIntegr(0), e(2), s(0), ks(0), dedh(2)
+  fiberGeometrySet(false), sectionIntegr(0), e(2), s(0), ks(0), dedh(2)
 {
   s = new Vector(sData, 2);
   ks = new Matrix(kData, 2, 2);
@@ -279,11 +273,6 @@ FiberSection2d::FiberSection2d():
 int
 FiberSection2d::addFiber(Fiber &newFiber)
 {
-  if (numFibers >= 10000) {
-    opserr << "ERROR: FiberSection2d::addFiber -- section has more than 10,000 fibers. You can surely use fewer fibers." << endln;
-    exit(-1);
-  }
-
   // need to create larger arrays
   if(numFibers == sizeFibers) {
       int newsize = 2*sizeFibers;
@@ -344,6 +333,8 @@ FiberSection2d::addFiber(Fiber &newFiber)
   // Recompute centroid
   if (computeCentroid && ABar != 0.0)
     yBar = QzBar/ABar;
+
+  fiberGeometrySet = false;
   
   return 0;
 }
@@ -363,6 +354,24 @@ FiberSection2d::~FiberSection2d()
   if (matData != 0)
     delete [] matData;
 
+  if (yFibers != 0)
+    delete [] yFibers;
+
+  if (AFibers != 0)
+    delete [] AFibers;
+
+  if (strainFibers != 0)
+    delete [] strainFibers;
+
+  if (stressFibers != 0)
+    delete [] stressFibers;
+
+  if (tangentFibers != 0)
+    delete [] tangentFibers;
+
+  if (fiberGroups != 0)
+    delete [] fiberGroups;
+
   if (s != 0)
     delete s;
 
@@ -373,6 +382,67 @@ FiberSection2d::~FiberSection2d()
     delete sectionIntegr;
 }
 
+void
+FiberSection2d::setFiberGeometry(void)
+{
+  if (yFibers != 0)
+    delete [] yFibers;
+  if (AFibers != 0)
+    delete [] AFibers;
+  if (strainFibers != 0)
+    delete [] strainFibers;
+  if (stressFibers != 0)
+    delete [] stressFibers;
+  if (tangentFibers != 0)
+    delete [] tangentFibers;
+  if (fiberGroups != 0)
+    delete [] fiberGroups;
+  yFibers = 0;
+  AFibers = 0;
+  strainFibers = 0;
+  stressFibers = 0;
+  tangentFibers = 0;
+  fiberGroups = 0;
+  numFiberGroups = 0;
+
+  if (numFibers > 0) {
+    yFibers = new double [numFibers];
+    AFibers = new double [numFibers];
+    strainFibers = new double [numFibers];
+    stressFibers = new double [numFibers];
+    tangentFibers = new double [numFibers];
+    fiberGroups = new int [numFibers+1];
+
+    if (sectionIntegr != 0) {
+      sectionIntegr->getFiberLocations(numFibers, yFibers);
+      sectionIntegr->getFiberWeights(numFibers, AFibers);
+    }
+    else {
+      for (int i = 0; i < numFibers; i++) {
+	yFibers[i] = matData[2*i];
+	AFibers[i] = matData[2*i+1];
+      }
+    }
+
+    for (int i = 0; i < numFibers; i++)
+      yFibers[i] -= yBar;
+
+    // runs of consecutive fibers whose materials have the same class
+    // are updated together by UniaxialMaterial::setTrialBatch()
+    int classTag = theMaterials[0]->getClassTag();
+    fiberGroups[numFiberGroups++] = 0;
+    for (int i = 1; i < numFibers; i++) {
+      if (theMaterials[i]->getClassTag() != classTag) {
+	classTag = theMaterials[i]->getClassTag();
+	fiberGroups[numFiberGroups++] = i;
+      }
+    }
+    fiberGroups[numFiberGroups] = numFibers;
+  }
+
+  fiberGeometrySet = true;
+}
+
 int
 FiberSection2d::setTrialSectionDeformation (const Vector &deforms)
 {
@@ -386,37 +456,30 @@ FiberSection2d::setTrialSectionDeformation (const Vector &deforms)
   double d0 = deforms(0);
   double d1 = deforms(1);
 
-  static double fiberLocs[10000];
-  static double fiberArea[10000];
+  if (!fiberGeometrySet)
+    this->setFiberGeometry();
 
-  if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, fiberLocs);
-    sectionIntegr->getFiberWeights(numFibers, fiberArea);
-  }  
-  else {
-    for (int i = 0; i < numFibers; i++) {
-      fiberLocs[i] = matData[2*i];
-      fiberArea[i] = matData[2*i+1];
-    }
+  // determine material strains and set them, a group of fibers at a time
+  for (int i = 0; i < numFibers; i++)
+    strainFibers[i] = d0 - yFibers[i]*d1;
+
+  for (int j = 0; j < numFiberGroups; j++) {
+    int i = fiberGroups[j];
+    res += theMaterials[i]->setTrialBatch(fiberGroups[j+1]-i, &theMaterials[i],
+					  &strainFibers[i], &stressFibers[i], &tangentFibers[i]);
   }
   
   for (int i = 0; i < numFibers; i++) {
-    UniaxialMaterial *theMat = theMaterials[i];
-    double y = fiberLocs[i] - yBar;
-    double A = fiberArea[i];
-
-    // determine material strain and set it
-    double strain = d0 - y*d1;
-    double tangent, stress;
-    res += theMat->setTrial(strain, stress, tangent);
+    double y = yFibers[i];
+    double A = AFibers[i];
 
-    double ks0 = tangent * A;
+    double ks0 = tangentFibers[i] * A;
     double ks1 = ks0 * -y;
     kData[0] += ks0;
     kData[1] += ks1;
     kData[3] += ks1 * -y;
 
-    double fs0 = stress * A;
+    double fs0 = stressFibers[i] * A;
     sData[0] += fs0;
     sData[1] += fs0 * -y;
   }
@@ -435,28 +498,17 @@ FiberSection2d::getSectionDeformation(void)
 const Matrix&
 FiberSection2d::getInitialTangent(void)
 {
-  static double kInitial[4];
-  static Matrix kInitialMatrix(kInitial, 2, 2);
+  static thread_local double kInitial[4];
+  static thread_local Matrix kInitialMatrix(kInitial, 2, 2);
   kInitial[0] = 0.0; kInitial[1] = 0.0; kInitial[2] = 0.0; kInitial[3] = 0.0;
 
-  static double fiberLocs[10000];
-  static double fiberArea[10000];
-  
-  if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, fiberLocs);
-    sectionIntegr->getFiberWeights(numFibers, fiberArea);    
-  }  
-  else {
-    for (int i = 0; i < numFibers; i++) {
-      fiberLocs[i] = matData[2*i];
-      fiberArea[i] = matData[2*i+1];      
-    }
-  }
+  if (!fiberGeometrySet)
+    this->setFiberGeometry();
 
   for (int i = 0; i < numFibers; i++) {
     UniaxialMaterial *theMat = theMaterials[i];
-    double y = fiberLocs[i] - yBar;
-    double A = fiberArea[i];
+    double y = yFibers[i];
+    double A = AFibers[i];
 
     double tangent = theMat->getInitialTangent();
 
@@ -540,6 +592,8 @@ FiberSection2d::getCopy(void)
   else
     theCopy->sectionIntegr = 0;
 
+  theCopy->setFiberGeometry();
+
   return theCopy;
 }
 
@@ -555,6 +609,16 @@ FiberSection2d::getOrder () const
   return 2;
 }
 
+bool
+FiberSection2d::isThreadSafe(void)
+{
+  for (int i = 0; i < numFibers; i++)
+    if (!theMaterials[i]->isThreadSafe())
+      return false;
+
+  return true;
+}
+
 int
 FiberSection2d::commitState(void)
 {
@@ -574,24 +638,13 @@ FiberSection2d::revertToLastCommit(void)
   kData[0] = 0.0; kData[1] = 0.0; kData[2] = 0.0; kData[3] = 0.0;
   sData[0] = 0.0; sData[1] = 0.0;
   
-  static double fiberLocs[10000];
-  static double fiberArea[10000];
-
-  if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, fiberLocs);
-    sectionIntegr->getFiberWeights(numFibers, fiberArea);
-  }  
-  else {
-    for (int i = 0; i < numFibers; i++) {
-      fiberLocs[i] = matData[2*i];
-      fiberArea[i] = matData[2*i+1];
-    }
-  }
+  if (!fiberGeometrySet)
+    this->setFiberGeometry();
 
   for (int i = 0; i < numFibers; i++) {
     UniaxialMaterial *theMat = theMaterials[i];
-    double y = fiberLocs[i] - yBar;
-    double A = fiberArea[i];
+    double y = yFibers[i];
+    double A = AFibers[i];
 
     // invoke revertToLast on the material
     err += theMat->revertToLastCommit();
@@ -624,24 +677,13 @@ FiberSection2d::revertToStart(void)
   kData[0] = 0.0; kData[1] = 0.0; kData[2] = 0.0; kData[3] = 0.0;
   sData[0] = 0.0; sData[1] = 0.0;
   
-  static double fiberLocs[10000];
-  static double fiberArea[10000];
-
-  if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, fiberLocs);
-    sectionIntegr->getFiberWeights(numFibers, fiberArea);
-  }  
-  else {
-    for (int i = 0; i < numFibers; i++) {
-      fiberLocs[i] = matData[2*i];
-      fiberArea[i] = matData[2*i+1];
-    }
-  }
+  if (!fiberGeometrySet)
+    this->setFiberGeometry();
 
   for (int i = 0; i < numFibers; i++) {
     UniaxialMaterial *theMat = theMaterials[i];
-    double y = fiberLocs[i] - yBar;
-    double A = fiberArea[i];
+    double y = yFibers[i];
+    double A = AFibers[i];
 
     // invoke revertToLast on the material
     err += theMat->revertToStart();
@@ -873,33 +915,19 @@ FiberSection2d::recvSelf(int commitTag, Channel &theChannel,
   
   computeCentroid = data(2) ? true : false;
 
-  if (sectionIntegr != 0) {
-    static double fiberLocs[10000];
-    sectionIntegr->getFiberLocations(numFibers, fiberLocs);
-    
-    static double fiberArea[10000];
-    sectionIntegr->getFiberWeights(numFibers, fiberArea);
-    
-    for (int i = 0; i < numFibers; i++) {
-      ABar  += fiberArea[i];
-      QzBar += fiberLocs[i]*fiberArea[i];
-    }
-  }
-  else {
-    double yLoc, Area;
+  yBar = 0.0;
+  this->setFiberGeometry();
 
-    for (int i = 0; i < numFibers; i++) {
-      yLoc = matData[2*i];
-      Area = matData[2*i+1];
-      ABar  += Area;
-      QzBar += yLoc*Area;
-    }
+  for (int i = 0; i < numFibers; i++) {
+    ABar  += AFibers[i];
+    QzBar += yFibers[i]*AFibers[i];
   }
   
   if (computeCentroid && ABar != 0.0)
     yBar = QzBar/ABar;
-  else
-    yBar = 0.0;
+
+  for (int i = 0; i < numFibers; i++)
+    yFibers[i] -= yBar;
 
   return res;
 }
@@ -963,16 +991,8 @@ FiberSection2d::setResponse(const char **argv, int argc,
   
   if (argc > 2 && strcmp(argv[0],"fiber") == 0) {
 
-    static double fiberLocs[10000];
-    
-    if (sectionIntegr != 0) {
-      sectionIntegr->getFiberLocations(numFibers, fiberLocs);
-    }  
-    else {
-      for (int i = 0; i < numFibers; i++) {
-	fiberLocs[i] = matData[2*i];
-      }
-    }
+    if (!fiberGeometrySet)
+      this->setFiberGeometry();
   
     int key = numFibers;
     int passarg = 2;
@@ -994,7 +1014,7 @@ FiberSection2d::setResponse(const char **argv, int argc,
       for (j = 0; j < numFibers; j++) {
 	if (matTag == theMaterials[j]->getTag()) {
 	  //ySearch = matData[2*j];
-	  ySearch = fiberLocs[j];
+	  ySearch = yFibers[j] + yBar;
 	  dy = ySearch-yCoord;
 	  closestDist = dy*dy;
 	  key = j;
@@ -1005,7 +1025,7 @@ FiberSection2d::setResponse(const char **argv, int argc,
       for ( ; j < numFibers; j++) {
 	if (matTag == theMaterials[j]->getTag()) {
 	  //ySearch = matData[2*j];
-	  ySearch = fiberLocs[j];	  
+	  ySearch = yFibers[j] + yBar;	  
 	  dy = ySearch-yCoord;
 	  distance = dy*dy;
 	  if (distance < closestDist) {
@@ -1025,13 +1045,13 @@ FiberSection2d::setResponse(const char **argv, int argc,
       double distance;
       
       //ySearch = matData[0];
-      ySearch = fiberLocs[0];      
+      ySearch = yFibers[0] + yBar;      
       dy = ySearch-yCoord;
       closestDist = dy*dy;
       key = 0;
       for (int j = 1; j < numFibers; j++) {
 	//ySearch = matData[2*j];
-	ySearch = fiberLocs[j];	  	
+	ySearch = yFibers[j] + yBar;	  	
 	dy = ySearch-yCoord;
 	
 	distance = dy*dy;
@@ -1272,8 +1292,12 @@ FiberSection2d::setParameter(const char **argv, int argc, Parameter &param)
 
   // Check if it belongs to the section integration
   if (strstr(argv[0],"integration") != 0) {
-    if (sectionIntegr != 0)
-      return sectionIntegr->setParameter(&argv[1], argc-1, param);
+    if (sectionIntegr != 0) {
+      result = sectionIntegr->setParameter(&argv[1], argc-1, param);
+      if (result != -1)
+	param.addObject(1, this);
+      return result;
+    }
     else
       return -1;
   }
@@ -1288,13 +1312,25 @@ FiberSection2d::setParameter(const char **argv, int argc, Parameter &param)
 
   if (sectionIntegr != 0) {
     ok = sectionIntegr->setParameter(argv, argc, param);
-    if (ok != -1)
+    if (ok != -1) {
       result = ok;
+      param.addObject(1, this);
+    }
   }
 
   return result;
 }
 
+int
+FiberSection2d::updateParameter(int parameterID, Information &info)
+{
+  // fiber locations or weights have changed in the section integration
+  if (parameterID == 1)
+    fiberGeometrySet = false;
+
+  return 0;
+}
+
 const Vector &
 FiberSection2d::getSectionDeformationSensitivity(int gradIndex)
 {
@@ -1316,37 +1352,20 @@ FiberSection2d::getStressResultantSensitivity(int gradIndex, bool conditional)
   double tangent = 0.0;
   double sig_dAdh = 0.0;
 
-  static double fiberLocs[10000];
-  static double fiberArea[10000];
+  if (!fiberGeometrySet)
+    this->setFiberGeometry();
 
-  if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, fiberLocs);
-    sectionIntegr->getFiberWeights(numFibers, fiberArea);
-  }  
-  else {
-    for (int i = 0; i < numFibers; i++) {
-      fiberLocs[i] = matData[2*i];
-      fiberArea[i] = matData[2*i+1];
-    }
-  }
-
-  static double locsDeriv[10000];
-  static double areaDeriv[10000];
+  std::vector<double> locsDeriv(numFibers, 0.0);
+  std::vector<double> areaDeriv(numFibers, 0.0);
 
   if (sectionIntegr != 0) {
-    sectionIntegr->getLocationsDeriv(numFibers, locsDeriv);  
-    sectionIntegr->getWeightsDeriv(numFibers, areaDeriv);
-  }
-  else {
-    for (int i = 0; i < numFibers; i++) {
-      locsDeriv[i] = 0.0;
-      areaDeriv[i] = 0.0;
-    }
+    sectionIntegr->getLocationsDeriv(numFibers, locsDeriv.data());
+    sectionIntegr->getWeightsDeriv(numFibers, areaDeriv.data());
   }
   
   for (int i = 0; i < numFibers; i++) {
-    y = fiberLocs[i] - yBar;
-    A = fiberArea[i];
+    y = yFibers[i];
+    A = AFibers[i];
     
     stressGradient = theMaterials[i]->getStressSensitivity(gradIndex,true);
     stressGradient = stressGradient * A;
@@ -1372,7 +1391,7 @@ FiberSection2d::getStressResultantSensitivity(int gradIndex, bool conditional)
       tangent = tangent * A * e(1);
       
       ds(0) += -locsDeriv[i]*tangent;
-      ds(1) += fiberLocs[i]*locsDeriv[i]*tangent;
+      ds(1) += (yFibers[i]+yBar)*locsDeriv[i]*tangent;
     }
 
     //opserr << locsDeriv[i] << ' ' << areaDeriv[i] << endln;
@@ -1392,37 +1411,20 @@ FiberSection2d::getInitialTangentSensitivity(int gradIndex)
   double tangent = 0.0;
   double dtangentdh = 0.0;
 
-  static double fiberLocs[10000];
-  static double fiberArea[10000];
+  if (!fiberGeometrySet)
+    this->setFiberGeometry();
 
-  if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, fiberLocs);
-    sectionIntegr->getFiberWeights(numFibers, fiberArea);
-  }  
-  else {
-    for (int i = 0; i < numFibers; i++) {
-      fiberLocs[i] = matData[2*i];
-      fiberArea[i] = matData[2*i+1];
-    }
-  }
-
-  static double locsDeriv[10000];
-  static double areaDeriv[10000];
+  std::vector<double> locsDeriv(numFibers, 0.0);
+  std::vector<double> areaDeriv(numFibers, 0.0);
 
   if (sectionIntegr != 0) {
-    sectionIntegr->getLocationsDeriv(numFibers, locsDeriv);  
-    sectionIntegr->getWeightsDeriv(numFibers, areaDeriv);
-  }
-  else {
-    for (int i = 0; i < numFibers; i++) {
-      locsDeriv[i] = 0.0;
-      areaDeriv[i] = 0.0;
-    }
+    sectionIntegr->getLocationsDeriv(numFibers, locsDeriv.data());
+    sectionIntegr->getWeightsDeriv(numFibers, areaDeriv.data());
   }
   
   for (int i = 0; i < numFibers; i++) {
-    y = fiberLocs[i] - yBar;
-    A = fiberArea[i];
+    y = yFibers[i];
+    A = AFibers[i];
     dydh = locsDeriv[i];
     dAdh = areaDeriv[i];
     
@@ -1450,27 +1452,15 @@ FiberSection2d::commitSensitivity(const Vector& defSens,
 
   dedh = defSens;
 
-  static double fiberLocs[10000];
-
-  if (sectionIntegr != 0)
-    sectionIntegr->getFiberLocations(numFibers, fiberLocs);
-  else {
-    for (int i = 0; i < numFibers; i++)
-      fiberLocs[i] = matData[2*i];
-  }
+  if (!fiberGeometrySet)
+    this->setFiberGeometry();
 
-  static double locsDeriv[10000];
-  static double areaDeriv[10000];
+  std::vector<double> locsDeriv(numFibers, 0.0);
+  std::vector<double> areaDeriv(numFibers, 0.0);
 
   if (sectionIntegr != 0) {
-    sectionIntegr->getLocationsDeriv(numFibers, locsDeriv);  
-    sectionIntegr->getWeightsDeriv(numFibers, areaDeriv);
-  }
-  else {
-    for (int i = 0; i < numFibers; i++) {
-      locsDeriv[i] = 0.0;
-      areaDeriv[i] = 0.0;
-    }
+    sectionIntegr->getLocationsDeriv(numFibers, locsDeriv.data());
+    sectionIntegr->getWeightsDeriv(numFibers, areaDeriv.data());
   }
 
   double y;
@@ -1478,7 +1468,7 @@ FiberSection2d::commitSensitivity(const Vector& defSens,
 
   for (int i = 0; i < numFibers; i++) {
     UniaxialMaterial *theMat = theMaterials[i];
-    y = fiberLocs[i] - yBar;
+    y = yFibers[i];
 
     // determine material strain and set it
     double strainSens = d0 - y*d1 - locsDeriv[i]*kappa;
@@ -1493,20 +1483,13 @@ FiberSection2d::commitSensitivity(const Vector& defSens,
 //by SAJalali
 double FiberSection2d::getEnergy() const
 {
-	static double fiberArea[10000];
+	if (!fiberGeometrySet)
+		const_cast<FiberSection2d *>(this)->setFiberGeometry();
 
-	if (sectionIntegr != 0) {
-		sectionIntegr->getFiberWeights(numFibers, fiberArea);
-	}
-	else {
-		for (int i = 0; i < numFibers; i++) {
-			fiberArea[i] = matData[2 * i + 1];
-		}
-	}
 	double energy = 0;
 	for (int i = 0; i < numFibers; i++)
 	{
-		double A = fiberArea[i];
+		double A = AFibers[i];
 		energy += A * theMaterials[i]->getEnergy();
 	}
 	return energy;
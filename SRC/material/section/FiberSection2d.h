@@ -69,6 +69,7 @@ class FiberSection2d : public SectionForceDeformation
     SectionForceDeformation *getCopy(void);
     const ID &getType (void);
     int getOrder (void) const;
+    bool isThreadSafe(void);
     
     int sendSelf(int cTag, Channel &theChannel);
     int recvSelf(int cTag, Channel &theChannel, 
@@ -83,6 +84,7 @@ class FiberSection2d : public SectionForceDeformation
 
     // AddingSensitivity:BEGIN //////////////////////////////////////////
     int setParameter(const char **argv, int argc, Parameter &param);
+    int updateParameter(int parameterID, Information &info);
     const Vector& getStressResultantSensitivity(int gradIndex,
 						bool conditional);
     const Vector& getSectionDeformationSensitivity(int gradIndex);
@@ -99,16 +101,26 @@ class FiberSection2d : public SectionForceDeformation
     int numFibers, sizeFibers;       // number of fibers in the section
     UniaxialMaterial **theMaterials; // array of pointers to materials
     double   *matData;               // data for the materials [yloc and area]
+    double   *yFibers;               // fiber locations relative to yBar
+    double   *AFibers;               // fiber areas
+    double   *strainFibers;          // fiber strains, stresses and tangents
+    double   *stressFibers;          //   passed to setTrialBatch()
+    double   *tangentFibers;
+    int numFiberGroups;              // runs of fibers with the same material class
+    int *fiberGroups;                // first fiber of each run, numFibers at the end
     double   kData[4];               // data for ks matrix 
     double   sData[2];               // data for s vector 
     
     double QzBar, ABar, yBar;       // Section centroid
     bool computeCentroid;
+    bool fiberGeometrySet;          // yFibers and AFibers are current
       
     SectionIntegration *sectionIntegr;
 
     static ID code;
 
+    void setFiberGeometry(void);    // fill yFibers and AFibers and fiberGroups
+
     Vector e;          // trial section deformations 
     Vector *s;         // section resisting forces  (axial force, bending moment)
     Matrix *ks;        // section stiffness
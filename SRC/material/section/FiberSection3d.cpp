@@ -29,6 +29,7 @@
 
 #include <stdlib.h>
 #include <math.h>
+#include <vector>
 
 #include <Channel.h>
 #include <Vector.h>
@@ -40,6 +41,7 @@
 #include <ID.h>
 #include <FEM_ObjectBroker.h>
 #include <Information.h>
+#include <Parameter.h>
 #include <MaterialResponse.h>
 #include <UniaxialMaterial.h>
 #include <ElasticMaterial.h>
@@ -114,15 +116,11 @@ void* OPS_FiberSection3d()
 FiberSection3d::FiberSection3d(int tag, int num, Fiber **fibers,
 			       UniaxialMaterial &torsion, bool compCentroid): 
   SectionForceDeformation(tag, SEC_TAG_FiberSection3d),
-  numFibers(num), sizeFibers(num), theMaterials(0), matData(0),
+  numFibers(num), sizeFibers(num), theMaterials(0), matData(0), yFibers(0), zFibers(0), AFibers(0),
+  strainFibers(0), stressFibers(0), tangentFibers(0), numFiberGroups(0), fiberGroups(0),
   QzBar(0.0), QyBar(0.0), Abar(0.0), yBar(0.0), zBar(0.0), computeCentroid(compCentroid),
-  sectionIntegr(0), e(4), s(0), ks(0), theTorsion(0)
+  fiberGeometrySet(false), sectionIntegr(0), e(4), s(0), ks(0), theTorsion(0)
 {
-  if (numFibers > 10000) {
-    opserr << "ERROR: FiberSection3d::FiberSection3d -- section has more than 10,000 fibers. You can surely use fewer fibers." << endln;
-    exit(-1);
-  }
-  
   if (numFibers > 0) {
     theMaterials = new UniaxialMaterial *[numFibers];
 
@@ -164,6 +162,8 @@ FiberSection3d::FiberSection3d(int tag, int num, Fiber **fibers,
       yBar = QzBar/Abar;
       zBar = QyBar/Abar;
     }
+
+    this->setFiberGeometry();
   }
 
   theTorsion = torsion.getCopy();
@@ -189,15 +189,11 @@ FiberSection3d::FiberSection3d(int tag, int num, Fiber **fibers,
 
 FiberSection3d::FiberSection3d(int tag, int num, UniaxialMaterial &torsion, bool compCentroid): 
     SectionForceDeformation(tag, SEC_TAG_FiberSection3d),
-    numFibers(0), sizeFibers(num), theMaterials(0), matData(0),
+    numFibers(0), sizeFibers(num), theMaterials(0), matData(0), yFibers(0), zFibers(0), AFibers(0),
+  strainFibers(0), stressFibers(0), tangentFibers(0), numFiberGroups(0), fiberGroups(0),
     QzBar(0.0), QyBar(0.0), Abar(0.0), yBar(0.0), zBar(0.0), computeCentroid(compCentroid),
-    sectionIntegr(0), e(4), s(0), ks(0), theTorsion(0)
+    fiberGeometrySet(false), sectionIntegr(0), e(4), s(0), ks(0), theTorsion(0)
 {
-  if (numFibers > 10000) {
-    opserr << "ERROR: FiberSection3d::FiberSection3d -- section has more than 10,000 fibers. You can surely use fewer fibers." << endln;
-    exit(-1);
-  }
- 
     if(sizeFibers > 0) {
 	theMaterials = new UniaxialMaterial *[sizeFibers];
 
@@ -246,15 +242,11 @@ FiberSection3d::FiberSection3d(int tag, int num, UniaxialMaterial **mats,
 			       SectionIntegration &si, UniaxialMaterial &torsion,
 			       bool compCentroid):
   SectionForceDeformation(tag, SEC_TAG_FiberSection3d),
-  numFibers(num), sizeFibers(num), theMaterials(0), matData(0),
+  numFibers(num), sizeFibers(num), theMaterials(0), matData(0), yFibers(0), zFibers(0), AFibers(0),
+  strainFibers(0), stressFibers(0), tangentFibers(0), numFiberGroups(0), fiberGroups(0),
   QzBar(0.0), QyBar(0.0), Abar(0.0), yBar(0.0), zBar(0.0), computeCentroid(compCentroid),
-  sectionIntegr(0), e(4), s(0), ks(0), theTorsion(0)
+  fiberGeometrySet(false), sectionIntegr(0), e(4), s(0), ks(0), theTorsion(0)
 {
-  if (numFibers > 10000) {
-    opserr << "ERROR: FiberSection3d::FiberSection3d -- section has more than 10,000 fibers. You can surely use fewer fibers." << endln;
-    exit(-1);
-  }
- 
   if (numFibers > 0) {
     theMaterials = new UniaxialMaterial *[numFibers];
 
@@ -276,19 +268,8 @@ FiberSection3d::FiberSection3d(int tag, int num, UniaxialMaterial **mats,
     exit(-1);
   }
 
-  static double yLocs[10000];
-  static double zLocs[10000];
-  sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
-  
-  static double fiberArea[10000];
-  sectionIntegr->getFiberWeights(numFibers, fiberArea);
-  
   for (int i = 0; i < numFibers; i++) {
 
-    Abar  += fiberArea[i];
-    QzBar += yLocs[i]*fiberArea[i];
-    QyBar += zLocs[i]*fiberArea[i];
-
     theMaterials[i] = mats[i]->getCopy();
     
     if (theMaterials[i] == 0) {
@@ -297,10 +278,23 @@ FiberSection3d::FiberSection3d(int tag, int num, UniaxialMaterial **mats,
     }
   }    
 
+  this->setFiberGeometry();
+
+  for (int i = 0; i < numFibers; i++) {
+    Abar  += AFibers[i];
+    QzBar += yFibers[i]*AFibers[i];
+    QyBar += zFibers[i]*AFibers[i];
+  }
+
   if (computeCentroid) {
     yBar = QzBar/Abar;  
     zBar = QyBar/Abar;  
   }
+
+  for (int i = 0; i < numFibers; i++) {
+    yFibers[i] -= yBar;
+    zFibers[i] -= zBar;
+  }
   
   theTorsion = torsion.getCopy();
   if (theTorsion == 0)
@@ -324,9 +318,10 @@ FiberSection3d::FiberSection3d(int tag, int num, UniaxialMaterial **mats,
 // constructor for blank object that recvSelf needs to be invoked upon
 FiberSection3d::FiberSection3d():
   SectionForceDeformation(0, SEC_TAG_FiberSection3d),
-  numFibers(0), sizeFibers(0), theMaterials(0), matData(0),
+  numFibers(0), sizeFibers(0), theMaterials(0), matData(0), yFibers(0), zFibers(0), AFibers(0),
+  strainFibers(0), stressFibers(0), tangentFibers(0), numFiberGroups(0), fiberGroups(0),
   QzBar(0.0), QyBar(0.0), Abar(0.0), yBar(0.0), zBar(0.0), computeCentroid(true),
-  sectionIntegr(0), e(4), s(0), ks(0), theTorsion(0)
+  fiberGeometrySet(false), sectionIntegr(0), e(4), s(0), ks(0), theTorsion(0)
 {
   s = new Vector(sData, 4);
   ks = new Matrix(kData, 4, 4);
@@ -348,11 +343,6 @@ FiberSection3d::FiberSection3d():
 int
 FiberSection3d::addFiber(Fiber &newFiber)
 {
-  if (numFibers >= 10000) {
-    opserr << "ERROR: FiberSection3d::addFiber -- section has more than 10,000 fibers. You can surely use fewer fibers." << endln;
-    exit(-1);
-  }
-  
   // need to create a larger array
   if(numFibers == sizeFibers) {
       int newSize = 2*sizeFibers;
@@ -417,6 +407,8 @@ FiberSection3d::addFiber(Fiber &newFiber)
     yBar = QzBar/Abar;
     zBar = QyBar/Abar;
   }
+
+  fiberGeometrySet = false;
   
   return 0;
 }
@@ -437,6 +429,27 @@ FiberSection3d::~FiberSection3d()
   if (matData != 0)
     delete [] matData;
 
+  if (yFibers != 0)
+    delete [] yFibers;
+
+  if (zFibers != 0)
+    delete [] zFibers;
+
+  if (AFibers != 0)
+    delete [] AFibers;
+
+  if (strainFibers != 0)
+    delete [] strainFibers;
+
+  if (stressFibers != 0)
+    delete [] stressFibers;
+
+  if (tangentFibers != 0)
+    delete [] tangentFibers;
+
+  if (fiberGroups != 0)
+    delete [] fiberGroups;
+
   if (s != 0)
     delete s;
 
@@ -450,6 +463,74 @@ FiberSection3d::~FiberSection3d()
     delete theTorsion;
 }
 
+void
+FiberSection3d::setFiberGeometry(void)
+{
+  if (yFibers != 0)
+    delete [] yFibers;
+  if (zFibers != 0)
+    delete [] zFibers;
+  if (AFibers != 0)
+    delete [] AFibers;
+  if (strainFibers != 0)
+    delete [] strainFibers;
+  if (stressFibers != 0)
+    delete [] stressFibers;
+  if (tangentFibers != 0)
+    delete [] tangentFibers;
+  if (fiberGroups != 0)
+    delete [] fiberGroups;
+  yFibers = 0;
+  zFibers = 0;
+  AFibers = 0;
+  strainFibers = 0;
+  stressFibers = 0;
+  tangentFibers = 0;
+  fiberGroups = 0;
+  numFiberGroups = 0;
+
+  if (numFibers > 0) {
+    yFibers = new double [numFibers];
+    zFibers = new double [numFibers];
+    AFibers = new double [numFibers];
+    strainFibers = new double [numFibers];
+    stressFibers = new double [numFibers];
+    tangentFibers = new double [numFibers];
+    fiberGroups = new int [numFibers+1];
+
+    if (sectionIntegr != 0) {
+      sectionIntegr->getFiberLocations(numFibers, yFibers, zFibers);
+      sectionIntegr->getFiberWeights(numFibers, AFibers);
+    }
+    else {
+      for (int i = 0; i < numFibers; i++) {
+	yFibers[i] = matData[3*i];
+	zFibers[i] = matData[3*i+1];
+	AFibers[i] = matData[3*i+2];
+      }
+    }
+
+    for (int i = 0; i < numFibers; i++) {
+      yFibers[i] -= yBar;
+      zFibers[i] -= zBar;
+    }
+
+    // runs of consecutive fibers whose materials have the same class
+    // are updated together by UniaxialMaterial::setTrialBatch()
+    int classTag = theMaterials[0]->getClassTag();
+    fiberGroups[numFiberGroups++] = 0;
+    for (int i = 1; i < numFibers; i++) {
+      if (theMaterials[i]->getClassTag() != classTag) {
+	classTag = theMaterials[i]->getClassTag();
+	fiberGroups[numFiberGroups++] = i;
+      }
+    }
+    fiberGroups[numFiberGroups] = numFibers;
+  }
+
+  fiberGeometrySet = true;
+}
+
 int
 FiberSection3d::setTrialSectionDeformation (const Vector &deforms)
 {
@@ -466,35 +547,25 @@ FiberSection3d::setTrialSectionDeformation (const Vector &deforms)
   double d2 = deforms(2);
   double d3 = deforms(3);
 
-  static double yLocs[10000];
-  static double zLocs[10000];
-  static double fiberArea[10000];
- 
-  if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
-    sectionIntegr->getFiberWeights(numFibers, fiberArea);
-  }  
-  else {
-	
-    for (int i = 0; i < numFibers; i++) {
-		
-      yLocs[i] = matData[3*i];
-      zLocs[i] = matData[3*i+1];
-      fiberArea[i] = matData[3*i+2];
-    }
+  if (!fiberGeometrySet)
+    this->setFiberGeometry();
+
+  // determine material strains and set them, a group of fibers at a time
+  for (int i = 0; i < numFibers; i++)
+    strainFibers[i] = d0 - yFibers[i]*d1 + zFibers[i]*d2;
+
+  for (int j = 0; j < numFiberGroups; j++) {
+    int i = fiberGroups[j];
+    res += theMaterials[i]->setTrialBatch(fiberGroups[j+1]-i, &theMaterials[i],
+					  &strainFibers[i], &stressFibers[i], &tangentFibers[i]);
   }
  
-  double tangent, stress;
   for (int i = 0; i < numFibers; i++) {
-    double y = yLocs[i] - yBar;
-    double z = zLocs[i] - zBar;
-    double A = fiberArea[i];
+    double y = yFibers[i];
+    double z = zFibers[i];
+    double A = AFibers[i];
 
-    // determine material strain and set it
-    double strain = d0 - y*d1 + z*d2;
-    res += theMaterials[i]->setTrial(strain, stress, tangent);
-
-    double value = tangent * A;
+    double value = tangentFibers[i] * A;
     double vas1 = -y*value;
     double vas2 = z*value;
     double vas1as2 = vas1*z;
@@ -508,7 +579,7 @@ FiberSection3d::setTrialSectionDeformation (const Vector &deforms)
     
     kData[10] += vas2 * z; 
 
-    double fs0 = stress * A;
+    double fs0 = stressFibers[i] * A;
 
     sData[0] += fs0;
     sData[1] += fs0 * -y;
@@ -520,6 +591,7 @@ FiberSection3d::setTrialSectionDeformation (const Vector &deforms)
   kData[9] = kData[6];
  
   if (theTorsion != 0) {
+    double stress, tangent;
     res += theTorsion->setTrial(d3, stress, tangent);
     sData[3] = stress;
     kData[15] = tangent;
@@ -531,31 +603,18 @@ FiberSection3d::setTrialSectionDeformation (const Vector &deforms)
 const Matrix&
 FiberSection3d::getInitialTangent(void)
 {
-  static double kInitialData[16];
-  static Matrix kInitial(kInitialData, 4, 4);
+  static thread_local double kInitialData[16];
+  static thread_local Matrix kInitial(kInitialData, 4, 4);
   
   kInitial.Zero();
 
-  static double yLocs[10000];
-  static double zLocs[10000];
-  static double fiberArea[10000];
-
-  if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
-    sectionIntegr->getFiberWeights(numFibers, fiberArea);
-  }  
-  else {
-    for (int i = 0; i < numFibers; i++) {
-      yLocs[i] = matData[3*i];
-      zLocs[i] = matData[3*i+1];
-      fiberArea[i] = matData[3*i+2];
-    }
-  }
+  if (!fiberGeometrySet)
+    this->setFiberGeometry();
 
   for (int i = 0; i < numFibers; i++) {
-    double y = yLocs[i] - yBar;
-    double z = zLocs[i] - zBar;
-    double A = fiberArea[i];
+    double y = yFibers[i];
+    double z = zFibers[i];
+    double A = AFibers[i];
 
     double tangent = theMaterials[i]->getInitialTangent();
 
@@ -666,6 +725,8 @@ FiberSection3d::getCopy(void)
   else
     theCopy->sectionIntegr = 0;
 
+  theCopy->setFiberGeometry();
+
   return theCopy;
 }
 
@@ -681,6 +742,19 @@ FiberSection3d::getOrder () const
   return 4;
 }
 
+bool
+FiberSection3d::isThreadSafe(void)
+{
+  for (int i = 0; i < numFibers; i++)
+    if (!theMaterials[i]->isThreadSafe())
+      return false;
+
+  if (theTorsion != 0 && !theTorsion->isThreadSafe())
+    return false;
+
+  return true;
+}
+
 int
 FiberSection3d::commitState(void)
 {
@@ -706,27 +780,14 @@ FiberSection3d::revertToLastCommit(void)
   kData[15] = 0.0;
   sData[0] = 0.0; sData[1] = 0.0;  sData[2] = 0.0; sData[3] = 0.0;
 
-  static double yLocs[10000];
-  static double zLocs[10000];
-  static double fiberArea[10000];
-
-  if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
-    sectionIntegr->getFiberWeights(numFibers, fiberArea);
-  }  
-  else {
-    for (int i = 0; i < numFibers; i++) {
-      yLocs[i] = matData[3*i];
-      zLocs[i] = matData[3*i+1];
-      fiberArea[i] = matData[3*i+2];
-    }
-  }
+  if (!fiberGeometrySet)
+    this->setFiberGeometry();
 
   for (int i = 0; i < numFibers; i++) {
     UniaxialMaterial *theMat = theMaterials[i];
-    double y = yLocs[i] - yBar;
-    double z = zLocs[i] - zBar;
-    double A = fiberArea[i];
+    double y = yFibers[i];
+    double z = zFibers[i];
+    double A = AFibers[i];
 
     // invoke revertToLast on the material
     err += theMat->revertToLastCommit();
@@ -779,27 +840,14 @@ FiberSection3d::revertToStart(void)
   kData[15] = 0.0; 
   sData[0] = 0.0; sData[1] = 0.0;  sData[2] = 0.0; sData[3] = 0.0;
 
-  static double yLocs[10000];
-  static double zLocs[10000];
-  static double fiberArea[10000];
-
-  if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
-    sectionIntegr->getFiberWeights(numFibers, fiberArea);
-  }  
-  else {
-    for (int i = 0; i < numFibers; i++) {
-      yLocs[i] = matData[3*i];
-      zLocs[i] = matData[3*i+1];
-      fiberArea[i] = matData[3*i+2];
-    }
-  }
+  if (!fiberGeometrySet)
+    this->setFiberGeometry();
 
   for (int i = 0; i < numFibers; i++) {
     UniaxialMaterial *theMat = theMaterials[i];
-    double y = yLocs[i] - yBar;
-    double z = zLocs[i] - zBar;
-    double A = fiberArea[i];
+    double y = yFibers[i];
+    double z = zFibers[i];
+    double A = AFibers[i];
 
     // invoke revertToStart on the material
     err += theMat->revertToStart();
@@ -1080,38 +1128,24 @@ FiberSection3d::recvSelf(int commitTag, Channel &theChannel,
 
     computeCentroid = data(5) ? true : false;
 
-    if (sectionIntegr != 0) {
-      static double yLocs[10000];
-      static double zLocs[10000];
-      sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
-      
-      static double fiberArea[10000];
-      sectionIntegr->getFiberWeights(numFibers, fiberArea);
-      
-      for (int i = 0; i < numFibers; i++) {
-	Abar  += fiberArea[i];
-	QzBar += yLocs[i]*fiberArea[i];
-	QyBar += zLocs[i]*fiberArea[i];
-      }
-    }
-    else {
-      double yLoc, zLoc, Area;
-      for (i = 0; computeCentroid && i < numFibers; i++) {
-	yLoc = matData[3*i];
-	zLoc = matData[3*i+1];
-	Area = matData[3*i+2];
-	Abar  += Area;
-	QzBar += yLoc*Area;
-	QyBar += zLoc*Area;
-      }
+    yBar = 0.0;
+    zBar = 0.0;
+    this->setFiberGeometry();
+
+    for (i = 0; computeCentroid && i < numFibers; i++) {
+      Abar  += AFibers[i];
+      QzBar += yFibers[i]*AFibers[i];
+      QyBar += zFibers[i]*AFibers[i];
     }
     
     if (computeCentroid && Abar != 0.0) {
       yBar = QzBar/Abar;
       zBar = QyBar/Abar;
-    } else {
-      yBar = 0.0;
-      zBar = 0.0;      
+    }
+
+    for (i = 0; i < numFibers; i++) {
+      yFibers[i] -= yBar;
+      zFibers[i] -= zBar;
     }
   }   
 
@@ -1186,20 +1220,8 @@ FiberSection3d::setResponse(const char **argv, int argc, OPS_Stream &output)
 {
   Response *theResponse = 0;
   
-  static double yLocs[10000];
-  static double zLocs[10000];
-  static double fiberArea[10000];
-  
-  if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
-  }  
-  else {
-    for (int i = 0; i < numFibers; i++) {
-      yLocs[i] = matData[3*i];
-      zLocs[i] = matData[3*i+1];
-      fiberArea[i] = matData[3*i+2];      
-    }
-  }
+  if (!fiberGeometrySet)
+    this->setFiberGeometry();
     
   if (argc > 2 && strcmp(argv[0],"fiber") == 0) {
 
@@ -1224,8 +1246,8 @@ FiberSection3d::setResponse(const char **argv, int argc, OPS_Stream &output)
 	if (matTag == theMaterials[j]->getTag()) {
 	  //ySearch = matData[3*j];
 	  //zSearch = matData[3*j+1];
-	  ySearch = yLocs[j];
-	  zSearch = zLocs[j];	    
+	  ySearch = yFibers[j] + yBar;
+	  zSearch = zFibers[j] + zBar;	    
 	  dy = ySearch-yCoord;
 	  dz = zSearch-zCoord;
 	  closestDist = dy*dy + dz*dz;
@@ -1239,8 +1261,8 @@ FiberSection3d::setResponse(const char **argv, int argc, OPS_Stream &output)
 	if (matTag == theMaterials[j]->getTag()) {
 	  //ySearch = matData[3*j];
 	  //zSearch = matData[3*j+1];
-	  ySearch = yLocs[j];
-	  zSearch = zLocs[j];	    	    
+	  ySearch = yFibers[j] + yBar;
+	  zSearch = zFibers[j] + zBar;	    	    
 	  dy = ySearch-yCoord;
 	  dz = zSearch-zCoord;
 	  distance = dy*dy + dz*dz;
@@ -1261,8 +1283,8 @@ FiberSection3d::setResponse(const char **argv, int argc, OPS_Stream &output)
       double distance;
       //ySearch = matData[0];
       //zSearch = matData[1];
-      ySearch = yLocs[0];
-      zSearch = zLocs[0];
+      ySearch = yFibers[0] + yBar;
+      zSearch = zFibers[0] + zBar;
       dy = ySearch-yCoord;
       dz = zSearch-zCoord;
       closestDist = dy*dy + dz*dz;
@@ -1270,8 +1292,8 @@ FiberSection3d::setResponse(const char **argv, int argc, OPS_Stream &output)
       for (int j = 1; j < numFibers; j++) {
 	//ySearch = matData[3*j];
 	//zSearch = matData[3*j+1];
-	ySearch = yLocs[j];
-	zSearch = zLocs[j];	    	    	  
+	ySearch = yFibers[j] + yBar;
+	zSearch = zFibers[j] + zBar;	    	    	  
 	dy = ySearch-yCoord;
 	dz = zSearch-zCoord;
 	distance = dy*dy + dz*dz;
@@ -1285,9 +1307,9 @@ FiberSection3d::setResponse(const char **argv, int argc, OPS_Stream &output)
     
     if (key < numFibers && key >= 0) {
       output.tag("FiberOutput");
-      output.attr("yLoc",yLocs[key]);
-      output.attr("zLoc",zLocs[key]);
-      output.attr("area",fiberArea[key]);
+      output.attr("yLoc",yFibers[key] + yBar);
+      output.attr("zLoc",zFibers[key] + zBar);
+      output.attr("area",AFibers[key]);
       
       theResponse = theMaterials[key]->setResponse(&argv[passarg], argc-passarg, output);
       
@@ -1298,9 +1320,9 @@ FiberSection3d::setResponse(const char **argv, int argc, OPS_Stream &output)
     int numData = numFibers*5;
     for (int j = 0; j < numFibers; j++) {
       output.tag("FiberOutput");
-      output.attr("yLoc", yLocs[j]);
-      output.attr("zLoc", zLocs[j]);
-      output.attr("area", fiberArea[j]);    
+      output.attr("yLoc", yFibers[j] + yBar);
+      output.attr("zLoc", zFibers[j] + zBar);
+      output.attr("area", AFibers[j]);    
       output.tag("ResponseType","yCoord");
       output.tag("ResponseType","zCoord");
       output.tag("ResponseType","area");
@@ -1315,9 +1337,9 @@ FiberSection3d::setResponse(const char **argv, int argc, OPS_Stream &output)
     int numData = numFibers*6;
     for (int j = 0; j < numFibers; j++) {
       output.tag("FiberOutput");
-      output.attr("yLoc", yLocs[j]);
-      output.attr("zLoc", zLocs[j]);
-      output.attr("area", fiberArea[j]);    
+      output.attr("yLoc", yFibers[j] + yBar);
+      output.attr("zLoc", zFibers[j] + zBar);
+      output.attr("area", AFibers[j]);    
       output.attr("material", theMaterials[j]->getTag());
       output.tag("ResponseType","yCoord");
       output.tag("ResponseType","zCoord");
@@ -1364,29 +1386,17 @@ FiberSection3d::setResponse(const char **argv, int argc, OPS_Stream &output)
 int 
 FiberSection3d::getResponse(int responseID, Information &sectInfo)
 {
-  static double yLocs[10000];
-  static double zLocs[10000];
-  static double fiberArea[10000];
-  
-  if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
-  }  
-  else {
-    for (int i = 0; i < numFibers; i++) {
-      yLocs[i] = matData[3*i];
-      zLocs[i] = matData[3*i+1];
-      fiberArea[i] = matData[3*i+2];      
-    }
-  }
+  if (!fiberGeometrySet)
+    this->setFiberGeometry();
   
   if (responseID == 5) {
     int numData = 5*numFibers;
     Vector data(numData);
     int count = 0;
     for (int j = 0; j < numFibers; j++) {
-      data(count)   = yLocs[j]; // y
-      data(count+1) = zLocs[j]; // z
-      data(count+2) = fiberArea[j]; // A
+      data(count)   = yFibers[j] + yBar; // y
+      data(count+1) = zFibers[j] + zBar; // z
+      data(count+2) = AFibers[j]; // A
       data(count+3) = theMaterials[j]->getStress();
       data(count+4) = theMaterials[j]->getStrain();
       count += 5;
@@ -1397,9 +1407,9 @@ FiberSection3d::getResponse(int responseID, Information &sectInfo)
     Vector data(numData);
     int count = 0;
     for (int j = 0; j < numFibers; j++) {
-      data(count)   = yLocs[j]; // y
-      data(count+1) = zLocs[j]; // z
-      data(count+2) = fiberArea[j]; // A
+      data(count)   = yFibers[j] + yBar; // y
+      data(count+1) = zFibers[j] + zBar; // z
+      data(count+2) = AFibers[j]; // A
       data(count+3) = (double)theMaterials[j]->getTag();
       data(count+4) = theMaterials[j]->getStress();
       data(count+5) = theMaterials[j]->getStrain();	    
@@ -1474,8 +1484,12 @@ FiberSection3d::setParameter(const char **argv, int argc, Parameter &param)
 
   // Check if it belongs to the section integration
   else if (strstr(argv[0],"integration") != 0) {
-    if (sectionIntegr != 0)
-      return sectionIntegr->setParameter(&argv[1], argc-1, param);
+    if (sectionIntegr != 0) {
+      result = sectionIntegr->setParameter(&argv[1], argc-1, param);
+      if (result != -1)
+	param.addObject(1, this);
+      return result;
+    }
     else
       return -1;
   }
@@ -1496,13 +1510,25 @@ FiberSection3d::setParameter(const char **argv, int argc, Parameter &param)
 
   if (sectionIntegr != 0) {
     ok = sectionIntegr->setParameter(argv, argc, param);
-    if (ok != -1)
+    if (ok != -1) {
       result = ok;
+      param.addObject(1, this);
+    }
   }
 
   return result;
 }
 
+int
+FiberSection3d::updateParameter(int parameterID, Information &info)
+{
+  // fiber locations or weights have changed in the section integration
+  if (parameterID == 1)
+    fiberGeometrySet = false;
+
+  return 0;
+}
+
 const Vector &
 FiberSection3d::getSectionDeformationSensitivity(int gradIndex)
 {
@@ -1527,42 +1553,22 @@ FiberSection3d::getStressResultantSensitivity(int gradIndex, bool conditional)
   double sig_dAdh = 0;
   double tangent = 0;
 
-  static double yLocs[10000];
-  static double zLocs[10000];
-  static double fiberArea[10000];
-
-  if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
-    sectionIntegr->getFiberWeights(numFibers, fiberArea);
-  }  
-  else {
-    for (int i = 0; i < numFibers; i++) {
-      yLocs[i] = matData[3*i];
-      zLocs[i] = matData[3*i+1];
-      fiberArea[i] = matData[3*i+2];
-    }
-  }
+  if (!fiberGeometrySet)
+    this->setFiberGeometry();
 
-  static double dydh[10000];
-  static double dzdh[10000];
-  static double areaDeriv[10000];
+  std::vector<double> dydh(numFibers, 0.0);
+  std::vector<double> dzdh(numFibers, 0.0);
+  std::vector<double> areaDeriv(numFibers, 0.0);
 
   if (sectionIntegr != 0) {
-    sectionIntegr->getLocationsDeriv(numFibers, dydh, dzdh);  
-    sectionIntegr->getWeightsDeriv(numFibers, areaDeriv);
-  }
-  else {
-    for (int i = 0; i < numFibers; i++) {
-      dydh[i] = 0.0;
-      dzdh[i] = 0.0;
-      areaDeriv[i] = 0.0;
-    }
+    sectionIntegr->getLocationsDeriv(numFibers, dydh.data(), dzdh.data());
+    sectionIntegr->getWeightsDeriv(numFibers, areaDeriv.data());
   }
   
   for (int i = 0; i < numFibers; i++) {
-    y = yLocs[i] - yBar;
-    z = zLocs[i] - zBar;
-    A = fiberArea[i];
+    y = yFibers[i];
+    z = zFibers[i];
+    A = AFibers[i];
     
     dsigdh = theMaterials[i]->getStressSensitivity(gradIndex, conditional);
 
@@ -1636,37 +1642,22 @@ FiberSection3d::commitSensitivity(const Vector& defSens, int gradIndex, int numG
 
   //dedh = defSens;
 
-  static double yLocs[10000];
-  static double zLocs[10000];
+  if (!fiberGeometrySet)
+    this->setFiberGeometry();
 
-  if (sectionIntegr != 0)
-    sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
-  else {
-    for (int i = 0; i < numFibers; i++) {
-      yLocs[i] = matData[3*i];
-      zLocs[i] = matData[3*i+1];
-    }
-  }
-
-  static double dydh[10000];
-  static double dzdh[10000];
+  std::vector<double> dydh(numFibers, 0.0);
+  std::vector<double> dzdh(numFibers, 0.0);
 
   if (sectionIntegr != 0)
-    sectionIntegr->getLocationsDeriv(numFibers, dydh, dzdh);  
-  else {
-    for (int i = 0; i < numFibers; i++) {
-      dydh[i] = 0.0;
-      dzdh[i] = 0.0;
-    }
-  }
+    sectionIntegr->getLocationsDeriv(numFibers, dydh.data(), dzdh.data());
 
   double y, z;
 
   double depsdh = 0;
 
   for (int i = 0; i < numFibers; i++) {
-    y = yLocs[i] - yBar;
-    z = zLocs[i] - zBar;
+    y = yFibers[i];
+    z = zFibers[i];
 
     // determine material strain and set it
     depsdh = d0 - y*d1 + z*d2 - dydh[i]*e(1) + dzdh[i]*e(2);
@@ -1685,20 +1676,13 @@ FiberSection3d::commitSensitivity(const Vector& defSens, int gradIndex, int numG
 //by SAJalali
 double FiberSection3d::getEnergy() const
 {
-	static double fiberArea[10000];
+	if (!fiberGeometrySet)
+		const_cast<FiberSection3d *>(this)->setFiberGeometry();
 
-	if (sectionIntegr != 0) {
-		sectionIntegr->getFiberWeights(numFibers, fiberArea);
-	}
-	else {
-		for (int i = 0; i < numFibers; i++) {
-            fiberArea[i] = matData[3 * i + 2];
-		}
-	}
 	double energy = 0;
 	for (int i = 0; i < numFibers; i++)
 	{
-		double A = fiberArea[i];
+		double A = AFibers[i];
         energy += A *theMaterials[i]->getEnergy();
 	}
 	return energy;
@@ -70,6 +70,7 @@ class FiberSection3d : public SectionForceDeformation
     SectionForceDeformation *getCopy(void);
     const ID &getType (void);
     int getOrder (void) const;
+    bool isThreadSafe(void);
     
     int sendSelf(int cTag, Channel &theChannel);
     int recvSelf(int cTag, Channel &theChannel, 
@@ -84,6 +85,7 @@ class FiberSection3d : public SectionForceDeformation
 
     // AddingSensitivity:BEGIN //////////////////////////////////////////
     int setParameter(const char **argv, int argc, Parameter &param);
+    int updateParameter(int parameterID, Information &info);
 
     const Vector & getStressResultantSensitivity(int gradIndex, bool conditional);
     const Matrix & getSectionTangentSensitivity(int gradIndex);
@@ -102,6 +104,14 @@ class FiberSection3d : public SectionForceDeformation
     int numFibers, sizeFibers;       // number of fibers in the section
     UniaxialMaterial **theMaterials; // array of pointers to materials
     double   *matData;               // data for the materials [yloc, zloc, area]
+    double   *yFibers;               // fiber locations relative to yBar
+    double   *zFibers;               // fiber locations relative to zBar
+    double   *AFibers;               // fiber areas
+    double   *strainFibers;          // fiber strains, stresses and tangents
+    double   *stressFibers;          //   passed to setTrialBatch()
+    double   *tangentFibers;
+    int numFiberGroups;              // runs of fibers with the same material class
+    int *fiberGroups;                // first fiber of each run, numFibers at the end
     double   kData[16];              // data for ks matrix 
     double   sData[4];               // data for s vector 
 
@@ -109,11 +119,14 @@ class FiberSection3d : public SectionForceDeformation
     double yBar;       // Section centroid
     double zBar;
     bool computeCentroid;
+    bool fiberGeometrySet;  // yFibers, zFibers and AFibers are current
     
     SectionIntegration *sectionIntegr;
 
     static ID code;
 
+    void setFiberGeometry(void);    // fill yFibers, zFibers and AFibers and fiberGroups
+
     Vector e;          // trial section deformations 
     Vector *s;         // section resisting forces  (axial force, bending moment)
     Matrix *ks;        // section stiffness
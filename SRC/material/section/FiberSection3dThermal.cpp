@@ -46,6 +46,7 @@
 #include <ElasticMaterial.h>
 #include <SectionIntegration.h>
 #include <math.h>
+#include <vector>
 #include <elementAPI.h>
 
 ID FiberSection3dThermal::code(4);
@@ -120,11 +121,6 @@ FiberSection3dThermal::FiberSection3dThermal(int tag, int num, Fiber **fibers,
   sectionIntegr(0), e(4), eCommit(4), s(0), ks(0), theTorsion(0), sT(3), Fiber_T(0), Fiber_TMax(0),
   parameterID(0), SHVs(0), AverageThermalElong(4)
 {
-  if (numFibers > 10000) {
-    opserr << "ERROR: FiberSection3d::FiberSection3dThermal -- section has more than 10,000 fibers. You can surely use fewer fibers." << endln;
-    exit(-1);
-  }
-  
   if (numFibers > 0) {
     theMaterials = new UniaxialMaterial *[numFibers];
 
@@ -216,11 +212,7 @@ FiberSection3dThermal::FiberSection3dThermal(int tag, int num, UniaxialMaterial
   sT(3), Fiber_T(0), Fiber_TMax(0),
   parameterID(0), SHVs(0), AverageThermalElong(4)
 {
-  if (numFibers > 10000) {
-    opserr << "ERROR: FiberSection3d::FiberSection3dThermal -- section has more than 10,000 fibers. You can surely use fewer fibers." << endln;
-    exit(-1);
-  }
-  if(sizeFibers > 0) {
+if(sizeFibers > 0) {
     theMaterials = new UniaxialMaterial *[sizeFibers];
     
     if (theMaterials == 0) {
@@ -316,11 +308,6 @@ FiberSection3dThermal::FiberSection3dThermal():
 int
 FiberSection3dThermal::addFiber(Fiber &newFiber)
 {
-  if (numFibers >= 10000) {
-    opserr << "ERROR: FiberSection3dThermal::addFiber -- section has more than 10,000 fibers. You can surely use fewer fibers." << endln;
-    exit(-1);
-  }
-  
   // need to create a larger array
   if(numFibers == sizeFibers) {
       int newSize = 2*sizeFibers;
@@ -1195,12 +1182,12 @@ FiberSection3dThermal::recvSelf(int commitTag, Channel &theChannel,
     computeCentroid = data(5) ? true : false;
 
     if (sectionIntegr != 0) {
-      static double yLocs[10000];
-      static double zLocs[10000];
-      sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
+      std::vector<double> yLocs(numFibers);
+      std::vector<double> zLocs(numFibers);
+      sectionIntegr->getFiberLocations(numFibers, yLocs.data(), zLocs.data());
       
-      static double fiberArea[10000];
-      sectionIntegr->getFiberWeights(numFibers, fiberArea);
+      std::vector<double> fiberArea(numFibers);
+      sectionIntegr->getFiberWeights(numFibers, fiberArea.data());
       
       for (int i = 0; i < numFibers; i++) {
 		ABar  += fiberArea[i];
@@ -38,6 +38,7 @@
 
 #include <stdlib.h>
 #include <math.h>
+#include <vector>
 
 #include <Channel.h>
 #include <Vector.h>
@@ -49,6 +50,7 @@
 #include <ID.h>
 #include <FEM_ObjectBroker.h>
 #include <Information.h>
+#include <Parameter.h>
 #include <MaterialResponse.h>
 #include <UniaxialMaterial.h>
 #include <ElasticMaterial.h>
@@ -115,8 +117,8 @@ void* OPS_FiberSectionAsym3d()
 // constructors:
 FiberSectionAsym3d::FiberSectionAsym3d(int tag, int num, Fiber **fibers, UniaxialMaterial *torsion, double yss, double zss):
   SectionForceDeformation(tag, SEC_TAG_FiberSectionAsym3d),
-  numFibers(num), sizeFibers(num), theMaterials(0), matData(0),
-  QzBar(0.0), QyBar(0.0), Abar(0.0), yBar(0.0), zBar(0.0), sectionIntegr(0), e(5), s(0), ks(0), theTorsion(0), ys(yss), zs(zss)   //Xinlong
+  numFibers(num), sizeFibers(num), theMaterials(0), matData(0), yFibers(0), zFibers(0), AFibers(0),
+  QzBar(0.0), QyBar(0.0), Abar(0.0), yBar(0.0), zBar(0.0), fiberGeometrySet(false), sectionIntegr(0), e(5), s(0), ks(0), theTorsion(0), ys(yss), zs(zss)   //Xinlong
 {
   if (numFibers != 0) {
     theMaterials = new UniaxialMaterial *[numFibers];
@@ -157,6 +159,8 @@ FiberSectionAsym3d::FiberSectionAsym3d(int tag, int num, Fiber **fibers, Uniaxia
 
     yBar = QzBar/Abar;
     zBar = QyBar/Abar;
+
+    this->setFiberGeometry();
   }
 
   if (torsion != 0) {
@@ -187,8 +191,8 @@ FiberSectionAsym3d::FiberSectionAsym3d(int tag, int num, Fiber **fibers, Uniaxia
 
 FiberSectionAsym3d::FiberSectionAsym3d(int tag, int num, UniaxialMaterial *torsion, double yss, double zss):    //Xinlong 
     SectionForceDeformation(tag, SEC_TAG_FiberSectionAsym3d),
-    numFibers(0), sizeFibers(num), theMaterials(0), matData(0),
-    QzBar(0.0), QyBar(0.0), Abar(0.0), yBar(0.0), zBar(0.0), sectionIntegr(0), e(5), s(0), ks(0), theTorsion(0), ys(yss), zs(zss)  //Xinlong
+    numFibers(0), sizeFibers(num), theMaterials(0), matData(0), yFibers(0), zFibers(0), AFibers(0),
+    QzBar(0.0), QyBar(0.0), Abar(0.0), yBar(0.0), zBar(0.0), fiberGeometrySet(false), sectionIntegr(0), e(5), s(0), ks(0), theTorsion(0), ys(yss), zs(zss)  //Xinlong
 {
     if(sizeFibers != 0) {
 	theMaterials = new UniaxialMaterial *[sizeFibers];
@@ -242,8 +246,8 @@ FiberSectionAsym3d::FiberSectionAsym3d(int tag, int num, UniaxialMaterial *torsi
 FiberSectionAsym3d::FiberSectionAsym3d(int tag, int num, UniaxialMaterial **mats,
 			       SectionIntegration &si, UniaxialMaterial *torsion, double yss, double zss):                   //Xinlong
   SectionForceDeformation(tag, SEC_TAG_FiberSectionAsym3d),
-  numFibers(num), sizeFibers(num), theMaterials(0), matData(0),
-  QzBar(0.0), QyBar(0.0), Abar(0.0), yBar(0.0), zBar(0.0), sectionIntegr(0), e(5), s(0), ks(0), theTorsion(0), ys(yss), zs(zss)    //Xinlong
+  numFibers(num), sizeFibers(num), theMaterials(0), matData(0), yFibers(0), zFibers(0), AFibers(0),
+  QzBar(0.0), QyBar(0.0), Abar(0.0), yBar(0.0), zBar(0.0), fiberGeometrySet(false), sectionIntegr(0), e(5), s(0), ks(0), theTorsion(0), ys(yss), zs(zss)    //Xinlong
 {
   if (numFibers != 0) {
     theMaterials = new UniaxialMaterial *[numFibers];
@@ -266,18 +270,13 @@ FiberSectionAsym3d::FiberSectionAsym3d(int tag, int num, UniaxialMaterial **mats
     exit(-1);
   }
 
-  static double yLocs[10000];
-  static double zLocs[10000];
-  sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
-  
-  static double fiberArea[10000];
-  sectionIntegr->getFiberWeights(numFibers, fiberArea);
+  this->setFiberGeometry();
   
   for (int i = 0; i < numFibers; i++) {
 
-    Abar  += fiberArea[i];
-    QzBar += yLocs[i]*fiberArea[i];
-    QyBar += zLocs[i]*fiberArea[i];
+    Abar  += AFibers[i];
+    QzBar += yFibers[i]*AFibers[i];
+    QyBar += zFibers[i]*AFibers[i];
 
     theMaterials[i] = mats[i]->getCopy();
     
@@ -290,6 +289,11 @@ FiberSectionAsym3d::FiberSectionAsym3d(int tag, int num, UniaxialMaterial **mats
   yBar = QzBar/Abar;  
   zBar = QyBar/Abar;  
 
+  for (int i = 0; i < numFibers; i++) {
+    yFibers[i] -= yBar;
+    zFibers[i] -= zBar;
+  }
+
   if (torsion != 0) {
     theTorsion = torsion->getCopy();
     if (theTorsion == 0) {
@@ -316,8 +320,8 @@ FiberSectionAsym3d::FiberSectionAsym3d(int tag, int num, UniaxialMaterial **mats
 // constructor for blank object that recvSelf needs to be invoked upon
 FiberSectionAsym3d::FiberSectionAsym3d():
   SectionForceDeformation(0, SEC_TAG_FiberSectionAsym3d),
-  numFibers(0), sizeFibers(0), theMaterials(0), matData(0),
-  QzBar(0.0), QyBar(0.0), Abar(0.0), yBar(0.0), zBar(0.0), sectionIntegr(0), e(5), s(0), ks(0), theTorsion(0), ys(0.0), zs(0.0)     //Xinlong
+  numFibers(0), sizeFibers(0), theMaterials(0), matData(0), yFibers(0), zFibers(0), AFibers(0),
+  QzBar(0.0), QyBar(0.0), Abar(0.0), yBar(0.0), zBar(0.0), fiberGeometrySet(false), sectionIntegr(0), e(5), s(0), ks(0), theTorsion(0), ys(0.0), zs(0.0)     //Xinlong
 {
   s = new Vector(sData, 5);     //Xinlong
   ks = new Matrix(kData, 5, 5); //Xinlong
@@ -404,6 +408,8 @@ FiberSectionAsym3d::addFiber(Fiber &newFiber)
   yBar = QzBar/Abar;
   zBar = QyBar/Abar;
 
+  fiberGeometrySet = false;
+
   return 0;
 }
 
@@ -423,6 +429,15 @@ FiberSectionAsym3d::~FiberSectionAsym3d()
   if (matData != 0)
     delete [] matData;
 
+  if (yFibers != 0)
+    delete [] yFibers;
+
+  if (zFibers != 0)
+    delete [] zFibers;
+
+  if (AFibers != 0)
+    delete [] AFibers;
+
   if (s != 0)
     delete s;
 
@@ -436,6 +451,45 @@ FiberSectionAsym3d::~FiberSectionAsym3d()
     delete theTorsion;
 }
 
+void
+FiberSectionAsym3d::setFiberGeometry(void)
+{
+  if (yFibers != 0)
+    delete [] yFibers;
+  if (zFibers != 0)
+    delete [] zFibers;
+  if (AFibers != 0)
+    delete [] AFibers;
+  yFibers = 0;
+  zFibers = 0;
+  AFibers = 0;
+
+  if (numFibers > 0) {
+    yFibers = new double [numFibers];
+    zFibers = new double [numFibers];
+    AFibers = new double [numFibers];
+
+    if (sectionIntegr != 0) {
+      sectionIntegr->getFiberLocations(numFibers, yFibers, zFibers);
+      sectionIntegr->getFiberWeights(numFibers, AFibers);
+    }
+    else {
+      for (int i = 0; i < numFibers; i++) {
+	yFibers[i] = matData[3*i];
+	zFibers[i] = matData[3*i+1];
+	AFibers[i] = matData[3*i+2];
+      }
+    }
+
+    for (int i = 0; i < numFibers; i++) {
+      yFibers[i] -= yBar;
+      zFibers[i] -= zBar;
+    }
+  }
+
+  fiberGeometrySet = true;
+}
+
 int
 FiberSectionAsym3d::setTrialSectionDeformation (const Vector &deforms)
 {
@@ -468,30 +522,15 @@ FiberSectionAsym3d::setTrialSectionDeformation (const Vector &deforms)
   double d3 = deforms(3);
   double d4 = deforms(4); //Phi'
 
-  static double yLocs[10000];
-  static double zLocs[10000];
-  static double fiberArea[10000];
- 
-  if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
-    sectionIntegr->getFiberWeights(numFibers, fiberArea);
-  }  
-  else {
-	
-    for (int i = 0; i < numFibers; i++) {
-		
-      yLocs[i] = matData[3*i];
-      zLocs[i] = matData[3*i+1];
-      fiberArea[i] = matData[3*i+2];
-    }
-  }
+  if (!fiberGeometrySet)
+    this->setFiberGeometry();
  
   double tangent, stress;
   for (int i = 0; i < numFibers; i++) {
     UniaxialMaterial *theMat = theMaterials[i];
-    double y = yLocs[i] - yBar;
-    double z = zLocs[i] - zBar;
-    double A = fiberArea[i];
+    double y = yFibers[i];
+    double z = zFibers[i];
+    double A = AFibers[i];
 
     // determine material strain and set it
 	double pSquare = (y - ys)*(y - ys) + (z - zs)*(z - zs);
@@ -547,32 +586,19 @@ FiberSectionAsym3d::getInitialTangent(void)
 {
   //double zs = 0.6385; //z coord of shear center w.r.t. centroid
   //double ys = -0.6741; //y coord of shear center w.r.t. centroid
-  static double kInitialData[25];
-  static Matrix kInitial(kInitialData, 5, 5);
+  static thread_local double kInitialData[25];
+  static thread_local Matrix kInitial(kInitialData, 5, 5);
   
   kInitial.Zero();
 
-  static double yLocs[10000];
-  static double zLocs[10000];
-  static double fiberArea[10000];
-
-  if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
-    sectionIntegr->getFiberWeights(numFibers, fiberArea);
-  }  
-  else {
-    for (int i = 0; i < numFibers; i++) {
-      yLocs[i] = matData[3*i];
-      zLocs[i] = matData[3*i+1];
-      fiberArea[i] = matData[3*i+2];
-    }
-  }
+  if (!fiberGeometrySet)
+    this->setFiberGeometry();
 
   for (int i = 0; i < numFibers; i++) {
     UniaxialMaterial *theMat = theMaterials[i];
-    double y = yLocs[i] - yBar;
-    double z = zLocs[i] - zBar;
-    double A = fiberArea[i];
+    double y = yFibers[i];
+    double z = zFibers[i];
+    double A = AFibers[i];
 	double pSquare = (y - ys)*(y - ys) + (z - zs)*(z - zs);
 
     double tangent = theMat->getInitialTangent();
@@ -694,6 +720,9 @@ FiberSectionAsym3d::getCopy(void)
   else
     theCopy->sectionIntegr = 0;
 
+
+  theCopy->setFiberGeometry();
+
   return theCopy;
 }
 
@@ -736,27 +765,14 @@ FiberSectionAsym3d::revertToLastCommit(void)
   for (int i = 0; i < 25; i++) //Xinlong
 	  kData[i] = 0.0;
 
-  static double yLocs[10000];
-  static double zLocs[10000];
-  static double fiberArea[10000];
-
-  if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
-    sectionIntegr->getFiberWeights(numFibers, fiberArea);
-  }  
-  else {
-    for (int i = 0; i < numFibers; i++) {
-      yLocs[i] = matData[3*i];
-      zLocs[i] = matData[3*i+1];
-      fiberArea[i] = matData[3*i+2];
-    }
-  }
+  if (!fiberGeometrySet)
+    this->setFiberGeometry();
 
   for (int i = 0; i < numFibers; i++) {
     UniaxialMaterial *theMat = theMaterials[i];
-    double y = yLocs[i] - yBar;
-    double z = zLocs[i] - zBar;
-    double A = fiberArea[i];
+    double y = yFibers[i];
+    double z = zFibers[i];
+    double A = AFibers[i];
 
 	double pSquare = (y - ys)*(y - ys) + (z - zs)*(z - zs);
 
@@ -825,27 +841,14 @@ FiberSectionAsym3d::revertToStart(void)
   for (int i = 0; i < 25; i++) //Xinlong
 	  kData[i] = 0.0;
 
-  static double yLocs[10000];
-  static double zLocs[10000];
-  static double fiberArea[10000];
-
-  if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
-    sectionIntegr->getFiberWeights(numFibers, fiberArea);
-  }  
-  else {
-    for (int i = 0; i < numFibers; i++) {
-      yLocs[i] = matData[3*i];
-      zLocs[i] = matData[3*i+1];
-      fiberArea[i] = matData[3*i+2];
-    }
-  }
+  if (!fiberGeometrySet)
+    this->setFiberGeometry();
 
   for (int i = 0; i < numFibers; i++) {
     UniaxialMaterial *theMat = theMaterials[i];
-    double y = yLocs[i] - yBar;
-    double z = zLocs[i] - zBar;
-    double A = fiberArea[i];
+    double y = yFibers[i];
+    double z = zFibers[i];
+    double A = AFibers[i];
 
 	double pSquare = (y - ys)*(y - ys) + (z - zs)*(z - zs);
 
@@ -1092,20 +1095,25 @@ FiberSectionAsym3d::recvSelf(int commitTag, Channel &theChannel,
     QzBar = 0.0;
     QyBar = 0.0;
     Abar  = 0.0;
-    double yLoc, zLoc, Area;
+
+    yBar = 0.0;
+    zBar = 0.0;
+    this->setFiberGeometry();
 
     // Recompute centroid
     for (i = 0; i < numFibers; i++) {
-      yLoc = matData[3*i];
-      zLoc = matData[3*i+1];
-      Area = matData[3*i+2];
-      Abar  += Area;
-      QzBar += yLoc*Area;
-      QyBar += zLoc*Area;
+      Abar  += AFibers[i];
+      QzBar += yFibers[i]*AFibers[i];
+      QyBar += zFibers[i]*AFibers[i];
     }
     
     yBar = QzBar/Abar;
     zBar = QyBar/Abar;
+
+    for (i = 0; i < numFibers; i++) {
+      yFibers[i] -= yBar;
+      zFibers[i] -= zBar;
+    }
   }    
 
   return res;
@@ -1173,18 +1181,8 @@ FiberSectionAsym3d::setResponse(const char **argv, int argc, OPS_Stream &output)
   
   if (argc > 2 && strcmp(argv[0],"fiber") == 0) {
 
-    static double yLocs[10000];
-    static double zLocs[10000];
-    
-    if (sectionIntegr != 0) {
-      sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
-    }  
-    else {
-      for (int i = 0; i < numFibers; i++) {
-	yLocs[i] = matData[3*i];
-	zLocs[i] = matData[3*i+1];
-      }
-    }
+    if (!fiberGeometrySet)
+      this->setFiberGeometry();
     
     int key = numFibers;
     int passarg = 2;
@@ -1207,8 +1205,8 @@ FiberSectionAsym3d::setResponse(const char **argv, int argc, OPS_Stream &output)
 	if (matTag == theMaterials[j]->getTag()) {
 	  //ySearch = matData[3*j];
 	  //zSearch = matData[3*j+1];
-	  ySearch = yLocs[j];
-	  zSearch = zLocs[j];	    	  
+	  ySearch = yFibers[j] + yBar;
+	  zSearch = zFibers[j] + zBar;	    	  
 	  dy = ySearch-yCoord;
 	  dz = zSearch-zCoord;
 	  closestDist = dy*dy + dz*dz;
@@ -1222,8 +1220,8 @@ FiberSectionAsym3d::setResponse(const char **argv, int argc, OPS_Stream &output)
 	if (matTag == theMaterials[j]->getTag()) {
 	  //ySearch = matData[3*j];
 	  //zSearch = matData[3*j+1];
-	  ySearch = yLocs[j];
-	  zSearch = zLocs[j];	    	    	  
+	  ySearch = yFibers[j] + yBar;
+	  zSearch = zFibers[j] + zBar;	    	    	  
 	  dy = ySearch-yCoord;
 	  dz = zSearch-zCoord;
 	  distance = dy*dy + dz*dz;
@@ -1244,8 +1242,8 @@ FiberSectionAsym3d::setResponse(const char **argv, int argc, OPS_Stream &output)
       double distance;
       //ySearch = matData[0];
       //zSearch = matData[1];
-      ySearch = yLocs[0];
-      zSearch = zLocs[0];      
+      ySearch = yFibers[0] + yBar;
+      zSearch = zFibers[0] + zBar;      
       dy = ySearch-yCoord;
       dz = zSearch-zCoord;
       closestDist = dy*dy + dz*dz;
@@ -1253,8 +1251,8 @@ FiberSectionAsym3d::setResponse(const char **argv, int argc, OPS_Stream &output)
       for (int j = 1; j < numFibers; j++) {
 	//ySearch = matData[3*j];
 	//zSearch = matData[3*j+1];
-	ySearch = yLocs[j];
-	zSearch = zLocs[j];	    	    	  	
+	ySearch = yFibers[j] + yBar;
+	zSearch = zFibers[j] + zBar;	    	    	  	
 	dy = ySearch-yCoord;
 	dz = zSearch-zCoord;
 	distance = dy*dy + dz*dz;
@@ -1401,8 +1399,12 @@ FiberSectionAsym3d::setParameter(const char **argv, int argc, Parameter &param)
 
   // Check if it belongs to the section integration
   else if (strstr(argv[0],"integration") != 0) {
-    if (sectionIntegr != 0)
-      return sectionIntegr->setParameter(&argv[1], argc-1, param);
+    if (sectionIntegr != 0) {
+      result = sectionIntegr->setParameter(&argv[1], argc-1, param);
+      if (result != -1)
+	param.addObject(1, this);
+      return result;
+    }
     else
       return -1;
   }
@@ -1423,13 +1425,25 @@ FiberSectionAsym3d::setParameter(const char **argv, int argc, Parameter &param)
 
   if (sectionIntegr != 0) {
     ok = sectionIntegr->setParameter(argv, argc, param);
-    if (ok != -1)
+    if (ok != -1) {
       result = ok;
+      param.addObject(1, this);
+    }
   }
 
   return result;
 }
 
+int
+FiberSectionAsym3d::updateParameter(int parameterID, Information &info)
+{
+  // fiber locations or weights have changed in the section integration
+  if (parameterID == 1)
+    fiberGeometrySet = false;
+
+  return 0;
+}
+
 const Vector &
 FiberSectionAsym3d::getSectionDeformationSensitivity(int gradIndex)
 {
@@ -1454,42 +1468,22 @@ FiberSectionAsym3d::getStressResultantSensitivity(int gradIndex, bool conditiona
   double sig_dAdh = 0;
   double tangent = 0;
 
-  static double yLocs[10000];
-  static double zLocs[10000];
-  static double fiberArea[10000];
-
-  if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
-    sectionIntegr->getFiberWeights(numFibers, fiberArea);
-  }  
-  else {
-    for (int i = 0; i < numFibers; i++) {
-      yLocs[i] = matData[3*i];
-      zLocs[i] = matData[3*i+1];
-      fiberArea[i] = matData[3*i+2];
-    }
-  }
+  if (!fiberGeometrySet)
+    this->setFiberGeometry();
 
-  static double dydh[10000];
-  static double dzdh[10000];
-  static double areaDeriv[10000];
+  std::vector<double> dydh(numFibers, 0.0);
+  std::vector<double> dzdh(numFibers, 0.0);
+  std::vector<double> areaDeriv(numFibers, 0.0);
 
   if (sectionIntegr != 0) {
-    sectionIntegr->getLocationsDeriv(numFibers, dydh, dzdh);  
-    sectionIntegr->getWeightsDeriv(numFibers, areaDeriv);
-  }
-  else {
-    for (int i = 0; i < numFibers; i++) {
-      dydh[i] = 0.0;
-      dzdh[i] = 0.0;
-      areaDeriv[i] = 0.0;
-    }
+    sectionIntegr->getLocationsDeriv(numFibers, dydh.data(), dzdh.data());
+    sectionIntegr->getWeightsDeriv(numFibers, areaDeriv.data());
   }
   
   for (int i = 0; i < numFibers; i++) {
-    y = yLocs[i] - yBar;
-    z = zLocs[i] - zBar;
-    A = fiberArea[i];
+    y = yFibers[i];
+    z = zFibers[i];
+    A = AFibers[i];
     
     dsigdh = theMaterials[i]->getStressSensitivity(gradIndex, conditional);
 
@@ -1563,29 +1557,14 @@ FiberSectionAsym3d::commitSensitivity(const Vector& defSens, int gradIndex, int
 
   //dedh = defSens;
 
-  static double yLocs[10000];
-  static double zLocs[10000];
+  if (!fiberGeometrySet)
+    this->setFiberGeometry();
 
-  if (sectionIntegr != 0)
-    sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
-  else {
-    for (int i = 0; i < numFibers; i++) {
-      yLocs[i] = matData[3*i];
-      zLocs[i] = matData[3*i+1];
-    }
-  }
-
-  static double dydh[10000];
-  static double dzdh[10000];
+  std::vector<double> dydh(numFibers, 0.0);
+  std::vector<double> dzdh(numFibers, 0.0);
 
   if (sectionIntegr != 0)
-    sectionIntegr->getLocationsDeriv(numFibers, dydh, dzdh);  
-  else {
-    for (int i = 0; i < numFibers; i++) {
-      dydh[i] = 0.0;
-      dzdh[i] = 0.0;
-    }
-  }
+    sectionIntegr->getLocationsDeriv(numFibers, dydh.data(), dzdh.data());
 
   double y, z;
 
@@ -1593,8 +1572,8 @@ FiberSectionAsym3d::commitSensitivity(const Vector& defSens, int gradIndex, int
 
   for (int i = 0; i < numFibers; i++) {
     UniaxialMaterial *theMat = theMaterials[i];
-    y = yLocs[i] - yBar;
-    z = zLocs[i] - zBar;
+    y = yFibers[i];
+    z = zFibers[i];
 
     // determine material strain and set it
     depsdh = d0 - y*d1 + z*d2 - dydh[i]*e(1) + dzdh[i]*e(2); //Xinlong: seems this should be replaced by d0~d7
@@ -92,6 +92,7 @@ class FiberSectionAsym3d : public SectionForceDeformation
 
     // AddingSensitivity:BEGIN //////////////////////////////////////////
     int setParameter(const char **argv, int argc, Parameter &param);
+    int updateParameter(int parameterID, Information &info);
 
     const Vector & getStressResultantSensitivity(int gradIndex, bool conditional);
     const Matrix & getSectionTangentSensitivity(int gradIndex);
@@ -108,12 +109,16 @@ class FiberSectionAsym3d : public SectionForceDeformation
     int numFibers, sizeFibers;       // number of fibers in the section
     UniaxialMaterial **theMaterials; // array of pointers to materials
     double   *matData;               // data for the materials [yloc, zloc, area]
+    double   *yFibers;               // fiber locations relative to yBar
+    double   *zFibers;               // fiber locations relative to zBar
+    double   *AFibers;               // fiber areas
     double   kData[25];              // data for ks matrix       Xinlong 
     double   sData[5];               // data for s vector        Xinlong
 
     double QzBar, QyBar, Abar;
     double yBar;       // Section centroid
     double zBar;
+    bool fiberGeometrySet;  // yFibers, zFibers and AFibers are current
 	double ys; //Xinlong: y coord of shear center relative to centroid
 	double zs; //Xinlong: z coord of shear center relative to centroid
   
@@ -121,6 +126,8 @@ class FiberSectionAsym3d : public SectionForceDeformation
 
     static ID code;
 
+    void setFiberGeometry(void);    // fill yFibers, zFibers and AFibers
+
     Vector e;          // trial section deformations 
     Vector *s;         // section resisting forces  (axial force, bending moment)
     Matrix *ks;        // section stiffness
@@ -125,8 +125,9 @@ FiberSectionWarping3d::FiberSectionWarping3d(int tag, int num, Fiber **fibers,
 					     UniaxialMaterial &torsion): 
   SectionForceDeformation(tag, SEC_TAG_FiberSectionWarping3d),
   numFibers(num), sizeFibers(num),  theMaterials(0), matData(0),
+  yFibers(0), zFibers(0), AFibers(0), omegaFibers(0),
   yBar(0.0), zBar(0.0),
-  sectionIntegr(0), e(8), eCommit(8), s(0), ks(0), theTorsion(0)
+  fiberGeometrySet(false), sectionIntegr(0), e(8), eCommit(8), s(0), ks(0), theTorsion(0)
 {
   if (numFibers != 0) {
     theMaterials = new UniaxialMaterial *[numFibers];
@@ -176,6 +177,8 @@ FiberSectionWarping3d::FiberSectionWarping3d(int tag, int num, Fiber **fibers,
 
   yBar = zBar = 0.0;
 
+  this->setFiberGeometry();
+
   theTorsion = torsion.getCopy();
   if (theTorsion == 0)
     opserr << "FiberSectionWarping3d::FiberSectionWarping3d -- failed to get copy of torsion material\n";
@@ -209,8 +212,9 @@ FiberSectionWarping3d::FiberSectionWarping3d(int tag, int num, Fiber **fibers,
 FiberSectionWarping3d::FiberSectionWarping3d(int tag, int num, UniaxialMaterial &torsion): 
     SectionForceDeformation(tag, SEC_TAG_FiberSectionWarping3d),
     numFibers(0), sizeFibers(num), theMaterials(0), matData(0),
+  yFibers(0), zFibers(0), AFibers(0), omegaFibers(0),
     yBar(0.0), zBar(0.0),
-    sectionIntegr(0), e(8), eCommit(8), s(0), ks(0), theTorsion(0)
+    fiberGeometrySet(false), sectionIntegr(0), e(8), eCommit(8), s(0), ks(0), theTorsion(0)
 {
     if(sizeFibers != 0) {
 	theMaterials = new UniaxialMaterial *[sizeFibers];
@@ -265,8 +269,9 @@ FiberSectionWarping3d::FiberSectionWarping3d(int tag, int num, UniaxialMaterial
 					     SectionIntegration &si, UniaxialMaterial &torsion):
   SectionForceDeformation(tag, SEC_TAG_FiberSectionWarping3d),
   numFibers(num), sizeFibers(num), theMaterials(0), matData(0),
+  yFibers(0), zFibers(0), AFibers(0), omegaFibers(0),
   yBar(0.0), zBar(0.0), 
-  sectionIntegr(0), e(8), s(0), ks(0), theTorsion(0)
+  fiberGeometrySet(false), sectionIntegr(0), e(8), s(0), ks(0), theTorsion(0)
 {
   if (numFibers != 0) {
     theMaterials = new UniaxialMaterial *[numFibers];
@@ -289,21 +294,13 @@ FiberSectionWarping3d::FiberSectionWarping3d(int tag, int num, UniaxialMaterial
     exit(-1);
   }
 
-  static double yLocs[10000];
-  static double zLocs[10000];
-  sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
-  
-  static double fiberArea[10000];
-  sectionIntegr->getFiberWeights(numFibers, fiberArea);
-
-  //static double fiberSectorials[10000];
-  //sectionIntegr->getFiberSectorials(numFibers, fiberSectorials);
+  this->setFiberGeometry();
   
   for (int i = 0; i < numFibers; i++) {
 
-    //Abar  += fiberArea[i];
-    //QzBar += yLocs[i]*fiberArea[i];
-    //QyBar += zLocs[i]*fiberArea[i];
+    //Abar  += AFibers[i];
+    //QzBar += yFibers[i]*AFibers[i];
+    //QyBar += zFibers[i]*AFibers[i];
 
     theMaterials[i] = mats[i]->getCopy();
     
@@ -345,8 +342,9 @@ FiberSectionWarping3d::FiberSectionWarping3d(int tag, int num, UniaxialMaterial
 FiberSectionWarping3d::FiberSectionWarping3d():
   SectionForceDeformation(0, SEC_TAG_FiberSectionWarping3d),
   numFibers(0), theMaterials(0), matData(0),
+  yFibers(0), zFibers(0), AFibers(0), omegaFibers(0),
   yBar(0.0), zBar(0.0),
-  sectionIntegr(0), e(8), eCommit(8), s(0), ks(0), theTorsion(0)
+  fiberGeometrySet(false), sectionIntegr(0), e(8), eCommit(8), s(0), ks(0), theTorsion(0)
 {
   s = new Vector(sData, 6);
   ks = new Matrix(kData, 6, 6);
@@ -446,6 +444,8 @@ FiberSectionWarping3d::addFiber(Fiber &newFiber)
   zBar = Qy/A;
 
   yBar = zBar = 0.0;
+
+  fiberGeometrySet = false;
   
   return 0;
 }
@@ -466,6 +466,18 @@ FiberSectionWarping3d::~FiberSectionWarping3d()
   if (matData != 0)
     delete [] matData;
 
+  if (yFibers != 0)
+    delete [] yFibers;
+
+  if (zFibers != 0)
+    delete [] zFibers;
+
+  if (AFibers != 0)
+    delete [] AFibers;
+
+  if (omegaFibers != 0)
+    delete [] omegaFibers;
+
   if (s != 0)
     delete s;
 
@@ -479,6 +491,51 @@ FiberSectionWarping3d::~FiberSectionWarping3d()
     delete theTorsion;  
 }
 
+void
+FiberSectionWarping3d::setFiberGeometry(void)
+{
+  if (yFibers != 0)
+    delete [] yFibers;
+  if (zFibers != 0)
+    delete [] zFibers;
+  if (AFibers != 0)
+    delete [] AFibers;
+  if (omegaFibers != 0)
+    delete [] omegaFibers;
+  yFibers = 0;
+  zFibers = 0;
+  AFibers = 0;
+  omegaFibers = 0;
+
+  if (numFibers > 0) {
+    yFibers = new double [numFibers];
+    zFibers = new double [numFibers];
+    AFibers = new double [numFibers];
+    omegaFibers = new double [numFibers];
+
+    if (sectionIntegr != 0) {
+      sectionIntegr->getFiberLocations(numFibers, yFibers, zFibers);
+      sectionIntegr->getFiberWeights(numFibers, AFibers);
+      sectionIntegr->getFiberSectorials(numFibers, omegaFibers);
+    }
+    else {
+      for (int i = 0; i < numFibers; i++) {
+	yFibers[i] = matData[4*i];
+	zFibers[i] = matData[4*i+1];
+	AFibers[i] = matData[4*i+2];
+	omegaFibers[i] = matData[4*i+3];
+      }
+    }
+
+    for (int i = 0; i < numFibers; i++) {
+      yFibers[i] -= yBar;
+      zFibers[i] -= zBar;
+    }
+  }
+
+  fiberGeometrySet = true;
+}
+
 int
 FiberSectionWarping3d::setTrialSectionDeformation (const Vector &deforms)
 {
@@ -506,32 +563,14 @@ FiberSectionWarping3d::setTrialSectionDeformation (const Vector &deforms)
   double d6 = deforms(6);
   double d7 = deforms(7);
 
-  static double yLocs[10000];
-  static double zLocs[10000];
-  static double fiberArea[10000];
-  static double omega[10000];  
- 
-  if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
-    sectionIntegr->getFiberWeights(numFibers, fiberArea);
-    sectionIntegr->getFiberSectorials(numFibers, omega);
-  }  
-  else {
-	
-    for (int i = 0; i < numFibers; i++) {
-		
-      yLocs[i] = matData[4*i];
-      zLocs[i] = matData[4*i+1];
-      fiberArea[i] = matData[4*i+2];
-      omega[i] = matData[4*i+3];
-    }
-  }
+  if (!fiberGeometrySet)
+    this->setFiberGeometry();
   
   for (int i = 0; i < numFibers; i++) {
     UniaxialMaterial *theMat = theMaterials[i];
-    double y = yLocs[i] - yBar;
-    double z = zLocs[i] - zBar;
-    double A = fiberArea[i];
+    double y = yFibers[i];
+    double z = zFibers[i];
+    double A = AFibers[i];
     /*
     double Height=matData[i];
     // calculate sectorial area
@@ -541,7 +580,7 @@ FiberSectionWarping3d::setTrialSectionDeformation (const Vector &deforms)
     else
       omig = -z* (y+Height);
     */
-    double omig = omega[i];
+    double omig = omegaFibers[i];
 
     // determine material strain and set it, include second order terms
     double strain = d0 - y*d1 - z*d2 - omig*d3 + 0.5*d5*d5 + 0.5*d6*d6 + 0.5*(y*y+z*z)*d4*d4 - y*d7*d2 + z*d7*d1;
@@ -609,39 +648,21 @@ FiberSectionWarping3d::setTrialSectionDeformation (const Vector &deforms)
 const Matrix&
 FiberSectionWarping3d::getInitialTangent(void)
 {
-  static double kInitialData[36];
-  static Matrix kInitial(kInitialData, 6, 6);
+  static thread_local double kInitialData[36];
+  static thread_local Matrix kInitial(kInitialData, 6, 6);
   for (int i=0; i<36; i++)
     kInitialData[i]=0.0;
 
   int loc = 0;
 
-  static double yLocs[10000];
-  static double zLocs[10000];
-  static double fiberArea[10000];
-  static double omega[10000];
- 
-  if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
-    sectionIntegr->getFiberWeights(numFibers, fiberArea);
-    sectionIntegr->getFiberSectorials(numFibers, omega);    
-  }  
-  else {
-	
-    for (int i = 0; i < numFibers; i++) {
-		
-      yLocs[i] = matData[4*i];
-      zLocs[i] = matData[4*i+1];
-      fiberArea[i] = matData[4*i+2];
-      omega[i] = matData[4*i+3];      
-    }
-  }
+  if (!fiberGeometrySet)
+    this->setFiberGeometry();
   
   for (int i = 0; i < numFibers; i++) {
     UniaxialMaterial *theMat = theMaterials[i];
-    double y = yLocs[i] - yBar;
-    double z = zLocs[i] - zBar;
-    double A = fiberArea[i];
+    double y = yFibers[i];
+    double z = zFibers[i];
+    double A = AFibers[i];
     /*
     double Height = matData[i];
     // calculate sectorial area
@@ -651,7 +672,7 @@ FiberSectionWarping3d::getInitialTangent(void)
     else
       omig = -z* (y+Height);
     */
-    double omig = omega[i];
+    double omig = omegaFibers[i];
     
     double tangent = theMat->getInitialTangent();
 
@@ -757,6 +778,8 @@ FiberSectionWarping3d::getCopy(void)
     theCopy->sectionIntegr = sectionIntegr->getCopy();
   else
     theCopy->sectionIntegr = 0;
+
+  theCopy->setFiberGeometry();
   
   return theCopy;
 }
@@ -807,30 +830,14 @@ FiberSectionWarping3d::revertToLastCommit(void)
   sData[4] = 0.0;
   sData[5] = 0.0;
 
-  static double yLocs[10000];
-  static double zLocs[10000];
-  static double fiberArea[10000];
-  static double omega[10000];
-  
-  if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
-    sectionIntegr->getFiberWeights(numFibers, fiberArea);
-    sectionIntegr->getFiberSectorials(numFibers, omega);
-  }  
-  else {
-    for (int i = 0; i < numFibers; i++) {
-      yLocs[i] = matData[4*i];
-      zLocs[i] = matData[4*i+1];
-      fiberArea[i] = matData[4*i+2];
-      omega[i] = matData[4*i+3];
-    }
-  }
+  if (!fiberGeometrySet)
+    this->setFiberGeometry();
   
   for (int i = 0; i < numFibers; i++) {
     UniaxialMaterial *theMat = theMaterials[i];
-    double y = yLocs[i] - yBar;
-    double z = zLocs[i] - zBar;
-    double A = fiberArea[i];
+    double y = yFibers[i];
+    double z = zFibers[i];
+    double A = AFibers[i];
 
     // invoke revertToLast on the material
     err += theMat->revertToLastCommit();
@@ -850,7 +857,7 @@ FiberSectionWarping3d::revertToLastCommit(void)
     else
       omig = -z* (y+Height);
     */
-    double omig = omega[i];
+    double omig = omegaFibers[i];
     
     kData[0] += value;
     kData[3] += (y*y+z*z)*value;
@@ -898,30 +905,14 @@ FiberSectionWarping3d::revertToStart(void)
   sData[4] = 0.0;
   sData[5] = 0.0;  
 
-  static double yLocs[10000];
-  static double zLocs[10000];
-  static double fiberArea[10000];
-  static double omega[10000];
-  
-  if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
-    sectionIntegr->getFiberWeights(numFibers, fiberArea);
-    sectionIntegr->getFiberSectorials(numFibers, omega);
-  }  
-  else {
-    for (int i = 0; i < numFibers; i++) {
-      yLocs[i] = matData[4*i];
-      zLocs[i] = matData[4*i+1];
-      fiberArea[i] = matData[4*i+2];
-      omega[i] = matData[4*i+3];
-    }
-  }
+  if (!fiberGeometrySet)
+    this->setFiberGeometry();
   
   for (int i = 0; i < numFibers; i++) {
     UniaxialMaterial *theMat = theMaterials[i];
-    double y = yLocs[i] - yBar;
-    double z = zLocs[i] - zBar;
-    double A = fiberArea[i];
+    double y = yFibers[i];
+    double z = zFibers[i];
+    double A = AFibers[i];
 
     /*
     double Height = matData[loc++];
@@ -931,7 +922,7 @@ FiberSectionWarping3d::revertToStart(void)
     else
       omig = -z* (y+Height);
     */
-    double omig = omega[i];
+    double omig = omegaFibers[i];
     
     // invoke revertToStart on the material
     err += theMat->revertToStart();
@@ -1166,6 +1157,8 @@ FiberSectionWarping3d::recvSelf(int commitTag, Channel &theChannel,
     zBar = Qy/A;
   }    
 
+  fiberGeometrySet = false;
+
   return res;
 }
 
@@ -1201,24 +1194,8 @@ FiberSectionWarping3d::setResponse(const char **argv, int argc, OPS_Stream &outp
 
   Response *theResponse = 0;
   
-  static double yLocs[10000];
-  static double zLocs[10000];
-  static double fiberArea[10000];
-  static double omega[10000];
-  
-  if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
-    sectionIntegr->getFiberWeights(numFibers, fiberArea);
-    sectionIntegr->getFiberSectorials(numFibers, omega);      
-  }  
-  else {
-    for (int i = 0; i < numFibers; i++) {
-      yLocs[i] = matData[4*i];
-      zLocs[i] = matData[4*i+1];
-      fiberArea[i] = matData[4*i+2];
-      omega[i] = matData[4*i+3];	
-    }
-  }
+  if (!fiberGeometrySet)
+    this->setFiberGeometry();
     
   if (argc > 2 && strcmp(argv[0],"fiber") == 0) {
 
@@ -1279,8 +1256,8 @@ FiberSectionWarping3d::setResponse(const char **argv, int argc, OPS_Stream &outp
 	if (matTag == theMaterials[j]->getTag()) {
 	  //ySearch = matData[3*j];
 	  //zSearch = matData[3*j+1];
-	  ySearch = yLocs[j];
-	  zSearch = zLocs[j];	    
+	  ySearch = yFibers[j] + yBar;
+	  zSearch = zFibers[j] + zBar;	    
 	  dy = ySearch-yCoord;
 	  dz = zSearch-zCoord;
 	  closestDist = dy*dy + dz*dz;
@@ -1294,8 +1271,8 @@ FiberSectionWarping3d::setResponse(const char **argv, int argc, OPS_Stream &outp
 	if (matTag == theMaterials[j]->getTag()) {
 	  //ySearch = matData[3*j];
 	  //zSearch = matData[3*j+1];
-	  ySearch = yLocs[j];
-	  zSearch = zLocs[j];	    	    
+	  ySearch = yFibers[j] + yBar;
+	  zSearch = zFibers[j] + zBar;	    	    
 	  dy = ySearch-yCoord;
 	  dz = zSearch-zCoord;
 	  distance = dy*dy + dz*dz;
@@ -1316,8 +1293,8 @@ FiberSectionWarping3d::setResponse(const char **argv, int argc, OPS_Stream &outp
       double distance;
       //ySearch = matData[0];
       //zSearch = matData[1];
-      ySearch = yLocs[0];
-      zSearch = zLocs[0];
+      ySearch = yFibers[0] + yBar;
+      zSearch = zFibers[0] + zBar;
       dy = ySearch-yCoord;
       dz = zSearch-zCoord;
       closestDist = dy*dy + dz*dz;
@@ -1325,8 +1302,8 @@ FiberSectionWarping3d::setResponse(const char **argv, int argc, OPS_Stream &outp
       for (int j = 1; j < numFibers; j++) {
 	//ySearch = matData[3*j];
 	//zSearch = matData[3*j+1];
-	ySearch = yLocs[j];
-	zSearch = zLocs[j];	    	    	  
+	ySearch = yFibers[j] + yBar;
+	zSearch = zFibers[j] + zBar;	    	    	  
 	dy = ySearch-yCoord;
 	dz = zSearch-zCoord;
 	distance = dy*dy + dz*dz;
@@ -1340,10 +1317,10 @@ FiberSectionWarping3d::setResponse(const char **argv, int argc, OPS_Stream &outp
     
     if (key < numFibers && key >= 0) {
       output.tag("FiberOutput");
-      output.attr("yLoc",yLocs[key]);
-      output.attr("zLoc",zLocs[key]);
-      output.attr("area",fiberArea[key]);
-      output.attr("omega",omega[key]);      
+      output.attr("yLoc",yFibers[key] + yBar);
+      output.attr("zLoc",zFibers[key] + zBar);
+      output.attr("area",AFibers[key]);
+      output.attr("omega",omegaFibers[key]);      
       
       theResponse = theMaterials[key]->setResponse(&argv[passarg], argc-passarg, output);
       
@@ -1354,10 +1331,10 @@ FiberSectionWarping3d::setResponse(const char **argv, int argc, OPS_Stream &outp
     int numData = numFibers*6;
     for (int j = 0; j < numFibers; j++) {
       output.tag("FiberOutput");
-      output.attr("yLoc", yLocs[j]);
-      output.attr("zLoc", zLocs[j]);
-      output.attr("area", fiberArea[j]);
-      output.attr("omega", omega[j]);          
+      output.attr("yLoc", yFibers[j] + yBar);
+      output.attr("zLoc", zFibers[j] + zBar);
+      output.attr("area", AFibers[j]);
+      output.attr("omega", omegaFibers[j]);          
       output.tag("ResponseType","yCoord");
       output.tag("ResponseType","zCoord");
       output.tag("ResponseType","area");
@@ -1373,10 +1350,10 @@ FiberSectionWarping3d::setResponse(const char **argv, int argc, OPS_Stream &outp
     int numData = numFibers*7;
     for (int j = 0; j < numFibers; j++) {
       output.tag("FiberOutput");
-      output.attr("yLoc", yLocs[j]);
-      output.attr("zLoc", zLocs[j]);
-      output.attr("area", fiberArea[j]);
-      output.attr("omega", omega[j]);          
+      output.attr("yLoc", yFibers[j] + yBar);
+      output.attr("zLoc", zFibers[j] + zBar);
+      output.attr("area", AFibers[j]);
+      output.attr("omega", omegaFibers[j]);          
       output.attr("material", theMaterials[j]->getTag());
       output.tag("ResponseType","yCoord");
       output.tag("ResponseType","zCoord");
@@ -1401,34 +1378,18 @@ FiberSectionWarping3d::setResponse(const char **argv, int argc, OPS_Stream &outp
 int 
 FiberSectionWarping3d::getResponse(int responseID, Information &sectInfo)
 {
-  static double yLocs[10000];
-  static double zLocs[10000];
-  static double fiberArea[10000];
-  static double omega[10000];
-  
-  if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
-    sectionIntegr->getFiberWeights(numFibers, fiberArea);
-    sectionIntegr->getFiberSectorials(numFibers, omega);      
-  }  
-  else {
-    for (int i = 0; i < numFibers; i++) {
-      yLocs[i] = matData[4*i];
-      zLocs[i] = matData[4*i+1];
-      fiberArea[i] = matData[4*i+2];
-      omega[i] = matData[4*i+3];	
-    }
-  }
+  if (!fiberGeometrySet)
+    this->setFiberGeometry();
     
   if (responseID == 5) {
     int numData = 6*numFibers;
     Vector data(numData);
     int count = 0;
     for (int j = 0; j < numFibers; j++) {
-      data(count)   = yLocs[j]; // y
-      data(count+1) = zLocs[j]; // z
-      data(count+2) = fiberArea[j]; // A
-      data(count+3) = omega[j]; // omega
+      data(count)   = yFibers[j] + yBar; // y
+      data(count+1) = zFibers[j] + zBar; // z
+      data(count+2) = AFibers[j]; // A
+      data(count+3) = omegaFibers[j]; // omega
       data(count+4) = theMaterials[j]->getStress();
       data(count+5) = theMaterials[j]->getStrain();
       count += 6;
@@ -1439,10 +1400,10 @@ FiberSectionWarping3d::getResponse(int responseID, Information &sectInfo)
     Vector data(numData);
     int count = 0;
     for (int j = 0; j < numFibers; j++) {
-      data(count)   = yLocs[j]; // y
-      data(count+1) = zLocs[j]; // z
-      data(count+2) = fiberArea[j]; // A
-      data(count+3) = omega[j]; // omega
+      data(count)   = yFibers[j] + yBar; // y
+      data(count+1) = zFibers[j] + zBar; // z
+      data(count+2) = AFibers[j]; // A
+      data(count+3) = omegaFibers[j]; // omega
       data(count+4) = (double)theMaterials[j]->getTag();
       data(count+5) = theMaterials[j]->getStress();
       data(count+6) = theMaterials[j]->getStrain();	    
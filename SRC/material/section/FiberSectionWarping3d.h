@@ -98,16 +98,23 @@ class FiberSectionWarping3d : public SectionForceDeformation
     int numFibers, sizeFibers;                   // number of fibers in the section
     UniaxialMaterial **theMaterials; // array of pointers to materials
     double   *matData;               // data for the materials [yloc and area]
+    double   *yFibers;               // fiber locations relative to yBar
+    double   *zFibers;               // fiber locations relative to zBar
+    double   *AFibers;               // fiber areas
+    double   *omegaFibers;           // fiber sectorial coordinates
     double   kData[36];               // data for ks matrix 
     double   sData[6];               // data for s vector 
    // double   Height;
     double yBar;       // Section centroid
     double zBar;
+    bool fiberGeometrySet;  // yFibers, zFibers, AFibers and omegaFibers are current
 
     SectionIntegration *sectionIntegr;
   
     static ID code;
 
+    void setFiberGeometry(void);    // fill yFibers, zFibers, AFibers and omegaFibers
+
     Vector e;          // trial section deformations 
     Vector eCommit;    // committed section deformations 
     Vector *s;         // section resisting forces  (axial force, bending moment)
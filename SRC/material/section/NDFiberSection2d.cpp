@@ -30,6 +30,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <vector>
 
 #include <Channel.h>
 #include <Vector.h>
@@ -84,9 +85,9 @@ void* OPS_NDFiberSection2d()
 // constructors:
 NDFiberSection2d::NDFiberSection2d(int tag, int num, Fiber **fibers, double a, bool compCentroid): 
   SectionForceDeformation(tag, SEC_TAG_NDFiberSection2d),
-  numFibers(num), sizeFibers(num), theMaterials(0), matData(0),
+  numFibers(num), sizeFibers(num), theMaterials(0), matData(0), yFibers(0), AFibers(0),
   QzBar(0.0), Abar(0.0), yBar(0.0), computeCentroid(compCentroid),
-  alpha(a), sectionIntegr(0), e(3), s(0), ks(0), 
+  alpha(a), fiberGeometrySet(false), sectionIntegr(0), e(3), s(0), ks(0), 
   parameterID(0), dedh(3)
 {
   if (numFibers != 0) {
@@ -125,6 +126,8 @@ NDFiberSection2d::NDFiberSection2d(int tag, int num, Fiber **fibers, double a, b
 
     if (computeCentroid)
       yBar = QzBar/Abar;  
+
+    this->setFiberGeometry();
   }
 
   s = new Vector(sData, 3);
@@ -151,9 +154,9 @@ NDFiberSection2d::NDFiberSection2d(int tag, int num, Fiber **fibers, double a, b
 
 NDFiberSection2d::NDFiberSection2d(int tag, int num, double a, bool compCentroid): 
     SectionForceDeformation(tag, SEC_TAG_NDFiberSection2d),
-    numFibers(0), sizeFibers(num), theMaterials(0), matData(0),
+    numFibers(0), sizeFibers(num), theMaterials(0), matData(0), yFibers(0), AFibers(0),
     QzBar(0.0), Abar(0.0), yBar(0.0), computeCentroid(compCentroid),
-    alpha(a), sectionIntegr(0), e(3), s(0), ks(0), 
+    alpha(a), fiberGeometrySet(false), sectionIntegr(0), e(3), s(0), ks(0), 
     parameterID(0), dedh(3)
 {
     if (sizeFibers != 0) {
@@ -204,9 +207,9 @@ NDFiberSection2d::NDFiberSection2d(int tag, int num, double a, bool compCentroid
 NDFiberSection2d::NDFiberSection2d(int tag, int num, NDMaterial **mats,
 				   SectionIntegration &si, double a, bool compCentroid):
   SectionForceDeformation(tag, SEC_TAG_NDFiberSection2d),
-  numFibers(num), sizeFibers(num), theMaterials(0), matData(0),
+  numFibers(num), sizeFibers(num), theMaterials(0), matData(0), yFibers(0), AFibers(0),
   QzBar(0.0), Abar(0.0), yBar(0.0), computeCentroid(compCentroid),
-  alpha(a), sectionIntegr(0), e(3), s(0), ks(0), 
+  alpha(a), fiberGeometrySet(false), sectionIntegr(0), e(3), s(0), ks(0), 
   parameterID(0), dedh(3)
 {
   if (numFibers != 0) {
@@ -230,16 +233,12 @@ NDFiberSection2d::NDFiberSection2d(int tag, int num, NDMaterial **mats,
     exit(-1);
   }
 
-  static double fiberLocs[10000];
-  sectionIntegr->getFiberLocations(numFibers, fiberLocs);
-  
-  static double fiberArea[10000];
-  sectionIntegr->getFiberWeights(numFibers, fiberArea);
+  this->setFiberGeometry();
 
   for (int i = 0; i < numFibers; i++) {
 
-    Abar  += fiberArea[i];
-    QzBar += fiberLocs[i]*fiberArea[i];
+    Abar  += AFibers[i];
+    QzBar += yFibers[i]*AFibers[i];
 
     theMaterials[i] = mats[i]->getCopy("BeamFiber2d");
     
@@ -252,6 +251,9 @@ NDFiberSection2d::NDFiberSection2d(int tag, int num, NDMaterial **mats,
   if (computeCentroid)
     yBar = QzBar/Abar;  
 
+  for (int i = 0; i < numFibers; i++)
+    yFibers[i] -= yBar;
+
   s = new Vector(sData, 3);
   ks = new Matrix(kData, 3, 3);
   
@@ -277,9 +279,9 @@ NDFiberSection2d::NDFiberSection2d(int tag, int num, NDMaterial **mats,
 // constructor for blank object that recvSelf needs to be invoked upon
 NDFiberSection2d::NDFiberSection2d():
   SectionForceDeformation(0, SEC_TAG_NDFiberSection2d),
-  numFibers(0), sizeFibers(0), theMaterials(0), matData(0),
+  numFibers(0), sizeFibers(0), theMaterials(0), matData(0), yFibers(0), AFibers(0),
   QzBar(0.0), Abar(0.0), yBar(0.0), computeCentroid(true),
-  alpha(1.0), sectionIntegr(0), 
+  alpha(1.0), fiberGeometrySet(false), sectionIntegr(0), 
   e(3), s(0), ks(0), parameterID(0), dedh(3)
 {
   s = new Vector(sData, 3);
@@ -365,6 +367,8 @@ NDFiberSection2d::addFiber(Fiber &newFiber)
     yBar = QzBar/Abar;
   }
 
+  fiberGeometrySet = false;
+
   return 0;
 }
 
@@ -383,6 +387,12 @@ NDFiberSection2d::~NDFiberSection2d()
   if (matData != 0)
     delete [] matData;
 
+  if (yFibers != 0)
+    delete [] yFibers;
+
+  if (AFibers != 0)
+    delete [] AFibers;
+
   if (s != 0)
     delete s;
 
@@ -393,6 +403,38 @@ NDFiberSection2d::~NDFiberSection2d()
     delete sectionIntegr;
 }
 
+void
+NDFiberSection2d::setFiberGeometry(void)
+{
+  if (yFibers != 0)
+    delete [] yFibers;
+  if (AFibers != 0)
+    delete [] AFibers;
+  yFibers = 0;
+  AFibers = 0;
+
+  if (numFibers > 0) {
+    yFibers = new double [numFibers];
+    AFibers = new double [numFibers];
+
+    if (sectionIntegr != 0) {
+      sectionIntegr->getFiberLocations(numFibers, yFibers);
+      sectionIntegr->getFiberWeights(numFibers, AFibers);
+    }
+    else {
+      for (int i = 0; i < numFibers; i++) {
+	yFibers[i] = matData[2*i];
+	AFibers[i] = matData[2*i+1];
+      }
+    }
+
+    for (int i = 0; i < numFibers; i++)
+      yFibers[i] -= yBar;
+  }
+
+  fiberGeometrySet = true;
+}
+
 int
 NDFiberSection2d::setTrialSectionDeformation (const Vector &deforms)
 {
@@ -418,21 +460,10 @@ NDFiberSection2d::setTrialSectionDeformation (const Vector &deforms)
   double d1 = deforms(1);
   double d2 = deforms(2);
 
-  static double fiberLocs[10000];
-  static double fiberArea[10000];
+  if (!fiberGeometrySet)
+    this->setFiberGeometry();
 
-  if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, fiberLocs);
-    sectionIntegr->getFiberWeights(numFibers, fiberArea);
-  }  
-  else {
-    for (int i = 0; i < numFibers; i++) {
-      fiberLocs[i] = matData[2*i];
-      fiberArea[i] = matData[2*i+1];
-    }
-  }
-
-  static Vector eps(2);
+  static thread_local Vector eps(2);
 
   double rootAlpha = 1.0;
   eps(1) = d2;
@@ -443,8 +474,8 @@ NDFiberSection2d::setTrialSectionDeformation (const Vector &deforms)
 
   for (int i = 0; i < numFibers; i++) {
     NDMaterial *theMat = theMaterials[i];
-    double y = fiberLocs[i] - yBar;
-    double A = fiberArea[i];
+    double y = yFibers[i];
+    double A = AFibers[i];
 
     // determine material strain and set it
     eps(0) = d0 - y*d1;
@@ -505,8 +536,8 @@ NDFiberSection2d::getSectionDeformation(void)
 const Matrix&
 NDFiberSection2d::getInitialTangent(void)
 {
-  static double kInitial[9];
-  static Matrix kInitialMatrix(kInitial, 3, 3);
+  static thread_local double kInitial[9];
+  static thread_local Matrix kInitialMatrix(kInitial, 3, 3);
   kInitial[0] = 0.0; 
   kInitial[1] = 0.0; 
   kInitial[2] = 0.0; 
@@ -517,24 +548,13 @@ NDFiberSection2d::getInitialTangent(void)
   kInitial[7] = 0.0;
   kInitial[8] = 0.0;
 
-  static double fiberLocs[10000];
-  static double fiberArea[10000];
-
-  if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, fiberLocs);
-    sectionIntegr->getFiberWeights(numFibers, fiberArea);
-  }  
-  else {
-    for (int i = 0; i < numFibers; i++) {
-      fiberLocs[i] = matData[2*i];
-      fiberArea[i] = matData[2*i+1];
-    }
-  }
+  if (!fiberGeometrySet)
+    this->setFiberGeometry();
 
   for (int i = 0; i < numFibers; i++) {
     NDMaterial *theMat = theMaterials[i];
-    double y = fiberLocs[i] - yBar;
-    double A = fiberArea[i];
+    double y = yFibers[i];
+    double A = AFibers[i];
 
     const Matrix &tangent = theMat->getInitialTangent();
 
@@ -650,6 +670,9 @@ NDFiberSection2d::getCopy(void)
   else
     theCopy->sectionIntegr = 0;
 
+
+  theCopy->setFiberGeometry();
+
   return theCopy;
 }
 
@@ -695,24 +718,13 @@ NDFiberSection2d::revertToLastCommit(void)
   sData[1] = 0.0;
   sData[2] = 0.0;
   
-  static double fiberLocs[10000];
-  static double fiberArea[10000];
-
-  if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, fiberLocs);
-    sectionIntegr->getFiberWeights(numFibers, fiberArea);
-  }  
-  else {
-    for (int i = 0; i < numFibers; i++) {
-      fiberLocs[i] = matData[2*i];
-      fiberArea[i] = matData[2*i+1];
-    }
-  }
+  if (!fiberGeometrySet)
+    this->setFiberGeometry();
 
   for (int i = 0; i < numFibers; i++) {
     NDMaterial *theMat = theMaterials[i];
-    double y = fiberLocs[i] - yBar;
-    double A = fiberArea[i];
+    double y = yFibers[i];
+    double A = AFibers[i];
 
     // invoke revertToLast on the material
     err += theMat->revertToLastCommit();
@@ -787,24 +799,13 @@ NDFiberSection2d::revertToStart(void)
   sData[1] = 0.0;
   sData[2] = 0.0;
   
-  static double fiberLocs[10000];
-  static double fiberArea[10000];
-
-  if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, fiberLocs);
-    sectionIntegr->getFiberWeights(numFibers, fiberArea);
-  }  
-  else {
-    for (int i = 0; i < numFibers; i++) {
-      fiberLocs[i] = matData[2*i];
-      fiberArea[i] = matData[2*i+1];
-    }
-  }
+  if (!fiberGeometrySet)
+    this->setFiberGeometry();
 
   for (int i = 0; i < numFibers; i++) {
     NDMaterial *theMat = theMaterials[i];
-    double y = fiberLocs[i] - yBar;
-    double A = fiberArea[i];
+    double y = yFibers[i];
+    double A = AFibers[i];
 
     // invoke revertToLast on the material
     err += theMat->revertToStart();
@@ -1058,28 +1059,13 @@ NDFiberSection2d::recvSelf(int commitTag, Channel &theChannel,
   Abar  = 0.0;
   
   computeCentroid = data(2) ? true : false;
+
+  yBar = 0.0;
+  this->setFiberGeometry();
   
-  if (sectionIntegr != 0) {
-    static double fiberLocs[10000];
-    sectionIntegr->getFiberLocations(numFibers, fiberLocs);
-    
-    static double fiberArea[10000];
-    sectionIntegr->getFiberWeights(numFibers, fiberArea);
-    
-    for (int i = 0; i < numFibers; i++) {
-      Abar  += fiberArea[i];
-      QzBar += fiberLocs[i]*fiberArea[i];
-    }
-  }
-  else {
-    double yLoc, Area;
-    
-    for (int i = 0; i < numFibers; i++) {
-      yLoc = matData[2*i];
-      Area = matData[2*i+1];
-      Abar  += Area;
-      QzBar += yLoc*Area;
-    }
+  for (int i = 0; i < numFibers; i++) {
+    Abar  += AFibers[i];
+    QzBar += yFibers[i]*AFibers[i];
   }
   
   if (computeCentroid && Abar != 0.0)
@@ -1087,6 +1073,9 @@ NDFiberSection2d::recvSelf(int commitTag, Channel &theChannel,
   else
     yBar = 0.0;
 
+  for (int i = 0; i < numFibers; i++)
+    yFibers[i] -= yBar;
+
   return res;
 }
 
@@ -1116,16 +1105,8 @@ NDFiberSection2d::setResponse(const char **argv, int argc,
 
   if (argc > 2 && strcmp(argv[0],"fiber") == 0) {
 
-    static double fiberLocs[10000];
-    
-    if (sectionIntegr != 0) {
-      sectionIntegr->getFiberLocations(numFibers, fiberLocs);
-    }  
-    else {
-      for (int i = 0; i < numFibers; i++) {
-	fiberLocs[i] = matData[2*i];
-      }
-    }
+    if (!fiberGeometrySet)
+      this->setFiberGeometry();
     
     int key = numFibers;
     int passarg = 2;
@@ -1147,7 +1128,7 @@ NDFiberSection2d::setResponse(const char **argv, int argc,
       for (j = 0; j < numFibers; j++) {
 	if (matTag == theMaterials[j]->getTag()) {
 	  //ySearch = matData[2*j];
-	  ySearch = fiberLocs[j];
+	  ySearch = yFibers[j] + yBar;
 	  dy = ySearch-yCoord;
 	  closestDist = dy*dy;
 	  key = j;
@@ -1158,7 +1139,7 @@ NDFiberSection2d::setResponse(const char **argv, int argc,
       for ( ; j < numFibers; j++) {
 	if (matTag == theMaterials[j]->getTag()) {
 	  //ySearch = matData[2*j];
-	  ySearch = fiberLocs[j];
+	  ySearch = yFibers[j] + yBar;
 	  dy = ySearch-yCoord;
 	  distance = dy*dy;
 	  if (distance < closestDist) {
@@ -1178,13 +1159,13 @@ NDFiberSection2d::setResponse(const char **argv, int argc,
       double distance;
       
       //ySearch = matData[0];
-      ySearch = fiberLocs[0];      
+      ySearch = yFibers[0] + yBar;      
       dy = ySearch-yCoord;
       closestDist = dy*dy;
       key = 0;
       for (int j = 1; j < numFibers; j++) {
 	//ySearch = matData[2*j];
-	ySearch = fiberLocs[j];	  		
+	ySearch = yFibers[j] + yBar;	  		
 	dy = ySearch-yCoord;
 	
 	distance = dy*dy;
@@ -1333,8 +1314,12 @@ NDFiberSection2d::setParameter(const char **argv, int argc, Parameter &param)
 
   // Check if it belongs to the section integration
   else if (strstr(argv[0],"integration") != 0) {
-    if (sectionIntegr != 0)
-      return sectionIntegr->setParameter(&argv[1], argc-1, param);
+    if (sectionIntegr != 0) {
+      result = sectionIntegr->setParameter(&argv[1], argc-1, param);
+      if (result != -1)
+	param.addObject(2, this);
+      return result;
+    }
     else
       return -1;
   }
@@ -1349,8 +1334,10 @@ NDFiberSection2d::setParameter(const char **argv, int argc, Parameter &param)
 
   if (sectionIntegr != 0) {
     ok = sectionIntegr->setParameter(argv, argc, param);
-    if (ok != -1)
+    if (ok != -1) {
       result = ok;
+      param.addObject(2, this);
+    }
   }
 
   return result;
@@ -1363,6 +1350,10 @@ NDFiberSection2d::updateParameter(int paramID, Information &info)
   case 1:
     alpha = info.theDouble;
     return 0;
+  case 2:
+    // fiber locations or weights have changed in the section integration
+    fiberGeometrySet = false;
+    return 0;
   default:
     return -1;
   }
@@ -1395,32 +1386,15 @@ NDFiberSection2d::getStressResultantSensitivity(int gradIndex, bool conditional)
   static Vector sig_dAdh(2);
   static Matrix tangent(2,2);
 
-  static double fiberLocs[10000];
-  static double fiberArea[10000];
+  if (!fiberGeometrySet)
+    this->setFiberGeometry();
 
-  if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, fiberLocs);
-    sectionIntegr->getFiberWeights(numFibers, fiberArea);
-  }  
-  else {
-    for (int i = 0; i < numFibers; i++) {
-      fiberLocs[i] = matData[2*i];
-      fiberArea[i] = matData[2*i+1];
-    }
-  }
-
-  static double locsDeriv[10000];
-  static double areaDeriv[10000];
+  std::vector<double> locsDeriv(numFibers, 0.0);
+  std::vector<double> areaDeriv(numFibers, 0.0);
 
   if (sectionIntegr != 0) {
-    sectionIntegr->getLocationsDeriv(numFibers, locsDeriv);  
-    sectionIntegr->getWeightsDeriv(numFibers, areaDeriv);
-  }
-  else {
-    for (int i = 0; i < numFibers; i++) {
-      locsDeriv[i] = 0.0;
-      areaDeriv[i] = 0.0;
-    }
+    sectionIntegr->getLocationsDeriv(numFibers, locsDeriv.data());
+    sectionIntegr->getWeightsDeriv(numFibers, areaDeriv.data());
   }
   
   double rootAlpha = 1.0;
@@ -1432,8 +1406,8 @@ NDFiberSection2d::getStressResultantSensitivity(int gradIndex, bool conditional)
     drootAlphadh = 0.5/rootAlpha;
 
   for (int i = 0; i < numFibers; i++) {
-    y = fiberLocs[i] - yBar;
-    A = fiberArea[i];
+    y = yFibers[i];
+    A = AFibers[i];
     
     dsigdh = theMaterials[i]->getStressSensitivity(gradIndex,conditional);
     ds(0) += dsigdh(0)*A;
@@ -1489,37 +1463,20 @@ NDFiberSection2d::getInitialTangentSensitivity(int gradIndex)
   /*
   double y, A, dydh, dAdh, tangent, dtangentdh;
 
-  static double fiberLocs[10000];
-  static double fiberArea[10000];
+  if (!fiberGeometrySet)
+    this->setFiberGeometry();
 
-  if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, fiberLocs);
-    sectionIntegr->getFiberWeights(numFibers, fiberArea);
-  }  
-  else {
-    for (int i = 0; i < numFibers; i++) {
-      fiberLocs[i] = matData[2*i];
-      fiberArea[i] = matData[2*i+1];
-    }
-  }
-
-  static double locsDeriv[10000];
-  static double areaDeriv[10000];
+  std::vector<double> locsDeriv(numFibers, 0.0);
+  std::vector<double> areaDeriv(numFibers, 0.0);
 
   if (sectionIntegr != 0) {
-    sectionIntegr->getLocationsDeriv(numFibers, locsDeriv);  
-    sectionIntegr->getWeightsDeriv(numFibers, areaDeriv);
-  }
-  else {
-    for (int i = 0; i < numFibers; i++) {
-      locsDeriv[i] = 0.0;
-      areaDeriv[i] = 0.0;
-    }
+    sectionIntegr->getLocationsDeriv(numFibers, locsDeriv.data());
+    sectionIntegr->getWeightsDeriv(numFibers, areaDeriv.data());
   }
   
   for (int i = 0; i < numFibers; i++) {
-    y = fiberLocs[i] - yBar;
-    A = fiberArea[i];
+    y = yFibers[i];
+    A = AFibers[i];
     dydh = locsDeriv[i];
     dAdh = areaDeriv[i];
     
@@ -1548,27 +1505,15 @@ NDFiberSection2d::commitSensitivity(const Vector& defSens,
 
   dedh = defSens;
 
-  static double fiberLocs[10000];
-
-  if (sectionIntegr != 0)
-    sectionIntegr->getFiberLocations(numFibers, fiberLocs);
-  else {
-    for (int i = 0; i < numFibers; i++)
-      fiberLocs[i] = matData[2*i];
-  }
+  if (!fiberGeometrySet)
+    this->setFiberGeometry();
 
-  static double locsDeriv[10000];
-  static double areaDeriv[10000];
+  std::vector<double> locsDeriv(numFibers, 0.0);
+  std::vector<double> areaDeriv(numFibers, 0.0);
 
   if (sectionIntegr != 0) {
-    sectionIntegr->getLocationsDeriv(numFibers, locsDeriv);  
-    sectionIntegr->getWeightsDeriv(numFibers, areaDeriv);
-  }
-  else {
-    for (int i = 0; i < numFibers; i++) {
-      locsDeriv[i] = 0.0;
-      areaDeriv[i] = 0.0;
-    }
+    sectionIntegr->getLocationsDeriv(numFibers, locsDeriv.data());
+    sectionIntegr->getWeightsDeriv(numFibers, areaDeriv.data());
   }
 
   double y;
@@ -1589,7 +1534,7 @@ NDFiberSection2d::commitSensitivity(const Vector& defSens,
 
   for (int i = 0; i < numFibers; i++) {
     NDMaterial *theMat = theMaterials[i];
-    y = fiberLocs[i] - yBar;
+    y = yFibers[i];
 
     // determine material strain and set it
     depsdh(0) = d0 - y*d1 - locsDeriv[i]*kappa;
@@ -98,17 +98,22 @@ class NDFiberSection2d : public SectionForceDeformation
     int numFibers,sizeFibers;        // number of fibers in the section
     NDMaterial **theMaterials; // array of pointers to materials
     double   *matData;               // data for the materials [yloc and area]
+    double   *yFibers;               // fiber locations relative to yBar
+    double   *AFibers;               // fiber areas
     double   kData[9];               // data for ks matrix 
     double   sData[3];               // data for s vector 
     
     double QzBar, Abar, yBar;       // Section centroid
     bool computeCentroid;
     double alpha;      // Shear shape factor
+    bool fiberGeometrySet;          // yFibers and AFibers are current
 
     SectionIntegration *sectionIntegr;
 
     static ID code;
 
+    void setFiberGeometry(void);    // fill yFibers and AFibers
+
     Vector e;          // trial section deformations 
     Vector *s;         // section resisting forces  (axial force, bending moment)
     Matrix *ks;        // section stiffness
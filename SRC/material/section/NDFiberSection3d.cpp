@@ -30,6 +30,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <vector>
 
 #include <Channel.h>
 #include <Vector.h>
@@ -83,9 +84,9 @@ void* OPS_NDFiberSection3d()
 // constructors:
 NDFiberSection3d::NDFiberSection3d(int tag, int num, Fiber **fibers, double a, bool compCentroid): 
   SectionForceDeformation(tag, SEC_TAG_NDFiberSection3d),
-  numFibers(num), sizeFibers(num), theMaterials(0), matData(0),
+  numFibers(num), sizeFibers(num), theMaterials(0), matData(0), yFibers(0), zFibers(0), AFibers(0),
   Abar(0.0), QyBar(0.0), QzBar(0.0), yBar(0.0), zBar(0.0), computeCentroid(compCentroid),
-  alpha(a), sectionIntegr(0), e(6), s(0), ks(0), 
+  alpha(a), fiberGeometrySet(false), sectionIntegr(0), e(6), s(0), ks(0), 
   parameterID(0), dedh(6)
 {
   if (numFibers != 0) {
@@ -128,6 +129,8 @@ NDFiberSection3d::NDFiberSection3d(int tag, int num, Fiber **fibers, double a, b
       yBar = QzBar/Abar;  
       zBar = QyBar/Abar;
     }
+
+    this->setFiberGeometry();
   }
 
   s = new Vector(sData, 6);
@@ -149,9 +152,9 @@ NDFiberSection3d::NDFiberSection3d(int tag, int num, Fiber **fibers, double a, b
 
 NDFiberSection3d::NDFiberSection3d(int tag, int num, double a, bool compCentroid): 
     SectionForceDeformation(tag, SEC_TAG_NDFiberSection3d),
-    numFibers(0), sizeFibers(num), theMaterials(0), matData(0),
+    numFibers(0), sizeFibers(num), theMaterials(0), matData(0), yFibers(0), zFibers(0), AFibers(0),
     Abar(0.0), QyBar(0.0), QzBar(0.0), yBar(0.0), zBar(0.0), computeCentroid(compCentroid),
-    alpha(a), sectionIntegr(0), e(6), s(0), ks(0), 
+    alpha(a), fiberGeometrySet(false), sectionIntegr(0), e(6), s(0), ks(0), 
     parameterID(0), dedh(6)
 {
     if (sizeFibers != 0) {
@@ -198,9 +201,9 @@ NDFiberSection3d::NDFiberSection3d(int tag, int num, double a, bool compCentroid
 NDFiberSection3d::NDFiberSection3d(int tag, int num, NDMaterial **mats,
 				   SectionIntegration &si, double a, bool compCentroid):
   SectionForceDeformation(tag, SEC_TAG_NDFiberSection3d),
-  numFibers(num), sizeFibers(num), theMaterials(0), matData(0),
+  numFibers(num), sizeFibers(num), theMaterials(0), matData(0), yFibers(0), zFibers(0), AFibers(0),
   Abar(0.0), QyBar(0.0), QzBar(0.0), yBar(0.0), zBar(0.0), computeCentroid(compCentroid),
-  alpha(a), sectionIntegr(0), e(6), s(0), ks(0), 
+  alpha(a), fiberGeometrySet(false), sectionIntegr(0), e(6), s(0), ks(0), 
   parameterID(0), dedh(6)
 {
   if (numFibers != 0) {
@@ -224,18 +227,13 @@ NDFiberSection3d::NDFiberSection3d(int tag, int num, NDMaterial **mats,
     exit(-1);
   }
 
-  static double yLocs[10000];
-  static double zLocs[10000];
-  sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
-  
-  static double fiberArea[10000];
-  sectionIntegr->getFiberWeights(numFibers, fiberArea);
+  this->setFiberGeometry();
 
   for (int i = 0; i < numFibers; i++) {
 
-    Abar  += fiberArea[i];
-    QzBar += yLocs[i]*fiberArea[i];
-    QyBar += zLocs[i]*fiberArea[i];
+    Abar  += AFibers[i];
+    QzBar += yFibers[i]*AFibers[i];
+    QyBar += zFibers[i]*AFibers[i];
 
     theMaterials[i] = mats[i]->getCopy("BeamFiber");
     
@@ -250,6 +248,11 @@ NDFiberSection3d::NDFiberSection3d(int tag, int num, NDMaterial **mats,
     zBar = QyBar/Abar;
   }
 
+  for (int i = 0; i < numFibers; i++) {
+    yFibers[i] -= yBar;
+    zFibers[i] -= zBar;
+  }
+
   s = new Vector(sData, 6);
   ks = new Matrix(kData, 6, 6);
   
@@ -270,9 +273,9 @@ NDFiberSection3d::NDFiberSection3d(int tag, int num, NDMaterial **mats,
 // constructor for blank object that recvSelf needs to be invoked upon
 NDFiberSection3d::NDFiberSection3d():
   SectionForceDeformation(0, SEC_TAG_NDFiberSection3d),
-  numFibers(0), sizeFibers(0), theMaterials(0), matData(0),
+  numFibers(0), sizeFibers(0), theMaterials(0), matData(0), yFibers(0), zFibers(0), AFibers(0),
   Abar(0.0), QyBar(0.0), QzBar(0.0), yBar(0.0), zBar(0.0), computeCentroid(true),
-  alpha(1.0), sectionIntegr(0), e(6), s(0), ks(0),
+  alpha(1.0), fiberGeometrySet(false), sectionIntegr(0), e(6), s(0), ks(0),
   parameterID(0), dedh(6)
 {
   s = new Vector(sData, 6);
@@ -359,6 +362,8 @@ NDFiberSection3d::addFiber(Fiber &newFiber)
     yBar = QzBar/Abar;
     zBar = QyBar/Abar;
   }
+
+  fiberGeometrySet = false;
   
   return 0;
 }
@@ -378,6 +383,15 @@ NDFiberSection3d::~NDFiberSection3d()
   if (matData != 0)
     delete [] matData;
 
+  if (yFibers != 0)
+    delete [] yFibers;
+
+  if (zFibers != 0)
+    delete [] zFibers;
+
+  if (AFibers != 0)
+    delete [] AFibers;
+
   if (s != 0)
     delete s;
 
@@ -391,6 +405,45 @@ NDFiberSection3d::~NDFiberSection3d()
 // a = [1 -y z       0       0  0
 //      0  0 0 sqrt(a)       0 -z
 //      0  0 0       0 sqrt(a)  y]
+void
+NDFiberSection3d::setFiberGeometry(void)
+{
+  if (yFibers != 0)
+    delete [] yFibers;
+  if (zFibers != 0)
+    delete [] zFibers;
+  if (AFibers != 0)
+    delete [] AFibers;
+  yFibers = 0;
+  zFibers = 0;
+  AFibers = 0;
+
+  if (numFibers > 0) {
+    yFibers = new double [numFibers];
+    zFibers = new double [numFibers];
+    AFibers = new double [numFibers];
+
+    if (sectionIntegr != 0) {
+      sectionIntegr->getFiberLocations(numFibers, yFibers, zFibers);
+      sectionIntegr->getFiberWeights(numFibers, AFibers);
+    }
+    else {
+      for (int i = 0; i < numFibers; i++) {
+	yFibers[i] = matData[3*i];
+	zFibers[i] = matData[3*i+1];
+	AFibers[i] = matData[3*i+2];
+      }
+    }
+
+    for (int i = 0; i < numFibers; i++) {
+      yFibers[i] -= yBar;
+      zFibers[i] -= zBar;
+    }
+  }
+
+  fiberGeometrySet = true;
+}
+
 int
 NDFiberSection3d::setTrialSectionDeformation (const Vector &deforms)
 {
@@ -408,23 +461,10 @@ NDFiberSection3d::setTrialSectionDeformation (const Vector &deforms)
   double d4 = deforms(4);
   double d5 = deforms(5);
 
-  static double yLocs[10000];
-  static double zLocs[10000];
-  static double fiberArea[10000];
-
-  if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
-    sectionIntegr->getFiberWeights(numFibers, fiberArea);
-  }  
-  else {
-    for (int i = 0; i < numFibers; i++) {
-      yLocs[i] = matData[3*i];
-      zLocs[i] = matData[3*i+1];
-      fiberArea[i] = matData[3*i+2];
-    }
-  }
+  if (!fiberGeometrySet)
+    this->setFiberGeometry();
   
-  static Vector eps(3);
+  static thread_local Vector eps(3);
 
   double rootAlpha = 1.0;
   if (alpha != 1.0)
@@ -432,9 +472,9 @@ NDFiberSection3d::setTrialSectionDeformation (const Vector &deforms)
 
   for (int i = 0; i < numFibers; i++) {
     NDMaterial *theMat = theMaterials[i];
-    double y = yLocs[i] - yBar;
-    double z = zLocs[i] - zBar;
-    double A = fiberArea[i];
+    double y = yFibers[i];
+    double z = zFibers[i];
+    double A = AFibers[i];
 
     double y2 = y*y;
     double z2 = z*z;
@@ -551,25 +591,12 @@ NDFiberSection3d::getSectionDeformation(void)
 const Matrix&
 NDFiberSection3d::getInitialTangent(void)
 {
-  static double kInitial[36];
-  static Matrix ki(kInitial, 6, 6);
+  static thread_local double kInitial[36];
+  static thread_local Matrix ki(kInitial, 6, 6);
   ki.Zero();
 
-  static double yLocs[10000];
-  static double zLocs[10000];
-  static double fiberArea[10000];
-
-  if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
-    sectionIntegr->getFiberWeights(numFibers, fiberArea);
-  }  
-  else {
-    for (int i = 0; i < numFibers; i++) {
-      yLocs[i] = matData[3*i];
-      zLocs[i] = matData[3*i+1];
-      fiberArea[i] = matData[3*i+2];
-    }
-  }
+  if (!fiberGeometrySet)
+    this->setFiberGeometry();
 
   double rootAlpha = 1.0;
   if (alpha != 1.0)
@@ -577,9 +604,9 @@ NDFiberSection3d::getInitialTangent(void)
 
   for (int i = 0; i < numFibers; i++) {
     NDMaterial *theMat = theMaterials[i];
-    double y = yLocs[i] - yBar;
-    double z = zLocs[i] - zBar;
-    double A = fiberArea[i];
+    double y = yFibers[i];
+    double z = zFibers[i];
+    double A = AFibers[i];
 
     double y2 = y*y;
     double z2 = z*z;
@@ -736,6 +763,9 @@ NDFiberSection3d::getCopy(void)
   else
     theCopy->sectionIntegr = 0;
 
+
+  theCopy->setFiberGeometry();
+
   return theCopy;
 }
 
@@ -770,21 +800,8 @@ NDFiberSection3d::revertToLastCommit(void)
   ks->Zero();
   s->Zero();
   
-  static double yLocs[10000];
-  static double zLocs[10000];
-  static double fiberArea[10000];
-
-  if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
-    sectionIntegr->getFiberWeights(numFibers, fiberArea);
-  }  
-  else {
-    for (int i = 0; i < numFibers; i++) {
-      yLocs[i] = matData[3*i];
-      zLocs[i] = matData[3*i+1];
-      fiberArea[i] = matData[3*i+2];
-    }
-  }
+  if (!fiberGeometrySet)
+    this->setFiberGeometry();
 
   double rootAlpha = 1.0;
   if (alpha != 1.0)
@@ -792,9 +809,9 @@ NDFiberSection3d::revertToLastCommit(void)
 
   for (int i = 0; i < numFibers; i++) {
     NDMaterial *theMat = theMaterials[i];
-    double y = yLocs[i] - yBar;
-    double z = zLocs[i] - zBar;
-    double A = fiberArea[i];
+    double y = yFibers[i];
+    double z = zFibers[i];
+    double A = AFibers[i];
 
     double y2 = y*y;
     double z2 = z*z;
@@ -909,21 +926,8 @@ NDFiberSection3d::revertToStart(void)
   ks->Zero();
   s->Zero();
   
-  static double yLocs[10000];
-  static double zLocs[10000];
-  static double fiberArea[10000];
-
-  if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
-    sectionIntegr->getFiberWeights(numFibers, fiberArea);
-  }  
-  else {
-    for (int i = 0; i < numFibers; i++) {
-      yLocs[i] = matData[3*i];
-      zLocs[i] = matData[3*i+1];
-      fiberArea[i] = matData[3*i+2];
-    }
-  }
+  if (!fiberGeometrySet)
+    this->setFiberGeometry();
 
   double rootAlpha = 1.0;
   if (alpha != 1.0)
@@ -932,9 +936,9 @@ NDFiberSection3d::revertToStart(void)
   for (int i = 0; i < numFibers; i++) {
     NDMaterial *theMat = theMaterials[i];
 
-    double y = yLocs[i] - yBar;
-    double z = zLocs[i] - zBar;
-    double A = fiberArea[i];
+    double y = yFibers[i];
+    double z = zFibers[i];
+    double A = AFibers[i];
 
     double y2 = y*y;
     double z2 = z*z;
@@ -1238,34 +1242,17 @@ NDFiberSection3d::recvSelf(int commitTag, Channel &theChannel,
     QzBar = 0.0;
     QyBar = 0.0;
     Abar  = 0.0;
-    double yLoc, zLoc, Area;
 
     computeCentroid = data(2) ? true : false;
 
-    if (sectionIntegr != 0) {
-      static double yLocs[10000];
-      static double zLocs[10000];
-      sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
-      
-      static double fiberArea[10000];
-      sectionIntegr->getFiberWeights(numFibers, fiberArea);
-      
-      for (int i = 0; i < numFibers; i++) {
-	Abar  += fiberArea[i];
-	QzBar += yLocs[i]*fiberArea[i];
-	QyBar += zLocs[i]*fiberArea[i];
-      }
-    }
-    else {
-      double yLoc, zLoc, Area;
-      for (i = 0; computeCentroid && i < numFibers; i++) {
-	yLoc = matData[3*i];
-	zLoc = matData[3*i+1];
-	Area = matData[3*i+2];
-	Abar  += Area;
-	QzBar += yLoc*Area;
-	QyBar += zLoc*Area;
-      }
+    yBar = 0.0;
+    zBar = 0.0;
+    this->setFiberGeometry();
+
+    for (i = 0; i < numFibers; i++) {
+      Abar  += AFibers[i];
+      QzBar += yFibers[i]*AFibers[i];
+      QyBar += zFibers[i]*AFibers[i];
     }
     
     if (computeCentroid && Abar != 0.0) {
@@ -1275,6 +1262,11 @@ NDFiberSection3d::recvSelf(int commitTag, Channel &theChannel,
       yBar = 0.0;
       zBar = 0.0;      
     }    
+
+    for (i = 0; i < numFibers; i++) {
+      yFibers[i] -= yBar;
+      zFibers[i] -= zBar;
+    }
   }    
 
   return res;
@@ -1306,18 +1298,8 @@ NDFiberSection3d::setResponse(const char **argv, int argc,
 
   if (argc > 2 && strcmp(argv[0],"fiber") == 0) {
 
-    static double yLocs[10000];
-    static double zLocs[10000];
-    
-    if (sectionIntegr != 0) {
-      sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
-    }  
-    else {
-      for (int i = 0; i < numFibers; i++) {
-	yLocs[i] = matData[3*i];
-	zLocs[i] = matData[3*i+1];
-      }
-    }
+    if (!fiberGeometrySet)
+      this->setFiberGeometry();
     
     int key = numFibers;
     int passarg = 2;
@@ -1340,8 +1322,8 @@ NDFiberSection3d::setResponse(const char **argv, int argc,
 	if (matTag == theMaterials[j]->getTag()) {
 	  //ySearch = matData[3*j];
 	  //zSearch = matData[3*j+1];
-	  ySearch = yLocs[j];
-	  zSearch = zLocs[j];	    	  
+	  ySearch = yFibers[j] + yBar;
+	  zSearch = zFibers[j] + zBar;	    	  
 	  dy = ySearch-yCoord;
 	  dz = zSearch-zCoord;
 	  closestDist = dy*dy + dz*dz;
@@ -1354,8 +1336,8 @@ NDFiberSection3d::setResponse(const char **argv, int argc,
 	if (matTag == theMaterials[j]->getTag()) {
 	  //ySearch = matData[3*j];
 	  //zSearch = matData[3*j+1];
-	  ySearch = yLocs[j];
-	  zSearch = zLocs[j];	    	  	  
+	  ySearch = yFibers[j] + yBar;
+	  zSearch = zFibers[j] + zBar;	    	  	  
 	  dy = ySearch-yCoord;
 	  dz = zSearch-zCoord;
 	  distance = dy*dy + dz*dz;
@@ -1378,8 +1360,8 @@ NDFiberSection3d::setResponse(const char **argv, int argc,
       
       //ySearch = matData[0];
       //zSearch = matData[1];
-      ySearch = yLocs[0];
-      zSearch = zLocs[0];	    	  	        
+      ySearch = yFibers[0] + yBar;
+      zSearch = zFibers[0] + zBar;	    	  	        
       dy = ySearch-yCoord;
       dz = zSearch-zCoord;
       closestDist = dy*dy + dz*dz;
@@ -1387,8 +1369,8 @@ NDFiberSection3d::setResponse(const char **argv, int argc,
       for (int j = 1; j < numFibers; j++) {
 	//ySearch = matData[3*j];
 	//zSearch = matData[3*j+1];
-	ySearch = yLocs[j];
-	zSearch = zLocs[j];	    	
+	ySearch = yFibers[j] + yBar;
+	zSearch = zFibers[j] + zBar;	    	
 	dy = ySearch-yCoord;
 	dz = zSearch-zCoord;
 	distance = dy*dy + dz*dz;
@@ -1540,8 +1522,12 @@ NDFiberSection3d::setParameter(const char **argv, int argc, Parameter &param)
 
   // Check if it belongs to the section integration
   else if (strstr(argv[0],"integration") != 0) {
-    if (sectionIntegr != 0)
-      return sectionIntegr->setParameter(&argv[1], argc-1, param);
+    if (sectionIntegr != 0) {
+      result = sectionIntegr->setParameter(&argv[1], argc-1, param);
+      if (result != -1)
+	param.addObject(2, this);
+      return result;
+    }
     else
       return -1;
   }
@@ -1556,8 +1542,10 @@ NDFiberSection3d::setParameter(const char **argv, int argc, Parameter &param)
 
   if (sectionIntegr != 0) {
     ok = sectionIntegr->setParameter(argv, argc, param);
-    if (ok != -1)
+    if (ok != -1) {
       result = ok;
+      param.addObject(2, this);
+    }
   }
 
   return result;
@@ -1570,6 +1558,10 @@ NDFiberSection3d::updateParameter(int paramID, Information &info)
   case 1:
     alpha = info.theDouble;
     return 0;
+  case 2:
+    // fiber locations or weights have changed in the section integration
+    fiberGeometrySet = false;
+    return 0;
   default:
     return -1;
   }
@@ -1602,36 +1594,16 @@ NDFiberSection3d::getStressResultantSensitivity(int gradIndex, bool conditional)
   static Vector sig_dAdh(3);
   static Matrix tangent(3,3);
 
-  static double yLocs[10000];
-  static double zLocs[10000];
-  static double fiberArea[10000];
-
-  if (sectionIntegr != 0) {
-    sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
-    sectionIntegr->getFiberWeights(numFibers, fiberArea);
-  }  
-  else {
-    for (int i = 0; i < numFibers; i++) {
-      yLocs[i] = matData[3*i];
-      zLocs[i] = matData[3*i+1];
-      fiberArea[i] = matData[3*i+2];
-    }
-  }
+  if (!fiberGeometrySet)
+    this->setFiberGeometry();
 
-  static double dydh[10000];
-  static double dzdh[10000];
-  static double areaDeriv[10000];
+  std::vector<double> dydh(numFibers, 0.0);
+  std::vector<double> dzdh(numFibers, 0.0);
+  std::vector<double> areaDeriv(numFibers, 0.0);
 
   if (sectionIntegr != 0) {
-    sectionIntegr->getLocationsDeriv(numFibers, dydh, dzdh);  
-    sectionIntegr->getWeightsDeriv(numFibers, areaDeriv);
-  }
-  else {
-    for (int i = 0; i < numFibers; i++) {
-      dydh[i] = 0.0;
-      dzdh[i] = 0.0;
-      areaDeriv[i] = 0.0;
-    }
+    sectionIntegr->getLocationsDeriv(numFibers, dydh.data(), dzdh.data());
+    sectionIntegr->getWeightsDeriv(numFibers, areaDeriv.data());
   }
   
   double rootAlpha = 1.0;
@@ -1643,9 +1615,9 @@ NDFiberSection3d::getStressResultantSensitivity(int gradIndex, bool conditional)
     drootAlphadh = 0.5/rootAlpha;
 
   for (int i = 0; i < numFibers; i++) {
-    y = yLocs[i] - yBar;
-    z = zLocs[i] - zBar;
-    A = fiberArea[i];
+    y = yFibers[i];
+    z = zFibers[i];
+    A = AFibers[i];
     
     dsigdh = theMaterials[i]->getStressSensitivity(gradIndex,true);
 
@@ -1787,29 +1759,14 @@ NDFiberSection3d::commitSensitivity(const Vector& defSens,
 
   dedh = defSens;
 
-  static double yLocs[10000];
-  static double zLocs[10000];
-
-  if (sectionIntegr != 0)
-    sectionIntegr->getFiberLocations(numFibers, yLocs, zLocs);
-  else {
-    for (int i = 0; i < numFibers; i++) {
-      yLocs[i] = matData[3*i];
-      zLocs[i] = matData[3*i+1];
-    }
-  }
+  if (!fiberGeometrySet)
+    this->setFiberGeometry();
 
-  static double dydh[10000];
-  static double dzdh[10000];
+  std::vector<double> dydh(numFibers, 0.0);
+  std::vector<double> dzdh(numFibers, 0.0);
 
   if (sectionIntegr != 0)
-    sectionIntegr->getLocationsDeriv(numFibers, dydh, dzdh);  
-  else {
-    for (int i = 0; i < numFibers; i++) {
-      dydh[i] = 0.0;
-      dzdh[i] = 0.0;
-    }
-  }
+    sectionIntegr->getLocationsDeriv(numFibers, dydh.data(), dzdh.data());
 
   double y, z;
 
@@ -1825,8 +1782,8 @@ NDFiberSection3d::commitSensitivity(const Vector& defSens,
 
   for (int i = 0; i < numFibers; i++) {
     NDMaterial *theMat = theMaterials[i];
-    y = yLocs[i] - yBar;
-    z = zLocs[i] - zBar;
+    y = yFibers[i];
+    z = zFibers[i];
 
     // determine material strain and set it
     depsdh(0) = d0 - y*d1 + z*d2 - dydh[i]*e(1) + dzdh[i]*e(2);
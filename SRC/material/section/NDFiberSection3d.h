@@ -98,6 +98,9 @@ class NDFiberSection3d : public SectionForceDeformation
     int numFibers, sizeFibers;                   // number of fibers in the section
     NDMaterial **theMaterials; // array of pointers to materials
     double   *matData;               // data for the materials [yloc and area]
+    double   *yFibers;               // fiber locations relative to yBar
+    double   *zFibers;               // fiber locations relative to zBar
+    double   *AFibers;               // fiber areas
     double   kData[36];               // data for ks matrix 
     double   sData[6];               // data for s vector 
 
@@ -106,11 +109,14 @@ class NDFiberSection3d : public SectionForceDeformation
     double zBar;       // Section centroid
     bool computeCentroid;
     double alpha;      // Shear shape factor
+    bool fiberGeometrySet;  // yFibers, zFibers and AFibers are current
 
     SectionIntegration *sectionIntegr;
 
     static ID code;
 
+    void setFiberGeometry(void);    // fill yFibers, zFibers and AFibers
+
     Vector e;          // trial section deformations 
     Vector *s;         // section resisting forces  (axial force, bending moment)
     Matrix *ks;        // section stiffness
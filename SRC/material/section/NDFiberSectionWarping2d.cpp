@@ -31,6 +31,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <vector>
 
 #include <Channel.h>
 #include <Vector.h>
@@ -84,8 +85,8 @@ void* OPS_NDFiberSectionWarping2d()
 // constructors:
 NDFiberSectionWarping2d::NDFiberSectionWarping2d(int tag, int num, Fiber **fibers, double a): 
 SectionForceDeformation(tag, SEC_TAG_NDFiberSectionWarping2d),
-numFibers(num), sizeFibers(num), theMaterials(0), matData(0),
-yBar(0.0), alpha(a), yBarZero(0.0), DeltaYbar(0.0), sectionIntegr(0),
+numFibers(num), sizeFibers(num), theMaterials(0), matData(0), yFibers(0), AFibers(0),
+yBar(0.0), alpha(a), yBarZero(0.0), DeltaYbar(0.0), fiberGeometrySet(false), sectionIntegr(0),
 e(5), eCommit(5), s(0), ks(0), parameterID(0), dedh(5)
 { 
 	if (numFibers != 0) {
@@ -130,6 +131,8 @@ e(5), eCommit(5), s(0), ks(0), parameterID(0), dedh(5)
 
 		yBar = Qz/A; 
 		yBarZero = Qz/A;
+
+		this->setFiberGeometry();
 	}
 
 	s = new Vector(sData, 5);
@@ -176,8 +179,8 @@ e(5), eCommit(5), s(0), ks(0), parameterID(0), dedh(5)
 
 NDFiberSectionWarping2d::NDFiberSectionWarping2d(int tag, int num, double a): 
     SectionForceDeformation(tag, SEC_TAG_NDFiberSectionWarping2d),
-    numFibers(0), sizeFibers(num), theMaterials(0), matData(0),
-    yBar(0.0), alpha(a), yBarZero(0.0), DeltaYbar(0.0), sectionIntegr(0),
+    numFibers(0), sizeFibers(num), theMaterials(0), matData(0), yFibers(0), AFibers(0),
+    yBar(0.0), alpha(a), yBarZero(0.0), DeltaYbar(0.0), fiberGeometrySet(false), sectionIntegr(0),
     e(5), eCommit(5), s(0), ks(0), parameterID(0), dedh(5)
 {
     if (sizeFibers != 0) {
@@ -223,8 +226,8 @@ NDFiberSectionWarping2d::NDFiberSectionWarping2d(int tag, int num, double a):
 NDFiberSectionWarping2d::NDFiberSectionWarping2d(int tag, int num, NDMaterial **mats,
 	SectionIntegration &si, double a):
 SectionForceDeformation(tag, SEC_TAG_NDFiberSectionWarping2d),
-numFibers(num), sizeFibers(num), theMaterials(0), matData(0),
-yBar(0.0), alpha(a), yBarZero(0.0), DeltaYbar(0.0), sectionIntegr(0),
+numFibers(num), sizeFibers(num), theMaterials(0), matData(0), yFibers(0), AFibers(0),
+yBar(0.0), alpha(a), yBarZero(0.0), DeltaYbar(0.0), fiberGeometrySet(false), sectionIntegr(0),
 e(5), eCommit(5), s(0), ks(0), parameterID(0), dedh(5)
 {
 	if (numFibers != 0) {
@@ -248,19 +251,15 @@ e(5), eCommit(5), s(0), ks(0), parameterID(0), dedh(5)
 		exit(-1);
 	}
 
-	static double fiberLocs[10000];
-	sectionIntegr->getFiberLocations(numFibers, fiberLocs);
-
-	static double fiberArea[10000];
-	sectionIntegr->getFiberWeights(numFibers, fiberArea);
+	this->setFiberGeometry();
 
 	double Qz = 0.0;
 	double A  = 0.0;
 
 	for (int i = 0; i < numFibers; i++) {
 
-		A  +=  fiberArea[i];
-		Qz +=  fiberLocs[i]*fiberArea[i];
+		A  +=  AFibers[i];
+		Qz +=  yFibers[i]*AFibers[i];
 
 		theMaterials[i] = mats[i]->getCopy("BeamFiber2d");
 
@@ -273,6 +272,9 @@ e(5), eCommit(5), s(0), ks(0), parameterID(0), dedh(5)
 	yBar = Qz/A; 
 	yBarZero = Qz/A;
 
+	for (int i = 0; i < numFibers; i++)
+		yFibers[i] -= yBar;
+
 	s = new Vector(sData, 5);
 	ks = new Matrix(kData, 5, 5); 
 
@@ -318,8 +320,8 @@ e(5), eCommit(5), s(0), ks(0), parameterID(0), dedh(5)
 // constructor for blank object that recvSelf needs to be invoked upon
 NDFiberSectionWarping2d::NDFiberSectionWarping2d():
 SectionForceDeformation(0, SEC_TAG_NDFiberSectionWarping2d),
-numFibers(0), sizeFibers(0), theMaterials(0), matData(0),
-yBar(0.0), alpha(0.0), yBarZero(0.0), DeltaYbar(0.0), sectionIntegr(0),
+numFibers(0), sizeFibers(0), theMaterials(0), matData(0), yFibers(0), AFibers(0),
+yBar(0.0), alpha(0.0), yBarZero(0.0), DeltaYbar(0.0), fiberGeometrySet(false), sectionIntegr(0),
 e(5), eCommit(5), s(0), ks(0), parameterID(0), dedh(5)
 {
 	s = new Vector(sData, 5);
@@ -433,6 +435,8 @@ NDFiberSectionWarping2d::addFiber(Fiber &newFiber)
 	yBar = Qz/A;
 	yBarZero = Qz/A;
 
+	fiberGeometrySet = false;
+
 	return 0;
 }
 
@@ -451,6 +455,12 @@ NDFiberSectionWarping2d::~NDFiberSectionWarping2d()
 	if (matData != 0)
 		delete [] matData;
 
+	if (yFibers != 0)
+		delete [] yFibers;
+
+	if (AFibers != 0)
+		delete [] AFibers;
+
 	if (s != 0)
 		delete s;
 
@@ -461,6 +471,38 @@ NDFiberSectionWarping2d::~NDFiberSectionWarping2d()
 		delete sectionIntegr;
 }
 
+void
+	NDFiberSectionWarping2d::setFiberGeometry(void)
+{
+	if (yFibers != 0)
+		delete [] yFibers;
+	if (AFibers != 0)
+		delete [] AFibers;
+	yFibers = 0;
+	AFibers = 0;
+
+	if (numFibers > 0) {
+		yFibers = new double [numFibers];
+		AFibers = new double [numFibers];
+
+		if (sectionIntegr != 0) {
+			sectionIntegr->getFiberLocations(numFibers, yFibers);
+			sectionIntegr->getFiberWeights(numFibers, AFibers);
+		}
+		else {
+			for (int i = 0; i < numFibers; i++) {
+				yFibers[i] = matData[2*i];
+				AFibers[i] = matData[2*i+1];
+			}
+		}
+
+		for (int i = 0; i < numFibers; i++)
+			yFibers[i] -= yBar;
+	}
+
+	fiberGeometrySet = true;
+}
+
 int
 	NDFiberSectionWarping2d::setTrialSectionDeformation (const Vector &deforms)
 {
@@ -506,35 +548,24 @@ int
 	double d3 = deforms(3);
 	double d4 = deforms(4);
 
-	static double fiberLocs[10000];
-	static double fiberArea[10000];
+	if (!fiberGeometrySet)
+		this->setFiberGeometry();
 
-	if (sectionIntegr != 0) {
-		sectionIntegr->getFiberLocations(numFibers, fiberLocs);
-		sectionIntegr->getFiberWeights(numFibers, fiberArea);
-	}  
-	else {
-		for (int i = 0; i < numFibers; i++) {
-			fiberLocs[i] = matData[2*i];
-			fiberArea[i] = matData[2*i+1];
-		}
-	}
-
-	static Vector eps(2);
+	static thread_local Vector eps(2);
 
 	// h ~ parameter equals Height/2 for symmetric cases
-	double maxLoc(fiberLocs[1] - yBarZero), minLoc(fiberLocs[1] - yBarZero); 
+	double maxLoc(yFibers[1] + yBar - yBarZero), minLoc(yFibers[1] + yBar - yBarZero); 
 	for (int i = 0; i < numFibers; i++) {
-		if (fiberLocs[i] - yBarZero > maxLoc) { maxLoc = fiberLocs[i] - yBarZero;}
-		if (fiberLocs[i] - yBarZero < minLoc) { minLoc = fiberLocs[i] - yBarZero;}
+		if (yFibers[i] + yBar - yBarZero > maxLoc) { maxLoc = yFibers[i] + yBar - yBarZero;}
+		if (yFibers[i] + yBar - yBarZero < minLoc) { minLoc = yFibers[i] + yBar - yBarZero;}
 	}
 	double h (maxLoc);  //opserr<<"   h:   "<<h<<endln;
 
 	for (int i = 0; i < numFibers; i++) {
 
 		NDMaterial *theMat = theMaterials[i];
-		double y = fiberLocs[i] - yBar; 
-		double A = fiberArea[i];
+		double y = yFibers[i]; 
+		double A = AFibers[i];
 
 		// determine material strain and set it
 		eps(0) = d0 - y*d1 + (y*y*y/(h*h*h) - 0.6*y/h)*d4;
@@ -653,8 +684,8 @@ double
 const Matrix&
 	NDFiberSectionWarping2d::getInitialTangent(void)
 {
-	static double kInitial[25];
-	static Matrix kInitialMatrix(kInitial, 5, 5);
+	static thread_local double kInitial[25];
+	static thread_local Matrix kInitialMatrix(kInitial, 5, 5);
 	kInitial[0] = 0.0; 
 	kInitial[1] = 0.0;
 	kInitial[2] = 0.0;
@@ -681,24 +712,13 @@ const Matrix&
 	kInitial[23] = 0.0;
 	kInitial[24] = 0.0;
 
-	static double fiberLocs[10000];
-	static double fiberArea[10000];
-
-	if (sectionIntegr != 0) {
-		sectionIntegr->getFiberLocations(numFibers, fiberLocs);
-		sectionIntegr->getFiberWeights(numFibers, fiberArea);
-	}  
-	else {
-		for (int i = 0; i < numFibers; i++) {
-			fiberLocs[i] = matData[2*i];
-			fiberArea[i] = matData[2*i+1];
-		}
-	}
+	if (!fiberGeometrySet)
+		this->setFiberGeometry();
 
 	for (int i = 0; i < numFibers; i++) {
 		NDMaterial *theMat = theMaterials[i];
-		double y = fiberLocs[i] - yBar;
-		double A = fiberArea[i];
+		double y = yFibers[i];
+		double A = AFibers[i];
 
 		const Matrix &tangent = theMat->getInitialTangent();
 
@@ -708,10 +728,10 @@ const Matrix&
 		double d11 = tangent(1,1)*A;
 
 		// h ~ section height / 2 in Linear case
-		double maxLoc(fiberLocs[1] - yBarZero), minLoc(fiberLocs[1] - yBarZero);
+		double maxLoc(yFibers[1] + yBar - yBarZero), minLoc(yFibers[1] + yBar - yBarZero);
 		for (int i = 0; i < numFibers; i++) {
-			if (fiberLocs[i] - yBarZero > maxLoc) { maxLoc = fiberLocs[i] - yBarZero;}
-			if (fiberLocs[i] - yBarZero < minLoc) { minLoc = fiberLocs[i] - yBarZero;}
+			if (yFibers[i] + yBar - yBarZero > maxLoc) { maxLoc = yFibers[i] + yBar - yBarZero;}
+			if (yFibers[i] + yBar - yBarZero < minLoc) { minLoc = yFibers[i] + yBar - yBarZero;}
 		}
 		double h (maxLoc);
 		double omega      = y*y*y/(h*h*h)-0.6*y/h;
@@ -873,6 +893,8 @@ SectionForceDeformation*
 	else
 		theCopy->sectionIntegr = 0;
 
+	theCopy->setFiberGeometry();
+
 	return theCopy;
 }
 
@@ -941,32 +963,21 @@ int
 	sData[3] = 0.0;
 	sData[4] = 0.0;
 
-	static double fiberLocs[10000];
-	static double fiberArea[10000];
-
-	if (sectionIntegr != 0) {
-		sectionIntegr->getFiberLocations(numFibers, fiberLocs);
-		sectionIntegr->getFiberWeights(numFibers, fiberArea);
-	}  
-	else {
-		for (int i = 0; i < numFibers; i++) {
-			fiberLocs[i] = matData[2*i];
-			fiberArea[i] = matData[2*i+1];
-		}
-	}
+	if (!fiberGeometrySet)
+		this->setFiberGeometry();
 
 	// h ~ section height / 2 in Linear case
-	double maxLoc(fiberLocs[1] - yBarZero), minLoc(fiberLocs[1] - yBarZero);
+	double maxLoc(yFibers[1] + yBar - yBarZero), minLoc(yFibers[1] + yBar - yBarZero);
 	for (int i = 0; i < numFibers; i++) {
-		if (fiberLocs[i] - yBarZero > maxLoc) { maxLoc = fiberLocs[i] - yBarZero;}
-		if (fiberLocs[i] - yBarZero < minLoc) { minLoc = fiberLocs[i] - yBarZero;}
+		if (yFibers[i] + yBar - yBarZero > maxLoc) { maxLoc = yFibers[i] + yBar - yBarZero;}
+		if (yFibers[i] + yBar - yBarZero < minLoc) { minLoc = yFibers[i] + yBar - yBarZero;}
 	}
 	double h (maxLoc);
 
 	for (int i = 0; i < numFibers; i++) {
 		NDMaterial *theMat = theMaterials[i];
-		double y = fiberLocs[i] - yBar;
-		double A = fiberArea[i];
+		double y = yFibers[i];
+		double A = AFibers[i];
 
 		// invoke revertToLast on the material
 		err += theMat->revertToLastCommit();
@@ -1098,24 +1109,13 @@ int
 	sData[3] = 0.0;
 	sData[4] = 0.0;
 
-	static double fiberLocs[10000];
-	static double fiberArea[10000];
-
-	if (sectionIntegr != 0) {
-		sectionIntegr->getFiberLocations(numFibers, fiberLocs);
-		sectionIntegr->getFiberWeights(numFibers, fiberArea);
-	}  
-	else {
-		for (int i = 0; i < numFibers; i++) {
-			fiberLocs[i] = matData[2*i];
-			fiberArea[i] = matData[2*i+1];
-		}
-	}
+	if (!fiberGeometrySet)
+		this->setFiberGeometry();
 
 	for (int i = 0; i < numFibers; i++) {
 		NDMaterial *theMat = theMaterials[i];
-		double y = fiberLocs[i] - yBar;
-		double A = fiberArea[i];
+		double y = yFibers[i];
+		double A = AFibers[i];
 
 		// invoke revertToLast on the material
 		err += theMat->revertToStart();
@@ -1130,10 +1130,10 @@ int
 		double d11 = tangent(1,1)*A;
 
 		// h ~ section height / 2 in Linear case
-		double maxLoc(fiberLocs[1] - yBarZero), minLoc(fiberLocs[1] - yBarZero);
+		double maxLoc(yFibers[1] + yBar - yBarZero), minLoc(yFibers[1] + yBar - yBarZero);
 		for (int i = 0; i < numFibers; i++) {
-			if (fiberLocs[i] - yBarZero > maxLoc) { maxLoc = fiberLocs[i] - yBarZero;}
-			if (fiberLocs[i] - yBarZero < minLoc) { minLoc = fiberLocs[i] - yBarZero;}
+			if (yFibers[i] + yBar - yBarZero > maxLoc) { maxLoc = yFibers[i] + yBar - yBarZero;}
+			if (yFibers[i] + yBar - yBarZero < minLoc) { minLoc = yFibers[i] + yBar - yBarZero;}
 		}
 		double h (maxLoc);
 		double omega      = y*y*y/(h*h*h) - 0.6*y/h;
@@ -1396,6 +1396,8 @@ NDFiberSectionWarping2d::recvSelf(int commitTag, Channel &theChannel,
     
     yBar = Qz/A;
   }    
+
+  fiberGeometrySet = false;
   
   return res;
 }
@@ -1554,8 +1556,12 @@ int
 
 	// Check if it belongs to the section integration
 	else if (strstr(argv[0],"integration") != 0) {
-		if (sectionIntegr != 0)
-			return sectionIntegr->setParameter(&argv[1], argc-1, param);
+		if (sectionIntegr != 0) {
+			result = sectionIntegr->setParameter(&argv[1], argc-1, param);
+			if (result != -1)
+				param.addObject(2, this);
+			return result;
+		}
 		else
 			return -1;
 	}
@@ -1570,8 +1576,10 @@ int
 
 	if (sectionIntegr != 0) {
 		ok = sectionIntegr->setParameter(argv, argc, param);
-		if (ok != -1)
+		if (ok != -1) {
 			result = ok;
+			param.addObject(2, this);
+		}
 	}
 
 	return result;
@@ -1584,6 +1592,10 @@ int
 	case 1:
 		alpha = info.theDouble;
 		return 0;
+	case 2:
+		// fiber locations or weights have changed in the section integration
+		fiberGeometrySet = false;
+		return 0;
 	default:
 		return -1;
 	}
@@ -1616,32 +1628,15 @@ const Vector &
 	static Vector sig_dAdh(2);
 	static Matrix tangent(2,2);
 
-	static double fiberLocs[10000];
-	static double fiberArea[10000];
-
-	if (sectionIntegr != 0) {
-		sectionIntegr->getFiberLocations(numFibers, fiberLocs);
-		sectionIntegr->getFiberWeights(numFibers, fiberArea);
-	}  
-	else {
-		for (int i = 0; i < numFibers; i++) {
-			fiberLocs[i] = matData[2*i];
-			fiberArea[i] = matData[2*i+1];
-		}
-	}
+	if (!fiberGeometrySet)
+		this->setFiberGeometry();
 
-	static double locsDeriv[10000];
-	static double areaDeriv[10000];
+	std::vector<double> locsDeriv(numFibers, 0.0);
+	std::vector<double> areaDeriv(numFibers, 0.0);
 
 	if (sectionIntegr != 0) {
-		sectionIntegr->getLocationsDeriv(numFibers, locsDeriv);  
-		sectionIntegr->getWeightsDeriv(numFibers, areaDeriv);
-	}
-	else {
-		for (int i = 0; i < numFibers; i++) {
-			locsDeriv[i] = 0.0;
-			areaDeriv[i] = 0.0;
-		}
+	  sectionIntegr->getLocationsDeriv(numFibers, locsDeriv.data());
+	  sectionIntegr->getWeightsDeriv(numFibers, areaDeriv.data());
 	}
 
 	double rootAlpha = 1.0;
@@ -1653,8 +1648,8 @@ const Vector &
 		drootAlphadh = 0.5/rootAlpha;
 
 	for (int i = 0; i < numFibers; i++) {
-		y = fiberLocs[i] - yBar;
-		A = fiberArea[i];
+		y = yFibers[i];
+		A = AFibers[i];
 
 		dsigdh = theMaterials[i]->getStressSensitivity(gradIndex,true);
 
@@ -1711,37 +1706,20 @@ const Matrix &
 	/*
 	double y, A, dydh, dAdh, tangent, dtangentdh;
 
-	static double fiberLocs[10000];
-	static double fiberArea[10000];
-
-	if (sectionIntegr != 0) {
-	sectionIntegr->getFiberLocations(numFibers, fiberLocs);
-	sectionIntegr->getFiberWeights(numFibers, fiberArea);
-	}  
-	else {
-	for (int i = 0; i < numFibers; i++) {
-	fiberLocs[i] = matData[2*i];
-	fiberArea[i] = matData[2*i+1];
-	}
-	}
+	if (!fiberGeometrySet)
+		this->setFiberGeometry();
 
-	static double locsDeriv[10000];
-	static double areaDeriv[10000];
+	std::vector<double> locsDeriv(numFibers, 0.0);
+	std::vector<double> areaDeriv(numFibers, 0.0);
 
 	if (sectionIntegr != 0) {
-	sectionIntegr->getLocationsDeriv(numFibers, locsDeriv);  
-	sectionIntegr->getWeightsDeriv(numFibers, areaDeriv);
-	}
-	else {
-	for (int i = 0; i < numFibers; i++) {
-	locsDeriv[i] = 0.0;
-	areaDeriv[i] = 0.0;
-	}
+	  sectionIntegr->getLocationsDeriv(numFibers, locsDeriv.data());
+	  sectionIntegr->getWeightsDeriv(numFibers, areaDeriv.data());
 	}
 
 	for (int i = 0; i < numFibers; i++) {
-	y = fiberLocs[i] - yBar;
-	A = fiberArea[i];
+	y = yFibers[i];
+	A = AFibers[i];
 	dydh = locsDeriv[i];
 	dAdh = areaDeriv[i];
 
@@ -1772,27 +1750,15 @@ int
 
 	dedh = defSens;
 
-	static double fiberLocs[10000];
-
-	if (sectionIntegr != 0)
-		sectionIntegr->getFiberLocations(numFibers, fiberLocs);
-	else {
-		for (int i = 0; i < numFibers; i++)
-			fiberLocs[i] = matData[2*i];
-	}
+	if (!fiberGeometrySet)
+		this->setFiberGeometry();
 
-	static double locsDeriv[10000];
-	static double areaDeriv[10000];
+	std::vector<double> locsDeriv(numFibers, 0.0);
+	std::vector<double> areaDeriv(numFibers, 0.0);
 
 	if (sectionIntegr != 0) {
-		sectionIntegr->getLocationsDeriv(numFibers, locsDeriv);  
-		sectionIntegr->getWeightsDeriv(numFibers, areaDeriv);
-	}
-	else {
-		for (int i = 0; i < numFibers; i++) {
-			locsDeriv[i] = 0.0;
-			areaDeriv[i] = 0.0;
-		}
+	  sectionIntegr->getLocationsDeriv(numFibers, locsDeriv.data());
+	  sectionIntegr->getWeightsDeriv(numFibers, areaDeriv.data());
 	}
 
 	double y;
@@ -1815,7 +1781,7 @@ int
 
 	for (int i = 0; i < numFibers; i++) {
 		NDMaterial *theMat = theMaterials[i];
-		y = fiberLocs[i] - yBar;
+		y = yFibers[i];
 
 		// determine material strain and set it
 		depsdh(0) = d0 - y*d1 - locsDeriv[i]*kappa;
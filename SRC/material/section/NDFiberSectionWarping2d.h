@@ -100,6 +100,8 @@ class NDFiberSectionWarping2d : public SectionForceDeformation
   int numFibers,sizeFibers;                   // number of fibers in the section
     NDMaterial **theMaterials; // array of pointers to materials
     double   *matData;               // data for the materials [yloc and area]
+    double   *yFibers;               // fiber locations relative to yBar
+    double   *AFibers;               // fiber areas
     double   kData[25];               // data for ks matrix 
     double   sData[5];               // data for s vector 
     
@@ -108,11 +110,14 @@ class NDFiberSectionWarping2d : public SectionForceDeformation
 	
 	double yBarZero;
 	double DeltaYbar;
+    bool fiberGeometrySet;          // yFibers and AFibers are current
 
     SectionIntegration *sectionIntegr;
 
     static ID code;
 
+    void setFiberGeometry(void);    // fill yFibers and AFibers
+
     Vector e;          // trial section deformations
     Vector eCommit;    // committed section deformations 
     Vector *s;         // section resisting forces  (axial force, bending moment)
@@ -96,6 +96,10 @@ class SectionForceDeformation : public Material
   virtual SectionForceDeformation *getCopy (void) = 0;
   virtual const ID &getType (void) = 0;
   virtual int getOrder (void) const = 0;
+
+  // true if different sections may be updated concurrently, i.e. the
+  // section and its materials use no class-wide work storage
+  virtual bool isThreadSafe(void) {return false;};
   
   virtual Response *setResponse(const char **argv, int argc, OPS_Stream &s);
   virtual int getResponse(int responseID, Information &info);
@@ -278,6 +278,20 @@ Concrete01::setTrial (double strain, double &stress, double &tangent, double str
   return 0;
 }
 
+int
+Concrete01::setTrialBatch(int numMaterials, UniaxialMaterial **theMaterials,
+		       const double *strain, double *stress, double *tangent)
+{
+  // all the materials are Concrete01 objects, so skip the virtual dispatch
+  int res = 0;
+  for (int i = 0; i < numMaterials; i++) {
+    Concrete01 *theMaterial = static_cast<Concrete01 *>(theMaterials[i]);
+    res += theMaterial->Concrete01::setTrial(strain[i], stress[i], tangent[i]);
+  }
+
+  return res;
+}
+
 void Concrete01::determineTrialState (double dStrain)
 {  
   TminStrain = CminStrain;
@@ -289,6 +289,22 @@ Concrete02::getTangent(void)
   return e;
 }
 
+int
+Concrete02::setTrialBatch(int numMaterials, UniaxialMaterial **theMaterials,
+		       const double *strain, double *stress, double *tangent)
+{
+  // all the materials are Concrete02 objects, so skip the virtual dispatch
+  int res = 0;
+  for (int i = 0; i < numMaterials; i++) {
+    Concrete02 *theMaterial = static_cast<Concrete02 *>(theMaterials[i]);
+    res += theMaterial->Concrete02::setTrialStrain(strain[i]);
+    stress[i] = theMaterial->sig;
+    tangent[i] = theMaterial->e;
+  }
+
+  return res;
+}
+
 int 
 Concrete02::commitState(void)
 {
@@ -60,6 +60,7 @@ class ElasticMaterial : public UniaxialMaterial
     int commitState(void);
     int revertToLastCommit(void);    
     int revertToStart(void);        
+    bool isThreadSafe(void) {return true;}
 
     UniaxialMaterial *getCopy(void);
     
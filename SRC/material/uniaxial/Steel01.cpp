@@ -202,6 +202,19 @@ int Steel01::setTrial (double strain, double &stress, double &tangent, double st
    return 0;
 }
 
+int Steel01::setTrialBatch(int numMaterials, UniaxialMaterial **theMaterials,
+		       const double *strain, double *stress, double *tangent)
+{
+  // all the materials are Steel01 objects, so skip the virtual dispatch
+  int res = 0;
+  for (int i = 0; i < numMaterials; i++) {
+    Steel01 *theMaterial = static_cast<Steel01 *>(theMaterials[i]);
+    res += theMaterial->Steel01::setTrial(strain[i], stress[i], tangent[i]);
+  }
+
+  return res;
+}
+
 void Steel01::determineTrialState (double dStrain)
 {
       double fyOneMinusB = fy * (1.0 - b);
@@ -392,6 +392,22 @@ Steel02::getTangent(void)
   return e;
 }
 
+int
+Steel02::setTrialBatch(int numMaterials, UniaxialMaterial **theMaterials,
+		       const double *strain, double *stress, double *tangent)
+{
+  // all the materials are Steel02 objects, so skip the virtual dispatch
+  int res = 0;
+  for (int i = 0; i < numMaterials; i++) {
+    Steel02 *theMaterial = static_cast<Steel02 *>(theMaterials[i]);
+    res += theMaterial->Steel02::setTrialStrain(strain[i]);
+    stress[i] = theMaterial->sig;
+    tangent[i] = theMaterial->e;
+  }
+
+  return res;
+}
+
 int 
 Steel02::commitState(void)
 {
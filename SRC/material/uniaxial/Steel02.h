@@ -68,6 +68,8 @@ class Steel02 : public UniaxialMaterial
     UniaxialMaterial *getCopy(void);
 
     int setTrialStrain(double strain, double strainRate = 0.0); 
+    int setTrialBatch(int numMaterials, UniaxialMaterial **theMaterials,
+		      const double *strain, double *stress, double *tangent);
     double getStrain(void);      
     double getStress(void);
     double getTangent(void);
@@ -75,6 +77,7 @@ class Steel02 : public UniaxialMaterial
     int commitState(void);
     int revertToLastCommit(void);    
     int revertToStart(void);        
+    bool isThreadSafe(void) {return true;}
     
     int sendSelf(int commitTag, Channel &theChannel);  
     int recvSelf(int commitTag, Channel &theChannel, 
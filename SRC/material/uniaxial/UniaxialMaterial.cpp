@@ -162,6 +162,19 @@ UniaxialMaterial::setTrial(double strain, double temperature, double &stress, do
 }
 
 
+int
+UniaxialMaterial::setTrialBatch(int numMaterials, UniaxialMaterial **theMaterials,
+				const double *strain, double *stress, double *tangent)
+{
+  int res = 0;
+
+  for (int i = 0; i < numMaterials; i++)
+    res += theMaterials[i]->setTrial(strain[i], stress[i], tangent[i]);
+
+  return res;
+}
+
+
 // default operation for strain rate is zero
 double
 UniaxialMaterial::getStrainRate(void)
@@ -61,6 +61,12 @@ class UniaxialMaterial : public Material
     virtual int setTrial (double strain, double &stress, double &tangent, double strainRate = 0.0);
     virtual int setTrial (double strain, double temperature, double &stress, double &tangent, double &thermalElongation, double strainRate = 0.0);
 
+    // setTrial() for a group of materials which all have the class tag
+    // of this one, e.g. the fibers of a section; materials override it
+    // to update the whole group without a virtual call per material
+    virtual int setTrialBatch (int numMaterials, UniaxialMaterial **theMaterials,
+			       const double *strain, double *stress, double *tangent);
+
     virtual double getStrain (void) = 0;
     virtual double getStrainRate (void);
     virtual double getStress (void) = 0;
@@ -81,6 +87,10 @@ class UniaxialMaterial : public Material
     virtual int getResponse (int responseID, Information &matInformation);    
     virtual bool hasFailed(void) {return false;}
 
+    // true if setTrialStrain() and the get methods of different objects
+    // may be invoked concurrently, i.e. no class-wide work storage is used
+    virtual bool isThreadSafe(void) {return false;}
+
     // AddingSensitivity:BEGIN //////////////////////////////////////////
     virtual double getStressSensitivity     (int gradIndex, bool conditional);
     virtual double getStrainSensitivity     (int gradIndex);
@@ -0,0 +1,136 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: test of UniaxialMaterial::setTrialBatch(). For Steel01,
+// Steel02, Concrete01 and Concrete02 a group of copies is driven through
+// cyclic strain histories, each copy with a history of its own, once with
+// setTrialBatch() and once copy by copy with setTrialStrain(). Several
+// trial strains are set before each commit and some steps are reverted.
+// The stresses and tangents must be the same to the bit, e.g.
+//
+//      make batchTest; ./batchTest
+
+#include <Steel01.h>
+#include <Steel02.h>
+#include <Concrete01.h>
+#include <Concrete02.h>
+
+#include <OPS_Globals.h>
+#include <StandardStream.h>
+#include <elementAPI.h>
+
+#include <math.h>
+
+StandardStream sserr;
+OPS_Stream *opserrPtr = &sserr;
+
+// the command parsers of the materials refer to the interpreter, which
+// is not linked in; they are not invoked here
+int OPS_GetNumRemainingInputArgs() {return 0;}
+int OPS_GetIntInput(int *numData, int *data) {return -1;}
+int OPS_GetDoubleInput(int *numData, double *data) {return -1;}
+
+static const int numCopies = 7;
+static const int numSteps = 400;
+static const int numTrials = 3;
+
+// cyclic history of growing amplitude, shifted for each copy; the
+// concrete histories are mostly compressive
+static double
+strainHistory(int copy, int step, int trial, double scale, double offset)
+{
+  double t = 0.05*step + 0.9*copy;
+  double amplitude = scale*(0.2 + 0.01*step);
+  return offset*amplitude + amplitude*sin(t) + 0.05*scale*trial/numTrials;
+}
+
+static int
+check(const char *name, UniaxialMaterial &theMaterial, double scale, double offset)
+{
+  UniaxialMaterial *batch[numCopies];
+  UniaxialMaterial *single[numCopies];
+  for (int i = 0; i < numCopies; i++) {
+    batch[i] = theMaterial.getCopy();
+    single[i] = theMaterial.getCopy();
+  }
+
+  double strain[numCopies];
+  double stress[numCopies];
+  double tangent[numCopies];
+  int numErrors = 0;
+
+  for (int step = 0; step < numSteps && numErrors == 0; step++) {
+    for (int trial = 0; trial < numTrials; trial++) {
+      for (int i = 0; i < numCopies; i++)
+	strain[i] = strainHistory(i, step, trial, scale, offset);
+
+      batch[0]->setTrialBatch(numCopies, batch, strain, stress, tangent);
+
+      for (int i = 0; i < numCopies; i++) {
+	single[i]->setTrialStrain(strain[i]);
+	if (single[i]->getStress() != stress[i] || single[i]->getTangent() != tangent[i] ||
+	    batch[i]->getStress() != stress[i] || batch[i]->getTangent() != tangent[i]) {
+	  opserr << name << ": copy " << i << " step " << step << " trial " << trial
+		 << " strain " << strain[i] << " batch " << stress[i] << " " << tangent[i]
+		 << " single " << single[i]->getStress() << " " << single[i]->getTangent() << endln;
+	  numErrors++;
+	}
+      }
+    }
+
+    // every fifth step is abandoned
+    for (int i = 0; i < numCopies; i++) {
+      if (step % 5 == 4) {
+	batch[i]->revertToLastCommit();
+	single[i]->revertToLastCommit();
+      } else {
+	batch[i]->commitState();
+	single[i]->commitState();
+      }
+    }
+  }
+
+  for (int i = 0; i < numCopies; i++) {
+    delete batch[i];
+    delete single[i];
+  }
+
+  opserr << (numErrors == 0 ? "PASSED " : "FAILED ") << name << endln;
+  return numErrors;
+}
+
+int main(int argc, char **argv)
+{
+  int numErrors = 0;
+
+  Steel01 theSteel01(1, 60.0, 29000.0, 0.01, 0.1, 1.0, 0.1, 1.0);
+  numErrors += check("Steel01", theSteel01, 0.01, 0.0);
+
+  Steel02 theSteel02(2, 60.0, 29000.0, 0.01, 18.0, 0.925, 0.15, 0.1, 1.0, 0.1, 1.0);
+  numErrors += check("Steel02", theSteel02, 0.01, 0.0);
+
+  Concrete01 theConcrete01(3, -4.0, -0.002, -1.0, -0.006);
+  numErrors += check("Concrete01", theConcrete01, 0.004, -1.0);
+
+  Concrete02 theConcrete02(4, -4.0, -0.002, -1.0, -0.006, 0.1, 0.5, 200.0);
+  numErrors += check("Concrete02", theConcrete02, 0.004, -1.0);
+
+  return numErrors == 0 ? 0 : 1;
+}
@@ -44,13 +44,57 @@ using std::nothrow;
 
 #include <math.h>
 
-int Matrix::sizeDoubleWork = MATRIX_WORK_AREA;
-int Matrix::sizeIntWork = INT_WORK_AREA;
 double Matrix::MATRIX_NOT_VALID_ENTRY =0.0;
-double *Matrix::matrixWork = 0;
-int    *Matrix::intWork =0;
 
-//double *Matrix::matrixWork = (double *)malloc(400*sizeof(double));
+// work areas used by Solve(), Invert() and addMatrixTripleProduct(); there
+// is one set per thread so these methods can be invoked on different
+// objects concurrently. the areas only ever grow.
+namespace {
+  class MatrixWorkArea {
+  public:
+    MatrixWorkArea()
+      :matrixWork(0), intWork(0), sizeDoubleWork(0), sizeIntWork(0) {}
+
+    ~MatrixWorkArea() {
+      if (matrixWork != 0)
+	delete [] matrixWork;
+      if (intWork != 0)
+	delete [] intWork;
+    }
+
+    double *getDoubleWork(int size) {
+      if (size > sizeDoubleWork) {
+	if (matrixWork != 0)
+	  delete [] matrixWork;
+	if (size < MATRIX_WORK_AREA)
+	  size = MATRIX_WORK_AREA;
+	matrixWork = new (nothrow) double[size];
+	sizeDoubleWork = (matrixWork != 0) ? size : 0;
+      }
+      return matrixWork;
+    }
+
+    int *getIntWork(int size) {
+      if (size > sizeIntWork) {
+	if (intWork != 0)
+	  delete [] intWork;
+	if (size < INT_WORK_AREA)
+	  size = INT_WORK_AREA;
+	intWork = new (nothrow) int[size];
+	sizeIntWork = (intWork != 0) ? size : 0;
+      }
+      return intWork;
+    }
+
+  private:
+    double *matrixWork;
+    int *intWork;
+    int sizeDoubleWork;
+    int sizeIntWork;
+  };
+
+  thread_local MatrixWorkArea theWorkArea;
+}
 
 //
 // CONSTRUCTORS
@@ -59,15 +103,6 @@ int    *Matrix::intWork =0;
 Matrix::Matrix()
 :numRows(0), numCols(0), dataSize(0), data(0), fromFree(0)
 {
-  // allocate work areas if the first
-  if (matrixWork == 0) {
-    matrixWork = new (nothrow) double[sizeDoubleWork];
-    intWork = new (nothrow) int[sizeIntWork];
-    if (matrixWork == 0 || intWork == 0) {
-      opserr << "WARNING: Matrix::Matrix() - out of memory creating work area's\n";
-      exit(-1);
-    }
-  }
 }
 
 
@@ -75,15 +110,6 @@ Matrix::Matrix(int nRows,int nCols)
 :numRows(nRows), numCols(nCols), dataSize(0), data(0), fromFree(0)
 {
 
-  // allocate work areas if the first matrix
-  if (matrixWork == 0) {
-    matrixWork = new (nothrow) double[sizeDoubleWork];
-    intWork = new (nothrow) int[sizeIntWork];
-    if (matrixWork == 0 || intWork == 0) {
-      opserr << "WARNING: Matrix::Matrix() - out of memory creating work area's\n";
-      exit(-1);
-    }
-  }
 
 #ifdef _G3DEBUG
     if (nRows < 0) {
@@ -119,15 +145,6 @@ Matrix::Matrix(int nRows,int nCols)
 Matrix::Matrix(double *theData, int row, int col) 
 :numRows(row),numCols(col),dataSize(row*col),data(theData),fromFree(1)
 {
-  // allocate work areas if the first matrix
-  if (matrixWork == 0) {
-    matrixWork = new (nothrow) double[sizeDoubleWork];
-    intWork = new (nothrow) int[sizeIntWork];
-    if (matrixWork == 0 || intWork == 0) {
-      opserr << "WARNING: Matrix::Matrix() - out of memory creating work area's\n";
-      exit(-1);
-    }
-  }
 
 #ifdef _G3DEBUG
     if (row < 0) {
@@ -148,15 +165,6 @@ Matrix::Matrix(double *theData, int row, int col)
 Matrix::Matrix(const Matrix &other)
 :numRows(0), numCols(0), dataSize(0), data(0), fromFree(0)
 {
-  // allocate work areas if the first matrix
-  if (matrixWork == 0) {
-    matrixWork = new (nothrow) double[sizeDoubleWork];
-    intWork = new (nothrow) int[sizeIntWork];
-    if (matrixWork == 0 || intWork == 0) {
-      opserr << "WARNING: Matrix::Matrix() - out of memory creating work area's\n";
-      exit(-1);
-    }
-  }
 
     numRows = other.numRows;
     numCols = other.numCols;
@@ -386,38 +394,12 @@ Matrix::Solve(const Vector &b, Vector &x) const
     }
 #endif
     
-    // check work area can hold all the data
-    if (dataSize > sizeDoubleWork) {
-
-      if (matrixWork != 0) {
-	delete [] matrixWork;
-        matrixWork = 0;
-      }
-      matrixWork = new (nothrow) double[dataSize];
-      sizeDoubleWork = dataSize;
-      
-      if (matrixWork == 0) {
-	opserr << "WARNING: Matrix::Solve() - out of memory creating work area's\n";
-	sizeDoubleWork = 0;      
-	return -3;
-      }
-    }
-
-    // check work area can hold all the data
-    if (n > sizeIntWork) {
-
-      if (intWork != 0) {
-	delete [] intWork;
-        intWork = 0;
-      }
-      intWork = new (nothrow) int[n];
-      sizeIntWork = n;
-      
-      if (intWork == 0) {
-	opserr << "WARNING: Matrix::Solve() - out of memory creating work area's\n";
-	sizeIntWork = 0;      
-	return -3;
-      }
+    // get work areas that can hold all the data
+    double *matrixWork = theWorkArea.getDoubleWork(dataSize);
+    int *intWork = theWorkArea.getIntWork(n);
+    if (matrixWork == 0 || intWork == 0) {
+      opserr << "WARNING: Matrix::Solve() - out of memory creating work area's\n";
+      return -3;
     }
 
     
@@ -479,38 +461,12 @@ Matrix::Solve(const Matrix &b, Matrix &x) const
     }
 #endif
 
-    // check work area can hold all the data
-    if (dataSize > sizeDoubleWork) {
-
-      if (matrixWork != 0) {
-	delete [] matrixWork;
-        matrixWork = 0;
-      }
-      matrixWork = new (nothrow) double[dataSize];
-      sizeDoubleWork = dataSize;
-      
-      if (matrixWork == 0) {
-	opserr << "WARNING: Matrix::Solve() - out of memory creating work area's\n";
-	sizeDoubleWork = 0;      
-	return -3;
-      }
-    }
-
-    // check work area can hold all the data
-    if (n > sizeIntWork) {
-
-      if (intWork != 0) {
-	delete [] intWork;
-        intWork = 0;
-      }
-      intWork = new (nothrow) int[n];
-      sizeIntWork = n;
-      
-      if (intWork == 0) {
-	opserr << "WARNING: Matrix::Solve() - out of memory creating work area's\n";
-	sizeIntWork = 0;      
-	return -3;
-      }
+    // get work areas that can hold all the data
+    double *matrixWork = theWorkArea.getDoubleWork(dataSize);
+    int *intWork = theWorkArea.getIntWork(n);
+    if (matrixWork == 0 || intWork == 0) {
+      opserr << "WARNING: Matrix::Solve() - out of memory creating work area's\n";
+      return -3;
     }
     
     x = b;
@@ -576,38 +532,12 @@ Matrix::Invert(Matrix &theInverse) const
     }
 #endif
 
-    // check work area can hold all the data
-    if (dataSize > sizeDoubleWork) {
-
-      if (matrixWork != 0) {
-	delete [] matrixWork;
-        matrixWork = 0;
-      }
-      matrixWork = new (nothrow) double[dataSize];
-      sizeDoubleWork = dataSize;
-      
-      if (matrixWork == 0) {
-	opserr << "WARNING: Matrix::Solve() - out of memory creating work area's\n";
-	sizeDoubleWork = 0;      
-	return -3;
-      }
-    }
-
-    // check work area can hold all the data
-    if (n > sizeIntWork) {
-
-      if (intWork != 0) {
-	delete [] intWork;
-        intWork = 0;
-      }
-      intWork = new (nothrow) int[n];
-      sizeIntWork = n;
-      
-      if (intWork == 0) {
-	opserr << "WARNING: Matrix::Solve() - out of memory creating work area's\n";
-	sizeIntWork = 0;      
-	return -3;
-      }
+    // get work areas that can hold all the data
+    double *matrixWork = theWorkArea.getDoubleWork(dataSize);
+    int *intWork = theWorkArea.getIntWork(n);
+    if (matrixWork == 0 || intWork == 0) {
+      opserr << "WARNING: Matrix::Invert() - out of memory creating work area's\n";
+      return -3;
     }
     
     // copy the data
@@ -620,7 +550,7 @@ Matrix::Invert(Matrix &theInverse) const
     int info;
     double *Wptr = matrixWork;
     double *Aptr = theInverse.data;
-    int workSize = sizeDoubleWork;
+    int workSize = dataSize;
     
     int *iPIV = intWork;
     
@@ -949,11 +879,12 @@ Matrix::addMatrixTripleProduct(double thisFact,
     }
 #endif
 
-    // cheack work area can hold the temporary matrix
+    // get a work area that can hold the temporary matrix
     int dimB = B.numCols;
     int sizeWork = dimB * numCols;
 
-    if (sizeWork > sizeDoubleWork) {
+    double *matrixWork = theWorkArea.getDoubleWork(sizeWork);
+    if (matrixWork == 0) {
       this->addMatrix(thisFact, T^B*T, otherFact);
       return 0;
     }
@@ -1048,10 +979,11 @@ Matrix::addMatrixTripleProduct(double thisFact,
     }
 #endif
 
-    // cheack work area can hold the temporary matrix
+    // get a work area that can hold the temporary matrix
     int sizeWork = B.numRows * numCols;
 
-    if (sizeWork > sizeDoubleWork) {
+    double *matrixWork = theWorkArea.getDoubleWork(sizeWork);
+    if (matrixWork == 0) {
       this->addMatrix(thisFact, A^B*C, otherFact);
       return 0;
     }
@@ -156,10 +156,6 @@ class Matrix
 
   private:
     static double MATRIX_NOT_VALID_ENTRY;
-    static double *matrixWork;
-    static int *intWork;
-    static int sizeDoubleWork;
-    static int sizeIntWork;
 
     int numRows;
     int numCols;
@@ -0,0 +1,195 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: stress test for the Matrix work areas. Solve(), Invert()
+// and addMatrixTripleProduct() are invoked on different objects from
+// many threads at once and the results are compared bitwise with those
+// obtained serially. Build with 'make threadTest'.
+
+#include "Vector.h"
+#include "ID.h"
+#include "Matrix.h"
+#include <OPS_Globals.h>
+#include <StandardStream.h>
+
+#include <thread>
+#include <vector>
+#include <string.h>
+
+StandardStream sserr;
+OPS_Stream *opserrPtr = &sserr;
+
+// sizes chosen so that some problems fit in the initial work area
+// and some force it to grow
+static const int sizes[] = {3, 6, 12, 24, 40};
+static const int numSizes = sizeof(sizes)/sizeof(int);
+
+struct Problem {
+  Matrix A;   // diagonally dominant, so nonsingular
+  Matrix B;   // symmetric
+  Matrix T;   // rectangular
+  Vector b;
+
+  Problem(int n, int seed)
+    :A(n,n), B(n,n), T(n,n+2), b(n)
+  {
+    unsigned int r = seed*7919 + 17;
+    for (int i=0; i<n; i++) {
+      for (int j=0; j<n; j++) {
+	r = r*1103515245 + 12345;
+	double v = ((r >> 8) % 2000)/1000.0 - 1.0;
+	A(i,j) = v;
+	B(i,j) += 0.5*v;
+	B(j,i) += 0.5*v;
+      }
+      A(i,i) += 2.0*n;
+      for (int j=0; j<n+2; j++) {
+	r = r*1103515245 + 12345;
+	T(i,j) = ((r >> 8) % 2000)/1000.0 - 1.0;
+      }
+      b(i) = i + 1.0;
+    }
+  }
+};
+
+struct Result {
+  Vector x;
+  Matrix inv;
+  Matrix ktt;
+  Matrix kabc;
+  int ok;
+};
+
+static void
+solveProblem(const Problem &p, Result &res)
+{
+  int n = p.A.noRows();
+  res.x.resize(n);
+  res.inv.resize(n,n);
+  res.ktt.resize(n+2,n+2);
+  res.kabc.resize(n+2,n+2);
+  res.ktt.Zero();
+  res.kabc.Zero();
+
+  res.ok = 0;
+  if (p.A.Solve(p.b, res.x) < 0)
+    res.ok = -1;
+  if (p.A.Invert(res.inv) < 0)
+    res.ok = -2;
+  if (res.ktt.addMatrixTripleProduct(0.0, p.T, p.B, 1.0) < 0)
+    res.ok = -3;
+  if (res.kabc.addMatrixTripleProduct(0.0, p.T, p.A, p.T, 1.0) < 0)
+    res.ok = -4;
+}
+
+static bool
+sameBits(const Matrix &a, const Matrix &b)
+{
+  if (a.noRows() != b.noRows() || a.noCols() != b.noCols())
+    return false;
+  for (int i=0; i<a.noRows(); i++)
+    for (int j=0; j<a.noCols(); j++) {
+      double aij = a(i,j);
+      double bij = b(i,j);
+      if (memcmp(&aij, &bij, sizeof(double)) != 0)
+	return false;
+    }
+  return true;
+}
+
+static bool
+sameBits(const Vector &a, const Vector &b)
+{
+  if (a.Size() != b.Size())
+    return false;
+  for (int i=0; i<a.Size(); i++) {
+    double ai = a(i);
+    double bi = b(i);
+    if (memcmp(&ai, &bi, sizeof(double)) != 0)
+      return false;
+  }
+  return true;
+}
+
+int main(int argc, char **argv)
+{
+  int numThreads = 8;
+  int numRepeats = 200;
+  if (argc > 1)
+    numThreads = atoi(argv[1]);
+  if (argc > 2)
+    numRepeats = atoi(argv[2]);
+
+  int numProblems = 4*numSizes;
+  std::vector<Problem *> problems;
+  for (int i=0; i<numProblems; i++)
+    problems.push_back(new Problem(sizes[i%numSizes], i));
+
+  // reference results, computed serially
+  std::vector<Result> reference(numProblems);
+  for (int i=0; i<numProblems; i++) {
+    solveProblem(*problems[i], reference[i]);
+    if (reference[i].ok != 0) {
+      opserr << "threadTest - serial solution of problem " << i << " failed\n";
+      return -1;
+    }
+  }
+
+  // every thread works through all the problems, each starting at a
+  // different one so that the sizes interleave across threads
+  std::vector<int> numFailed(numThreads, 0);
+  std::vector<std::thread> threads;
+  for (int t=0; t<numThreads; t++) {
+    threads.push_back(std::thread([&, t]() {
+      Result res;
+      for (int k=0; k<numRepeats; k++) {
+	for (int i=0; i<numProblems; i++) {
+	  int j = (i + t + k) % numProblems;
+	  solveProblem(*problems[j], res);
+	  if (res.ok != 0 ||
+	      !sameBits(res.x, reference[j].x) ||
+	      !sameBits(res.inv, reference[j].inv) ||
+	      !sameBits(res.ktt, reference[j].ktt) ||
+	      !sameBits(res.kabc, reference[j].kabc))
+	    numFailed[t]++;
+	}
+      }
+    }));
+  }
+  for (int t=0; t<numThreads; t++)
+    threads[t].join();
+
+  int totalFailed = 0;
+  for (int t=0; t<numThreads; t++)
+    totalFailed += numFailed[t];
+
+  for (int i=0; i<numProblems; i++)
+    delete problems[i];
+
+  if (totalFailed != 0) {
+    opserr << "threadTest - FAILED " << totalFailed << " of "
+	   << numThreads*numRepeats*numProblems << " solutions differ from serial\n";
+    return 1;
+  }
+
+  opserr << "threadTest - PASSED " << numThreads << " threads x "
+	 << numRepeats*numProblems << " solutions\n";
+  return 0;
+}
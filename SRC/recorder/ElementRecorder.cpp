@@ -49,8 +49,10 @@
 #include <DataFileStreamAdd.h>
 #include <XmlFileStream.h>
 #include <BinaryFileStream.h>
+#include <ColumnFileStream.h>
 #include <DatabaseStream.h>
 #include <TCP_Stream.h>
+#include <AsyncStream.h>
 
 #include <elementAPI.h>
 
@@ -78,6 +80,7 @@ OPS_ElementRecorder()
     const int DATA_STREAM_CSV = 5;
     const int TCP_STREAM = 6;
     const int DATA_STREAM_ADD = 7;
+    const int COLUMN_STREAM = 8;
 
     int eMode = STANDARD_STREAM;
 
@@ -89,6 +92,8 @@ OPS_ElementRecorder()
     int precision = 6;
 
     bool closeOnWrite = false;
+    bool doAsync = false;
+    bool singlePrecision = false;
 
     const char *inetAddr = 0;
     int inetPort;
@@ -126,6 +131,9 @@ OPS_ElementRecorder()
         else if (strcmp(option, "-closeOnWrite") == 0) {
             closeOnWrite = true;
         }
+        else if (strcmp(option, "-async") == 0) {
+            doAsync = true;
+        }
         else if (strcmp(option, "-csv") == 0) {
             if (OPS_GetNumRemainingInputArgs() > 0) {
                 filename = OPS_GetString();
@@ -157,6 +165,15 @@ OPS_ElementRecorder()
             }
             eMode = BINARY_STREAM;
         }
+        else if (strcmp(option, "-columnFile") == 0) {
+            if (OPS_GetNumRemainingInputArgs() > 0) {
+                filename = OPS_GetString();
+            }
+            eMode = COLUMN_STREAM;
+        }
+        else if (strcmp(option, "-float") == 0) {
+            singlePrecision = true;
+        }
         else if (strcmp(option, "-dT") == 0) {
             if (OPS_GetNumRemainingInputArgs() > 0) {
                 int num = 1;
@@ -284,6 +301,8 @@ OPS_ElementRecorder()
     //    theOutputStream = new DatabaseStream(theDatabase, tableName);
     else if (eMode == BINARY_STREAM && filename != 0)
         theOutputStream = new BinaryFileStream(filename);
+    else if (eMode == COLUMN_STREAM && filename != 0)
+        theOutputStream = new ColumnFileStream(filename, OVERWRITE, singlePrecision);
     else if (eMode == TCP_STREAM && inetAddr != 0)
         theOutputStream = new TCP_Stream(inetPort, inetAddr);
     else
@@ -291,6 +310,10 @@ OPS_ElementRecorder()
 
     theOutputStream->setPrecision(precision);
 
+    // write the data from a separate thread
+    if (doAsync == true)
+        theOutputStream = new AsyncStream(theOutputStream);
+
     Domain* domain = OPS_GetDomain();
     if (domain == 0)
         return 0;
@@ -44,6 +44,7 @@
 #include <Vertex.h>
 #include <VertexIter.h>
 #include <mpi.h>
+#include <MPI_Channel.h>
 #endif
 
 #ifdef _PARALLEL_PROCESSING
@@ -942,6 +943,7 @@ GmshRecorder::write_element_graph()
         numvertex_proc[rank] = numvertex;
         // maxvertextag
         int maxvertextag_all;
+        MPI_Channel::flushAll();
         MPI_Allreduce(
             &maxvertextag,
             &maxvertextag_all,
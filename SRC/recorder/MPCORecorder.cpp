@@ -120,6 +120,7 @@ while opensees is writing data. Warning: this is a new feature in hdf5 version 1
 #ifdef _PARALLEL_PROCESSING
 extern bool OPS_PARTITIONED;
 #include <mpi.h>
+#include <MPI_Channel.h>
 #endif // _PARALLEL_PROCESSING
 
 /*************************************************************************************
@@ -4591,6 +4592,7 @@ int MPCORecorder::record(int commitTag, double timeStamp)
 		}
 		// get the maximum domain change stamp from all processes
 		int new_stamp_max = 0;
+		MPI_Channel::flushAll();
 		if (MPI_Allreduce(&new_stamp, &new_stamp_max, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD) != MPI_SUCCESS) {
 			opserr << "MPCORecorder::lambdaHasDomainChanged() Warning: MPI_Reduce failed to get max domain changed stamp\n";
 			return new_stamp;
@@ -46,8 +46,10 @@
 #include <DataFileStreamAdd.h>
 #include <XmlFileStream.h>
 #include <BinaryFileStream.h>
+#include <ColumnFileStream.h>
 #include <DatabaseStream.h>
 #include <TCP_Stream.h>
+#include <AsyncStream.h>
 
 #include <elementAPI.h>
 
@@ -76,6 +78,7 @@ OPS_NodeRecorder()
     const int DATA_STREAM_CSV = 5;
     const int TCP_STREAM = 6;
     const int DATA_STREAM_ADD = 7;
+    const int COLUMN_STREAM = 8;
     
     int eMode = STANDARD_STREAM;
     
@@ -87,6 +90,8 @@ OPS_NodeRecorder()
     int precision = 6;
 
     bool closeOnWrite = false;
+    bool doAsync = false;
+    bool singlePrecision = false;
 
     const char *inetAddr = 0;
     int inetPort;
@@ -128,6 +133,9 @@ OPS_NodeRecorder()
         else if (strcmp(option, "-closeOnWrite") == 0) {
             closeOnWrite = true;
         }
+        else if (strcmp(option, "-async") == 0) {
+            doAsync = true;
+        }
         else if (strcmp(option, "-csv") == 0) {
             if (OPS_GetNumRemainingInputArgs() > 0) {
                 filename = OPS_GetString();
@@ -159,6 +167,15 @@ OPS_NodeRecorder()
             }
             eMode = BINARY_STREAM;
         }
+        else if (strcmp(option, "-columnFile") == 0) {
+            if (OPS_GetNumRemainingInputArgs() > 0) {
+                filename = OPS_GetString();
+            }
+            eMode = COLUMN_STREAM;
+        }
+        else if (strcmp(option, "-float") == 0) {
+            singlePrecision = true;
+        }
         else if (strcmp(option, "-dT") == 0) {
             if (OPS_GetNumRemainingInputArgs() > 0) {
                 int num = 1;
@@ -289,6 +306,8 @@ OPS_NodeRecorder()
     //    theOutputStream = new DatabaseStream(theDatabase, tableName);
     else if (eMode == BINARY_STREAM && filename != 0)
         theOutputStream = new BinaryFileStream(filename);
+    else if (eMode == COLUMN_STREAM && filename != 0)
+        theOutputStream = new ColumnFileStream(filename, OVERWRITE, singlePrecision);
     else if (eMode == TCP_STREAM && inetAddr != 0)
         theOutputStream = new TCP_Stream(inetPort, inetAddr);
     else
@@ -296,6 +315,10 @@ OPS_NodeRecorder()
 
     theOutputStream->setPrecision(precision);
 
+    // write the data from a separate thread
+    if (doAsync == true)
+        theOutputStream = new AsyncStream(theOutputStream);
+
     Domain* domain = OPS_GetDomain();
     if (domain == 0)
         return 0;
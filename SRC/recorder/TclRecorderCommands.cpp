@@ -91,9 +91,11 @@ extern void* OPS_NodeRecorderRMS();
  #include <DataFileStreamAdd.h>
  #include <XmlFileStream.h>
  #include <BinaryFileStream.h>
+#include <ColumnFileStream.h>
  #include <DatabaseStream.h>
  #include <DummyStream.h>
  #include <TCP_Stream.h>
+#include <AsyncStream.h>
 
  #include <packages.h>
  #include <elementAPI.h>
@@ -114,7 +116,7 @@ extern "C" int         OPS_ResetInputNoBuilder(ClientData clientData, Tcl_Interp
 
  static ExternalRecorderCommand *theExternalRecorderCommands = NULL;
 
-enum outputMode  {STANDARD_STREAM, DATA_STREAM, XML_STREAM, DATABASE_STREAM, BINARY_STREAM, DATA_STREAM_CSV, TCP_STREAM, DATA_STREAM_ADD};
+enum outputMode  {STANDARD_STREAM, DATA_STREAM, XML_STREAM, DATABASE_STREAM, BINARY_STREAM, DATA_STREAM_CSV, TCP_STREAM, DATA_STREAM_ADD, COLUMN_STREAM};
 
 
  #include <EquiSolnAlgo.h>
@@ -177,6 +179,8 @@ enum outputMode  {STANDARD_STREAM, DATA_STREAM, XML_STREAM, DATABASE_STREAM, BIN
        const char *inetAddr = 0;
        int inetPort;
        bool closeOnWrite = false;
+       bool doAsync = false;
+       bool singlePrecision = false;
        int writeBufferSize = 0;
        bool doScientific = false;
 
@@ -364,6 +368,10 @@ enum outputMode  {STANDARD_STREAM, DATA_STREAM, XML_STREAM, DATABASE_STREAM, BIN
 	 } else if (strcmp(argv[loc],"-closeOnWrite") == 0) {
 	   closeOnWrite = true;
 	   loc +=1;
+
+	 } else if (strcmp(argv[loc],"-async") == 0) {
+	   doAsync = true;
+	   loc +=1;
 	 }
      
 	 else if (strcmp(argv[loc],"-buffer") == 0 ||
@@ -431,6 +439,19 @@ enum outputMode  {STANDARD_STREAM, DATA_STREAM, XML_STREAM, DATABASE_STREAM, BIN
 	   loc += 2;
 	 }	    
 
+	 else if ((strcmp(argv[loc],"-columnFile") == 0)) {
+	   fileName = argv[loc+1];
+	   const char *pwd = getInterpPWD(interp);
+	   simulationInfo.addOutputFile(fileName, pwd);
+	   eMode = COLUMN_STREAM;
+	   loc += 2;
+	 }
+
+	 else if ((strcmp(argv[loc],"-float") == 0)) {
+	   singlePrecision = true;
+	   loc += 1;
+	 }
+
 	 else {
 	   // first unknown string then is assumed to start 
 	   // element response request starts
@@ -468,6 +489,8 @@ enum outputMode  {STANDARD_STREAM, DATA_STREAM, XML_STREAM, DATABASE_STREAM, BIN
 	 theOutputStream = new DatabaseStream(theDatabase, tableName);
        } else if (eMode == BINARY_STREAM && fileName != 0) {
 	 theOutputStream = new BinaryFileStream(fileName);
+       } else if (eMode == COLUMN_STREAM && fileName != 0) {
+	 theOutputStream = new ColumnFileStream(fileName, OVERWRITE, singlePrecision);
        } else if (eMode == TCP_STREAM && inetAddr != 0) {
 	 theOutputStream = new TCP_Stream(inetPort, inetAddr);
        } else 
@@ -475,6 +498,10 @@ enum outputMode  {STANDARD_STREAM, DATA_STREAM, XML_STREAM, DATABASE_STREAM, BIN
 
        theOutputStream->setPrecision(precision);
 
+       // write the data from a separate thread
+       if (doAsync == true)
+	 theOutputStream = new AsyncStream(theOutputStream);
+
        if (strcmp(argv[1],"Element") == 0) {
 
 	 (*theRecorder) = new ElementRecorder(eleIDs, 
@@ -1124,6 +1151,8 @@ enum outputMode  {STANDARD_STREAM, DATA_STREAM, XML_STREAM, DATABASE_STREAM, BIN
        int inetPort;
 
        bool closeOnWrite = false;
+       bool doAsync = false;
+       bool singlePrecision = false;
        int writeBufferSize = 0;
 
 
@@ -1167,6 +1196,11 @@ enum outputMode  {STANDARD_STREAM, DATA_STREAM, XML_STREAM, DATABASE_STREAM, BIN
 	   pos += 1;
 	 }
 
+	 else if (strcmp(argv[pos],"-async") == 0)  {
+	   doAsync = true;
+	   pos += 1;
+	 }
+
 	 else if (strcmp(argv[pos],"-buffer") == 0 ||
        strcmp(argv[pos],"-bufferSize") == 0)  {
        pos++;
@@ -1223,6 +1257,19 @@ enum outputMode  {STANDARD_STREAM, DATA_STREAM, XML_STREAM, DATABASE_STREAM, BIN
 	   pos += 2;
 	 }	    
 
+	 else if ((strcmp(argv[pos],"-columnFile") == 0)) {
+	   fileName = argv[pos+1];
+	   const char *pwd = getInterpPWD(interp);
+	   simulationInfo.addOutputFile(fileName, pwd);
+	   eMode = COLUMN_STREAM;
+	   pos += 2;
+	 }
+
+	 else if ((strcmp(argv[pos],"-float") == 0)) {
+	   singlePrecision = true;
+	   pos += 1;
+	 }
+
 
 	 else if (strcmp(argv[pos],"-dT") == 0) {
 	   pos ++;
@@ -1411,6 +1458,8 @@ enum outputMode  {STANDARD_STREAM, DATA_STREAM, XML_STREAM, DATABASE_STREAM, BIN
 	 theOutputStream = new DatabaseStream(theDatabase, tableName);
        } else if (eMode == BINARY_STREAM && fileName != 0) {
 	 theOutputStream = new BinaryFileStream(fileName);
+       } else if (eMode == COLUMN_STREAM && fileName != 0) {
+	 theOutputStream = new ColumnFileStream(fileName, OVERWRITE, singlePrecision);
        } else if (eMode == TCP_STREAM && inetAddr != 0) {
 	 theOutputStream = new TCP_Stream(inetPort, inetAddr);
        } else {
@@ -1419,6 +1468,10 @@ enum outputMode  {STANDARD_STREAM, DATA_STREAM, XML_STREAM, DATABASE_STREAM, BIN
 
        theOutputStream->setPrecision(precision);
 
+       // write the data from a separate thread
+       if (doAsync == true)
+	 theOutputStream = new AsyncStream(theOutputStream);
+
        if (theTimeSeries != 0 && theTimeSeriesID.Size() < theDofs.Size()) {
 	 opserr << "ERROR: recorder Node/EnvelopNode # TimeSeries must equal # dof - IGNORING TimeSeries OPTION\n";
 	 for (int i=0; i<theTimeSeriesID.Size(); i++) {
@@ -1499,6 +1552,7 @@ enum outputMode  {STANDARD_STREAM, DATA_STREAM, XML_STREAM, DATABASE_STREAM, BIN
        int precision = 6;
        bool doScientific = false;
        bool closeOnWrite = false;
+       bool singlePrecision = false;
 
        while (pos < argc) {
 
@@ -1547,6 +1601,19 @@ enum outputMode  {STANDARD_STREAM, DATA_STREAM, XML_STREAM, DATABASE_STREAM, BIN
 	   pos += 2;
 	 }	    
 
+	 else if ((strcmp(argv[pos],"-columnFile") == 0)) {
+	   fileName = argv[pos+1];
+	   const char *pwd = getInterpPWD(interp);
+	   simulationInfo.addOutputFile(fileName, pwd);
+	   eMode = COLUMN_STREAM;
+	   pos += 2;
+	 }
+
+	 else if ((strcmp(argv[pos],"-float") == 0)) {
+	   singlePrecision = true;
+	   pos += 1;
+	 }
+
 	 else if ((strcmp(argv[pos],"-nees") == 0) || (strcmp(argv[pos],"-xml") == 0)) {
 	   // allow user to specify load pattern other than current
 	   fileName = argv[pos+1];
@@ -1660,6 +1727,8 @@ enum outputMode  {STANDARD_STREAM, DATA_STREAM, XML_STREAM, DATABASE_STREAM, BIN
 	 theOutputStream = new DatabaseStream(theDatabase, tableName);
        } else if (eMode == BINARY_STREAM) {
 	 theOutputStream = new BinaryFileStream(fileName);
+       } else if (eMode == COLUMN_STREAM && fileName != 0) {
+	 theOutputStream = new ColumnFileStream(fileName, OVERWRITE, singlePrecision);
        } else
 	 theOutputStream = new StandardStream();
 
@@ -36,6 +36,8 @@
 #include <NatafProbabilityTransformation.h>
 #include <RandomNumberGenerator.h>
 #include <RandomVariable.h>
+#include <LimitStateFunction.h>
+#include <Parameter.h>
 //#include <RandomVariablePositioner.h>
 #include <NormalRV.h>
 #include <Vector.h>
@@ -45,8 +47,17 @@
 #include <string.h>
 #include <fstream>
 #include <iostream>
+#include <iomanip>
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <poll.h>
+#include <errno.h>
+#include <sys/wait.h>
+#endif
 
 using std::ifstream;
+using std::ofstream;
 using std::ios;
 
 //using std::ios;
@@ -59,7 +70,11 @@ MonteCarloResponseAnalysis::MonteCarloResponseAnalysis(
 						int passedPrintFlag,
 						TCL_Char *passedFileName,
 						TCL_Char *pTclFileToRunFileName,
-						int pSeed
+						int pSeed,
+						Domain *passedOpenSeesDomain,
+						FunctionEvaluator *passedGFunEvaluator,
+						int pNumProcs,
+						double pTargetCOV
 						)
 {
 	theReliabilityDomain = passedReliabilityDomain;
@@ -77,6 +92,12 @@ MonteCarloResponseAnalysis::MonteCarloResponseAnalysis(
 	}
 	else tclFileToRun = 0;
 
+	theOpenSeesDomain = passedOpenSeesDomain;
+	theGFunEvaluator = passedGFunEvaluator;
+	numProcs = pNumProcs;
+	targetCOV = pTargetCOV;
+	isFirstSimulation = true;
+	numSamples = 0;
 }
 
 
@@ -86,22 +107,343 @@ MonteCarloResponseAnalysis::~MonteCarloResponseAnalysis()
 	if (tclFileToRun !=0) delete [] tclFileToRun;
 }
 
+
+int
+MonteCarloResponseAnalysis::runSample(int sample, Vector &x, Vector &g)
+{
+	int numRV = x.Size();
+	int result;
+
+	// Create array of standard normal random numbers
+	if (numProcs > 0) {
+		result = theRandomNumberGenerator->setStream(seed,sample);
+		if (result == 0)
+			result = theRandomNumberGenerator->generate_nIndependentStdNormalNumbers(numRV);
+	}
+	else {
+		if (isFirstSimulation) {
+			result = theRandomNumberGenerator->generate_nIndependentStdNormalNumbers(numRV,seed);
+		}
+		else {
+			result = theRandomNumberGenerator->generate_nIndependentStdNormalNumbers(numRV);
+		}
+		seed = theRandomNumberGenerator->getSeed();
+		isFirstSimulation = false;
+	}
+	if (result < 0) {
+		opserr << "MonteCarloResponseAnalysis::analyze() - could not generate" << endln
+			<< " random numbers for simulation." << endln;
+		return -1;
+	}
+
+	// Transform into original space
+	const Vector &u = theRandomNumberGenerator->getGeneratedNumbers();
+	result = theProbabilityTransformation->transform_u_to_x(u, x);
+	if (result < 0) {
+		opserr << "MonteCarloResponseAnalysis::analyze() - could not " << endln
+		       << " transform u to x. " << endln;
+		return -1;
+	}
+
+	// the sequential analysis only writes x and runs the tcl file, as
+	// before; the workers also evaluate the limit-state functions
+	if (numProcs == 0) {
+		if (tclFileToRun != 0) {
+			char theRevertToStartCommand[10] = "reset";
+			Tcl_Eval( theTclInterp, theRevertToStartCommand );
+			char theWipeAnalysis[15] = "wipeAnalysis";
+			Tcl_Eval( theTclInterp, theWipeAnalysis );
+
+			if(Tcl_EvalFile(theTclInterp, tclFileToRun) !=TCL_OK){
+				opserr<<"MonteCarloResponseAnalysis: the file "<<tclFileToRun<<" can not be run!"<<endln;
+				exit(-1);
+			}  //if
+		}  //if
+		return 0;
+	}
+
+	// --------------- update structure parameter -----------------
+	if (theOpenSeesDomain != 0) {
+		for (int j = 0; j < numRV; j++) {
+			int param_indx = theReliabilityDomain->getParameterIndexFromRandomVariableIndex(j);
+			Parameter *theParam = theOpenSeesDomain->getParameterFromIndex(param_indx);
+			if (theParam != 0)
+				theParam->update( x(j) );
+		}
+	}
+
+	if (theGFunEvaluator != 0 && theGFunEvaluator->setVariables() < 0) {
+		opserr << "MonteCarloResponseAnalysis::analyze() - " << endln
+		       << " could not set variables in namespace. " << endln;
+		return -1;
+	}
+
+	// ---------------------- run tcl file and  recorder ---------------------
+	bool FEconvergence = true;
+	if (tclFileToRun != 0) {
+		char theRevertToStartCommand[10] = "reset";
+		Tcl_Eval( theTclInterp, theRevertToStartCommand );
+		char theWipeAnalysis[15] = "wipeAnalysis";
+		Tcl_Eval( theTclInterp, theWipeAnalysis );
+
+		if(Tcl_EvalFile(theTclInterp, tclFileToRun) !=TCL_OK){
+			opserr<<"MonteCarloResponseAnalysis: the file "<<tclFileToRun<<" can not be run!"<<endln;
+			return -1;
+		}  //if
+
+	}  //if
+	else if (theGFunEvaluator != 0 && theGFunEvaluator->runAnalysis() < 0) {
+		// a failure of the analysis is registered as a failure
+		opserr << "WARNING MonteCarloResponseAnalysis::analyze() - error running analysis of sample " << sample << endln;
+		FEconvergence = false;
+	}
+
+	// ---------------------- limit-state functions ---------------------
+	for (int lsf = 0; lsf < g.Size(); lsf++) {
+		LimitStateFunction *theLimitStateFunction = theReliabilityDomain->getLimitStateFunctionPtrFromIndex(lsf);
+		theReliabilityDomain->setTagOfActiveLimitStateFunction(theLimitStateFunction->getTag());
+
+		theGFunEvaluator->setExpression(theLimitStateFunction->getExpression());
+		g(lsf) = theGFunEvaluator->evaluateExpression();
+		if (!FEconvergence)
+			g(lsf) = -1.0;
+	}
+
+	return 0;
+}
+
+
+// int runWorkers(int first, int last, ...);
+// Forks numProcs workers which run samples first to last-1 and send
+// back, for each sample, its number, the result of runSample(), x and g.
+// status is -1 for a sample not sent back.
+
+int
+MonteCarloResponseAnalysis::runWorkers(int first, int last, std::vector<Vector> &x, std::vector<Vector> &g, std::vector<int> &status)
+{
+	int numRV = theReliabilityDomain->getNumberOfRandomVariables();
+	int numLsf = numFailures.Size();
+	int numSamplesRun = last - first;
+
+	x.assign(numSamplesRun, Vector(numRV));
+	g.assign(numSamplesRun, Vector(numLsf));
+	status.assign(numSamplesRun, -1);
+
+#ifdef _WIN32
+	// no fork(), the samples are run here with the same seeds
+	for (int k = first; k < last; k++)
+		status[k-first] = this->runSample(k, x[k-first], g[k-first]);
+	return 0;
+#else
+	int numWorkers = (numProcs < numSamplesRun) ? numProcs : numSamplesRun;
+	int recordSize = 2 + numRV + numLsf;
+	std::vector<int> pipes;
+	std::vector<pid_t> workers;
+
+	// anything buffered would be written again by the workers
+	opserr.flush();
+	std::cout.flush();
+	std::cerr.flush();
+
+	for (int w = 0; w < numWorkers; w++) {
+		int fd[2];
+		if (pipe(fd) != 0) {
+			opserr << "MonteCarloResponseAnalysis::analyze() - could not create a pipe for a worker" << endln;
+			break;
+		}
+
+		pid_t pid = fork();
+		if (pid < 0) {
+			opserr << "MonteCarloResponseAnalysis::analyze() - could not fork a worker" << endln;
+			close(fd[0]);
+			close(fd[1]);
+			break;
+		}
+
+		if (pid == 0) {
+			// the worker, it exits without the clean up of the analysis
+			close(fd[0]);
+			Vector xs(numRV);
+			Vector gs(numLsf);
+			std::vector<double> record(recordSize);
+			for (int k = first + w; k < last; k += numWorkers) {
+				if (printFlag == 1 || printFlag == 2)
+					opserr << "Sample #" << k << ":" << endln;
+				int res = this->runSample(k, xs, gs);
+				record[0] = k;
+				record[1] = res;
+				for (int i = 0; i < numRV; i++)
+					record[2+i] = xs(i);
+				for (int i = 0; i < numLsf; i++)
+					record[2+numRV+i] = gs(i);
+
+				const char *data = (const char *)&record[0];
+				size_t numBytes = recordSize*sizeof(double);
+				while (numBytes > 0) {
+					ssize_t numWritten = write(fd[1], data, numBytes);
+					if (numWritten <= 0)
+						_exit(-1);
+					data += numWritten;
+					numBytes -= numWritten;
+				}
+				if (res < 0)
+					break;
+			}
+			close(fd[1]);
+			opserr.flush();
+			_exit(0);
+		}
+
+		close(fd[1]);
+		pipes.push_back(fd[0]);
+		workers.push_back(pid);
+	}
+
+	// the records are read as they arrive from any of the workers, so
+	// that none of them waits on a full pipe; a read may end inside a
+	// record, the rest of which comes later
+	size_t recordBytes = recordSize*sizeof(double);
+	std::vector<struct pollfd> fds(pipes.size());
+	std::vector<std::vector<char> > received(pipes.size());
+	for (size_t w = 0; w < pipes.size(); w++) {
+		fds[w].fd = pipes[w];
+		fds[w].events = POLLIN;
+	}
+
+	std::vector<double> record(recordSize);
+	char buffer[65536];
+	size_t numOpen = pipes.size();
+	while (numOpen > 0) {
+		if (poll(&fds[0], fds.size(), -1) < 0) {
+			if (errno == EINTR)
+				continue;
+			opserr << "MonteCarloResponseAnalysis::analyze() - could not poll the workers" << endln;
+			break;
+		}
+
+		for (size_t w = 0; w < fds.size(); w++) {
+			if (fds[w].fd < 0 || fds[w].revents == 0)
+				continue;
+
+			ssize_t numRead = read(fds[w].fd, buffer, sizeof(buffer));
+			if (numRead <= 0) {
+				if (numRead < 0 && errno == EINTR)
+					continue;
+				// the worker is done, poll() skips a negative fd
+				close(fds[w].fd);
+				fds[w].fd = -1;
+				numOpen--;
+				continue;
+			}
+
+			std::vector<char> &data = received[w];
+			data.insert(data.end(), buffer, buffer + numRead);
+			size_t pos = 0;
+			for (; pos + recordBytes <= data.size(); pos += recordBytes) {
+				memcpy(&record[0], &data[pos], recordBytes);
+				int k = (int)record[0] - first;
+				if (k < 0 || k >= numSamplesRun)
+					continue;
+				status[k] = (int)record[1];
+				for (int i = 0; i < numRV; i++)
+					x[k](i) = record[2+i];
+				for (int i = 0; i < numLsf; i++)
+					g[k](i) = record[2+numRV+i];
+			}
+			data.erase(data.begin(), data.begin() + pos);
+		}
+	}
+
+	for (size_t w = 0; w < fds.size(); w++)
+		if (fds[w].fd >= 0)
+			close(fds[w].fd);
+
+	for (size_t w = 0; w < workers.size(); w++)
+		waitpid(workers[w], 0, 0);
+
+	if ((int)workers.size() != numWorkers)
+		return -1;
+
+	return 0;
+#endif
+}
+
+
+int
+MonteCarloResponseAnalysis::addSample(int sample, const Vector &x, const Vector &g, ofstream &resultsOutputFile, ofstream &gFunOutputFile)
+{
+      // ------ here recorder x ----
+	resultsOutputFile.precision(15);
+	for (int ii=0;ii<x.Size();ii++)
+	   resultsOutputFile << x(ii)<<endln ;
+
+	int numLsf = g.Size();
+	if (numLsf == 0)
+		return 0;
+
+	numSamples++;
+	for (int lsf = 0; lsf < numLsf; lsf++) {
+		if (g(lsf) < 0.0)
+			numFailures(lsf) += 1.0;
+		gFunOutputFile << std::setiosflags(ios::scientific) << std::setprecision(6) << g(lsf) << "  ";
+	}
+	gFunOutputFile << endln;
+
+	// Keep the user posted
+	if (printFlag == 1 || printFlag == 2) {
+		for (int lsf = 0; lsf < numLsf; lsf++) {
+			double pf = numFailures(lsf)/numSamples;
+			double cov = (pf > 0.0) ? sqrt((1.0-pf)/(numSamples*pf)) : 0.0;
+			opserr << " Sample #" << sample << " GFun #" << theReliabilityDomain->getLimitStateFunctionPtrFromIndex(lsf)->getTag()
+			       << ", estimate: " << pf << ", cov: " << cov << endln;
+		}
+	}
+
+	return 0;
+}
+
+
+// the coefficient of variation of each estimate of a probability of
+// failure, with at least one failure, is below targetCOV
+bool
+MonteCarloResponseAnalysis::isConverged(void)
+{
+	int numLsf = numFailures.Size();
+	if (targetCOV <= 0.0 || numLsf == 0 || numSamples < 2)
+		return false;
+
+	for (int lsf = 0; lsf < numLsf; lsf++) {
+		double pf = numFailures(lsf)/numSamples;
+		if (pf <= 0.0 || sqrt((1.0-pf)/(numSamples*pf)) > targetCOV)
+			return false;
+	}
+
+	return true;
+}
+
+
 int MonteCarloResponseAnalysis::analyze(){
 
 
 	opserr << "Monte Carlo Response Analysis is running ... " << endln;
 	
 
-	int result;
 	int kk = 0;
-	bool isFirstSimulation = true;
-	//int seed = 1;
+	isFirstSimulation = true;
+
+	int numLsf = 0;
+	if (theGFunEvaluator != 0 && numProcs > 0)
+		numLsf = theReliabilityDomain->getNumberOfLimitStateFunctions();
+	numFailures.resize(numLsf);
+	numFailures.Zero();
+	numSamples = 0;
+
 	if (printFlag ==2) {
 	
 	  	 // check whether the restart file '_restart.tmp' exist, (this file is wrote by openSees only, not by user)
 		 //                      if yes, read data;{ success reading: set values above; otherwise: do noting} 
     	 //		                 if no, create file '_restart.tmp'
-	     //	data format:                 seed           numOfGFunEvaluations
+	     //	data format:                 seed           numOfGFunEvaluations     numOfFailures
 			
 	  ifstream inputFile( "_restart.tmp", ios::in );
 	  if (!inputFile) {
@@ -111,8 +453,11 @@ int MonteCarloResponseAnalysis::analyze(){
 	  else { 
 	    inputFile >> seed;
 	    inputFile >> kk;
+	    for (int lsf = 0; lsf < numLsf; lsf++)
+	      inputFile >> numFailures(lsf);
 	    inputFile.close();
 	    isFirstSimulation = false;
+	    numSamples = kk;
 	  }
 	  
 	}
@@ -120,156 +465,106 @@ int MonteCarloResponseAnalysis::analyze(){
 	int numRV = theReliabilityDomain->getNumberOfRandomVariables();
 
 	Vector x(numRV);
-
-	Vector u(numRV);
-	Vector randomArray(numRV);
-
-	ofstream *outputFile = 0;
+	Vector g(numLsf);
 
 
 	
-	// Prepare output file
-	ofstream resultsOutputFile( fileName, ios::out );
+	// Prepare output files, a restart of the workers adds to them
+	ios::openmode mode = (isFirstSimulation || numProcs == 0) ? ios::out : ios::app;
+	ofstream resultsOutputFile( fileName, mode );
+	ofstream gFunOutputFile;
+	if (numLsf > 0) {
+		char gFunFileName[40];
+		sprintf(gFunFileName,"%s.gFun",fileName);
+		gFunOutputFile.open(gFunFileName, mode);
+	}
 
+	// the samples of a round of workers, with a target cov the estimates
+	// are checked after each round
+	int numPerRound = numberOfSimulations;
+	if (numProcs > 0 && targetCOV > 0.0)
+		numPerRound = 16*numProcs;
 
+	std::vector<Vector> xs, gs;
+	std::vector<int> status;
 
-	while( kk< numberOfSimulations){ // && govCov>targetCOV || k<=2) ) {
+	bool converged = this->isConverged();
+	while( kk< numberOfSimulations && !converged){
 
-		// Keep the user posted
-		if (printFlag == 1 || printFlag == 2) {
-			opserr << "Sample #" << kk << ":" << endln;
-//			resultsOutputFile<< "Sample #" << kk << ":" << endln;
+		if (numProcs == 0) {
+			// Keep the user posted
+			if (printFlag == 1 || printFlag == 2) {
+				opserr << "Sample #" << kk << ":" << endln;
+			}
 
-		}
+			if (this->runSample(kk, x, g) < 0)
+				return -1;
 
-		
-		// Create array of standard normal random numbers
-		if (isFirstSimulation) {
-			result = theRandomNumberGenerator->generate_nIndependentStdNormalNumbers(numRV,seed);
+			this->addSample(kk, x, g, resultsOutputFile, gFunOutputFile);
+			kk++;
+			converged = this->isConverged();
 		}
 		else {
-			result = theRandomNumberGenerator->generate_nIndependentStdNormalNumbers(numRV);
-		}
-		seed = theRandomNumberGenerator->getSeed();
-		if (result < 0) {
-			opserr << "MonteCarloResponseAnalysis::analyze() - could not generate" << endln
-				<< " random numbers for simulation." << endln;
-			return -1;
-		}
-		randomArray = theRandomNumberGenerator->getGeneratedNumbers();
-
-
-		// Compute the point in standard normal space
-
-		
-		u = randomArray;   // Quan
-
-		// Transform into original space
-		/*
-		result = theProbabilityTransformation->set_u(u);
-		if (result < 0) {
-			opserr << "MonteCarloResponseAnalysis::analyze() - could not " << endln
-				<< " set the u-vector for xu-transformation. " << endln;
-			return -1;
-		}
-
-		
-		result = theProbabilityTransformation->transform_u_to_x();
-		if (result < 0) {
-			opserr << "MonteCarloResponseAnalysis::analyze() - could not " << endln
-				<< " transform u to x. " << endln;
-			return -1;
-		}
-		x = theProbabilityTransformation->get_x();
-		*/
-
-		int result = theProbabilityTransformation->transform_u_to_x(u, x);
-		if (result < 0) {
-			opserr << "MonteCarloResponseAnalysis::analyze() - could not " << endln
-			       << " transform u to x. " << endln;
-			return -1;
+			int last = kk + numPerRound;
+			if (last > numberOfSimulations || last < kk)
+				last = numberOfSimulations;
+
+			int res = this->runWorkers(kk, last, xs, gs, status);
+
+			// the samples are added in order, up to a failed one
+			int first = kk;
+			for (int k = first; k < last && !converged; k++) {
+				if (status[k-first] < 0) {
+					opserr << "MonteCarloResponseAnalysis::analyze() - sample " << k << " failed" << endln;
+					res = -1;
+					break;
+				}
+				this->addSample(k, xs[k-first], gs[k-first], resultsOutputFile, gFunOutputFile);
+				kk++;
+				converged = this->isConverged();
+			}
+
+			if (res < 0) {
+				resultsOutputFile.close();
+				return -1;
+			}
 		}
 
 
-      // ------ here recorder x ----
-//		opserr << "RV x is: " << x << endln;
-//		resultsOutputFile << "RV x is: " <<endln;
-		resultsOutputFile.precision(15);
-		for (int ii=0;ii<numRV;ii++)
-		   resultsOutputFile << x(ii)<<endln ;
-//		resultsOutputFile <<endln;
-
-
-		// --------------- update structure parameter -----------------
-		
-		// No longer using positioners -- MHS 4/2012
-		/*
-		int numberOfRandomVariablePositioners = theReliabilityDomain->getNumberOfRandomVariablePositioners();
-		RandomVariablePositioner *theRandomVariablePositioner;
-		int rvNumber;
-		//FMK
-		for (int i=1 ; i<=numberOfRandomVariablePositioners ; i++ )  {
-			theRandomVariablePositioner = theReliabilityDomain->getRandomVariablePositionerPtr(i);
-			rvNumber				= theRandomVariablePositioner->getRvIndex();
-			theRandomVariablePositioner->update(x(rvNumber));
-		}
-		*/
-
-		// ---------------------- run tcl file and  recorder ---------------------
-
-
-		if (tclFileToRun != 0) {     
-			char theRevertToStartCommand[10] = "reset";
-			Tcl_Eval( theTclInterp, theRevertToStartCommand );
-			char theWipeAnalysis[15] = "wipeAnalysis";
-			Tcl_Eval( theTclInterp, theWipeAnalysis );
-
-			if(Tcl_EvalFile(theTclInterp, tclFileToRun) !=TCL_OK){
-				opserr<<"MonteCarloResponseAnalysis: the file "<<tclFileToRun<<" can not be run!"<<endln;
-				exit(-1);
-			}  //if
-
-		}  //if
-
-		kk++;
-		isFirstSimulation = false;	
-
-
-
 		if (printFlag ==2){
  
 			// write necessary data into file '_restart.tmp' .... close file
 			ofstream resultsOutputFile5( "_restart.tmp");
 			resultsOutputFile5<< seed        <<endln;
 			resultsOutputFile5<< kk <<endln;
+			for (int lsf = 0; lsf < numLsf; lsf++)
+				resultsOutputFile5<< numFailures(lsf) <<endln;
 			
 			resultsOutputFile5.flush();
 			resultsOutputFile5.close();
 		}
 
-
-
-
-		
-		
 	}// while 
 		
 		
 	opserr << endln;
 
 
-	// Delete possible 'new' objects
-	if (outputFile != 0) {
-		delete outputFile;
-	}
-
-
 	// Print summary of results to screen 
 	opserr << "Simulation Analysis completed." << endln;
+	if (numLsf > 0) {
+		opserr << "Number of samples: " << numSamples << endln;
+		for (int lsf = 0; lsf < numLsf; lsf++) {
+			double pf = (numSamples > 0) ? numFailures(lsf)/numSamples : 0.0;
+			double cov = (pf > 0.0) ? sqrt((1.0-pf)/(numSamples*pf)) : 0.0;
+			opserr << "GFun #" << theReliabilityDomain->getLimitStateFunctionPtrFromIndex(lsf)->getTag()
+			       << ": failure probability " << pf << ", cov " << cov << endln;
+		}
+	}
 
 	// Clean up
 	resultsOutputFile.close();
-//	delete theMatrixOperations;
+	gFunOutputFile.close();
 
 	return 0;
 
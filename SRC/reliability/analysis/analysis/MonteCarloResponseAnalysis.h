@@ -1,5 +1,22 @@
 // MonteCarloResponseAnalysis.h: interface for the MonteCarloResponseAnalysis class.
 //
+// With numProcs > 0 the samples are run by numProcs worker processes,
+// forked from the current one so that each works on a copy of the
+// domain and interpreter as they are when analyze() is invoked. The
+// random numbers of a sample are then taken from the substream of the
+// generator given by the seed and the number of the sample, so the
+// results do not depend on the number of workers, and the results of
+// the workers are gathered and written in the order of the samples.
+// Files written by recorders in the tcl file are written by all the
+// workers at once.
+//
+// The workers also update the parameters from the random variables and,
+// with a FunctionEvaluator and limit-state functions, evaluate the
+// functions for each sample, write them to <fileName>.gFun and stop once
+// the coefficient of variation of each estimated probability of failure
+// is below targetCOV, if given. Without numProcs the samples are run as
+// before: x is written and the tcl file is run, nothing else.
+//
 //////////////////////////////////////////////////////////////////////
 
 #ifndef MONTECARLORESPONSEANALYSIS
@@ -8,9 +25,15 @@
 #include <ReliabilityDomain.h>
 #include <ProbabilityTransformation.h>
 #include <RandomNumberGenerator.h>
+#include <FunctionEvaluator.h>
+#include <Domain.h>
+#include <Vector.h>
+
+#include <fstream>
+#include <vector>
 
 
-class MonteCarloResponseAnalysis  
+class MonteCarloResponseAnalysis
 {
 public:
 	MonteCarloResponseAnalysis(ReliabilityDomain *passedReliabilityDomain,
@@ -21,7 +44,11 @@ public:
 						int printFlag,
 						TCL_Char *outputFileName,
 						TCL_Char *tclFileToRunFileName,
-						int seed
+						int seed,
+						Domain *passedOpenSeesDomain = 0,
+						FunctionEvaluator *passedGFunEvaluator = 0,
+						int numProcs = 0,
+						double targetCOV = 0.0
 						);
 
 
@@ -29,6 +56,11 @@ public:
 	int analyze();
 
 private:
+	int runSample(int sample, Vector &x, Vector &g);
+	int runWorkers(int first, int last, std::vector<Vector> &x, std::vector<Vector> &g, std::vector<int> &status);
+	int addSample(int sample, const Vector &x, const Vector &g, std::ofstream &resultsOutputFile, std::ofstream &gFunOutputFile);
+	bool isConverged(void);
+
 	ReliabilityDomain *theReliabilityDomain;
 	Tcl_Interp *theTclInterp;
 	ProbabilityTransformation *theProbabilityTransformation;
@@ -39,8 +71,15 @@ private:
 	char * tclFileToRun;
 	int seed;
 
+	Domain *theOpenSeesDomain;
+	FunctionEvaluator *theGFunEvaluator;
+	int numProcs;               // 0 if the samples share one random stream
+	double targetCOV;
+	bool isFirstSimulation;
 
-
+	// of the samples added, for the estimates of the failure probabilities
+	int numSamples;
+	Vector numFailures;
 };
 
-#endif 
+#endif
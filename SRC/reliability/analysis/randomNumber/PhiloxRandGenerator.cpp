@@ -0,0 +1,259 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 2001, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** Reliability module developed by:                                   **
+**   Terje Haukaas (haukaas@ce.berkeley.edu)                          **
+**   Armen Der Kiureghian (adk@ce.berkeley.edu)                       **
+**                                                                    **
+** ****************************************************************** */
+                                                                        
+// Description: This file contains the implementation of
+// PhiloxRandGenerator.
+
+#include <PhiloxRandGenerator.h>
+#include <math.h>
+#include <time.h>
+
+namespace {
+
+  const unsigned int M0 = 0xD2511F53;
+  const unsigned int M1 = 0xCD9E8D57;
+  const unsigned int W0 = 0x9E3779B9;
+  const unsigned int W1 = 0xBB67AE85;
+
+  // blocks worked on together, the rounds of the lanes are independent
+  // and are vectorized by the compiler
+  const int numLanes = 8;
+  const int bufferBlocks = 64;
+
+  const double twoPi = 6.283185307179586;
+
+  // 53 random bits of a and b, in (0,1)
+  inline double toUniform(unsigned int a, unsigned int b)
+  {
+    return ((a >> 5)*67108864.0 + (b >> 6) + 0.5)*(1.0/9007199254740992.0);
+  }
+}
+
+
+PhiloxRandGenerator::PhiloxRandGenerator(int passedSeed)
+:RandomNumberGenerator(), generatedNumbers(1)
+{
+	this->setSeed(passedSeed);
+}
+
+
+PhiloxRandGenerator::~PhiloxRandGenerator()
+{
+
+}
+
+
+void
+PhiloxRandGenerator::nextBlocks(unsigned int *out, int numBlocks)
+{
+	unsigned int c0[numLanes], c1[numLanes], c2[numLanes], c3[numLanes];
+
+	for (int first = 0; first < numBlocks; first += numLanes) {
+		for (int l = 0; l < numLanes; l++) {
+			unsigned long long n = position + l;
+			c0[l] = (unsigned int)n;
+			c1[l] = (unsigned int)(n >> 32);
+			c2[l] = stream;
+			c3[l] = 0;
+		}
+
+		unsigned int k0 = key[0];
+		unsigned int k1 = key[1];
+		for (int r = 0; r < 10; r++) {
+			for (int l = 0; l < numLanes; l++) {
+				unsigned long long p0 = (unsigned long long)M0*c0[l];
+				unsigned long long p1 = (unsigned long long)M1*c2[l];
+				unsigned int n0 = (unsigned int)(p1 >> 32) ^ c1[l] ^ k0;
+				unsigned int n2 = (unsigned int)(p0 >> 32) ^ c3[l] ^ k1;
+				c1[l] = (unsigned int)p1;
+				c3[l] = (unsigned int)p0;
+				c0[l] = n0;
+				c2[l] = n2;
+			}
+			k0 += W0;
+			k1 += W1;
+		}
+
+		int numDone = (numBlocks-first < numLanes) ? numBlocks-first : numLanes;
+		for (int l = 0; l < numDone; l++) {
+			unsigned int *block = out + 4*(first+l);
+			block[0] = c0[l];
+			block[1] = c1[l];
+			block[2] = c2[l];
+			block[3] = c3[l];
+		}
+		position += numDone;
+	}
+}
+
+
+// each block gives two uniform numbers, an odd one is not used
+void
+PhiloxRandGenerator::fillUniform(double *x, int n, double lower, double upper)
+{
+	unsigned int buffer[4*bufferBlocks];
+	double range = upper - lower;
+
+	for (int i = 0; i < n; ) {
+		int numBlocks = (n-i+1)/2;
+		if (numBlocks > bufferBlocks)
+			numBlocks = bufferBlocks;
+		this->nextBlocks(buffer, numBlocks);
+
+		for (int b = 0; b < numBlocks; b++) {
+			const unsigned int *block = buffer + 4*b;
+			x[i++] = lower + range*toUniform(block[0], block[1]);
+			if (i < n)
+				x[i++] = lower + range*toUniform(block[2], block[3]);
+		}
+	}
+}
+
+
+// each block gives a Box-Muller pair, an odd one is kept for the next
+void
+PhiloxRandGenerator::fillStdNormal(double *x, int n)
+{
+	unsigned int buffer[4*bufferBlocks];
+	int i = 0;
+
+	if (n > 0 && hasSpareNormal) {
+		x[i++] = spareNormal;
+		hasSpareNormal = false;
+	}
+
+	while (i < n) {
+		int numBlocks = (n-i+1)/2;
+		if (numBlocks > bufferBlocks)
+			numBlocks = bufferBlocks;
+		this->nextBlocks(buffer, numBlocks);
+
+		for (int b = 0; b < numBlocks; b++) {
+			const unsigned int *block = buffer + 4*b;
+			double r = sqrt(-2.0*log(toUniform(block[0], block[1])));
+			double theta = twoPi*toUniform(block[2], block[3]);
+			x[i++] = r*cos(theta);
+			if (i < n)
+				x[i++] = r*sin(theta);
+			else {
+				spareNormal = r*sin(theta);
+				hasSpareNormal = true;
+			}
+		}
+	}
+}
+
+
+int
+PhiloxRandGenerator::generate_nIndependentUniformNumbers(int n, double lower, double upper, int seedIn)
+{
+	if (n < 1)
+		return -1;
+
+	// set RNG seed if necessary
+	if (seedIn != 0)
+		this->setSeed(seedIn);
+
+	if (generatedNumbers.Size() != n)
+		generatedNumbers.resize(n);
+
+	this->fillUniform(&generatedNumbers(0), n, lower, upper);
+
+	return 0;
+}
+
+
+int
+PhiloxRandGenerator::generate_nIndependentStdNormalNumbers(int n, int seedIn)
+{
+	if (n < 1)
+		return -1;
+
+	// set RNG seed if necessary
+	if (seedIn != 0)
+		this->setSeed(seedIn);
+
+	if (generatedNumbers.Size() != n)
+		generatedNumbers.resize(n);
+
+	this->fillStdNormal(&generatedNumbers(0), n);
+
+	return 0;
+}
+
+
+const Vector&
+PhiloxRandGenerator::getGeneratedNumbers()
+{
+	return generatedNumbers;
+}
+
+
+int
+PhiloxRandGenerator::getSeed()
+{
+	return seed;
+}
+
+
+void
+PhiloxRandGenerator::setSeed(int passedSeed)
+{
+	if (passedSeed == 0)
+		passedSeed = time(NULL);
+
+	this->setStream(passedSeed, 0);
+}
+
+
+int
+PhiloxRandGenerator::setStream(int passedSeed, int passedStream)
+{
+	seed = passedSeed;
+	key[0] = (unsigned int)passedSeed;
+	key[1] = 0;
+	stream = (unsigned int)passedStream;
+	position = 0;
+	hasSpareNormal = false;
+
+	return 0;
+}
+
+
+double
+PhiloxRandGenerator::generate_singleUniformNumber(double lower, double upper)
+{
+	double x;
+	this->fillUniform(&x, 1, lower, upper);
+	return x;
+}
+
+
+double
+PhiloxRandGenerator::generate_singleStdNormalNumber(void)
+{
+	double x;
+	this->fillStdNormal(&x, 1);
+	return x;
+}
@@ -0,0 +1,78 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 2001, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** Reliability module developed by:                                   **
+**   Terje Haukaas (haukaas@ce.berkeley.edu)                          **
+**   Armen Der Kiureghian (adk@ce.berkeley.edu)                       **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the class definition for
+// PhiloxRandGenerator, a counter-based generator using the Philox4x32-10
+// function of Salmon et al. (2011). The n-th block of four 32 bit numbers
+// of a stream is the Philox function of the counter (n, stream) under the
+// key given by the seed, so that the generator has no state other than
+// the position in the stream: instances with the same seed and stream
+// give the same numbers whatever the thread or process, and the streams
+// of a seed are independent. Uniform numbers have 53 random bits and lie
+// in (0,1); standard normal numbers are formed from pairs of them with
+// the Box-Muller transformation.
+
+#ifndef PhiloxRandGenerator_h
+#define PhiloxRandGenerator_h
+
+#include <RandomNumberGenerator.h>
+#include <Vector.h>
+
+class PhiloxRandGenerator : public RandomNumberGenerator
+{
+
+public:
+	PhiloxRandGenerator(int seed = 0);
+	~PhiloxRandGenerator();
+
+	int		generate_nIndependentStdNormalNumbers(int n, int seed=0);
+	int     generate_nIndependentUniformNumbers(int n, double lower, double upper, int seed=0);
+	const   Vector& getGeneratedNumbers();
+	int     getSeed();
+
+	double  generate_singleStdNormalNumber();
+	double  generate_singleUniformNumber(double lower=0.0, double upper=1.0);
+	void    setSeed(int passedSeed=0);
+	int     setStream(int seed, int stream);
+
+	// bulk generation, continuing the stream
+	void    fillUniform(double *x, int n, double lower=0.0, double upper=1.0);
+	void    fillStdNormal(double *x, int n);
+
+protected:
+
+private:
+	void	nextBlocks(unsigned int *out, int numBlocks);
+
+	Vector generatedNumbers;
+	int seed;
+	unsigned int key[2];
+	unsigned int stream;
+	unsigned long long position;	// of the next block in the stream
+
+	double spareNormal;				// second number of a Box-Muller pair
+	bool hasSpareNormal;
+};
+
+#endif
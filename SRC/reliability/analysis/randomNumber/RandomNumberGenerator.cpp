@@ -42,3 +42,20 @@ RandomNumberGenerator::~RandomNumberGenerator()
 }
 
 
+// the base class seeds the generator with a seed mixed from seed and
+// stream, so that neighbouring streams get unrelated seeds
+int
+RandomNumberGenerator::setStream(int seed, int stream)
+{
+	unsigned long long z = ((unsigned long long)(unsigned int)seed << 32) + (unsigned int)stream;
+	z += 0x9e3779b97f4a7c15ULL;
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+	z = z ^ (z >> 31);
+
+	int streamSeed = (int)(z & 0x7fffffff);
+	if (streamSeed == 0)
+		streamSeed = 1;
+	this->setSeed(streamSeed);
+	return 0;
+}
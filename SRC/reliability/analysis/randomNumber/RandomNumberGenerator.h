@@ -53,6 +53,11 @@ public:
 	virtual double  generate_singleUniformNumber(double lower=0.0, double upper=1.0)=0;		
 	virtual void setSeed(int)=0;
 
+	// restarts the generator on substream stream of seed, e.g. the
+	// sample number of a simulation, so that the numbers of a sample do
+	// not depend on the samples generated before it
+	virtual int setStream(int seed, int stream);
+
 
 protected:
 
@@ -0,0 +1,113 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 2001, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** Reliability module developed by:                                   **
+**   Terje Haukaas (haukaas@ce.berkeley.edu)                          **
+**   Armen Der Kiureghian (adk@ce.berkeley.edu)                       **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: throughput of the random number generators. For bulks
+// of 10 to 100000 numbers it times generate_nIndependentStdNormalNumbers()
+// and generate_nIndependentUniformNumbers() of CStdLibRandGenerator and
+// PhiloxRandGenerator, and the bulk fill of PhiloxRandGenerator, for
+// numNumbers numbers in all (default 20,000,000), e.g.
+//
+//      make bench; ./bench 20000000
+
+#include <PhiloxRandGenerator.h>
+#include <CStdLibRandGenerator.h>
+#include <Vector.h>
+#include <OPS_Globals.h>
+#include <StandardStream.h>
+
+#include <stdlib.h>
+#include <chrono>
+#include <vector>
+
+StandardStream sserr;
+OPS_Stream *opserrPtr = &sserr;
+
+static double
+elapsed(std::chrono::steady_clock::time_point start)
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// millions of numbers per second
+static double
+bench(RandomNumberGenerator &theGenerator, int n, int numBulks, bool normal, double &check)
+{
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (int i = 0; i < numBulks; i++) {
+    if (normal)
+      theGenerator.generate_nIndependentStdNormalNumbers(n);
+    else
+      theGenerator.generate_nIndependentUniformNumbers(n, 0.0, 1.0);
+    check += theGenerator.getGeneratedNumbers()(n-1);
+  }
+  return 1.0e-6*n*numBulks/elapsed(start);
+}
+
+static double
+benchFill(PhiloxRandGenerator &theGenerator, int n, int numBulks, bool normal, double &check)
+{
+  std::vector<double> x(n);
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (int i = 0; i < numBulks; i++) {
+    if (normal)
+      theGenerator.fillStdNormal(x.data(), n);
+    else
+      theGenerator.fillUniform(x.data(), n);
+    check += x[n-1];
+  }
+  return 1.0e-6*n*numBulks/elapsed(start);
+}
+
+int main(int argc, char **argv)
+{
+  int numNumbers = 20000000;
+  if (argc > 1)
+    numNumbers = atoi(argv[1]);
+
+  CStdLibRandGenerator theCStdLib;
+  theCStdLib.setSeed(3);
+  PhiloxRandGenerator thePhilox(3);
+  double check = 0.0;
+
+  opserr << "million numbers per second, " << numNumbers << " numbers in bulks of n\n";
+  opserr << "      n  normal: CStdLib   Philox  fill   uniform: CStdLib   Philox  fill\n";
+
+  int sizes[] = {10, 1000, 100000};
+  for (int n : sizes) {
+    int numBulks = numNumbers/n;
+    if (numBulks < 1)
+      numBulks = 1;
+    double normalCStdLib = bench(theCStdLib, n, numBulks, true, check);
+    double normalPhilox = bench(thePhilox, n, numBulks, true, check);
+    double normalFill = benchFill(thePhilox, n, numBulks, true, check);
+    double uniformCStdLib = bench(theCStdLib, n, numBulks, false, check);
+    double uniformPhilox = bench(thePhilox, n, numBulks, false, check);
+    double uniformFill = benchFill(thePhilox, n, numBulks, false, check);
+    opserr << n << "  " << normalCStdLib << "  " << normalPhilox << "  " << normalFill
+	   << "   " << uniformCStdLib << "  " << uniformPhilox << "  " << uniformFill << endln;
+  }
+  opserr << "(check " << check << ")\n";
+
+  return 0;
+}
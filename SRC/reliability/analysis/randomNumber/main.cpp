@@ -0,0 +1,148 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 2001, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** Reliability module developed by:                                   **
+**   Terje Haukaas (haukaas@ce.berkeley.edu)                          **
+**   Armen Der Kiureghian (adk@ce.berkeley.edu)                       **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: checks of PhiloxRandGenerator: the known answer of the
+// Philox4x32-10 function for counter 0 and key 0 from the Random123
+// test vectors, the independence of the numbers from how they are
+// requested and the reproducibility of a stream, e.g.
+//
+//      make test; ./test
+
+#include <PhiloxRandGenerator.h>
+#include <Vector.h>
+#include <OPS_Globals.h>
+#include <StandardStream.h>
+
+#include <math.h>
+
+StandardStream sserr;
+OPS_Stream *opserrPtr = &sserr;
+
+// uniform number of PhiloxRandGenerator from two 32 bit words
+static double
+toUniform(unsigned int a, unsigned int b)
+{
+  return ((a >> 5)*67108864.0 + (b >> 6) + 0.5)*(1.0/9007199254740992.0);
+}
+
+int main(int argc, char **argv)
+{
+  int numErrors = 0;
+
+  // Philox4x32-10 of counter (0,0,0,0) under key (0,0) is
+  // 6627e8d5 e169c58d bc57ac4c 9b00dbd8, the first block of stream 0
+  PhiloxRandGenerator theGenerator;
+  theGenerator.setStream(0, 0);
+  double x[2];
+  theGenerator.fillUniform(x, 2);
+  if (x[0] != toUniform(0x6627e8d5, 0xe169c58d) ||
+      x[1] != toUniform(0xbc57ac4c, 0x9b00dbd8)) {
+    opserr << "known answer: got " << x[0] << " " << x[1] << endln;
+    numErrors++;
+  }
+
+  // the same numbers one at a time, in odd sized bulks and as a Vector
+  const int n = 1001;
+  double bulk[n];
+  theGenerator.setStream(7, 3);
+  theGenerator.fillStdNormal(bulk, n);
+
+  double pieces[n];
+  theGenerator.setStream(7, 3);
+  for (int i = 0; i < 3; i++)
+    pieces[i] = theGenerator.generate_singleStdNormalNumber();
+  theGenerator.fillStdNormal(pieces+3, 501);
+  theGenerator.fillStdNormal(pieces+504, n-504);
+
+  theGenerator.setStream(7, 3);
+  theGenerator.generate_nIndependentStdNormalNumbers(n);
+  const Vector &theNumbers = theGenerator.getGeneratedNumbers();
+
+  for (int i = 0; i < n; i++)
+    if (pieces[i] != bulk[i] || theNumbers(i) != bulk[i]) {
+      opserr << "normal number " << i << " depends on how it is requested\n";
+      numErrors++;
+      break;
+    }
+
+  // a stream does not depend on the streams used before it, and
+  // neighbouring streams differ
+  PhiloxRandGenerator other(99);
+  other.setStream(7, 2);
+  other.fillStdNormal(pieces, 100);
+  if (pieces[0] == bulk[0]) {
+    opserr << "streams 2 and 3 start with the same number\n";
+    numErrors++;
+  }
+  other.setStream(7, 3);
+  other.fillStdNormal(pieces, n);
+  for (int i = 0; i < n; i++)
+    if (pieces[i] != bulk[i]) {
+      opserr << "stream 3 is not reproduced\n";
+      numErrors++;
+      break;
+    }
+
+  // moments of the uniform and normal numbers
+  const int numSamples = 1000000;
+  double *samples = new double[numSamples];
+  theGenerator.setStream(12345, 0);
+  theGenerator.fillUniform(samples, numSamples);
+  double mean = 0.0;
+  for (int i = 0; i < numSamples; i++) {
+    if (samples[i] <= 0.0 || samples[i] >= 1.0) {
+      opserr << "uniform number " << samples[i] << " not in (0,1)\n";
+      numErrors++;
+      break;
+    }
+    mean += samples[i];
+  }
+  mean /= numSamples;
+  if (fabs(mean - 0.5) > 0.002) {
+    opserr << "uniform mean " << mean << endln;
+    numErrors++;
+  }
+
+  theGenerator.fillStdNormal(samples, numSamples);
+  mean = 0.0;
+  double variance = 0.0;
+  for (int i = 0; i < numSamples; i++)
+    mean += samples[i];
+  mean /= numSamples;
+  for (int i = 0; i < numSamples; i++)
+    variance += (samples[i] - mean)*(samples[i] - mean);
+  variance /= numSamples;
+  if (fabs(mean) > 0.005 || fabs(variance - 1.0) > 0.005) {
+    opserr << "normal mean " << mean << " variance " << variance << endln;
+    numErrors++;
+  }
+  delete [] samples;
+
+  if (numErrors == 0)
+    opserr << "PASSED PhiloxRandGenerator\n";
+  else
+    opserr << "FAILED PhiloxRandGenerator\n";
+
+  return numErrors == 0 ? 0 : 1;
+}
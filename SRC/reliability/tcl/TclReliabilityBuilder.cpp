@@ -102,6 +102,7 @@ using std::setiosflags;
 #include <SearchWithStepSizeAndStepDirection.h>
 #include <RandomNumberGenerator.h>
 #include <CStdLibRandGenerator.h>
+#include <PhiloxRandGenerator.h>
 #include <FindCurvatures.h>
 #include <FirstPrincipalCurvature.h>
 #include <CurvaturesBySearchAlgorithm.h>
@@ -2202,6 +2203,15 @@ TclReliabilityModelBuilder_addRandomNumberGenerator(ClientData clientData, Tcl_I
   if (strcmp(argv[1],"CStdLib") == 0) {
 	  theRandomNumberGenerator = new CStdLibRandGenerator();
   }
+  else if (strcmp(argv[1],"Philox") == 0) {
+	  // randomNumberGenerator Philox <seed>
+	  int seed = 0;
+	  if (argc > 2 && Tcl_GetInt(interp, argv[2], &seed) != TCL_OK) {
+		  opserr << "ERROR: invalid input: seed of Philox RandomNumberGenerator \n";
+		  return TCL_ERROR;
+	  }
+	  theRandomNumberGenerator = new PhiloxRandGenerator(seed);
+  }
   else {
 	opserr << "ERROR: unrecognized type of RandomNumberGenerator \n";
 	return TCL_ERROR;
@@ -5154,7 +5164,7 @@ TclReliabilityModelBuilder_printReliability(ClientData clientData, Tcl_Interp *i
 // ---------- Quan Gu ------------------------
 
 
-///Command:  runMonteCarloResponseAnalysis  -outPutFile  m.out -maxNum 1000 -print 1 -tclFileToRun test.tcl <-seed 1>
+///Command:  runMonteCarloResponseAnalysis  -outPutFile  m.out -maxNum 1000 -print 1 -tclFileToRun test.tcl <-seed 1> <-numProcs 4> <-targetCOV 0.05>
 int 
 TclReliabilityModelBuilder_runMonteCarloResponseAnalysis(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
 {
@@ -5183,7 +5193,7 @@ TclReliabilityModelBuilder_runMonteCarloResponseAnalysis(ClientData clientData,
   int numberOfArguments = argc;
   if (numberOfArguments < 4) {
 		opserr << "ERROR: invalid number of arguments to designVariable command "<<endln;
-	    opserr <<"command: runMonteCarloResponseAnalysis  -outPutFile  m.out -maxNum 1000 -print 1 -tclFileToRun test.tcl"<<endln;
+	    opserr <<"command: runMonteCarloResponseAnalysis  -outPutFile  m.out -maxNum 1000 -print 1 -tclFileToRun test.tcl <-seed 1> <-numProcs 4> <-targetCOV 0.05>"<<endln;
 		return TCL_ERROR;
   }	
 
@@ -5193,6 +5203,8 @@ TclReliabilityModelBuilder_runMonteCarloResponseAnalysis(ClientData clientData,
 	int printFlag			= 0;
 	char outPutFile[25]="";
 	char * tclFileName = 0;
+	int numProcs			= 0;
+	double targetCOV		= 0.0;
 
 	int argvCounter = 1;
 	while (argc > argvCounter) {
@@ -5245,6 +5257,26 @@ TclReliabilityModelBuilder_runMonteCarloResponseAnalysis(ClientData clientData,
 			argvCounter++;
 		}// else if
 
+		else if ((strcmp(argv[argvCounter],"-numProcs") == 0)||(strcmp(argv[argvCounter],"-numprocs") == 0)) {
+			argvCounter++;
+			
+			if (argc == argvCounter || Tcl_GetInt(interp, argv[argvCounter], &numProcs) != TCL_OK || numProcs < 1) {
+			opserr << "ERROR: invalid input: numProcs \n";
+			return TCL_ERROR;
+			}
+			argvCounter++;
+		}// else if
+
+		else if ((strcmp(argv[argvCounter],"-targetCOV") == 0)||(strcmp(argv[argvCounter],"-targetCov") == 0)) {
+			argvCounter++;
+			
+			if (argc == argvCounter || Tcl_GetDouble(interp, argv[argvCounter], &targetCOV) != TCL_OK) {
+			opserr << "ERROR: invalid input: targetCOV \n";
+			return TCL_ERROR;
+			}
+			argvCounter++;
+		}// else if
+
 		else {
 			opserr<<"warning: unknown command: "<<argv[argvCounter]<<endln;
 			argvCounter++;
@@ -5253,6 +5285,9 @@ TclReliabilityModelBuilder_runMonteCarloResponseAnalysis(ClientData clientData,
 
 	};  // while
 
+	// the limit-state functions are evaluated only by the workers
+	if (targetCOV > 0.0 && numProcs == 0)
+		opserr << "WARNING runMonteCarloResponseAnalysis - -targetCOV is used only with -numProcs, it is ignored\n";
 
 	
 	theMonteCarloResponseAnalysis
@@ -5264,7 +5299,11 @@ TclReliabilityModelBuilder_runMonteCarloResponseAnalysis(ClientData clientData,
 						printFlag,
 						outPutFile,
 						tclFileName,
-						seed);
+						seed,
+						theStructuralDomain,
+						theFunctionEvaluator,
+						numProcs,
+						targetCOV);
 			
 			
 	if (theMonteCarloResponseAnalysis == 0) {
@@ -5275,7 +5314,8 @@ TclReliabilityModelBuilder_runMonteCarloResponseAnalysis(ClientData clientData,
 	if (tclFileName !=0) delete [] tclFileName;
 
 	// Now run analysis
-	theMonteCarloResponseAnalysis->analyze();
+	if (theMonteCarloResponseAnalysis->analyze() < 0)
+		return TCL_ERROR;
 	
 	return TCL_OK;
 
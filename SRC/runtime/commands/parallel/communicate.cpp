@@ -19,6 +19,7 @@
 #include <Logging.h>
 #include <Parsing.h>
 #include <MachineBroker.h>
+#include <MPI_Channel.h>
 
 
 static int opsBarrier(ClientData, Tcl_Interp *, int, TCL_Char ** const argv);
@@ -68,6 +69,7 @@ opsSend(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char ** const a
 
   } else {
     if (myPID == 0) {
+      MPI_Channel::flushAll();
       MPI_Bcast((void *)(&msgLength), 1, MPI_INT, 0, MPI_COMM_WORLD);
       MPI_Bcast((void *)gMsg, msgLength, MPI_CHAR, 0, MPI_COMM_WORLD);
     } else {
@@ -109,6 +111,7 @@ opsRecv(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char ** const a
     }
 
     if (otherPID > -1 && otherPID < np) {
+      MPI_Channel::flushAll();
       MPI_Status status;
 
       if (fromAny == false)
@@ -141,6 +144,7 @@ opsRecv(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char ** const a
     }
   } else {
     if (myPID != 0) {
+      MPI_Channel::flushAll();
       MPI_Bcast((void *)(&msgLength), 1, MPI_INT, 0, MPI_COMM_WORLD);
 
       if (msgLength > 0) {
@@ -163,6 +167,8 @@ opsRecv(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char ** const a
 static int
 opsBarrier(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char ** const argv)
 {
+  // data held back by the channels could be what the others wait on
+  MPI_Channel::flushAll();
   return MPI_Barrier(MPI_COMM_WORLD);
 }
 
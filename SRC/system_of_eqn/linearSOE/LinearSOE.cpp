@@ -35,6 +35,7 @@
 #include<Matrix.h>
 #include<Vector.h>
 #include<ID.h>
+#include<Profiler.h>
 
 LinearSOE::LinearSOE(LinearSOESolver &theLinearSOESolver, int classtag)
     :MovableObject(classtag), theModel(0), theSolver(&theLinearSOESolver)
@@ -58,9 +59,14 @@ LinearSOE::~LinearSOE()
 int 
 LinearSOE::solve(void)
 {
-  if (theSolver != 0)
+  static int solveRegion = Profiler::getRegion("solve");
+  ProfilerScope theScope(solveRegion);
+
+  if (theSolver != 0) {
+    // the time of each solver is kept under its class name
+    ProfilerScope solverScope(Profiler::isEnabled() ? Profiler::getClassRegion(theSolver->getClassTag(), theSolver->getClassType()) : -1);
     return (theSolver->solve());
-  else 
+  } else 
     return -1;
 }
 
@@ -71,6 +71,10 @@ class LinearSOE : public MovableObject
     virtual int addA(const Matrix &);
     virtual int addColA(const Vector &col, int colIndex, double fact = 1.0);
 
+    // true if addA() and addB() may be invoked concurrently for ID's
+    // that share no equation numbers
+    virtual bool isThreadSafe(void) {return false;};
+
     virtual void zeroA(void) =0;
     virtual void zeroB(void) =0;
 
@@ -46,6 +46,9 @@ class LinearSOESolver : public MovableObject
     LinearSOESolver(int classTag);    
     virtual ~LinearSOESolver();
 
+    // solve() must reuse the factorization of A if only B has been
+    // changed since the last solve (LinearSOE::zeroA() resets it); the
+    // refactor policy of the EquiSolnAlgo classes depends on this.
     virtual int solve(void) = 0;
     virtual int setSize(void) = 0;
     virtual double getDeterminant(void) {return 1.0;};
@@ -0,0 +1,129 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation for SparseScatterMap.
+
+#include <SparseScatterMap.h>
+#include <ID.h>
+#include <AnalysisModel.h>
+#include <FE_Element.h>
+#include <FE_EleIter.h>
+#include <DOF_Group.h>
+#include <DOF_GrpIter.h>
+
+SparseScatterMap::SparseScatterMap()
+{
+
+}
+
+SparseScatterMap::~SparseScatterMap()
+{
+
+}
+
+int
+SparseScatterMap::setSize(AnalysisModel &theModel, const int *outerStart,
+			  const int *innerIndex, int numEqn, bool rowCompressed)
+{
+  this->clear();
+
+  FE_Element *elePtr;
+  FE_EleIter &theEles = theModel.getFEs();
+  while ((elePtr = theEles()) != 0)
+    this->addID(elePtr->getID(), outerStart, innerIndex, numEqn, rowCompressed);
+
+  DOF_Group *dofPtr;
+  DOF_GrpIter &theDofs = theModel.getDOFs();
+  while ((dofPtr = theDofs()) != 0)
+    this->addID(dofPtr->getID(), outerStart, innerIndex, numEqn, rowCompressed);
+
+  return 0;
+}
+
+void
+SparseScatterMap::clear(void)
+{
+  theData.clear();
+  theOffsets.clear();
+}
+
+const int *
+SparseScatterMap::getLocations(const ID &id) const
+{
+  std::unordered_map<const ID *, int>::const_iterator it = theOffsets.find(&id);
+  if (it == theOffsets.end())
+    return 0;
+
+  // make sure the ID has not been renumbered since the map was set up
+  const int *data = &theData[it->second];
+  int n = id.Size();
+  if (data[0] != n)
+    return 0;
+  for (int i=0; i<n; i++)
+    if (data[1+i] != id(i))
+      return 0;
+
+  return data + 1 + n;
+}
+
+void
+SparseScatterMap::addID(const ID &id, const int *outerStart,
+			const int *innerIndex, int numEqn, bool rowCompressed)
+{
+  // an ID shared by more than one object need only be added once
+  if (theOffsets.find(&id) != theOffsets.end())
+    return;
+
+  int n = id.Size();
+  int offset = theData.size();
+  theData.resize(offset + 1 + n + n*n);
+
+  int *data = &theData[offset];
+  data[0] = n;
+  for (int i=0; i<n; i++)
+    data[1+i] = id(i);
+
+  int *loc = data + 1 + n;
+  for (int j=0; j<n; j++) {
+    int col = id(j);
+    for (int i=0; i<n; i++) {
+      int row = id(i);
+      int &theLoc = loc[j*n+i];
+      theLoc = -1;
+      if (row < 0 || row >= numEqn || col < 0 || col >= numEqn)
+	continue;
+
+      int outer = col;
+      int inner = row;
+      if (rowCompressed) {
+	outer = row;
+	inner = col;
+      }
+
+      for (int k=outerStart[outer]; k<outerStart[outer+1]; k++)
+	if (innerIndex[k] == inner) {
+	  theLoc = k;
+	  break;
+	}
+    }
+  }
+
+  theOffsets[&id] = offset;
+}
@@ -0,0 +1,65 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the class definition for SparseScatterMap.
+// A SparseScatterMap is used by the compressed sparse LinearSOE classes
+// to avoid searching a column (or row) for every coefficient in addA().
+// When the SOE is sized, the location in the value array of every entry
+// of the matrix of each FE_Element and DOF_Group in the AnalysisModel is
+// computed once; addA() then looks up the locations from the ID it is
+// given and adds the entries directly.
+
+#ifndef SparseScatterMap_h
+#define SparseScatterMap_h
+
+#include <vector>
+#include <unordered_map>
+
+class ID;
+class AnalysisModel;
+
+class SparseScatterMap
+{
+  public:
+    SparseScatterMap();
+    ~SparseScatterMap();
+
+    // compute the locations for the ID's of theModel's FE_Elements and
+    // DOF_Groups; outerStart and innerIndex describe the compressed
+    // columns (or, if rowCompressed, rows) of a matrix of order numEqn
+    int setSize(AnalysisModel &theModel, const int *outerStart,
+		const int *innerIndex, int numEqn, bool rowCompressed = false);
+    void clear(void);
+
+    // locations for entry (i,j) of the matrix assembled with id, stored
+    // at [j*id.Size()+i], -1 for entries not in the system; 0 if id is
+    // not one the map was set up for, or its equation numbers changed
+    const int *getLocations(const ID &id) const;
+
+  private:
+    void addID(const ID &id, const int *outerStart, const int *innerIndex,
+	       int numEqn, bool rowCompressed);
+
+    // for each ID: its size n, its n equation numbers and n*n locations
+    std::vector<int> theData;
+    std::unordered_map<const ID *, int> theOffsets;
+};
+
+#endif
@@ -146,21 +146,24 @@ BandGenLinSOE::setSize(Graph &theGraph)
     numSubD = 0;
     numSuperD = 0;
 
-    Vertex *vertexPtr;
-    VertexIter &theVertices = theGraph.getVertices();
-    
-    while ((vertexPtr = theVertices()) != 0) {
-	int vertexNum = vertexPtr->getTag();
-	const ID &theAdjacency = vertexPtr->getAdjacency();
-	for (int i=0; i<theAdjacency.Size(); i++) {
-	    int otherNum = theAdjacency(i);
-	    int diff = vertexNum - otherNum;
-	    if (diff > 0) {
-		if (diff > numSuperD)
-		    numSuperD = diff;
-	    } else 
-		if (diff < numSubD)
-		    numSubD = diff;
+    const int *rowStart, *adjacency;
+    if (theGraph.getCSR(rowStart, adjacency) < 0) {
+	opserr << "WARNING BandGenLinSOE::setSize :";
+	opserr << " vertices not numbered 0 through size-1 - size set to 0\n";
+	size = 0;
+	return -1;
+    }
+
+    // the adjacency of each vertex is sorted, so the first and last
+    // entries give the extent of the row
+    for (int vertexNum=0; vertexNum<size; vertexNum++) {
+	if (rowStart[vertexNum+1] > rowStart[vertexNum]) {
+	    int diff = vertexNum - adjacency[rowStart[vertexNum]];
+	    if (diff > numSuperD)
+		numSuperD = diff;
+	    diff = vertexNum - adjacency[rowStart[vertexNum+1]-1];
+	    if (diff < numSubD)
+		numSubD = diff;
 	}
     }
     numSubD *= -1;
@@ -154,15 +154,19 @@ BandSPDLinSOE::setSize(Graph &theGraph)
     size = theGraph.getNumVertex();
     half_band = 0;
     
-    Vertex *vertexPtr;
-    VertexIter &theVertices = theGraph.getVertices();
-    
-    while ((vertexPtr = theVertices()) != 0) {
-	int vertexNum = vertexPtr->getTag();
-	const ID &theAdjacency = vertexPtr->getAdjacency();
-	for (int i=0; i<theAdjacency.Size(); i++) {
-	    int otherNum = theAdjacency(i);
-	    int diff = vertexNum-otherNum;
+    const int *rowStart, *adjacency;
+    if (theGraph.getCSR(rowStart, adjacency) < 0) {
+	opserr << "WARNING BandSPDLinSOE::setSize :";
+	opserr << " vertices not numbered 0 through size-1 - size set to 0\n";
+	size = 0;
+	return -1;
+    }
+
+    // the adjacency of each vertex is sorted, the first entry is the
+    // one furthest from the diagonal in the lower triangle
+    for (int vertexNum=0; vertexNum<size; vertexNum++) {
+	if (rowStart[vertexNum+1] > rowStart[vertexNum]) {
+	    int diff = vertexNum - adjacency[rowStart[vertexNum]];
 	    if (half_band < diff)
 		half_band = diff;
 	}
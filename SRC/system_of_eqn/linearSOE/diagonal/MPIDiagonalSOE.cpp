@@ -23,6 +23,7 @@
 #include <math.h>
 
 #include <Channel.h>
+#include <MPI_Channel.h>
 #include <FEM_ObjectBroker.h>
 
 #include <AnalysisModel.h>
@@ -160,6 +161,7 @@ MPIDiagonalSOE::setSize(Graph &theGraph)
   int* allSizes = new int[numProcesses];
   for (int i=0; i<numProcesses; i++)
     allSizes[i] = 0;
+  MPI_Channel::flushAll();
   MPI_Allgather(tmpsendSize,1,MPI_INT,allSizes,1,MPI_INT,MPI_COMM_WORLD);
   int* max = new int[1];
   max[0] =0;
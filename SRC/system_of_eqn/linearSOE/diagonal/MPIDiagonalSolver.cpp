@@ -15,6 +15,7 @@
 #include <MPIDiagonalSolver.h>
 #include <MPIDiagonalSOE.h>
 #include <Channel.h>
+#include <MPI_Channel.h>
 #include <elementAPI.h>
 //#include <essl.h>
 
@@ -110,6 +111,8 @@ MPIDiagonalSolver::solve(void)
   *tmpnumShared = numShared;
 
   if (notSet) {
+    // the others wait in the broadcasts on any data held back
+    MPI_Channel::flushAll();
     for (int i=0; i<maxNeighbors; i++) {
        for (int j=0; j<maxShared; j++) {
 	maxDOFsSharedArray[j] = 0;
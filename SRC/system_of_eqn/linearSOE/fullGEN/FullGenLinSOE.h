@@ -56,6 +56,7 @@ class FullGenLinSOE : public LinearSOE
     int setSize(Graph &theGraph);
     int addA(const Matrix &, const ID &, double fact = 1.0);
     int addB(const Vector &, const ID &, double fact = 1.0);    
+    virtual bool isThreadSafe(void) {return true;};
     int setB(const Vector &, double fact = 1.0);        
     int addColA(const Vector &col, int colIndex, double fact = 1.0);
     
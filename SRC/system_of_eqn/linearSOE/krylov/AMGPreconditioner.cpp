@@ -0,0 +1,502 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation for
+// AMGPreconditioner.
+
+#include <AMGPreconditioner.h>
+#include <OPS_Globals.h>
+#include <cmath>
+
+#ifdef _WIN32
+
+extern "C" int DGETRF(int *M, int *N, double *A, int *LDA, int *iPiv, int *INFO);
+
+extern "C" int DGETRS(char *TRANS, int *N, int *NRHS, double *A, int *LDA,
+		      int *iPiv, double *B, int *LDB, int *INFO);
+
+#else
+
+extern "C" int dgetrf_(int *M, int *N, double *A, int *LDA, int *iPiv, int *INFO);
+
+extern "C" int dgetrs_(char *TRANS, int *N, int *NRHS, double *A, int *LDA,
+		       int *iPiv, double *B, int *LDB, int *INFO);
+
+#define DGETRF dgetrf_
+#define DGETRS dgetrs_
+
+#endif
+
+// the largest coarsest level that is factored as a dense matrix, a
+// larger one (when maxLevels is reached) is only smoothed
+static const int maxDenseSize = 4000;
+
+// C = A B, A of n rows and B of m columns
+static void
+multiplySparse(int n, const int *Ap, const int *Aj, const double *Ax,
+	       int m, const int *Bp, const int *Bj, const double *Bx,
+	       std::vector<int> &Cp, std::vector<int> &Cj, std::vector<double> &Cx)
+{
+  std::vector<int> mark(m, -1);
+  Cp.assign(1, 0);
+  Cj.clear();
+  Cx.clear();
+
+  for (int i=0; i<n; i++) {
+    int rowBegin = Cj.size();
+    for (int ka=Ap[i]; ka<Ap[i+1]; ka++) {
+      int k = Aj[ka];
+      double a = Ax[ka];
+      for (int kb=Bp[k]; kb<Bp[k+1]; kb++) {
+	int j = Bj[kb];
+	if (mark[j] < rowBegin) {
+	  mark[j] = Cj.size();
+	  Cj.push_back(j);
+	  Cx.push_back(a * Bx[kb]);
+	} else
+	  Cx[mark[j]] += a * Bx[kb];
+      }
+    }
+    Cp.push_back(Cj.size());
+  }
+}
+
+// T = A', A of n rows and m columns
+static void
+transposeSparse(int n, int m, const int *Ap, const int *Aj, const double *Ax,
+		std::vector<int> &Tp, std::vector<int> &Tj, std::vector<double> &Tx)
+{
+  Tp.assign(m+1, 0);
+  for (int k=0; k<Ap[n]; k++)
+    Tp[Aj[k]+1]++;
+  for (int j=0; j<m; j++)
+    Tp[j+1] += Tp[j];
+
+  Tj.resize(Ap[n]);
+  Tx.resize(Ap[n]);
+  std::vector<int> next(Tp.begin(), Tp.end()-1);
+  for (int i=0; i<n; i++)
+    for (int k=Ap[i]; k<Ap[i+1]; k++) {
+      int pos = next[Aj[k]]++;
+      Tj[pos] = i;
+      Tx[pos] = Ax[k];
+    }
+}
+
+AMGPreconditioner::AMGPreconditioner(int bSize, double theta, int nSweeps,
+				     int cSize, int mLevels)
+  :blockSize(bSize), threshold(theta), numSweeps(nSweeps),
+   coarseSize(cSize), maxLevels(mLevels),
+   size(0), rowStart(0), colIndex(0)
+{
+  if (blockSize < 1)
+    blockSize = 1;
+  if (numSweeps < 1)
+    numSweeps = 1;
+  if (coarseSize < 1)
+    coarseSize = 1;
+  if (maxLevels < 1)
+    maxLevels = 1;
+}
+
+AMGPreconditioner::~AMGPreconditioner()
+{
+
+}
+
+int
+AMGPreconditioner::setSize(int n, const int *rStart, const int *cIndex)
+{
+  size = n;
+  rowStart = rStart;
+  colIndex = cIndex;
+  levels.clear();
+
+  if (n % blockSize != 0) {
+    opserr << "WARNING AMGPreconditioner::setSize() - number of equations ";
+    opserr << n << " not a multiple of the block size " << blockSize;
+    opserr << ", using a block size of 1\n";
+    blockSize = 1;
+  }
+
+  return 0;
+}
+
+int
+AMGPreconditioner::getNumLevels(void) const
+{
+  return levels.size();
+}
+
+double
+AMGPreconditioner::jacobiRadius(const Level &theLevel)
+{
+  // a few power iterations on inv(D)A, from a fixed start vector
+  int n = theLevel.n;
+  const std::vector<double> &invDiag = theLevel.invDiag;
+  std::vector<double> x(n), y(n);
+  for (int i=0; i<n; i++)
+    x[i] = 1.0 + 0.1*(i%7);
+
+  double rho = 0.0;
+  for (int iter=0; iter<10; iter++) {
+    double xNorm = 0.0;
+    for (int i=0; i<n; i++)
+      xNorm += x[i]*x[i];
+    xNorm = sqrt(xNorm);
+    if (xNorm == 0.0)
+      break;
+    for (int i=0; i<n; i++)
+      x[i] /= xNorm;
+
+    KrylovPreconditioner::multiply(n, theLevel.Ap, theLevel.Aj, theLevel.Ax,
+				   x.data(), y.data(), numThreads);
+    double yNorm = 0.0;
+    for (int i=0; i<n; i++) {
+      y[i] *= invDiag[i];
+      yNorm += y[i]*y[i];
+    }
+    rho = sqrt(yNorm);
+    x.swap(y);
+  }
+
+  return rho;
+}
+
+int
+AMGPreconditioner::coarsen(int l)
+{
+  Level &fine = levels[l];
+  int n = fine.n;
+  const int *Ap = fine.Ap;
+  const int *Aj = fine.Aj;
+  const double *Ax = fine.Ax;
+  int bs = blockSize;
+  int numNodes = n / bs;
+
+  // strength of the coupling between nodes, the Frobenius norm of the
+  // nodal blocks: I and J are strongly coupled if
+  // |A_IJ| >= threshold * sqrt(|A_II| |A_JJ|)
+  std::vector<double> nodeNorm(numNodes, 0.0);
+  std::vector<int> Sp(1, 0), Sj;
+  {
+    std::vector<double> sum(numNodes, 0.0);
+    std::vector<int> mark(numNodes, -1);
+    std::vector<int> nodes;
+
+    std::vector<int> Np(1, 0), Nj;
+    std::vector<double> Nx;
+    for (int I=0; I<numNodes; I++) {
+      nodes.clear();
+      for (int i=I*bs; i<(I+1)*bs; i++)
+	for (int k=Ap[i]; k<Ap[i+1]; k++) {
+	  int J = Aj[k] / bs;
+	  if (mark[J] != I) {
+	    mark[J] = I;
+	    sum[J] = 0.0;
+	    nodes.push_back(J);
+	  }
+	  sum[J] += Ax[k]*Ax[k];
+	}
+      for (std::size_t k=0; k<nodes.size(); k++) {
+	int J = nodes[k];
+	if (J == I)
+	  nodeNorm[I] = sqrt(sum[J]);
+	else {
+	  Nj.push_back(J);
+	  Nx.push_back(sqrt(sum[J]));
+	}
+      }
+      Np.push_back(Nj.size());
+    }
+
+    double theta = threshold;
+    for (int I=0; I<numNodes; I++) {
+      for (int k=Np[I]; k<Np[I+1]; k++) {
+	int J = Nj[k];
+	if (Nx[k] != 0.0 && Nx[k] >= theta * sqrt(nodeNorm[I]*nodeNorm[J]))
+	  Sj.push_back(J);
+      }
+      Sp.push_back(Sj.size());
+    }
+  }
+
+  // aggregation, in three passes: nodes whose strong neighbours are all
+  // free start an aggregate with them, the remaining nodes join an
+  // aggregate of a strong neighbour, and whatever is left over is
+  // aggregated with its free strong neighbours
+  std::vector<int> agg(numNodes, -1);
+  int numAgg = 0;
+  for (int I=0; I<numNodes; I++) {
+    if (agg[I] >= 0)
+      continue;
+    bool isFree = true;
+    for (int k=Sp[I]; k<Sp[I+1] && isFree; k++)
+      if (agg[Sj[k]] >= 0)
+	isFree = false;
+    if (isFree) {
+      agg[I] = numAgg;
+      for (int k=Sp[I]; k<Sp[I+1]; k++)
+	agg[Sj[k]] = numAgg;
+      numAgg++;
+    }
+  }
+
+  std::vector<int> joined(agg);
+  for (int I=0; I<numNodes; I++) {
+    if (agg[I] >= 0)
+      continue;
+    for (int k=Sp[I]; k<Sp[I+1]; k++)
+      if (agg[Sj[k]] >= 0) {
+	joined[I] = agg[Sj[k]];
+	break;
+      }
+  }
+  agg.swap(joined);
+
+  for (int I=0; I<numNodes; I++) {
+    if (agg[I] >= 0)
+      continue;
+    agg[I] = numAgg;
+    for (int k=Sp[I]; k<Sp[I+1]; k++)
+      if (agg[Sj[k]] < 0)
+	agg[Sj[k]] = numAgg;
+    numAgg++;
+  }
+
+  int nc = numAgg*bs;
+  if (nc == 0 || 2*nc > n) // not worth another level
+    return 1;
+
+  // tentative prolongator, orthonormal columns
+  std::vector<int> aggSize(numAgg, 0);
+  for (int I=0; I<numNodes; I++)
+    aggSize[agg[I]]++;
+
+  std::vector<int> Tp(n+1), Tj(n);
+  std::vector<double> Tx(n);
+  for (int i=0; i<n; i++) {
+    int I = i / bs;
+    Tp[i] = i;
+    Tj[i] = agg[I]*bs + i%bs;
+    Tx[i] = 1.0/sqrt((double)aggSize[agg[I]]);
+  }
+  Tp[n] = n;
+
+  // smoothed prolongator P = (I - omega inv(D) A) T
+  double omega = fine.omega;
+
+  multiplySparse(n, Ap, Aj, Ax, nc, Tp.data(), Tj.data(), Tx.data(),
+		 fine.Pp, fine.Pj, fine.Px);
+  std::vector<int> &Pp = fine.Pp;
+  std::vector<int> &Pj = fine.Pj;
+  std::vector<double> &Px = fine.Px;
+  std::vector<int> Qp(1, 0), Qj;
+  std::vector<double> Qx;
+  for (int i=0; i<n; i++) {
+    double scale = -omega * fine.invDiag[i];
+    bool found = false;
+    for (int k=Pp[i]; k<Pp[i+1]; k++) {
+      double value = scale * Px[k];
+      if (Pj[k] == Tj[i]) {
+	value += Tx[i];
+	found = true;
+      }
+      Qj.push_back(Pj[k]);
+      Qx.push_back(value);
+    }
+    if (!found) {
+      Qj.push_back(Tj[i]);
+      Qx.push_back(Tx[i]);
+    }
+    Qp.push_back(Qj.size());
+  }
+  Pp.swap(Qp);
+  Pj.swap(Qj);
+  Px.swap(Qx);
+
+  transposeSparse(n, nc, Pp.data(), Pj.data(), Px.data(),
+		  fine.Rp, fine.Rj, fine.Rx);
+
+  // coarse matrix P'AP
+  std::vector<int> APp, APj;
+  std::vector<double> APx;
+  multiplySparse(n, Ap, Aj, Ax, nc, Pp.data(), Pj.data(), Px.data(),
+		 APp, APj, APx);
+
+  levels.push_back(Level());
+  Level &coarse = levels.back();   // fine may have moved
+  Level &prev = levels[l];
+  coarse.n = nc;
+  multiplySparse(nc, prev.Rp.data(), prev.Rj.data(), prev.Rx.data(),
+		 nc, APp.data(), APj.data(), APx.data(),
+		 coarse.Cp, coarse.Cj, coarse.Cx);
+  coarse.Ap = coarse.Cp.data();
+  coarse.Aj = coarse.Cj.data();
+  coarse.Ax = coarse.Cx.data();
+
+  return 0;
+}
+
+int
+AMGPreconditioner::update(const double *A)
+{
+  levels.clear();
+  levels.reserve(maxLevels);
+  levels.push_back(Level());
+  levels[0].n = size;
+  levels[0].Ap = rowStart;
+  levels[0].Aj = colIndex;
+  levels[0].Ax = A;
+
+  for (int l=0; ; l++) {
+    Level &theLevel = levels[l];
+    int n = theLevel.n;
+
+    theLevel.invDiag.assign(n, 0.0);
+    for (int i=0; i<n; i++)
+      for (int k=theLevel.Ap[i]; k<theLevel.Ap[i+1]; k++)
+	if (theLevel.Aj[k] == i && theLevel.Ax[k] != 0.0)
+	  theLevel.invDiag[i] = 1.0/theLevel.Ax[k];
+    double rho = this->jacobiRadius(theLevel);
+    theLevel.omega = (rho > 0.0) ? 4.0/(3.0*rho) : 0.0;
+
+    theLevel.x.assign(n, 0.0);
+    theLevel.b.assign(n, 0.0);
+    theLevel.r.assign(n, 0.0);
+
+    if (n <= coarseSize || l+1 >= maxLevels || this->coarsen(l) != 0)
+      break;
+  }
+
+  // damped Jacobi smoother
+  for (std::size_t l=0; l<levels.size(); l++) {
+    Level &theLevel = levels[l];
+    for (int i=0; i<theLevel.n; i++)
+      theLevel.invDiag[i] *= theLevel.omega;
+  }
+
+  // dense factorization of the coarsest level
+  Level &last = levels.back();
+  int nc = last.n;
+  coarseLU.clear();
+  coarsePivot.clear();
+  if (nc <= maxDenseSize) {
+    coarseLU.assign((std::size_t)nc*nc, 0.0);
+    coarsePivot.assign(nc, 0);
+    for (int i=0; i<nc; i++)
+      for (int k=last.Ap[i]; k<last.Ap[i+1]; k++)
+	coarseLU[(std::size_t)last.Aj[k]*nc + i] += last.Ax[k];
+    int info = 0;
+    if (nc > 0)
+      DGETRF(&nc, &nc, coarseLU.data(), &nc, coarsePivot.data(), &info);
+    if (info != 0) {
+      opserr << "WARNING AMGPreconditioner::update() -";
+      opserr << " coarse level matrix is singular\n";
+      return -1;
+    }
+  }
+
+  return 0;
+}
+
+void
+AMGPreconditioner::smooth(Level &theLevel, bool zeroStart)
+{
+  int n = theLevel.n;
+  double *x = theLevel.x.data();
+  const double *b = theLevel.b.data();
+  double *r = theLevel.r.data();
+  const double *invDiag = theLevel.invDiag.data();
+
+  for (int sweep=0; sweep<numSweeps; sweep++) {
+    if (zeroStart && sweep == 0) {
+      for (int i=0; i<n; i++)
+	x[i] = invDiag[i]*b[i];
+      continue;
+    }
+    KrylovPreconditioner::multiply(n, theLevel.Ap, theLevel.Aj, theLevel.Ax,
+				   x, r, numThreads);
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(numThreads) schedule(static) if(n > 2000)
+#endif
+    for (int i=0; i<n; i++)
+      x[i] += invDiag[i]*(b[i] - r[i]);
+  }
+}
+
+void
+AMGPreconditioner::cycle(int l)
+{
+  Level &theLevel = levels[l];
+  int n = theLevel.n;
+
+  if (l+1 == (int)levels.size()) {
+    if (!coarsePivot.empty()) {
+      char trans[] = "N";
+      int nrhs = 1;
+      int info = 0;
+      theLevel.x = theLevel.b;
+      DGETRS(trans, &n, &nrhs, coarseLU.data(), &n, coarsePivot.data(),
+	     theLevel.x.data(), &n, &info);
+    } else
+      this->smooth(theLevel, true);
+    return;
+  }
+
+  Level &next = levels[l+1];
+
+  // pre-smoothing, restriction of the residual
+  this->smooth(theLevel, true);
+  double *r = theLevel.r.data();
+  KrylovPreconditioner::multiply(n, theLevel.Ap, theLevel.Aj, theLevel.Ax,
+				 theLevel.x.data(), r, numThreads);
+  for (int i=0; i<n; i++)
+    r[i] = theLevel.b[i] - r[i];
+  KrylovPreconditioner::multiply(next.n, theLevel.Rp.data(), theLevel.Rj.data(),
+				 theLevel.Rx.data(), r, next.b.data(), numThreads);
+
+  this->cycle(l+1);
+
+  // coarse correction, post-smoothing
+  KrylovPreconditioner::multiply(n, theLevel.Pp.data(), theLevel.Pj.data(),
+				 theLevel.Px.data(), next.x.data(), r, numThreads);
+  for (int i=0; i<n; i++)
+    theLevel.x[i] += r[i];
+  this->smooth(theLevel, false);
+}
+
+int
+AMGPreconditioner::apply(const double *r, double *z)
+{
+  if (levels.empty())
+    return -1;
+
+  Level &fine = levels[0];
+  for (int i=0; i<size; i++)
+    fine.b[i] = r[i];
+
+  this->cycle(0);
+
+  for (int i=0; i<size; i++)
+    z[i] = fine.x[i];
+
+  return 0;
+}
@@ -0,0 +1,91 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the class definition for
+// AMGPreconditioner, a smoothed aggregation algebraic multigrid
+// preconditioner (Vanek, Mandel and Brezina, 1996) applied as one
+// V-cycle. The unknowns are aggregated by nodes of blockSize equations
+// through the strong couplings of A; the tentative prolongator carries
+// one column per aggregate and nodal dof (the translations for a solid
+// model), and is smoothed by one damped Jacobi step. The coarse
+// matrices are the Galerkin products P'AP, the smoother is damped
+// Jacobi, so the cycle is symmetric and may be used with PCG, and the
+// coarsest level is solved by a dense LU factorization.
+
+#ifndef AMGPreconditioner_h
+#define AMGPreconditioner_h
+
+#include <KrylovPreconditioner.h>
+#include <vector>
+
+class AMGPreconditioner : public KrylovPreconditioner
+{
+  public:
+    AMGPreconditioner(int blockSize = 1, double threshold = 0.0,
+		      int numSweeps = 2, int coarseSize = 500,
+		      int maxLevels = 10);
+    ~AMGPreconditioner();
+
+    int setSize(int n, const int *rowStart, const int *colIndex);
+    int update(const double *A);
+    int apply(const double *r, double *z);
+
+    int getNumLevels(void) const;
+
+  protected:
+
+  private:
+    struct Level {
+      int n;
+      const int *Ap;               // matrix of the level, compressed rows
+      const int *Aj;
+      const double *Ax;
+      std::vector<int> Cp, Cj;     // storage for the coarse level matrices
+      std::vector<double> Cx;
+      double omega;                // 4/(3 rho(inv(D)A))
+      std::vector<double> invDiag; // omega/a_ii for the Jacobi smoother
+      std::vector<int> Pp, Pj;     // prolongator from the next level
+      std::vector<double> Px;
+      std::vector<int> Rp, Rj;     // restriction to the next level, P'
+      std::vector<double> Rx;
+      std::vector<double> x, b, r;
+    };
+
+    int coarsen(int l);
+    double jacobiRadius(const Level &theLevel);
+    void smooth(Level &theLevel, bool zeroStart);
+    void cycle(int l);
+
+    int blockSize;
+    double threshold;
+    int numSweeps;
+    int coarseSize;
+    int maxLevels;
+
+    int size;
+    const int *rowStart;
+    const int *colIndex;
+
+    std::vector<Level> levels;
+    std::vector<double> coarseLU; // dense factors of the coarsest level
+    std::vector<int> coarsePivot;
+};
+
+#endif
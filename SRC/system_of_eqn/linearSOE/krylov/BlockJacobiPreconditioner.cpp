@@ -0,0 +1,153 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation for
+// BlockJacobiPreconditioner.
+
+#include <BlockJacobiPreconditioner.h>
+#include <OPS_Globals.h>
+#include <cmath>
+
+BlockJacobiPreconditioner::BlockJacobiPreconditioner(int bSize)
+  :blockSize(bSize), size(0), rowStart(0), colIndex(0)
+{
+  if (blockSize < 1)
+    blockSize = 1;
+}
+
+BlockJacobiPreconditioner::~BlockJacobiPreconditioner()
+{
+
+}
+
+int
+BlockJacobiPreconditioner::setSize(int n, const int *rStart, const int *cIndex)
+{
+  size = n;
+  rowStart = rStart;
+  colIndex = cIndex;
+
+  int numBlocks = (n + blockSize - 1) / blockSize;
+  LU.assign((std::size_t)numBlocks*blockSize*blockSize, 0.0);
+  pivot.assign((std::size_t)numBlocks*blockSize, 0);
+
+  return 0;
+}
+
+int
+BlockJacobiPreconditioner::update(const double *A)
+{
+  int numBlocks = (size + blockSize - 1) / blockSize;
+  int bs = blockSize;
+  int result = 0;
+
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(numThreads) schedule(static) reduction(min:result)
+#endif
+  for (int b=0; b<numBlocks; b++) {
+    int first = b*bs;
+    int n = (first + bs <= size) ? bs : size - first;
+    double *D = &LU[(std::size_t)b*bs*bs];
+    int *piv = &pivot[(std::size_t)b*bs];
+
+    // gather the diagonal block, column major
+    for (int i=0; i<bs*bs; i++)
+      D[i] = 0.0;
+    for (int i=0; i<n; i++) {
+      int row = first + i;
+      for (int k=rowStart[row]; k<rowStart[row+1]; k++) {
+	int j = colIndex[k] - first;
+	if (j >= 0 && j < n)
+	  D[j*n+i] = A[k];
+      }
+    }
+
+    // factor it
+    for (int j=0; j<n; j++) {
+      int p = j;
+      for (int i=j+1; i<n; i++)
+	if (fabs(D[j*n+i]) > fabs(D[j*n+p]))
+	  p = i;
+      piv[j] = p;
+      if (D[j*n+p] == 0.0) {
+	result = -1;
+	break;
+      }
+      if (p != j)
+	for (int k=0; k<n; k++) {
+	  double tmp = D[k*n+j];
+	  D[k*n+j] = D[k*n+p];
+	  D[k*n+p] = tmp;
+	}
+      double invPivot = 1.0/D[j*n+j];
+      for (int i=j+1; i<n; i++)
+	D[j*n+i] *= invPivot;
+      for (int k=j+1; k<n; k++)
+	for (int i=j+1; i<n; i++)
+	  D[k*n+i] -= D[j*n+i]*D[k*n+j];
+    }
+  }
+
+  if (result < 0) {
+    opserr << "WARNING BlockJacobiPreconditioner::update() -";
+    opserr << " singular diagonal block\n";
+    return -1;
+  }
+
+  return 0;
+}
+
+int
+BlockJacobiPreconditioner::apply(const double *r, double *z)
+{
+  int numBlocks = (size + blockSize - 1) / blockSize;
+  int bs = blockSize;
+
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(numThreads) schedule(static) if(size > 2000)
+#endif
+  for (int b=0; b<numBlocks; b++) {
+    int first = b*bs;
+    int n = (first + bs <= size) ? bs : size - first;
+    const double *D = &LU[(std::size_t)b*bs*bs];
+    const int *piv = &pivot[(std::size_t)b*bs];
+    double *x = &z[first];
+
+    for (int i=0; i<n; i++)
+      x[i] = r[first+i];
+    for (int j=0; j<n; j++) {
+      int p = piv[j];
+      if (p != j) {
+	double tmp = x[j];
+	x[j] = x[p];
+	x[p] = tmp;
+      }
+      for (int i=j+1; i<n; i++)
+	x[i] -= D[j*n+i]*x[j];
+    }
+    for (int j=n-1; j>=0; j--) {
+      x[j] /= D[j*n+j];
+      for (int i=0; i<j; i++)
+	x[i] -= D[j*n+i]*x[j];
+    }
+  }
+
+  return 0;
+}
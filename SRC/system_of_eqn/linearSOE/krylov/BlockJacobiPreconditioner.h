@@ -0,0 +1,55 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the class definition for
+// BlockJacobiPreconditioner, M = blockdiag(A). The equations are split
+// into consecutive blocks of blockSize equations (the dofs of a node
+// when the DOF_Numberer numbers them together) and each diagonal block
+// is factored by Gaussian elimination with partial pivoting. With a
+// blockSize of 1 it is the Jacobi (diagonal) preconditioner.
+
+#ifndef BlockJacobiPreconditioner_h
+#define BlockJacobiPreconditioner_h
+
+#include <KrylovPreconditioner.h>
+#include <vector>
+
+class BlockJacobiPreconditioner : public KrylovPreconditioner
+{
+  public:
+    BlockJacobiPreconditioner(int blockSize = 1);
+    ~BlockJacobiPreconditioner();
+
+    int setSize(int n, const int *rowStart, const int *colIndex);
+    int update(const double *A);
+    int apply(const double *r, double *z);
+
+  protected:
+
+  private:
+    int blockSize;
+    int size;
+    const int *rowStart;
+    const int *colIndex;
+    std::vector<double> LU;  // factored blocks, each blockSize*blockSize
+    std::vector<int> pivot;
+};
+
+#endif
@@ -0,0 +1,182 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation for
+// ILUkPreconditioner.
+
+#include <ILUkPreconditioner.h>
+#include <OPS_Globals.h>
+#include <limits.h>
+
+ILUkPreconditioner::ILUkPreconditioner(int level)
+  :levelOfFill(level), size(0), rowStart(0), colIndex(0)
+{
+  if (levelOfFill < 0)
+    levelOfFill = 0;
+}
+
+ILUkPreconditioner::~ILUkPreconditioner()
+{
+
+}
+
+int
+ILUkPreconditioner::setSize(int n, const int *rStart, const int *cIndex)
+{
+  size = n;
+  rowStart = rStart;
+  colIndex = cIndex;
+
+  luStart.assign(1, 0);
+  luCol.clear();
+  diagPos.assign(n, 0);
+  std::vector<int> luLev;
+
+  // row i is built as a sorted linked list: next[head] is its first
+  // column and the list ends at tail, which is larger than any column
+  const int head = n;
+  const int tail = n+1;
+  std::vector<int> next(n+2);
+  std::vector<int> lev(n, INT_MAX);
+
+  for (int i=0; i<n; i++) {
+    int last = head;
+    bool haveDiag = false;
+    for (int k=rowStart[i]; k<rowStart[i+1]; k++) {
+      int j = colIndex[k];
+      if (j > i && !haveDiag) { // no diagonal in A, add it
+	next[last] = i;
+	lev[i] = 0;
+	last = i;
+	haveDiag = true;
+      }
+      if (j == i)
+	haveDiag = true;
+      next[last] = j;
+      lev[j] = 0;
+      last = j;
+    }
+    if (!haveDiag) {
+      next[last] = i;
+      lev[i] = 0;
+      last = i;
+    }
+    next[last] = tail;
+
+    // fill-in from the rows of U above
+    for (int k=next[head]; k<i; k=next[k]) {
+      int levik = lev[k];
+      int prev = k;
+      for (int p=diagPos[k]+1; p<luStart[k+1]; p++) {
+	int newLev = levik + luLev[p] + 1;
+	if (newLev > levelOfFill)
+	  continue;
+	int j = luCol[p];
+	while (next[prev] < j)
+	  prev = next[prev];
+	if (next[prev] == j) {
+	  if (newLev < lev[j])
+	    lev[j] = newLev;
+	} else {
+	  next[j] = next[prev];
+	  next[prev] = j;
+	  lev[j] = newLev;
+	}
+	prev = j;
+      }
+    }
+
+    for (int j=next[head]; j!=tail; j=next[j]) {
+      if (j == i)
+	diagPos[i] = luCol.size();
+      luCol.push_back(j);
+      luLev.push_back(lev[j]);
+      lev[j] = INT_MAX;
+    }
+    luStart.push_back(luCol.size());
+  }
+
+  LU.assign(luCol.size(), 0.0);
+  work.assign(n, -1);
+
+  return 0;
+}
+
+int
+ILUkPreconditioner::update(const double *A)
+{
+  int *pos = work.data();
+
+  for (int i=0; i<size; i++) {
+    int start = luStart[i];
+    int end = luStart[i+1];
+    for (int p=start; p<end; p++) {
+      LU[p] = 0.0;
+      pos[luCol[p]] = p;
+    }
+    for (int k=rowStart[i]; k<rowStart[i+1]; k++)
+      LU[pos[colIndex[k]]] = A[k];
+
+    // eliminate with the rows above, in order
+    for (int p=start; p<diagPos[i]; p++) {
+      int k = luCol[p];
+      double lik = LU[p] / LU[diagPos[k]];
+      LU[p] = lik;
+      for (int q=diagPos[k]+1; q<luStart[k+1]; q++) {
+	int j = pos[luCol[q]];
+	if (j >= 0)
+	  LU[j] -= lik * LU[q];
+      }
+    }
+
+    for (int p=start; p<end; p++)
+      pos[luCol[p]] = -1;
+
+    if (LU[diagPos[i]] == 0.0) {
+      opserr << "WARNING ILUkPreconditioner::update() -";
+      opserr << " zero pivot in row " << i << endln;
+      return -1;
+    }
+  }
+
+  return 0;
+}
+
+int
+ILUkPreconditioner::apply(const double *r, double *z)
+{
+  // forward substitution with unit L
+  for (int i=0; i<size; i++) {
+    double sum = r[i];
+    for (int p=luStart[i]; p<diagPos[i]; p++)
+      sum -= LU[p] * z[luCol[p]];
+    z[i] = sum;
+  }
+
+  // back substitution with U
+  for (int i=size-1; i>=0; i--) {
+    double sum = z[i];
+    for (int p=diagPos[i]+1; p<luStart[i+1]; p++)
+      sum -= LU[p] * z[luCol[p]];
+    z[i] = sum / LU[diagPos[i]];
+  }
+
+  return 0;
+}
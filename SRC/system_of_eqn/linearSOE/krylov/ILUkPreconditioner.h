@@ -0,0 +1,58 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the class definition for
+// ILUkPreconditioner, an incomplete LU factorization with level of
+// fill k, M = LU. setSize() determines the pattern of L and U by the
+// symbolic level-of-fill algorithm (Saad, Iterative Methods for Sparse
+// Linear Systems, 10.3.3), so that update() only has to compute the
+// values; with a level of 0 the pattern is that of A.
+
+#ifndef ILUkPreconditioner_h
+#define ILUkPreconditioner_h
+
+#include <KrylovPreconditioner.h>
+#include <vector>
+
+class ILUkPreconditioner : public KrylovPreconditioner
+{
+  public:
+    ILUkPreconditioner(int levelOfFill = 0);
+    ~ILUkPreconditioner();
+
+    int setSize(int n, const int *rowStart, const int *colIndex);
+    int update(const double *A);
+    int apply(const double *r, double *z);
+
+  protected:
+
+  private:
+    int levelOfFill;
+    int size;
+    const int *rowStart;
+    const int *colIndex;
+    std::vector<int> luStart;  // pattern of L and U by rows, sorted
+    std::vector<int> luCol;
+    std::vector<int> diagPos;  // location of the diagonal in each row
+    std::vector<double> LU;    // unit L below the diagonal, U on and above
+    std::vector<int> work;
+};
+
+#endif
@@ -0,0 +1,333 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation for
+// KrylovLinSOE.
+
+#include <KrylovLinSOE.h>
+#include <KrylovLinSolver.h>
+#include <Matrix.h>
+#include <Graph.h>
+#include <Vertex.h>
+#include <VertexIter.h>
+#include <Channel.h>
+#include <FEM_ObjectBroker.h>
+#include <ID.h>
+
+KrylovLinSOE::KrylovLinSOE(KrylovLinSolver &the_Solver)
+  :LinearSOE(the_Solver, LinSOE_TAGS_KrylovLinSOE),
+   factored(false), X(), B(), rowStartA(), colA(), A()
+{
+  the_Solver.setLinearSOE(*this);
+}
+
+KrylovLinSOE::KrylovLinSOE()
+  :LinearSOE(LinSOE_TAGS_KrylovLinSOE),
+   factored(false), X(), B(), rowStartA(), colA(), A()
+{
+
+}
+
+KrylovLinSOE::~KrylovLinSOE()
+{
+
+}
+
+int
+KrylovLinSOE::getNumEqn(void) const
+{
+  return X.Size();
+}
+
+int
+KrylovLinSOE::setSize(Graph &theGraph)
+{
+  int size = theGraph.getNumVertex();
+  if (size < 0) {
+    opserr << "WARNING KrylovLinSOE::setSize - size of soe < 0\n";
+    return -1;
+  }
+
+  const int *rowStart, *adjacency;
+  if (theGraph.getCSR(rowStart, adjacency) < 0) {
+    opserr << "WARNING KrylovLinSOE::setSize -";
+    opserr << " vertices not numbered 0 through size-1 - size set to 0\n";
+    rowStartA.assign(1, 0);
+    colA.clear();
+    A.clear();
+    X.resize(0);
+    B.resize(0);
+    return -1;
+  }
+
+  // fill in rowStartA and colA, placing the diagonal in order among
+  // the sorted adjacency of each vertex
+  rowStartA.assign(1, 0);
+  colA.clear();
+  rowStartA.reserve(size+1);
+  colA.reserve(size + rowStart[size]);
+
+  for (int a=0; a<size; a++) {
+    int i = rowStart[a];
+    for (; i<rowStart[a+1] && adjacency[i] < a; i++)
+      colA.push_back(adjacency[i]);
+    colA.push_back(a);
+    for (; i<rowStart[a+1]; i++)
+      colA.push_back(adjacency[i]);
+    rowStartA.push_back(colA.size());
+  }
+
+  A.assign(colA.size(), 0.0);
+  B.resize(size);
+  B.Zero();
+  X.resize(size);
+  X.Zero();
+  factored = false;
+
+  // locations of the FE_Element and DOF_Group entries in A
+  if (theModel != 0)
+    theScatterMap.setSize(*theModel, rowStartA.data(), colA.data(), size, true);
+  else
+    theScatterMap.clear();
+
+  // invoke setSize() on the Solver
+  LinearSOESolver *the_Solver = this->getSolver();
+  int solverOK = the_Solver->setSize();
+  if (solverOK < 0) {
+    opserr << "WARNING KrylovLinSOE::setSize -";
+    opserr << " solver failed setSize()\n";
+    return solverOK;
+  }
+
+  return 0;
+}
+
+int
+KrylovLinSOE::addA(const Matrix &m, const ID &id, double fact)
+{
+  // check for a quick return
+  if (fact == 0.0)
+    return 0;
+
+  int idSize = id.Size();
+
+  // check that m and id are of similar size
+  if (idSize != m.noRows() && idSize != m.noCols()) {
+    opserr << "KrylovLinSOE::addA() ";
+    opserr << " - Matrix and ID not of similar sizes\n";
+    return -1;
+  }
+
+  const int *loc = theScatterMap.getLocations(id);
+  if (loc != 0 && idSize == m.noRows() && idSize == m.noCols()) {
+    if (fact == 1.0) { // do not need to multiply
+      for (int j=0; j<idSize; j++)
+	for (int i=0; i<idSize; i++, loc++)
+	  if (*loc >= 0)
+	    A[*loc] += m(i,j);
+    } else {
+      for (int j=0; j<idSize; j++)
+	for (int i=0; i<idSize; i++, loc++)
+	  if (*loc >= 0)
+	    A[*loc] += fact * m(i,j);
+    }
+    return 0;
+  }
+
+  int size = X.Size();
+  for (int i=0; i<idSize; i++) {
+    int row = id(i);
+    if (row < 0 || row >= size)
+      continue;
+    int startRowLoc = rowStartA[row];
+    int endRowLoc = rowStartA[row+1];
+    for (int j=0; j<idSize; j++) {
+      int col = id(j);
+      if (col < 0 || col >= size)
+	continue;
+      // find place in A using colA
+      for (int k=startRowLoc; k<endRowLoc; k++)
+	if (colA[k] == col) {
+	  A[k] += fact * m(i,j);
+	  break;
+	}
+    }
+  }
+
+  return 0;
+}
+
+int
+KrylovLinSOE::addB(const Vector &v, const ID &id, double fact)
+{
+  // check for a quick return
+  if (fact == 0.0)
+    return 0;
+
+  int idSize = id.Size();
+  // check that v and id are of similar size
+  if (idSize != v.Size()) {
+    opserr << "KrylovLinSOE::addB() ";
+    opserr << " - Vector and ID not of similar sizes\n";
+    return -1;
+  }
+
+  int size = B.Size();
+  if (fact == 1.0) { // do not need to multiply if fact == 1.0
+    for (int i=0; i<idSize; i++) {
+      int pos = id(i);
+      if (pos < size && pos >= 0) B[pos] += v(i);
+    }
+  } else if (fact == -1.0) { // do not need to multiply if fact == -1.0
+    for (int i=0; i<idSize; i++) {
+      int pos = id(i);
+      if (pos < size && pos >= 0) B[pos] -= v(i);
+    }
+  } else {
+    for (int i=0; i<idSize; i++) {
+      int pos = id(i);
+      if (pos < size && pos >= 0) B[pos] += v(i) * fact;
+    }
+  }
+
+  return 0;
+}
+
+int
+KrylovLinSOE::setB(const Vector &v, double fact)
+{
+  // check for a quick return
+  if (fact == 0.0) {
+    B.Zero();
+    return 0;
+  }
+
+  int size = B.Size();
+  if (v.Size() != size) {
+    opserr << "WARNING KrylovLinSOE::setB() -";
+    opserr << " incompatible sizes " << size << " and " << v.Size() << endln;
+    return -1;
+  }
+
+  if (fact == 1.0) { // do not need to multiply if fact == 1.0
+    for (int i=0; i<size; i++)
+      B[i] = v(i);
+  } else if (fact == -1.0) {
+    for (int i=0; i<size; i++)
+      B[i] = -v(i);
+  } else {
+    for (int i=0; i<size; i++)
+      B[i] = v(i) * fact;
+  }
+
+  return 0;
+}
+
+void
+KrylovLinSOE::zeroA(void)
+{
+  A.assign(A.size(), 0.0);
+  factored = false;
+}
+
+void
+KrylovLinSOE::zeroB(void)
+{
+  B.Zero();
+}
+
+int
+KrylovLinSOE::formAp(const Vector &p, Vector &Ap)
+{
+  int size = X.Size();
+  if (p.Size() != size || Ap.Size() != size) {
+    opserr << "KrylovLinSOE::formAp -- vectors not of correct size\n";
+    return -1;
+  }
+
+  for (int i=0; i<size; i++) {
+    double sum = 0.0;
+    for (int k=rowStartA[i]; k<rowStartA[i+1]; k++)
+      sum += A[k] * p(colA[k]);
+    Ap(i) = sum;
+  }
+
+  return 0;
+}
+
+void
+KrylovLinSOE::setX(int loc, double value)
+{
+  if (loc < X.Size() && loc >= 0)
+    X(loc) = value;
+}
+
+void
+KrylovLinSOE::setX(const Vector &x)
+{
+  if (x.Size() == X.Size())
+    X = x;
+}
+
+const Vector &
+KrylovLinSOE::getX(void)
+{
+  return X;
+}
+
+const Vector &
+KrylovLinSOE::getB(void)
+{
+  return B;
+}
+
+double
+KrylovLinSOE::normRHS(void)
+{
+  return B.Norm();
+}
+
+int
+KrylovLinSOE::setKrylovSolver(KrylovLinSolver &newSolver)
+{
+  newSolver.setLinearSOE(*this);
+  if (X.Size() != 0) {
+    int solverOK = newSolver.setSize();
+    if (solverOK < 0) {
+      opserr << "WARNING KrylovLinSOE::setSolver -";
+      opserr << " the new solver could not setSize() - staying with old\n";
+      return -1;
+    }
+  }
+  return this->LinearSOE::setSolver(newSolver);
+}
+
+int
+KrylovLinSOE::sendSelf(int cTag, Channel &theChannel)
+{
+  return 0;
+}
+
+int
+KrylovLinSOE::recvSelf(int cTag, Channel &theChannel,
+			      FEM_ObjectBroker &theBroker)
+{
+  return 0;
+}
@@ -0,0 +1,80 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the class definition for
+// KrylovLinSOE. KrylovLinSOE is a subclass of LinearSOE.
+// It stores a general sparse matrix A in compressed row form, the column
+// indices of each row sorted; it is solved by a KrylovLinSolver.
+
+#ifndef KrylovLinSOE_h
+#define KrylovLinSOE_h
+
+#include <LinearSOE.h>
+#include <Vector.h>
+#include <SparseScatterMap.h>
+#include <vector>
+
+class KrylovLinSolver;
+
+class KrylovLinSOE : public LinearSOE
+{
+  public:
+    KrylovLinSOE(KrylovLinSolver &theSolver);
+    KrylovLinSOE();
+
+    ~KrylovLinSOE();
+
+    int getNumEqn(void) const;
+    int setSize(Graph &theGraph);
+    int addA(const Matrix &, const ID &, double fact = 1.0);
+    int addB(const Vector &, const ID &, double fact = 1.0);
+    virtual bool isThreadSafe(void) {return true;};
+    int setB(const Vector &, double fact = 1.0);
+
+    void zeroA(void);
+    void zeroB(void);
+
+    const Vector &getX(void);
+    const Vector &getB(void);
+    double normRHS(void);
+
+    int formAp(const Vector &p, Vector &Ap);
+
+    void setX(int loc, double value);
+    void setX(const Vector &x);
+    int setKrylovSolver(KrylovLinSolver &newSolver);
+
+    int sendSelf(int commitTag, Channel &theChannel);
+    int recvSelf(int commitTag, Channel &theChannel,
+		 FEM_ObjectBroker &theBroker);
+
+    friend class KrylovLinSolver;
+
+  protected:
+    bool factored;
+
+  private:
+    Vector X, B;
+    std::vector<int> rowStartA, colA; // A by rows
+    std::vector<double> A;
+    SparseScatterMap theScatterMap;
+};
+
+#endif
@@ -0,0 +1,589 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation for
+// KrylovLinSolver.
+
+#include <KrylovLinSolver.h>
+#include <KrylovLinSOE.h>
+#include <KrylovPreconditioner.h>
+#include <BlockJacobiPreconditioner.h>
+#include <ILUkPreconditioner.h>
+#include <AMGPreconditioner.h>
+#include <Information.h>
+#include <elementAPI.h>
+#include <cmath>
+#include <string.h>
+
+void* OPS_KrylovLinSolver()
+{
+  int method = KrylovLinSolver::PCG;
+  int precond = 1; // 0 none, 1 Jacobi, 2 BlockJacobi, 3 ILU, 4 AMG
+  int blockSize = 1;
+  int fill = 0;
+  double threshold = 0.0;
+  double tol = 1.0e-8;
+  int maxIter = 1000;
+  int restart = 30;
+  int reuse = 1;
+  int numThreads = 1;
+
+  int numdata = 1;
+  while (OPS_GetNumRemainingInputArgs() > 0) {
+    const char *opt = OPS_GetString();
+    if (strcmp(opt, "-method") == 0 || strcmp(opt, "-solver") == 0) {
+      if (OPS_GetNumRemainingInputArgs() < 1) {
+	opserr << "WARNING system Krylov -method PCG|GMRES|BiCGStab\n";
+	return 0;
+      }
+      const char *type = OPS_GetString();
+      if (strcmp(type, "PCG") == 0 || strcmp(type, "CG") == 0)
+	method = KrylovLinSolver::PCG;
+      else if (strcmp(type, "GMRES") == 0)
+	method = KrylovLinSolver::GMRES;
+      else if (strcmp(type, "BiCGStab") == 0)
+	method = KrylovLinSolver::BiCGStab;
+      else {
+	opserr << "WARNING system Krylov - unknown method " << type << "\n";
+	return 0;
+      }
+    } else if (strcmp(opt, "-precond") == 0) {
+      if (OPS_GetNumRemainingInputArgs() < 1) {
+	opserr << "WARNING system Krylov -precond none|Jacobi|BlockJacobi|ILU|AMG\n";
+	return 0;
+      }
+      const char *type = OPS_GetString();
+      if (strcmp(type, "none") == 0)
+	precond = 0;
+      else if (strcmp(type, "Jacobi") == 0)
+	precond = 1;
+      else if (strcmp(type, "BlockJacobi") == 0)
+	precond = 2;
+      else if (strcmp(type, "ILU") == 0)
+	precond = 3;
+      else if (strcmp(type, "AMG") == 0)
+	precond = 4;
+      else {
+	opserr << "WARNING system Krylov - unknown preconditioner " << type << "\n";
+	return 0;
+      }
+    } else if (strcmp(opt, "-blockSize") == 0) {
+      if (OPS_GetNumRemainingInputArgs() < 1 ||
+	  OPS_GetIntInput(&numdata, &blockSize) < 0 || blockSize < 1) {
+	opserr << "WARNING system Krylov -blockSize blockSize - invalid blockSize\n";
+	return 0;
+      }
+    } else if (strcmp(opt, "-fill") == 0) {
+      if (OPS_GetNumRemainingInputArgs() < 1 ||
+	  OPS_GetIntInput(&numdata, &fill) < 0 || fill < 0) {
+	opserr << "WARNING system Krylov -fill levelOfFill - invalid levelOfFill\n";
+	return 0;
+      }
+    } else if (strcmp(opt, "-threshold") == 0) {
+      if (OPS_GetNumRemainingInputArgs() < 1 ||
+	  OPS_GetDoubleInput(&numdata, &threshold) < 0 || threshold < 0.0) {
+	opserr << "WARNING system Krylov -threshold threshold - invalid threshold\n";
+	return 0;
+      }
+    } else if (strcmp(opt, "-tol") == 0) {
+      if (OPS_GetNumRemainingInputArgs() < 1 ||
+	  OPS_GetDoubleInput(&numdata, &tol) < 0 || tol <= 0.0) {
+	opserr << "WARNING system Krylov -tol tol - invalid tol\n";
+	return 0;
+      }
+    } else if (strcmp(opt, "-maxIter") == 0) {
+      if (OPS_GetNumRemainingInputArgs() < 1 ||
+	  OPS_GetIntInput(&numdata, &maxIter) < 0 || maxIter < 1) {
+	opserr << "WARNING system Krylov -maxIter maxIter - invalid maxIter\n";
+	return 0;
+      }
+    } else if (strcmp(opt, "-restart") == 0) {
+      if (OPS_GetNumRemainingInputArgs() < 1 ||
+	  OPS_GetIntInput(&numdata, &restart) < 0 || restart < 1) {
+	opserr << "WARNING system Krylov -restart restart - invalid restart\n";
+	return 0;
+      }
+    } else if (strcmp(opt, "-reuse") == 0) {
+      if (OPS_GetNumRemainingInputArgs() < 1 ||
+	  OPS_GetIntInput(&numdata, &reuse) < 0 || reuse < 1) {
+	opserr << "WARNING system Krylov -reuse numReuse - invalid numReuse\n";
+	return 0;
+      }
+    } else if (strcmp(opt, "-numThreads") == 0) {
+      if (OPS_GetNumRemainingInputArgs() < 1 ||
+	  OPS_GetIntInput(&numdata, &numThreads) < 0 || numThreads < 1) {
+	opserr << "WARNING system Krylov -numThreads numThreads - invalid numThreads\n";
+	return 0;
+      }
+    } else {
+      opserr << "WARNING system Krylov - unknown option " << opt << "\n";
+      return 0;
+    }
+  }
+
+  KrylovPreconditioner *thePrecond = 0;
+  if (precond == 1)
+    thePrecond = new BlockJacobiPreconditioner(1);
+  else if (precond == 2)
+    thePrecond = new BlockJacobiPreconditioner(blockSize);
+  else if (precond == 3)
+    thePrecond = new ILUkPreconditioner(fill);
+  else if (precond == 4)
+    thePrecond = new AMGPreconditioner(blockSize, threshold);
+
+  KrylovLinSolver *theSolver = new KrylovLinSolver(method, thePrecond, tol, maxIter,
+						   restart, reuse, numThreads);
+  return new KrylovLinSOE(*theSolver);
+}
+
+KrylovLinSolver::KrylovLinSolver(int meth, KrylovPreconditioner *precond,
+				 double tolerance, int mIter, int nRestart,
+				 int nReuse, int nThreads)
+  :LinearSOESolver(SOLVER_TAGS_KrylovLinSolver),
+   theSOE(0), thePrecond(precond), method(meth), tol(tolerance),
+   maxIter(mIter), restart(nRestart), reuse(nReuse), numThreads(nThreads),
+   size(0), precondAge(0),
+   numIter(0), totalIter(0), numSolve(0), numPrecond(0), residual(0.0)
+{
+  if (restart < 1)
+    restart = 1;
+  if (reuse < 1)
+    reuse = 1;
+  if (numThreads < 1)
+    numThreads = 1;
+
+#ifndef _OPENMP
+  if (numThreads > 1) {
+    opserr << "WARNING KrylovLinSolver -";
+    opserr << " not built with OpenMP, solver will be serial\n";
+  }
+#endif
+
+  if (thePrecond != 0)
+    thePrecond->setNumThreads(numThreads);
+}
+
+KrylovLinSolver::~KrylovLinSolver()
+{
+  if (thePrecond != 0)
+    delete thePrecond;
+}
+
+int
+KrylovLinSolver::setLinearSOE(KrylovLinSOE &theLinearSOE)
+{
+  theSOE = &theLinearSOE;
+  return 0;
+}
+
+int
+KrylovLinSolver::setSize(void)
+{
+  if (theSOE == 0) {
+    opserr << "WARNING KrylovLinSolver::setSize() - no LinearSOE set\n";
+    return -1;
+  }
+
+  size = theSOE->X.Size();
+  precondAge = 0;
+
+  std::size_t numVectors = 7;
+  if (method == PCG)
+    numVectors = 4;
+  else if (method == GMRES)
+    numVectors = restart + 3;
+  work.assign(numVectors*size, 0.0);
+
+  if (thePrecond != 0)
+    return thePrecond->setSize(size, theSOE->rowStartA.data(),
+			       theSOE->colA.data());
+
+  return 0;
+}
+
+void
+KrylovLinSolver::multiply(const double *x, double *y)
+{
+  KrylovPreconditioner::multiply(size, theSOE->rowStartA.data(),
+				 theSOE->colA.data(), theSOE->A.data(),
+				 x, y, numThreads);
+}
+
+int
+KrylovLinSolver::precondition(const double *r, double *z)
+{
+  if (thePrecond != 0)
+    return thePrecond->apply(r, z);
+
+  for (int i=0; i<size; i++)
+    z[i] = r[i];
+  return 0;
+}
+
+double
+KrylovLinSolver::dot(const double *x, const double *y)
+{
+  int n = size;
+  double result = 0.0;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(numThreads) schedule(static) reduction(+:result) if(n > 2000)
+#endif
+  for (int i=0; i<n; i++)
+    result += x[i]*y[i];
+  return result;
+}
+
+int
+KrylovLinSolver::solve(void)
+{
+  if (theSOE == 0) {
+    opserr << "WARNING KrylovLinSolver::solve() - no LinearSOE set\n";
+    return -1;
+  }
+
+  if (size == 0)
+    return 0;
+
+  // rebuild the preconditioner if A has changed and it has served
+  // reuse matrices
+  if (theSOE->factored == false) {
+    if (thePrecond != 0 && (precondAge == 0 || precondAge >= reuse)) {
+      if (thePrecond->update(theSOE->A.data()) < 0) {
+	opserr << "WARNING KrylovLinSolver::solve() -";
+	opserr << " failed to build the preconditioner\n";
+	return -1;
+      }
+      numPrecond++;
+      precondAge = 0;
+    }
+    precondAge++;
+    theSOE->factored = true;
+  }
+
+  double *x = &(theSOE->X(0));
+  const double *b = &(theSOE->B(0));
+  for (int i=0; i<size; i++)
+    x[i] = 0.0;
+
+  numIter = 0;
+  residual = 0.0;
+  numSolve++;
+
+  int result;
+  if (method == GMRES)
+    result = this->solveGMRES(x, b);
+  else if (method == BiCGStab)
+    result = this->solveBiCGStab(x, b);
+  else
+    result = this->solvePCG(x, b);
+
+  totalIter += numIter;
+
+  if (result < 0) {
+    opserr << "WARNING KrylovLinSolver::solve() - no convergence after ";
+    opserr << numIter << " iterations, relative residual " << residual << endln;
+    return -1;
+  }
+
+  return 0;
+}
+
+int
+KrylovLinSolver::solvePCG(double *x, const double *b)
+{
+  int n = size;
+  double *r = &work[0];
+  double *z = &work[n];
+  double *p = &work[2*(std::size_t)n];
+  double *q = &work[3*(std::size_t)n];
+
+  double bNorm = sqrt(this->dot(b, b));
+  if (bNorm == 0.0)
+    return 0;
+
+  for (int i=0; i<n; i++)
+    r[i] = b[i];
+  if (this->precondition(r, z) < 0)
+    return -1;
+  for (int i=0; i<n; i++)
+    p[i] = z[i];
+  double rz = this->dot(r, z);
+
+  while (numIter < maxIter) {
+    this->multiply(p, q);
+    double pq = this->dot(p, q);
+    if (pq == 0.0)
+      return -1;
+    double alpha = rz/pq;
+
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(numThreads) schedule(static) if(n > 2000)
+#endif
+    for (int i=0; i<n; i++) {
+      x[i] += alpha*p[i];
+      r[i] -= alpha*q[i];
+    }
+    numIter++;
+
+    residual = sqrt(this->dot(r, r))/bNorm;
+    if (residual <= tol)
+      return 0;
+
+    if (this->precondition(r, z) < 0)
+      return -1;
+    double rzNew = this->dot(r, z);
+    double beta = rzNew/rz;
+    rz = rzNew;
+
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(numThreads) schedule(static) if(n > 2000)
+#endif
+    for (int i=0; i<n; i++)
+      p[i] = z[i] + beta*p[i];
+  }
+
+  return -1;
+}
+
+int
+KrylovLinSolver::solveGMRES(double *x, const double *b)
+{
+  int n = size;
+  int m = restart;
+  double *r = &work[0];
+  double *w = &work[n];
+  double *V = &work[2*(std::size_t)n]; // m+1 basis vectors
+
+  std::vector<double> H((std::size_t)(m+1)*m); // column major
+  std::vector<double> c(m), s(m), g(m+1), y(m);
+
+  double bNorm = sqrt(this->dot(b, b));
+  if (bNorm == 0.0)
+    return 0;
+
+  for (int i=0; i<n; i++)
+    r[i] = b[i];
+  double beta = bNorm;
+
+  while (numIter < maxIter) {
+    double *v0 = V;
+    for (int i=0; i<n; i++)
+      v0[i] = r[i]/beta;
+    for (int k=0; k<=m; k++)
+      g[k] = 0.0;
+    g[0] = beta;
+
+    int j = 0;
+    while (j < m && numIter < maxIter) {
+      double *vj = &V[(std::size_t)j*n];
+      double *vNext = &V[(std::size_t)(j+1)*n];
+      double *h = &H[(std::size_t)j*(m+1)];
+
+      // w = A inv(M) vj, orthogonalized by modified Gram-Schmidt
+      if (this->precondition(vj, r) < 0)
+	return -1;
+      this->multiply(r, w);
+      for (int k=0; k<=j; k++) {
+	double *vk = &V[(std::size_t)k*n];
+	double hkj = this->dot(w, vk);
+	for (int i=0; i<n; i++)
+	  w[i] -= hkj*vk[i];
+	h[k] = hkj;
+      }
+      double hNorm = sqrt(this->dot(w, w));
+      h[j+1] = hNorm;
+      if (hNorm != 0.0)
+	for (int i=0; i<n; i++)
+	  vNext[i] = w[i]/hNorm;
+
+      // apply the previous rotations and eliminate h[j+1]
+      for (int k=0; k<j; k++) {
+	double tmp = c[k]*h[k] + s[k]*h[k+1];
+	h[k+1] = -s[k]*h[k] + c[k]*h[k+1];
+	h[k] = tmp;
+      }
+      double denom = sqrt(h[j]*h[j] + h[j+1]*h[j+1]);
+      if (denom == 0.0)
+	return -1;
+      c[j] = h[j]/denom;
+      s[j] = h[j+1]/denom;
+      h[j] = denom;
+      h[j+1] = 0.0;
+      g[j+1] = -s[j]*g[j];
+      g[j] = c[j]*g[j];
+
+      j++;
+      numIter++;
+      residual = fabs(g[j])/bNorm;
+      if (residual <= tol || hNorm == 0.0)
+	break;
+    }
+
+    // x += inv(M) V y, with H y = g
+    for (int k=j-1; k>=0; k--) {
+      double sum = g[k];
+      for (int l=k+1; l<j; l++)
+	sum -= H[(std::size_t)l*(m+1)+k]*y[l];
+      y[k] = sum/H[(std::size_t)k*(m+1)+k];
+    }
+    for (int i=0; i<n; i++)
+      w[i] = 0.0;
+    for (int k=0; k<j; k++) {
+      double *vk = &V[(std::size_t)k*n];
+      for (int i=0; i<n; i++)
+	w[i] += y[k]*vk[i];
+    }
+    if (this->precondition(w, r) < 0)
+      return -1;
+    for (int i=0; i<n; i++)
+      x[i] += r[i];
+
+    // true residual for the restart
+    this->multiply(x, w);
+    for (int i=0; i<n; i++)
+      r[i] = b[i] - w[i];
+    beta = sqrt(this->dot(r, r));
+    residual = beta/bNorm;
+    if (residual <= tol)
+      return 0;
+  }
+
+  return -1;
+}
+
+int
+KrylovLinSolver::solveBiCGStab(double *x, const double *b)
+{
+  int n = size;
+  double *r = &work[0];
+  double *rHat = &work[n];
+  double *p = &work[2*(std::size_t)n];
+  double *v = &work[3*(std::size_t)n];
+  double *pHat = &work[4*(std::size_t)n];
+  double *sHat = &work[5*(std::size_t)n];
+  double *t = &work[6*(std::size_t)n];
+
+  double bNorm = sqrt(this->dot(b, b));
+  if (bNorm == 0.0)
+    return 0;
+
+  for (int i=0; i<n; i++) {
+    r[i] = b[i];
+    rHat[i] = b[i];
+    p[i] = 0.0;
+    v[i] = 0.0;
+  }
+  double rho = 1.0;
+  double alpha = 1.0;
+  double omega = 1.0;
+
+  while (numIter < maxIter) {
+    double rhoNew = this->dot(rHat, r);
+    if (rhoNew == 0.0)
+      return -1;
+    double beta = (rhoNew/rho)*(alpha/omega);
+    rho = rhoNew;
+    for (int i=0; i<n; i++)
+      p[i] = r[i] + beta*(p[i] - omega*v[i]);
+
+    if (this->precondition(p, pHat) < 0)
+      return -1;
+    this->multiply(pHat, v);
+    double rHatV = this->dot(rHat, v);
+    if (rHatV == 0.0)
+      return -1;
+    alpha = rho/rHatV;
+
+    // s = r - alpha v is kept in r
+    for (int i=0; i<n; i++) {
+      r[i] -= alpha*v[i];
+      x[i] += alpha*pHat[i];
+    }
+    numIter++;
+    residual = sqrt(this->dot(r, r))/bNorm;
+    if (residual <= tol)
+      return 0;
+
+    if (this->precondition(r, sHat) < 0)
+      return -1;
+    this->multiply(sHat, t);
+    double tt = this->dot(t, t);
+    if (tt == 0.0)
+      return -1;
+    omega = this->dot(t, r)/tt;
+
+    for (int i=0; i<n; i++) {
+      x[i] += omega*sHat[i];
+      r[i] -= omega*t[i];
+    }
+    residual = sqrt(this->dot(r, r))/bNorm;
+    if (residual <= tol)
+      return 0;
+    if (omega == 0.0)
+      return -1;
+  }
+
+  return -1;
+}
+
+int
+KrylovLinSolver::getVariable(const char *variable, Information &theInfo)
+{
+  if (strcmp(variable, "numIter") == 0) {
+    theInfo.theType = IntType;
+    theInfo.setInt(numIter);
+  } else if (strcmp(variable, "totalIter") == 0) {
+    theInfo.theType = IntType;
+    theInfo.setInt(totalIter);
+  } else if (strcmp(variable, "numSolve") == 0) {
+    theInfo.theType = IntType;
+    theInfo.setInt(numSolve);
+  } else if (strcmp(variable, "numPrecond") == 0) {
+    theInfo.theType = IntType;
+    theInfo.setInt(numPrecond);
+  } else if (strcmp(variable, "residual") == 0) {
+    theInfo.theType = DoubleType;
+    theInfo.setDouble(residual);
+  } else if (strcmp(variable, "numLevels") == 0) {
+    AMGPreconditioner *theAMG = dynamic_cast<AMGPreconditioner *>(thePrecond);
+    if (theAMG == 0)
+      return -1;
+    theInfo.theType = IntType;
+    theInfo.setInt(theAMG->getNumLevels());
+  } else
+    return -1;
+
+  return 0;
+}
+
+int
+KrylovLinSolver::sendSelf(int cTag, Channel &theChannel)
+{
+  // nothing to do
+  return 0;
+}
+
+int
+KrylovLinSolver::recvSelf(int cTag, Channel &theChannel,
+			  FEM_ObjectBroker &theBroker)
+{
+  // nothing to do
+  return 0;
+}
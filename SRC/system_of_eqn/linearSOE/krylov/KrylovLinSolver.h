@@ -0,0 +1,93 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the class definition for
+// KrylovLinSolver. It solves a KrylovLinSOE by a preconditioned Krylov
+// subspace method: conjugate gradients (PCG) for symmetric positive
+// definite systems, or restarted GMRES and BiCGStab, both right
+// preconditioned, for general ones. The preconditioner is rebuilt from
+// the new A only every reuse-th time A changes, so that with a Newton
+// algorithm an expensive preconditioner (ILU(k), AMG) can serve several
+// tangents. The matrix-vector products and vector operations are shared
+// amongst numThreads threads when built with OpenMP.
+
+#ifndef KrylovLinSolver_h
+#define KrylovLinSolver_h
+
+#include <LinearSOESolver.h>
+#include <vector>
+
+class KrylovLinSOE;
+class KrylovPreconditioner;
+
+class KrylovLinSolver : public LinearSOESolver
+{
+  public:
+    enum Method {PCG, GMRES, BiCGStab};
+
+    KrylovLinSolver(int method = PCG, KrylovPreconditioner *thePrecond = 0,
+		    double tol = 1.0e-8, int maxIter = 1000, int restart = 30,
+		    int reuse = 1, int numThreads = 1);
+    ~KrylovLinSolver();
+
+    int solve(void);
+    int setSize(void);
+
+    int setLinearSOE(KrylovLinSOE &theSOE);
+
+    // numIter, totalIter, numSolve, numPrecond, residual and numLevels
+    int getVariable(const char *variable, Information &theInfo);
+
+    int sendSelf(int commitTag, Channel &theChannel);
+    int recvSelf(int commitTag, Channel &theChannel,
+		 FEM_ObjectBroker &theBroker);
+
+  protected:
+
+  private:
+    void multiply(const double *x, double *y);
+    int precondition(const double *r, double *z);
+    double dot(const double *x, const double *y);
+
+    int solvePCG(double *x, const double *b);
+    int solveGMRES(double *x, const double *b);
+    int solveBiCGStab(double *x, const double *b);
+
+    KrylovLinSOE *theSOE;
+    KrylovPreconditioner *thePrecond;
+    int method;
+    double tol;
+    int maxIter;
+    int restart;
+    int reuse;
+    int numThreads;
+
+    int size;
+    int precondAge;    // number of matrices the preconditioner has served
+    std::vector<double> work;
+
+    int numIter;       // of the last solve
+    int totalIter;
+    int numSolve;
+    int numPrecond;
+    double residual;   // |b - Ax|/|b| of the last solve
+};
+
+#endif
@@ -0,0 +1,57 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation for
+// KrylovPreconditioner.
+
+#include <KrylovPreconditioner.h>
+
+KrylovPreconditioner::KrylovPreconditioner()
+  :numThreads(1)
+{
+
+}
+
+KrylovPreconditioner::~KrylovPreconditioner()
+{
+
+}
+
+void
+KrylovPreconditioner::setNumThreads(int nThreads)
+{
+  numThreads = (nThreads < 1) ? 1 : nThreads;
+}
+
+void
+KrylovPreconditioner::multiply(int n, const int *rowStart, const int *colIndex,
+			       const double *A, const double *x, double *y,
+			       int numThreads)
+{
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(numThreads) schedule(static) if(n > 2000)
+#endif
+  for (int i=0; i<n; i++) {
+    double sum = 0.0;
+    for (int k=rowStart[i]; k<rowStart[i+1]; k++)
+      sum += A[k] * x[colIndex[k]];
+    y[i] = sum;
+  }
+}
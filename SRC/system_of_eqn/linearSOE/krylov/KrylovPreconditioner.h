@@ -0,0 +1,57 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the class definition for
+// KrylovPreconditioner, the abstract base class of the preconditioners
+// used by a KrylovLinSolver. A preconditioner works on a square matrix
+// in compressed row form, the column indices of each row sorted.
+// setSize() is invoked when the sparsity pattern changes and update()
+// when the preconditioner is to be rebuilt from new values of A;
+// apply() then returns z = inv(M) r. The static multiply() is the
+// (multithreaded) matrix-vector product shared by the solver and the
+// preconditioners.
+
+#ifndef KrylovPreconditioner_h
+#define KrylovPreconditioner_h
+
+class KrylovPreconditioner
+{
+  public:
+    KrylovPreconditioner();
+    virtual ~KrylovPreconditioner();
+
+    virtual int setSize(int n, const int *rowStart, const int *colIndex) = 0;
+    virtual int update(const double *A) = 0;
+    virtual int apply(const double *r, double *z) = 0;
+
+    void setNumThreads(int numThreads);
+
+    // y = A x
+    static void multiply(int n, const int *rowStart, const int *colIndex,
+			 const double *A, const double *x, double *y,
+			 int numThreads = 1);
+
+  protected:
+    int numThreads;
+
+  private:
+};
+
+#endif
@@ -143,6 +143,7 @@ MumpsParallelSOE::setSize(Graph &theGraph)
     for (int j=0; j<numChannels; j++) {
       Channel *theChannel = theChannels[j];
       theChannel->sendID(0, 0, data);
+      theChannel->flush();
     }
     size = maxVertexTag;
   }
@@ -325,6 +326,7 @@ MumpsParallelSOE::solve(void)
     // send B
     Channel *theChannel = theChannels[0];
     theChannel->sendVector(0, 0, *myVectB);
+    theChannel->flush();
 
     resSolver =  this->LinearSOE::solve();
 
@@ -362,6 +364,7 @@ MumpsParallelSOE::solve(void)
 	Channel *theChannel = theChannels[j];
 	theChannel->sendVector(0, 0, *vectX);
 	theChannel->sendVector(0, 0, *vectB);
+	theChannel->flush();
       }
     }
   } 
@@ -485,6 +488,7 @@ MumpsParallelSOE::getB(void)
     for (int j=0; j<numChannels; j++) {
       Channel *theChannel = theChannels[j];
       theChannel->sendVector(0, 0, *vectB);
+      theChannel->flush();
     }
   } 
 
@@ -42,6 +42,7 @@
 #include <f2c.h>
 #include <math.h>
 #include <Channel.h>
+#include <MPI_Channel.h>
 #include <FEM_ObjectBroker.h>
 
 ActorPetscSOE::ActorPetscSOE(PetscSolver &theSOESolver, int blockSize)
@@ -55,6 +56,7 @@ ActorPetscSOE::ActorPetscSOE(PetscSolver &theSOESolver, int blockSize)
     opserr << " ActorPetscSOE::ActorPetscSOE - must be rank 0\n";
   }
   recvBuffer = (void *)(&recvData[0]);
+  MPI_Channel::flushAll();
   MPI_Barrier(PETSC_COMM_WORLD);
 
 /***************
@@ -153,6 +155,7 @@ ActorPetscSOE::run(void)
   void *buffer = 0;
   
   while (flag != 0) {
+    MPI_Channel::flushAll();
     MPI_Bcast(recvBuffer, 3, MPI_INT, 0, PETSC_COMM_WORLD);  
     flag = recvData[0];
     switch(flag) {
@@ -37,6 +37,7 @@
 #include <f2c.h>
 #include <math.h>
 #include <Channel.h>
+#include <MPI_Channel.h>
 #include <FEM_ObjectBroker.h>
 
 
@@ -251,6 +252,7 @@ PetscSOE::setSize(Graph &theGraph)
     {
       Channel *theChannel = theChannels[j];
       theChannel->sendID(0, 0, data);
+      theChannel->flush();
     }
   }
 
@@ -359,6 +361,7 @@ PetscSOE::setSize(Graph &theGraph)
   // cout << "Processor " << processID_world << " owns " << nlocaldofs[processID_world] << " DOFS.\n";
 
   //Now gather across all processes so we can determine a reasonable partition of
+  MPI_Channel::flushAll();
   MPI_Allgather(&my_nlocaldofs, 1, MPI_INT, &nlocaldofs, 1, MPI_INT,
                 MPI_COMM_WORLD);
 
@@ -514,6 +517,7 @@ PetscSOE::setSize(Graph &theGraph)
     }
 
     // Now reduce the arrays to one global one in the local processor
+    MPI_Channel::flushAll();
     for (int proc = 0; proc < numProcesses; proc++)
     {
       MPI_Reduce(
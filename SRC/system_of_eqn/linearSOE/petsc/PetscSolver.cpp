@@ -175,6 +175,7 @@ PetscSolver::solve(void)
         {
             Channel *theChannel = theChannels[j];
             theChannel->sendVector(0, 0, *vectB);
+            theChannel->flush();
         }
     }
     PETSCSOLVER_DEBUGOUT << "PetscSolver::solve (" << processID << ") FormBEnd\n";
@@ -239,6 +240,7 @@ PetscSolver::solve(void)
         {
             Channel *theChannel = theChannels[j];
             theChannel->sendVector(0, 0, *vectX);
+            theChannel->flush();
         }
     }
 
@@ -41,6 +41,7 @@
 #include <f2c.h>
 #include <math.h>
 #include <Channel.h>
+#include <MPI_Channel.h>
 #include <FEM_ObjectBroker.h>
 
 ShadowPetscSOE::ShadowPetscSOE(PetscSolver &theSOESolver, int bs)
@@ -56,6 +57,7 @@ ShadowPetscSOE::ShadowPetscSOE(PetscSolver &theSOESolver, int bs)
     opserr << " ShadowPetscSOE::ShadowPetscSOE - must be rank 0\n";
   }
   sendBuffer = (void *)(&sendData[0]);
+  MPI_Channel::flushAll();
   MPI_Barrier(PETSC_COMM_WORLD);
 
 /************
@@ -125,6 +127,7 @@ ShadowPetscSOE::ShadowPetscSOE(PetscSolver &theSOESolver, int bs)
   // now send the data to the remote actor objects
   sendData[0] = petscMethod;
   sendData[1] = petscPre;
+  MPI_Channel::flushAll();
   MPI_Bcast(sendBuffer, 3, MPI_INT, 0, PETSC_COMM_WORLD);    
 **********/
 
@@ -140,6 +143,7 @@ ShadowPetscSOE::getNumEqn(void) const
 ShadowPetscSOE::~ShadowPetscSOE()
 {
   sendData[0] = 0;
+  MPI_Channel::flushAll();
   MPI_Bcast(sendBuffer, 3, MPI_INT, 0, PETSC_COMM_WORLD);
   MPI_Barrier(PETSC_COMM_WORLD);
 }
@@ -150,6 +154,7 @@ ShadowPetscSOE::solve(void)
 {
   sendData[0] = 1;
   sendData[1] = theSOE.isFactored;
+  MPI_Channel::flushAll();
   MPI_Bcast(sendBuffer, 3, MPI_INT, 0, PETSC_COMM_WORLD);
   return theSOE.solve();
 }
@@ -226,6 +231,7 @@ ShadowPetscSOE::setSize(Graph &theGraph)
 
   // now for each of the SOE's we determine how to invoke setSizeParallel()
   sendData[0] = 2;
+  MPI_Channel::flushAll();
   MPI_Bcast(sendBuffer, 3, MPI_INT, 0, PETSC_COMM_WORLD);
 
   int dnz = 0;
@@ -287,6 +293,7 @@ ShadowPetscSOE::setSize(Graph &theGraph)
   // we broadcast again before we start setSizeParallel()
   // this is because Petsc all processes need to call setup at same
   // time .. if don't we hang
+  MPI_Channel::flushAll();
   MPI_Bcast(sendBuffer, 3, MPI_INT, 0, PETSC_COMM_WORLD);  
   result = theSOE.setSizeParallel(numRows, n, dnz, dnnz, onz, onnz);
 
@@ -328,6 +335,7 @@ void
 ShadowPetscSOE::zeroA(void)
 {
   sendData[0] = 3;
+  MPI_Channel::flushAll();
   MPI_Bcast(sendBuffer, 3, MPI_INT, 0, PETSC_COMM_WORLD);
   theSOE.zeroA();
 }
@@ -336,6 +344,7 @@ void
 ShadowPetscSOE::zeroB(void)
 {
   sendData[0] = 4;
+  MPI_Channel::flushAll();
   MPI_Bcast(sendBuffer, 3, MPI_INT, 0, PETSC_COMM_WORLD);
   theSOE.zeroB();
 }
@@ -345,6 +354,7 @@ const Vector &
 ShadowPetscSOE::getX(void)
 {
   sendData[0] = 5;
+  MPI_Channel::flushAll();
   MPI_Bcast(sendBuffer, 3, MPI_INT, 0, PETSC_COMM_WORLD);
 
 
@@ -383,6 +393,7 @@ const Vector &
 ShadowPetscSOE::getB(void)
 {
   sendData[0] = 6;
+  MPI_Channel::flushAll();
   MPI_Bcast(sendBuffer, 3, MPI_INT, 0, PETSC_COMM_WORLD);
 
   // STOP ****** some more work here
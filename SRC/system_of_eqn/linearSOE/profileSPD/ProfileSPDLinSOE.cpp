@@ -175,26 +175,22 @@ ProfileSPDLinSOE::setSize(Graph &theGraph)
     }
 
     // now we go through the vertices to find the height of each col and
-    // width of each row from the connectivity information.
+    // width of each row from the connectivity information; the adjacency
+    // of each vertex is sorted so the height is set by its first entry.
     
-    Vertex *vertexPtr;
-    VertexIter &theVertices = theGraph.getVertices();
-
-    while ((vertexPtr = theVertices()) != 0) {
-	int vertexNum = vertexPtr->getTag();
-	const ID &theAdjacency = vertexPtr->getAdjacency();
-	int iiDiagLoc = iDiagLoc[vertexNum];
-	int *iiDiagLocPtr = &(iDiagLoc[vertexNum]);
-
-	for (int i=0; i<theAdjacency.Size(); i++) {
-	    int otherNum = theAdjacency(i);
-	    int diff = vertexNum-otherNum;
-	    if (diff > 0) {
-		if (iiDiagLoc < diff) {
-		    iiDiagLoc = diff;
-		    *iiDiagLocPtr = diff;
-		}
-	    } 
+    const int *rowStart, *adjacency;
+    if (theGraph.getCSR(rowStart, adjacency) < 0) {
+	opserr << "WARNING ProfileSPDLinSOE::setSize :";
+	opserr << " vertices not numbered 0 through size-1 - size set to 0\n";
+	size = 0;
+	return -1;
+    }
+
+    for (int vertexNum=0; vertexNum<size; vertexNum++) {
+	if (rowStart[vertexNum+1] > rowStart[vertexNum]) {
+	    int diff = vertexNum - adjacency[rowStart[vertexNum]];
+	    if (diff > 0)
+		iDiagLoc[vertexNum] = diff;
 	}
     }
 
@@ -34,6 +34,7 @@
 #include <cmath>
 #include <Timer.h>
 #include <mpi.h>
+#include <MPI_Channel.h>
 
 PFEMCompressibleSolver_Mumps::PFEMCompressibleSolver_Mumps(int r, int e, int s)
     :PFEMCompressibleSolver(), theSOE(0),
@@ -76,6 +77,7 @@ PFEMCompressibleSolver_Mumps::solve()
     int Psize = Mp.Size();
     int size = B.Size();
 
+    MPI_Channel::flushAll();
     MPI_Bcast(&Vsize, 1, MPI_INT, 0, MPI_COMM_WORLD);
     MPI_Bcast(&Psize, 1, MPI_INT, 0, MPI_COMM_WORLD);
     MPI_Bcast(&size, 1, MPI_INT, 0, MPI_COMM_WORLD);
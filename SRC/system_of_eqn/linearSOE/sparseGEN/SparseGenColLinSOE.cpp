@@ -168,14 +168,15 @@ SparseGenColLinSOE::setSize(Graph &theGraph)
     int oldSize = size;
     size = theGraph.getNumVertex();
 
-    // fist itearte through the vertices of the graph to get nnz
-    Vertex *theVertex;
-    int newNNZ = 0;
-    VertexIter &theVertices = theGraph.getVertices();
-    while ((theVertex = theVertices()) != 0) {
-	const ID &theAdjacency = theVertex->getAdjacency();
-	newNNZ += theAdjacency.Size() +1; // the +1 is for the diag entry
+    // the adjacency of the graph in compressed row form gives nnz
+    const int *rowStart, *adjacency;
+    if (theGraph.getCSR(rowStart, adjacency) < 0) {
+	opserr << "WARNING:SparseGenColLinSOE::setSize :";
+	opserr << " vertices not numbered 0 through size-1 - size set to 0\n";
+	size = 0;
+	return -1;
     }
+    int newNNZ = rowStart[size] + size; // the +size is for the diag entries
     nnz = newNNZ;
 
     if (newNNZ > Asize) { // we have to get more space for A and rowA
@@ -248,49 +249,26 @@ SparseGenColLinSOE::setSize(Graph &theGraph)
     // fill in colStartA and rowA
     if (size != 0) {
       colStartA[0] = 0;
-      int startLoc = 0;
       int lastLoc = 0;
       for (int a=0; a<size; a++) {
 
-	theVertex = theGraph.getVertexPtr(a);
-	if (theVertex == 0) {
-	  opserr << "WARNING:SparseGenColLinSOE::setSize :";
-	  opserr << " vertex " << a << " not in graph! - size set to 0\n";
-	  size = 0;
-	  return -1;
-	}
-
-	rowA[lastLoc++] = theVertex->getTag(); // place diag in first
-	const ID &theAdjacency = theVertex->getAdjacency();
-	int idSize = theAdjacency.Size();
-	
-	// now we have to place the entries in the ID into order in rowA
-	for (int i=0; i<idSize; i++) {
-
-	  int row = theAdjacency(i);
-	  bool foundPlace = false;
-	  // find a place in rowA for current col
-	  for (int j=startLoc; j<lastLoc; j++)
-	    if (rowA[j] > row) { 
-	      // move the entries already there one further on
-	      // and place col in current location
-	      for (int k=lastLoc; k>j; k--)
-		
-		rowA[k] = rowA[k-1];
-	      rowA[j] = row;
-	      foundPlace = true;
-	      j = lastLoc;
-	    }
-	  if (foundPlace == false) // put in at the end
-	    rowA[lastLoc] = row;
+	// the adjacency is sorted, the diag is placed in order among it
+	int i = rowStart[a];
+	for (; i<rowStart[a+1] && adjacency[i] < a; i++)
+	  rowA[lastLoc++] = adjacency[i];
+	rowA[lastLoc++] = a;
+	for (; i<rowStart[a+1]; i++)
+	  rowA[lastLoc++] = adjacency[i];
 
-	  lastLoc++;
-	}
-	colStartA[a+1] = lastLoc;;	    
-	startLoc = lastLoc;
+	colStartA[a+1] = lastLoc;
       }
     }
 
+    // locations of the FE_Element and DOF_Group entries in A
+    if (theModel != 0 && result == 0)
+	theScatterMap.setSize(*theModel, colStartA, rowA, size);
+    else
+	theScatterMap.clear();
     
     // invoke setSize() on the Solver    
     LinearSOESolver *the_Solver = this->getSolver();
@@ -319,6 +297,23 @@ SparseGenColLinSOE::addA(const Matrix &m, const ID &id, double fact)
 	opserr << " - Matrix and ID not of similar sizes\n";
 	return -1;
     }
+
+    // if the locations were computed in setSize() add the entries directly
+    const int *loc = theScatterMap.getLocations(id);
+    if (loc != 0 && idSize == m.noRows() && idSize == m.noCols()) {
+	if (fact == 1.0) { // do not need to multiply 
+	    for (int j=0; j<idSize; j++)
+		for (int i=0; i<idSize; i++, loc++)
+		    if (*loc >= 0)
+			A[*loc] += m(i,j);
+	} else {
+	    for (int j=0; j<idSize; j++)
+		for (int i=0; i<idSize; i++, loc++)
+		    if (*loc >= 0)
+			A[*loc] += fact * m(i,j);
+	}
+	return 0;
+    }
     
     if (fact == 1.0) { // do not need to multiply 
       for (int i=0; i<idSize; i++) {
@@ -38,6 +38,7 @@
 
 #include <LinearSOE.h>
 #include <Vector.h>
+#include <SparseScatterMap.h>
 
 class SparseGenColLinSolver;
 
@@ -57,6 +58,7 @@ class SparseGenColLinSOE : public LinearSOE
     virtual int setSize(Graph &theGraph);
     virtual int addA(const Matrix &, const ID &, double fact = 1.0);
     virtual int addB(const Vector &, const ID &, double fact = 1.0);    
+    virtual bool isThreadSafe(void) {return true;};
     virtual int setB(const Vector &, double fact = 1.0);        
     
     virtual void zeroA(void);
@@ -100,6 +102,7 @@ class SparseGenColLinSOE : public LinearSOE
     Vector *vectB;    
     int Asize, Bsize;    // size of the 1d array holding A
     bool factored;
+    SparseScatterMap theScatterMap; // locations in A of the FE and DOF entries
     
   private:
 
@@ -38,6 +38,7 @@
 
 #include <LinearSOE.h>
 #include <Vector.h>
+#include <SparseScatterMap.h>
 
 class SparseGenRowLinSolver;
 
@@ -52,6 +53,7 @@ class SparseGenRowLinSOE : public LinearSOE
     int setSize(Graph &theGraph);
     int addA(const Matrix &, const ID &, double fact = 1.0);
     int addB(const Vector &, const ID &, double fact = 1.0);    
+    virtual bool isThreadSafe(void) {return true;};
     int setB(const Vector &, double fact = 1.0);        
     
     void zeroA(void);
@@ -87,6 +89,7 @@ class SparseGenRowLinSOE : public LinearSOE
     Vector *vectB;    
     int Asize, Bsize;    // size of the 1d array holding A
     bool factored;
+    SparseScatterMap theScatterMap; // locations in A of the FE and DOF entries
 };
 
 
@@ -126,14 +126,15 @@ int SymSparseLinSOE::setSize(Graph &theGraph)
     int oldSize = size;
     size = theGraph.getNumVertex();
 
-    // first itearte through the vertices of the graph to get nnz
-    Vertex *theVertex;
-    int newNNZ = 0;
-    VertexIter &theVertices = theGraph.getVertices();
-    while ((theVertex = theVertices()) != 0) {
-        const ID &theAdjacency = theVertex->getAdjacency();
-	newNNZ += theAdjacency.Size(); 
+    // the adjacency of the graph in compressed row form gives nnz
+    const int *adjStart, *adjacency;
+    if (theGraph.getCSR(adjStart, adjacency) < 0) {
+        opserr << "WARNING:SymSparseLinSOE::setSize :";
+        opserr << " vertices not numbered 0 through size-1 - size set to 0\n";
+        size = 0;
+        return -1;
     }
+    int newNNZ = adjStart[size];
     nnz = newNNZ;
  
     colA = new (nothrow) int[newNNZ];	
@@ -191,44 +192,12 @@ int SymSparseLinSOE::setSize(Graph &theGraph)
     // fill in rowStartA and colA
     if (size != 0) {
         rowStartA[0] = 0;
-        int startLoc = 0;
-	int lastLoc = 0;
 
+	// the adjacency of each vertex is already in order
 	for (int a=0; a<size; a++) {
-	   theVertex = theGraph.getVertexPtr(a);
-	   if (theVertex == 0) {
-	        opserr << "WARNING:SymSparseLinSOE::setSize :";
-	        opserr << " vertex " << a << " not in graph! - size set to 0\n";
-	        size = 0;
-	        return -1;
-	   }
-
-	   const ID &theAdjacency = theVertex->getAdjacency();
-	   int idSize = theAdjacency.Size();
-	
-	// now we have to place the entries in the ID into order in colA
-	   for (int i=0; i<idSize; i++) {
-	      int row = theAdjacency(i);
-	      bool foundPlace = false;
-	 
-	      for (int j=startLoc; j<lastLoc; j++)
-	          if (colA[j] > row) { 
-	      // move the entries already there one further on
-	      // and place col in current location
-	              for (int k=lastLoc; k>j; k--)
-		          colA[k] = colA[k-1];
-                      colA[j] = row;
-		      foundPlace = true;
-    	              j = lastLoc;
-		  }
-		  
-	      if (foundPlace == false) // put in at the end
-	      	   colA[lastLoc] = row;
-
-	      lastLoc++;
-	   }
-	   rowStartA[a+1] = lastLoc;;	    
-	   startLoc = lastLoc;
+	   for (int i=adjStart[a]; i<adjStart[a+1]; i++)
+	      colA[i] = adjacency[i];
+	   rowStartA[a+1] = adjStart[a+1];
 	}
     }
     
@@ -0,0 +1,314 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation for
+// SupernodalSPDLinSOE.
+
+#include <SupernodalSPDLinSOE.h>
+#include <SupernodalSPDLinSolver.h>
+#include <Matrix.h>
+#include <Graph.h>
+#include <Vertex.h>
+#include <VertexIter.h>
+#include <Channel.h>
+#include <FEM_ObjectBroker.h>
+#include <ID.h>
+
+SupernodalSPDLinSOE::SupernodalSPDLinSOE(SupernodalSPDLinSolver &the_Solver)
+  :LinearSOE(the_Solver, LinSOE_TAGS_SupernodalSPDLinSOE),
+   factored(false), X(), B(), colStartA(), rowA(), A()
+{
+  the_Solver.setLinearSOE(*this);
+}
+
+SupernodalSPDLinSOE::SupernodalSPDLinSOE()
+  :LinearSOE(LinSOE_TAGS_SupernodalSPDLinSOE),
+   factored(false), X(), B(), colStartA(), rowA(), A()
+{
+
+}
+
+SupernodalSPDLinSOE::~SupernodalSPDLinSOE()
+{
+
+}
+
+int
+SupernodalSPDLinSOE::getNumEqn(void) const
+{
+  return X.Size();
+}
+
+int
+SupernodalSPDLinSOE::setSize(Graph &theGraph)
+{
+  int size = theGraph.getNumVertex();
+  if (size < 0) {
+    opserr << "WARNING SupernodalSPDLinSOE::setSize - size of soe < 0\n";
+    return -1;
+  }
+
+  const int *rowStart, *adjacency;
+  if (theGraph.getCSR(rowStart, adjacency) < 0) {
+    opserr << "WARNING SupernodalSPDLinSOE::setSize -";
+    opserr << " vertices not numbered 0 through size-1 - size set to 0\n";
+    colStartA.assign(1, 0);
+    rowA.clear();
+    A.clear();
+    X.resize(0);
+    B.resize(0);
+    return -1;
+  }
+
+  // fill in colStartA and rowA with the lower triangle, the diagonal
+  // first in each column; the adjacency of each vertex is sorted
+  colStartA.assign(1, 0);
+  rowA.clear();
+  colStartA.reserve(size+1);
+  rowA.reserve(size + rowStart[size]/2);
+
+  for (int a=0; a<size; a++) {
+    rowA.push_back(a);
+    for (int i=rowStart[a]; i<rowStart[a+1]; i++)
+      if (adjacency[i] > a)
+	rowA.push_back(adjacency[i]);
+    colStartA.push_back(rowA.size());
+  }
+
+  A.assign(rowA.size(), 0.0);
+  B.resize(size);
+  B.Zero();
+  X.resize(size);
+  X.Zero();
+  factored = false;
+
+  // locations of the FE_Element and DOF_Group entries in A
+  if (theModel != 0)
+    theScatterMap.setSize(*theModel, colStartA.data(), rowA.data(), size);
+  else
+    theScatterMap.clear();
+
+  // invoke setSize() on the Solver
+  LinearSOESolver *the_Solver = this->getSolver();
+  int solverOK = the_Solver->setSize();
+  if (solverOK < 0) {
+    opserr << "WARNING SupernodalSPDLinSOE::setSize -";
+    opserr << " solver failed setSize()\n";
+    return solverOK;
+  }
+
+  return 0;
+}
+
+int
+SupernodalSPDLinSOE::addA(const Matrix &m, const ID &id, double fact)
+{
+  // check for a quick return
+  if (fact == 0.0)
+    return 0;
+
+  int idSize = id.Size();
+
+  // check that m and id are of similar size
+  if (idSize != m.noRows() && idSize != m.noCols()) {
+    opserr << "SupernodalSPDLinSOE::addA() ";
+    opserr << " - Matrix and ID not of similar sizes\n";
+    return -1;
+  }
+
+  // only the lower triangle is stored, the map has no location for
+  // the entries above the diagonal
+  const int *loc = theScatterMap.getLocations(id);
+  if (loc != 0 && idSize == m.noRows() && idSize == m.noCols()) {
+    if (fact == 1.0) { // do not need to multiply
+      for (int j=0; j<idSize; j++)
+	for (int i=0; i<idSize; i++, loc++)
+	  if (*loc >= 0)
+	    A[*loc] += m(i,j);
+    } else {
+      for (int j=0; j<idSize; j++)
+	for (int i=0; i<idSize; i++, loc++)
+	  if (*loc >= 0)
+	    A[*loc] += fact * m(i,j);
+    }
+    return 0;
+  }
+
+  int size = X.Size();
+  for (int j=0; j<idSize; j++) {
+    int col = id(j);
+    if (col < 0 || col >= size)
+      continue;
+    int startColLoc = colStartA[col];
+    int endColLoc = colStartA[col+1];
+    for (int i=0; i<idSize; i++) {
+      int row = id(i);
+      if (row < col || row >= size)
+	continue;
+      // find place in A using rowA
+      for (int k=startColLoc; k<endColLoc; k++)
+	if (rowA[k] == row) {
+	  A[k] += fact * m(i,j);
+	  break;
+	}
+    }
+  }
+
+  return 0;
+}
+
+int
+SupernodalSPDLinSOE::addB(const Vector &v, const ID &id, double fact)
+{
+  // check for a quick return
+  if (fact == 0.0)
+    return 0;
+
+  int idSize = id.Size();
+  // check that v and id are of similar size
+  if (idSize != v.Size()) {
+    opserr << "SupernodalSPDLinSOE::addB() ";
+    opserr << " - Vector and ID not of similar sizes\n";
+    return -1;
+  }
+
+  int size = B.Size();
+  if (fact == 1.0) { // do not need to multiply if fact == 1.0
+    for (int i=0; i<idSize; i++) {
+      int pos = id(i);
+      if (pos < size && pos >= 0) B[pos] += v(i);
+    }
+  } else if (fact == -1.0) { // do not need to multiply if fact == -1.0
+    for (int i=0; i<idSize; i++) {
+      int pos = id(i);
+      if (pos < size && pos >= 0) B[pos] -= v(i);
+    }
+  } else {
+    for (int i=0; i<idSize; i++) {
+      int pos = id(i);
+      if (pos < size && pos >= 0) B[pos] += v(i) * fact;
+    }
+  }
+
+  return 0;
+}
+
+int
+SupernodalSPDLinSOE::setB(const Vector &v, double fact)
+{
+  // check for a quick return
+  if (fact == 0.0) {
+    B.Zero();
+    return 0;
+  }
+
+  int size = B.Size();
+  if (v.Size() != size) {
+    opserr << "WARNING SupernodalSPDLinSOE::setB() -";
+    opserr << " incompatible sizes " << size << " and " << v.Size() << endln;
+    return -1;
+  }
+
+  if (fact == 1.0) { // do not need to multiply if fact == 1.0
+    for (int i=0; i<size; i++)
+      B[i] = v(i);
+  } else if (fact == -1.0) {
+    for (int i=0; i<size; i++)
+      B[i] = -v(i);
+  } else {
+    for (int i=0; i<size; i++)
+      B[i] = v(i) * fact;
+  }
+
+  return 0;
+}
+
+void
+SupernodalSPDLinSOE::zeroA(void)
+{
+  A.assign(A.size(), 0.0);
+  factored = false;
+}
+
+void
+SupernodalSPDLinSOE::zeroB(void)
+{
+  B.Zero();
+}
+
+void
+SupernodalSPDLinSOE::setX(int loc, double value)
+{
+  if (loc < X.Size() && loc >= 0)
+    X(loc) = value;
+}
+
+void
+SupernodalSPDLinSOE::setX(const Vector &x)
+{
+  if (x.Size() == X.Size())
+    X = x;
+}
+
+const Vector &
+SupernodalSPDLinSOE::getX(void)
+{
+  return X;
+}
+
+const Vector &
+SupernodalSPDLinSOE::getB(void)
+{
+  return B;
+}
+
+double
+SupernodalSPDLinSOE::normRHS(void)
+{
+  return B.Norm();
+}
+
+int
+SupernodalSPDLinSOE::setSupernodalSPDLinSolver(SupernodalSPDLinSolver &newSolver)
+{
+  newSolver.setLinearSOE(*this);
+  if (X.Size() != 0) {
+    int solverOK = newSolver.setSize();
+    if (solverOK < 0) {
+      opserr << "WARNING SupernodalSPDLinSOE::setSolver -";
+      opserr << " the new solver could not setSize() - staying with old\n";
+      return -1;
+    }
+  }
+  return this->LinearSOE::setSolver(newSolver);
+}
+
+int
+SupernodalSPDLinSOE::sendSelf(int cTag, Channel &theChannel)
+{
+  return 0;
+}
+
+int
+SupernodalSPDLinSOE::recvSelf(int cTag, Channel &theChannel,
+			      FEM_ObjectBroker &theBroker)
+{
+  return 0;
+}
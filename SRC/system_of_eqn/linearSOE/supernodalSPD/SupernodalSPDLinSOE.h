@@ -0,0 +1,79 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the class definition for
+// SupernodalSPDLinSOE. SupernodalSPDLinSOE is a subclass of LinearSOE.
+// It stores the lower triangle of a symmetric positive definite matrix
+// A in compressed column form, the row indices of each column sorted;
+// it is solved by a SupernodalSPDLinSolver.
+
+#ifndef SupernodalSPDLinSOE_h
+#define SupernodalSPDLinSOE_h
+
+#include <LinearSOE.h>
+#include <Vector.h>
+#include <SparseScatterMap.h>
+#include <vector>
+
+class SupernodalSPDLinSolver;
+
+class SupernodalSPDLinSOE : public LinearSOE
+{
+  public:
+    SupernodalSPDLinSOE(SupernodalSPDLinSolver &theSolver);
+    SupernodalSPDLinSOE();
+
+    ~SupernodalSPDLinSOE();
+
+    int getNumEqn(void) const;
+    int setSize(Graph &theGraph);
+    int addA(const Matrix &, const ID &, double fact = 1.0);
+    int addB(const Vector &, const ID &, double fact = 1.0);
+    virtual bool isThreadSafe(void) {return true;};
+    int setB(const Vector &, double fact = 1.0);
+
+    void zeroA(void);
+    void zeroB(void);
+
+    const Vector &getX(void);
+    const Vector &getB(void);
+    double normRHS(void);
+
+    void setX(int loc, double value);
+    void setX(const Vector &x);
+    int setSupernodalSPDLinSolver(SupernodalSPDLinSolver &newSolver);
+
+    int sendSelf(int commitTag, Channel &theChannel);
+    int recvSelf(int commitTag, Channel &theChannel,
+		 FEM_ObjectBroker &theBroker);
+
+    friend class SupernodalSPDLinSolver;
+
+  protected:
+    bool factored;
+
+  private:
+    Vector X, B;
+    std::vector<int> colStartA, rowA; // lower triangle of A, by columns
+    std::vector<double> A;
+    SparseScatterMap theScatterMap;
+};
+
+#endif
@@ -0,0 +1,682 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation for
+// SupernodalSPDLinSolver.
+
+#include <SupernodalSPDLinSolver.h>
+#include <SupernodalSPDLinSOE.h>
+#include <Information.h>
+#include <elementAPI.h>
+#include <amd.h>
+#include <algorithm>
+#include <string.h>
+
+void* OPS_SupernodalSPDLinSolver()
+{
+  int numThreads = 1;
+  while (OPS_GetNumRemainingInputArgs() > 0) {
+    const char *opt = OPS_GetString();
+    if (strcmp(opt, "-numThreads") == 0) {
+      int numdata = 1;
+      if (OPS_GetNumRemainingInputArgs() < 1 ||
+	  OPS_GetIntInput(&numdata, &numThreads) < 0 || numThreads < 1) {
+	opserr << "WARNING system SupernodalSPD -numThreads numThreads - invalid numThreads\n";
+	return 0;
+      }
+    } else {
+      opserr << "WARNING system SupernodalSPD - unknown option " << opt << "\n";
+      return 0;
+    }
+  }
+
+  SupernodalSPDLinSolver *theSolver = new SupernodalSPDLinSolver(numThreads);
+  return new SupernodalSPDLinSOE(*theSolver);
+}
+
+#ifdef _WIN32
+
+extern "C" int DPOTRF(char *UPLO, int *N, double *A, int *LDA, int *INFO);
+
+extern "C" int DTRSM(char *SIDE, char *UPLO, char *TRANSA, char *DIAG,
+		     int *M, int *N, double *ALPHA, double *A, int *LDA,
+		     double *B, int *LDB);
+
+extern "C" int DGEMM(char *TRANSA, char *TRANSB, int *M, int *N, int *K,
+		     double *ALPHA, double *A, int *LDA, double *B, int *LDB,
+		     double *BETA, double *C, int *LDC);
+
+extern "C" int DTRSV(char *UPLO, char *TRANS, char *DIAG, int *N,
+		     double *A, int *LDA, double *X, int *INCX);
+
+extern "C" int DGEMV(char *TRANS, int *M, int *N, double *ALPHA,
+		     double *A, int *LDA, double *X, int *INCX,
+		     double *BETA, double *Y, int *INCY);
+
+#else
+
+extern "C" int dpotrf_(char *UPLO, int *N, double *A, int *LDA, int *INFO);
+
+extern "C" int dtrsm_(char *SIDE, char *UPLO, char *TRANSA, char *DIAG,
+		      int *M, int *N, double *ALPHA, double *A, int *LDA,
+		      double *B, int *LDB);
+
+extern "C" int dgemm_(char *TRANSA, char *TRANSB, int *M, int *N, int *K,
+		      double *ALPHA, double *A, int *LDA, double *B, int *LDB,
+		      double *BETA, double *C, int *LDC);
+
+extern "C" int dtrsv_(char *UPLO, char *TRANS, char *DIAG, int *N,
+		      double *A, int *LDA, double *X, int *INCX);
+
+extern "C" int dgemv_(char *TRANS, int *M, int *N, double *ALPHA,
+		      double *A, int *LDA, double *X, int *INCX,
+		      double *BETA, double *Y, int *INCY);
+
+#define DPOTRF dpotrf_
+#define DTRSM dtrsm_
+#define DGEMM dgemm_
+#define DTRSV dtrsv_
+#define DGEMV dgemv_
+
+#endif
+
+SupernodalSPDLinSolver::SupernodalSPDLinSolver(int nThreads)
+  :LinearSOESolver(SOLVER_TAGS_SupernodalSPDLinSolver),
+   theSOE(0), numThreads(nThreads), size(0), numSupernodes(0),
+   numNumeric(0)
+{
+  if (numThreads < 1)
+    numThreads = 1;
+
+#ifndef _OPENMP
+  if (numThreads > 1) {
+    opserr << "WARNING SupernodalSPDLinSolver -";
+    opserr << " not built with OpenMP, factorization will be serial\n";
+  }
+#endif
+}
+
+SupernodalSPDLinSolver::~SupernodalSPDLinSolver()
+{
+
+}
+
+int
+SupernodalSPDLinSolver::setLinearSOE(SupernodalSPDLinSOE &theLinearSOE)
+{
+  theSOE = &theLinearSOE;
+  return 0;
+}
+
+// permutedPattern() - the pattern of P A P' by columns, the rows above
+// the diagonal in Up/Ui and the rows below it in Lp/Li.
+
+void
+SupernodalSPDLinSolver::permutedPattern(std::vector<int> &Up, std::vector<int> &Ui,
+					std::vector<int> &Lp, std::vector<int> &Li)
+{
+  const std::vector<int> &colStartA = theSOE->colStartA;
+  const std::vector<int> &rowA = theSOE->rowA;
+
+  Up.assign(size+1, 0);
+  Lp.assign(size+1, 0);
+  for (int j=0; j<size; j++)
+    for (int k=colStartA[j]; k<colStartA[j+1]; k++) {
+      int pi = invPerm[rowA[k]];
+      int pj = invPerm[j];
+      if (pi == pj)
+	continue;
+      Up[std::max(pi,pj)+1]++;
+      Lp[std::min(pi,pj)+1]++;
+    }
+
+  for (int k=0; k<size; k++) {
+    Up[k+1] += Up[k];
+    Lp[k+1] += Lp[k];
+  }
+
+  Ui.resize(Up[size]);
+  Li.resize(Lp[size]);
+  std::vector<int> nextU(Up.begin(), Up.end()-1);
+  std::vector<int> nextL(Lp.begin(), Lp.end()-1);
+  for (int j=0; j<size; j++)
+    for (int k=colStartA[j]; k<colStartA[j+1]; k++) {
+      int pi = invPerm[rowA[k]];
+      int pj = invPerm[j];
+      if (pi == pj)
+	continue;
+      int lo = std::min(pi,pj);
+      int hi = std::max(pi,pj);
+      Ui[nextU[hi]++] = lo;
+      Li[nextL[lo]++] = hi;
+    }
+}
+
+void
+SupernodalSPDLinSolver::eliminationTree(const std::vector<int> &Up,
+					const std::vector<int> &Ui,
+					std::vector<int> &parent)
+{
+  // Liu's algorithm with path compression
+  std::vector<int> ancestor(size, -1);
+  parent.assign(size, -1);
+  for (int k=0; k<size; k++)
+    for (int p=Up[k]; p<Up[k+1]; p++) {
+      int i = Ui[p];
+      while (i != -1 && i < k) {
+	int next = ancestor[i];
+	ancestor[i] = k;
+	if (next == -1)
+	  parent[i] = k;
+	i = next;
+      }
+    }
+}
+
+int
+SupernodalSPDLinSolver::setSize(void)
+{
+  size = theSOE->X.Size();
+
+  perm.clear(); invPerm.clear();
+  snodeStart.clear(); snodeOf.clear();
+  rowStart.clear(); rowIndex.clear();
+  valStart.clear(); L.clear();
+  mapA.clear(); updStart.clear(); updList.clear();
+  levelStart.clear(); levelNodes.clear();
+  numSupernodes = 0;
+
+  if (size == 0)
+    return 0;
+
+  const std::vector<int> &colStartA = theSOE->colStartA;
+  const std::vector<int> &rowA = theSOE->rowA;
+
+  //
+  // fill reducing ordering of A + A' by AMD
+  //
+
+  std::vector<int> Ap(size+1, 0);
+  for (int j=0; j<size; j++)
+    for (int k=colStartA[j]; k<colStartA[j+1]; k++)
+      if (rowA[k] != j) {
+	Ap[rowA[k]+1]++;
+	Ap[j+1]++;
+      }
+  for (int j=0; j<size; j++)
+    Ap[j+1] += Ap[j];
+
+  std::vector<int> Ai(Ap[size]);
+  std::vector<int> next(Ap.begin(), Ap.end()-1);
+  for (int j=0; j<size; j++)
+    for (int k=colStartA[j]; k<colStartA[j+1]; k++)
+      if (rowA[k] != j) {
+	Ai[next[rowA[k]]++] = j;
+	Ai[next[j]++] = rowA[k];
+      }
+
+  perm.resize(size);
+  int status = amd_order(size, Ap.data(), Ai.data(), perm.data(), 0, 0);
+  if (status != AMD_OK && status != AMD_OK_BUT_JUMBLED) {
+    opserr << "WARNING SupernodalSPDLinSolver::setSize - AMD failed with ";
+    opserr << status << ", using the original ordering\n";
+    for (int k=0; k<size; k++)
+      perm[k] = k;
+  }
+
+  invPerm.resize(size);
+  for (int k=0; k<size; k++)
+    invPerm[perm[k]] = k;
+
+  //
+  // postorder the elimination tree, so that the columns of a subtree,
+  // and hence of a supernode, are numbered consecutively
+  //
+
+  std::vector<int> Up, Ui, Lp, Li, parent;
+  this->permutedPattern(Up, Ui, Lp, Li);
+  this->eliminationTree(Up, Ui, parent);
+
+  std::vector<int> head(size, -1), sibling(size, -1);
+  for (int j=size-1; j>=0; j--)
+    if (parent[j] != -1) {
+      sibling[j] = head[parent[j]];
+      head[parent[j]] = j;
+    }
+
+  std::vector<int> post, stack;
+  post.reserve(size);
+  for (int root=0; root<size; root++) {
+    if (parent[root] != -1)
+      continue;
+    stack.push_back(root);
+    while (!stack.empty()) {
+      int j = stack.back();
+      int child = head[j];
+      if (child == -1) {
+	post.push_back(j);
+	stack.pop_back();
+      } else {
+	head[j] = sibling[child];
+	stack.push_back(child);
+      }
+    }
+  }
+
+  for (int k=0; k<size; k++)
+    next[k] = perm[post[k]];
+  for (int k=0; k<size; k++) {
+    perm[k] = next[k];
+    invPerm[perm[k]] = k;
+  }
+
+  this->permutedPattern(Up, Ui, Lp, Li);
+  this->eliminationTree(Up, Ui, parent);
+
+  //
+  // column counts of L, from the row subtrees of the elimination tree
+  //
+
+  std::vector<int> colCount(size, 1), mark(size, -1), numChildren(size, 0);
+  for (int k=0; k<size; k++) {
+    mark[k] = k;
+    for (int p=Up[k]; p<Up[k+1]; p++)
+      for (int j=Ui[p]; mark[j] != k; j=parent[j]) {
+	colCount[j]++;
+	mark[j] = k;
+      }
+    if (parent[k] != -1)
+      numChildren[parent[k]]++;
+  }
+
+  //
+  // fundamental supernodes: column j joins the supernode of j-1 if j-1
+  // is its only child and L(:,j) is L(:,j-1) less its diagonal
+  //
+
+  snodeStart.push_back(0);
+  for (int j=1; j<size; j++)
+    if (parent[j-1] != j || numChildren[j] != 1 ||
+	colCount[j-1] != colCount[j]+1)
+      snodeStart.push_back(j);
+  snodeStart.push_back(size);
+  numSupernodes = snodeStart.size() - 1;
+
+  snodeOf.resize(size);
+  for (int s=0; s<numSupernodes; s++)
+    for (int j=snodeStart[s]; j<snodeStart[s+1]; j++)
+      snodeOf[j] = s;
+
+  std::vector<int> sParent(numSupernodes, -1);
+  std::vector<int> sHead(numSupernodes, -1), sSibling(numSupernodes, -1);
+  for (int s=numSupernodes-1; s>=0; s--) {
+    int p = parent[snodeStart[s+1]-1];
+    if (p != -1) {
+      sParent[s] = snodeOf[p];
+      sSibling[s] = sHead[sParent[s]];
+      sHead[sParent[s]] = s;
+    }
+  }
+
+  //
+  // row structure of each supernode: its columns, the rows of A below
+  // them and the rows of its children below the children's columns
+  //
+
+  rowStart.assign(1, 0);
+  valStart.assign(1, 0);
+  mark.assign(size, -1);
+  std::vector<int> rows;
+  for (int s=0; s<numSupernodes; s++) {
+    int first = snodeStart[s];
+    int last = snodeStart[s+1]-1;
+    rows.clear();
+    for (int j=first; j<=last; j++) {
+      rows.push_back(j);
+      mark[j] = s;
+    }
+    for (int j=first; j<=last; j++)
+      for (int p=Lp[j]; p<Lp[j+1]; p++)
+	if (mark[Li[p]] != s) {
+	  rows.push_back(Li[p]);
+	  mark[Li[p]] = s;
+	}
+    for (int c=sHead[s]; c!=-1; c=sSibling[c]) {
+      int numCols = snodeStart[c+1]-snodeStart[c];
+      for (int p=rowStart[c]+numCols; p<rowStart[c+1]; p++)
+	if (mark[rowIndex[p]] != s) {
+	  rows.push_back(rowIndex[p]);
+	  mark[rowIndex[p]] = s;
+	}
+    }
+    std::sort(rows.begin()+(last-first+1), rows.end());
+
+    rowIndex.insert(rowIndex.end(), rows.begin(), rows.end());
+    rowStart.push_back(rowIndex.size());
+    valStart.push_back(valStart[s] + rows.size()*(last-first+1));
+  }
+
+  L.assign(valStart[numSupernodes], 0.0);
+
+  //
+  // supernodes updating each supernode, i.e. with rows in its columns
+  //
+
+  updStart.assign(numSupernodes+1, 0);
+  for (int pass=0; pass<2; pass++) {
+    std::vector<int> nextUpd(updStart.begin(), updStart.end()-1);
+    for (int d=0; d<numSupernodes; d++) {
+      int numCols = snodeStart[d+1]-snodeStart[d];
+      int lastS = -1;
+      for (int p=rowStart[d]+numCols; p<rowStart[d+1]; p++) {
+	int s = snodeOf[rowIndex[p]];
+	if (s == lastS)
+	  continue;
+	lastS = s;
+	if (pass == 0)
+	  updStart[s+1]++;
+	else
+	  updList[nextUpd[s]++] = d;
+      }
+    }
+    if (pass == 0) {
+      for (int s=0; s<numSupernodes; s++)
+	updStart[s+1] += updStart[s];
+      updList.resize(updStart[numSupernodes]);
+    }
+  }
+
+  //
+  // levels of the supernodal tree; the supernodes of a level have no
+  // descendants in that level and can be factored concurrently
+  //
+
+  std::vector<int> level(numSupernodes, 0);
+  int numLevels = 0;
+  for (int s=0; s<numSupernodes; s++) {
+    if (sParent[s] != -1 && level[sParent[s]] < level[s]+1)
+      level[sParent[s]] = level[s]+1;
+    if (level[s]+1 > numLevels)
+      numLevels = level[s]+1;
+  }
+  levelStart.assign(numLevels+1, 0);
+  for (int s=0; s<numSupernodes; s++)
+    levelStart[level[s]+1]++;
+  for (int l=0; l<numLevels; l++)
+    levelStart[l+1] += levelStart[l];
+  levelNodes.resize(numSupernodes);
+  std::vector<int> nextLevel(levelStart.begin(), levelStart.end()-1);
+  for (int s=0; s<numSupernodes; s++)
+    levelNodes[nextLevel[level[s]]++] = s;
+
+  //
+  // location in L of each entry of A
+  //
+
+  mapA.resize(rowA.size());
+  for (int j=0; j<size; j++)
+    for (int k=colStartA[j]; k<colStartA[j+1]; k++) {
+      int pi = invPerm[rowA[k]];
+      int pj = invPerm[j];
+      int lo = std::min(pi,pj);
+      int hi = std::max(pi,pj);
+      int s = snodeOf[lo];
+      const int *sRows = &rowIndex[rowStart[s]];
+      int numRows = rowStart[s+1]-rowStart[s];
+      int r = std::lower_bound(sRows, sRows+numRows, hi) - sRows;
+      mapA[k] = valStart[s] + (std::size_t)(lo-snodeStart[s])*numRows + r;
+    }
+
+  work.resize(2*size);
+
+  return 0;
+}
+
+// factorSupernode() - left-looking: the supernode is first updated by
+// every supernode with rows in its columns, all of which have already
+// been factored, and is then factored itself. Only the supernode's own
+// block of L is written, so supernodes that are not ancestors of one
+// another can be factored at the same time.
+
+int
+SupernodalSPDLinSolver::factorSupernode(int s)
+{
+  static thread_local std::vector<int> relIndex;
+  static thread_local std::vector<double> W;
+
+  if ((int)relIndex.size() < size)
+    relIndex.resize(size);
+
+  int first = snodeStart[s];
+  int numCols = snodeStart[s+1]-first;
+  int last = first+numCols-1;
+  const int *sRows = &rowIndex[rowStart[s]];
+  int numRows = rowStart[s+1]-rowStart[s];
+  double *Ls = &L[valStart[s]];
+
+  for (int r=0; r<numRows; r++)
+    relIndex[sRows[r]] = r;
+
+  for (int u=updStart[s]; u<updStart[s+1]; u++) {
+    int d = updList[u];
+    int dCols = snodeStart[d+1]-snodeStart[d];
+    const int *dRows = &rowIndex[rowStart[d]];
+    int dNumRows = rowStart[d+1]-rowStart[d];
+    double *Ld = &L[valStart[d]];
+
+    // rows p1 to p2-1 of d lie in the columns of s
+    int p1 = std::lower_bound(dRows+dCols, dRows+dNumRows, first) - dRows;
+    int p2 = std::upper_bound(dRows+p1, dRows+dNumRows, last) - dRows;
+
+    // W = Ld(p1:end,:) * Ld(p1:p2-1,:)'
+    int m = dNumRows-p1;
+    int k = p2-p1;
+    if ((int)W.size() < m*k)
+      W.resize(m*k);
+
+    char N = 'N';
+    char T = 'T';
+    double one = 1.0;
+    double zero = 0.0;
+    DGEMM(&N, &T, &m, &k, &dCols, &one, Ld+p1, &dNumRows, Ld+p1, &dNumRows,
+	  &zero, W.data(), &m);
+
+    // subtract from the lower triangle of s
+    for (int jj=0; jj<k; jj++) {
+      double *Lcol = Ls + (std::size_t)(dRows[p1+jj]-first)*numRows;
+      const double *Wcol = W.data() + jj*m;
+      for (int ii=jj; ii<m; ii++)
+	Lcol[relIndex[dRows[p1+ii]]] -= Wcol[ii];
+    }
+  }
+
+  char UPLO = 'L';
+  int INFO = 0;
+  DPOTRF(&UPLO, &numCols, Ls, &numRows, &INFO);
+  if (INFO != 0) {
+#pragma omp critical (SupernodalSPDLinSolver_output)
+    {
+      opserr << "WARNING SupernodalSPDLinSolver::solve -";
+      if (INFO > 0)
+	opserr << " matrix not positive definite at equation "
+	       << perm[first+INFO-1] << endln;
+      else
+	opserr << " dpotrf returned " << INFO << endln;
+    }
+    return -2;
+  }
+
+  int numBelow = numRows-numCols;
+  if (numBelow > 0) {
+    char SIDE = 'R';
+    char TRANS = 'T';
+    char DIAG = 'N';
+    double one = 1.0;
+    DTRSM(&SIDE, &UPLO, &TRANS, &DIAG, &numBelow, &numCols, &one,
+	  Ls, &numRows, Ls+numCols, &numRows);
+  }
+
+  return 0;
+}
+
+int
+SupernodalSPDLinSolver::factor(void)
+{
+  L.assign(L.size(), 0.0);
+  const std::vector<double> &A = theSOE->A;
+  int nnzA = A.size();
+  for (int k=0; k<nnzA; k++)
+    L[mapA[k]] += A[k];
+
+  int result = 0;
+  int numLevels = levelStart.size()-1;
+  for (int l=0; l<numLevels && result == 0; l++) {
+    int start = levelStart[l];
+    int end = levelStart[l+1];
+
+#pragma omp parallel for num_threads(numThreads) schedule(dynamic,1) reduction(min:result)
+    for (int i=start; i<end; i++) {
+      int res = this->factorSupernode(levelNodes[i]);
+      if (res < result)
+	result = res;
+    }
+  }
+
+  numNumeric++;
+  return result;
+}
+
+int
+SupernodalSPDLinSolver::solve(void)
+{
+  if (theSOE == 0) {
+    opserr << "WARNING SupernodalSPDLinSolver::solve - no LinearSOE object has been set\n";
+    return -1;
+  }
+
+  if (size == 0)
+    return 0;
+
+  if (mapA.size() != theSOE->A.size()) {
+    opserr << "WARNING SupernodalSPDLinSolver::solve - setSize has not been called\n";
+    return -1;
+  }
+
+  if (theSOE->factored == false) {
+    int res = this->factor();
+    if (res < 0)
+      return res;
+    theSOE->factored = true;
+  }
+
+  double *y = work.data();
+  double *tmp = y + size;
+  for (int k=0; k<size; k++)
+    y[k] = theSOE->B(perm[k]);
+
+  char UPLO = 'L';
+  char N = 'N';
+  char T = 'T';
+  char DIAG = 'N';
+  int inc = 1;
+  double one = 1.0;
+  double minusOne = -1.0;
+  double zero = 0.0;
+
+  // forward substitution L y = P b
+  for (int s=0; s<numSupernodes; s++) {
+    int first = snodeStart[s];
+    int numCols = snodeStart[s+1]-first;
+    const int *sRows = &rowIndex[rowStart[s]];
+    int numRows = rowStart[s+1]-rowStart[s];
+    int numBelow = numRows-numCols;
+    double *Ls = &L[valStart[s]];
+
+    DTRSV(&UPLO, &N, &DIAG, &numCols, Ls, &numRows, y+first, &inc);
+    if (numBelow > 0) {
+      DGEMV(&N, &numBelow, &numCols, &one, Ls+numCols, &numRows, y+first, &inc,
+	    &zero, tmp, &inc);
+      for (int r=0; r<numBelow; r++)
+	y[sRows[numCols+r]] -= tmp[r];
+    }
+  }
+
+  // back substitution L' x = y
+  for (int s=numSupernodes-1; s>=0; s--) {
+    int first = snodeStart[s];
+    int numCols = snodeStart[s+1]-first;
+    const int *sRows = &rowIndex[rowStart[s]];
+    int numRows = rowStart[s+1]-rowStart[s];
+    int numBelow = numRows-numCols;
+    double *Ls = &L[valStart[s]];
+
+    if (numBelow > 0) {
+      for (int r=0; r<numBelow; r++)
+	tmp[r] = y[sRows[numCols+r]];
+      DGEMV(&T, &numBelow, &numCols, &minusOne, Ls+numCols, &numRows, tmp, &inc,
+	    &one, y+first, &inc);
+    }
+    DTRSV(&UPLO, &T, &DIAG, &numCols, Ls, &numRows, y+first, &inc);
+  }
+
+  for (int k=0; k<size; k++)
+    theSOE->X(perm[k]) = y[k];
+
+  return 0;
+}
+
+int
+SupernodalSPDLinSolver::getVariable(const char *variable, Information &theInfo)
+{
+  if (strcmp(variable, "numSupernodes") == 0) {
+    theInfo.theType = IntType;
+    theInfo.setInt(numSupernodes);
+  } else if (strcmp(variable, "nnzL") == 0) {
+    double nnzL = 0.0;
+    for (int s=0; s<numSupernodes; s++) {
+      double numCols = snodeStart[s+1]-snodeStart[s];
+      double numRows = rowStart[s+1]-rowStart[s];
+      nnzL += numCols*numRows - numCols*(numCols-1)/2;
+    }
+    theInfo.theType = DoubleType;
+    theInfo.setDouble(nnzL);
+  } else if (strcmp(variable, "numNumeric") == 0) {
+    theInfo.theType = IntType;
+    theInfo.setInt(numNumeric);
+  } else
+    return -1;
+
+  return 0;
+}
+
+int
+SupernodalSPDLinSolver::sendSelf(int cTag, Channel &theChannel)
+{
+  // nothing to do
+  return 0;
+}
+
+int
+SupernodalSPDLinSolver::recvSelf(int cTag, Channel &theChannel,
+				 FEM_ObjectBroker &theBroker)
+{
+  // nothing to do
+  return 0;
+}
@@ -0,0 +1,94 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the class definition for
+// SupernodalSPDLinSolver. It solves a SupernodalSPDLinSOE by a sparse
+// Cholesky factorization A = P'LL'P. In setSize() the equations are
+// ordered by AMD and postordered on the elimination tree, and the
+// columns of L with the same structure are grouped into supernodes,
+// each stored as a dense block. In solve() the supernodes are factored
+// left-looking with LAPACK/BLAS-3 kernels; supernodes at the same level
+// of the elimination tree are independent and are shared amongst
+// numThreads threads when built with OpenMP.
+
+#ifndef SupernodalSPDLinSolver_h
+#define SupernodalSPDLinSolver_h
+
+#include <LinearSOESolver.h>
+#include <vector>
+#include <cstddef>
+
+class SupernodalSPDLinSOE;
+
+class SupernodalSPDLinSolver : public LinearSOESolver
+{
+  public:
+    SupernodalSPDLinSolver(int numThreads = 1);
+    ~SupernodalSPDLinSolver();
+
+    int solve(void);
+    int setSize(void);
+
+    int setLinearSOE(SupernodalSPDLinSOE &theSOE);
+
+    // numSupernodes, nnzL and numNumeric
+    int getVariable(const char *variable, Information &theInfo);
+
+    int sendSelf(int commitTag, Channel &theChannel);
+    int recvSelf(int commitTag, Channel &theChannel,
+		 FEM_ObjectBroker &theBroker);
+
+  protected:
+
+  private:
+    void permutedPattern(std::vector<int> &Up, std::vector<int> &Ui,
+			 std::vector<int> &Lp, std::vector<int> &Li);
+    void eliminationTree(const std::vector<int> &Up, const std::vector<int> &Ui,
+			 std::vector<int> &parent);
+    int factor(void);
+    int factorSupernode(int s);
+
+    SupernodalSPDLinSOE *theSOE;
+    int numThreads;
+
+    int size;
+    std::vector<int> perm;        // perm[k] is equation of column k of L
+    std::vector<int> invPerm;
+
+    int numSupernodes;
+    std::vector<int> snodeStart;  // first column of each supernode
+    std::vector<int> snodeOf;     // supernode of each column
+    std::vector<int> rowStart;    // row structure of each supernode, the
+    std::vector<int> rowIndex;    // supernode's own columns first
+    std::vector<std::size_t> valStart; // start of each dense block in L
+    std::vector<double> L;
+
+    std::vector<std::size_t> mapA; // location in L of each entry of A
+    std::vector<int> updStart;    // supernodes that update each supernode
+    std::vector<int> updList;
+    std::vector<int> levelStart;  // supernodes by level in the tree
+    std::vector<int> levelNodes;
+
+    std::vector<double> work;     // used in the triangular solves
+
+    int numNumeric;
+};
+
+#endif
@@ -82,16 +82,18 @@ UmfpackGenLinSOE::setSize(Graph &theGraph)
 	return -1;
     }
 
-    // fist itearte through the vertices of the graph to get nnz
-    Vertex *theVertex;
-    int nnz = 0;
-    VertexIter &theVertices = theGraph.getVertices();
-    while ((theVertex = theVertices()) != 0) {
-	const ID &theAdjacency = theVertex->getAdjacency();
-	nnz += theAdjacency.Size() +1; // the +1 is for the diag entry
+    // the adjacency of the graph in compressed row form gives nnz
+    const int *rowStart, *adjacency;
+    if (theGraph.getCSR(rowStart, adjacency) < 0) {
+	opserr << "WARNING:UmfpackGenLinSOE::setSize :";
+	opserr << " vertices not numbered 0 through size-1 - size set to 0\n";
+	return -1;
     }
+    int nnz = rowStart[size] + size; // the +size is for the diag entries
 
     // resize A, B, X
+    Ap.clear();
+    Ai.clear();
     Ap.reserve(size+1);
     Ai.reserve(nnz);
     Ax.resize(nnz,0.0);
@@ -104,36 +106,24 @@ UmfpackGenLinSOE::setSize(Graph &theGraph)
     Ap.push_back(0);
     for (int a=0; a<size; a++) {
 
-	theVertex = theGraph.getVertexPtr(a);
-	if (theVertex == 0) {
-	    opserr << "WARNING:UmfpackGenLinSOE::setSize :";
-	    opserr << " vertex " << a << " not in graph! - size set to 0\n";
-	    size = 0;
-	    return -1;
-	}
-
-	const ID &theAdjacency = theVertex->getAdjacency();
-	int idSize = theAdjacency.Size();
-	ID col(0,idSize+1);
-
-	// diagonal
-	col.insert(theVertex->getTag());
-
-	// now we have to place the entries in the ID into order in Ai
-	for (int i=0; i<idSize; i++) {
-	    int row = theAdjacency(i);
-	    col.insert(row);
-	}
-
-	// copy to Ai
-	for (int i=0; i<col.Size(); i++) {
-	    Ai.push_back(col(i));
-	}
+	// the adjacency is sorted, the diag is placed in order among it
+	int i = rowStart[a];
+	for (; i<rowStart[a+1] && adjacency[i] < a; i++)
+	    Ai.push_back(adjacency[i]);
+	Ai.push_back(a);
+	for (; i<rowStart[a+1]; i++)
+	    Ai.push_back(adjacency[i]);
 
 	// set Ap
-	Ap.push_back(Ap[a]+col.Size());
+	Ap.push_back((int)Ai.size());
     }
 
+    // locations of the FE_Element and DOF_Group entries in Ax
+    if (theModel != 0)
+	theScatterMap.setSize(*theModel, Ap.data(), Ai.data(), size);
+    else
+	theScatterMap.clear();
+
     // invoke setSize() on the Solver
     factored = false;
     LinearSOESolver *the_Solver = this->getSolver();
@@ -161,6 +151,23 @@ UmfpackGenLinSOE::addA(const Matrix &m, const ID &id, double fact)
 	return -1;
     }
 
+    // if the locations were computed in setSize() add the entries directly
+    const int *loc = theScatterMap.getLocations(id);
+    if (loc != 0 && idSize == m.noRows() && idSize == m.noCols()) {
+	if (fact == 1.0) { // do not need to multiply
+	    for (int j=0; j<idSize; j++)
+		for (int i=0; i<idSize; i++, loc++)
+		    if (*loc >= 0)
+			Ax[*loc] += m(i,j);
+	} else {
+	    for (int j=0; j<idSize; j++)
+		for (int i=0; i<idSize; i++, loc++)
+		    if (*loc >= 0)
+			Ax[*loc] += fact*m(i,j);
+	}
+	return 0;
+    }
+
     int size = X.Size();
     if (fact == 1.0) { // do not need to multiply
 	for (int j=0; j<idSize; j++) {
@@ -37,6 +37,7 @@
 
 #include <LinearSOE.h>
 #include <Vector.h>
+#include <SparseScatterMap.h>
 #include <vector>
 
 class UmfpackGenLinSolver;
@@ -53,6 +54,7 @@ public:
     int setSize(Graph &theGraph);
     int addA(const Matrix &, const ID &, double fact = 1.0);
     int addB(const Vector &, const ID &, double fact = 1.0);    
+    virtual bool isThreadSafe(void) {return true;};
     int setB(const Vector &, double fact = 1.0);        
     
     void zeroA(void);
@@ -82,6 +84,7 @@ private:
     Vector X,B;
     std::vector<int> Ap, Ai;
     std::vector<double> Ax;
+    SparseScatterMap theScatterMap;
 };
 
 
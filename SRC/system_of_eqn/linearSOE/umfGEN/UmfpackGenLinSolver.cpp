@@ -38,6 +38,7 @@
 #include <cstring>
 #include <Channel.h>
 #include <FEM_ObjectBroker.h>
+#include <Information.h>
 #include <elementAPI.h>
 
 void* OPS_UmfpackGenLinSolver()
@@ -68,7 +69,11 @@ UmfpackGenLinSolver(bool useLongIndices)
       useLongIndices(useLongIndices),
       Symbolic(0),
       Numeric(0),
-      theSOE(0)
+      theSOE(0),
+      numSetSize(0),
+      numSymbolic(0),
+      numSymbolicReused(0),
+      numNumeric(0)
 {
 }
 
@@ -147,6 +152,7 @@ UmfpackGenLinSolver::solve(void)
                 return -1;
             }
             theSOE->factored = true;
+            numNumeric++;
         }
 
         SuiteSparse_long status =
@@ -175,6 +181,7 @@ UmfpackGenLinSolver::solve(void)
                 return -1;
             }
             theSOE->factored = true;
+            numNumeric++;
         }
 
         int status =
@@ -193,6 +200,8 @@ UmfpackGenLinSolver::solve(void)
 int
 UmfpackGenLinSolver::setSize()
 {
+    numSetSize++;
+
     int n = theSOE->X.Size();
     int nnz = (int)theSOE->Ai.size();
     if (n == 0 || nnz == 0) {
@@ -220,6 +229,17 @@ UmfpackGenLinSolver::setSize()
         }
     }
 
+    // if the pattern of A is the one the current Symbolic was computed
+    // for, e.g. a domain change that did not alter the connectivity, keep
+    // the ordering and symbolic factorization; the comparison of the
+    // column starts fails at once if the order or number of nonzeros differ
+    if (Symbolic != 0 &&
+        patternAp == theSOE->Ap && patternAi == theSOE->Ai) {
+        syncIndexBuffers();
+        numSymbolicReused++;
+        return 0;
+    }
+
     if (useLongIndices) {
 #ifdef _UMFPACK_DLONG
         // set default control parameters
@@ -276,6 +296,12 @@ UmfpackGenLinSolver::setSize()
         }
     }
 
+    if (Symbolic != 0) {
+        patternAp = theSOE->Ap;
+        patternAi = theSOE->Ai;
+        numSymbolic++;
+    }
+
     return 0;
 }
 
@@ -286,6 +312,26 @@ UmfpackGenLinSolver::setLinearSOE(UmfpackGenLinSOE &theLinearSOE)
     return 0;
 }
 
+int
+UmfpackGenLinSolver::getVariable(const char *variable, Information &theInfo)
+{
+    int value;
+    if (strcmp(variable, "numSetSize") == 0)
+        value = numSetSize;
+    else if (strcmp(variable, "numSymbolic") == 0)
+        value = numSymbolic;
+    else if (strcmp(variable, "numSymbolicReused") == 0)
+        value = numSymbolicReused;
+    else if (strcmp(variable, "numNumeric") == 0)
+        value = numNumeric;
+    else
+        return -1;
+
+    theInfo.theType = IntType;
+    theInfo.setInt(value);
+    return 0;
+}
+
 int
 UmfpackGenLinSolver::sendSelf(int cTag, Channel &theChannel)
 {
@@ -51,6 +51,9 @@ class UmfpackGenLinSolver : public LinearSOESolver
     int setSize(void);
 
     int setLinearSOE(UmfpackGenLinSOE &theSOE);
+
+    // numSetSize, numSymbolic, numSymbolicReused and numNumeric counts
+    int getVariable(const char *variable, Information &theInfo);
     
     int sendSelf(int commitTag, Channel &theChannel);
     int recvSelf(int commitTag, Channel &theChannel,
@@ -68,6 +71,15 @@ class UmfpackGenLinSolver : public LinearSOESolver
     UmfpackGenLinSOE *theSOE;
     std::vector<SuiteSparse_long> Ap64;
     std::vector<SuiteSparse_long> Ai64;
+
+    // pattern of A the current Symbolic was computed for
+    std::vector<int> patternAp;
+    std::vector<int> patternAi;
+
+    int numSetSize;         // calls to setSize()
+    int numSymbolic;        // symbolic factorizations performed
+    int numSymbolicReused;  // setSize() calls that kept the old Symbolic
+    int numNumeric;         // numeric factorizations performed
 };
 
 #endif
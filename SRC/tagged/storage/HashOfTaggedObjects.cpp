@@ -0,0 +1,280 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation of the
+// HashOfTaggedObjects class.
+
+#include <TaggedObject.h>
+#include <HashOfTaggedObjects.h>
+
+#include <OPS_Globals.h>
+
+#define HASH_EMPTY   -1
+#define HASH_REMOVED -2
+#define HASH_MIN_SIZE 64
+
+HashOfTaggedObjects::HashOfTaggedObjects(int initialSize)
+  :theComponents(), theTable(), numComponents(0), numUsed(0), shift(32),
+   myIter(*this)
+{
+  this->setSize(initialSize);
+}
+
+
+HashOfTaggedObjects::~HashOfTaggedObjects()
+{
+  this->clearAll();
+}
+
+
+// int setSize(int newSize);
+// Makes room for newSize objects, so that they can be added without the
+// table being rebuilt.
+
+int
+HashOfTaggedObjects::setSize(int newSize)
+{
+  if (newSize < 0) {
+    opserr << "HashOfTaggedObjects::setSize - invalid size " << newSize << "\n";
+    return -1;
+  }
+
+  if (newSize > numComponents) {
+    theComponents.reserve(newSize);
+    this->rehash(newSize);
+  }
+
+  return 0;
+}
+
+
+bool
+HashOfTaggedObjects::addComponent(TaggedObject *newComponent)
+{
+  int tag = newComponent->getTag();
+
+  if (this->findEntry(tag) >= 0) {
+    opserr << "HashOfTaggedObjects::addComponent - not adding as one with similar tag exists, tag: " <<
+      tag << "\n";
+    return false;
+  }
+
+  // keep the table at most 70% full, counting the removed entries
+  int size = theTable.size();
+  if (10*(numUsed+1) > 7*size)
+    this->rehash(numComponents+1);
+
+  // squeeze out the holes once they outnumber the objects
+  if ((int)theComponents.size() - numComponents > numComponents &&
+      (int)theComponents.size() > HASH_MIN_SIZE)
+    this->squeeze();
+
+  unsigned int mask = theTable.size() - 1;
+  unsigned int i = ((unsigned int)tag * 2654435769u) >> shift;
+  while (theTable[i].slot >= 0)
+    i = (i+1) & mask;
+
+  if (theTable[i].slot == HASH_EMPTY)
+    numUsed++;
+  theTable[i].tag = tag;
+  theTable[i].slot = theComponents.size();
+
+  theComponents.push_back(newComponent);
+  numComponents++;
+
+  return true;  // o.k.
+}
+
+
+TaggedObject *
+HashOfTaggedObjects::removeComponent(int tag)
+{
+  int i = this->findEntry(tag);
+  if (i < 0)
+    return 0;
+
+  int slot = theTable[i].slot;
+  TaggedObject *removed = theComponents[slot];
+
+  theTable[i].slot = HASH_REMOVED;
+  theComponents[slot] = 0;
+  numComponents--;
+
+  // the last objects are simply popped off
+  while (theComponents.empty() == false && theComponents.back() == 0)
+    theComponents.pop_back();
+
+  return removed;
+}
+
+
+int
+HashOfTaggedObjects::getNumComponents(void) const
+{
+  return numComponents;
+}
+
+
+TaggedObject *
+HashOfTaggedObjects::getComponentPtr(int tag)
+{
+  int i = this->findEntry(tag);
+  if (i < 0)
+    return 0;
+
+  return theComponents[theTable[i].slot];
+}
+
+
+TaggedObjectIter &
+HashOfTaggedObjects::getComponents()
+{
+  myIter.reset();
+  return myIter;
+}
+
+
+HashOfTaggedObjectsIter
+HashOfTaggedObjects::getIter()
+{
+  return HashOfTaggedObjectsIter(*this);
+}
+
+
+TaggedObjectStorage *
+HashOfTaggedObjects::getEmptyCopy(void)
+{
+  HashOfTaggedObjects *theCopy = new HashOfTaggedObjects();
+
+  if (theCopy == 0) {
+    opserr << "HashOfTaggedObjects::getEmptyCopy-out of memory\n";
+  }
+
+  return theCopy;
+}
+
+
+void
+HashOfTaggedObjects::clearAll(bool invokeDestructor)
+{
+  // invoke the destructor on all the tagged objects stored
+  if (invokeDestructor == true) {
+    for (TaggedObject *theComponent : theComponents)
+      if (theComponent != 0)
+	delete theComponent;
+  }
+
+  theComponents.clear();
+  theTable.clear();
+  numComponents = 0;
+  numUsed = 0;
+  shift = 32;
+}
+
+
+void
+HashOfTaggedObjects::Print(OPS_Stream &s, int flag)
+{
+  s << "\nnumComponents: " << this->getNumComponents() << endln;
+
+  // go through the array invoking Print on non-zero entries
+  for (TaggedObject *theComponent : theComponents)
+    if (theComponent != 0)
+      theComponent->Print(s, flag);
+}
+
+
+// int findEntry(int tag) const;
+// Returns the position of the object with the given tag in the table,
+// -1 if there is none. The tag is hashed by Fibonacci hashing, the top
+// bits of the product with 2^32 divided by the golden ratio, so runs of
+// consecutive tags are spread over the table.
+
+int
+HashOfTaggedObjects::findEntry(int tag) const
+{
+  if (theTable.empty() == true)
+    return -1;
+
+  unsigned int mask = theTable.size() - 1;
+  unsigned int i = ((unsigned int)tag * 2654435769u) >> shift;
+  while (theTable[i].slot != HASH_EMPTY) {
+    if (theTable[i].slot >= 0 && theTable[i].tag == tag)
+      return i;
+    i = (i+1) & mask;
+  }
+
+  return -1;
+}
+
+
+// void rehash(int numEntries);
+// Rebuilds the table with room for numEntries objects at a load of at
+// most a half, dropping the entries of removed objects.
+
+void
+HashOfTaggedObjects::rehash(int numEntries)
+{
+  int size = HASH_MIN_SIZE;
+  int bits = 6;
+  while (size < 2*numEntries) {
+    size *= 2;
+    bits++;
+  }
+
+  Entry empty = {0, HASH_EMPTY};
+  theTable.assign(size, empty);
+  shift = 32 - bits;
+  numUsed = 0;
+
+  unsigned int mask = size - 1;
+  int numSlots = theComponents.size();
+  for (int slot=0; slot<numSlots; slot++) {
+    TaggedObject *theComponent = theComponents[slot];
+    if (theComponent == 0)
+      continue;
+
+    int tag = theComponent->getTag();
+    unsigned int i = ((unsigned int)tag * 2654435769u) >> shift;
+    while (theTable[i].slot != HASH_EMPTY)
+      i = (i+1) & mask;
+    theTable[i].tag = tag;
+    theTable[i].slot = slot;
+    numUsed++;
+  }
+}
+
+
+// void squeeze(void);
+// Closes the holes left by removed objects, keeping the objects in the
+// order they were added, and rebuilds the table for the new slots.
+
+void
+HashOfTaggedObjects::squeeze(void)
+{
+  int numSlots = theComponents.size();
+  int next = 0;
+  for (int slot=0; slot<numSlots; slot++)
+    if (theComponents[slot] != 0)
+      theComponents[next++] = theComponents[slot];
+  theComponents.resize(next);
+
+  this->rehash(numComponents+1);
+}
@@ -0,0 +1,82 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef HashOfTaggedObjects_h
+#define HashOfTaggedObjects_h
+
+// Description: This file contains the class definition for
+// HashOfTaggedObjects. HashOfTaggedObjects is a storage class. The
+// pointers to the TaggedObjects are kept in a dense array in the order
+// they were added, which is the order the iter returns them in, and an
+// open addressing hash table with linear probing maps a tag to its slot
+// in the array. Lookup is O(1) whatever the numbering of the tags and
+// iteration is a walk over contiguous memory. A removed object leaves a
+// hole in the array; the holes are squeezed out when they outnumber the
+// objects and a component is added.
+
+#include <TaggedObjectStorage.h>
+#include <HashOfTaggedObjectsIter.h>
+#include <vector>
+
+class HashOfTaggedObjects : public TaggedObjectStorage
+{
+  public:
+    HashOfTaggedObjects(int initialSize = 0);
+    ~HashOfTaggedObjects();
+
+    // public methods to populate a domain
+    int  setSize(int newSize);
+    bool addComponent(TaggedObject *newComponent);
+    TaggedObject *removeComponent(int tag);
+    int getNumComponents(void) const;
+
+    TaggedObject     *getComponentPtr(int tag);
+    TaggedObjectIter &getComponents();
+
+    HashOfTaggedObjectsIter getIter();
+
+    TaggedObjectStorage *getEmptyCopy(void);
+    void clearAll(bool invokeDestructor = true);
+
+    void Print(OPS_Stream &s, int flag =0);
+    friend class HashOfTaggedObjectsIter;
+
+  protected:
+
+  private:
+    struct Entry {
+      int tag;
+      int slot;    // -1 empty, -2 removed
+    };
+
+    int findEntry(int tag) const;
+    void rehash(int numEntries);
+    void squeeze(void);
+
+    std::vector<TaggedObject *> theComponents;  // dense, 0 for a hole
+    std::vector<Entry> theTable;
+    int numComponents;  // objects stored
+    int numUsed;        // entries of the table not empty
+    int shift;          // 32 - log2 of the table size
+
+    HashOfTaggedObjectsIter myIter;  // the iter for this object
+};
+
+#endif
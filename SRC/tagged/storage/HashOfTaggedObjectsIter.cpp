@@ -0,0 +1,59 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation of
+// HashOfTaggedObjectsIter.
+
+#include <HashOfTaggedObjectsIter.h>
+#include <HashOfTaggedObjects.h>
+
+HashOfTaggedObjectsIter::HashOfTaggedObjectsIter(HashOfTaggedObjects &theComponents)
+  :theStorage(&theComponents), currentSlot(0)
+{
+
+}
+
+
+HashOfTaggedObjectsIter::~HashOfTaggedObjectsIter()
+{
+
+}
+
+
+void
+HashOfTaggedObjectsIter::reset(void)
+{
+  currentSlot = 0;
+}
+
+
+TaggedObject *
+HashOfTaggedObjectsIter::operator()(void)
+{
+  // skip over the holes left by removed objects
+  int numSlots = theStorage->theComponents.size();
+  while (currentSlot < numSlots) {
+    TaggedObject *result = theStorage->theComponents[currentSlot++];
+    if (result != 0)
+      return result;
+  }
+
+  return 0;
+}
@@ -0,0 +1,132 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: microbenchmark of the TaggedObjectStorage classes. For
+// numComponents objects (default 10,000,000) with consecutive tags and
+// with sparse tags, as generated models often number them, it times
+// adding the objects, looking every one up in a shuffled order and
+// iterating over them, e.g.
+//
+//      make bench; ./bench 10000000
+
+#include <TaggedObject.h>
+#include <TaggedObjectIter.h>
+#include <ArrayOfTaggedObjects.h>
+#include <MapOfTaggedObjects.h>
+#include <HashOfTaggedObjects.h>
+
+#include <OPS_Globals.h>
+#include <StandardStream.h>
+
+#include <stdlib.h>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <random>
+
+StandardStream sserr;
+OPS_Stream *opserrPtr = &sserr;
+
+class BenchObject: public TaggedObject
+{
+  public:
+    BenchObject(int tag) :TaggedObject(tag), value(tag) {}
+    void Print(OPS_Stream &s, int flag =0) {s << this->getTag() << endln;}
+    double value;
+};
+
+static double
+elapsed(std::chrono::steady_clock::time_point start)
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void
+bench(const char *name, TaggedObjectStorage &theStorage,
+      const std::vector<int> &tags, const std::vector<int> &lookups)
+{
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (int tag : tags)
+    theStorage.addComponent(new BenchObject(tag));
+  double buildTime = elapsed(start);
+
+  start = std::chrono::steady_clock::now();
+  double sum = 0.0;
+  for (int tag : lookups)
+    sum += ((BenchObject *)theStorage.getComponentPtr(tag))->value;
+  double lookupTime = elapsed(start);
+
+  start = std::chrono::steady_clock::now();
+  TaggedObject *theObject;
+  TaggedObjectIter &theObjects = theStorage.getComponents();
+  while ((theObject = theObjects()) != 0)
+    sum -= ((BenchObject *)theObject)->value;
+  double iterTime = elapsed(start);
+
+  opserr << name << "  build: " << buildTime << " s  lookup: " << lookupTime
+	 << " s  iterate: " << iterTime << " s  (check " << sum << ")\n";
+
+  start = std::chrono::steady_clock::now();
+  theStorage.clearAll();
+  opserr << name << "  clear: " << elapsed(start) << " s\n";
+}
+
+int main(int argc, char **argv)
+{
+  int numComponents = 10000000;
+  if (argc > 1)
+    numComponents = atoi(argv[1]);
+
+  std::mt19937 generator(12345);
+
+  // consecutive tags, and sparse ones: blocks of 100 tags 10000 apart
+  std::vector<int> denseTags(numComponents);
+  std::vector<int> sparseTags(numComponents);
+  for (int i=0; i<numComponents; i++) {
+    denseTags[i] = i+1;
+    sparseTags[i] = (i/100)*10000 + i%100 + 1;
+  }
+  std::shuffle(sparseTags.begin(), sparseTags.end(), generator);
+
+  std::vector<int> denseLookups(denseTags);
+  std::vector<int> sparseLookups(sparseTags);
+  std::shuffle(denseLookups.begin(), denseLookups.end(), generator);
+  std::shuffle(sparseLookups.begin(), sparseLookups.end(), generator);
+
+  opserr << numComponents << " components, consecutive tags\n";
+  {
+    ArrayOfTaggedObjects theArray(numComponents+1);
+    bench("Array", theArray, denseTags, denseLookups);
+    MapOfTaggedObjects theMap;
+    bench("Map  ", theMap, denseTags, denseLookups);
+    HashOfTaggedObjects theHash;
+    bench("Hash ", theHash, denseTags, denseLookups);
+  }
+
+  opserr << numComponents << " components, sparse tags added in random order\n";
+  {
+    MapOfTaggedObjects theMap;
+    bench("Map  ", theMap, sparseTags, sparseLookups);
+    HashOfTaggedObjects theHash;
+    bench("Hash ", theHash, sparseTags, sparseLookups);
+  }
+
+  return 0;
+}
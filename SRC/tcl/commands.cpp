@@ -38,6 +38,7 @@
 #include <mpi.h>
 #elif _PARALLEL_INTERPRETERS
 #include <mpi.h>
+#include <MPI_Channel.h>
 #endif
 
 extern "C" {
@@ -112,6 +113,9 @@ extern "C" int OPS_ResetInputNoBuilder(ClientData clientData, Tcl_Interp * inter
 #endif
 
 #include <Information.h>
+#include <MapOfTaggedObjects.h>
+#include <ArrayOfTaggedObjects.h>
+#include <HashOfTaggedObjects.h>
 #include <Element.h>
 #include <Node.h>
 #include <ElementIter.h>
@@ -356,6 +360,9 @@ extern void OPS_SetReliabilityDomain(ReliabilityDomain *);
 #include <SymSparseLinSolver.h>
 #include <UmfpackGenLinSOE.h>
 #include <UmfpackGenLinSolver.h>
+#include <SupernodalSPDLinSOE.h>
+#include <SupernodalSPDLinSolver.h>
+extern void *OPS_KrylovLinSolver(void);
 #include <EigenSOE.h>
 #include <EigenSolver.h>
 #include <ArpackSOE.h>
@@ -467,6 +474,8 @@ int OPS_MAIN_DOMAIN_PARTITION_ID =0;
 DomainPartitioner *OPS_DOMAIN_PARTITIONER =0;
 GraphPartitioner  *OPS_GRAPH_PARTITIONER =0;
 LoadBalancer      *OPS_BALANCER = 0;
+int OPS_BALANCE_INTERVAL = 0;
+double OPS_BALANCE_IMBALANCE = 1.0;
 FEM_ObjectBroker  *OPS_OBJECT_BROKER =0;
 MachineBroker     *OPS_MACHINE =0;
 Channel          **OPS_theChannels = 0;
@@ -582,6 +591,7 @@ static Timer *theTimer = 0;
 
 #include <FileStream.h>
 #include <SimulationInformation.h>
+#include <Profiler.h>
 SimulationInformation simulationInfo;
 SimulationInformation *theSimulationInfoPtr = 0;
 
@@ -678,6 +688,9 @@ convertBinaryToText(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Cha
 int
 convertTextToBinary(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
 
+int
+columnFileToText(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
+
 int
 maxOpenFiles(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
 
@@ -1017,6 +1030,7 @@ int OpenSeesAppInit(Tcl_Interp *interp) {
     Tcl_CreateCommand(interp, "stripXML", &stripOpenSeesXML,(ClientData)NULL, NULL);
     Tcl_CreateCommand(interp, "convertBinaryToText", &convertBinaryToText,(ClientData)NULL, NULL);
     Tcl_CreateCommand(interp, "convertTextToBinary", &convertTextToBinary,(ClientData)NULL, NULL);
+    Tcl_CreateCommand(interp, "columnFileToText", &columnFileToText,(ClientData)NULL, NULL);
 
     Tcl_CreateCommand(interp, "getEleTags", &getEleTags, 
 		      (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);  
@@ -1100,6 +1114,20 @@ int OpenSeesAppInit(Tcl_Interp *interp) {
 		      (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);  
     Tcl_CreateCommand(interp, "systemSize", &systemSize, 
 		      (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);  
+    Tcl_CreateCommand(interp, "systemStat", &systemStat, 
+		      (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);  
+    Tcl_CreateCommand(interp, "domainStat", &domainStat, 
+		      (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);  
+    Tcl_CreateCommand(interp, "domainThreads", &domainThreads, 
+		      (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);  
+    Tcl_CreateCommand(interp, "domainNodalStore", &domainNodalStore, 
+		      (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);  
+    Tcl_CreateCommand(interp, "domainStorage", &domainStorage, 
+		      (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);  
+    Tcl_CreateCommand(interp, "profiler", &profiler, 
+		      (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);  
+    Tcl_CreateCommand(interp, "elementCosts", &elementCosts, 
+		      (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);  
     Tcl_CreateCommand(interp, "version", &version, 
 		      (ClientData)NULL, (Tcl_CmdDeleteProc *)NULL);  
 
@@ -1846,11 +1874,14 @@ partitionModel(int eleTag)
 
   // create a partitioner & partition the domain
   if (OPS_DOMAIN_PARTITIONER == 0) {
-    //      OPS_BALANCER = new ShedHeaviest();
     OPS_GRAPH_PARTITIONER  = new Metis;
-    //OPS_DOMAIN_PARTITIONER = new DomainPartitioner(*OPS_GRAPH_PARTITIONER, *OPS_BALANCER);
-    OPS_DOMAIN_PARTITIONER = new DomainPartitioner(*OPS_GRAPH_PARTITIONER);
+    if (OPS_BALANCE_INTERVAL > 0) {
+      OPS_BALANCER = new ShedHeaviest();
+      OPS_DOMAIN_PARTITIONER = new DomainPartitioner(*OPS_GRAPH_PARTITIONER, *OPS_BALANCER);
+    } else
+      OPS_DOMAIN_PARTITIONER = new DomainPartitioner(*OPS_GRAPH_PARTITIONER);
     theDomain.setPartitioner(OPS_DOMAIN_PARTITIONER);
+    theDomain.setLoadBalancing(OPS_BALANCE_INTERVAL, OPS_BALANCE_IMBALANCE);
   }
 
  // opserr << "commands.cpp - partition numPartitions: " << OPS_NUM_SUBDOMAINS << endln;
@@ -1904,11 +1935,25 @@ int
 opsPartition(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
 {
 #ifdef _PARALLEL_PROCESSING
-  int eleTag;
-  if (argc == 2) {
-    if (Tcl_GetInt(interp, argv[1], &eleTag) != TCL_OK) {
+  // partition <eleTag> <-balance interval <imbalance>>
+  int eleTag = 0;
+  int argi = 1;
+  if (argc > argi && strcmp(argv[argi], "-balance") != 0) {
+    if (Tcl_GetInt(interp, argv[argi], &eleTag) != TCL_OK) {
       ;
     }
+    argi++;
+  }
+  if (argc > argi + 1 && strcmp(argv[argi], "-balance") == 0) {
+    if (Tcl_GetInt(interp, argv[argi+1], &OPS_BALANCE_INTERVAL) != TCL_OK) {
+      opserr << "WARNING partition -balance interval <imbalance> - invalid interval " << argv[argi+1] << endln;
+      return TCL_ERROR;
+    }
+    if (argc > argi + 2 &&
+	Tcl_GetDouble(interp, argv[argi+2], &OPS_BALANCE_IMBALANCE) != TCL_OK) {
+      opserr << "WARNING partition -balance interval <imbalance> - invalid imbalance " << argv[argi+2] << endln;
+      return TCL_ERROR;
+    }
   }
   partitionModel(eleTag);
 #endif
@@ -3523,6 +3568,35 @@ specifySOE(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
     theSOE = new UmfpackGenLinSOE(*theSolver);      
   }
 
+  else if (strcmp(argv[1],"SupernodalSPD") == 0) {
+
+    // system SupernodalSPD <-numThreads $numThreads>
+    int numThreads = 1;
+    int count = 2;
+    while (count < argc) {
+      if (strcmp(argv[count],"-numThreads") == 0 && count+1 < argc) {
+	if (Tcl_GetInt(interp, argv[count+1], &numThreads) != TCL_OK || numThreads < 1) {
+	  opserr << "WARNING system SupernodalSPD -numThreads numThreads - invalid numThreads " << argv[count+1] << endln;
+	  return TCL_ERROR;
+	}
+	count++;
+      }
+      count++;
+    }
+
+    SupernodalSPDLinSolver *theSolver = new SupernodalSPDLinSolver(numThreads);
+    theSOE = new SupernodalSPDLinSOE(*theSolver);
+  }
+
+  else if (strcmp(argv[1],"Krylov") == 0) {
+
+    // system Krylov <-method $method> <-precond $precond> <-tol $tol> ...
+    OPS_ResetInputNoBuilder(clientData, interp, 2, argc, argv, &theDomain);
+    theSOE = (LinearSOE *)OPS_KrylovLinSolver();
+    if (theSOE == 0)
+      return TCL_ERROR;
+  }
+
 #ifdef _ITPACK
   else if (strcmp(argv[1],"Itpack") == 0) {
     
@@ -4309,6 +4383,19 @@ int
 specifyIntegrator(ClientData clientData, Tcl_Interp *interp, int argc, 
 		  TCL_Char **argv)
 {
+  // check for the number of assembly threads ahead of the type,
+  // i.e. integrator -numThreads $numThreads type args ..
+  int numThreads = 0;
+  if (argc > 2 && strcmp(argv[1],"-numThreads") == 0) {
+    if (Tcl_GetInt(interp, argv[2], &numThreads) != TCL_OK || numThreads < 1) {
+      opserr << "WARNING integrator -numThreads numThreads type ... - invalid numThreads " << argv[2] << endln;
+      return TCL_ERROR;
+    }
+    argc -= 2;
+    argv += 2;
+  }
+  StaticIntegrator *oldStaticIntegrator = theStaticIntegrator;
+  TransientIntegrator *oldTransientIntegrator = theTransientIntegrator;
 
     OPS_ResetInputNoBuilder(clientData, interp, 2, argc, argv, &theDomain);
 
@@ -5351,6 +5438,13 @@ specifyIntegrator(ClientData clientData, Tcl_Interp *interp, int argc,
     return TCL_ERROR;
   }    
 
+  if (numThreads > 0) {
+    if (theStaticIntegrator != oldStaticIntegrator && theStaticIntegrator != 0)
+      theStaticIntegrator->setNumThreads(numThreads);
+    else if (theTransientIntegrator != oldTransientIntegrator && theTransientIntegrator != 0)
+      theTransientIntegrator->setNumThreads(numThreads);
+  }
+
 #ifdef _PARALLEL_PROCESSING
 
   if (theStaticAnalysis != 0 && theStaticIntegrator != 0) {
@@ -9249,6 +9343,8 @@ int
 opsBarrier(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
 {
 #ifdef _PARALLEL_INTERPRETERS
+  // data held back by the channels could be what the others wait on
+  MPI_Channel::flushAll();
   return MPI_Barrier(MPI_COMM_WORLD);
 #endif
 
@@ -9291,6 +9387,7 @@ opsSend(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
 
   } else {
     if (myPID == 0) { 
+      MPI_Channel::flushAll();
       MPI_Bcast((void *)(&msgLength), 1, MPI_INT,  0, MPI_COMM_WORLD);
       MPI_Bcast((void *)gMsg, msgLength, MPI_CHAR, 0, MPI_COMM_WORLD);
     } else {
@@ -9335,6 +9432,7 @@ opsRecv(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
 	}
 
     if (otherPID > -1 && otherPID < np) {
+      MPI_Channel::flushAll();
       MPI_Status status;
       
       if (fromAny == false)
@@ -9364,6 +9462,7 @@ opsRecv(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
   } else {
 
     if (myPID != 0) {
+      MPI_Channel::flushAll();
       MPI_Bcast((void *)(&msgLength), 1, MPI_INT, 0, MPI_COMM_WORLD);
 
       if (msgLength > 0) {
@@ -9753,6 +9852,40 @@ int convertTextToBinary(ClientData clientData, Tcl_Interp *interp, int argc, TCL
   return textToBinary(inputFile, outputFile);
 }
 
+extern int columnFileToText(const char *inputFilename, const char *outputFilename,
+			    const ID &columns, bool writeNames);
+
+int columnFileToText(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
+{
+  if (argc < 3) {
+    opserr << "ERROR incorrect # args - columnFileToText inputFile outputFile <-names> <column1 column2 ...>\n";
+    return TCL_ERROR;
+  }
+
+  const char *inputFile = argv[1];
+  const char *outputFile = argv[2];
+
+  bool writeNames = false;
+  ID columns(0, 8);
+  for (int i=3; i<argc; i++) {
+    if (strcmp(argv[i], "-names") == 0) {
+      writeNames = true;
+      continue;
+    }
+    int column;
+    if (Tcl_GetInt(interp, argv[i], &column) != TCL_OK) {
+      opserr << "WARNING columnFileToText - invalid column " << argv[i] << "\n";
+      return TCL_ERROR;
+    }
+    columns[columns.Size()] = column;
+  }
+
+  if (columnFileToText(inputFile, outputFile, columns, writeNames) < 0)
+    return TCL_ERROR;
+
+  return TCL_OK;
+}
+
 int domainChange(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
 {
   theDomain.domainChange();
@@ -9941,6 +10074,234 @@ systemSize(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
   return TCL_OK;
 }
 
+int
+systemStat(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
+{
+  char buffer[40];
+
+  if (theSOE == 0) {
+    opserr << "WARNING systemStat - no system set\n";
+    return TCL_ERROR;
+  }
+
+  if (argc < 2) {
+    opserr << "WARNING systemStat name - no name given\n";
+    return TCL_ERROR;
+  }
+
+  // counters kept by the solver, e.g. numSymbolicReused for Umfpack
+  LinearSOESolver *theSolver = theSOE->getSolver();
+  Information theInfo;
+  if (theSolver == 0 || theSolver->getVariable(argv[1], theInfo) < 0) {
+    opserr << "WARNING systemStat - solver does not provide " << argv[1] << endln;
+    return TCL_ERROR;
+  }
+
+  if (theInfo.theType == DoubleType)
+    sprintf(buffer, "%.15g", theInfo.theDouble);
+  else
+    sprintf(buffer, "%d", theInfo.theInt);
+  Tcl_SetResult(interp, buffer, TCL_VOLATILE);
+
+  return TCL_OK;
+}
+
+int
+domainStat(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
+{
+  char buffer[40];
+
+  if (argc < 2) {
+    opserr << "WARNING domainStat name - no name given\n";
+    return TCL_ERROR;
+  }
+
+  if (strcmp(argv[1], "reset") == 0) {
+    theDomain.resetPhaseStats();
+    return TCL_OK;
+  }
+
+  // timings of the commit, revert and update sweeps, e.g. updateTime
+  Information theInfo;
+  if (theDomain.getPhaseStat(argv[1], theInfo) < 0) {
+    opserr << "WARNING domainStat - domain does not provide " << argv[1] << endln;
+    return TCL_ERROR;
+  }
+
+  if (theInfo.theType == DoubleType)
+    sprintf(buffer, "%.15g", theInfo.theDouble);
+  else
+    sprintf(buffer, "%d", theInfo.theInt);
+  Tcl_SetResult(interp, buffer, TCL_VOLATILE);
+
+  return TCL_OK;
+}
+
+int
+domainThreads(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
+{
+  int numThreads;
+
+  if (argc < 2) {
+    opserr << "WARNING domainThreads numThreads - no numThreads given\n";
+    return TCL_ERROR;
+  }
+
+  if (Tcl_GetInt(interp, argv[1], &numThreads) != TCL_OK) {
+    opserr << "WARNING domainThreads numThreads - invalid numThreads " << argv[1] << endln;
+    return TCL_ERROR;
+  }
+
+  if (theDomain.setNumThreads(numThreads) < 0)
+    return TCL_ERROR;
+
+  return TCL_OK;
+}
+
+int
+domainStorage(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
+{
+  if (argc < 3) {
+    opserr << "WARNING domainStorage componentType storageType - insufficient args\n";
+    return TCL_ERROR;
+  }
+
+  TaggedObjectStorage *theStorage = 0;
+  if (strcmp(argv[2], "Map") == 0)
+    theStorage = new MapOfTaggedObjects();
+  else if (strcmp(argv[2], "Array") == 0)
+    theStorage = new ArrayOfTaggedObjects(1024);
+  else if (strcmp(argv[2], "Hash") == 0)
+    theStorage = new HashOfTaggedObjects();
+  else {
+    opserr << "WARNING domainStorage - unknown storageType " << argv[2] << ", Map, Array or Hash\n";
+    return TCL_ERROR;
+  }
+
+  if (theDomain.setStorage(argv[1], theStorage) < 0) {
+    delete theStorage;
+    return TCL_ERROR;
+  }
+
+  return TCL_OK;
+}
+
+int
+domainNodalStore(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
+{
+  int flag;
+
+  if (argc < 2) {
+    opserr << "WARNING domainNodalStore flag - no flag given\n";
+    return TCL_ERROR;
+  }
+
+  if (Tcl_GetInt(interp, argv[1], &flag) != TCL_OK) {
+    opserr << "WARNING domainNodalStore flag - invalid flag " << argv[1] << endln;
+    return TCL_ERROR;
+  }
+
+  if (theDomain.setNodalStateStore(flag != 0) < 0)
+    return TCL_ERROR;
+
+  return TCL_OK;
+}
+
+int
+profiler(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
+{
+  if (argc < 2) {
+    opserr << "WARNING profiler on <-trace>|off|reset|print|dump fileName <-json|-csv|-trace> - no action given\n";
+    return TCL_ERROR;
+  }
+
+  if (strcmp(argv[1], "on") == 0) {
+    bool trace = (argc > 2 && strcmp(argv[2], "-trace") == 0);
+    if (Profiler::enable(trace) < 0)
+      return TCL_ERROR;
+
+  } else if (strcmp(argv[1], "off") == 0) {
+    Profiler::disable();
+
+  } else if (strcmp(argv[1], "reset") == 0) {
+    Profiler::reset();
+
+  } else if (strcmp(argv[1], "print") == 0) {
+    Profiler::Print(opserr);
+
+  } else if (strcmp(argv[1], "dump") == 0) {
+    if (argc < 3) {
+      opserr << "WARNING profiler dump fileName <-json|-csv|-trace> - no fileName given\n";
+      return TCL_ERROR;
+    }
+    const char *format = "json";
+    if (argc > 3) {
+      if (strcmp(argv[3], "-csv") == 0)
+	format = "csv";
+      else if (strcmp(argv[3], "-trace") == 0)
+	format = "trace";
+      else if (strcmp(argv[3], "-json") != 0) {
+	opserr << "WARNING profiler dump - unknown format " << argv[3] << ", -json, -csv or -trace\n";
+	return TCL_ERROR;
+      }
+    }
+    if (Profiler::dump(argv[2], format) < 0)
+      return TCL_ERROR;
+
+  } else {
+    opserr << "WARNING profiler - unknown action " << argv[1] << ", on, off, reset, print or dump\n";
+    return TCL_ERROR;
+  }
+
+  return TCL_OK;
+}
+
+int
+elementCosts(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
+{
+  if (argc < 2) {
+    opserr << "WARNING elementCosts on|off|reset|print <numTop> <-file fileName> - no action given\n";
+    return TCL_ERROR;
+  }
+
+  if (strcmp(argv[1], "on") == 0) {
+    Element::setMeasureCosts(true);
+
+  } else if (strcmp(argv[1], "off") == 0) {
+    Element::setMeasureCosts(false);
+
+  } else if (strcmp(argv[1], "reset") == 0) {
+    theDomain.resetElementCosts();
+
+  } else if (strcmp(argv[1], "print") == 0) {
+    int numTop = 10;
+    const char *fileName = 0;
+    for (int i = 2; i < argc; i++) {
+      if (strcmp(argv[i], "-file") == 0 && i+1 < argc) {
+	fileName = argv[++i];
+      } else if (Tcl_GetInt(interp, argv[i], &numTop) != TCL_OK) {
+	opserr << "WARNING elementCosts print - invalid numTop " << argv[i] << endln;
+	return TCL_ERROR;
+      }
+    }
+
+    int res;
+    if (fileName != 0) {
+      FileStream theFile(fileName);
+      res = theDomain.printElementCosts(theFile, numTop);
+    } else
+      res = theDomain.printElementCosts(opserr, numTop);
+    if (res < 0)
+      return TCL_ERROR;
+
+  } else {
+    opserr << "WARNING elementCosts - unknown action " << argv[1] << ", on, off, reset or print\n";
+    return TCL_ERROR;
+  }
+
+  return TCL_OK;
+}
+
 int
 numIter(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv)
 {
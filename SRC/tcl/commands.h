@@ -382,6 +382,27 @@ numIter(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
 int 
 systemSize(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
 
+int 
+systemStat(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
+
+int 
+domainStat(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
+
+int 
+domainThreads(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
+
+int 
+domainStorage(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
+
+int 
+domainNodalStore(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
+
+int 
+profiler(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
+
+int 
+elementCosts(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
+
 int
 elementActivate(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char **argv);
 int
@@ -0,0 +1,382 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+// Description: This file contains the implementation of Profiler.
+
+#include <Profiler.h>
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+bool Profiler::enabled = false;
+
+namespace {
+
+  typedef std::chrono::steady_clock Clock;
+
+  // a node of the tree of region paths, node 0 is the root
+  struct Node {
+    int region;
+    int parent;
+    long calls;
+    double total;
+    double children;            // time of the child nodes
+    std::vector<int> childNodes;
+  };
+
+  struct Event {
+    int node;
+    double start;
+    double duration;
+  };
+
+  const size_t maxEvents = 1000000;
+
+  // the class regions last looked up by each thread, indexed by a hash
+  // of the class tag, so the lookup in the element loops takes no lock
+  struct ClassEntry {
+    ClassEntry() :classTag(0), region(-1) {};
+    int classTag;
+    int region;
+    std::string className;
+  };
+  const int numClassEntries = 256;
+  thread_local ClassEntry classEntries[numClassEntries];
+
+  std::mutex theMutex;          // guards the registration of names
+  std::vector<std::string> regionNames;
+  std::unordered_map<std::string, int> regionIds;
+  std::map<std::pair<std::string, int>, int> classRegions;
+  std::vector<std::string> counterNames;
+  std::vector<long> counters;
+
+  std::vector<Node> nodes;
+  std::vector<int> openNodes;
+  std::vector<Clock::time_point> openTimes;
+  std::vector<Event> events;
+  long numDropped = 0;
+  bool tracing = false;
+  std::thread::id owner;
+  Clock::time_point origin;
+
+  void clearNodes(void)
+  {
+    nodes.clear();
+    Node root = {-1, -1, 0, 0.0, 0.0, std::vector<int>()};
+    nodes.push_back(root);
+    openNodes.clear();
+    openNodes.push_back(0);
+    openTimes.clear();
+    events.clear();
+    numDropped = 0;
+    for (size_t i = 0; i < counters.size(); i++)
+      counters[i] = 0;
+    origin = Clock::now();
+  }
+
+  int addRegion(const std::string &name)
+  {
+    std::unordered_map<std::string, int>::iterator it = regionIds.find(name);
+    if (it != regionIds.end())
+      return it->second;
+    int id = regionNames.size();
+    regionNames.push_back(name);
+    regionIds[name] = id;
+    return id;
+  }
+
+  std::string getPath(int node)
+  {
+    std::string path = regionNames[nodes[node].region];
+    for (int p = nodes[node].parent; p > 0; p = nodes[p].parent)
+      path = regionNames[nodes[p].region] + "/" + path;
+    return path;
+  }
+
+  // the nodes in depth first order, with their depth
+  void getOrder(int node, int depth, std::vector<std::pair<int, int> > &order)
+  {
+    if (node != 0)
+      order.push_back(std::make_pair(node, depth));
+    const std::vector<int> &childNodes = nodes[node].childNodes;
+    for (size_t i = 0; i < childNodes.size(); i++)
+      getOrder(childNodes[i], depth+1, order);
+  }
+
+  void writeString(std::ostream &s, const std::string &str)
+  {
+    s << '"';
+    for (size_t i = 0; i < str.size(); i++) {
+      if (str[i] == '"' || str[i] == '\\')
+	s << '\\';
+      s << str[i];
+    }
+    s << '"';
+  }
+}
+
+int
+Profiler::enable(bool trace)
+{
+  std::lock_guard<std::mutex> lock(theMutex);
+  if (enabled == false) {
+    owner = std::this_thread::get_id();
+    if (nodes.empty())
+      clearNodes();
+  } else if (owner != std::this_thread::get_id()) {
+    opserr << "Profiler::enable() - already enabled by another thread\n";
+    return -1;
+  }
+  tracing = trace;
+  enabled = true;
+  return 0;
+}
+
+void
+Profiler::disable(void)
+{
+  enabled = false;
+}
+
+void
+Profiler::reset(void)
+{
+  std::lock_guard<std::mutex> lock(theMutex);
+  clearNodes();
+}
+
+int
+Profiler::getRegion(const char *name)
+{
+  std::lock_guard<std::mutex> lock(theMutex);
+  return addRegion(name);
+}
+
+int
+Profiler::getClassRegion(int classTag, const char *className)
+{
+  // the class tags of elements, solvers, etc. overlap, the name and tag
+  // together are unique; the names are compared as strings as the same
+  // literal may have a different address in each translation unit
+  ClassEntry &theEntry = classEntries[(unsigned int)classTag % numClassEntries];
+  if (theEntry.region >= 0 && theEntry.classTag == classTag && theEntry.className == className)
+    return theEntry.region;
+
+  std::lock_guard<std::mutex> lock(theMutex);
+  std::pair<std::string, int> key(className, classTag);
+  std::map<std::pair<std::string, int>, int>::iterator it = classRegions.find(key);
+  int id;
+  if (it != classRegions.end())
+    id = it->second;
+  else {
+    // classes that do not override getClassType() are told apart by tag
+    std::string name = className;
+    if (name.empty() || name == "UnknownMovableObject")
+      name = "classTag" + std::to_string(classTag);
+    id = addRegion(name);
+    classRegions[key] = id;
+  }
+
+  theEntry.classTag = classTag;
+  theEntry.className = className;
+  theEntry.region = id;
+  return id;
+}
+
+int
+Profiler::getCounter(const char *name)
+{
+  std::lock_guard<std::mutex> lock(theMutex);
+  for (size_t i = 0; i < counterNames.size(); i++)
+    if (counterNames[i] == name)
+      return i;
+  counterNames.push_back(name);
+  counters.push_back(0);
+  return counterNames.size() - 1;
+}
+
+bool
+Profiler::start(int region)
+{
+  if (enabled == false || region < 0 || std::this_thread::get_id() != owner)
+    return false;
+
+  int parent = openNodes.back();
+  int node = -1;
+  const std::vector<int> &childNodes = nodes[parent].childNodes;
+  for (size_t i = 0; i < childNodes.size(); i++)
+    if (nodes[childNodes[i]].region == region) {
+      node = childNodes[i];
+      break;
+    }
+
+  if (node < 0) {
+    node = nodes.size();
+    Node newNode = {region, parent, 0, 0.0, 0.0, std::vector<int>()};
+    nodes.push_back(newNode);
+    nodes[parent].childNodes.push_back(node);
+  }
+
+  openNodes.push_back(node);
+  openTimes.push_back(Clock::now());
+  return true;
+}
+
+void
+Profiler::stop(void)
+{
+  // the stack is emptied by a reset() while regions are open
+  if (openTimes.empty())
+    return;
+
+  Clock::time_point now = Clock::now();
+  double time = std::chrono::duration<double>(now - openTimes.back()).count();
+  int node = openNodes.back();
+  openNodes.pop_back();
+  openTimes.pop_back();
+
+  Node &theNode = nodes[node];
+  theNode.calls++;
+  theNode.total += time;
+  nodes[theNode.parent].children += time;
+
+  if (tracing) {
+    if (events.size() < maxEvents) {
+      Event theEvent;
+      theEvent.node = node;
+      theEvent.duration = time;
+      theEvent.start = std::chrono::duration<double>(now - origin).count() - time;
+      events.push_back(theEvent);
+    } else
+      numDropped++;
+  }
+}
+
+void
+Profiler::count(int counter, long n)
+{
+  if (enabled == false || std::this_thread::get_id() != owner)
+    return;
+  counters[counter] += n;
+}
+
+int
+Profiler::dump(const char *fileName, const char *format)
+{
+  std::string theFormat = format;
+  if (theFormat != "json" && theFormat != "csv" && theFormat != "trace") {
+    opserr << "Profiler::dump() - unknown format " << format << "\n";
+    return -1;
+  }
+
+  std::ofstream theFile(fileName);
+  if (!theFile) {
+    opserr << "Profiler::dump() - could not open file " << fileName << "\n";
+    return -1;
+  }
+  theFile << std::setprecision(9);
+
+  std::lock_guard<std::mutex> lock(theMutex);
+
+  std::vector<std::pair<int, int> > order;
+  if (!nodes.empty())
+    getOrder(0, 0, order);
+
+  if (theFormat == "csv") {
+    theFile << "path,calls,total,self\n";
+    for (size_t i = 0; i < order.size(); i++) {
+      const Node &theNode = nodes[order[i].first];
+      theFile << getPath(order[i].first) << ',' << theNode.calls << ','
+	      << theNode.total << ',' << theNode.total - theNode.children << "\n";
+    }
+    theFile << "\ncounter,value\n";
+    for (size_t i = 0; i < counterNames.size(); i++)
+      theFile << counterNames[i] << ',' << counters[i] << "\n";
+
+  } else if (theFormat == "json") {
+    theFile << "{\n  \"regions\": [";
+    for (size_t i = 0; i < order.size(); i++) {
+      const Node &theNode = nodes[order[i].first];
+      theFile << (i == 0 ? "\n" : ",\n") << "    {\"path\": ";
+      writeString(theFile, getPath(order[i].first));
+      theFile << ", \"name\": ";
+      writeString(theFile, regionNames[theNode.region]);
+      theFile << ", \"depth\": " << order[i].second
+	      << ", \"calls\": " << theNode.calls
+	      << ", \"total\": " << theNode.total
+	      << ", \"self\": " << theNode.total - theNode.children << "}";
+    }
+    theFile << "\n  ],\n  \"counters\": {";
+    for (size_t i = 0; i < counterNames.size(); i++) {
+      theFile << (i == 0 ? "\n    " : ",\n    ");
+      writeString(theFile, counterNames[i]);
+      theFile << ": " << counters[i];
+    }
+    theFile << "\n  }\n}\n";
+
+  } else {
+    // complete events with times in microseconds
+    theFile << "{\"traceEvents\": [";
+    for (size_t i = 0; i < events.size(); i++) {
+      theFile << (i == 0 ? "\n" : ",\n") << "{\"name\": ";
+      writeString(theFile, regionNames[nodes[events[i].node].region]);
+      theFile << ", \"ph\": \"X\", \"pid\": 0, \"tid\": 0, \"ts\": "
+	      << events[i].start*1.0e6 << ", \"dur\": " << events[i].duration*1.0e6 << "}";
+    }
+    theFile << "\n], \"displayTimeUnit\": \"ms\"}\n";
+    if (numDropped != 0)
+      opserr << "Profiler::dump() - trace is missing the last " << OPS_Stream::toString(numDropped).c_str() << " events\n";
+  }
+
+  theFile.close();
+  if (!theFile) {
+    opserr << "Profiler::dump() - failed to write file " << fileName << "\n";
+    return -1;
+  }
+  return 0;
+}
+
+void
+Profiler::Print(OPS_Stream &s)
+{
+  std::lock_guard<std::mutex> lock(theMutex);
+
+  std::vector<std::pair<int, int> > order;
+  if (!nodes.empty())
+    getOrder(0, 0, order);
+
+  s << "Profiler: region, calls, total time, self time\n";
+  for (size_t i = 0; i < order.size(); i++) {
+    const Node &theNode = nodes[order[i].first];
+    std::string indent(2*order[i].second, ' ');
+    s << indent.c_str() << regionNames[theNode.region].c_str() << "  "
+      << OPS_Stream::toString(theNode.calls).c_str() << "  " << theNode.total << "  "
+      << theNode.total - theNode.children << "\n";
+  }
+  for (size_t i = 0; i < counterNames.size(); i++)
+    s << counterNames[i].c_str() << "  " << OPS_Stream::toString(counters[i]).c_str() << "\n";
+}
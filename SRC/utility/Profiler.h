@@ -0,0 +1,81 @@
+/* ****************************************************************** **
+**    OpenSees - Open System for Earthquake Engineering Simulation    **
+**          Pacific Earthquake Engineering Research Center            **
+**                                                                    **
+**                                                                    **
+** (C) Copyright 1999, The Regents of the University of California    **
+** All Rights Reserved.                                               **
+**                                                                    **
+** Commercial use of this program without express permission of the   **
+** University of California, Berkeley, is strictly prohibited.  See   **
+** file 'COPYRIGHT'  in main directory for information on usage and   **
+** redistribution,  and for a DISCLAIMER OF ALL WARRANTIES.           **
+**                                                                    **
+** Developed by:                                                      **
+**   Frank McKenna (fmckenna@ce.berkeley.edu)                         **
+**   Gregory L. Fenves (fenves@ce.berkeley.edu)                       **
+**   Filip C. Filippou (filippou@ce.berkeley.edu)                     **
+**                                                                    **
+** ****************************************************************** */
+
+#ifndef Profiler_h
+#define Profiler_h
+
+// Description: This file contains the class definition for Profiler.
+// Profiler collects the wall clock time spent in named regions of the
+// analysis, e.g. the steps, the formation of the tangent, the solution
+// of the system and the update of the elements. Regions opened while
+// another is open are recorded as its children, so the times are kept
+// for each path of regions, e.g. analyze/step/formTangent/ElasticBeam3d.
+// Besides the times, named counters are kept, e.g. of the iterations.
+//
+// The profiler is off until enable() is invoked, and while off a
+// ProfilerScope costs a test of a flag. Only the thread that enabled the
+// profiler records, regions opened by other threads are ignored. With
+// trace on, each region closed is also kept as an event, up to a limit,
+// which dump() can write in the Chrome trace format.
+
+#include <OPS_Globals.h>
+
+class Profiler
+{
+  public:
+    static int enable(bool trace = false);
+    static void disable(void);
+    static void reset(void);
+    static bool isEnabled(void) {return enabled;};
+
+    // regions and counters are registered once by name, the returned
+    // ids stay valid for the run, including after a reset()
+    static int getRegion(const char *name);
+    static int getClassRegion(int classTag, const char *className);
+    static int getCounter(const char *name);
+
+    // start() returns false if the region is not recorded, e.g. a
+    // negative region, and stop() is then not to be invoked
+    static bool start(int region);
+    static void stop(void);
+    static void count(int counter, long n = 1);
+
+    // format is json, csv or trace
+    static int dump(const char *fileName, const char *format);
+    static void Print(OPS_Stream &s);
+
+  private:
+    static bool enabled;
+};
+
+// ProfilerScope records the region from its construction to the end of
+// the enclosing block
+class ProfilerScope
+{
+  public:
+    ProfilerScope(int region)
+      :active(Profiler::isEnabled() && Profiler::start(region)) {};
+    ~ProfilerScope() {if (active) Profiler::stop();};
+
+  private:
+    bool active;
+};
+
+#endif
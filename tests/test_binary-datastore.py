@@ -0,0 +1,97 @@
+try:
+   import opensees as ops
+except ModuleNotFoundError:
+   import openseespy.opensees as ops
+import pytest
+
+H = 120
+E = 29000
+Fy = 50
+d = 12
+b = 8
+P = 50
+
+NUM_STEPS = 3
+
+def cantilever():
+   ops.wipe()
+   ops.model('basic','-ndm',2,'-ndf',3)
+
+   ops.uniaxialMaterial('Steel02',1,Fy,E,0.01,18,0.925,0.15)
+   ops.section('Fiber',1)
+   ops.patch('rect',1,16,1,-d/2,-b/2,d/2,b/2)
+
+   ops.beamIntegration('Lobatto',1,1,5)
+   ops.geomTransf('PDelta',1)
+
+   ops.node(1,0,0); ops.fix(1,1,1,1)
+   ops.node(2,0,H)
+   ops.element('forceBeamColumn',1,1,2,1,1)
+
+   ops.timeSeries('Linear',1)
+   ops.pattern('Plain',1,1)
+   ops.load(2,P,-P,0)
+
+   ops.constraints('Plain')
+   ops.numberer('RCM')
+   ops.system('BandGen')
+   ops.test('NormDispIncr',1.0e-10,50)
+   ops.algorithm('Newton')
+   ops.integrator('LoadControl',0.5)
+   ops.analysis('Static','-noWarnings')
+
+def test_binary_restore(tmp_path):
+   fileName = str(tmp_path / 'checkpoint')
+
+   cantilever()
+   ops.database('Binary',fileName)
+   saved = {}
+   for step in range(1,NUM_STEPS+1):
+      assert ops.analyze(1) == 0
+      ops.save(step)
+      saved[step] = ops.nodeDisp(2)
+
+   for step in range(NUM_STEPS,0,-1):
+      ops.restore(step)
+      for u1, u2 in zip(saved[step], ops.nodeDisp(2)):
+         assert u1 == u2
+
+def test_binary_torn_save(tmp_path):
+   # a run killed during the last save has written part of its records
+   # but not yet pointed the file header at its commit record; the
+   # earlier checkpoints must still be restored
+   fileName = str(tmp_path / 'checkpoint')
+
+   cantilever()
+   ops.database('Binary',fileName)
+   saved = {}
+   for step in range(1,NUM_STEPS+1):
+      assert ops.analyze(1) == 0
+      ops.save(step)
+      saved[step] = ops.nodeDisp(2)
+      if step == NUM_STEPS-1:
+         with open(fileName,'rb') as f:
+            committed = f.read()
+   ops.wipe()
+
+   with open(fileName,'rb') as f:
+      last = f.read()
+   torn = committed + last[len(committed):(len(committed)+len(last))//2]
+   tornName = str(tmp_path / 'torn')
+   with open(tornName,'wb') as f:
+      f.write(torn)
+
+   cantilever()
+   ops.database('Binary',tornName)
+   for step in range(NUM_STEPS-1,0,-1):
+      ops.restore(step)
+      for u1, u2 in zip(saved[step], ops.nodeDisp(2)):
+         assert u1 == u2
+
+   with pytest.raises(Exception):
+      ops.restore(NUM_STEPS)
+
+if __name__ == '__main__':
+   import pathlib, tempfile
+   test_binary_restore(pathlib.Path(tempfile.mkdtemp()))
+   test_binary_torn_save(pathlib.Path(tempfile.mkdtemp()))
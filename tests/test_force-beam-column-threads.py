@@ -0,0 +1,137 @@
+try:
+   import opensees as ops
+except ModuleNotFoundError:
+   import openseespy.opensees as ops
+from math import isclose
+import pytest
+
+H = 120
+E = 29000
+Fy = 50
+d = 12
+b = 8
+P = 50
+
+NUM_COLUMNS = 64
+NUM_THREADS = 4
+
+def threads_available():
+   # without OpenMP the domain keeps to one thread, and the threaded
+   # runs would only repeat the serial ones
+   ops.wipe()
+   ops.model('basic','-ndm',1,'-ndf',1)
+   ops.domainThreads(NUM_THREADS)
+   numThreads = ops.domainStat('numThreads')
+   ops.wipe()
+   return numThreads == NUM_THREADS
+
+pytestmark = pytest.mark.skipif(not threads_available(),
+                                reason='OpenSees built without OpenMP')
+
+def cantilever_columns(numThreads):
+   ops.wipe()
+   ops.model('basic','-ndm',2,'-ndf',3)
+
+   ops.uniaxialMaterial('Steel02',1,Fy,E,0.01,18,0.925,0.15)
+   ops.section('Fiber',1)
+   ops.patch('rect',1,16,1,-d/2,-b/2,d/2,b/2)
+
+   ops.beamIntegration('Lobatto',1,1,5)
+   ops.geomTransf('PDelta',1)
+
+   ops.timeSeries('Linear',1)
+   ops.pattern('Plain',1,1)
+
+   # columns of different heights so each element follows its own path;
+   # at the peak load factor of 2, 2*P*H > Fy*b*d**2/6 and all of them yield
+   for i in range(NUM_COLUMNS):
+      h = H*(1.0 + 0.01*i)
+      ops.node(2*i+1,i*H,0); ops.fix(2*i+1,1,1,1)
+      ops.node(2*i+2,i*H,h)
+      ops.element('forceBeamColumn',i+1,2*i+1,2*i+2,1,1)
+      ops.load(2*i+2,P*H/h,-P,0)
+
+   ops.domainThreads(numThreads)
+
+   ops.constraints('Plain')
+   ops.numberer('RCM')
+   ops.system('BandGen')
+   ops.test('NormDispIncr',1.0e-10,50)
+   ops.algorithm('Newton')
+   ops.integrator('-numThreads',numThreads,'LoadControl',0.1)
+   ops.analysis('Static','-noWarnings')
+   assert ops.analyze(20) == 0
+
+   # unload into the reversed direction to exercise the subdivisions
+   ops.integrator('-numThreads',numThreads,'LoadControl',-0.15)
+   assert ops.analyze(20) == 0
+
+   disp = [ops.nodeDisp(2*i+2,1) for i in range(NUM_COLUMNS)]
+   force = [ops.eleResponse(i+1,'basicForce') for i in range(NUM_COLUMNS)]
+   return disp, force
+
+def shaken_columns(numThreads):
+   ops.wipe()
+   ops.model('basic','-ndm',2,'-ndf',3)
+
+   ops.uniaxialMaterial('Steel02',1,Fy,E,0.01,18,0.925,0.15)
+   ops.section('Fiber',1)
+   ops.patch('rect',1,16,1,-d/2,-b/2,d/2,b/2)
+
+   ops.beamIntegration('Lobatto',1,1,5)
+   ops.geomTransf('PDelta',1)
+
+   for i in range(NUM_COLUMNS):
+      h = H*(1.0 + 0.01*i)
+      ops.node(2*i+1,i*H,0); ops.fix(2*i+1,1,1,1)
+      ops.node(2*i+2,i*H,h,'-mass',0.1,0.1,0.0)
+      ops.element('forceBeamColumn',i+1,2*i+1,2*i+2,1,1)
+
+   # all four factors, so the element base class forms the damping
+   # matrix and forces, including the committed stiffness
+   ops.rayleigh(0.2,0.001,0.001,0.001)
+
+   # strong enough for the columns to yield
+   ops.timeSeries('Trig',1,0.0,2.0,0.5,'-factor',100.0)
+   ops.pattern('UniformExcitation',1,1,'-accel',1)
+
+   ops.domainThreads(numThreads)
+
+   ops.constraints('Plain')
+   ops.numberer('RCM')
+   ops.system('BandGen')
+   ops.test('NormDispIncr',1.0e-10,50)
+   ops.algorithm('Newton')
+   ops.integrator('-numThreads',numThreads,'Newmark',0.5,0.25)
+   ops.analysis('Transient','-noWarnings')
+   assert ops.analyze(100,0.02) == 0
+
+   disp = [ops.nodeDisp(2*i+2,1) for i in range(NUM_COLUMNS)]
+   force = [ops.eleResponse(i+1,'basicForce') for i in range(NUM_COLUMNS)]
+   return disp, force
+
+def test_threaded_update():
+   serialDisp, serialForce = cantilever_columns(1)
+   threadedDisp, threadedForce = cantilever_columns(NUM_THREADS)
+
+   for u1, u2 in zip(serialDisp, threadedDisp):
+      assert isclose(u1,u2,rel_tol=1e-12)
+
+   for q1, q2 in zip(serialForce, threadedForce):
+      for f1, f2 in zip(q1, q2):
+         assert isclose(f1,f2,rel_tol=1e-12,abs_tol=1e-12)
+
+def test_threaded_rayleigh():
+   serialDisp, serialForce = shaken_columns(1)
+   threadedDisp, threadedForce = shaken_columns(NUM_THREADS)
+
+   for u1, u2 in zip(serialDisp, threadedDisp):
+      assert isclose(u1,u2,rel_tol=1e-12)
+
+   for q1, q2 in zip(serialForce, threadedForce):
+      for f1, f2 in zip(q1, q2):
+         assert isclose(f1,f2,rel_tol=1e-12,abs_tol=1e-12)
+
+if __name__ == '__main__':
+   test_threaded_update()
+   test_threaded_rayleigh()
@@ -0,0 +1,99 @@
+try:
+   import opensees as ops
+except ModuleNotFoundError:
+   import openseespy.opensees as ops
+from math import isclose
+import pytest
+
+E = 30000
+nu = 0.25
+P = 10
+
+# ten bricks a side gives more equations than the 2000 below which the
+# solver keeps its vector operations on one thread
+NUM_BRICKS = 10
+NUM_THREADS = 4
+
+def threads_available():
+   # without OpenMP the solver runs on one thread whatever is asked, and
+   # the threaded solves would only repeat the serial ones
+   ops.wipe()
+   ops.model('basic','-ndm',1,'-ndf',1)
+   ops.domainThreads(NUM_THREADS)
+   numThreads = ops.domainStat('numThreads')
+   ops.wipe()
+   return numThreads == NUM_THREADS
+
+pytestmark = pytest.mark.skipif(not threads_available(),
+                                reason='OpenSees built without OpenMP')
+
+def brick_block(system):
+   ops.wipe()
+   ops.model('basic','-ndm',3,'-ndf',3)
+
+   ops.nDMaterial('ElasticIsotropic',1,E,nu)
+
+   n = NUM_BRICKS + 1
+   def tag(i, j, k):
+      return 1 + i + n*j + n*n*k
+
+   for k in range(n):
+      for j in range(n):
+         for i in range(n):
+            ops.node(tag(i,j,k),float(i),float(j),float(k))
+            if k == 0:
+               ops.fix(tag(i,j,k),1,1,1)
+
+   eleTag = 1
+   for k in range(NUM_BRICKS):
+      for j in range(NUM_BRICKS):
+         for i in range(NUM_BRICKS):
+            ops.element('stdBrick',eleTag,
+                        tag(i,j,k),tag(i+1,j,k),tag(i+1,j+1,k),tag(i,j+1,k),
+                        tag(i,j,k+1),tag(i+1,j,k+1),tag(i+1,j+1,k+1),tag(i,j+1,k+1),1)
+            eleTag += 1
+
+   # a sideways load on the top face, so all three directions respond
+   ops.timeSeries('Linear',1)
+   ops.pattern('Plain',1,1)
+   for j in range(n):
+      for i in range(n):
+         ops.load(tag(i,j,NUM_BRICKS),P,0.5*P,-P)
+
+   ops.constraints('Plain')
+   ops.numberer('RCM')
+   ops.system(*system)
+   ops.test('NormDispIncr',1.0e-8,10)
+   ops.algorithm('Linear')
+   ops.integrator('LoadControl',1.0)
+   ops.analysis('Static','-noWarnings')
+   assert ops.analyze(1) == 0
+
+   return [ops.nodeDisp(node) for node in ops.getNodeTags()]
+
+@pytest.mark.parametrize('method,precond', [
+   ('PCG','Jacobi'),
+   ('PCG','BlockJacobi'),
+   ('PCG','AMG'),
+   ('GMRES','ILU'),
+   ('BiCGStab','ILU'),
+])
+def test_threaded_krylov(method, precond):
+   direct = brick_block(['UmfPack'])
+
+   krylov = ['Krylov','-method',method,'-precond',precond,
+             '-blockSize',3,'-tol',1.0e-12,'-maxIter',2000]
+   serial = brick_block(krylov + ['-numThreads',1])
+   threaded = brick_block(krylov + ['-numThreads',NUM_THREADS])
+
+   # the threads sum the dot products in another order, so the iterates
+   # follow the serial ones only to within the solver tolerance
+   uMax = max(abs(u) for disp in direct for u in disp)
+   for u0, u1, u2 in zip(direct, serial, threaded):
+      for d0, d1, d2 in zip(u0, u1, u2):
+         assert isclose(d1,d0,abs_tol=1e-8*uMax)
+         assert isclose(d2,d1,abs_tol=1e-8*uMax)
+
+if __name__ == '__main__':
+   for method, precond in [('PCG','AMG'),('GMRES','ILU')]:
+      test_threaded_krylov(method, precond)